@@ -0,0 +1,313 @@
+#include "bench.h"
+
+#include <ECM/math/functions.h>
+#include <ECM/math/parallel.h>
+#include <ECM/math/random.h>
+#include <ECM/math/ray.h>
+
+#include <cstring>
+#include <type_traits>
+
+// The errors of the functions in units in the last place. float32 functions
+// are compared with the double-precision functions of the standard library
+// on every input of a range, float64 functions with the long double
+// functions on random inputs. Where long double equals double, like with
+// MSVC, the float64 errors are only accurate to about one ulp.
+
+namespace ecm::bench
+{
+	namespace
+	{
+		template<typename T>
+		struct float_traits;
+
+		template<>
+		struct float_traits<float32>
+		{
+			typedef uint32 bits_type;
+			typedef float64 reference_type;
+			static constexpr char const* NAME{ "float32" };
+		};
+
+		template<>
+		struct float_traits<float64>
+		{
+			typedef uint64 bits_type;
+			typedef long double reference_type;
+			static constexpr char const* NAME{ "float64" };
+		};
+
+		template<typename T>
+		using bits_t = typename float_traits<T>::bits_type;
+
+		template<typename T>
+		using reference_t = typename float_traits<T>::reference_type;
+
+		// Maps the bits of a floating-point value to an unsigned integer,
+		// which is ordered like the values, so that a range of integers is a
+		// range of consecutive values
+		template<typename T>
+		bits_t<T> to_ordered(T x)
+		{
+			constexpr bits_t<T> sign{ static_cast<bits_t<T>>(bits_t<T>(1) << (sizeof(T) * 8 - 1)) };
+			bits_t<T> bits;
+			std::memcpy(&bits, &x, sizeof(T));
+			return (bits & sign) ? static_cast<bits_t<T>>(~bits) : static_cast<bits_t<T>>(bits | sign);
+		}
+
+		template<typename T>
+		T from_ordered(bits_t<T> ordered)
+		{
+			constexpr bits_t<T> sign{ static_cast<bits_t<T>>(bits_t<T>(1) << (sizeof(T) * 8 - 1)) };
+			const bits_t<T> bits{ (ordered & sign) ? static_cast<bits_t<T>>(ordered & ~sign) : static_cast<bits_t<T>>(~ordered) };
+			T x;
+			std::memcpy(&x, &bits, sizeof(T));
+			return x;
+		}
+
+		// Draws values, which are uniform in the ordered bits of a range, so
+		// that every binade of the range gets the same share of samples
+		template<typename T>
+		class ordered_sampler
+		{
+		public:
+			ordered_sampler(T lo, T hi)
+				: _first(to_ordered(lo)), _range(static_cast<uint64>(to_ordered(hi) - to_ordered(lo)) + 1)
+			{}
+
+			T operator()(math::Xoshiro256pp& rng) const
+			{
+				// A range of all 2^64 values wraps to 0
+				const uint64 offset{ _range ? rng() % _range : rng() };
+				return from_ordered<T>(static_cast<bits_t<T>>(_first + offset));
+			}
+		private:
+			bits_t<T> _first;
+			uint64 _range;
+		};
+
+		constexpr uint64 GRAIN{ 1ull << 14 };
+
+		// Runs the chunks of a range on all threads and merges their
+		// statistics in the order of the chunks, so that the result is the
+		// same for every number of threads
+		template<typename Chunk>
+		AccuracyStats run_chunks(uint64 count, Chunk&& chunk)
+		{
+			std::vector<AccuracyStats> partials((count + GRAIN - 1) / GRAIN);
+			math::ParallelFor(0, count, GRAIN, [&](uint64 begin, uint64 end) {
+				chunk(partials[begin / GRAIN], begin, end);
+			});
+			AccuracyStats stats;
+			for (AccuracyStats const& partial : partials)
+				stats.Merge(partial);
+			return stats;
+		}
+
+		// Compares a unary function with the reference on consecutive values.
+		// The full run covers every value of the range, the quick one about
+		// 2^20 evenly spread values.
+		template<typename T, typename Function, typename Reference>
+		void sweep(Options const& options, Report& report, std::string const& name, T lo, T hi,
+			Function const& function, Reference const& reference)
+		{
+			const bits_t<T> first{ to_ordered(lo) };
+			const uint64 range{ static_cast<uint64>(to_ordered(hi) - first) + 1 };
+			const uint64 count{ options.quick ? std::min<uint64>(range, 1ull << 20) : range };
+			const AccuracyStats stats{ run_chunks(count, [&](AccuracyStats& partial, uint64 begin, uint64 end) {
+				for (uint64 i{ begin }; i < end; ++i) {
+					const T x{ from_ordered<T>(static_cast<bits_t<T>>(first + (count == range ? i : i * range / count))) };
+					Compare(partial, x, function(x), reference(static_cast<reference_t<T>>(x)));
+				}
+			}) };
+			report.AddAccuracy(name, float_traits<T>::NAME, count == range ? "exhaustive" : "strided", lo, hi, stats);
+		}
+
+		// Compares a unary function with the reference on random values
+		template<typename T, typename Function, typename Reference>
+		void sample(Options const& options, Report& report, std::string const& name, T lo, T hi,
+			Function const& function, Reference const& reference)
+		{
+			const ordered_sampler<T> sampler(lo, hi);
+			const uint64 count{ options.quick ? 1ull << 18 : 1ull << 24 };
+			const AccuracyStats stats{ run_chunks(count, [&](AccuracyStats& partial, uint64 begin, uint64 end) {
+				math::Xoshiro256pp rng(0xECu + begin / GRAIN);
+				for (uint64 i{ begin }; i < end; ++i) {
+					const T x{ sampler(rng) };
+					Compare(partial, x, function(x), reference(static_cast<reference_t<T>>(x)));
+				}
+			}) };
+			report.AddAccuracy(name, float_traits<T>::NAME, "sampled", lo, hi, stats);
+		}
+
+		// Compares a binary function with the reference on random pairs. The
+		// worst input is the first argument.
+		template<typename T, typename Function, typename Reference>
+		void sample(Options const& options, Report& report, std::string const& name, T xLo, T xHi, T yLo, T yHi,
+			Function const& function, Reference const& reference)
+		{
+			const ordered_sampler<T> xSampler(xLo, xHi);
+			const ordered_sampler<T> ySampler(yLo, yHi);
+			const uint64 count{ options.quick ? 1ull << 18 : 1ull << 24 };
+			const AccuracyStats stats{ run_chunks(count, [&](AccuracyStats& partial, uint64 begin, uint64 end) {
+				math::Xoshiro256pp rng(0xECu + begin / GRAIN);
+				for (uint64 i{ begin }; i < end; ++i) {
+					const T x{ xSampler(rng) };
+					const T y{ ySampler(rng) };
+					Compare(partial, x, function(x, y), reference(static_cast<reference_t<T>>(x), static_cast<reference_t<T>>(y)));
+				}
+			}) };
+			report.AddAccuracy(name, float_traits<T>::NAME, "sampled", xLo, xHi, stats);
+		}
+
+		template<typename Function, typename Reference>
+		void unary(Options const& options, Report& report, std::string const& name, float32 lo32, float32 hi32,
+			float64 lo64, float64 hi64, Function const& function, Reference const& reference)
+		{
+			if (report.Selected(name + ".float32"))
+				sweep<float32>(options, report, name, lo32, hi32, function, reference);
+			if (report.Selected(name + ".float64"))
+				sample<float64>(options, report, name, lo64, hi64, function, reference);
+		}
+
+		template<typename Function, typename Reference>
+		void binary(Options const& options, Report& report, std::string const& name, float64 xLo, float64 xHi,
+			float64 yLo, float64 yHi, Function const& function, Reference const& reference)
+		{
+			if (report.Selected(name + ".float32")) {
+				sample<float32>(options, report, name, static_cast<float32>(xLo), static_cast<float32>(xHi),
+					static_cast<float32>(yLo), static_cast<float32>(yHi), function, reference);
+			}
+			if (report.Selected(name + ".float64"))
+				sample<float64>(options, report, name, xLo, xHi, yLo, yHi, function, reference);
+		}
+
+		// Rays, which start on a face plane of the box [0, 1]^3 or one value
+		// inside or outside of it, with a zero direction component of +0 or
+		// -0 on the axis of the plane. They travel along another axis
+		// towards the box, which they hit at the distance 1 unless they
+		// start outside. The input is the index of the ray.
+		template<uint32 N>
+		void ray_box_faces(Report& report, std::string const& name)
+		{
+			const math::AABB box(math::Vector3_Base<float32>(0.f, 0.f, 0.f), math::Vector3_Base<float32>(1.f, 1.f, 1.f));
+			std::vector<math::Ray> rays;
+			std::vector<float32> expected;
+			for (uint32 axis{ 0 }; axis < 3; ++axis) {
+				for (const float32 plane : { 0.f, 1.f }) {
+					const float32 outside{ plane == 0.f ? -1.f : 2.f };
+					for (const float32 start : { std::nextafter(plane, 0.5f), plane, std::nextafter(plane, outside) }) {
+						for (const float32 zero : { 0.f, -0.f }) {
+							for (uint32 travel{ 1 }; travel < 3; ++travel) {
+								for (const float32 sign : { 1.f, -1.f }) {
+									math::Ray ray;
+									ray.origin[axis] = start;
+									ray.origin[(axis + travel) % 3] = sign > 0.f ? -1.f : 2.f;
+									ray.origin[(axis + 3 - travel) % 3] = 0.5f;
+									ray.direction[axis] = zero;
+									ray.direction[(axis + travel) % 3] = sign;
+									ray.direction[(axis + 3 - travel) % 3] = 0.f;
+									rays.push_back(ray);
+									expected.push_back(start == std::nextafter(plane, outside)
+										? std::numeric_limits<float32>::infinity() : 1.f);
+								}
+							}
+						}
+					}
+				}
+			}
+
+			AccuracyStats stats;
+			for (uint64 i{ 0 }; i < rays.size(); i += N) {
+				float32 distances[N];
+				if constexpr (N == 1) {
+					if (!math::Intersects(rays[i], box, distances[0]))
+						distances[0] = std::numeric_limits<float32>::infinity();
+				} else {
+					math::RayPacket_Base<N> packet;
+					for (uint32 r{ 0 }; r < N; ++r) {
+						for (uint32 c{ 0 }; c < 3; ++c) {
+							packet.origin[c][r] = rays[i + r].origin[c];
+							packet.direction[c][r] = rays[i + r].direction[c];
+						}
+						distances[r] = std::numeric_limits<float32>::infinity();
+					}
+					Consume(math::IntersectPacket(packet, box, distances));
+				}
+				for (uint32 r{ 0 }; r < N; ++r)
+					Compare(stats, static_cast<float64>(i + r), distances[r], static_cast<float64>(expected[i + r]));
+			}
+			report.AddAccuracy(name, "float32", "faces", 0.0, static_cast<float64>(rays.size() - 1), stats);
+		}
+	} // anonymous namespace
+
+// Wraps the function templates in generic lambdas, which take float32 and
+// float64 inputs, and their references float64 and long double inputs
+#define ECM_BENCH_UNARY(name, lo32, hi32, lo64, hi64, function, reference) \
+	unary(options, report, name, lo32, hi32, lo64, hi64, \
+		[](auto x) { return math::function(x); }, [](auto x) { return std::reference(x); })
+#define ECM_BENCH_BINARY(name, xLo, xHi, yLo, yHi, function, reference) \
+	binary(options, report, name, xLo, xHi, yLo, yHi, \
+		[](auto x, auto y) { return math::function(x, y); }, [](auto x, auto y) { return std::reference(x, y); })
+
+	ECM_BENCH_SUITE(accuracy)
+	{
+		constexpr float32 MAX32{ std::numeric_limits<float32>::max() };
+		constexpr float64 MAX64{ std::numeric_limits<float64>::max() };
+		// Floor, Ceil and Trunc convert to a 64-bit integer
+		constexpr float64 INT_RANGE{ 4611686018427387904.0 };
+
+		ECM_BENCH_UNARY("Sqrt", 0.f, MAX32, 0.0, MAX64, Sqrt, sqrt);
+		ECM_BENCH_UNARY("Cbrt", -MAX32, MAX32, -MAX64, MAX64, Cbrt, cbrt);
+		ECM_BENCH_UNARY("Exp", -87.3f, 88.7f, -708.3, 709.7, Exp, exp);
+		ECM_BENCH_UNARY("Floor", static_cast<float32>(-INT_RANGE), static_cast<float32>(INT_RANGE), -INT_RANGE, INT_RANGE, Floor, floor);
+		ECM_BENCH_UNARY("Ceil", static_cast<float32>(-INT_RANGE), static_cast<float32>(INT_RANGE), -INT_RANGE, INT_RANGE, Ceil, ceil);
+		ECM_BENCH_UNARY("Trunc", static_cast<float32>(-INT_RANGE), static_cast<float32>(INT_RANGE), -INT_RANGE, INT_RANGE, Trunc, trunc);
+		ECM_BENCH_UNARY("Sin", -1e6f, 1e6f, -1e6, 1e6, Sin, sin);
+		ECM_BENCH_UNARY("Cos", -1e6f, 1e6f, -1e6, 1e6, Cos, cos);
+		ECM_BENCH_UNARY("Tan", -1e6f, 1e6f, -1e6, 1e6, Tan, tan);
+		ECM_BENCH_UNARY("Asin", -1.f, 1.f, -1.0, 1.0, Asin, asin);
+		ECM_BENCH_UNARY("Acos", -1.f, 1.f, -1.0, 1.0, Acos, acos);
+		ECM_BENCH_UNARY("Atan", -MAX32, MAX32, -MAX64, MAX64, Atan, atan);
+		ECM_BENCH_UNARY("Sinh", -89.f, 89.f, -710.0, 710.0, Sinh, sinh);
+		ECM_BENCH_UNARY("Cosh", -89.f, 89.f, -710.0, 710.0, Cosh, cosh);
+		ECM_BENCH_UNARY("Tanh", -MAX32, MAX32, -MAX64, MAX64, Tanh, tanh);
+		ECM_BENCH_UNARY("Asinh", -MAX32, MAX32, -MAX64, MAX64, Asinh, asinh);
+		ECM_BENCH_UNARY("Acosh", 1.f, MAX32, 1.0, MAX64, Acosh, acosh);
+		ECM_BENCH_UNARY("Atanh", -1.f, 1.f, -1.0, 1.0, Atanh, atanh);
+		ECM_BENCH_UNARY("Log", 0.f, MAX32, 0.0, MAX64, Log, log);
+		ECM_BENCH_UNARY("Log2", 0.f, MAX32, 0.0, MAX64, Log2, log2);
+		ECM_BENCH_UNARY("Log10", 0.f, MAX32, 0.0, MAX64, Log10, log10);
+		ECM_BENCH_UNARY("Log1p", -1.f, MAX32, -1.0, MAX64, Log1p, log1p);
+
+		// Only the mantissa, infinity would never leave the loop of Frexp
+		unary(options, report, "Frexp", -MAX32, MAX32, -MAX64, MAX64,
+			[](auto x) { int32 e{ 0 }; return math::Frexp(x, &e); },
+			[](auto x) { int e{ 0 }; return std::frexp(x, &e); });
+
+		ECM_BENCH_BINARY("Pow", 0.0, 1e3, -20.0, 20.0, Pow, pow);
+		// Integral exponents, the truncated second value
+		binary(options, report, "PowInt", -4.0, 4.0, -30.0, 30.0,
+			[](auto x, auto n) { return math::Pow(x, static_cast<int32>(n)); },
+			[](auto x, auto n) { return std::pow(x, static_cast<int>(n)); });
+		ECM_BENCH_BINARY("Hypot", -1e18, 1e18, -1e18, 1e18, Hypot, hypot);
+		ECM_BENCH_BINARY("Fmod", -1e6, 1e6, 1e-3, 1e3, Fmod, fmod);
+
+		// The exponent is the truncated second value, Ldexp shifts a 64-bit
+		// integer
+		binary(options, report, "Ldexp", -1e6, 1e6, 0.0, 30.0,
+			[](auto x, auto n) { return math::Ldexp(x, static_cast<int32>(n)); },
+			[](auto x, auto n) { return std::ldexp(x, static_cast<int>(n)); });
+
+		// Hits and misses of the slab tests at the faces of a box
+		if (report.Selected("ray.Intersects.AABB"))
+			ray_box_faces<1>(report, "ray.Intersects.AABB");
+		if (report.Selected("ray.IntersectPacket4.AABB"))
+			ray_box_faces<4>(report, "ray.IntersectPacket4.AABB");
+		if (report.Selected("ray.IntersectPacket8.AABB"))
+			ray_box_faces<8>(report, "ray.IntersectPacket8.AABB");
+	}
+
+#undef ECM_BENCH_UNARY
+#undef ECM_BENCH_BINARY
+} // namespace ecm::bench
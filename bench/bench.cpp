@@ -0,0 +1,215 @@
+#include "bench.h"
+
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+namespace ecm::bench
+{
+	namespace
+	{
+		std::map<std::string, SuiteFunction>& get_suites()
+		{
+			// Function-local, so that registrars of other translation units
+			// never see it uninitialized
+			static std::map<std::string, SuiteFunction> suites;
+			return suites;
+		}
+
+		char const* get_simd_name()
+		{
+#if ECM_SIMD_AVX2
+			return "AVX2";
+#elif ECM_SIMD_SSE41
+			return "SSE4.1";
+#elif ECM_SIMD_SSE2
+			return "SSE2";
+#else
+			return "none";
+#endif
+		}
+
+		std::string get_compiler_name()
+		{
+#if defined(__clang__)
+			return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+			return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+			return "msvc " + std::to_string(_MSC_VER);
+#else
+			return "unknown";
+#endif
+		}
+
+		// JSON has no NaN and infinity, so they become null
+		void write_number(std::FILE* file, float64 value)
+		{
+			if (std::isfinite(value))
+				std::fprintf(file, "%.17g", value);
+			else
+				std::fputs("null", file);
+		}
+
+		void write_string(std::FILE* file, std::string const& value)
+		{
+			std::fputc('"', file);
+			for (const char c : value) {
+				if (c == '"' || c == '\\')
+					std::fputc('\\', file);
+				std::fputc(c, file);
+			}
+			std::fputc('"', file);
+		}
+	} // anonymous namespace
+
+	void AccuracyStats::Add(float64 ulp, float64 input) noexcept
+	{
+		++samples;
+		sumUlp += ulp;
+		// Ties keep the first input, so the result doesn't depend on threads
+		if (ulp > maxUlp) {
+			maxUlp = ulp;
+			worstInput = input;
+		}
+	}
+
+	void AccuracyStats::AddMismatch(float64 input) noexcept
+	{
+		if (mismatches == 0)
+			mismatchInput = input;
+		++samples;
+		++mismatches;
+	}
+
+	void AccuracyStats::Merge(AccuracyStats const& other) noexcept
+	{
+		if (mismatches == 0 && other.mismatches != 0)
+			mismatchInput = other.mismatchInput;
+		if (other.maxUlp > maxUlp) {
+			maxUlp = other.maxUlp;
+			worstInput = other.worstInput;
+		}
+		samples += other.samples;
+		mismatches += other.mismatches;
+		sumUlp += other.sumUlp;
+	}
+
+	Report::Report(Options const& options)
+		: _options(options)
+	{}
+
+	bool Report::Selected(std::string const& name) const
+	{
+		return _options.filter.empty() || name.find(_options.filter) != std::string::npos;
+	}
+
+	void Report::AddAccuracy(std::string const& name, std::string const& type, std::string const& method,
+		float64 lo, float64 hi, AccuracyStats const& stats)
+	{
+		if (!_printedAccuracyHeader) {
+			std::printf("\n%-12s %-8s %-11s %12s %12s %10s  %s\n", "accuracy", "type", "method", "max ulp", "mean ulp", "mismatches", "worst input");
+			_printedAccuracyHeader = true;
+		}
+		const float64 meanUlp{ stats.samples > stats.mismatches
+			? stats.sumUlp / static_cast<float64>(stats.samples - stats.mismatches) : 0.0 };
+		std::printf("%-12s %-8s %-11s %12.4g %12.4g %10llu  %.17g\n", name.c_str(), type.c_str(), method.c_str(),
+			stats.maxUlp, meanUlp, static_cast<unsigned long long>(stats.mismatches), stats.worstInput);
+		std::fflush(stdout);
+		_accuracy.push_back({ name, type, method, lo, hi, stats });
+	}
+
+	void Report::AddThroughput(std::string const& name, float64 nsPerItem, std::string const& baseline,
+		float64 baselineNsPerItem, std::string const& unit)
+	{
+		if (!_printedThroughputHeader) {
+			std::printf("\n%-36s %14s   %-32s %14s %8s\n", "throughput", "ns/item", "baseline", "ns/item", "speedup");
+			_printedThroughputHeader = true;
+		}
+		if (baseline.empty()) {
+			std::printf("%-36s %9.3f ns/%-3s\n", name.c_str(), nsPerItem, unit.c_str());
+		} else {
+			std::printf("%-36s %9.3f ns/%-3s  %-32s %9.3f ns/%-3s %7.2fx\n", name.c_str(), nsPerItem, unit.c_str(),
+				baseline.c_str(), baselineNsPerItem, unit.c_str(), baselineNsPerItem / nsPerItem);
+		}
+		std::fflush(stdout);
+		_throughput.push_back({ name, nsPerItem, baseline, baselineNsPerItem, unit });
+	}
+
+	bool Report::WriteJson() const
+	{
+		if (_options.jsonPath.empty())
+			return true;
+		std::FILE* file{ std::fopen(_options.jsonPath.c_str(), "w") };
+		if (!file)
+			return false;
+		std::fputs("{\n  \"meta\": {\n    \"simd\": ", file);
+		write_string(file, get_simd_name());
+		std::fputs(",\n    \"compiler\": ", file);
+		write_string(file, get_compiler_name());
+		std::fprintf(file, ",\n    \"long_double_digits\": %d,\n    \"threads\": %u,\n    \"quick\": %s\n  },\n",
+			std::numeric_limits<long double>::digits, math::GetParallelThreadCount(), _options.quick ? "true" : "false");
+		std::fputs("  \"accuracy\": [", file);
+		for (size_t i{ 0 }; i < _accuracy.size(); ++i) {
+			accuracy_entry const& entry{ _accuracy[i] };
+			const uint64 compared{ entry.stats.samples - entry.stats.mismatches };
+			std::fputs(i == 0 ? "\n    { \"name\": " : ",\n    { \"name\": ", file);
+			write_string(file, entry.name);
+			std::fputs(", \"type\": ", file);
+			write_string(file, entry.type);
+			std::fputs(", \"method\": ", file);
+			write_string(file, entry.method);
+			std::fputs(", \"lo\": ", file);
+			write_number(file, entry.lo);
+			std::fputs(", \"hi\": ", file);
+			write_number(file, entry.hi);
+			std::fprintf(file, ", \"samples\": %llu, \"mismatches\": %llu, \"max_ulp\": ",
+				static_cast<unsigned long long>(entry.stats.samples), static_cast<unsigned long long>(entry.stats.mismatches));
+			write_number(file, entry.stats.maxUlp);
+			std::fputs(", \"mean_ulp\": ", file);
+			write_number(file, compared ? entry.stats.sumUlp / static_cast<float64>(compared) : 0.0);
+			std::fputs(", \"worst_input\": ", file);
+			write_number(file, entry.stats.worstInput);
+			if (entry.stats.mismatches != 0) {
+				std::fputs(", \"mismatch_input\": ", file);
+				write_number(file, entry.stats.mismatchInput);
+			}
+			std::fputs(" }", file);
+		}
+		std::fputs("\n  ],\n  \"throughput\": [", file);
+		for (size_t i{ 0 }; i < _throughput.size(); ++i) {
+			throughput_entry const& entry{ _throughput[i] };
+			std::fputs(i == 0 ? "\n    { \"name\": " : ",\n    { \"name\": ", file);
+			write_string(file, entry.name);
+			std::fputs(", \"unit\": ", file);
+			write_string(file, entry.unit);
+			std::fputs(", \"ns_per_item\": ", file);
+			write_number(file, entry.nsPerItem);
+			if (!entry.baseline.empty()) {
+				std::fputs(", \"baseline\": ", file);
+				write_string(file, entry.baseline);
+				std::fputs(", \"baseline_ns_per_item\": ", file);
+				write_number(file, entry.baselineNsPerItem);
+				std::fputs(", \"speedup\": ", file);
+				write_number(file, entry.baselineNsPerItem / entry.nsPerItem);
+			}
+			std::fputs(" }", file);
+		}
+		std::fputs("\n  ]\n}\n", file);
+		return std::fclose(file) == 0;
+	}
+
+	SuiteRegistrar::SuiteRegistrar(char const* name, SuiteFunction function)
+	{
+		get_suites()[name] = function;
+	}
+
+	void RunSuites(Options const& options, Report& report)
+	{
+		for (auto const& suite : get_suites())
+			suite.second(options, report);
+	}
+} // namespace ecm::bench
@@ -0,0 +1,326 @@
+/**
+ * \file bench.h
+ *
+ * \brief This header defines the framework of the accuracy and throughput
+ *        benchmarks of ECM's Math module.
+ *
+ * A suite is a function registered with ECM_BENCH_SUITE. It measures cases
+ * and adds their results to the report, which prints them and writes them
+ * as JSON for regression tracking.
+ */
+
+#pragma once
+#ifndef _ECM_BENCH_H_
+#define _ECM_BENCH_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ecm::bench
+{
+	/**
+	 * This structure defines the command line options of the benchmarks.
+	 *
+	 * \since v1.0.0
+	 */
+	struct Options
+	{
+		/* Samples sweeps and runs timings shorter, for a run of seconds */
+		bool quick{ false };
+		/* Only cases, whose name contains this text, run */
+		std::string filter;
+		/* The path of the JSON file, empty to write none */
+		std::string jsonPath;
+		/* The minimum time of one timing repetition in seconds */
+		float64 minTime{ 0.05 };
+	};
+
+	/**
+	 * This structure represents the accuracy of a function over a range.
+	 *
+	 * \since v1.0.0
+	 */
+	struct AccuracyStats
+	{
+		/* The number of compared inputs */
+		uint64 samples{ 0 };
+		/* Inputs, where one result is NaN or infinite and the other one
+		   not, or infinite with another sign */
+		uint64 mismatches{ 0 };
+		/* The largest error in units in the last place */
+		float64 maxUlp{ 0.0 };
+		/* The sum of the errors, for the mean */
+		float64 sumUlp{ 0.0 };
+		/* The input with the largest error */
+		float64 worstInput{ 0.0 };
+		/* The first input with a mismatch */
+		float64 mismatchInput{ 0.0 };
+
+		/**
+		 * Adds the error of one input.
+		 *
+		 * \param ulp The error in units in the last place.
+		 * \param input The input.
+		 *
+		 * \since v1.0.0
+		 */
+		void Add(float64 ulp, float64 input) noexcept;
+
+		/**
+		 * Adds a mismatch of one input.
+		 *
+		 * \param input The input.
+		 *
+		 * \since v1.0.0
+		 */
+		void AddMismatch(float64 input) noexcept;
+
+		/**
+		 * Merges the statistics of another range.
+		 *
+		 * \param other The statistics to merge.
+		 *
+		 * \since v1.0.0
+		 */
+		void Merge(AccuracyStats const& other) noexcept;
+	};
+
+	/**
+	 * This class collects the results of the cases, prints them and writes
+	 * them as JSON.
+	 *
+	 * \since v1.0.0
+	 */
+	class Report
+	{
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * \param options The options of the run.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit Report(Options const& options);
+
+		/**
+		 * Checks whether a case runs with the filter of the options.
+		 *
+		 * \param name The name of the case.
+		 *
+		 * \returns True, if the case runs.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD bool Selected(std::string const& name) const;
+
+		/**
+		 * Adds and prints the accuracy of a case.
+		 *
+		 * \param name The name of the case.
+		 * \param type The floating type, float32 or float64.
+		 * \param method How the inputs were chosen, e.g. exhaustive.
+		 * \param lo The lower bound of the input range.
+		 * \param hi The upper bound of the input range.
+		 * \param stats The accuracy.
+		 *
+		 * \since v1.0.0
+		 */
+		void AddAccuracy(std::string const& name, std::string const& type, std::string const& method,
+			float64 lo, float64 hi, AccuracyStats const& stats);
+
+		/**
+		 * Adds and prints the throughput of a case.
+		 *
+		 * \param name The name of the case.
+		 * \param nsPerItem The nanoseconds per item.
+		 * \param baseline The name of the baseline, e.g. libm, or empty.
+		 * \param baselineNsPerItem The nanoseconds per item of the baseline.
+		 * \param unit The name of an item, e.g. op or sample.
+		 *
+		 * \since v1.0.0
+		 */
+		void AddThroughput(std::string const& name, float64 nsPerItem, std::string const& baseline = std::string(),
+			float64 baselineNsPerItem = 0.0, std::string const& unit = "op");
+
+		/**
+		 * Writes all results to the JSON file of the options.
+		 *
+		 * \returns False, if the file couldn't be written.
+		 *
+		 * \since v1.0.0
+		 */
+		bool WriteJson() const;
+	private:
+		struct accuracy_entry
+		{
+			std::string name;
+			std::string type;
+			std::string method;
+			float64 lo;
+			float64 hi;
+			AccuracyStats stats;
+		};
+
+		struct throughput_entry
+		{
+			std::string name;
+			float64 nsPerItem;
+			std::string baseline;
+			float64 baselineNsPerItem;
+			std::string unit;
+		};
+
+		Options _options;
+		std::vector<accuracy_entry> _accuracy;
+		std::vector<throughput_entry> _throughput;
+		bool _printedAccuracyHeader{ false };
+		bool _printedThroughputHeader{ false };
+	};
+
+	typedef void (*SuiteFunction)(Options const& options, Report& report);
+
+	/**
+	 * This structure registers a suite in its constructor. Use it through
+	 * ECM_BENCH_SUITE.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SuiteRegistrar
+	{
+		SuiteRegistrar(char const* name, SuiteFunction function);
+	};
+
+	/**
+	 * Runs all registered suites in the order of their names.
+	 *
+	 * \param options The options.
+	 * \param report The report receiving the results.
+	 *
+	 * \since v1.0.0
+	 */
+	void RunSuites(Options const& options, Report& report);
+
+	/**
+	 * Keeps the compiler from removing the computation of a value.
+	 *
+	 * \param value The value.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	inline void Consume(T const& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile char sink;
+		sink = *reinterpret_cast<char const volatile*>(&value);
+#endif
+	}
+
+	/**
+	 * Measures the time of a function. The function runs repeatedly until
+	 * the minimum time of the options has passed, and the fastest of five
+	 * repetitions counts.
+	 *
+	 * \param options The options.
+	 * \param itemsPerCall The number of items, which one call processes.
+	 * \param function The function to measure.
+	 *
+	 * \returns The nanoseconds per item.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Function>
+	float64 MeasureNs(Options const& options, uint64 itemsPerCall, Function&& function)
+	{
+		using clock = std::chrono::steady_clock;
+		const float64 minTime{ options.quick ? options.minTime * 0.1 : options.minTime };
+		function();
+		float64 best{ std::numeric_limits<float64>::infinity() };
+		for (int32 repetition{ 0 }; repetition < 5; ++repetition) {
+			uint64 calls{ 0 };
+			const clock::time_point start{ clock::now() };
+			float64 elapsed{ 0.0 };
+			do {
+				function();
+				++calls;
+				elapsed = std::chrono::duration<float64>(clock::now() - start).count();
+			} while (elapsed < minTime);
+			best = std::fmin(best, elapsed * 1e9 / static_cast<float64>(calls * itemsPerCall));
+		}
+		return best;
+	}
+
+	/**
+	 * Calculates the error of a result in units in the last place of the
+	 * result type, relative to a more precise reference. Both must be
+	 * finite.
+	 *
+	 * \param result The result.
+	 * \param reference The reference.
+	 *
+	 * \returns The error in units in the last place.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename R>
+	float64 UlpError(T result, R reference)
+	{
+		const R magnitude{ std::fabs(static_cast<R>(static_cast<T>(reference))) };
+		int exponent{ 0 };
+		std::frexp(magnitude, &exponent);
+		// The spacing of T around the reference, at least the one of the
+		// subnormal numbers
+		const int32 ulpExponent{ std::max<int32>(exponent - std::numeric_limits<T>::digits,
+			std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits) };
+		return static_cast<float64>(std::fabs(static_cast<R>(result) - reference) / std::ldexp(static_cast<R>(1), ulpExponent));
+	}
+
+	/**
+	 * Compares a result with a reference and adds the error to statistics.
+	 *
+	 * \param stats The statistics.
+	 * \param input The input of the result.
+	 * \param result The result.
+	 * \param reference The more precise reference.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename R>
+	void Compare(AccuracyStats& stats, float64 input, T result, R reference)
+	{
+		// The reference rounded to T may overflow
+		const T rounded{ static_cast<T>(reference) };
+		if (std::isfinite(result) && std::isfinite(rounded)) {
+			stats.Add(UlpError(result, reference), input);
+		} else if ((std::isnan(result) && std::isnan(rounded)) || result == rounded) {
+			stats.Add(0.0, input);
+		} else {
+			stats.AddMismatch(input);
+		}
+	}
+} // namespace ecm::bench
+
+#define ECM_BENCH_CONCAT_IMPL(a, b) a##b
+#define ECM_BENCH_CONCAT(a, b) ECM_BENCH_CONCAT_IMPL(a, b)
+
+/**
+ * Defines and registers a suite. The body follows the macro and gets the
+ * parameters options and report.
+ *
+ * \since v1.0.0
+ */
+#define ECM_BENCH_SUITE(name) \
+	static void ECM_BENCH_CONCAT(name, _suite)(::ecm::bench::Options const& options, ::ecm::bench::Report& report); \
+	static const ::ecm::bench::SuiteRegistrar ECM_BENCH_CONCAT(name, _registrar)(#name, &ECM_BENCH_CONCAT(name, _suite)); \
+	static void ECM_BENCH_CONCAT(name, _suite)(ECM_MAYBEUNUSED ::ecm::bench::Options const& options, ::ecm::bench::Report& report)
+
+#endif // !_ECM_BENCH_H_
@@ -0,0 +1,143 @@
+#include "bench.h"
+
+#include <ECM/math/functions.h>
+#include <ECM/math/random.h>
+
+// The time per call of the functions against the ones of the standard
+// library, on 4096 inputs of their typical range
+
+namespace ecm::bench
+{
+	namespace
+	{
+		constexpr uint64 INPUT_COUNT{ 4096 };
+
+		template<typename T>
+		std::vector<T> make_inputs(float64 lo, float64 hi)
+		{
+			math::Xoshiro256pp rng(0xECu);
+			std::vector<T> inputs(INPUT_COUNT);
+			for (T& x : inputs)
+				x = static_cast<T>(lo + (hi - lo) * static_cast<float64>(rng() >> 11) * 0x1p-53);
+			return inputs;
+		}
+
+		template<typename T, typename Function, typename Baseline>
+		void measure(Options const& options, Report& report, std::string const& name, char const* typeName,
+			float64 lo, float64 hi, Function const& function, Baseline const& baseline)
+		{
+			const std::string caseName{ name + "." + typeName };
+			if (!report.Selected(caseName))
+				return;
+			const std::vector<T> inputs{ make_inputs<T>(lo, hi) };
+			std::vector<T> outputs(INPUT_COUNT);
+			const float64 ns{ MeasureNs(options, INPUT_COUNT, [&]() {
+				for (uint64 i{ 0 }; i < INPUT_COUNT; ++i)
+					outputs[i] = function(inputs[i]);
+				Consume(outputs[0]);
+			}) };
+			const float64 baselineNs{ MeasureNs(options, INPUT_COUNT, [&]() {
+				for (uint64 i{ 0 }; i < INPUT_COUNT; ++i)
+					outputs[i] = baseline(inputs[i]);
+				Consume(outputs[0]);
+			}) };
+			report.AddThroughput(caseName, ns, "std::" + name, baselineNs);
+		}
+
+		template<typename T>
+		void measure_pow_batch(Options const& options, Report& report, char const* typeName, int32 exp)
+		{
+			const std::string caseName{ std::string("PowBatch.") + typeName };
+			if (!report.Selected(caseName))
+				return;
+			const std::vector<T> inputs{ make_inputs<T>(0.5, 2.0) };
+			std::vector<T> outputs(INPUT_COUNT);
+			const float64 ns{ MeasureNs(options, INPUT_COUNT, [&]() {
+				math::PowBatch(inputs.data(), outputs.data(), INPUT_COUNT, exp);
+				Consume(outputs[0]);
+			}) };
+			const float64 baselineNs{ MeasureNs(options, INPUT_COUNT, [&]() {
+				for (uint64 i{ 0 }; i < INPUT_COUNT; ++i)
+					outputs[i] = std::pow(inputs[i], static_cast<T>(exp));
+				Consume(outputs[0]);
+			}) };
+			report.AddThroughput(caseName, ns, "std::pow loop", baselineNs);
+		}
+
+		template<typename T>
+		void measure_fact_batch(Options const& options, Report& report, char const* typeName)
+		{
+			const std::string caseName{ std::string("FactBatch.") + typeName };
+			if (!report.Selected(caseName))
+				return;
+			std::vector<uint32> inputs(INPUT_COUNT);
+			math::Pcg32 rng(0xECu);
+			for (uint32& n : inputs)
+				n = rng() % 40;
+			std::vector<T> outputs(INPUT_COUNT);
+			const float64 ns{ MeasureNs(options, INPUT_COUNT, [&]() {
+				math::FactBatch(inputs.data(), outputs.data(), INPUT_COUNT);
+				Consume(outputs[0]);
+			}) };
+			const float64 baselineNs{ MeasureNs(options, INPUT_COUNT, [&]() {
+				for (uint64 i{ 0 }; i < INPUT_COUNT; ++i)
+					outputs[i] = math::Fact(static_cast<T>(inputs[i]));
+				Consume(outputs[0]);
+			}) };
+			report.AddThroughput(caseName, ns, "Fact loop", baselineNs);
+		}
+
+		template<typename Function, typename Baseline>
+		void measure(Options const& options, Report& report, std::string const& name, float64 lo, float64 hi,
+			Function const& function, Baseline const& baseline)
+		{
+			measure<float32>(options, report, name, "float32", lo, hi, function, baseline);
+			measure<float64>(options, report, name, "float64", lo, hi, function, baseline);
+		}
+	} // anonymous namespace
+
+#define ECM_BENCH_FUNCTION(name, lo, hi, function, baseline) \
+	measure(options, report, name, lo, hi, [](auto x) { return math::function(x); }, [](auto x) { return std::baseline(x); })
+
+	ECM_BENCH_SUITE(functions)
+	{
+		ECM_BENCH_FUNCTION("sqrt", 0.0, 1e6, Sqrt, sqrt);
+		ECM_BENCH_FUNCTION("cbrt", -1e6, 1e6, Cbrt, cbrt);
+		ECM_BENCH_FUNCTION("exp", -80.0, 80.0, Exp, exp);
+		ECM_BENCH_FUNCTION("floor", -1e6, 1e6, Floor, floor);
+		ECM_BENCH_FUNCTION("ceil", -1e6, 1e6, Ceil, ceil);
+		ECM_BENCH_FUNCTION("trunc", -1e6, 1e6, Trunc, trunc);
+		ECM_BENCH_FUNCTION("sin", -10.0, 10.0, Sin, sin);
+		ECM_BENCH_FUNCTION("cos", -10.0, 10.0, Cos, cos);
+		ECM_BENCH_FUNCTION("tan", -1.5, 1.5, Tan, tan);
+		ECM_BENCH_FUNCTION("atan", -10.0, 10.0, Atan, atan);
+		ECM_BENCH_FUNCTION("tanh", -10.0, 10.0, Tanh, tanh);
+		ECM_BENCH_FUNCTION("log", 1e-6, 1e6, Log, log);
+		ECM_BENCH_FUNCTION("log2", 1e-6, 1e6, Log2, log2);
+		measure(options, report, "pow.int3", -10.0, 10.0,
+			[](auto x) { return math::Pow(x, 3); },
+			[](auto x) { return std::pow(x, static_cast<decltype(x)>(3)); });
+		measure(options, report, "pow.const3", -10.0, 10.0,
+			[](auto x) { return math::Pow<3>(x); },
+			[](auto x) { return std::pow(x, static_cast<decltype(x)>(3)); });
+		measure(options, report, "pow.int-5", 0.5, 2.0,
+			[](auto x) { return math::Pow(x, -5); },
+			[](auto x) { return std::pow(x, static_cast<decltype(x)>(-5)); });
+		measure(options, report, "frexp", -1e6, 1e6,
+			[](auto x) { int32 e{ 0 }; return math::Frexp(x, &e); },
+			[](auto x) { int e{ 0 }; return std::frexp(x, &e); });
+		measure(options, report, "hypot", -1e6, 1e6,
+			[](auto x) { return math::Hypot(x, x * 0.5f); },
+			[](auto x) { return std::hypot(x, x * 0.5f); });
+		measure(options, report, "fmod", -1e6, 1e6,
+			[](auto x) { return math::Fmod(x, 3.7f); },
+			[](auto x) { return std::fmod(x, static_cast<decltype(x)>(3.7f)); });
+
+		measure_pow_batch<float32>(options, report, "float32", 5);
+		measure_pow_batch<float64>(options, report, "float64", 5);
+		measure_fact_batch<float32>(options, report, "float32");
+		measure_fact_batch<float64>(options, report, "float64");
+	}
+
+#undef ECM_BENCH_FUNCTION
+} // namespace ecm::bench
@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	void print_usage(char const* program)
+	{
+		std::printf(
+			"Usage: %s [options]\n"
+			"  --quick          Sample the sweeps and shorten the timings\n"
+			"  --filter <text>  Only run cases whose name contains the text\n"
+			"  --json <path>    Write the results as JSON to the path\n"
+			"  --help           Print this help\n", program);
+	}
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+	ecm::bench::Options options;
+	for (int i{ 1 }; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--quick") == 0) {
+			options.quick = true;
+		} else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+			options.filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+			options.jsonPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--help") == 0) {
+			print_usage(argv[0]);
+			return 0;
+		} else {
+			std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	ecm::bench::Report report(options);
+	ecm::bench::RunSuites(options, report);
+	if (!report.WriteJson()) {
+		std::fprintf(stderr, "Cannot write %s\n", options.jsonPath.c_str());
+		return 1;
+	}
+	return 0;
+}
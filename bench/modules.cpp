@@ -0,0 +1,1426 @@
+#include "bench.h"
+
+#include <ECM/math/animation.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/bvh.h>
+#include <ECM/math/collision.h>
+#include <ECM/math/dense_matrix.h>
+#include <ECM/math/easing.h>
+#include <ECM/math/fft.h>
+#include <ECM/math/fixed.h>
+#include <ECM/math/float16.h>
+#include <ECM/math/frustum.h>
+#include <ECM/math/functions.h>
+#include <ECM/math/loose_tree.h>
+#include <ECM/math/matrixn.h>
+#include <ECM/math/morton.h>
+#include <ECM/math/noise.h>
+#include <ECM/math/packing.h>
+#include <ECM/math/quaternion.h>
+#include <ECM/math/random.h>
+#include <ECM/math/ray.h>
+#include <ECM/math/reduction.h>
+#include <ECM/math/skinning.h>
+#include <ECM/math/sparse_matrix.h>
+#include <ECM/math/spatial_hash.h>
+#include <ECM/math/ext/vector_ext.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+// The batch functions of the Math module against loops over their scalar
+// counterparts
+
+namespace ecm::bench
+{
+	namespace
+	{
+		constexpr uint64 ITEM_COUNT{ 1ull << 16 };
+
+		std::vector<float32> make_floats(float32 lo, float32 hi)
+		{
+			std::vector<float32> values(ITEM_COUNT);
+			math::Pcg32 rng(0xECu);
+			math::FillUniform(rng, values.data(), values.size(), lo, hi);
+			return values;
+		}
+
+		std::vector<math::Vector3_Base<float32>> make_normals()
+		{
+			std::vector<math::Vector3_Base<float32>> normals(ITEM_COUNT);
+			math::Pcg32 rng(0xECu);
+			math::FillUnitSphere(rng, normals.data(), normals.size());
+			return normals;
+		}
+
+		void random_cases(Options const& options, Report& report)
+		{
+			std::vector<uint32> bits(ITEM_COUNT);
+			std::vector<float32> floats(ITEM_COUNT);
+			std::vector<math::Vector3_Base<float32>> points(ITEM_COUNT);
+
+			// The baselines only run for selected cases
+			math::Pcg32 pcg(1);
+			float64 pcgLoopNs{ 0.0 };
+			if (report.Selected("random.Pcg32.Fill") || report.Selected("random.Pcg32x8.Fill")) {
+				pcgLoopNs = MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint32& value : bits)
+						value = pcg();
+					Consume(bits[0]);
+				});
+			}
+			if (report.Selected("random.Pcg32.Fill")) {
+				report.AddThroughput("random.Pcg32.Fill", MeasureNs(options, ITEM_COUNT, [&]() {
+					pcg.Fill(bits.data(), bits.size());
+					Consume(bits[0]);
+				}), "Pcg32 loop", pcgLoopNs, "u32");
+			}
+			if (report.Selected("random.Pcg32x8.Fill")) {
+				math::Pcg32x8 pcg8(1);
+				report.AddThroughput("random.Pcg32x8.Fill", MeasureNs(options, ITEM_COUNT, [&]() {
+					pcg8.Fill(bits.data(), bits.size());
+					Consume(bits[0]);
+				}), "Pcg32 loop", pcgLoopNs, "u32");
+			}
+
+			math::Xoshiro256pp xoshiro(1);
+			float64 xoshiroLoopNs{ 0.0 };
+			if (report.Selected("random.Xoshiro256pp.Fill") || report.Selected("random.Xoshiro256ppx4.Fill")) {
+				xoshiroLoopNs = MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint32& value : bits)
+						value = static_cast<uint32>(xoshiro() >> 32);
+					Consume(bits[0]);
+				});
+			}
+			if (report.Selected("random.Xoshiro256pp.Fill")) {
+				report.AddThroughput("random.Xoshiro256pp.Fill", MeasureNs(options, ITEM_COUNT, [&]() {
+					xoshiro.Fill(bits.data(), bits.size());
+					Consume(bits[0]);
+				}), "Xoshiro256pp loop", xoshiroLoopNs, "u32");
+			}
+			if (report.Selected("random.Xoshiro256ppx4.Fill")) {
+				math::Xoshiro256ppx4 xoshiro4(1);
+				report.AddThroughput("random.Xoshiro256ppx4.Fill", MeasureNs(options, ITEM_COUNT, [&]() {
+					xoshiro4.Fill(bits.data(), bits.size());
+					Consume(bits[0]);
+				}), "Xoshiro256pp loop", xoshiroLoopNs, "u32");
+			}
+
+			std::mt19937 mt(1);
+			math::Pcg32x8 pcg8(1);
+			if (report.Selected("random.FillUniform")) {
+				std::uniform_real_distribution<float32> uniform(0.f, 1.f);
+				const float64 baselineNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (float32& value : floats)
+						value = uniform(mt);
+					Consume(floats[0]);
+				}) };
+				report.AddThroughput("random.FillUniform", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::FillUniform(pcg8, floats.data(), floats.size());
+					Consume(floats[0]);
+				}), "std::uniform_real_distribution", baselineNs, "f32");
+			}
+			if (report.Selected("random.FillNormal")) {
+				std::normal_distribution<float32> normal(0.f, 1.f);
+				const float64 baselineNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (float32& value : floats)
+						value = normal(mt);
+					Consume(floats[0]);
+				}) };
+				report.AddThroughput("random.FillNormal", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::FillNormal(pcg8, floats.data(), floats.size());
+					Consume(floats[0]);
+				}), "std::normal_distribution", baselineNs, "f32");
+			}
+			if (report.Selected("random.FillUnitSphere")) {
+				report.AddThroughput("random.FillUnitSphere", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::FillUnitSphere(pcg8, points.data(), points.size());
+					Consume(points[0]);
+				}), std::string(), 0.0, "vec");
+			}
+		}
+
+		void noise_case(Options const& options, Report& report, char const* name, math::NoiseType type)
+		{
+			const std::string caseName{ std::string("noise.FillNoiseGrid.") + name };
+			if (!report.Selected(caseName))
+				return;
+			constexpr uint32 SIZE{ 256 };
+			math::NoiseSettings settings;
+			settings.type = type;
+			settings.frequency = 1.f / 32.f;
+			const math::Vector2_Base<float32> origin(0.f, 0.f);
+			const math::Vector2_Base<float32> spacing(1.f, 1.f);
+			std::vector<float32> grid(SIZE * SIZE);
+			const float64 scalarNs{ MeasureNs(options, grid.size(), [&]() {
+				for (uint32 y{ 0 }; y < SIZE; ++y) {
+					for (uint32 x{ 0 }; x < SIZE; ++x)
+						grid[y * SIZE + x] = math::Noise(settings, math::Vector2_Base<float32>(static_cast<float32>(x), static_cast<float32>(y)));
+				}
+				Consume(grid[0]);
+			}) };
+			report.AddThroughput(caseName, MeasureNs(options, grid.size(), [&]() {
+				math::FillNoiseGrid(settings, origin, spacing, SIZE, SIZE, grid.data());
+				Consume(grid[0]);
+			}), "Noise loop", scalarNs, "pt");
+		}
+
+		void noise_cases(Options const& options, Report& report)
+		{
+			noise_case(options, report, "Perlin", math::NoiseType::PERLIN);
+			noise_case(options, report, "OpenSimplex2", math::NoiseType::OPENSIMPLEX2);
+			noise_case(options, report, "Worley", math::NoiseType::WORLEY);
+
+			if (!report.Selected("noise.NoiseBatch.fbm3d"))
+				return;
+			math::NoiseSettings settings;
+			settings.fractal = math::FractalType::FBM;
+			std::vector<math::Vector3_Base<float32>> points(ITEM_COUNT / 4);
+			math::Pcg32 rng(0xECu);
+			math::FillUniform(rng, points.data(), points.size(), -100.f, 100.f);
+			std::vector<float32> values(points.size());
+			const float64 scalarNs{ MeasureNs(options, points.size(), [&]() {
+				for (size_t i{ 0 }; i < points.size(); ++i)
+					values[i] = math::Noise(settings, points[i]);
+				Consume(values[0]);
+			}) };
+			report.AddThroughput("noise.NoiseBatch.fbm3d", MeasureNs(options, points.size(), [&]() {
+				math::NoiseBatch(settings, points.data(), values.data(), points.size());
+				Consume(values[0]);
+			}), "Noise loop", scalarNs, "pt");
+		}
+
+		void float16_cases(Options const& options, Report& report)
+		{
+			const std::vector<float32> floats{ make_floats(-1e4f, 1e4f) };
+			std::vector<float16> halves(ITEM_COUNT);
+			std::vector<float32> restored(ITEM_COUNT);
+			if (report.Selected("float16.ConvertF32ToF16")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						halves[i] = float16::FromBits(math::Float32ToFloat16Bits(floats[i]));
+					Consume(halves[0]);
+				}) };
+				report.AddThroughput("float16.ConvertF32ToF16", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::ConvertF32ToF16(floats.data(), halves.data(), ITEM_COUNT);
+					Consume(halves[0]);
+				}), "Float32ToFloat16Bits loop", scalarNs);
+			}
+			if (report.Selected("float16.ConvertF16ToF32")) {
+				math::ConvertF32ToF16(floats.data(), halves.data(), ITEM_COUNT);
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						restored[i] = math::Float16BitsToFloat32(halves[i].bits);
+					Consume(restored[0]);
+				}) };
+				report.AddThroughput("float16.ConvertF16ToF32", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::ConvertF16ToF32(halves.data(), restored.data(), ITEM_COUNT);
+					Consume(restored[0]);
+				}), "Float16BitsToFloat32 loop", scalarNs);
+			}
+		}
+
+		void packing_cases(Options const& options, Report& report)
+		{
+			const std::vector<math::Vector3_Base<float32>> normals{ make_normals() };
+			std::vector<uint32> packed(ITEM_COUNT);
+			std::vector<math::Vector3_Base<float32>> unpacked(ITEM_COUNT);
+			if (report.Selected("packing.EncodeOctahedral16Batch")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						packed[i] = math::EncodeOctahedral16(normals[i]);
+					Consume(packed[0]);
+				}) };
+				report.AddThroughput("packing.EncodeOctahedral16Batch", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::EncodeOctahedral16Batch(normals.data(), packed.data(), ITEM_COUNT);
+					Consume(packed[0]);
+				}), "EncodeOctahedral16 loop", scalarNs);
+			}
+			if (report.Selected("packing.DecodeOctahedral16Batch")) {
+				math::EncodeOctahedral16Batch(normals.data(), packed.data(), ITEM_COUNT);
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						unpacked[i] = math::DecodeOctahedral16(packed[i]);
+					Consume(unpacked[0]);
+				}) };
+				report.AddThroughput("packing.DecodeOctahedral16Batch", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::DecodeOctahedral16Batch(packed.data(), unpacked.data(), ITEM_COUNT);
+					Consume(unpacked[0]);
+				}), "DecodeOctahedral16 loop", scalarNs);
+			}
+		}
+
+		void fixed_cases(Options const& options, Report& report)
+		{
+			const std::vector<float32> floats{ make_floats(-100.f, 100.f) };
+			std::vector<math::Fixed16_16> a(ITEM_COUNT);
+			std::vector<math::Fixed16_16> b(ITEM_COUNT);
+			std::vector<math::Fixed16_16> out(ITEM_COUNT);
+			for (uint64 i{ 0 }; i < ITEM_COUNT; ++i) {
+				a[i] = math::Fixed16_16(floats[i]);
+				b[i] = math::Fixed16_16(floats[ITEM_COUNT - 1 - i]);
+			}
+			if (report.Selected("fixed.MulBatch.Fixed16_16")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						out[i] = a[i] * b[i];
+					Consume(out[0]);
+				}) };
+				report.AddThroughput("fixed.MulBatch.Fixed16_16", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::MulBatch(a.data(), b.data(), out.data(), ITEM_COUNT);
+					Consume(out[0]);
+				}), "operator* loop", scalarNs);
+			}
+			if (report.Selected("fixed.Sin.Fixed16_16")) {
+				std::vector<float32> results(ITEM_COUNT);
+				const float64 baselineNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						results[i] = std::sin(floats[i]);
+					Consume(results[0]);
+				}) };
+				report.AddThroughput("fixed.Sin.Fixed16_16", MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						out[i] = math::Sin(a[i]);
+					Consume(out[0]);
+				}), "std::sin float32", baselineNs);
+			}
+		}
+
+		void easing_cases(Options const& options, Report& report)
+		{
+			const std::vector<float32> from{ make_floats(-10.f, 10.f) };
+			const std::vector<float32> to{ make_floats(-20.f, 20.f) };
+			const std::vector<float32> factors{ make_floats(0.f, 1.f) };
+			std::vector<float32> out(ITEM_COUNT);
+			if (report.Selected("easing.LerpBatch.Vector3")) {
+				const uint64 count{ ITEM_COUNT / 3 };
+				auto const* x{ reinterpret_cast<math::Vector3_Base<float32> const*>(from.data()) };
+				auto const* y{ reinterpret_cast<math::Vector3_Base<float32> const*>(to.data()) };
+				auto* vectors{ reinterpret_cast<math::Vector3_Base<float32>*>(out.data()) };
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i)
+						vectors[i] = math::Lerp(x[i], y[i], factors[i]);
+					Consume(out[0]);
+				}) };
+				report.AddThroughput("easing.LerpBatch.Vector3", MeasureNs(options, count, [&]() {
+					math::LerpBatch(x, y, factors.data(), vectors, count);
+					Consume(out[0]);
+				}), "Lerp loop", scalarNs, "vec");
+			}
+			const std::pair<char const*, math::EaseType> curves[]{
+				{ "CUBIC_IN_OUT", math::EaseType::CUBIC_IN_OUT },
+				{ "ELASTIC_OUT", math::EaseType::ELASTIC_OUT }
+			};
+			for (auto const& curve : curves) {
+				const std::string caseName{ std::string("easing.EaseBatch.") + curve.first };
+				if (!report.Selected(caseName))
+					continue;
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						out[i] = math::Ease(curve.second, factors[i]);
+					Consume(out[0]);
+				}) };
+				report.AddThroughput(caseName, MeasureNs(options, ITEM_COUNT, [&]() {
+					math::EaseBatch(curve.second, factors.data(), out.data(), ITEM_COUNT);
+					Consume(out[0]);
+				}), "Ease loop", scalarNs);
+			}
+			if (report.Selected("easing.EvaluateTracks.CUBIC_IN_OUT")) {
+				// Four times the items, as an animation system evaluates
+				// hundreds of thousands of channels
+				const uint64 count{ ITEM_COUNT * 4 };
+				std::vector<float32> start(count);
+				std::vector<float32> duration(count);
+				std::vector<float32> startValues(count);
+				std::vector<float32> endValues(count);
+				math::Pcg32 rng(0xECu);
+				math::FillUniform(rng, start.data(), count, 0.f, 1.f);
+				math::FillUniform(rng, duration.data(), count, 0.5f, 2.f);
+				math::FillUniform(rng, startValues.data(), count, -1.f, 1.f);
+				math::FillUniform(rng, endValues.data(), count, -1.f, 1.f);
+				std::vector<float32> results(count);
+				const math::EaseTracks tracks{ math::EaseType::CUBIC_IN_OUT, start.data(), duration.data() };
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						const float32 t{ math::Ease(tracks.type, (1.f - start[i]) / duration[i]) };
+						results[i] = math::Lerp(startValues[i], endValues[i], t);
+					}
+					Consume(results[0]);
+				}) };
+				report.AddThroughput("easing.EvaluateTracks.CUBIC_IN_OUT", MeasureNs(options, count, [&]() {
+					math::EvaluateTracks(tracks, 1.f, startValues.data(), endValues.data(), results.data(), count);
+					Consume(results[0]);
+				}), "Ease and Lerp loop", scalarNs, "trk");
+			}
+		}
+		// A track with the keys in one array, sampled with a binary search
+		template<typename T>
+		struct aos_track
+		{
+			std::vector<float32> times;
+			std::vector<T> values;
+		};
+
+		template<typename T, typename Interpolate>
+		T sample_aos(aos_track<T> const& track, float32 time, Interpolate const& interpolate)
+		{
+			const uint64 last{ track.times.size() - 1 };
+			const uint64 next{ static_cast<uint64>(std::upper_bound(track.times.begin(), track.times.end(), time)
+				- track.times.begin()) };
+			if (next == 0)
+				return track.values[0];
+			if (next > last)
+				return track.values[last];
+			const float32 t{ (time - track.times[next - 1]) / (track.times[next] - track.times[next - 1]) };
+			return interpolate(track.values[next - 1], track.values[next], t);
+		}
+
+		template<typename T, typename MakeValue, typename Interpolate>
+		void animation_case(Options const& options, Report& report, std::string const& caseName,
+			MakeValue const& makeValue, Interpolate const& interpolate)
+		{
+			if (!report.Selected(caseName))
+				return;
+			// Twice the items, as an animation system samples more than
+			// 100k tracks per frame
+			const uint64 count{ ITEM_COUNT * 2 };
+			constexpr uint32 keyCount{ 32 };
+			math::Pcg32 rng(0xA1u);
+			std::vector<math::AnimationTrack<T>> tracks(count);
+			std::vector<aos_track<T>> aosTracks(count);
+			for (uint64 i{ 0 }; i < count; ++i) {
+				tracks[i].Reserve(keyCount);
+				float32 time{ 0.f };
+				for (uint32 k{ 0 }; k < keyCount; ++k) {
+					const T value{ makeValue(rng) };
+					tracks[i].AddKey(time, value);
+					aosTracks[i].times.push_back(time);
+					aosTracks[i].values.push_back(value);
+					time += 0.25f + static_cast<float32>(rng() >> 8) * (0.25f / 16777216.f);
+				}
+			}
+			std::vector<math::AnimationCursor> cursors(count);
+			std::vector<T> results(count);
+			// Each run samples the next frame of a 60 Hz animation
+			float32 time{ 0.f };
+			const float64 scalarNs{ MeasureNs(options, count, [&]() {
+				time = time < 3.f ? time + 1.f / 60.f : 0.f;
+				for (uint64 i{ 0 }; i < count; ++i)
+					results[i] = sample_aos(aosTracks[i], time, interpolate);
+				Consume(results[0][0]);
+			}) };
+			time = 0.f;
+			report.AddThroughput(caseName, MeasureNs(options, count, [&]() {
+				time = time < 3.f ? time + 1.f / 60.f : 0.f;
+				math::SampleAll(tracks.data(), cursors.data(), time, results.data(), count);
+				Consume(results[0][0]);
+			}), "binary search and Lerp loop", scalarNs, "trk");
+		}
+
+		void animation_cases(Options const& options, Report& report)
+		{
+			animation_case<math::Vector3_Base<float32>>(options, report, "animation.SampleAll.Vector3",
+				[](math::Pcg32& rng) {
+					const float32 scale{ 1.f / 16777216.f };
+					return math::Vector3_Base<float32>(static_cast<float32>(rng() >> 8) * scale,
+						static_cast<float32>(rng() >> 8) * scale, static_cast<float32>(rng() >> 8) * scale);
+				},
+				[](math::Vector3_Base<float32> const& x, math::Vector3_Base<float32> const& y, float32 t) {
+					return math::Lerp(x, y, t);
+				});
+			animation_case<math::Quaternion>(options, report, "animation.SampleAll.Quaternion",
+				[](math::Pcg32& rng) {
+					const float32 angle{ static_cast<float32>(rng() >> 8) * (6.2831853f / 16777216.f) };
+					return math::QuaternionFromAxisAngle(math::Vector3_Base<float32>(0.f, 0.6f, 0.8f), angle);
+				},
+				[](math::Quaternion const& x, math::Quaternion const& y, float32 t) {
+					return math::Nlerp(x, y, t);
+				});
+		}
+
+		// A mesh with four influences per vertex on a palette of 128 bones
+		struct skinning_mesh
+		{
+			std::vector<float32> positions[3];
+			std::vector<float32> normals[3];
+			std::vector<uint16> bones;
+			std::vector<float32> weights;
+			std::vector<float32> outPositions[3];
+			std::vector<float32> outNormals[3];
+		};
+
+		void skinning_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("skinning.SkinLinear") && !report.Selected("skinning.SkinDualQuat"))
+				return;
+			const uint64 count{ ITEM_COUNT };
+			constexpr uint32 boneCount{ 128 };
+			math::Pcg32 rng(0x5Cu);
+			std::vector<math::Matrix4x4_Base<float32>> model(boneCount);
+			std::vector<math::Matrix4x4_Base<float32>> inverseBind(boneCount);
+			for (uint32 b{ 0 }; b < boneCount; ++b) {
+				const float32 angle{ static_cast<float32>(rng() >> 8) * (6.2831853f / 16777216.f) };
+				model[b] = math::ToMatrix(math::QuaternionFromAxisAngle(math::Vector3_Base<float32>(0.f, 0.6f, 0.8f), angle));
+				model[b].m30 = static_cast<float32>(b);
+			}
+			std::vector<math::SkinningMatrix> matrices(boneCount);
+			std::vector<math::DualQuaternion_Base<float32>> dualQuaternions(boneCount);
+			math::ComputeSkinningMatrices(model.data(), inverseBind.data(), matrices.data(), boneCount);
+			math::ComputeSkinningMatrices(model.data(), inverseBind.data(), dualQuaternions.data(), boneCount);
+
+			skinning_mesh mesh;
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				mesh.positions[c].resize(count);
+				mesh.normals[c].resize(count);
+				mesh.outPositions[c].resize(count);
+				mesh.outNormals[c].resize(count);
+				math::FillUniform(rng, mesh.positions[c].data(), count, -1.f, 1.f);
+				math::FillUniform(rng, mesh.normals[c].data(), count, -1.f, 1.f);
+			}
+			mesh.bones.resize(count * 4);
+			mesh.weights.resize(count * 4);
+			math::FillUniform(rng, mesh.weights.data(), count * 4, 0.f, 1.f);
+			for (uint64 i{ 0 }; i < count; ++i) {
+				// Neighbouring vertices have neighbouring bones
+				const uint32 bone{ static_cast<uint32>(i * boneCount / count) };
+				float32 sum{ 0.f };
+				for (uint32 k{ 0 }; k < 4; ++k) {
+					mesh.bones[i * 4 + k] = static_cast<uint16>(std::min(bone + (rng() & 3u), boneCount - 1));
+					sum += mesh.weights[i * 4 + k];
+				}
+				for (uint32 k{ 0 }; k < 4; ++k)
+					mesh.weights[i * 4 + k] /= sum;
+			}
+			math::SkinningVertices vertices;
+			math::SkinnedVertices out;
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				vertices.positions[c] = mesh.positions[c].data();
+				vertices.normals[c] = mesh.normals[c].data();
+				out.positions[c] = mesh.outPositions[c].data();
+				out.normals[c] = mesh.outNormals[c].data();
+			}
+			vertices.bones = mesh.bones.data();
+			vertices.weights = mesh.weights.data();
+
+			if (report.Selected("skinning.SkinLinear")) {
+				std::vector<math::Matrix4x4_Base<float32>> palette(boneCount);
+				for (uint32 b{ 0 }; b < boneCount; ++b)
+					palette[b] = model[b] * inverseBind[b];
+				// One vertex at a time, with the blended matrix
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						math::Matrix4x4_Base<float32> m{ palette[mesh.bones[i * 4]] * mesh.weights[i * 4] };
+						for (uint32 k{ 1 }; k < 4; ++k)
+							m += palette[mesh.bones[i * 4 + k]] * mesh.weights[i * 4 + k];
+						const float32 p[3]{ mesh.positions[0][i], mesh.positions[1][i], mesh.positions[2][i] };
+						const float32 n[3]{ mesh.normals[0][i], mesh.normals[1][i], mesh.normals[2][i] };
+						for (uint32 r{ 0 }; r < 3; ++r) {
+							mesh.outPositions[r][i] = m.matrix[0][r] * p[0] + m.matrix[1][r] * p[1] + m.matrix[2][r] * p[2]
+								+ m.matrix[3][r];
+							mesh.outNormals[r][i] = m.matrix[0][r] * n[0] + m.matrix[1][r] * n[1] + m.matrix[2][r] * n[2];
+						}
+					}
+					Consume(mesh.outPositions[0][0]);
+				}) };
+				report.AddThroughput("skinning.SkinLinear", MeasureNs(options, count, [&]() {
+					math::SkinLinear(matrices.data(), vertices, out, count);
+					Consume(mesh.outPositions[0][0]);
+				}), "Matrix4x4 blend loop", scalarNs, "vtx");
+			}
+			if (report.Selected("skinning.SkinDualQuat")) {
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						math::DualQuaternion_Base<float32> const& first{ dualQuaternions[mesh.bones[i * 4]] };
+						math::DualQuaternion_Base<float32> dq{ first * mesh.weights[i * 4] };
+						for (uint32 k{ 1 }; k < 4; ++k) {
+							math::DualQuaternion_Base<float32> const& bone{ dualQuaternions[mesh.bones[i * 4 + k]] };
+							const float32 sign{ math::Dot(bone.real, first.real) < 0.f ? -1.f : 1.f };
+							dq = dq + bone * (mesh.weights[i * 4 + k] * sign);
+						}
+						dq = math::Normalize(dq);
+						const math::Vector3_Base<float32> p{ math::Transform(dq, math::Vector3_Base<float32>(
+							mesh.positions[0][i], mesh.positions[1][i], mesh.positions[2][i])) };
+						const math::Vector3_Base<float32> n{ math::Rotate(dq.real, math::Vector3_Base<float32>(
+							mesh.normals[0][i], mesh.normals[1][i], mesh.normals[2][i])) };
+						for (uint32 c{ 0 }; c < 3; ++c) {
+							mesh.outPositions[c][i] = p[c];
+							mesh.outNormals[c][i] = n[c];
+						}
+					}
+					Consume(mesh.outPositions[0][0]);
+				}) };
+				report.AddThroughput("skinning.SkinDualQuat", MeasureNs(options, count, [&]() {
+					math::SkinDualQuat(dualQuaternions.data(), vertices, out, count);
+					Consume(mesh.outPositions[0][0]);
+				}), "DualQuaternion blend loop", scalarNs, "vtx");
+			}
+		}
+		void bounds_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("bounds.ComputeBounds"))
+				return;
+			const std::vector<math::Vector3_Base<float32>> points{ make_normals() };
+			const float64 scalarNs{ MeasureNs(options, points.size(), [&]() {
+				math::AABB_Base<float32> box;
+				for (math::Vector3_Base<float32> const& point : points)
+					box = math::Merge(box, point);
+				Consume(box.max.x);
+			}) };
+			report.AddThroughput("bounds.ComputeBounds", MeasureNs(options, points.size(), [&]() {
+				Consume(math::ComputeBounds(points.data(), points.size()).max.x);
+			}), "AABB Merge loop", scalarNs, "pts");
+		}
+		void frustum_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("frustum.CullAABBs"))
+				return;
+			// A camera at the origin, which looks along -z with a field of
+			// view of 90 degrees, over boxes in [-64, 64]
+			math::Matrix4x4_Base<float32> projection(0.f);
+			projection.m00 = 1.f;
+			projection.m11 = 1.f;
+			projection.m22 = -1.002f;
+			projection.m23 = -1.f;
+			projection.m32 = -0.2002f;
+			const math::Frustum frustum{ math::FrustumFromMatrix(projection) };
+			const uint64 count{ ITEM_COUNT };
+			std::vector<float32> centers[3];
+			std::vector<float32> min[3];
+			std::vector<float32> max[3];
+			math::AABBArrays boxes;
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				centers[c] = make_floats(-64.f, 64.f);
+				std::rotate(centers[c].begin(), centers[c].begin() + c * 977, centers[c].end());
+				min[c].resize(count);
+				max[c].resize(count);
+				for (uint64 i{ 0 }; i < count; ++i) {
+					min[c][i] = centers[c][i] - 0.5f;
+					max[c][i] = centers[c][i] + 0.5f;
+				}
+				boxes.min[c] = min[c].data();
+				boxes.max[c] = max[c].data();
+			}
+			std::vector<uint32> visible(count);
+			const float64 scalarNs{ MeasureNs(options, count, [&]() {
+				uint64 visibleCount{ 0 };
+				for (uint64 i{ 0 }; i < count; ++i) {
+					const math::AABB box(math::Vector3_Base<float32>(min[0][i], min[1][i], min[2][i]),
+						math::Vector3_Base<float32>(max[0][i], max[1][i], max[2][i]));
+					if (math::Intersects(frustum, box))
+						visible[visibleCount++] = static_cast<uint32>(i);
+				}
+				Consume(visibleCount);
+			}) };
+			report.AddThroughput("frustum.CullAABBs", MeasureNs(options, count, [&]() {
+				Consume(math::CullAABBs(frustum, boxes, count, visible.data()));
+			}), "Intersects loop", scalarNs, "obj");
+		}
+		void ray_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("ray.IntersectPacket8.Triangle") && !report.Selected("ray.IntersectPacket8.AABB"))
+				return;
+			// Rays along z through 16 triangles and boxes in front of them,
+			// each ray keeps its closest hit
+			constexpr uint32 primitiveCount{ 16 };
+			const uint64 count{ ITEM_COUNT };
+			std::vector<float32> xy[2]{ make_floats(-1.f, 1.f), make_floats(-1.f, 1.f) };
+			std::rotate(xy[1].begin(), xy[1].begin() + 977, xy[1].end());
+			std::vector<math::Ray> rays(count);
+			std::vector<math::RayPacket8> packets(count / 8);
+			for (uint64 i{ 0 }; i < count; ++i) {
+				rays[i] = math::Ray(math::Vector3_Base<float32>(xy[0][i], xy[1][i], -10.f),
+					math::Vector3_Base<float32>(0.05f * xy[1][i], -0.05f * xy[0][i], 1.f));
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					packets[i / 8].origin[c][i % 8] = rays[i].origin[c];
+					packets[i / 8].direction[c][i % 8] = rays[i].direction[c];
+				}
+			}
+			math::Vector3_Base<float32> triangles[primitiveCount][3];
+			math::AABB boxes[primitiveCount];
+			math::Pcg32 rng(0x7Au);
+			for (uint32 p{ 0 }; p < primitiveCount; ++p) {
+				float32 values[6];
+				math::FillUniform(rng, values, 6, -1.f, 1.f);
+				const float32 z{ static_cast<float32>(p) };
+				triangles[p][0] = math::Vector3_Base<float32>(values[0], values[1], z);
+				triangles[p][1] = math::Vector3_Base<float32>(values[2], values[3], z + 0.5f);
+				triangles[p][2] = math::Vector3_Base<float32>(values[4], values[5], z - 0.5f);
+				boxes[p] = math::Merge(math::AABB(triangles[p][0], triangles[p][0]),
+					math::AABB(triangles[p][1], triangles[p][1]));
+			}
+			std::vector<float32> distances(count);
+
+			if (report.Selected("ray.IntersectPacket8.Triangle")) {
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						float32 closest{ std::numeric_limits<float32>::infinity() };
+						for (uint32 p{ 0 }; p < primitiveCount; ++p) {
+							float32 t;
+							float32 u;
+							float32 v;
+							if (math::Intersects(rays[i], triangles[p][0], triangles[p][1], triangles[p][2], t, u, v)
+								&& t < closest)
+								closest = t;
+						}
+						distances[i] = closest;
+					}
+					Consume(distances[0]);
+				}) };
+				report.AddThroughput("ray.IntersectPacket8.Triangle", MeasureNs(options, count, [&]() {
+					std::fill(distances.begin(), distances.end(), std::numeric_limits<float32>::infinity());
+					for (uint64 i{ 0 }; i < count; i += 8) {
+						for (uint32 p{ 0 }; p < primitiveCount; ++p) {
+							Consume(math::IntersectPacket(packets[i / 8], triangles[p][0], triangles[p][1],
+								triangles[p][2], distances.data() + i));
+						}
+					}
+					Consume(distances[0]);
+				}), "Moller-Trumbore loop", scalarNs, "ray");
+			}
+			if (report.Selected("ray.IntersectPacket8.AABB")) {
+				const float64 scalarNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						float32 closest{ std::numeric_limits<float32>::infinity() };
+						for (uint32 p{ 0 }; p < primitiveCount; ++p) {
+							float32 t;
+							if (math::Intersects(rays[i], boxes[p], t) && t < closest)
+								closest = t;
+						}
+						distances[i] = closest;
+					}
+					Consume(distances[0]);
+				}) };
+				report.AddThroughput("ray.IntersectPacket8.AABB", MeasureNs(options, count, [&]() {
+					std::fill(distances.begin(), distances.end(), std::numeric_limits<float32>::infinity());
+					for (uint64 i{ 0 }; i < count; i += 8) {
+						for (uint32 p{ 0 }; p < primitiveCount; ++p)
+							Consume(math::IntersectPacket(packets[i / 8], boxes[p], distances.data() + i));
+					}
+					Consume(distances[0]);
+				}), "slab test loop", scalarNs, "ray");
+			}
+		}
+		void bvh_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("bvh.Build") && !report.Selected("bvh.IntersectClosest"))
+				return;
+			// A height field of 256 x 256 quads, and rays from above onto it
+			constexpr uint32 gridSize{ 256 };
+			std::vector<math::Vector3_Base<float32>> vertices((gridSize + 1) * (gridSize + 1));
+			std::vector<float32> heights{ make_floats(-0.5f, 0.5f) };
+			for (uint32 y{ 0 }; y <= gridSize; ++y) {
+				for (uint32 x{ 0 }; x <= gridSize; ++x) {
+					const uint32 i{ y * (gridSize + 1) + x };
+					vertices[i] = math::Vector3_Base<float32>(static_cast<float32>(x), heights[i % heights.size()],
+						static_cast<float32>(y));
+				}
+			}
+			std::vector<uint32> indices;
+			indices.reserve(gridSize * gridSize * 6);
+			for (uint32 y{ 0 }; y < gridSize; ++y) {
+				for (uint32 x{ 0 }; x < gridSize; ++x) {
+					const uint32 i{ y * (gridSize + 1) + x };
+					const uint32 quad[6]{ i, i + 1, i + gridSize + 1, i + 1, i + gridSize + 2, i + gridSize + 1 };
+					indices.insert(indices.end(), quad, quad + 6);
+				}
+			}
+			const uint32 triangleCount{ gridSize * gridSize * 2 };
+			math::Bvh8 bvh;
+
+			if (report.Selected("bvh.Build")) {
+				report.AddThroughput("bvh.Build", MeasureNs(options, triangleCount, [&]() {
+					bvh.Build(vertices.data(), indices.data(), triangleCount);
+					Consume(bvh.GetNodeCount());
+				}), std::string(), 0.0, "tri");
+			}
+			if (report.Selected("bvh.IntersectClosest")) {
+				bvh.Build(vertices.data(), indices.data(), triangleCount);
+				const uint64 count{ ITEM_COUNT };
+				std::vector<float32> xz[2]{ make_floats(0.f, static_cast<float32>(gridSize)),
+					make_floats(0.f, static_cast<float32>(gridSize)) };
+				std::rotate(xz[1].begin(), xz[1].begin() + 977, xz[1].end());
+				std::vector<math::Ray> rays(count);
+				for (uint64 i{ 0 }; i < count; ++i) {
+					rays[i] = math::Ray(math::Vector3_Base<float32>(xz[0][i], 10.f, xz[1][i]),
+						math::Vector3_Base<float32>(0.3f, -1.f, 0.2f));
+				}
+				std::vector<math::BvhHit> hits(count);
+				const float64 serialNs{ MeasureNs(options, count, [&]() {
+					for (uint64 i{ 0 }; i < count; ++i) {
+						hits[i] = math::BvhHit();
+						Consume(bvh.IntersectClosest(rays[i], hits[i]));
+					}
+				}) };
+				report.AddThroughput("bvh.IntersectClosest", MeasureNs(options, count, [&]() {
+					std::fill(hits.begin(), hits.end(), math::BvhHit());
+					bvh.IntersectClosest(rays.data(), hits.data(), count);
+					Consume(hits[0].distance);
+				}), "one thread", serialNs, "ray");
+			}
+		}
+		void collision_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("collision.CollideBatch") && !report.Selected("collision.OBBIntersects"))
+				return;
+			// Spheres, boxes, capsules and hulls with random rotations on a
+			// grid, each paired with its neighbours along the axes, so that
+			// about half of the pairs intersect
+			constexpr uint32 gridSize{ 24 };
+			const uint32 count{ gridSize * gridSize * gridSize };
+			std::vector<float32> jitter{ make_floats(-0.25f, 0.25f) };
+			std::vector<float32> angles{ make_floats(-1.f, 1.f) };
+			static const math::Vector3_Base<float32> HullPoints[8]{
+				math::Vector3_Base<float32>(-0.5f, -0.3f, -0.4f), math::Vector3_Base<float32>(0.5f, -0.3f, -0.4f),
+				math::Vector3_Base<float32>(-0.4f, 0.3f, -0.4f), math::Vector3_Base<float32>(0.4f, 0.3f, -0.3f),
+				math::Vector3_Base<float32>(-0.5f, -0.3f, 0.4f), math::Vector3_Base<float32>(0.5f, -0.2f, 0.4f),
+				math::Vector3_Base<float32>(-0.4f, 0.3f, 0.4f), math::Vector3_Base<float32>(0.3f, 0.3f, 0.3f) };
+			std::vector<math::ConvexShape> shapes(count);
+			std::vector<math::Matrix4x4_Base<float32>> transforms(count);
+			std::vector<math::Vector3_Base<float32>> boxExtents(count);
+			for (uint32 i{ 0 }; i < count; ++i) {
+				math::ConvexShape& shape{ shapes[i] };
+				switch (i % 4) {
+				case 0:
+					shape.radius = 0.5f;
+					break;
+				case 1:
+					shape.type = math::ShapeType::BOX;
+					shape.extents = math::Vector3_Base<float32>(0.5f, 0.4f, 0.3f);
+					break;
+				case 2:
+					shape.type = math::ShapeType::SEGMENT;
+					shape.extents = math::Vector3_Base<float32>(0.f, 0.3f, 0.f);
+					shape.radius = 0.25f;
+					break;
+				default:
+					shape.type = math::ShapeType::HULL;
+					shape.points = HullPoints;
+					shape.pointCount = 8;
+					break;
+				}
+				boxExtents[i] = math::Vector3_Base<float32>(0.3f + 0.2f * angles[(i * 3) % ITEM_COUNT],
+					0.4f, 0.3f - 0.1f * angles[(i * 5) % ITEM_COUNT]);
+				math::Quaternion_Base<float32> q(angles[i % ITEM_COUNT], angles[(i * 7 + 1) % ITEM_COUNT],
+					angles[(i * 11 + 2) % ITEM_COUNT], angles[(i * 13 + 3) % ITEM_COUNT] + 1.5f);
+				const float32 inverseLength{ 1.f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w) };
+				q = math::Quaternion_Base<float32>(q.x * inverseLength, q.y * inverseLength, q.z * inverseLength,
+					q.w * inverseLength);
+				transforms[i] = math::ToMatrix(q);
+				transforms[i].matrix[3][0] = static_cast<float32>(i % gridSize) + jitter[i % ITEM_COUNT];
+				transforms[i].matrix[3][1] = static_cast<float32>(i / gridSize % gridSize) + jitter[(i * 3 + 1) % ITEM_COUNT];
+				transforms[i].matrix[3][2] = static_cast<float32>(i / (gridSize * gridSize)) + jitter[(i * 5 + 2) % ITEM_COUNT];
+			}
+			std::vector<math::SpatialPair> pairs;
+			for (uint32 i{ 0 }; i < count; ++i) {
+				if (i % gridSize + 1 < gridSize)
+					pairs.push_back({ i, i + 1 });
+				if (i / gridSize % gridSize + 1 < gridSize)
+					pairs.push_back({ i, i + gridSize });
+				if (i / (gridSize * gridSize) + 1 < gridSize)
+					pairs.push_back({ i, i + gridSize * gridSize });
+			}
+			const uint64 pairCount{ pairs.size() };
+			std::vector<math::Contact> contacts(pairCount);
+
+			if (report.Selected("collision.CollideBatch")) {
+				const float64 serialNs{ MeasureNs(options, pairCount, [&]() {
+					uint64 hits{ 0 };
+					for (uint64 i{ 0 }; i < pairCount; ++i) {
+						math::SpatialPair const& pair{ pairs[i] };
+						hits += math::Collide(shapes[pair.first], transforms[pair.first], shapes[pair.second],
+							transforms[pair.second], contacts[i]);
+					}
+					Consume(hits);
+				}) };
+				report.AddThroughput("collision.CollideBatch", MeasureNs(options, pairCount, [&]() {
+					Consume(math::CollideBatch(shapes.data(), transforms.data(), pairs.data(), pairCount, contacts.data()));
+				}), "one thread", serialNs, "pair");
+			}
+			if (report.Selected("collision.OBBIntersects")) {
+				// The same pairs as boxes
+				math::ConvexShape boxA, boxB;
+				boxA.type = boxB.type = math::ShapeType::BOX;
+				const float64 gjkNs{ MeasureNs(options, pairCount, [&]() {
+					uint64 hits{ 0 };
+					for (uint64 i{ 0 }; i < pairCount; ++i) {
+						math::SpatialPair const& pair{ pairs[i] };
+						boxA.extents = boxExtents[pair.first];
+						boxB.extents = boxExtents[pair.second];
+						hits += math::EpaPenetration(boxA, transforms[pair.first], boxB, transforms[pair.second],
+							contacts[i]);
+					}
+					Consume(hits);
+				}) };
+				report.AddThroughput("collision.OBBIntersects", MeasureNs(options, pairCount, [&]() {
+					uint64 hits{ 0 };
+					for (uint64 i{ 0 }; i < pairCount; ++i) {
+						math::SpatialPair const& pair{ pairs[i] };
+						hits += math::OBBIntersects(boxExtents[pair.first], transforms[pair.first],
+							boxExtents[pair.second], transforms[pair.second], &contacts[i]);
+					}
+					Consume(hits);
+				}), "GJK and EPA", gjkNs, "pair");
+			}
+		}
+		template<typename T>
+		void gemm_case(Options const& options, Report& report, std::string const& name)
+		{
+			if (!report.Selected(name))
+				return;
+			// The items are floating-point operations, a multiply and an add
+			// per step, so that 1 / (ns/item) is GFLOPS
+			constexpr uint32 size{ 256 };
+			const uint64 flops{ 2ull * size * size * size };
+			std::vector<float32> values{ make_floats(-1.f, 1.f) };
+			math::DenseMatrix<T> a(size, size), b(size, size), c(size, size);
+			for (uint32 i{ 0 }; i < size * size; ++i) {
+				a.GetData()[i] = static_cast<T>(values[i % ITEM_COUNT]);
+				b.GetData()[i] = static_cast<T>(values[(i * 7 + 3) % ITEM_COUNT]);
+			}
+			const float64 naiveNs{ MeasureNs(options, flops, [&]() {
+				T const* x{ a.GetData() };
+				T const* y{ b.GetData() };
+				T* z{ c.GetData() };
+				for (uint32 i{ 0 }; i < size; ++i) {
+					for (uint32 j{ 0 }; j < size; ++j) {
+						T sum{ 0 };
+						for (uint32 k{ 0 }; k < size; ++k)
+							sum += x[k * size + i] * y[j * size + k];
+						z[j * size + i] = sum;
+					}
+				}
+				Consume(z[0]);
+			}) };
+			report.AddThroughput(name, MeasureNs(options, flops, [&]() {
+				Consume(math::Gemm(T(1), a, math::MatrixOp::NONE, b, math::MatrixOp::NONE, T(0), c));
+			}), "triple loop", naiveNs, "flop");
+		}
+		void dense_matrix_cases(Options const& options, Report& report)
+		{
+			gemm_case<float32>(options, report, "dense_matrix.Gemm.float32");
+			gemm_case<float64>(options, report, "dense_matrix.Gemm.float64");
+		}
+		// The 5-point Laplacian of a grid plus the identity, like the
+		// systems of implicit heat diffusion, with dof unknowns per node
+		// coupled by dense blocks
+		std::vector<math::SparseTriplet<float64>> make_grid_laplacian(uint32 size, uint32 dof)
+		{
+			std::vector<math::SparseTriplet<float64>> triplets;
+			auto couple = [&](uint32 i, uint32 j, float64 value) {
+				for (uint32 a{ 0 }; a < dof; ++a) {
+					for (uint32 b{ 0 }; b < dof; ++b)
+						triplets.push_back({ i * dof + a, j * dof + b, a == b ? value : value * 0.1 });
+				}
+			};
+			for (uint32 y{ 0 }; y < size; ++y) {
+				for (uint32 x{ 0 }; x < size; ++x) {
+					const uint32 i{ y * size + x };
+					couple(i, i, 5.0);
+					if (x > 0)
+						couple(i, i - 1, -1.0);
+					if (x + 1 < size)
+						couple(i, i + 1, -1.0);
+					if (y > 0)
+						couple(i, i - size, -1.0);
+					if (y + 1 < size)
+						couple(i, i + size, -1.0);
+				}
+			}
+			return triplets;
+		}
+		void sparse_matrix_cases(Options const& options, Report& report)
+		{
+			if (report.Selected("sparse_matrix.Multiply")) {
+				constexpr uint32 size{ 512 };
+				const std::vector<math::SparseTriplet<float64>> triplets{ make_grid_laplacian(size, 1) };
+				math::SparseMatrix<float64> matrix;
+				matrix.Build(size * size, size * size, triplets.data(), triplets.size());
+				std::vector<float64> x(size * size, 1.0), y(size * size);
+				const uint64 count{ matrix.GetNonZeroCount() };
+				const float64 serialNs{ MeasureNs(options, count, [&]() {
+					uint64 const* offsets{ matrix.GetRowOffsets() };
+					uint32 const* columns{ matrix.GetColumnIndices() };
+					float64 const* values{ matrix.GetValues() };
+					for (uint32 row{ 0 }; row < size * size; ++row) {
+						float64 sum{ 0.0 };
+						for (uint64 i{ offsets[row] }; i < offsets[row + 1]; ++i)
+							sum += values[i] * x[columns[i]];
+						y[row] = sum;
+					}
+					Consume(y[0]);
+				}) };
+				report.AddThroughput("sparse_matrix.Multiply", MeasureNs(options, count, [&]() {
+					matrix.Multiply(x.data(), y.data());
+					Consume(y[0]);
+				}), "one thread", serialNs, "nonzero");
+			}
+			if (report.Selected("sparse_matrix.BlockSparseMatrix.Multiply")) {
+				// Three unknowns per node like cloth
+				constexpr uint32 size{ 256 };
+				const std::vector<math::SparseTriplet<float64>> triplets{ make_grid_laplacian(size, 3) };
+				math::SparseMatrix<float64> matrix;
+				matrix.Build(size * size * 3, size * size * 3, triplets.data(), triplets.size());
+				math::BlockSparseMatrix<float64> blocks;
+				blocks.Build(matrix, 3);
+				std::vector<float64> x(size * size * 3, 1.0), y(size * size * 3);
+				const uint64 count{ matrix.GetNonZeroCount() };
+				const float64 csrNs{ MeasureNs(options, count, [&]() {
+					matrix.Multiply(x.data(), y.data());
+					Consume(y[0]);
+				}) };
+				report.AddThroughput("sparse_matrix.BlockSparseMatrix.Multiply", MeasureNs(options, count, [&]() {
+					blocks.Multiply(x.data(), y.data());
+					Consume(y[0]);
+				}), "SparseMatrix", csrNs, "nonzero");
+			}
+			if (report.Selected("sparse_matrix.ConjugateGradient")) {
+				constexpr uint32 size{ 128 };
+				const std::vector<math::SparseTriplet<float64>> triplets{ make_grid_laplacian(size, 1) };
+				math::SparseMatrix<float64> matrix;
+				matrix.Build(size * size, size * size, triplets.data(), triplets.size());
+				std::vector<float32> values{ make_floats(-1.f, 1.f) };
+				std::vector<float64> b(size * size), x(size * size);
+				for (uint32 i{ 0 }; i < size * size; ++i)
+					b[i] = values[i % ITEM_COUNT];
+				auto solve_case = [&](math::Preconditioner preconditioner) {
+					math::ConjugateGradient<float64> solver{ preconditioner };
+					solver.SetTolerance(1e-8);
+					solver.Compute(matrix);
+					return MeasureNs(options, 1, [&]() {
+						std::fill(x.begin(), x.end(), 0.0);
+						Consume(solver.Solve(matrix, b.data(), x.data()).iterations);
+					});
+				};
+				const float64 jacobiNs{ solve_case(math::Preconditioner::JACOBI) };
+				report.AddThroughput("sparse_matrix.ConjugateGradient", solve_case(math::Preconditioner::IC0),
+					"Jacobi", jacobiNs, "solve");
+			}
+		}
+		// The textbook radix-2 transform, which reverses the bits of the
+		// indices on the fly and computes the twiddle factors of each stage
+		// with a recurrence
+		void radix2_fft(math::ComplexF* data, uint32 size)
+		{
+			for (uint32 i{ 1 }, j{ 0 }; i < size; ++i) {
+				uint32 bit{ size >> 1 };
+				for (; (j & bit) != 0; bit >>= 1)
+					j ^= bit;
+				j |= bit;
+				if (i < j)
+					std::swap(data[i], data[j]);
+			}
+			for (uint32 length{ 2 }; length <= size; length *= 2) {
+				const float64 angle{ -math::DEF_2PI / length };
+				const float32 stepReal{ static_cast<float32>(std::cos(angle)) };
+				const float32 stepImag{ static_cast<float32>(std::sin(angle)) };
+				for (uint32 start{ 0 }; start < size; start += length) {
+					float32 wReal{ 1.f }, wImag{ 0.f };
+					for (uint32 k{ 0 }; k < length / 2; ++k) {
+						math::ComplexF& a{ data[start + k] };
+						math::ComplexF& b{ data[start + k + length / 2] };
+						const float32 tReal{ b.real * wReal - b.imag * wImag };
+						const float32 tImag{ b.real * wImag + b.imag * wReal };
+						b = { a.real - tReal, a.imag - tImag };
+						a = { a.real + tReal, a.imag + tImag };
+						const float32 next{ wReal * stepReal - wImag * stepImag };
+						wImag = wReal * stepImag + wImag * stepReal;
+						wReal = next;
+					}
+				}
+			}
+		}
+		void fft_cases(Options const& options, Report& report)
+		{
+			std::vector<float32> values{ make_floats(-1.f, 1.f) };
+			for (uint32 size : { 64u, 1024u, 16384u, 262144u, 1048576u }) {
+				const std::string name{ "fft.FftPlan." + std::to_string(size) };
+				if (!report.Selected(name))
+					continue;
+				std::vector<math::ComplexF> data(size);
+				for (uint32 i{ 0 }; i < size; ++i)
+					data[i] = { values[(2 * i) % ITEM_COUNT], values[(2 * i + 1) % ITEM_COUNT] };
+				std::vector<math::ComplexF> work(data);
+				const float64 textbookNs{ MeasureNs(options, size, [&]() {
+					std::copy(data.begin(), data.end(), work.begin());
+					radix2_fft(work.data(), size);
+					Consume(work[1].real);
+				}) };
+				math::FftPlan plan;
+				plan.Create(size);
+				report.AddThroughput(name, MeasureNs(options, size, [&]() {
+					plan.Execute(data.data(), work.data(), math::FftDirection::FORWARD);
+					Consume(work[1].real);
+				}), "textbook radix-2", textbookNs, "element");
+			}
+			for (uint32 size : { 64u, 1024u, 16384u, 262144u, 1048576u }) {
+				const std::string name{ "fft.RealFftPlan." + std::to_string(size) };
+				if (!report.Selected(name))
+					continue;
+				std::vector<math::ComplexF> data(size), work(size);
+				std::vector<float32> signal(size);
+				for (uint32 i{ 0 }; i < size; ++i) {
+					signal[i] = values[i % ITEM_COUNT];
+					data[i] = { signal[i], 0.f };
+				}
+				math::FftPlan complexPlan;
+				complexPlan.Create(size);
+				const float64 complexNs{ MeasureNs(options, size, [&]() {
+					complexPlan.Execute(data.data(), work.data(), math::FftDirection::FORWARD);
+					Consume(work[1].real);
+				}) };
+				math::RealFftPlan plan;
+				plan.Create(size);
+				report.AddThroughput(name, MeasureNs(options, size, [&]() {
+					plan.Forward(signal.data(), work.data());
+					Consume(work[1].real);
+				}), "complex FftPlan", complexNs, "element");
+			}
+			if (report.Selected("fft.FftPlan2D.1024x1024")) {
+				// The columns are gathered into a buffer without transposing
+				// the blocks
+				constexpr uint32 size{ 1024 };
+				std::vector<math::ComplexF> data(size * size), work(size * size), column(size);
+				for (uint32 i{ 0 }; i < size * size; ++i)
+					data[i] = { values[i % ITEM_COUNT], values[(i + 7) % ITEM_COUNT] };
+				math::FftPlan rows;
+				rows.Create(size);
+				const float64 gatherNs{ MeasureNs(options, size * size, [&]() {
+					for (uint32 y{ 0 }; y < size; ++y)
+						rows.Execute(data.data() + y * size, work.data() + y * size, math::FftDirection::FORWARD);
+					for (uint32 x{ 0 }; x < size; ++x) {
+						for (uint32 y{ 0 }; y < size; ++y)
+							column[y] = work[y * size + x];
+						rows.Execute(column.data(), column.data(), math::FftDirection::FORWARD);
+						for (uint32 y{ 0 }; y < size; ++y)
+							work[y * size + x] = column[y];
+					}
+					Consume(work[1].real);
+				}) };
+				math::FftPlan2D plan;
+				plan.Create(size, size);
+				report.AddThroughput("fft.FftPlan2D.1024x1024", MeasureNs(options, size * size, [&]() {
+					plan.Execute(data.data(), work.data(), math::FftDirection::FORWARD);
+					Consume(work[1].real);
+				}), "column gather", gatherNs, "element");
+			}
+		}
+		void reduction_cases(Options const& options, Report& report)
+		{
+			// Large enough to leave the caches like telemetry and images
+			constexpr uint64 count{ 1u << 22 };
+			std::vector<float32> values{ make_floats(-1.f, 1.f) };
+			std::vector<float32> a(count), b(count);
+			for (uint64 i{ 0 }; i < count; ++i) {
+				a[i] = values[i % ITEM_COUNT];
+				b[i] = values[(i * 7 + 3) % ITEM_COUNT];
+			}
+			if (report.Selected("reduction.Sum")) {
+				const float64 loopNs{ MeasureNs(options, count, [&]() {
+					float32 sum{ 0.f };
+					for (uint64 i{ 0 }; i < count; ++i)
+						sum += a[i];
+					Consume(sum);
+				}) };
+				report.AddThroughput("reduction.Sum", MeasureNs(options, count, [&]() {
+					Consume(math::Sum(a.data(), count));
+				}), "loop", loopNs, "value");
+			}
+			if (report.Selected("reduction.Sum.COMPENSATED")) {
+				const float64 kahanNs{ MeasureNs(options, count, [&]() {
+					float32 sum{ 0.f }, compensation{ 0.f };
+					for (uint64 i{ 0 }; i < count; ++i) {
+						const float32 y{ a[i] - compensation };
+						const float32 t{ sum + y };
+						compensation = (t - sum) - y;
+						sum = t;
+					}
+					Consume(sum);
+				}) };
+				report.AddThroughput("reduction.Sum.COMPENSATED", MeasureNs(options, count, [&]() {
+					Consume(math::Sum(a.data(), count, math::Summation::COMPENSATED));
+				}), "Kahan loop", kahanNs, "value");
+			}
+			if (report.Selected("reduction.Dot")) {
+				const float64 loopNs{ MeasureNs(options, count, [&]() {
+					float32 sum{ 0.f };
+					for (uint64 i{ 0 }; i < count; ++i)
+						sum += a[i] * b[i];
+					Consume(sum);
+				}) };
+				report.AddThroughput("reduction.Dot", MeasureNs(options, count, [&]() {
+					Consume(math::Dot(a.data(), b.data(), count));
+				}), "loop", loopNs, "value");
+			}
+			if (report.Selected("reduction.Variance")) {
+				const float64 loopNs{ MeasureNs(options, count, [&]() {
+					float32 sum{ 0.f };
+					for (uint64 i{ 0 }; i < count; ++i)
+						sum += a[i];
+					const float32 mean{ sum / static_cast<float32>(count) };
+					float32 squares{ 0.f };
+					for (uint64 i{ 0 }; i < count; ++i)
+						squares += (a[i] - mean) * (a[i] - mean);
+					Consume(squares / static_cast<float32>(count));
+				}) };
+				report.AddThroughput("reduction.Variance", MeasureNs(options, count, [&]() {
+					Consume(math::Variance(a.data(), count));
+				}), "two-pass loop", loopNs, "value");
+			}
+			if (report.Selected("reduction.MinMax")) {
+				const float64 stdNs{ MeasureNs(options, count, [&]() {
+					const auto range{ std::minmax_element(a.begin(), a.end()) };
+					Consume(*range.first + *range.second);
+				}) };
+				report.AddThroughput("reduction.MinMax", MeasureNs(options, count, [&]() {
+					float32 min, max;
+					math::MinMax(a.data(), count, min, max);
+					Consume(min + max);
+				}), "std::minmax_element", stdNs, "value");
+			}
+			if (report.Selected("reduction.ArgMax")) {
+				const float64 stdNs{ MeasureNs(options, count, [&]() {
+					Consume(std::max_element(a.begin(), a.end()) - a.begin());
+				}) };
+				report.AddThroughput("reduction.ArgMax", MeasureNs(options, count, [&]() {
+					Consume(math::ArgMax(a.data(), count));
+				}), "std::max_element", stdNs, "value");
+			}
+			if (report.Selected("reduction.Histogram")) {
+				constexpr uint32 binCount{ 256 };
+				std::vector<uint64> bins(binCount);
+				const float64 loopNs{ MeasureNs(options, count, [&]() {
+					std::fill(bins.begin(), bins.end(), uint64{ 0 });
+					for (uint64 i{ 0 }; i < count; ++i) {
+						if (a[i] >= -1.f && a[i] <= 1.f)
+							++bins[std::min(binCount - 1, static_cast<uint32>((a[i] + 1.f) * (binCount / 2.f)))];
+					}
+					Consume(bins[0]);
+				}) };
+				report.AddThroughput("reduction.Histogram", MeasureNs(options, count, [&]() {
+					math::Histogram(a.data(), count, -1.f, 1.f, binCount, bins.data());
+					Consume(bins[0]);
+				}), "loop", loopNs, "value");
+			}
+		}
+		void matrixn_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("matrixn.SolveBatch"))
+				return;
+			// Diagonally dominant 6x6 systems like the blocks of a
+			// constraint solver
+			constexpr uint32 size{ 6 };
+			const uint64 count{ ITEM_COUNT };
+			std::vector<float32> values{ make_floats(-1.f, 1.f) };
+			std::vector<float32> a(size * size * count), b(size * count), x(size * count);
+			for (uint32 i{ 0 }; i < size * size; ++i) {
+				const float32 diagonal{ i % (size + 1) == 0 ? 4.f : 0.f };
+				for (uint64 k{ 0 }; k < count; ++k)
+					a[i * count + k] = values[(i * 7 + k) % ITEM_COUNT] + diagonal;
+			}
+			for (uint32 i{ 0 }; i < size; ++i) {
+				for (uint64 k{ 0 }; k < count; ++k)
+					b[i * count + k] = values[(i * 13 + k + 5) % ITEM_COUNT];
+			}
+			const float64 scalarNs{ MeasureNs(options, count, [&]() {
+				uint64 solved{ 0 };
+				math::MatrixN<float32, size, size> matrix;
+				math::VectorN<float32, size> vector, solution;
+				for (uint64 k{ 0 }; k < count; ++k) {
+					for (uint32 i{ 0 }; i < size * size; ++i)
+						matrix[i] = a[i * count + k];
+					for (uint32 i{ 0 }; i < size; ++i)
+						vector[i] = b[i * count + k];
+					solved += math::Solve(matrix, vector, solution);
+					for (uint32 i{ 0 }; i < size; ++i)
+						x[i * count + k] = solution[i];
+				}
+				Consume(solved);
+			}) };
+			report.AddThroughput("matrixn.SolveBatch", MeasureNs(options, count, [&]() {
+				Consume(math::SolveBatch(size, a.data(), b.data(), x.data(), count));
+			}), "MatrixN Solve", scalarNs, "system");
+		}
+		void spatial_hash_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("spatial_hash.Build") && !report.Selected("spatial_hash.FindPairs"))
+				return;
+			// Points in a square with about three neighbours within the
+			// distance of each point
+			const uint64 count{ ITEM_COUNT * 2 };
+			const float32 distance{ 1.f };
+			const float32 extent{ std::sqrt(static_cast<float32>(count) * 3.14159f / 3.f) };
+			std::vector<math::PointF> points(count);
+			math::Pcg32 rng(0x42u);
+			math::FillUniform(rng, points.data(), count, 0.f, extent);
+			math::SpatialHashGrid grid(distance);
+
+			if (report.Selected("spatial_hash.Build")) {
+				report.AddThroughput("spatial_hash.Build", MeasureNs(options, count, [&]() {
+					grid.Build(points.data(), static_cast<uint32>(count));
+					Consume(grid.GetCount());
+				}), std::string(), 0.0, "pt");
+			}
+			if (report.Selected("spatial_hash.FindPairs")) {
+				// All pairs of 8192 points take as long as the grid for all
+				// points
+				const uint64 pairCount{ 8192 };
+				const float64 allPairsNs{ MeasureNs(options, pairCount, [&]() {
+					uint64 found{ 0 };
+					for (uint64 i{ 0 }; i < pairCount; ++i) {
+						for (uint64 j{ i + 1 }; j < pairCount; ++j) {
+							const float32 dx{ points[j].x - points[i].x };
+							const float32 dy{ points[j].y - points[i].y };
+							found += dx * dx + dy * dy <= distance * distance;
+						}
+					}
+					Consume(found);
+				}) };
+				std::vector<math::SpatialPair> pairs;
+				grid.Build(points.data(), static_cast<uint32>(count));
+				report.AddThroughput("spatial_hash.FindPairs", MeasureNs(options, count, [&]() {
+					grid.FindPairs(distance, pairs);
+					Consume(pairs.size());
+				}), "all pairs of 8192 points", allPairsNs, "pt");
+			}
+		}
+		void loose_tree_cases(Options const& options, Report& report)
+		{
+			if (!report.Selected("loose_tree.QueryAABB") && !report.Selected("loose_tree.Move"))
+				return;
+			// Small boxes in a cube, queried with boxes of a few items each
+			const uint64 count{ ITEM_COUNT };
+			const float32 extent{ 100.f };
+			std::vector<math::Vector3_Base<float32>> centers(count);
+			math::Pcg32 rng(0x43u);
+			math::FillUniform(rng, centers.data(), count, 0.f, extent);
+			const math::Vector3_Base<float32> half(0.5f, 0.5f, 0.5f);
+			std::vector<math::AABB> boxes(count);
+			for (uint64 i{ 0 }; i < count; ++i)
+				boxes[i] = math::AABB(centers[i] - half, centers[i] + half);
+			math::LooseOctree tree(math::AABB(math::Vector3_Base<float32>(0.f, 0.f, 0.f),
+				math::Vector3_Base<float32>(extent, extent, extent)), 8);
+			for (math::AABB const& box : boxes)
+				tree.Insert(box);
+
+			if (report.Selected("loose_tree.QueryAABB")) {
+				const uint64 queryCount{ 1024 };
+				const math::Vector3_Base<float32> reach(4.f, 4.f, 4.f);
+				std::vector<uint32> found(count);
+				const float64 allNs{ MeasureNs(options, 16, [&]() {
+					uint64 hits{ 0 };
+					for (uint64 q{ 0 }; q < 16; ++q) {
+						const math::AABB query(centers[q] - reach, centers[q] + reach);
+						for (math::AABB const& box : boxes)
+							hits += math::Intersects(box, query);
+					}
+					Consume(hits);
+				}) };
+				report.AddThroughput("loose_tree.QueryAABB", MeasureNs(options, queryCount, [&]() {
+					uint64 hits{ 0 };
+					for (uint64 q{ 0 }; q < queryCount; ++q) {
+						const math::AABB query(centers[q] - reach, centers[q] + reach);
+						hits += tree.QueryAABB(query, found.data(), static_cast<uint32>(found.size()));
+					}
+					Consume(hits);
+				}), "all boxes", allNs, "query");
+			}
+			if (report.Selected("loose_tree.Move")) {
+				// Each item moves by a tenth of its size, which mostly stays
+				// in the cell of its node
+				const math::Vector3_Base<float32> step(0.1f, 0.f, 0.05f);
+				const float64 reinsertNs{ MeasureNs(options, count, [&]() {
+					for (uint32 i{ 0 }; i < count; ++i) {
+						boxes[i] = math::AABB(boxes[i].min + step, boxes[i].max + step);
+						tree.Remove(i);
+						tree.Insert(boxes[i]);
+					}
+					Consume(tree.GetNodeCount());
+				}) };
+				report.AddThroughput("loose_tree.Move", MeasureNs(options, count, [&]() {
+					for (uint32 i{ 0 }; i < count; ++i) {
+						boxes[i] = math::AABB(boxes[i].min - step, boxes[i].max - step);
+						tree.Move(i, boxes[i]);
+					}
+					Consume(tree.GetNodeCount());
+				}), "Remove and Insert", reinsertNs, "item");
+			}
+		}
+		void morton_cases(Options const& options, Report& report)
+		{
+			std::vector<math::Vector3_Base<float32>> points(ITEM_COUNT);
+			math::Pcg32 rng(0x44u);
+			math::FillUniform(rng, points.data(), ITEM_COUNT, -50.f, 50.f);
+			const math::AABB bounds(math::Vector3_Base<float32>(-50.f, -50.f, -50.f),
+				math::Vector3_Base<float32>(50.f, 50.f, 50.f));
+			// The cell of a point, like the batch functions compute it
+			const auto cell = [&](math::Vector3_Base<float32> const& p, float32 cells) {
+				const auto axis = [cells](float32 v) {
+					const float32 t{ std::min(std::max((v + 50.f) * (cells / 100.f), 0.f), cells - 1.f) };
+					return static_cast<uint32>(t);
+				};
+				return math::Vector3_Base<uint32>(axis(p.x), axis(p.y), axis(p.z));
+			};
+			std::vector<uint32> codes32(ITEM_COUNT);
+			std::vector<uint64> codes64(ITEM_COUNT);
+			if (report.Selected("morton.EncodeMorton3D32Batch")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						codes32[i] = math::EncodeMorton3D32(cell(points[i], 1024.f));
+					Consume(codes32[0]);
+				}) };
+				report.AddThroughput("morton.EncodeMorton3D32Batch", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::EncodeMorton3D32Batch(bounds, points.data(), codes32.data(), ITEM_COUNT);
+					Consume(codes32[0]);
+				}), "EncodeMorton3D32 loop", scalarNs);
+			}
+			if (report.Selected("morton.EncodeMorton3D64Batch")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						codes64[i] = math::EncodeMorton3D64(cell(points[i], 2097152.f));
+					Consume(codes64[0]);
+				}) };
+				report.AddThroughput("morton.EncodeMorton3D64Batch", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::EncodeMorton3D64Batch(bounds, points.data(), codes64.data(), ITEM_COUNT);
+					Consume(codes64[0]);
+				}), "EncodeMorton3D64 loop", scalarNs);
+			}
+			if (report.Selected("morton.EncodeHilbert3D32Batch")) {
+				const float64 scalarNs{ MeasureNs(options, ITEM_COUNT, [&]() {
+					for (uint64 i{ 0 }; i < ITEM_COUNT; ++i)
+						codes32[i] = math::EncodeHilbert3D32(cell(points[i], 1024.f));
+					Consume(codes32[0]);
+				}) };
+				report.AddThroughput("morton.EncodeHilbert3D32Batch", MeasureNs(options, ITEM_COUNT, [&]() {
+					math::EncodeHilbert3D32Batch(bounds, points.data(), codes32.data(), ITEM_COUNT);
+					Consume(codes32[0]);
+				}), "EncodeHilbert3D32 loop", scalarNs);
+			}
+		}
+	} // anonymous namespace
+
+	ECM_BENCH_SUITE(modules)
+	{
+		random_cases(options, report);
+		easing_cases(options, report);
+		animation_cases(options, report);
+		skinning_cases(options, report);
+		bounds_cases(options, report);
+		frustum_cases(options, report);
+		ray_cases(options, report);
+		bvh_cases(options, report);
+		collision_cases(options, report);
+		matrixn_cases(options, report);
+		dense_matrix_cases(options, report);
+		sparse_matrix_cases(options, report);
+		fft_cases(options, report);
+		reduction_cases(options, report);
+		spatial_hash_cases(options, report);
+		loose_tree_cases(options, report);
+		morton_cases(options, report);
+		noise_cases(options, report);
+		float16_cases(options, report);
+		packing_cases(options, report);
+		fixed_cases(options, report);
+	}
+} // namespace ecm::bench
@@ -8,10 +8,37 @@
 #ifndef _ECM_MATH_HPP_
 #define _ECM_MATH_HPP_
 
+#include <ECM/math/animation.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/bvh.h>
+#include <ECM/math/collision.h>
+#include <ECM/math/dense_matrix.h>
+#include <ECM/math/dual_quaternion.h>
+#include <ECM/math/easing.h>
+#include <ECM/math/fft.h>
+#include <ECM/math/fixed.h>
+#include <ECM/math/float16.h>
+#include <ECM/math/frustum.h>
 #include <ECM/math/functions.h>
 #include <ECM/math/functions_simd.h>
 
 #include <ECM/math/vector.h>
+#include <ECM/math/loose_tree.h>
 #include <ECM/math/matrix.h>
+#include <ECM/math/matrixn.h>
+#include <ECM/math/morton.h>
+#include <ECM/math/noise.h>
+#include <ECM/math/packing.h>
+#include <ECM/math/parallel.h>
+#include <ECM/math/quaternion.h>
+#include <ECM/math/random.h>
+#include <ECM/math/ray.h>
+#include <ECM/math/reduction.h>
+#include <ECM/math/skeleton.h>
+#include <ECM/math/skinning.h>
+#include <ECM/math/sparse_matrix.h>
+#include <ECM/math/spatial_hash.h>
+
+#include <ECM/math/ext/integer_ext.h>
 
 #endif // !_ECM_MATH_HPP_
@@ -170,6 +170,12 @@
 #	define ECM_LIKELY
 #	define ECM_UNLIKELY
 #endif
+// Constant evaluation check (std::is_constant_evaluated is C++20 only)
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#	define ECM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#	define ECM_IS_CONSTANT_EVALUATED() true
+#endif
 // Standard attribute noreturn
 #if ECM_OS_WINDOWS
 #	define ECM_NORETURN __declspec(noreturn)
@@ -51,6 +51,11 @@ namespace ecm
 	using uint64 = unsigned long long;
 
 	// floating types
+	/*
+	 * Declares a 16-bit floating type, which is a storage type defined in
+	 * <ECM/math/float16.h>.
+	 */
+	struct float16;
 	/*
 	 * Defines a 32-bit floating type.
 	 */
@@ -0,0 +1,300 @@
+/**
+ * \file animation.h
+ *
+ * \brief This header defines keyframe tracks of animated values and their
+ * sampling.
+ *
+ * A track stores the times of its keys separate from their values, so the
+ * search for a key reads only the times. A cursor remembers the key of the
+ * last sample, so that sampling forward in time finds the next key in
+ * constant time and only a jump searches the keys binary.
+ *
+ * SampleAll samples many tracks at one time. It finds the keys of a block of
+ * tracks, then interpolates eight tracks at once with AVX2 and four with
+ * SSE2, and splits large batches into chunks, which run on the threads of
+ * ParallelFor. The values are the same as those of Sample.
+ */
+
+#pragma once
+#ifndef _ECM_ANIMATION_H_
+#define _ECM_ANIMATION_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/quaternion.h>
+#include <ECM/math/vector2.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines the interpolation between the keys of a
+	 * track. Quaternions are interpolated component-wise and normalized, so
+	 * LINEAR is Nlerp.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class InterpolationType : uint8
+	{
+		/* The value of the previous key */
+		STEP = 0x0,
+		LINEAR,
+		/* A cubic Hermite spline with the tangents of the keys */
+		HERMITE,
+		/* A cubic Hermite spline with tangents from the neighbouring keys */
+		CATMULL_ROM
+	} InterpolationType;
+
+	/**
+	 * This structure caches the key of the last sample of a track. Each
+	 * instance of an animation, which plays a track, needs its own cursor.
+	 *
+	 * \since v1.0.0
+	 */
+	struct AnimationCursor
+	{
+		/* The index of the key before the last sampled time */
+		uint32 key{ 0 };
+	};
+
+	namespace detail
+	{
+		// The number of components of the animated types, and if they are
+		// rotations, which are normalized after the interpolation
+		template<typename T>
+		struct animation_traits;
+
+		template<>
+		struct animation_traits<float32>
+		{
+			static constexpr uint32 components{ 1 };
+			static constexpr bool rotation{ false };
+		};
+
+		template<>
+		struct animation_traits<Vector2_Base<float32>>
+		{
+			static constexpr uint32 components{ 2 };
+			static constexpr bool rotation{ false };
+		};
+
+		template<>
+		struct animation_traits<Vector3_Base<float32>>
+		{
+			static constexpr uint32 components{ 3 };
+			static constexpr bool rotation{ false };
+		};
+
+		template<>
+		struct animation_traits<Vector4_Base<float32>>
+		{
+			static constexpr uint32 components{ 4 };
+			static constexpr bool rotation{ false };
+		};
+
+		template<>
+		struct animation_traits<Quaternion_Base<float32>>
+		{
+			static constexpr uint32 components{ 4 };
+			static constexpr bool rotation{ true };
+		};
+
+		// The keys of a track without its type, so that the sampling is
+		// compiled once in the library instead of once per type. The
+		// components of a key are consecutive, and the tangents of a key are
+		// the in-tangent followed by the out-tangent, so the out-tangent of
+		// a key and the in-tangent of the next one are next to each other.
+		struct track_view
+		{
+			float32 const* times;
+			float32 const* values;
+			// Null for STEP and LINEAR tracks
+			float32 const* tangents;
+			uint32 count;
+			InterpolationType type;
+		};
+
+		// Samples the track at the time, and writes the components of its
+		// value to out. The cursor may be null.
+		ECM_MATH_API void ECM_CALL sample_track(track_view const& track, uint32 components, bool rotation,
+			float32 time, uint32* cursor, float32* out) noexcept;
+		// Samples the tracks at the time, and writes the components of
+		// their values one after another to out. The cursors may be null.
+		ECM_MATH_API void ECM_CALL sample_tracks(track_view const* tracks, uint64 count, uint32 components,
+			bool rotation, float32 time, uint32* cursors, float32* out) noexcept;
+	} // namespace detail
+
+	/**
+	 * This class represents a keyframe track of a float32, a vector or a
+	 * quaternion.
+	 *
+	 * Before the first key a track has the value of the first key, and after
+	 * the last key the value of the last key. A track without keys has the
+	 * value 0, or the identity for quaternions.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	class AnimationTrack
+	{
+	public:
+		typedef T value_type;
+
+		/**
+		 * Constructor creating a track without keys.
+		 *
+		 * \param type The interpolation between the keys.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit AnimationTrack(InterpolationType type = InterpolationType::LINEAR);
+
+		/**
+		 * Appends a key. The tangents of HERMITE tracks are 0, and those of
+		 * CATMULL_ROM tracks are calculated from the neighbouring keys.
+		 * Quaternions are normalized, and negated if they are on the other
+		 * hemisphere than the previous key, so the interpolation takes the
+		 * shorter arc.
+		 *
+		 * \param time The time, which must be greater than the time of the
+		 *             previous key.
+		 * \param value The value.
+		 *
+		 * \since v1.0.0
+		 */
+		void AddKey(float32 time, T const& value);
+
+		/**
+		 * Appends a key of a HERMITE track.
+		 *
+		 * \param time The time, which must be greater than the time of the
+		 *             previous key.
+		 * \param value The value.
+		 * \param inTangent The derivative by the time at the end of the
+		 *                  segment before the key.
+		 * \param outTangent The derivative by the time at the start of the
+		 *                   segment after the key.
+		 *
+		 * \since v1.0.0
+		 */
+		void AddKey(float32 time, T const& value, T const& inTangent, T const& outTangent);
+
+		/**
+		 * Reserves memory for keys.
+		 *
+		 * \param count The number of keys.
+		 *
+		 * \since v1.0.0
+		 */
+		void Reserve(uint32 count);
+
+		/**
+		 * Removes all keys.
+		 *
+		 * \since v1.0.0
+		 */
+		void Clear() noexcept;
+
+		/**
+		 * Returns the number of keys.
+		 *
+		 * \returns The number of keys.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetKeyCount() const noexcept;
+
+		/**
+		 * Returns the interpolation between the keys.
+		 *
+		 * \returns The interpolation type.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD InterpolationType ECM_CALL GetType() const noexcept;
+
+		/**
+		 * Returns the time of the first key.
+		 *
+		 * \returns The time, or 0 if the track has no keys.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD float32 ECM_CALL GetStartTime() const noexcept;
+
+		/**
+		 * Returns the time of the last key.
+		 *
+		 * \returns The time, or 0 if the track has no keys.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD float32 ECM_CALL GetEndTime() const noexcept;
+
+		/**
+		 * Samples the track. The cursor makes sampling in increasing time
+		 * constant, instead of logarithmic in the number of keys.
+		 *
+		 * \param time The time.
+		 * \param cursor The cursor of the animation instance, which is
+		 *               updated.
+		 *
+		 * \returns The value.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T ECM_CALL Sample(float32 time, AnimationCursor& cursor) const noexcept;
+
+		/**
+		 * Samples the track with a binary search for the keys.
+		 *
+		 * \param time The time.
+		 *
+		 * \returns The value.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T ECM_CALL Sample(float32 time) const noexcept;
+
+		/**
+		 * Returns the keys without their type for the library functions.
+		 *
+		 * \returns The view of the keys.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD detail::track_view ECM_CALL GetView() const noexcept;
+	private:
+		static constexpr uint32 N{ detail::animation_traits<T>::components };
+		static_assert(sizeof(T) == N * sizeof(float32));
+
+		InterpolationType _type;
+		// The times are separate from the values, so the search for the
+		// keys reads only them
+		std::vector<float32> _times;
+		std::vector<float32> _values;
+		std::vector<float32> _tangents;
+	};
+
+	/**
+	 * Samples many tracks at the same time.
+	 *
+	 * \param tracks The tracks.
+	 * \param cursors The cursors of the tracks, which are updated, or null
+	 *                to search the keys of all tracks binary.
+	 * \param time The time.
+	 * \param out The array of the values.
+	 * \param count The number of tracks.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	void ECM_CALL SampleAll(AnimationTrack<T> const* tracks, AnimationCursor* cursors, float32 time, T* out, uint64 count) noexcept;
+} // namespace ecm::math
+
+#include "animation.inl"
+
+#endif // !_ECM_ANIMATION_H_
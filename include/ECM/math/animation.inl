@@ -0,0 +1,157 @@
+#pragma once
+
+#include <ECM/math/animation.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// The number of tracks, whose views are built on the stack for one
+		// call of sample_tracks
+		inline constexpr uint64 animation_view_block{ 256 };
+		// The number of tracks of a chunk of SampleAll
+		inline constexpr uint64 animation_track_grain{ 4096 };
+	} // namespace detail
+
+	template<typename T>
+	AnimationTrack<T>::AnimationTrack(InterpolationType type)
+		: _type(type)
+	{}
+
+	template<typename T>
+	void AnimationTrack<T>::AddKey(float32 time, T const& value)
+	{
+		ECM_ASSERT(_times.empty() || time > _times.back());
+		T key{ value };
+		if constexpr (detail::animation_traits<T>::rotation) {
+			key = Normalize(value);
+			if (!_times.empty()) {
+				float32 const* previous{ _values.data() + _values.size() - N };
+				if (Dot(T(previous[0], previous[1], previous[2], previous[3]), key) < 0.f)
+					key = -key;
+			}
+		}
+		float32 const* v{ reinterpret_cast<float32 const*>(&key) };
+		_times.push_back(time);
+		_values.insert(_values.end(), v, v + N);
+		if (_type != InterpolationType::HERMITE && _type != InterpolationType::CATMULL_ROM)
+			return;
+		_tangents.resize(_tangents.size() + 2 * N, 0.f);
+		if (_type != InterpolationType::CATMULL_ROM)
+			return;
+
+		// The new key has the one-sided tangent of the last key, and the
+		// previous key gets the central tangent of an inner key
+		const uint64 k{ _times.size() - 1 };
+		if (k == 0)
+			return;
+		const uint64 first{ k == 1 ? 0 : k - 2 };
+		for (uint32 c{ 0 }; c < N; ++c) {
+			const float32 last{ (_values[k * N + c] - _values[(k - 1) * N + c]) / (_times[k] - _times[k - 1]) };
+			const float32 inner{ (_values[k * N + c] - _values[first * N + c]) / (_times[k] - _times[first]) };
+			_tangents[2 * k * N + c] = last;
+			_tangents[2 * k * N + N + c] = last;
+			_tangents[2 * (k - 1) * N + c] = inner;
+			_tangents[2 * (k - 1) * N + N + c] = inner;
+		}
+	}
+
+	template<typename T>
+	void AnimationTrack<T>::AddKey(float32 time, T const& value, T const& inTangent, T const& outTangent)
+	{
+		ECM_ASSERT(_type == InterpolationType::HERMITE);
+		AddKey(time, value);
+		if (_type != InterpolationType::HERMITE)
+			return;
+		float32 const* in{ reinterpret_cast<float32 const*>(&inTangent) };
+		float32 const* out{ reinterpret_cast<float32 const*>(&outTangent) };
+		std::copy(in, in + N, _tangents.end() - 2 * N);
+		std::copy(out, out + N, _tangents.end() - N);
+	}
+
+	template<typename T>
+	void AnimationTrack<T>::Reserve(uint32 count)
+	{
+		_times.reserve(count);
+		_values.reserve(static_cast<uint64>(count) * N);
+		if (_type == InterpolationType::HERMITE || _type == InterpolationType::CATMULL_ROM)
+			_tangents.reserve(static_cast<uint64>(count) * 2 * N);
+	}
+
+	template<typename T>
+	void AnimationTrack<T>::Clear() noexcept
+	{
+		_times.clear();
+		_values.clear();
+		_tangents.clear();
+	}
+
+	template<typename T>
+	uint32 AnimationTrack<T>::GetKeyCount() const noexcept
+	{
+		return static_cast<uint32>(_times.size());
+	}
+
+	template<typename T>
+	InterpolationType AnimationTrack<T>::GetType() const noexcept
+	{
+		return _type;
+	}
+
+	template<typename T>
+	float32 AnimationTrack<T>::GetStartTime() const noexcept
+	{
+		return _times.empty() ? 0.f : _times.front();
+	}
+
+	template<typename T>
+	float32 AnimationTrack<T>::GetEndTime() const noexcept
+	{
+		return _times.empty() ? 0.f : _times.back();
+	}
+
+	template<typename T>
+	T AnimationTrack<T>::Sample(float32 time, AnimationCursor& cursor) const noexcept
+	{
+		T result;
+		detail::sample_track(GetView(), N, detail::animation_traits<T>::rotation, time, &cursor.key,
+			reinterpret_cast<float32*>(&result));
+		return result;
+	}
+
+	template<typename T>
+	T AnimationTrack<T>::Sample(float32 time) const noexcept
+	{
+		T result;
+		detail::sample_track(GetView(), N, detail::animation_traits<T>::rotation, time, nullptr,
+			reinterpret_cast<float32*>(&result));
+		return result;
+	}
+
+	template<typename T>
+	detail::track_view AnimationTrack<T>::GetView() const noexcept
+	{
+		return detail::track_view{ _times.data(), _values.data(), _tangents.empty() ? nullptr : _tangents.data(),
+			static_cast<uint32>(_times.size()), _type };
+	}
+
+	template<typename T>
+	void SampleAll(AnimationTrack<T> const* tracks, AnimationCursor* cursors, float32 time, T* out, uint64 count) noexcept
+	{
+		static_assert(sizeof(AnimationCursor) == sizeof(uint32));
+		constexpr uint32 components{ detail::animation_traits<T>::components };
+		ParallelFor(0, count, detail::animation_track_grain, [&](uint64 begin, uint64 end) {
+			detail::track_view views[detail::animation_view_block];
+			for (uint64 i{ begin }; i < end; i += detail::animation_view_block) {
+				const uint64 n{ std::min(end - i, detail::animation_view_block) };
+				for (uint64 j{ 0 }; j < n; ++j)
+					views[j] = tracks[i + j].GetView();
+				detail::sample_tracks(views, n, components, detail::animation_traits<T>::rotation, time,
+					cursors ? reinterpret_cast<uint32*>(cursors + i) : nullptr, reinterpret_cast<float32*>(out + i));
+			}
+		});
+	}
+} // namespace ecm::math
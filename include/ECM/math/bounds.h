@@ -0,0 +1,439 @@
+/**
+ * \file bounds.h
+ *
+ * \brief This header defines axis-aligned bounding boxes, bounding spheres
+ * and functionalities.
+ *
+ * The functions of single-precision boxes use SSE2. Transform uses Arvo's
+ * method, which transforms the extents of a box along each axis, and gives
+ * the smallest box around the transformed box without transforming its
+ * eight corners.
+ *
+ * ComputeBounds calculates the box of large point clouds, and splits them
+ * into chunks, which run on the threads of ParallelFor.
+ */
+
+#pragma once
+#ifndef _ECM_BOUNDS_H_
+#define _ECM_BOUNDS_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents an axis-aligned bounding box template.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct AABB_Base
+	{
+		typedef T value_type;
+		typedef AABB_Base<T> type;
+
+		// The minimum corner
+		Vector3_Base<T> min;
+		// The maximum corner
+		Vector3_Base<T> max;
+
+		// Basic constructors
+
+		/**
+		 * Default constructor, which creates an empty box. Its minimum is
+		 * the largest value of T, and its maximum the lowest value, so that
+		 * merging a point gives the box of the point.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr AABB_Base();
+
+		/**
+		 * Copy constructor initializing from another box.
+		 *
+		 * \param box The box to copy from.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr AABB_Base(AABB_Base<T> const& box);
+
+		/**
+		 * Constructor initializing with the corners.
+		 *
+		 * \param min The minimum corner.
+		 * \param max The maximum corner.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr AABB_Base(Vector3_Base<T> const& min, Vector3_Base<T> const& max);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * \param box The box to assign from.
+		 *
+		 * \returns A reference to this box after assignment.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr AABB_Base<T>& operator=(AABB_Base<T> const& box);
+	};
+
+	/**
+	 * This structure represents a bounding sphere template.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct Sphere_Base
+	{
+		typedef T value_type;
+		typedef Sphere_Base<T> type;
+
+		// The center
+		Vector3_Base<T> center;
+		// The radius
+		T radius;
+
+		// Basic constructors
+
+		/**
+		 * Default constructor, which creates a sphere with the radius 0 at
+		 * the origin.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Sphere_Base();
+
+		/**
+		 * Copy constructor initializing from another sphere.
+		 *
+		 * \param sphere The sphere to copy from.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Sphere_Base(Sphere_Base<T> const& sphere);
+
+		/**
+		 * Constructor initializing with the center and the radius.
+		 *
+		 * \param center The center.
+		 * \param radius The radius.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Sphere_Base(Vector3_Base<T> const& center, T radius);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * \param sphere The sphere to assign from.
+		 *
+		 * \returns A reference to this sphere after assignment.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Sphere_Base<T>& operator=(Sphere_Base<T> const& sphere);
+	};
+
+	// Comparison operators
+
+	/**
+	 * This operator checks if the two boxes are the same.
+	 *
+	 * \param box1 Left operand.
+	 * \param box2 Right operand.
+	 *
+	 * \returns true if the corners are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator==(AABB_Base<T> const& box1, AABB_Base<T> const& box2);
+
+	/**
+	 * This operator checks if the two boxes are not the same.
+	 *
+	 * \param box1 Left operand.
+	 * \param box2 Right operand.
+	 *
+	 * \returns true if a corner differs, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator!=(AABB_Base<T> const& box1, AABB_Base<T> const& box2);
+
+	/**
+	 * This operator checks if the two spheres are the same.
+	 *
+	 * \param sphere1 Left operand.
+	 * \param sphere2 Right operand.
+	 *
+	 * \returns true if the centers and radii are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator==(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2);
+
+	/**
+	 * This operator checks if the two spheres are not the same.
+	 *
+	 * \param sphere1 Left operand.
+	 * \param sphere2 Right operand.
+	 *
+	 * \returns true if the center or the radius differs, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator!=(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2);
+
+	// Functions
+
+	/**
+	 * Checks if a box is empty, which it is if its minimum is greater than
+	 * its maximum on an axis.
+	 *
+	 * \param box The box.
+	 *
+	 * \returns true if the box is empty, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL IsEmpty(AABB_Base<T> const& box) noexcept;
+
+	/**
+	 * Returns the center of a box.
+	 *
+	 * \param box The box, which must not be empty.
+	 *
+	 * \returns The center.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL GetCenter(AABB_Base<T> const& box) noexcept;
+
+	/**
+	 * Returns the half size of a box on each axis.
+	 *
+	 * \param box The box, which must not be empty.
+	 *
+	 * \returns The extents.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL GetExtents(AABB_Base<T> const& box) noexcept;
+
+	/**
+	 * Returns the smallest box, which contains two boxes.
+	 *
+	 * \param box1 The first box.
+	 * \param box2 The second box.
+	 *
+	 * \returns The merged box.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr AABB_Base<T> ECM_CALL Merge(AABB_Base<T> const& box1, AABB_Base<T> const& box2) noexcept;
+
+	/**
+	 * Returns the smallest box, which contains a box and a point.
+	 *
+	 * \param box The box.
+	 * \param point The point.
+	 *
+	 * \returns The merged box.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr AABB_Base<T> ECM_CALL Merge(AABB_Base<T> const& box, Vector3_Base<T> const& point) noexcept;
+
+	/**
+	 * Checks if a box contains a point. Points on the faces are contained.
+	 *
+	 * \param box The box.
+	 * \param point The point.
+	 *
+	 * \returns true if the box contains the point, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Contains(AABB_Base<T> const& box, Vector3_Base<T> const& point) noexcept;
+
+	/**
+	 * Checks if a box contains another box entirely.
+	 *
+	 * \param box The box.
+	 * \param other The other box, which must not be empty.
+	 *
+	 * \returns true if the box contains the other box, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Contains(AABB_Base<T> const& box, AABB_Base<T> const& other) noexcept;
+
+	/**
+	 * Checks if two boxes overlap. Boxes, which touch, overlap.
+	 *
+	 * \param box1 The first box.
+	 * \param box2 The second box.
+	 *
+	 * \returns true if the boxes overlap, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(AABB_Base<T> const& box1, AABB_Base<T> const& box2) noexcept;
+
+	/**
+	 * Checks if a box and a sphere overlap.
+	 *
+	 * \param box The box.
+	 * \param sphere The sphere.
+	 *
+	 * \returns true if the box and the sphere overlap, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(AABB_Base<T> const& box, Sphere_Base<T> const& sphere) noexcept;
+
+	/**
+	 * Transforms a box, and returns the smallest box around the result.
+	 *
+	 * \param box The box.
+	 * \param m The affine transformation, with the translation in m[3].
+	 *
+	 * \returns The transformed box, or the box if it is empty.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr AABB_Base<T> ECM_CALL Transform(AABB_Base<T> const& box, Matrix4x4_Base<T> const& m) noexcept;
+
+	/**
+	 * Returns the smallest sphere, which contains two spheres.
+	 *
+	 * \param sphere1 The first sphere.
+	 * \param sphere2 The second sphere.
+	 *
+	 * \returns The merged sphere.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Sphere_Base<T> ECM_CALL Merge(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2) noexcept;
+
+	/**
+	 * Checks if a sphere contains a point. Points on the surface are
+	 * contained.
+	 *
+	 * \param sphere The sphere.
+	 * \param point The point.
+	 *
+	 * \returns true if the sphere contains the point, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Contains(Sphere_Base<T> const& sphere, Vector3_Base<T> const& point) noexcept;
+
+	/**
+	 * Checks if two spheres overlap. Spheres, which touch, overlap.
+	 *
+	 * \param sphere1 The first sphere.
+	 * \param sphere2 The second sphere.
+	 *
+	 * \returns true if the spheres overlap, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2) noexcept;
+
+	/**
+	 * Transforms a sphere. The radius is scaled by the largest scale of
+	 * the transformation.
+	 *
+	 * \param sphere The sphere.
+	 * \param m The affine transformation, with the translation in m[3].
+	 *
+	 * \returns The transformed sphere.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Sphere_Base<T> ECM_CALL Transform(Sphere_Base<T> const& sphere, Matrix4x4_Base<T> const& m) noexcept;
+
+	/**
+	 * Returns the sphere through the corners of a box.
+	 *
+	 * \param box The box, which must not be empty.
+	 *
+	 * \returns The sphere.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Sphere_Base<T> ECM_CALL SphereFromAABB(AABB_Base<T> const& box) noexcept;
+
+	/**
+	 * Calculates the bounding box of points.
+	 *
+	 * \param points The points.
+	 * \param count The number of points.
+	 *
+	 * \returns The box, which is empty if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API AABB_Base<float32> ECM_CALL ComputeBounds(Vector3_Base<float32> const* points,
+		uint64 count) noexcept;
+
+	/**
+	 * Calculates the bounding box of points, whose components are in
+	 * separate arrays.
+	 *
+	 * \param x The x components.
+	 * \param y The y components.
+	 * \param z The z components.
+	 * \param count The number of points.
+	 *
+	 * \returns The box, which is empty if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API AABB_Base<float32> ECM_CALL ComputeBounds(float32 const* x, float32 const* y,
+		float32 const* z, uint64 count) noexcept;
+
+	/**
+	 * An axis-aligned bounding box with single-precision floating-point
+	 * components.
+	 *
+	 * \since v1.0.0
+	 */
+	using AABB = AABB_Base<float32>;
+
+	/**
+	 * A bounding sphere with single-precision floating-point components.
+	 *
+	 * \since v1.0.0
+	 */
+	using Sphere = Sphere_Base<float32>;
+} // namespace ecm::math
+
+#include "bounds.inl"
+
+#endif // !_ECM_BOUNDS_H_
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <ECM/math/bounds.h>
+#include <ECM/math/functions_simd.h>
+
+#include <cmath>
+#include <limits>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// Single-precision boxes use SSE2, with the components x, y and z
+		// in the first three lanes of a register.
+		template<typename T>
+		struct is_simd_bounds
+		{
+			static constexpr bool value = ECM_SIMD_SSE2 && std::is_same_v<T, float32>;
+		};
+
+		template<typename T>
+		constexpr bool is_simd_bounds_v = is_simd_bounds<T>::value;
+
+		// The fourth lane repeats z, so that it doesn't change the result of
+		// a comparison of all lanes.
+		ECM_FORCEINLINE __m128 load_vector3(Vector3_Base<float32> const& v)
+		{
+			return _mm_setr_ps(v.x, v.y, v.z, v.z);
+		}
+
+		ECM_FORCEINLINE Vector3_Base<float32> store_vector3(__m128 v)
+		{
+			ECM_ALIGN(16) float32 lanes[4];
+			_mm_store_ps(lanes, v);
+			return Vector3_Base<float32>(lanes[0], lanes[1], lanes[2]);
+		}
+
+		template<int I>
+		ECM_FORCEINLINE __m128 splat_lane(__m128 v)
+		{
+			return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+		}
+
+		ECM_FORCEINLINE bool all_lanes(__m128 mask)
+		{
+			return _mm_movemask_ps(mask) == 0xF;
+		}
+
+		template<typename T>
+		constexpr T min_value(T a, T b)
+		{
+			return b < a ? b : a;
+		}
+
+		template<typename T>
+		constexpr T max_value(T a, T b)
+		{
+			return a < b ? b : a;
+		}
+	} // namespace detail
+
+	// Basic constructors
+
+	template<typename T>
+	constexpr AABB_Base<T>::AABB_Base()
+		: min(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()),
+		max(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest())
+	{}
+
+	template<typename T>
+	constexpr AABB_Base<T>::AABB_Base(AABB_Base<T> const& box)
+		: min(box.min), max(box.max)
+	{}
+
+	template<typename T>
+	constexpr AABB_Base<T>::AABB_Base(Vector3_Base<T> const& min, Vector3_Base<T> const& max)
+		: min(min), max(max)
+	{}
+
+	template<typename T>
+	constexpr AABB_Base<T>& AABB_Base<T>::operator=(AABB_Base<T> const& box)
+	{
+		min = box.min;
+		max = box.max;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr Sphere_Base<T>::Sphere_Base()
+		: center(), radius(0)
+	{}
+
+	template<typename T>
+	constexpr Sphere_Base<T>::Sphere_Base(Sphere_Base<T> const& sphere)
+		: center(sphere.center), radius(sphere.radius)
+	{}
+
+	template<typename T>
+	constexpr Sphere_Base<T>::Sphere_Base(Vector3_Base<T> const& center, T radius)
+		: center(center), radius(radius)
+	{}
+
+	template<typename T>
+	constexpr Sphere_Base<T>& Sphere_Base<T>::operator=(Sphere_Base<T> const& sphere)
+	{
+		center = sphere.center;
+		radius = sphere.radius;
+		return *this;
+	}
+
+	// Comparison operators
+
+	template<typename T>
+	constexpr bool operator==(AABB_Base<T> const& box1, AABB_Base<T> const& box2)
+	{
+		return box1.min == box2.min && box1.max == box2.max;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(AABB_Base<T> const& box1, AABB_Base<T> const& box2)
+	{
+		return !(box1 == box2);
+	}
+
+	template<typename T>
+	constexpr bool operator==(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2)
+	{
+		return sphere1.center == sphere2.center && sphere1.radius == sphere2.radius;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2)
+	{
+		return !(sphere1 == sphere2);
+	}
+
+	// Functions
+
+	template<typename T>
+	constexpr bool IsEmpty(AABB_Base<T> const& box) noexcept
+	{
+		return box.max.x < box.min.x || box.max.y < box.min.y || box.max.z < box.min.z;
+	}
+
+	template<typename T>
+	constexpr Vector3_Base<T> GetCenter(AABB_Base<T> const& box) noexcept
+	{
+		return Vector3_Base<T>((box.min.x + box.max.x) / T(2), (box.min.y + box.max.y) / T(2),
+			(box.min.z + box.max.z) / T(2));
+	}
+
+	template<typename T>
+	constexpr Vector3_Base<T> GetExtents(AABB_Base<T> const& box) noexcept
+	{
+		return Vector3_Base<T>((box.max.x - box.min.x) / T(2), (box.max.y - box.min.y) / T(2),
+			(box.max.z - box.min.z) / T(2));
+	}
+
+	template<typename T>
+	constexpr AABB_Base<T> Merge(AABB_Base<T> const& box1, AABB_Base<T> const& box2) noexcept
+	{
+		if constexpr (detail::is_simd_bounds_v<T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return AABB_Base<T>(
+					detail::store_vector3(_mm_min_ps(detail::load_vector3(box1.min), detail::load_vector3(box2.min))),
+					detail::store_vector3(_mm_max_ps(detail::load_vector3(box1.max), detail::load_vector3(box2.max))));
+			}
+		}
+		return AABB_Base<T>(
+			Vector3_Base<T>(detail::min_value(box1.min.x, box2.min.x), detail::min_value(box1.min.y, box2.min.y),
+				detail::min_value(box1.min.z, box2.min.z)),
+			Vector3_Base<T>(detail::max_value(box1.max.x, box2.max.x), detail::max_value(box1.max.y, box2.max.y),
+				detail::max_value(box1.max.z, box2.max.z)));
+	}
+
+	template<typename T>
+	constexpr AABB_Base<T> Merge(AABB_Base<T> const& box, Vector3_Base<T> const& point) noexcept
+	{
+		return Merge(box, AABB_Base<T>(point, point));
+	}
+
+	template<typename T>
+	constexpr bool Contains(AABB_Base<T> const& box, Vector3_Base<T> const& point) noexcept
+	{
+		return Contains(box, AABB_Base<T>(point, point));
+	}
+
+	template<typename T>
+	constexpr bool Contains(AABB_Base<T> const& box, AABB_Base<T> const& other) noexcept
+	{
+		if constexpr (detail::is_simd_bounds_v<T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128 aboveMin{ _mm_cmple_ps(detail::load_vector3(box.min), detail::load_vector3(other.min)) };
+				const __m128 belowMax{ _mm_cmple_ps(detail::load_vector3(other.max), detail::load_vector3(box.max)) };
+				return detail::all_lanes(_mm_and_ps(aboveMin, belowMax));
+			}
+		}
+		return box.min.x <= other.min.x && box.min.y <= other.min.y && box.min.z <= other.min.z
+			&& other.max.x <= box.max.x && other.max.y <= box.max.y && other.max.z <= box.max.z;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(AABB_Base<T> const& box1, AABB_Base<T> const& box2) noexcept
+	{
+		if constexpr (detail::is_simd_bounds_v<T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128 below{ _mm_cmple_ps(detail::load_vector3(box1.min), detail::load_vector3(box2.max)) };
+				const __m128 above{ _mm_cmple_ps(detail::load_vector3(box2.min), detail::load_vector3(box1.max)) };
+				return detail::all_lanes(_mm_and_ps(below, above));
+			}
+		}
+		return box1.min.x <= box2.max.x && box1.min.y <= box2.max.y && box1.min.z <= box2.max.z
+			&& box2.min.x <= box1.max.x && box2.min.y <= box1.max.y && box2.min.z <= box1.max.z;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(AABB_Base<T> const& box, Sphere_Base<T> const& sphere) noexcept
+	{
+		// The distance of the center to the closest point of the box
+		T distanceSquared{ 0 };
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			const T c{ sphere.center[i] };
+			const T d{ c < box.min[i] ? box.min[i] - c : (box.max[i] < c ? c - box.max[i] : T(0)) };
+			distanceSquared += d * d;
+		}
+		return distanceSquared <= sphere.radius * sphere.radius;
+	}
+
+	template<typename T>
+	constexpr AABB_Base<T> Transform(AABB_Base<T> const& box, Matrix4x4_Base<T> const& m) noexcept
+	{
+		if (IsEmpty(box))
+			return box;
+		// Each axis of the box adds the smaller and the larger product of its
+		// column with the minimum and the maximum
+		if constexpr (detail::is_simd_bounds_v<T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128 boxMin{ detail::load_vector3(box.min) };
+				const __m128 boxMax{ detail::load_vector3(box.max) };
+				__m128 resultMin{ _mm_loadu_ps(m.matrix[3]) };
+				__m128 resultMax{ resultMin };
+				const __m128 minAxes[3]{ detail::splat_lane<0>(boxMin), detail::splat_lane<1>(boxMin),
+					detail::splat_lane<2>(boxMin) };
+				const __m128 maxAxes[3]{ detail::splat_lane<0>(boxMax), detail::splat_lane<1>(boxMax),
+					detail::splat_lane<2>(boxMax) };
+				for (uint8 c{ 0 }; c < 3; ++c) {
+					const __m128 column{ _mm_loadu_ps(m.matrix[c]) };
+					const __m128 a{ _mm_mul_ps(column, minAxes[c]) };
+					const __m128 b{ _mm_mul_ps(column, maxAxes[c]) };
+					resultMin = _mm_add_ps(resultMin, _mm_min_ps(a, b));
+					resultMax = _mm_add_ps(resultMax, _mm_max_ps(a, b));
+				}
+				return AABB_Base<T>(detail::store_vector3(resultMin), detail::store_vector3(resultMax));
+			}
+		}
+		AABB_Base<T> result(Vector3_Base<T>(m.matrix[3][0], m.matrix[3][1], m.matrix[3][2]),
+			Vector3_Base<T>(m.matrix[3][0], m.matrix[3][1], m.matrix[3][2]));
+		for (uint8 c{ 0 }; c < 3; ++c) {
+			for (uint8 r{ 0 }; r < 3; ++r) {
+				const T a{ m.matrix[c][r] * box.min[c] };
+				const T b{ m.matrix[c][r] * box.max[c] };
+				result.min[r] += detail::min_value(a, b);
+				result.max[r] += detail::max_value(a, b);
+			}
+		}
+		return result;
+	}
+
+	template<typename T>
+	Sphere_Base<T> Merge(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2) noexcept
+	{
+		const Vector3_Base<T> d(sphere2.center.x - sphere1.center.x, sphere2.center.y - sphere1.center.y,
+			sphere2.center.z - sphere1.center.z);
+		const T distance{ static_cast<T>(std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z)) };
+		if (distance + sphere2.radius <= sphere1.radius)
+			return sphere1;
+		if (distance + sphere1.radius <= sphere2.radius)
+			return sphere2;
+		const T radius{ (distance + sphere1.radius + sphere2.radius) / T(2) };
+		// The center moves from the first center towards the second one
+		const T t{ (radius - sphere1.radius) / distance };
+		return Sphere_Base<T>(Vector3_Base<T>(sphere1.center.x + d.x * t, sphere1.center.y + d.y * t,
+			sphere1.center.z + d.z * t), radius);
+	}
+
+	template<typename T>
+	constexpr bool Contains(Sphere_Base<T> const& sphere, Vector3_Base<T> const& point) noexcept
+	{
+		const T x{ point.x - sphere.center.x };
+		const T y{ point.y - sphere.center.y };
+		const T z{ point.z - sphere.center.z };
+		return x * x + y * y + z * z <= sphere.radius * sphere.radius;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(Sphere_Base<T> const& sphere1, Sphere_Base<T> const& sphere2) noexcept
+	{
+		const T x{ sphere2.center.x - sphere1.center.x };
+		const T y{ sphere2.center.y - sphere1.center.y };
+		const T z{ sphere2.center.z - sphere1.center.z };
+		const T radius{ sphere1.radius + sphere2.radius };
+		return x * x + y * y + z * z <= radius * radius;
+	}
+
+	template<typename T>
+	Sphere_Base<T> Transform(Sphere_Base<T> const& sphere, Matrix4x4_Base<T> const& m) noexcept
+	{
+		Vector3_Base<T> center(m.matrix[3][0], m.matrix[3][1], m.matrix[3][2]);
+		T scaleSquared{ 0 };
+		for (uint8 c{ 0 }; c < 3; ++c) {
+			T lengthSquared{ 0 };
+			for (uint8 r{ 0 }; r < 3; ++r) {
+				center[r] += m.matrix[c][r] * sphere.center[c];
+				lengthSquared += m.matrix[c][r] * m.matrix[c][r];
+			}
+			scaleSquared = detail::max_value(scaleSquared, lengthSquared);
+		}
+		return Sphere_Base<T>(center, sphere.radius * static_cast<T>(std::sqrt(scaleSquared)));
+	}
+
+	template<typename T>
+	Sphere_Base<T> SphereFromAABB(AABB_Base<T> const& box) noexcept
+	{
+		const Vector3_Base<T> extents{ GetExtents(box) };
+		return Sphere_Base<T>(GetCenter(box), static_cast<T>(std::sqrt(extents.x * extents.x
+			+ extents.y * extents.y + extents.z * extents.z)));
+	}
+} // namespace ecm::math
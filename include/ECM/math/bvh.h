@@ -0,0 +1,224 @@
+/**
+ * \file bvh.h
+ *
+ * \brief This header defines bounding volume hierarchies over triangle
+ * meshes, and the queries of rays against them.
+ *
+ * The builder splits the triangles with the surface area heuristic, which
+ * is evaluated in bins of the centroids. The splits of large ranges bin the
+ * triangles on the threads of ParallelFor, and the subtrees below them are
+ * built in parallel. The binary tree is then collapsed into nodes with four
+ * or eight children, whose boxes are in SoA layout, so that a ray is tested
+ * against all children at once with SSE2 or AVX2.
+ *
+ * The triangles are stored in the order of the leaves. Refit updates them
+ * and the boxes of the nodes for new positions of the vertices, without
+ * changing the tree, which suits deforming meshes.
+ */
+
+#pragma once
+#ifndef _ECM_BVH_H_
+#define _ECM_BVH_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/ray.h>
+#include <ECM/math/vector3.h>
+
+#include <limits>
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a node of a BVH with N children. The boxes
+	 * of the children are in SoA layout, and the node fills whole cache
+	 * lines.
+	 *
+	 * \since v1.0.0
+	 */
+	template<uint32 N>
+	ECM_ALIGNEDSTRUCT(64) BvhNode_Base
+	{
+		// The x, y and z components of the minimum corners of the children
+		float32 min[3][N];
+		// The x, y and z components of the maximum corners of the children
+		float32 max[3][N];
+		// The index of the node of each child, or of its first triangle if
+		// it's a leaf
+		uint32 child[N];
+		// The number of triangles of each leaf, or 0 for nodes and unused
+		// children
+		uint32 count[N];
+	};
+
+	/**
+	 * This structure receives the closest hit of a ray.
+	 *
+	 * \since v1.0.0
+	 */
+	struct BvhHit
+	{
+		/* The distance of the hit. It must be set to the maximum distance
+		   before the query */
+		float32 distance{ std::numeric_limits<float32>::infinity() };
+		/* The barycentric coordinate of the second vertex */
+		float32 u{ 0.f };
+		/* The barycentric coordinate of the third vertex */
+		float32 v{ 0.f };
+		/* The index of the triangle in the mesh */
+		uint32 triangle{ 0xffffffffu };
+	};
+
+	/**
+	 * This class represents a bounding volume hierarchy over the triangles
+	 * of a mesh, whose nodes have N children. N is 4 or 8.
+	 *
+	 * \since v1.0.0
+	 */
+	template<uint32 N>
+	class ECM_MATH_API Bvh_Base
+	{
+	public:
+		static_assert(N == 4 || N == 8, "A BVH has 4 or 8 children per node");
+
+		/**
+		 * Constructor creating an empty hierarchy.
+		 *
+		 * \since v1.0.0
+		 */
+		Bvh_Base() noexcept = default;
+
+		/**
+		 * Builds the hierarchy over the triangles of a mesh.
+		 *
+		 * \param vertices The vertices of the mesh.
+		 * \param indices The three indices into the vertices of each
+		 *                triangle.
+		 * \param triangleCount The number of triangles.
+		 *
+		 * \since v1.0.0
+		 */
+		void Build(Vector3_Base<float32> const* vertices, uint32 const* indices, uint32 triangleCount);
+
+		/**
+		 * Updates the triangles and the boxes of the nodes for new positions
+		 * of the vertices. The tree stays the same, so the queries get
+		 * slower if the triangles move far.
+		 *
+		 * \param vertices The vertices of the mesh, with the indices of the
+		 *                 last Build.
+		 *
+		 * \since v1.0.0
+		 */
+		void Refit(Vector3_Base<float32> const* vertices) noexcept;
+
+		/**
+		 * Finds the closest triangle, which a ray hits.
+		 *
+		 * \param ray The ray.
+		 * \param hit The hit. Its distance is the maximum distance of the
+		 *            ray, and it receives the closest hit before it.
+		 *
+		 * \returns true if the ray hits a triangle before the distance of
+		 *          the hit, or false if not.
+		 *
+		 * \since v1.0.0
+		 */
+		bool IntersectClosest(Ray_Base<float32> const& ray, BvhHit& hit) const noexcept;
+
+		/**
+		 * Finds the closest hits of many rays on multiple threads.
+		 *
+		 * \param rays The rays.
+		 * \param hits The hits of the rays, whose distances are the maximum
+		 *             distances of the rays.
+		 * \param count The number of rays.
+		 *
+		 * \since v1.0.0
+		 */
+		void IntersectClosest(Ray_Base<float32> const* rays, BvhHit* hits, uint64 count) const noexcept;
+
+		/**
+		 * Checks if a ray hits any triangle, and stops at the first hit,
+		 * which suits shadow and visibility rays.
+		 *
+		 * \param ray The ray.
+		 * \param maxDistance The maximum distance of the ray.
+		 *
+		 * \returns true if the ray hits a triangle before the distance, or
+		 *          false if not.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD bool IntersectAny(Ray_Base<float32> const& ray,
+			float32 maxDistance = std::numeric_limits<float32>::infinity()) const noexcept;
+
+		/**
+		 * Returns the box of all triangles.
+		 *
+		 * \returns The box, which is empty if there are no triangles.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD AABB_Base<float32> ECM_CALL GetBounds() const noexcept;
+
+		/**
+		 * Returns the number of nodes.
+		 *
+		 * \returns The number of nodes.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetNodeCount() const noexcept;
+
+		/**
+		 * Returns the number of triangles.
+		 *
+		 * \returns The number of triangles.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetTriangleCount() const noexcept;
+
+		/**
+		 * Returns the nodes. The first node is the root.
+		 *
+		 * \returns The array of GetNodeCount() nodes.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD BvhNode_Base<N> const* ECM_CALL GetNodes() const noexcept;
+	private:
+		std::vector<BvhNode_Base<N>> _nodes;
+		// The vertices of the triangles in the order of the leaves
+		std::vector<Vector3_Base<float32>> _positions;
+		// The indices of the vertices of the triangles in the order of the
+		// leaves
+		std::vector<uint32> _indices;
+		// The index of each triangle in the mesh
+		std::vector<uint32> _triangles;
+		// The number of entries, which the stack of a traversal needs
+		uint32 _stackSize{ 0 };
+	};
+
+	extern template class Bvh_Base<4>;
+	extern template class Bvh_Base<8>;
+
+	/**
+	 * A BVH with four children per node, which are tested with SSE2.
+	 *
+	 * \since v1.0.0
+	 */
+	using Bvh4 = Bvh_Base<4>;
+
+	/**
+	 * A BVH with eight children per node, which are tested with AVX2.
+	 *
+	 * \since v1.0.0
+	 */
+	using Bvh8 = Bvh_Base<8>;
+} // namespace ecm::math
+
+#endif // !_ECM_BVH_H_
@@ -0,0 +1,213 @@
+/**
+ * \file collision.h
+ *
+ * \brief This header defines the narrow phase of collision detection for
+ * convex shapes.
+ *
+ * A convex shape is a core shape, which is rounded by a radius: a sphere is
+ * a rounded point and a capsule a rounded segment. GJK finds the distance
+ * of the cores from their support functions, and EPA expands the last GJK
+ * simplex into the penetration of intersecting cores. The radii are added
+ * afterwards, so rounded shapes converge as fast as their cores. Boxes
+ * without radius are tested with the separating axis theorem instead,
+ * which is faster and exact.
+ *
+ * The shapes are placed by affine transformations in world space. The
+ * radii are not transformed. None of the functions allocate, and
+ * CollideBatch runs the pairs of a broad phase on multiple threads.
+ */
+
+#pragma once
+#ifndef _ECM_COLLISION_H_
+#define _ECM_COLLISION_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/spatial_hash.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines the core shapes of convex shapes.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class ShapeType : uint8
+	{
+		/* The origin, which is a sphere with a radius */
+		POINT = 0x0,
+		/* A segment along the y axis, which is a capsule with a radius */
+		SEGMENT,
+		/* A box centered at the origin */
+		BOX,
+		/* The convex hull of points */
+		HULL
+	} ShapeType;
+
+	/**
+	 * This structure represents a convex shape in its local space.
+	 *
+	 * \since v1.0.0
+	 */
+	struct ConvexShape
+	{
+		/* The core shape */
+		ShapeType type{ ShapeType::POINT };
+		/* The half extents of boxes. Segments reach from -y to y. */
+		Vector3_Base<float32> extents;
+		/* The radius, by which the core is rounded */
+		float32 radius{ 0.f };
+		/* The points of hulls, which the shape doesn't own */
+		Vector3_Base<float32> const* points{ nullptr };
+		/* The number of points of hulls */
+		uint32 pointCount{ 0 };
+	};
+
+	/**
+	 * This structure represents the contact of two intersecting shapes A
+	 * and B.
+	 *
+	 * \since v1.0.0
+	 */
+	struct Contact
+	{
+		/* The direction from A to B, along which B is pushed out of A */
+		Vector3_Base<float32> normal;
+		/* The distance, which B is pushed along the normal, or 0 for
+		 * shapes, which don't intersect */
+		float32 depth{ 0.f };
+		/* The deepest point of A inside of B */
+		Vector3_Base<float32> pointA;
+		/* The deepest point of B inside of A */
+		Vector3_Base<float32> pointB;
+	};
+
+	/**
+	 * Tests two convex shapes for intersection with GJK.
+	 *
+	 * \param a The first shape.
+	 * \param transformA The transformation of the first shape.
+	 * \param b The second shape.
+	 * \param transformB The transformation of the second shape.
+	 *
+	 * \returns True if the shapes intersect or touch, false otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API bool ECM_CALL GjkIntersects(ConvexShape const& a,
+		Matrix4x4_Base<float32> const& transformA, ConvexShape const& b,
+		Matrix4x4_Base<float32> const& transformB) noexcept;
+
+	/**
+	 * Computes the distance of two convex shapes with GJK.
+	 *
+	 * \param a The first shape.
+	 * \param transformA The transformation of the first shape.
+	 * \param b The second shape.
+	 * \param transformB The transformation of the second shape.
+	 * \param pointA Receives the closest point of the first shape, if not
+	 *               null and the shapes are separated.
+	 * \param pointB Receives the closest point of the second shape, if not
+	 *               null and the shapes are separated.
+	 *
+	 * \returns The distance, or 0 if the shapes intersect.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API float32 ECM_CALL GjkDistance(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA,
+		ConvexShape const& b, Matrix4x4_Base<float32> const& transformB, Vector3_Base<float32>* pointA = nullptr,
+		Vector3_Base<float32>* pointB = nullptr) noexcept;
+
+	/**
+	 * Computes the penetration of two convex shapes with GJK and EPA.
+	 *
+	 * \param a The first shape.
+	 * \param transformA The transformation of the first shape.
+	 * \param b The second shape.
+	 * \param transformB The transformation of the second shape.
+	 * \param contact Receives the contact, whose depth is 0 if the shapes
+	 *                don't intersect.
+	 *
+	 * \returns True if the shapes intersect, false otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API bool ECM_CALL EpaPenetration(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA,
+		ConvexShape const& b, Matrix4x4_Base<float32> const& transformB, Contact& contact) noexcept;
+
+	/**
+	 * Tests two oriented boxes for intersection with the separating axis
+	 * theorem. The transformations can rotate and scale the boxes, but
+	 * must not shear them.
+	 *
+	 * \param halfExtentsA The half extents of the first box.
+	 * \param transformA The transformation of the first box.
+	 * \param halfExtentsB The half extents of the second box.
+	 * \param transformB The transformation of the second box.
+	 * \param contact Receives the contact along the axis of the least
+	 *                overlap, if not null.
+	 *
+	 * \returns True if the boxes intersect, false otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API bool ECM_CALL OBBIntersects(Vector3_Base<float32> const& halfExtentsA,
+		Matrix4x4_Base<float32> const& transformA, Vector3_Base<float32> const& halfExtentsB,
+		Matrix4x4_Base<float32> const& transformB, Contact* contact = nullptr) noexcept;
+
+	/**
+	 * Tests a triangle and a box for intersection with the separating axis
+	 * theorem (Akenine-Möller, "Fast 3D Triangle-Box Overlap Testing").
+	 *
+	 * \param v0, v1, v2 The corners of the triangle.
+	 * \param box The box.
+	 *
+	 * \returns True if the triangle and the box intersect, false otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API bool ECM_CALL TriangleAABBIntersects(Vector3_Base<float32> const& v0,
+		Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2, AABB_Base<float32> const& box) noexcept;
+
+	/**
+	 * Computes the contact of two convex shapes. Pairs of spheres are
+	 * solved directly, pairs of boxes without radius by OBBIntersects and
+	 * all other pairs by EpaPenetration.
+	 *
+	 * \param a The first shape.
+	 * \param transformA The transformation of the first shape.
+	 * \param b The second shape.
+	 * \param transformB The transformation of the second shape.
+	 * \param contact Receives the contact, whose depth is 0 if the shapes
+	 *                don't intersect.
+	 *
+	 * \returns True if the shapes intersect, false otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API bool ECM_CALL Collide(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA,
+		ConvexShape const& b, Matrix4x4_Base<float32> const& transformB, Contact& contact) noexcept;
+
+	/**
+	 * Computes the contacts of pairs of shapes with Collide on multiple
+	 * threads.
+	 *
+	 * \param shapes The shapes.
+	 * \param transforms The transformations of the shapes.
+	 * \param pairs The pairs of indices into the shapes, for example from
+	 *              SpatialHashGrid::FindPairs.
+	 * \param count The number of pairs.
+	 * \param contacts The array receiving the contact of each pair.
+	 *
+	 * \returns The number of pairs, which intersect.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API uint64 ECM_CALL CollideBatch(ConvexShape const* shapes, Matrix4x4_Base<float32> const* transforms,
+		SpatialPair const* pairs, uint64 count, Contact* contacts);
+} // namespace ecm::math
+
+#endif // !_ECM_COLLISION_H_
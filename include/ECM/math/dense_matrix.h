@@ -0,0 +1,328 @@
+/**
+ * \file dense_matrix.h
+ *
+ * \brief This header defines dense matrices, whose sizes are chosen at run
+ * time, and the BLAS-like operations on them.
+ *
+ * The elements are stored column by column like Matrix4x4_Base, and the
+ * storage is aligned to cache lines. Gemm follows the structure of BLIS:
+ * for each slice of the depth, all rows of A are packed into one buffer
+ * and the columns of B into panels, which fit into the L3 cache. A
+ * microkernel keeps a tile of the result in registers and updates it with
+ * the multiply-adds of SSE2 or AVX2, which are fused if ECM_SIMD_FMA is
+ * enabled. The tiles are computed on the threads of ParallelFor, and each
+ * task reads a block of the rows of packed A, which fits into the L2
+ * cache.
+ *
+ * The matrices are explicitly instantiated for float32 and float64.
+ */
+
+#pragma once
+#ifndef _ECM_DENSE_MATRIX_H_
+#define _ECM_DENSE_MATRIX_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines how an operand of Gemm and Gemv is used.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class MatrixOp : uint8
+	{
+		/* The matrix as it is */
+		NONE = 0x0,
+		/* The transposed matrix */
+		TRANSPOSE
+	} MatrixOp;
+
+	/**
+	 * This class represents a matrix of float32 or float64 elements, whose
+	 * size is chosen at run time.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	class ECM_MATH_API DenseMatrix
+	{
+	public:
+		typedef T value_type;
+
+		/**
+		 * Constructor creating an empty matrix.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix() noexcept = default;
+
+		/**
+		 * Constructor creating a matrix, whose elements are all the same.
+		 *
+		 * \param rows The number of rows.
+		 * \param columns The number of columns.
+		 * \param value The value of the elements.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix(uint32 rows, uint32 columns, T value = T(0));
+
+		/**
+		 * Copy constructor.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix(DenseMatrix const& other);
+
+		/**
+		 * Move constructor, which leaves the other matrix empty.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix(DenseMatrix&& other) noexcept;
+
+		/**
+		 * Destructor.
+		 *
+		 * \since v1.0.0
+		 */
+		~DenseMatrix();
+
+		/**
+		 * Copy assignment operator.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix& operator=(DenseMatrix const& other);
+
+		/**
+		 * Move assignment operator, which leaves the other matrix empty.
+		 *
+		 * \since v1.0.0
+		 */
+		DenseMatrix& operator=(DenseMatrix&& other) noexcept;
+
+		/**
+		 * Changes the size of the matrix. The storage is only reallocated,
+		 * if it grows, and the elements are zero afterwards.
+		 *
+		 * \param rows The number of rows.
+		 * \param columns The number of columns.
+		 *
+		 * \since v1.0.0
+		 */
+		void Resize(uint32 rows, uint32 columns);
+
+		/**
+		 * Sets all elements to the same value.
+		 *
+		 * \param value The value.
+		 *
+		 * \since v1.0.0
+		 */
+		void Fill(T value) noexcept;
+
+		/**
+		 * Element access by row and column.
+		 *
+		 * \param row The row.
+		 * \param column The column.
+		 *
+		 * \returns A reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		T& operator()(uint32 row, uint32 column) noexcept;
+
+		/**
+		 * Element access by row and column.
+		 *
+		 * \param row The row.
+		 * \param column The column.
+		 *
+		 * \returns A constant reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		T const& operator()(uint32 row, uint32 column) const noexcept;
+
+		/**
+		 * Returns the number of rows.
+		 *
+		 * \returns The number of rows.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetRows() const noexcept;
+
+		/**
+		 * Returns the number of columns.
+		 *
+		 * \returns The number of columns.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetColumns() const noexcept;
+
+		/**
+		 * Returns the elements column by column, so that the element of row
+		 * r and column c is at c * GetRows() + r. The first element is
+		 * aligned to 64 bytes.
+		 *
+		 * \returns The elements, or null if the matrix is empty.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T* ECM_CALL GetData() noexcept;
+
+		/**
+		 * Returns the elements column by column, so that the element of row
+		 * r and column c is at c * GetRows() + r. The first element is
+		 * aligned to 64 bytes.
+		 *
+		 * \returns The elements, or null if the matrix is empty.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T const* ECM_CALL GetData() const noexcept;
+	private:
+		T* _data{ nullptr };
+		uint64 _capacity{ 0 };
+		uint32 _rows{ 0 };
+		uint32 _columns{ 0 };
+	};
+
+	extern template class DenseMatrix<float32>;
+	extern template class DenseMatrix<float64>;
+
+	/**
+	 * A dense matrix with single-precision floating-point values (float32).
+	 *
+	 * \since v1.0.0
+	 */
+	using DenseMatrixF = DenseMatrix<float32>;
+
+	/**
+	 * A dense matrix with double-precision floating-point values (float64).
+	 *
+	 * \since v1.0.0
+	 */
+	using DenseMatrixD = DenseMatrix<float64>;
+
+	/**
+	 * Computes C = alpha * op(A) * op(B) + beta * C on multiple threads.
+	 * C must not share its storage with A or B.
+	 *
+	 * \param alpha The factor of the product.
+	 * \param a The matrix A.
+	 * \param opA How A is used.
+	 * \param b The matrix B.
+	 * \param opB How B is used.
+	 * \param beta The factor of C. If it's zero, C is resized to the size of
+	 *             the product and its elements aren't read.
+	 * \param c The matrix C.
+	 *
+	 * \returns False if the sizes of the matrices don't match, in which case
+	 *          C isn't changed, true otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API bool ECM_CALL Gemm(T alpha, DenseMatrix<T> const& a, MatrixOp opA, DenseMatrix<T> const& b,
+		MatrixOp opB, T beta, DenseMatrix<T>& c);
+
+	/**
+	 * Computes y = alpha * op(A) * x + beta * y on multiple threads. y must
+	 * not share its storage with A or x.
+	 *
+	 * \param alpha The factor of the product.
+	 * \param a The matrix A.
+	 * \param opA How A is used.
+	 * \param x The vector x, whose size is the number of columns of op(A).
+	 * \param beta The factor of y. If it's zero, the elements of y aren't
+	 *             read.
+	 * \param y The vector y, whose size is the number of rows of op(A).
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API void ECM_CALL Gemv(T alpha, DenseMatrix<T> const& a, MatrixOp opA, T const* x, T beta,
+		T* y) noexcept;
+
+	/**
+	 * Transposes a matrix in cache-sized blocks on multiple threads.
+	 *
+	 * \param a The matrix.
+	 * \param result The matrix receiving the transposed matrix, which must
+	 *               not be the same as the matrix.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API void ECM_CALL Transpose(DenseMatrix<T> const& a, DenseMatrix<T>& result);
+
+	/**
+	 * Adds two matrices element by element. The result may be one of the
+	 * matrices.
+	 *
+	 * \param a The first matrix.
+	 * \param b The second matrix.
+	 * \param result The matrix receiving the sum.
+	 *
+	 * \returns False if the sizes of the matrices don't match, true
+	 *          otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API bool ECM_CALL Add(DenseMatrix<T> const& a, DenseMatrix<T> const& b, DenseMatrix<T>& result);
+
+	/**
+	 * Subtracts two matrices element by element. The result may be one of
+	 * the matrices.
+	 *
+	 * \param a The first matrix.
+	 * \param b The second matrix.
+	 * \param result The matrix receiving the difference.
+	 *
+	 * \returns False if the sizes of the matrices don't match, true
+	 *          otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API bool ECM_CALL Subtract(DenseMatrix<T> const& a, DenseMatrix<T> const& b, DenseMatrix<T>& result);
+
+	/**
+	 * Multiplies two matrices element by element (Hadamard product). The
+	 * result may be one of the matrices.
+	 *
+	 * \param a The first matrix.
+	 * \param b The second matrix.
+	 * \param result The matrix receiving the product.
+	 *
+	 * \returns False if the sizes of the matrices don't match, true
+	 *          otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API bool ECM_CALL MultiplyElements(DenseMatrix<T> const& a, DenseMatrix<T> const& b,
+		DenseMatrix<T>& result);
+
+	/**
+	 * Multiplies a matrix by a scalar. The result may be the matrix.
+	 *
+	 * \param a The matrix.
+	 * \param scalar The scalar.
+	 * \param result The matrix receiving the product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_MATH_API void ECM_CALL Scale(DenseMatrix<T> const& a, T scalar, DenseMatrix<T>& result);
+} // namespace ecm::math
+
+#endif // !_ECM_DENSE_MATRIX_H_
@@ -0,0 +1,237 @@
+/**
+ * \file dual_quaternion.h
+ *
+ * \brief This header defines a dual quaternion for rigid transformations and
+ * functionalities.
+ *
+ * A dual quaternion stores a rotation r in its real part and half the
+ * translation t times the rotation, 0.5 * (t, 0) * r, in its dual part. The
+ * weighted sum of unit dual quaternions, scaled by the length of its real
+ * part, blends rigid transformations without the volume loss of blended
+ * matrices.
+ */
+
+#pragma once
+#ifndef _ECM_DUAL_QUATERNION_H_
+#define _ECM_DUAL_QUATERNION_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/quaternion.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a dual quaternion template.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct DualQuaternion_Base
+	{
+		typedef T value_type;
+		typedef DualQuaternion_Base<T> type;
+
+		// The rotation
+		Quaternion_Base<T> real;
+		// Half the translation times the rotation
+		Quaternion_Base<T> dual;
+
+		// Basic constructors
+
+		/**
+		 * Default constructor, which creates the identity transformation.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr DualQuaternion_Base();
+
+		/**
+		 * Copy constructor initializing from another dual quaternion.
+		 *
+		 * \param dq The dual quaternion to copy from.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr DualQuaternion_Base(DualQuaternion_Base<T> const& dq);
+
+		/**
+		 * Constructor initializing with the parts.
+		 *
+		 * \param real The real part.
+		 * \param dual The dual part.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr DualQuaternion_Base(Quaternion_Base<T> const& real, Quaternion_Base<T> const& dual);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * \param dq The dual quaternion to assign from.
+		 *
+		 * \returns A reference to this dual quaternion after assignment.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr DualQuaternion_Base<T>& operator=(DualQuaternion_Base<T> const& dq);
+	};
+
+	// Comparison operators
+
+	/**
+	 * This operator checks if the two dual quaternions are the same.
+	 *
+	 * \param dq1 Left operand.
+	 * \param dq2 Right operand.
+	 *
+	 * \returns true if all components are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator==(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2);
+
+	/**
+	 * This operator checks if the two dual quaternions are not the same.
+	 *
+	 * \param dq1 Left operand.
+	 * \param dq2 Right operand.
+	 *
+	 * \returns true if a component differs, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator!=(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2);
+
+	// Arithmetic operators
+
+	/**
+	 * Adds two dual quaternions component-wise.
+	 *
+	 * \param dq1 Left operand.
+	 * \param dq2 Right operand.
+	 *
+	 * \returns The sum.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr DualQuaternion_Base<T> operator+(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2);
+
+	/**
+	 * Multiplies all components by a scalar.
+	 *
+	 * \param dq The dual quaternion.
+	 * \param scalar The scalar.
+	 *
+	 * \returns The scaled dual quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr DualQuaternion_Base<T> operator*(DualQuaternion_Base<T> const& dq, T scalar);
+
+	/**
+	 * Concatenates two transformations, which applies \p dq2 first and
+	 * \p dq1 after it.
+	 *
+	 * \param dq1 Left operand.
+	 * \param dq2 Right operand.
+	 *
+	 * \returns The product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr DualQuaternion_Base<T> operator*(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2);
+
+	// Functions
+
+	/**
+	 * Creates the transformation, which rotates and then translates.
+	 *
+	 * \param rotation The unit rotation.
+	 * \param translation The translation.
+	 *
+	 * \returns The unit dual quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr DualQuaternion_Base<T> ECM_CALL DualQuaternionFromTransform(Quaternion_Base<T> const& rotation, Vector3_Base<T> const& translation) noexcept;
+
+	/**
+	 * Scales a dual quaternion, so that its real part has the length 1.
+	 *
+	 * \param dq The dual quaternion, whose real part must not be 0.
+	 *
+	 * \returns The unit dual quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD DualQuaternion_Base<T> ECM_CALL Normalize(DualQuaternion_Base<T> const& dq) noexcept;
+
+	/**
+	 * Returns the translation of a unit dual quaternion.
+	 *
+	 * \param dq The transformation.
+	 *
+	 * \returns The translation.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL GetTranslation(DualQuaternion_Base<T> const& dq) noexcept;
+
+	/**
+	 * Transforms a point by a unit dual quaternion.
+	 *
+	 * \param dq The transformation.
+	 * \param p The point.
+	 *
+	 * \returns The rotated and translated point.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL Transform(DualQuaternion_Base<T> const& dq, Vector3_Base<T> const& p) noexcept;
+
+	/**
+	 * Converts a unit dual quaternion to a transformation matrix with the
+	 * translation in m[3].
+	 *
+	 * \param dq The transformation.
+	 *
+	 * \returns The transformation matrix.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Matrix4x4_Base<T> ECM_CALL ToMatrix(DualQuaternion_Base<T> const& dq) noexcept;
+
+	/**
+	 * A rigid transformation with single-precision floating-point components.
+	 *
+	 * \since v1.0.0
+	 */
+	using DualQuaternion = DualQuaternion_Base<float32>;
+
+	/**
+	 * A rigid transformation with single-precision floating-point components
+	 * and 16-byte alignment.
+	 *
+	 * \note Requires SIMD alignment for efficient vectorized operations.
+	 *
+	 * \since v1.0.0
+	 */
+	using DualQuaternionA = ECM_ALIGN(16) DualQuaternion;
+} // namespace ecm::math
+
+#include "dual_quaternion.inl"
+
+#endif // !_ECM_DUAL_QUATERNION_H_
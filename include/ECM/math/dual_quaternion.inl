@@ -0,0 +1,109 @@
+#pragma once
+
+#include <ECM/math/dual_quaternion.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	// Basic constructors
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T>::DualQuaternion_Base()
+		: real(), dual(T(0), T(0), T(0), T(0))
+	{}
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T>::DualQuaternion_Base(DualQuaternion_Base<T> const& dq)
+		: real(dq.real), dual(dq.dual)
+	{}
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T>::DualQuaternion_Base(Quaternion_Base<T> const& real, Quaternion_Base<T> const& dual)
+		: real(real), dual(dual)
+	{}
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T>& DualQuaternion_Base<T>::operator=(DualQuaternion_Base<T> const& dq)
+	{
+		real = dq.real;
+		dual = dq.dual;
+		return *this;
+	}
+
+	// Comparison operators
+
+	template<typename T>
+	constexpr bool operator==(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2)
+	{
+		return dq1.real == dq2.real && dq1.dual == dq2.dual;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2)
+	{
+		return !(dq1 == dq2);
+	}
+
+	// Arithmetic operators
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T> operator+(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2)
+	{
+		return DualQuaternion_Base<T>(dq1.real + dq2.real, dq1.dual + dq2.dual);
+	}
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T> operator*(DualQuaternion_Base<T> const& dq, T scalar)
+	{
+		return DualQuaternion_Base<T>(dq.real * scalar, dq.dual * scalar);
+	}
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T> operator*(DualQuaternion_Base<T> const& dq1, DualQuaternion_Base<T> const& dq2)
+	{
+		return DualQuaternion_Base<T>(dq1.real * dq2.real, dq1.real * dq2.dual + dq1.dual * dq2.real);
+	}
+
+	// Functions
+
+	template<typename T>
+	constexpr DualQuaternion_Base<T> DualQuaternionFromTransform(Quaternion_Base<T> const& rotation, Vector3_Base<T> const& translation) noexcept
+	{
+		const Quaternion_Base<T> t(translation.x * T(0.5), translation.y * T(0.5), translation.z * T(0.5), T(0));
+		return DualQuaternion_Base<T>(rotation, t * rotation);
+	}
+
+	template<typename T>
+	DualQuaternion_Base<T> Normalize(DualQuaternion_Base<T> const& dq) noexcept
+	{
+		const T length{ static_cast<T>(std::sqrt(Dot(dq.real, dq.real))) };
+		return dq * (T(1) / length);
+	}
+
+	template<typename T>
+	constexpr Vector3_Base<T> GetTranslation(DualQuaternion_Base<T> const& dq) noexcept
+	{
+		const Quaternion_Base<T> t{ dq.dual * Conjugate(dq.real) };
+		return Vector3_Base<T>(t.x * T(2), t.y * T(2), t.z * T(2));
+	}
+
+	template<typename T>
+	constexpr Vector3_Base<T> Transform(DualQuaternion_Base<T> const& dq, Vector3_Base<T> const& p) noexcept
+	{
+		const Vector3_Base<T> r{ Rotate(dq.real, p) };
+		const Vector3_Base<T> t{ GetTranslation(dq) };
+		return Vector3_Base<T>(r.x + t.x, r.y + t.y, r.z + t.z);
+	}
+
+	template<typename T>
+	constexpr Matrix4x4_Base<T> ToMatrix(DualQuaternion_Base<T> const& dq) noexcept
+	{
+		Matrix4x4_Base<T> m{ ToMatrix(dq.real) };
+		const Vector3_Base<T> t{ GetTranslation(dq) };
+		m.m30 = t.x;
+		m.m31 = t.y;
+		m.m32 = t.z;
+		return m;
+	}
+} // namespace ecm::math
@@ -0,0 +1,459 @@
+/**
+ * \file easing.h
+ *
+ * \brief This header defines easing curves and batch functions for the
+ * interpolation of animation channels.
+ *
+ * The batch functions process eight values at once with AVX2 and four with
+ * SSE2, and return the same values as Ease and as the scalar functions Lerp,
+ * Clamp, SmoothStep and Remap, unless the compiler contracts the latter to
+ * fused multiply-adds. Arrays of vectors are processed like arrays of their
+ * components.
+ *
+ * EvaluateTracks fuses the normalization of the time, the easing and the
+ * interpolation of many tracks into one pass, and splits large batches into
+ * chunks, which run on the threads of ParallelFor.
+ */
+
+#pragma once
+#ifndef _ECM_EASING_H_
+#define _ECM_EASING_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector2.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines the easing curves. They map the range [0, 1]
+	 * to a curve from 0 to 1, which overshoots for the elastic and back
+	 * curves.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class EaseType : uint8
+	{
+		LINEAR = 0x0,
+		QUAD_IN,
+		QUAD_OUT,
+		QUAD_IN_OUT,
+		CUBIC_IN,
+		CUBIC_OUT,
+		CUBIC_IN_OUT,
+		/* 2^(10t - 10), exactly 0 at t = 0 */
+		EXPO_IN,
+		EXPO_OUT,
+		EXPO_IN_OUT,
+		/* A sine with the period 0.3, which decays with the expo curve */
+		ELASTIC_IN,
+		ELASTIC_OUT,
+		ELASTIC_IN_OUT,
+		/* A cubic, which overshoots by 10% */
+		BACK_IN,
+		BACK_OUT,
+		BACK_IN_OUT
+	} EaseType;
+
+	/**
+	 * This structure defines the timing of tracks, which are evaluated by
+	 * EvaluateTracks. Track i runs from start[i] to start[i] + duration[i].
+	 *
+	 * \since v1.0.0
+	 */
+	struct EaseTracks
+	{
+		/* The easing curve of all tracks */
+		EaseType type{ EaseType::LINEAR };
+		/* The start times */
+		float32 const* start{ nullptr };
+		/* The durations. A track with a duration of 0 jumps to its end
+		   value after its start time. */
+		float32 const* duration{ nullptr };
+	};
+
+	/**
+	 * Evaluates an easing curve. The exponential and sine curves use
+	 * polynomial approximations with an error of a few ulp.
+	 *
+	 * \param type The easing curve.
+	 * \param t The position, which is clamped to the range [0, 1].
+	 *
+	 * \returns The value of the curve at \p t.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Ease(EaseType type, float32 t) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Linearly interpolates arrays with one factor: out[i] = Lerp(x[i], y[i], t).
+	 *
+	 * \param x The start values.
+	 * \param y The end values.
+	 * \param t The interpolation factor.
+	 * \param out The array receiving count values. It may be x or y.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(float32 const* x, float32 const* y, float32 t, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays with one factor per value:
+	 * out[i] = Lerp(x[i], y[i], t[i]).
+	 *
+	 * \param x The start values.
+	 * \param y The end values.
+	 * \param t The interpolation factors.
+	 * \param out The array receiving count values. It may be x, y or t.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(float32 const* x, float32 const* y, float32 const* t, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 2D vectors with one factor.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factor.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector2_Base<float32> const* x, Vector2_Base<float32> const* y, float32 t,
+		Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 3D vectors with one factor.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factor.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector3_Base<float32> const* x, Vector3_Base<float32> const* y, float32 t,
+		Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 4D vectors with one factor.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factor.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector4_Base<float32> const* x, Vector4_Base<float32> const* y, float32 t,
+		Vector4_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 2D vectors with one factor per vector.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factors.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector2_Base<float32> const* x, Vector2_Base<float32> const* y, float32 const* t,
+		Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 3D vectors with one factor per vector.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factors.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector3_Base<float32> const* x, Vector3_Base<float32> const* y, float32 const* t,
+		Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Linearly interpolates arrays of 4D vectors with one factor per vector.
+	 *
+	 * \param x The start vectors.
+	 * \param y The end vectors.
+	 * \param t The interpolation factors.
+	 * \param out The array receiving count vectors. It may be x or y.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LerpBatch(Vector4_Base<float32> const* x, Vector4_Base<float32> const* y, float32 const* t,
+		Vector4_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Clamps an array: out[i] = Clamp(v[i], min, max).
+	 *
+	 * \param v The input values.
+	 * \param min The minimum bound.
+	 * \param max The maximum bound, not less than \p min.
+	 * \param out The array receiving count values. It may be v.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ClampBatch(float32 const* v, float32 min, float32 max, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Clamps the components of an array of 2D vectors to the ones of the
+	 * bounds.
+	 *
+	 * \param v The input vectors.
+	 * \param min The minimum bounds.
+	 * \param max The maximum bounds, not less than \p min.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ClampBatch(Vector2_Base<float32> const* v, Vector2_Base<float32> const& min,
+		Vector2_Base<float32> const& max, Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Clamps the components of an array of 3D vectors to the ones of the
+	 * bounds.
+	 *
+	 * \param v The input vectors.
+	 * \param min The minimum bounds.
+	 * \param max The maximum bounds, not less than \p min.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ClampBatch(Vector3_Base<float32> const* v, Vector3_Base<float32> const& min,
+		Vector3_Base<float32> const& max, Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Clamps the components of an array of 4D vectors to the ones of the
+	 * bounds.
+	 *
+	 * \param v The input vectors.
+	 * \param min The minimum bounds.
+	 * \param max The maximum bounds, not less than \p min.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ClampBatch(Vector4_Base<float32> const* v, Vector4_Base<float32> const& min,
+		Vector4_Base<float32> const& max, Vector4_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Applies SmoothStep to an array: out[i] = SmoothStep(edge0, edge1, x[i]).
+	 *
+	 * \param edge0 The value, which gives 0.
+	 * \param edge1 The value, which gives 1.
+	 * \param x The input values.
+	 * \param out The array receiving count values. It may be x.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SmoothStepBatch(float32 edge0, float32 edge1, float32 const* x, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Applies SmoothStep to the components of an array of 2D vectors.
+	 *
+	 * \param edge0 The value, which gives 0.
+	 * \param edge1 The value, which gives 1.
+	 * \param x The input vectors.
+	 * \param out The array receiving count vectors. It may be x.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SmoothStepBatch(float32 edge0, float32 edge1, Vector2_Base<float32> const* x,
+		Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Applies SmoothStep to the components of an array of 3D vectors.
+	 *
+	 * \param edge0 The value, which gives 0.
+	 * \param edge1 The value, which gives 1.
+	 * \param x The input vectors.
+	 * \param out The array receiving count vectors. It may be x.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SmoothStepBatch(float32 edge0, float32 edge1, Vector3_Base<float32> const* x,
+		Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Applies SmoothStep to the components of an array of 4D vectors.
+	 *
+	 * \param edge0 The value, which gives 0.
+	 * \param edge1 The value, which gives 1.
+	 * \param x The input vectors.
+	 * \param out The array receiving count vectors. It may be x.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SmoothStepBatch(float32 edge0, float32 edge1, Vector4_Base<float32> const* x,
+		Vector4_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Maps an array from one range to another:
+	 * out[i] = Remap(v[i], inMin, inMax, outMin, outMax).
+	 *
+	 * \param v The input values.
+	 * \param inMin The start of the input range.
+	 * \param inMax The end of the input range.
+	 * \param outMin The start of the output range.
+	 * \param outMax The end of the output range.
+	 * \param out The array receiving count values. It may be v.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL RemapBatch(float32 const* v, float32 inMin, float32 inMax, float32 outMin, float32 outMax,
+		float32* out, uint64 count) noexcept;
+
+	/**
+	 * Maps the components of an array of 2D vectors from one range to
+	 * another.
+	 *
+	 * \param v The input vectors.
+	 * \param inMin The start of the input range.
+	 * \param inMax The end of the input range.
+	 * \param outMin The start of the output range.
+	 * \param outMax The end of the output range.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL RemapBatch(Vector2_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Maps the components of an array of 3D vectors from one range to
+	 * another.
+	 *
+	 * \param v The input vectors.
+	 * \param inMin The start of the input range.
+	 * \param inMax The end of the input range.
+	 * \param outMin The start of the output range.
+	 * \param outMax The end of the output range.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL RemapBatch(Vector3_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Maps the components of an array of 4D vectors from one range to
+	 * another.
+	 *
+	 * \param v The input vectors.
+	 * \param inMin The start of the input range.
+	 * \param inMax The end of the input range.
+	 * \param outMin The start of the output range.
+	 * \param outMax The end of the output range.
+	 * \param out The array receiving count vectors. It may be v.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL RemapBatch(Vector4_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector4_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Evaluates an easing curve for an array: out[i] = Ease(type, t[i]).
+	 *
+	 * \param type The easing curve.
+	 * \param t The positions.
+	 * \param out The array receiving count values. It may be t.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EaseBatch(EaseType type, float32 const* t, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Evaluates tracks at a time. The value of track i is
+	 * Lerp(from[i], to[i], Ease(tracks.type, (time - start[i]) / duration[i])).
+	 * Tracks with different curves are evaluated by separate calls.
+	 *
+	 * \param tracks The timing of the tracks.
+	 * \param time The time.
+	 * \param from The start values.
+	 * \param to The end values.
+	 * \param out The array receiving count values.
+	 * \param count The number of tracks.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EvaluateTracks(EaseTracks const& tracks, float32 time, float32 const* from, float32 const* to,
+		float32* out, uint64 count) noexcept;
+
+	/**
+	 * Evaluates tracks of 2D vectors at a time.
+	 *
+	 * \param tracks The timing of the tracks.
+	 * \param time The time.
+	 * \param from The start vectors.
+	 * \param to The end vectors.
+	 * \param out The array receiving count vectors.
+	 * \param count The number of tracks.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EvaluateTracks(EaseTracks const& tracks, float32 time, Vector2_Base<float32> const* from,
+		Vector2_Base<float32> const* to, Vector2_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Evaluates tracks of 3D vectors at a time.
+	 *
+	 * \param tracks The timing of the tracks.
+	 * \param time The time.
+	 * \param from The start vectors.
+	 * \param to The end vectors.
+	 * \param out The array receiving count vectors.
+	 * \param count The number of tracks.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EvaluateTracks(EaseTracks const& tracks, float32 time, Vector3_Base<float32> const* from,
+		Vector3_Base<float32> const* to, Vector3_Base<float32>* out, uint64 count) noexcept;
+
+	/**
+	 * Evaluates tracks of 4D vectors at a time.
+	 *
+	 * \param tracks The timing of the tracks.
+	 * \param time The time.
+	 * \param from The start vectors.
+	 * \param to The end vectors.
+	 * \param out The array receiving count vectors.
+	 * \param count The number of tracks.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EvaluateTracks(EaseTracks const& tracks, float32 time, Vector4_Base<float32> const* from,
+		Vector4_Base<float32> const* to, Vector4_Base<float32>* out, uint64 count) noexcept;
+} // namespace ecm::math
+
+#endif // !_ECM_EASING_H_
@@ -0,0 +1,350 @@
+/**
+ * \file integer_ext.h
+ *
+ * \brief This header defines SIMD accelerated functionalities for integer
+ *        vectors and matrices.
+ */
+
+#pragma once
+#ifndef _ECM_INTEGER_EXT_H_
+#define _ECM_INTEGER_EXT_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector.h>
+#include <ECM/math/matrix.h>
+
+#include <type_traits>
+
+namespace ecm::math
+{
+	// Component-wise functions
+
+	/**
+	 * Computes the component-wise minimum of two integer 4D vectors.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A vector containing the smaller component of each pair.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL Min(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Computes the component-wise maximum of two integer 4D vectors.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A vector containing the greater component of each pair.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL Max(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Adds two integer 4D vectors component-wise and clamps each sum to the
+	 * range of \p T instead of wrapping around.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A vector containing the saturated sums.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL AddSat(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Subtracts two integer 4D vectors component-wise and clamps each
+	 * difference to the range of \p T instead of wrapping around.
+	 *
+	 * \param v1 The vector to subtract from.
+	 * \param v2 The vector to subtract.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A vector containing the saturated differences.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL SubSat(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Shifts each component of an integer 4D vector to the left.
+	 *
+	 * \param v The vector to shift.
+	 * \param bits The number of bits to shift, in the range [0, 31].
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns The shifted vector.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL ShiftLeft(Vector4_Base<T> const& v, int32 bits);
+
+	/**
+	 * Shifts each component of an integer 4D vector to the right. Signed
+	 * components are shifted arithmetically and unsigned components are shifted
+	 * logically.
+	 *
+	 * \param v The vector to shift.
+	 * \param bits The number of bits to shift, in the range [0, 31].
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns The shifted vector.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL ShiftRight(Vector4_Base<T> const& v, int32 bits);
+
+	/**
+	 * Compares two integer 4D vectors component-wise for equality.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A boolean vector, where each component is true if the
+	 *          components are equal.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<bool> ECM_CALL Equal(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Compares two integer 4D vectors component-wise for \p v1 < \p v2.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A boolean vector, where each component is true if the component
+	 *          of \p v1 is less than the one of \p v2.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<bool> ECM_CALL Less(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	/**
+	 * Compares two integer 4D vectors component-wise for \p v1 > \p v2.
+	 *
+	 * \param v1 The first vector.
+	 * \param v2 The second vector.
+	 *
+	 * \tparam T The integral type of the vector components.
+	 *
+	 * \returns A boolean vector, where each component is true if the component
+	 *          of \p v1 is greater than the one of \p v2.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+	ECM_NODISCARD constexpr Vector4_Base<bool> ECM_CALL Greater(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2);
+
+	// Batch functions
+
+	/**
+	 * Adds the vectors of two arrays component-wise.
+	 *
+	 * Processes two vectors per iteration with AVX2 and one with SSE2. The
+	 * arrays may alias each other.
+	 *
+	 * \param a The first array of vectors.
+	 * \param b The second array of vectors.
+	 * \param out The array receiving \p a[i] + \p b[i].
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL AddBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc AddBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL AddBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Subtracts the vectors of two arrays component-wise.
+	 *
+	 * \param a The array of vectors to subtract from.
+	 * \param b The array of vectors to subtract.
+	 * \param out The array receiving \p a[i] - \p b[i].
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SubBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc SubBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL SubBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Multiplies the vectors of two arrays component-wise and keeps the low
+	 * 32 bits of each product.
+	 *
+	 * \param a The first array of vectors.
+	 * \param b The second array of vectors.
+	 * \param out The array receiving \p a[i] * \p b[i].
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc MulBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Computes the component-wise minimum of the vectors of two arrays.
+	 *
+	 * \param a The first array of vectors.
+	 * \param b The second array of vectors.
+	 * \param out The array receiving Min(\p a[i], \p b[i]).
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MinBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc MinBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL MinBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Computes the component-wise maximum of the vectors of two arrays.
+	 *
+	 * \param a The first array of vectors.
+	 * \param b The second array of vectors.
+	 * \param out The array receiving Max(\p a[i], \p b[i]).
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MaxBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc MaxBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL MaxBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Adds the vectors of two arrays component-wise with saturation.
+	 *
+	 * \param a The first array of vectors.
+	 * \param b The second array of vectors.
+	 * \param out The array receiving AddSat(\p a[i], \p b[i]).
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL AddSatBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc AddSatBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL AddSatBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Subtracts the vectors of two arrays component-wise with saturation.
+	 *
+	 * \param a The array of vectors to subtract from.
+	 * \param b The array of vectors to subtract.
+	 * \param out The array receiving SubSat(\p a[i], \p b[i]).
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SubSatBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc SubSatBatch(Vector4i const*, Vector4i const*, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL SubSatBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count);
+
+	/**
+	 * Shifts each component of the vectors of an array to the left.
+	 *
+	 * \param in The array of vectors to shift.
+	 * \param bits The number of bits to shift, in the range [0, 31].
+	 * \param out The array receiving the shifted vectors.
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ShiftLeftBatch(Vector4i const* in, int32 bits, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc ShiftLeftBatch(Vector4i const*, int32, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL ShiftLeftBatch(Vector4u const* in, int32 bits, Vector4u* out, uint64 count);
+
+	/**
+	 * Shifts each component of the vectors of an array to the right. Signed
+	 * components are shifted arithmetically and unsigned components are shifted
+	 * logically.
+	 *
+	 * \param in The array of vectors to shift.
+	 * \param bits The number of bits to shift, in the range [0, 31].
+	 * \param out The array receiving the shifted vectors.
+	 * \param count The number of vectors in each array.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ShiftRightBatch(Vector4i const* in, int32 bits, Vector4i* out, uint64 count);
+
+	/**
+	 * \copydoc ShiftRightBatch(Vector4i const*, int32, Vector4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL ShiftRightBatch(Vector4u const* in, int32 bits, Vector4u* out, uint64 count);
+
+	/**
+	 * Multiplies the matrices of two arrays. The products wrap around like the
+	 * scalar integer multiplication.
+	 *
+	 * \param a The array of left matrix operands.
+	 * \param b The array of right matrix operands.
+	 * \param out The array receiving \p a[i] * \p b[i], which must not alias
+	 *            \p a or \p b.
+	 * \param count The number of matrices in each array.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa Matrix4x4_Base
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Matrix4x4i const* a, Matrix4x4i const* b, Matrix4x4i* out, uint64 count);
+
+	/**
+	 * \copydoc MulBatch(Matrix4x4i const*, Matrix4x4i const*, Matrix4x4i*, uint64)
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Matrix4x4u const* a, Matrix4x4u const* b, Matrix4x4u* out, uint64 count);
+} // namespace ecm::math
+
+#include "integer_ext.inl"
+
+#endif // !_ECM_INTEGER_EXT_H_
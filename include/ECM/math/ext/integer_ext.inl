@@ -0,0 +1,224 @@
+#pragma once
+
+#include <ECM/math/ext/integer_ext.h>
+#include <ECM/math/functions_simd.h>
+
+#include <limits>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		template<typename T>
+		constexpr T add_sat(T x, T y) noexcept
+		{
+			constexpr T max{ std::numeric_limits<T>::max() };
+			constexpr T min{ std::numeric_limits<T>::min() };
+			if constexpr (std::is_signed_v<T>) {
+				if (y > 0 && x > max - y) return max;
+				if (y < 0 && x < min - y) return min;
+			}
+			else {
+				if (x > max - y) return max;
+			}
+			return static_cast<T>(x + y);
+		}
+
+		template<typename T>
+		constexpr T sub_sat(T x, T y) noexcept
+		{
+			constexpr T max{ std::numeric_limits<T>::max() };
+			constexpr T min{ std::numeric_limits<T>::min() };
+			if constexpr (std::is_signed_v<T>) {
+				if (y < 0 && x > max + y) return max;
+				if (y > 0 && x < min + y) return min;
+			}
+			else {
+				if (x < y) return min;
+			}
+			return static_cast<T>(x - y);
+		}
+
+		ECM_FORCEINLINE Vector4_Base<bool> to_bool4(__m128i mask)
+		{
+			const int32 bits{ _mm_movemask_ps(_mm_castsi128_ps(mask)) };
+			return Vector4_Base<bool>(
+				(bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0, (bits & 8) != 0);
+		}
+	} // namespace detail
+
+	// Component-wise functions
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> Min(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::store_int4<T>(MinI32(a, b));
+				}
+				else {
+					return detail::store_int4<T>(MinU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<T>(
+			v1.x < v2.x ? v1.x : v2.x,
+			v1.y < v2.y ? v1.y : v2.y,
+			v1.z < v2.z ? v1.z : v2.z,
+			v1.w < v2.w ? v1.w : v2.w);
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> Max(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::store_int4<T>(MaxI32(a, b));
+				}
+				else {
+					return detail::store_int4<T>(MaxU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<T>(
+			v1.x > v2.x ? v1.x : v2.x,
+			v1.y > v2.y ? v1.y : v2.y,
+			v1.z > v2.z ? v1.z : v2.z,
+			v1.w > v2.w ? v1.w : v2.w);
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> AddSat(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::store_int4<T>(AddSatI32(a, b));
+				}
+				else {
+					return detail::store_int4<T>(AddSatU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<T>(
+			detail::add_sat(v1.x, v2.x),
+			detail::add_sat(v1.y, v2.y),
+			detail::add_sat(v1.z, v2.z),
+			detail::add_sat(v1.w, v2.w));
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> SubSat(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::store_int4<T>(SubSatI32(a, b));
+				}
+				else {
+					return detail::store_int4<T>(SubSatU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<T>(
+			detail::sub_sat(v1.x, v2.x),
+			detail::sub_sat(v1.y, v2.y),
+			detail::sub_sat(v1.z, v2.z),
+			detail::sub_sat(v1.w, v2.w));
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> ShiftLeft(Vector4_Base<T> const& v, int32 bits)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::store_int4<T>(
+					_mm_sll_epi32(detail::load_int4(v), _mm_cvtsi32_si128(bits)));
+			}
+		}
+		return Vector4_Base<T>(
+			static_cast<T>(v.x << bits),
+			static_cast<T>(v.y << bits),
+			static_cast<T>(v.z << bits),
+			static_cast<T>(v.w << bits));
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<T> ShiftRight(Vector4_Base<T> const& v, int32 bits)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i count{ _mm_cvtsi32_si128(bits) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::store_int4<T>(_mm_sra_epi32(detail::load_int4(v), count));
+				}
+				else {
+					return detail::store_int4<T>(_mm_srl_epi32(detail::load_int4(v), count));
+				}
+			}
+		}
+		return Vector4_Base<T>(
+			static_cast<T>(v.x >> bits),
+			static_cast<T>(v.y >> bits),
+			static_cast<T>(v.z >> bits),
+			static_cast<T>(v.w >> bits));
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<bool> Equal(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::to_bool4(
+					_mm_cmpeq_epi32(detail::load_int4(v1), detail::load_int4(v2)));
+			}
+		}
+		return Vector4_Base<bool>(v1.x == v2.x, v1.y == v2.y, v1.z == v2.z, v1.w == v2.w);
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<bool> Less(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::to_bool4(_mm_cmplt_epi32(a, b));
+				}
+				else {
+					return detail::to_bool4(CmpLtU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<bool>(v1.x < v2.x, v1.y < v2.y, v1.z < v2.z, v1.w < v2.w);
+	}
+
+	template<typename T, typename>
+	constexpr Vector4_Base<bool> Greater(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
+	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i a{ detail::load_int4(v1) };
+				const __m128i b{ detail::load_int4(v2) };
+				if constexpr (std::is_signed_v<T>) {
+					return detail::to_bool4(_mm_cmpgt_epi32(a, b));
+				}
+				else {
+					return detail::to_bool4(CmpGtU32(a, b));
+				}
+			}
+		}
+		return Vector4_Base<bool>(v1.x > v2.x, v1.y > v2.y, v1.z > v2.z, v1.w > v2.w);
+	}
+} // namespace ecm::math
@@ -10,6 +10,7 @@
 
 #include <ECM/ECM_api.h>
 #include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
 #include <ECM/math/vector2.h>
 #include <ECM/math/vector3.h>
 #include <ECM/math/vector4.h>
@@ -42,7 +43,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename W, typename = std::enable_if_t<std::is_arithmetic<W>::value>>
+	template<typename T, typename U, typename W, typename = std::enable_if_t<is_arithmetic_v<W>>>
 	ECM_NODISCARD constexpr Vector2_Base<T> ECM_CALL Lerp(const Vector2_Base<T>& x, const Vector2_Base<U>& y, W t);
 
 	/**
@@ -67,7 +68,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename W, typename = std::enable_if_t<std::is_arithmetic<W>::value>>
+	template<typename T, typename U, typename W, typename = std::enable_if_t<is_arithmetic_v<W>>>
 	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL Lerp(const Vector3_Base<T>& x, const Vector3_Base<U>& y, W t);
 
 	/**
@@ -92,7 +93,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename W, typename = std::enable_if_t<std::is_arithmetic<W>::value>>
+	template<typename T, typename U, typename W, typename = std::enable_if_t<is_arithmetic_v<W>>>
 	ECM_NODISCARD constexpr Vector4_Base<T> ECM_CALL Lerp(const Vector4_Base<T>& x, const Vector4_Base<U>& y, W t);
 
 	/**
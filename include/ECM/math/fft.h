@@ -0,0 +1,350 @@
+/**
+ * \file fft.h
+ *
+ * \brief This header defines fast Fourier transforms of complex and real
+ * float32 signals in one and two dimensions.
+ *
+ * A plan precomputes the twiddle factors and the bit reversal of one size,
+ * so it is created once and executed for every signal of that size. The
+ * sizes must be powers of two. The complex transforms combine a radix-2
+ * stage with radix-4 stages, whose butterflies run on two complex numbers
+ * at once with SSE2 and on four with AVX2. The real transforms compute a
+ * complex transform of half the size and split its result into the
+ * spectrum of the real signal.
+ *
+ * The two-dimensional plans transform the rows, transpose the result in
+ * cache-sized blocks, transform the rows of the transposed signal and
+ * transpose it back. The rows and blocks run on the threads of
+ * ParallelFor, and so do the stages of large one-dimensional transforms.
+ *
+ * No transform is normalized: the inverse of the forward transform of a
+ * signal is the signal multiplied by its number of elements.
+ */
+
+#pragma once
+#ifndef _ECM_FFT_H_
+#define _ECM_FFT_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a complex number. Its layout matches
+	 * std::complex<float> and the interleaved arrays of other FFT libraries.
+	 *
+	 * \since v1.0.0
+	 */
+	struct ComplexF
+	{
+		float32 real{ 0.0f };
+		float32 imag{ 0.0f };
+	};
+
+	/**
+	 * This enumeration defines the direction of a Fourier transform.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class FftDirection : uint8
+	{
+		/* The transform with the kernel exp(-2 pi i n k / N) */
+		FORWARD = 0x0,
+		/* The transform with the kernel exp(2 pi i n k / N) */
+		INVERSE
+	} FftDirection;
+
+	/**
+	 * This class represents a plan of one-dimensional complex Fourier
+	 * transforms of a fixed size.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API FftPlan
+	{
+	public:
+		/**
+		 * Constructor creating an empty plan, whose transforms do nothing.
+		 *
+		 * \since v1.0.0
+		 */
+		FftPlan() noexcept = default;
+
+		/**
+		 * Creates the plan of a size.
+		 *
+		 * \param size The number of complex elements, which must be a power
+		 *             of two.
+		 *
+		 * \returns False if the size isn't a power of two, in which case the
+		 *          plan is empty, true otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Create(uint32 size);
+
+		/**
+		 * Transforms a signal. The output may be the input, which
+		 * transforms the signal in place.
+		 *
+		 * \param input The GetSize() elements of the signal.
+		 * \param output The GetSize() elements receiving the transform.
+		 * \param direction The direction of the transform.
+		 *
+		 * \since v1.0.0
+		 */
+		void Execute(ComplexF const* input, ComplexF* output, FftDirection direction) const noexcept;
+
+		/**
+		 * Returns the number of complex elements of the transforms.
+		 *
+		 * \returns The size, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetSize() const noexcept;
+	private:
+		// The twiddle factors of the radix-4 stages, three arrays for each
+		// stage from the smallest to the largest
+		std::vector<ComplexF> _twiddles{};
+		// The index, which is swapped with each index
+		std::vector<uint32> _reversed{};
+		uint32 _size{ 0 };
+	};
+
+	/**
+	 * This class represents a plan of one-dimensional Fourier transforms of
+	 * real signals of a fixed size.
+	 *
+	 * The spectrum of a real signal of N elements is symmetric, so only its
+	 * N / 2 + 1 first complex elements are computed. Their storage holds the
+	 * N + 2 real elements of a signal, which lets the transforms run in
+	 * place.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API RealFftPlan
+	{
+	public:
+		/**
+		 * Constructor creating an empty plan, whose transforms do nothing.
+		 *
+		 * \since v1.0.0
+		 */
+		RealFftPlan() noexcept = default;
+
+		/**
+		 * Creates the plan of a size.
+		 *
+		 * \param size The number of real elements, which must be a power of
+		 *             two and at least 2.
+		 *
+		 * \returns False if the size is invalid, in which case the plan is
+		 *          empty, true otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Create(uint32 size);
+
+		/**
+		 * Computes the spectrum of a real signal. The input may be the
+		 * storage of the output, which transforms the signal in place.
+		 *
+		 * \param input The GetSize() elements of the signal.
+		 * \param output The GetSize() / 2 + 1 elements receiving the
+		 *               spectrum.
+		 *
+		 * \since v1.0.0
+		 */
+		void Forward(float32 const* input, ComplexF* output) const noexcept;
+
+		/**
+		 * Computes the real signal of a spectrum. The output may be the
+		 * storage of the input, which transforms the spectrum in place. The
+		 * imaginary parts of the first and the last element are ignored.
+		 *
+		 * \param input The GetSize() / 2 + 1 elements of the spectrum.
+		 * \param output The GetSize() elements receiving the signal.
+		 *
+		 * \since v1.0.0
+		 */
+		void Inverse(ComplexF const* input, float32* output) const noexcept;
+
+		/**
+		 * Returns the number of real elements of the transforms.
+		 *
+		 * \returns The size, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetSize() const noexcept;
+	private:
+		// The complex plan of half the size
+		FftPlan _half{};
+		// The factors exp(-2 pi i k / N) of the split for k < N / 4 + 1
+		std::vector<ComplexF> _twiddles{};
+		uint32 _size{ 0 };
+	};
+
+	/**
+	 * This class represents a plan of two-dimensional complex Fourier
+	 * transforms of a fixed size. The signals are stored row by row, so that
+	 * the element of row y and column x is at y * GetWidth() + x.
+	 *
+	 * The plan owns the storage of the transposed signal, so it executes one
+	 * transform at a time.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API FftPlan2D
+	{
+	public:
+		/**
+		 * Constructor creating an empty plan, whose transforms do nothing.
+		 *
+		 * \since v1.0.0
+		 */
+		FftPlan2D() noexcept = default;
+
+		/**
+		 * Creates the plan of a size.
+		 *
+		 * \param width The number of columns, which must be a power of two.
+		 * \param height The number of rows, which must be a power of two.
+		 *
+		 * \returns False if a size isn't a power of two, in which case the
+		 *          plan is empty, true otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Create(uint32 width, uint32 height);
+
+		/**
+		 * Transforms a signal on multiple threads. The output may be the
+		 * input, which transforms the signal in place.
+		 *
+		 * \param input The GetWidth() * GetHeight() elements of the signal.
+		 * \param output The GetWidth() * GetHeight() elements receiving the
+		 *               transform.
+		 * \param direction The direction of the transform.
+		 *
+		 * \since v1.0.0
+		 */
+		void Execute(ComplexF const* input, ComplexF* output, FftDirection direction);
+
+		/**
+		 * Returns the number of columns of the transforms.
+		 *
+		 * \returns The width, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetWidth() const noexcept;
+
+		/**
+		 * Returns the number of rows of the transforms.
+		 *
+		 * \returns The height, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetHeight() const noexcept;
+	private:
+		FftPlan _rows{};
+		FftPlan _columns{};
+		// The transposed signal, whose rows are the columns of the signal
+		std::vector<ComplexF> _transposed{};
+	};
+
+	/**
+	 * This class represents a plan of two-dimensional Fourier transforms of
+	 * real signals of a fixed size. The signals are stored row by row, so
+	 * that the element of row y and column x is at y * GetWidth() + x.
+	 *
+	 * The spectrum has GetWidth() / 2 + 1 columns and GetHeight() rows and
+	 * is stored row by row as well. The plan owns the storage of the
+	 * transposed spectrum, so it executes one transform at a time.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API RealFftPlan2D
+	{
+	public:
+		/**
+		 * Constructor creating an empty plan, whose transforms do nothing.
+		 *
+		 * \since v1.0.0
+		 */
+		RealFftPlan2D() noexcept = default;
+
+		/**
+		 * Creates the plan of a size.
+		 *
+		 * \param width The number of columns, which must be a power of two
+		 *              and at least 2.
+		 * \param height The number of rows, which must be a power of two.
+		 *
+		 * \returns False if a size is invalid, in which case the plan is
+		 *          empty, true otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Create(uint32 width, uint32 height);
+
+		/**
+		 * Computes the spectrum of a real signal on multiple threads.
+		 *
+		 * \param input The GetWidth() * GetHeight() elements of the signal.
+		 * \param output The (GetWidth() / 2 + 1) * GetHeight() elements
+		 *               receiving the spectrum, which must not share their
+		 *               storage with the signal.
+		 *
+		 * \since v1.0.0
+		 */
+		void Forward(float32 const* input, ComplexF* output);
+
+		/**
+		 * Computes the real signal of a spectrum on multiple threads. The
+		 * spectrum is used as storage of the intermediate results, so its
+		 * elements are undefined afterwards.
+		 *
+		 * \param input The (GetWidth() / 2 + 1) * GetHeight() elements of
+		 *              the spectrum.
+		 * \param output The GetWidth() * GetHeight() elements receiving the
+		 *               signal, which must not share their storage with
+		 *               the spectrum.
+		 *
+		 * \since v1.0.0
+		 */
+		void Inverse(ComplexF* input, float32* output);
+
+		/**
+		 * Returns the number of columns of the signals.
+		 *
+		 * \returns The width, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetWidth() const noexcept;
+
+		/**
+		 * Returns the number of rows of the signals.
+		 *
+		 * \returns The height, which is zero for an empty plan.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetHeight() const noexcept;
+	private:
+		RealFftPlan _rows{};
+		FftPlan _columns{};
+		// The transposed spectrum, whose rows are the columns of the
+		// spectrum
+		std::vector<ComplexF> _transposed{};
+	};
+} // namespace ecm::math
+
+#endif // !_ECM_FFT_H_
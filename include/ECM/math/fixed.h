@@ -0,0 +1,648 @@
+/**
+ * \file fixed.h
+ *
+ * \brief This header defines a fixed-point number type and functionalities.
+ *
+ * Fixed-point arithmetic only uses integer instructions, so its results are
+ * bit-identical on every compiler and CPU. This makes it suitable for
+ * deterministic simulations, like lockstep networking, where floating-point
+ * results can differ between builds.
+ */
+
+#pragma once
+#ifndef _ECM_FIXED_H_
+#define _ECM_FIXED_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
+
+#include <limits>
+#include <type_traits>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a signed fixed-point number with IntBits
+	 * integer bits, including the sign bit, and FracBits fractional bits.
+	 *
+	 * The number is stored as a 32-bit or 64-bit integer, which is the value
+	 * multiplied with 2^FracBits. Additions and subtractions are exact,
+	 * multiplications round to the nearest representable value (ties towards
+	 * positive infinity) and divisions truncate towards zero.
+	 *
+	 * An overflow wraps around like an unsigned integer does. Debug builds
+	 * (ECM_DEBUG) check every operation with ECM_ASSERT instead.
+	 *
+	 * Integers convert implicitly and exactly, floating-point values only
+	 * explicitly, so that no floating-point value slips into a deterministic
+	 * calculation by accident.
+	 *
+	 * \tparam IntBits The number of integer bits, including the sign bit.
+	 * \tparam FracBits The number of fractional bits. The sum of both must be
+	 *                  32 or 64.
+	 *
+	 * \note Like the built-in arithmetic types, a default constructed Fixed
+	 *       is uninitialized.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	struct Fixed
+	{
+		static_assert(IntBits > 0 && FracBits > 0, "Fixed needs at least one integer and one fractional bit.");
+		static_assert(IntBits + FracBits == 32 || IntBits + FracBits == 64, "Fixed must be 32 or 64 bits wide.");
+
+		typedef std::conditional_t<IntBits + FracBits == 32, int32, int64> raw_type;
+		typedef Fixed<IntBits, FracBits> type;
+
+		// The number of integer bits, including the sign bit.
+		static constexpr int32 INT_BITS{ IntBits };
+		// The number of fractional bits.
+		static constexpr int32 FRAC_BITS{ FracBits };
+
+		// The value multiplied with 2^FracBits.
+		raw_type raw;
+
+		// Basic constructors
+
+		/**
+		 * Default constructor.
+		 *
+		 * \since v1.0.0
+		 */
+		Fixed() = default;
+
+		/**
+		 * Constructor converting an integer. The conversion is exact.
+		 *
+		 * \param value The integer, which must be in the range of the type.
+		 *
+		 * \since v1.0.0
+		 */
+		template<typename U, std::enable_if_t<std::is_integral<U>::value, int32> = 0>
+		constexpr Fixed(U value) noexcept;
+
+		/**
+		 * Constructor converting a floating-point value, rounding to the
+		 * nearest representable value (ties away from zero).
+		 *
+		 * \param value The floating-point value, which must be in the range
+		 *              of the type.
+		 *
+		 * \since v1.0.0
+		 */
+		template<typename U, std::enable_if_t<std::is_floating_point<U>::value, int32> = 0>
+		constexpr explicit Fixed(U value) noexcept;
+
+		/**
+		 * Constructor converting a fixed-point number of another format.
+		 * Dropped fractional bits are rounded like a multiplication does.
+		 *
+		 * \param f The fixed-point number, which must be in the range of the
+		 *          type.
+		 *
+		 * \since v1.0.0
+		 */
+		template<int32 I, int32 F>
+		constexpr explicit Fixed(Fixed<I, F> const& f) noexcept;
+
+		/**
+		 * Creates a fixed-point number from its raw value.
+		 *
+		 * \param raw The value multiplied with 2^FracBits.
+		 *
+		 * \returns The fixed-point number.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr Fixed ECM_CALL FromRaw(raw_type raw) noexcept;
+
+		/**
+		 * Converts the number to an arithmetic type. Integers are truncated
+		 * towards zero like floating-point values are.
+		 *
+		 * \tparam U The arithmetic type.
+		 *
+		 * \returns The converted value.
+		 *
+		 * \since v1.0.0
+		 */
+		template<typename U, std::enable_if_t<std::is_arithmetic<U>::value, int32> = 0>
+		constexpr explicit operator U() const noexcept;
+
+		// Unary arithmetic operators
+
+		/**
+		 * Adds another number to this one.
+		 *
+		 * \param f The number to add.
+		 *
+		 * \returns A reference to this number.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Fixed& operator+=(Fixed f) noexcept;
+
+		/**
+		 * Subtracts another number from this one.
+		 *
+		 * \param f The number to subtract.
+		 *
+		 * \returns A reference to this number.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Fixed& operator-=(Fixed f) noexcept;
+
+		/**
+		 * Multiplies this number with another one.
+		 *
+		 * \param f The number to multiply with.
+		 *
+		 * \returns A reference to this number.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Fixed& operator*=(Fixed f) noexcept;
+
+		/**
+		 * Divides this number by another one.
+		 *
+		 * \param f The divisor, which must not be zero.
+		 *
+		 * \returns A reference to this number.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Fixed& operator/=(Fixed f) noexcept;
+	};
+
+	/**
+	 * Specialization making fixed-point numbers usable as the scalars of
+	 * vectors and matrices.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	struct is_arithmetic<Fixed<IntBits, FracBits>> : std::true_type {};
+
+	// Unary operators
+
+	/**
+	 * Returns the number unchanged.
+	 *
+	 * \param f The number.
+	 *
+	 * \returns The number.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator+(Fixed<IntBits, FracBits> f) noexcept;
+
+	/**
+	 * Negates the number.
+	 *
+	 * \param f The number.
+	 *
+	 * \returns The negated number.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator-(Fixed<IntBits, FracBits> f) noexcept;
+
+	// Binary operators
+
+	/**
+	 * Adds two numbers.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns The sum.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator+(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Adds an integer to a number.
+	 *
+	 * \param f The number.
+	 * \param i The integer.
+	 *
+	 * \returns The sum.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator+(Fixed<IntBits, FracBits> f, U i) noexcept;
+
+	/**
+	 * Adds a number to an integer.
+	 *
+	 * \param i The integer.
+	 * \param f The number.
+	 *
+	 * \returns The sum.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator+(U i, Fixed<IntBits, FracBits> f) noexcept;
+
+	/**
+	 * Subtracts two numbers.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns The difference.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator-(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Subtracts an integer from a number.
+	 *
+	 * \param f The number.
+	 * \param i The integer.
+	 *
+	 * \returns The difference.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator-(Fixed<IntBits, FracBits> f, U i) noexcept;
+
+	/**
+	 * Subtracts a number from an integer.
+	 *
+	 * \param i The integer.
+	 * \param f The number.
+	 *
+	 * \returns The difference.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator-(U i, Fixed<IntBits, FracBits> f) noexcept;
+
+	/**
+	 * Multiplies two numbers, rounding to the nearest representable value.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns The product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator*(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Multiplies a number with an integer. The result is exact.
+	 *
+	 * \param f The number.
+	 * \param i The integer.
+	 *
+	 * \returns The product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator*(Fixed<IntBits, FracBits> f, U i) noexcept;
+
+	/**
+	 * Multiplies an integer with a number. The result is exact.
+	 *
+	 * \param i The integer.
+	 * \param f The number.
+	 *
+	 * \returns The product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator*(U i, Fixed<IntBits, FracBits> f) noexcept;
+
+	/**
+	 * Divides two numbers, truncating towards zero.
+	 *
+	 * \param f1 The dividend.
+	 * \param f2 The divisor, which must not be zero.
+	 *
+	 * \returns The quotient.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator/(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Divides a number by an integer, truncating towards zero.
+	 *
+	 * \param f The dividend.
+	 * \param i The divisor, which must not be zero.
+	 *
+	 * \returns The quotient.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator/(Fixed<IntBits, FracBits> f, U i) noexcept;
+
+	/**
+	 * Divides an integer by a number, truncating towards zero.
+	 *
+	 * \param i The dividend.
+	 * \param f The divisor, which must not be zero.
+	 *
+	 * \returns The quotient.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits, typename U, typename = std::enable_if_t<std::is_integral<U>::value>>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL operator/(U i, Fixed<IntBits, FracBits> f) noexcept;
+
+	// Comparison operators
+
+	/**
+	 * Checks whether two numbers are equal.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if both numbers are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator==(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Checks whether two numbers are unequal.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if both numbers are unequal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator!=(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Checks whether the left number is less than the right one.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if the left number is less, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator<(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Checks whether the left number is less than or equal to the right one.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if the left number is less or equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator<=(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Checks whether the left number is greater than the right one.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if the left number is greater, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator>(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	/**
+	 * Checks whether the left number is greater than or equal to the right
+	 * one.
+	 *
+	 * \param f1 The left operand.
+	 * \param f2 The right operand.
+	 *
+	 * \returns true if the left number is greater or equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr bool ECM_CALL operator>=(
+		Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept;
+
+	// Functions
+
+	/**
+	 * Calculates the square root of a fixed-point number. The result is
+	 * exact, rounded down to the next representable value.
+	 *
+	 * \param x The number, which must not be negative.
+	 *
+	 * \returns The square root, or 0 for negative numbers.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL Sqrt(Fixed<IntBits, FracBits> x) noexcept;
+
+	/**
+	 * Calculates the sine of an angle in radians.
+	 *
+	 * The angle is reduced to a full turn and the sine is interpolated between
+	 * 256 table entries with a Taylor polynomial, all in integer arithmetic.
+	 * The result is rounded to the nearest Q16.16 number, and the absolute
+	 * error is below 2^-29 for formats with more fractional bits.
+	 *
+	 * \param x The angle in radians.
+	 *
+	 * \returns The sine.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL Sin(Fixed<IntBits, FracBits> x) noexcept;
+
+	/**
+	 * Calculates the cosine of an angle in radians, like Sin does.
+	 *
+	 * \param x The angle in radians.
+	 *
+	 * \returns The cosine.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 IntBits, int32 FracBits>
+	ECM_NODISCARD constexpr Fixed<IntBits, FracBits> ECM_CALL Cos(Fixed<IntBits, FracBits> x) noexcept;
+
+	// Definitions
+
+	/**
+	 * A fixed-point number with 16 integer and 16 fractional bits (Q16.16).
+	 *
+	 * It covers the range of [-32768, 32768) with a resolution of 1/65536.
+	 *
+	 * \since v1.0.0
+	 */
+	using Fixed16_16 = Fixed<16, 16>;
+
+	/**
+	 * A fixed-point number with 32 integer and 32 fractional bits (Q32.32).
+	 *
+	 * It covers the range of [-2^31, 2^31) with a resolution of 2^-32.
+	 *
+	 * \since v1.0.0
+	 */
+	using Fixed32_32 = Fixed<32, 32>;
+
+	// Batch functions
+
+	/**
+	 * Adds two arrays of Q16.16 numbers element-wise. Overflows wrap around.
+	 *
+	 * Processes eight numbers per iteration with AVX2 and four with SSE2.
+	 *
+	 * \param a The left operands.
+	 * \param b The right operands.
+	 * \param out The array receiving the sums. May be equal to a or b.
+	 * \param count The number of elements.
+	 *
+	 * \note Arrays of fixed-point vectors or matrices can be processed by
+	 *       passing their first component and the number of components.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL AddBatch(Fixed16_16 const* a, Fixed16_16 const* b, Fixed16_16* out, uint64 count);
+
+	/**
+	 * Multiplies two arrays of Q16.16 numbers element-wise with the same
+	 * rounding as the scalar multiplication. Overflows wrap around.
+	 *
+	 * Processes eight numbers per iteration with AVX2 and four with SSE2.
+	 *
+	 * \param a The left operands.
+	 * \param b The right operands.
+	 * \param out The array receiving the products. May be equal to a or b.
+	 * \param count The number of elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Fixed16_16 const* a, Fixed16_16 const* b, Fixed16_16* out, uint64 count);
+
+	/**
+	 * Adds two arrays of Q32.32 numbers element-wise. Overflows wrap around.
+	 *
+	 * Processes four numbers per iteration with AVX2 and two with SSE2.
+	 *
+	 * \param a The left operands.
+	 * \param b The right operands.
+	 * \param out The array receiving the sums. May be equal to a or b.
+	 * \param count The number of elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL AddBatch(Fixed32_32 const* a, Fixed32_32 const* b, Fixed32_32* out, uint64 count);
+
+	/**
+	 * Multiplies two arrays of Q32.32 numbers element-wise. Overflows wrap
+	 * around.
+	 *
+	 * \param a The left operands.
+	 * \param b The right operands.
+	 * \param out The array receiving the products. May be equal to a or b.
+	 * \param count The number of elements.
+	 *
+	 * \note SSE and AVX2 lack a 64-bit multiplication with a 128-bit result,
+	 *       so this function uses scalar instructions.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MulBatch(Fixed32_32 const* a, Fixed32_32 const* b, Fixed32_32* out, uint64 count);
+} // namespace ecm::math
+
+namespace std
+{
+	/**
+	 * Specialization of the numeric limits for fixed-point numbers. Like for
+	 * floating-point types, min() is the smallest positive value and lowest() the
+	 * most negative one.
+	 *
+	 * \since v1.0.0
+	 */
+	template<ecm::int32 IntBits, ecm::int32 FracBits>
+	class numeric_limits<ecm::math::Fixed<IntBits, FracBits>>
+	{
+		using type = ecm::math::Fixed<IntBits, FracBits>;
+		using raw_limits = std::numeric_limits<typename type::raw_type>;
+
+	public:
+		static constexpr bool is_specialized{ true };
+		static constexpr bool is_signed{ true };
+		static constexpr bool is_integer{ false };
+		static constexpr bool is_exact{ true };
+		static constexpr bool has_infinity{ false };
+		static constexpr bool has_quiet_NaN{ false };
+		static constexpr bool has_signaling_NaN{ false };
+		static constexpr std::float_denorm_style has_denorm{ std::denorm_absent };
+		static constexpr bool has_denorm_loss{ false };
+		static constexpr std::float_round_style round_style{ std::round_to_nearest };
+		static constexpr bool is_iec559{ false };
+		static constexpr bool is_bounded{ true };
+		static constexpr bool is_modulo{ true };
+		static constexpr int digits{ IntBits + FracBits - 1 };
+		static constexpr int digits10{ raw_limits::digits10 };
+		static constexpr int max_digits10{ 0 };
+		static constexpr int radix{ 2 };
+		static constexpr int min_exponent{ 0 };
+		static constexpr int min_exponent10{ 0 };
+		static constexpr int max_exponent{ 0 };
+		static constexpr int max_exponent10{ 0 };
+		static constexpr bool traps{ false };
+		static constexpr bool tinyness_before{ false };
+
+		static constexpr type min() noexcept { return type::FromRaw(1); }
+		static constexpr type lowest() noexcept { return type::FromRaw(raw_limits::min()); }
+		static constexpr type max() noexcept { return type::FromRaw(raw_limits::max()); }
+		static constexpr type epsilon() noexcept { return type::FromRaw(1); }
+		static constexpr type round_error() noexcept { return type::FromRaw(typename type::raw_type{ 1 } << (FracBits - 1)); }
+		static constexpr type infinity() noexcept { return type::FromRaw(0); }
+		static constexpr type quiet_NaN() noexcept { return type::FromRaw(0); }
+		static constexpr type signaling_NaN() noexcept { return type::FromRaw(0); }
+		static constexpr type denorm_min() noexcept { return type::FromRaw(1); }
+	};
+} // namespace std
+
+#include "fixed.inl"
+
+#endif // !_ECM_FIXED_H_
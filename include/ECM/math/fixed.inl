@@ -0,0 +1,653 @@
+#pragma once
+
+#include <ECM/math/fixed.h>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// Unsigned 128-bit arithmetic for the intermediate results of 64-bit
+		// fixed-point numbers. Both implementations give identical results.
+#if defined(__SIZEOF_INT128__)
+		using uint128 = unsigned __int128;
+
+		constexpr uint128 make_uint128(uint64 v) noexcept
+		{
+			return v;
+		}
+
+		constexpr uint64 low64(uint128 v) noexcept
+		{
+			return static_cast<uint64>(v);
+		}
+
+		constexpr uint64 high64(uint128 v) noexcept
+		{
+			return static_cast<uint64>(v >> 64);
+		}
+
+		constexpr uint128 mul_64x64(uint64 a, uint64 b) noexcept
+		{
+			return static_cast<uint128>(a) * b;
+		}
+
+		constexpr uint128 div_128x64(uint128 n, uint64 d) noexcept
+		{
+			return n / d;
+		}
+#else
+		struct uint128
+		{
+			uint64 hi;
+			uint64 lo;
+
+			constexpr uint128 operator+(uint128 v) const noexcept
+			{
+				const uint64 l{ this->lo + v.lo };
+				return { this->hi + v.hi + (l < this->lo ? 1u : 0u), l };
+			}
+
+			constexpr uint128 operator-(uint128 v) const noexcept
+			{
+				return { this->hi - v.hi - (this->lo < v.lo ? 1u : 0u), this->lo - v.lo };
+			}
+
+			constexpr uint128 operator<<(int32 s) const noexcept
+			{
+				if (s == 0) {
+					return *this;
+				}
+				if (s >= 64) {
+					return { this->lo << (s - 64), 0 };
+				}
+				return { (this->hi << s) | (this->lo >> (64 - s)), this->lo << s };
+			}
+
+			constexpr uint128 operator>>(int32 s) const noexcept
+			{
+				if (s == 0) {
+					return *this;
+				}
+				if (s >= 64) {
+					return { 0, this->hi >> (s - 64) };
+				}
+				return { this->hi >> s, (this->lo >> s) | (this->hi << (64 - s)) };
+			}
+
+			constexpr uint128 operator|(uint128 v) const noexcept
+			{
+				return { this->hi | v.hi, this->lo | v.lo };
+			}
+
+			constexpr bool operator==(uint128 v) const noexcept
+			{
+				return this->hi == v.hi && this->lo == v.lo;
+			}
+
+			constexpr bool operator!=(uint128 v) const noexcept
+			{
+				return !(*this == v);
+			}
+
+			constexpr bool operator<(uint128 v) const noexcept
+			{
+				return this->hi < v.hi || (this->hi == v.hi && this->lo < v.lo);
+			}
+
+			constexpr bool operator>(uint128 v) const noexcept
+			{
+				return v < *this;
+			}
+
+			constexpr bool operator>=(uint128 v) const noexcept
+			{
+				return !(*this < v);
+			}
+		};
+
+		constexpr uint128 make_uint128(uint64 v) noexcept
+		{
+			return { 0, v };
+		}
+
+		constexpr uint64 low64(uint128 v) noexcept
+		{
+			return v.lo;
+		}
+
+		constexpr uint64 high64(uint128 v) noexcept
+		{
+			return v.hi;
+		}
+
+		constexpr uint128 mul_64x64(uint64 a, uint64 b) noexcept
+		{
+			constexpr uint64 mask{ 0xffffffffu };
+			const uint64 p00{ (a & mask) * (b & mask) };
+			const uint64 p01{ (a & mask) * (b >> 32) };
+			const uint64 p10{ (a >> 32) * (b & mask) };
+			const uint64 p11{ (a >> 32) * (b >> 32) };
+			const uint64 mid{ (p00 >> 32) + (p01 & mask) + (p10 & mask) };
+			return { p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32), (mid << 32) | (p00 & mask) };
+		}
+
+		// Restoring long division, one quotient bit per iteration.
+		constexpr uint128 div_128x64(uint128 n, uint64 d) noexcept
+		{
+			uint128 q{ 0, 0 };
+			uint64 r{ 0 };
+			for (int32 i{ 127 }; i >= 0; --i) {
+				const bool carry{ (r >> 63) != 0 };
+				r = (r << 1) | (low64(n >> i) & 1u);
+				q = q << 1;
+				if (carry || r >= d) {
+					r -= d;
+					q.lo |= 1u;
+				}
+			}
+			return q;
+		}
+#endif // __SIZEOF_INT128__
+
+		// The absolute value of a signed integer, which is also correct for
+		// the most negative value.
+		constexpr uint64 uabs(int64 v) noexcept
+		{
+			return v < 0 ? 0u - static_cast<uint64>(v) : static_cast<uint64>(v);
+		}
+
+		// Checks whether an integer is in the integer range of a fixed-point
+		// format.
+		template<int32 IntBits, typename U>
+		constexpr bool fixed_int_fits(U value) noexcept
+		{
+			constexpr uint64 bound{ uint64{ 1 } << (IntBits - 1) };
+			if constexpr (std::is_signed<U>::value) {
+				return value < 0 ? uabs(value) <= bound : static_cast<uint64>(value) < bound;
+			}
+			else {
+				return static_cast<uint64>(value) < bound;
+			}
+		}
+
+		// Checks whether an unsigned magnitude with a sign fits into int64.
+		constexpr bool int64_fits(uint64 magnitude, bool negative) noexcept
+		{
+			return magnitude <= static_cast<uint64>(std::numeric_limits<int64>::max()) + (negative ? 1u : 0u);
+		}
+
+		// Applies a sign to an unsigned magnitude, wrapping like a cast does.
+		constexpr int64 apply_sign(uint64 magnitude, bool negative) noexcept
+		{
+			return static_cast<int64>(negative ? 0u - magnitude : magnitude);
+		}
+
+		// Multiplies two raw values and shifts the product right, rounding
+		// to the nearest value with ties towards positive infinity.
+		template<int32 Shift>
+		constexpr int32 fixed_mul(int32 a, int32 b) noexcept
+		{
+			const int64 product{ static_cast<int64>(a) * b };
+			const int64 result{ (product + (int64{ 1 } << (Shift - 1))) >> Shift };
+			ECM_ASSERT(result >= std::numeric_limits<int32>::min() && result <= std::numeric_limits<int32>::max());
+			return static_cast<int32>(result);
+		}
+
+		template<int32 Shift>
+		constexpr int64 fixed_mul(int64 a, int64 b) noexcept
+		{
+			const bool negative{ (a < 0) != (b < 0) };
+			const uint128 magnitude{ mul_64x64(uabs(a), uabs(b)) };
+			ECM_ASSERT(high64(magnitude >> Shift) == 0 && int64_fits(low64(magnitude >> Shift), negative));
+			// Rounding in two's complement floors negative results correctly
+			const uint128 product{ negative ? make_uint128(0) - magnitude : magnitude };
+			const uint128 rounded{ product + (make_uint128(1) << (Shift - 1)) };
+			return static_cast<int64>(low64(rounded >> Shift));
+		}
+
+		// Divides two raw values, the dividend being shifted left first.
+		template<int32 Shift>
+		constexpr int32 fixed_div(int32 a, int32 b) noexcept
+		{
+			ECM_ASSERT(b != 0);
+			const int64 result{ static_cast<int64>(a) * (int64{ 1 } << Shift) / b };
+			ECM_ASSERT(result >= std::numeric_limits<int32>::min() && result <= std::numeric_limits<int32>::max());
+			return static_cast<int32>(result);
+		}
+
+		template<int32 Shift>
+		constexpr int64 fixed_div(int64 a, int64 b) noexcept
+		{
+			ECM_ASSERT(b != 0);
+			const bool negative{ (a < 0) != (b < 0) };
+			const uint128 quotient{ div_128x64(make_uint128(uabs(a)) << Shift, uabs(b)) };
+			ECM_ASSERT(high64(quotient) == 0 && int64_fits(low64(quotient), negative));
+			return apply_sign(low64(quotient), negative);
+		}
+
+		// Adds or subtracts raw values, wrapping around on overflow.
+		template<typename R>
+		constexpr R fixed_add(R a, R b) noexcept
+		{
+			using UR = std::make_unsigned_t<R>;
+			const R result{ static_cast<R>(static_cast<UR>(a) + static_cast<UR>(b)) };
+			// An overflow occurred if the sign of the result differs from both
+			ECM_ASSERT(((a ^ result) & (b ^ result)) >= 0);
+			return result;
+		}
+
+		template<typename R>
+		constexpr R fixed_sub(R a, R b) noexcept
+		{
+			using UR = std::make_unsigned_t<R>;
+			const R result{ static_cast<R>(static_cast<UR>(a) - static_cast<UR>(b)) };
+			ECM_ASSERT(((a ^ b) & (a ^ result)) >= 0);
+			return result;
+		}
+
+		// Multiplies a raw value with an integer, wrapping around on overflow.
+		template<typename R, typename U>
+		constexpr R fixed_mul_int(R a, U i) noexcept
+		{
+			using UR = std::make_unsigned_t<R>;
+			ECM_ASSERT(static_cast<float64>(a) * static_cast<float64>(i) >= static_cast<float64>(std::numeric_limits<R>::min())
+				&& static_cast<float64>(a) * static_cast<float64>(i) <= static_cast<float64>(std::numeric_limits<R>::max()));
+			return static_cast<R>(static_cast<UR>(a) * static_cast<UR>(i));
+		}
+
+		// sin(k * pi / 128) for k in [0, 64] in Q1.31 format, rounded to
+		// nearest. The cosines are the same entries in reverse order.
+		inline constexpr uint32 fixed_sin_table[65]{
+			0u, 52701887u, 105372028u, 157978697u,
+			210490206u, 262874923u, 315101295u, 367137861u,
+			418953276u, 470516330u, 521795963u, 572761285u,
+			623381598u, 673626408u, 723465451u, 772868706u,
+			821806413u, 870249095u, 918167572u, 965532978u,
+			1012316784u, 1058490808u, 1104027237u, 1148898640u,
+			1193077991u, 1236538675u, 1279254516u, 1321199781u,
+			1362349204u, 1402678000u, 1442161874u, 1480777044u,
+			1518500250u, 1555308768u, 1591180426u, 1626093616u,
+			1660027308u, 1692961062u, 1724875040u, 1755750017u,
+			1785567396u, 1814309216u, 1841958164u, 1868497586u,
+			1893911494u, 1918184581u, 1941302225u, 1963250501u,
+			1984016189u, 2003586779u, 2021950484u, 2039096241u,
+			2055013723u, 2069693342u, 2083126254u, 2095304370u,
+			2106220352u, 2115867626u, 2124240380u, 2131333572u,
+			2137142927u, 2141664948u, 2144896910u, 2146836866u,
+			2147483648u
+		};
+
+		// Converts an angle to a phase, where 2^40 is one full turn. The
+		// factor is 2^61 / pi, so the phase is raw * factor / 2^(FracBits + 22).
+		template<int32 FracBits, typename R>
+		constexpr uint64 fixed_phase(R raw) noexcept
+		{
+			constexpr uint64 factor{ 733972625820500307u };
+			constexpr uint64 mask{ (uint64{ 1 } << 40) - 1 };
+			const uint64 phase{ low64(mul_64x64(uabs(raw), factor) >> (FracBits + 22)) };
+			return (raw < 0 ? 0u - phase : phase) & mask;
+		}
+
+		// Calculates the sine and cosine of a phase in Q1.31 format.
+		//
+		// The phase selects the quadrant and one of 64 table entries in it.
+		// The remaining angle d is below pi / 128, and the sum formulas
+		// sin(a + d) = sin(a) cos(d) + cos(a) sin(d) and
+		// cos(a + d) = cos(a) cos(d) - sin(a) sin(d) are evaluated with the
+		// Taylor polynomials of sin(d) and cos(d).
+		constexpr void fixed_sin_cos(uint64 phase, int64& outSin, int64& outCos) noexcept
+		{
+			constexpr int64 one{ int64{ 1 } << 31 };
+			constexpr uint64 piQ29{ 1686629713u };
+			const uint32 quadrant{ static_cast<uint32>(phase >> 38) };
+			const uint32 index{ static_cast<uint32>(phase >> 32) & 63u };
+			const uint64 frac{ phase & 0xffffffffu };
+
+			// The remaining angle in radians, frac * 2 pi / 2^40, in Q1.31
+			const int64 d{ static_cast<int64>((frac * piQ29 + (uint64{ 1 } << 36)) >> 37) };
+			const int64 d2{ (d * d) >> 31 };
+			const int64 d3{ (d2 * d) >> 31 };
+			const int64 d4{ (d2 * d2) >> 31 };
+			const int64 sinD{ d - d3 / 6 };
+			const int64 cosD{ one - d2 / 2 + d4 / 24 };
+
+			const int64 sinA{ fixed_sin_table[index] };
+			const int64 cosA{ fixed_sin_table[64 - index] };
+			const int64 s{ (sinA * cosD + cosA * sinD + (int64{ 1 } << 30)) >> 31 };
+			const int64 c{ (cosA * cosD - sinA * sinD + (int64{ 1 } << 30)) >> 31 };
+			switch (quadrant) {
+			case 0:
+				outSin = s;
+				outCos = c;
+				break;
+			case 1:
+				outSin = c;
+				outCos = -s;
+				break;
+			case 2:
+				outSin = -s;
+				outCos = -c;
+				break;
+			default:
+				outSin = -c;
+				outCos = s;
+				break;
+			}
+		}
+
+		// Converts a value in [-1, 1] from Q1.31 to a fixed-point number.
+		template<int32 IntBits, int32 FracBits>
+		constexpr Fixed<IntBits, FracBits> fixed_from_q31(int64 v) noexcept
+		{
+			using raw_type = typename Fixed<IntBits, FracBits>::raw_type;
+			int64 raw{ 0 };
+			if constexpr (FracBits == 31) {
+				raw = v;
+			}
+			else if constexpr (FracBits < 31) {
+				raw = (v + (int64{ 1 } << (30 - FracBits))) >> (31 - FracBits);
+			}
+			else {
+				raw = v * (int64{ 1 } << (FracBits - 31));
+			}
+			// With one integer bit, 1 is not representable
+			if constexpr (IntBits == 1) {
+				raw = raw > std::numeric_limits<raw_type>::max() ? std::numeric_limits<raw_type>::max() : raw;
+			}
+			return Fixed<IntBits, FracBits>::FromRaw(static_cast<raw_type>(raw));
+		}
+	} // namespace detail
+
+	// Basic constructors
+
+	template<int32 IntBits, int32 FracBits>
+	template<typename U, std::enable_if_t<std::is_integral<U>::value, int32>>
+	constexpr Fixed<IntBits, FracBits>::Fixed(U value) noexcept
+		: raw(static_cast<raw_type>(static_cast<std::make_unsigned_t<raw_type>>(value) << FracBits))
+	{
+		ECM_ASSERT(detail::fixed_int_fits<IntBits>(value));
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	template<typename U, std::enable_if_t<std::is_floating_point<U>::value, int32>>
+	constexpr Fixed<IntBits, FracBits>::Fixed(U value) noexcept
+		: raw(0)
+	{
+		// Scaling by a power of two is exact
+		const float64 scaled{ static_cast<float64>(value) * static_cast<float64>(uint64{ 1 } << FracBits) };
+		ECM_ASSERT(scaled >= static_cast<float64>(std::numeric_limits<raw_type>::min())
+			&& scaled < -static_cast<float64>(std::numeric_limits<raw_type>::min()));
+		const raw_type truncated{ static_cast<raw_type>(scaled) };
+		const float64 rest{ scaled - static_cast<float64>(truncated) };
+		this->raw = truncated + (rest >= 0.5 ? 1 : (rest <= -0.5 ? -1 : 0));
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	template<int32 I, int32 F>
+	constexpr Fixed<IntBits, FracBits>::Fixed(Fixed<I, F> const& f) noexcept
+		: raw(0)
+	{
+		if constexpr (F > FracBits) {
+			constexpr int32 shift{ F - FracBits };
+			const int64 v{ static_cast<int64>(f.raw) };
+			// Rounded like fixed_mul, without overflowing for large values
+			const int64 result{ (v >> shift) + ((v >> (shift - 1)) & 1) };
+			ECM_ASSERT(result >= std::numeric_limits<raw_type>::min() && result <= std::numeric_limits<raw_type>::max());
+			this->raw = static_cast<raw_type>(result);
+		}
+		else {
+			constexpr int32 shift{ FracBits - F };
+			ECM_ASSERT(detail::fixed_int_fits<IntBits>(f.raw >> F));
+			this->raw = static_cast<raw_type>(static_cast<uint64>(static_cast<int64>(f.raw)) << shift);
+		}
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> Fixed<IntBits, FracBits>::FromRaw(raw_type raw) noexcept
+	{
+		Fixed<IntBits, FracBits> result{};
+		result.raw = raw;
+		return result;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	template<typename U, std::enable_if_t<std::is_arithmetic<U>::value, int32>>
+	constexpr Fixed<IntBits, FracBits>::operator U() const noexcept
+	{
+		if constexpr (std::is_floating_point<U>::value) {
+			return static_cast<U>(static_cast<float64>(this->raw) / static_cast<float64>(uint64{ 1 } << FracBits));
+		}
+		else {
+			const uint64 magnitude{ detail::uabs(this->raw) >> FracBits };
+			return static_cast<U>(detail::apply_sign(magnitude, this->raw < 0));
+		}
+	}
+
+	// Unary arithmetic operators
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits>& Fixed<IntBits, FracBits>::operator+=(Fixed f) noexcept
+	{
+		this->raw = detail::fixed_add(this->raw, f.raw);
+		return *this;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits>& Fixed<IntBits, FracBits>::operator-=(Fixed f) noexcept
+	{
+		this->raw = detail::fixed_sub(this->raw, f.raw);
+		return *this;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits>& Fixed<IntBits, FracBits>::operator*=(Fixed f) noexcept
+	{
+		this->raw = detail::fixed_mul<FracBits>(this->raw, f.raw);
+		return *this;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits>& Fixed<IntBits, FracBits>::operator/=(Fixed f) noexcept
+	{
+		this->raw = detail::fixed_div<FracBits>(this->raw, f.raw);
+		return *this;
+	}
+
+	// Unary operators
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator+(Fixed<IntBits, FracBits> f) noexcept
+	{
+		return f;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator-(Fixed<IntBits, FracBits> f) noexcept
+	{
+		using raw_type = typename Fixed<IntBits, FracBits>::raw_type;
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_sub(raw_type{ 0 }, f.raw));
+	}
+
+	// Binary operators
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator+(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_add(f1.raw, f2.raw));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator+(Fixed<IntBits, FracBits> f, U i) noexcept
+	{
+		return f + Fixed<IntBits, FracBits>(i);
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator+(U i, Fixed<IntBits, FracBits> f) noexcept
+	{
+		return Fixed<IntBits, FracBits>(i) + f;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator-(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_sub(f1.raw, f2.raw));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator-(Fixed<IntBits, FracBits> f, U i) noexcept
+	{
+		return f - Fixed<IntBits, FracBits>(i);
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator-(U i, Fixed<IntBits, FracBits> f) noexcept
+	{
+		return Fixed<IntBits, FracBits>(i) - f;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator*(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_mul<FracBits>(f1.raw, f2.raw));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator*(Fixed<IntBits, FracBits> f, U i) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_mul_int(f.raw, i));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator*(U i, Fixed<IntBits, FracBits> f) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_mul_int(f.raw, i));
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> operator/(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return Fixed<IntBits, FracBits>::FromRaw(detail::fixed_div<FracBits>(f1.raw, f2.raw));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator/(Fixed<IntBits, FracBits> f, U i) noexcept
+	{
+		using raw_type = typename Fixed<IntBits, FracBits>::raw_type;
+		ECM_ASSERT(i != 0);
+		const int64 result{ static_cast<int64>(f.raw) / static_cast<int64>(i) };
+		ECM_ASSERT(result >= std::numeric_limits<raw_type>::min() && result <= std::numeric_limits<raw_type>::max());
+		return Fixed<IntBits, FracBits>::FromRaw(static_cast<raw_type>(result));
+	}
+
+	template<int32 IntBits, int32 FracBits, typename U, typename>
+	constexpr Fixed<IntBits, FracBits> operator/(U i, Fixed<IntBits, FracBits> f) noexcept
+	{
+		return Fixed<IntBits, FracBits>(i) / f;
+	}
+
+	// Comparison operators
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator==(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw == f2.raw;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator!=(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw != f2.raw;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator<(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw < f2.raw;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator<=(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw <= f2.raw;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator>(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw > f2.raw;
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr bool operator>=(Fixed<IntBits, FracBits> f1, Fixed<IntBits, FracBits> f2) noexcept
+	{
+		return f1.raw >= f2.raw;
+	}
+
+	// Functions
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> Sqrt(Fixed<IntBits, FracBits> x) noexcept
+	{
+		using raw_type = typename Fixed<IntBits, FracBits>::raw_type;
+		ECM_ASSERT(x.raw >= 0);
+		if (x.raw <= 0) {
+			return Fixed<IntBits, FracBits>::FromRaw(0);
+		}
+
+		// The raw result is the integer square root of raw * 2^FracBits,
+		// calculated digit by digit.
+		using wide_type = std::conditional_t<sizeof(raw_type) == 4, uint64, detail::uint128>;
+		wide_type n{};
+		wide_type result{};
+		wide_type bit{};
+		if constexpr (sizeof(raw_type) == 4) {
+			n = static_cast<uint64>(x.raw) << FracBits;
+			result = 0;
+			bit = uint64{ 1 } << 62;
+		}
+		else {
+			n = detail::make_uint128(static_cast<uint64>(x.raw)) << FracBits;
+			result = detail::make_uint128(0);
+			bit = detail::make_uint128(1) << 126;
+		}
+		while (bit > n) {
+			bit = bit >> 2;
+		}
+		while (bit != wide_type{}) {
+			if (n >= result + bit) {
+				n = n - (result + bit);
+				result = (result >> 1) + bit;
+			}
+			else {
+				result = result >> 1;
+			}
+			bit = bit >> 2;
+		}
+
+		if constexpr (sizeof(raw_type) == 4) {
+			return Fixed<IntBits, FracBits>::FromRaw(static_cast<raw_type>(result));
+		}
+		else {
+			return Fixed<IntBits, FracBits>::FromRaw(static_cast<raw_type>(detail::low64(result)));
+		}
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> Sin(Fixed<IntBits, FracBits> x) noexcept
+	{
+		int64 sinQ31{ 0 };
+		int64 cosQ31{ 0 };
+		detail::fixed_sin_cos(detail::fixed_phase<FracBits>(x.raw), sinQ31, cosQ31);
+		return detail::fixed_from_q31<IntBits, FracBits>(sinQ31);
+	}
+
+	template<int32 IntBits, int32 FracBits>
+	constexpr Fixed<IntBits, FracBits> Cos(Fixed<IntBits, FracBits> x) noexcept
+	{
+		int64 sinQ31{ 0 };
+		int64 cosQ31{ 0 };
+		detail::fixed_sin_cos(detail::fixed_phase<FracBits>(x.raw), sinQ31, cosQ31);
+		return detail::fixed_from_q31<IntBits, FracBits>(cosQ31);
+	}
+} // namespace ecm::math
@@ -0,0 +1,164 @@
+/**
+ * \file float16.h
+ *
+ * \brief This header defines a 16-bit floating type and conversion
+ *        functionalities.
+ */
+
+#pragma once
+#ifndef _ECM_FLOAT16_H_
+#define _ECM_FLOAT16_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+namespace ecm
+{
+	/**
+	 * This structure represents an IEEE 754 half-precision floating-point
+	 * number (1 sign bit, 5 exponent bits and 10 mantissa bits).
+	 *
+	 * It is a storage type: arithmetic is done after the implicit conversion
+	 * to float32, and the conversion back rounds to the nearest even value.
+	 * Values above the half-precision range become infinity and values below
+	 * it become subnormal numbers or zero.
+	 *
+	 * \note Like the built-in floating types, a default constructed float16
+	 *       is uninitialized.
+	 *
+	 * \since v1.0.0
+	 */
+	struct float16
+	{
+		// The raw bits of the half-precision number.
+		uint16 bits;
+
+		/**
+		 * Default constructor.
+		 *
+		 * \since v1.0.0
+		 */
+		float16() = default;
+
+		/**
+		 * Constructor converting a single-precision value to half-precision,
+		 * rounding to the nearest even value.
+		 *
+		 * \param value The value to convert.
+		 *
+		 * \since v1.0.0
+		 */
+		float16(float32 value) noexcept;
+
+		/**
+		 * Creates a half-precision number from its raw bits.
+		 *
+		 * \param bits The raw bits of the number.
+		 *
+		 * \returns The half-precision number.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr float16 ECM_CALL FromBits(uint16 bits) noexcept;
+
+		/**
+		 * Converts the half-precision number to single-precision. The
+		 * conversion is exact.
+		 *
+		 * \returns The value as float32.
+		 *
+		 * \since v1.0.0
+		 */
+		operator float32() const noexcept;
+	};
+
+	/**
+	 * Compares two half-precision numbers by their values, so that +0 equals
+	 * -0 and NaN is unequal to any value.
+	 *
+	 * \param h1 The left operand.
+	 * \param h2 The right operand.
+	 *
+	 * \returns true if both values are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD constexpr bool operator==(float16 h1, float16 h2) noexcept;
+
+	/**
+	 * Compares two half-precision numbers by their values.
+	 *
+	 * \param h1 The left operand.
+	 * \param h2 The right operand.
+	 *
+	 * \returns true if both values are unequal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD constexpr bool operator!=(float16 h1, float16 h2) noexcept;
+} // namespace ecm
+
+namespace ecm::math
+{
+	/**
+	 * Converts a single-precision value to the bits of a half-precision number
+	 * rounding to the nearest even value.
+	 *
+	 * \param value The value to convert.
+	 *
+	 * \returns The bits of the half-precision number.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint16 ECM_CALL Float32ToFloat16Bits(float32 value) noexcept;
+
+	/**
+	 * Converts the bits of a half-precision number to a single-precision
+	 * value. The conversion is exact.
+	 *
+	 * \param bits The bits of the half-precision number.
+	 *
+	 * \returns The single-precision value.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE float32 ECM_CALL Float16BitsToFloat32(uint16 bits) noexcept;
+
+	/**
+	 * Converts an array of single-precision values to half-precision, rounding
+	 * to the nearest even value.
+	 *
+	 * Uses F16C to convert eight values per instruction where available, and
+	 * an SSE2 bit manipulation converting four values at once otherwise. The
+	 * results are identical except for NaN payloads.
+	 *
+	 * \param in The values to convert.
+	 * \param out The array receiving the half-precision numbers.
+	 * \param count The number of values to convert.
+	 *
+	 * \note A buffer of ColorF or Vector4 can be converted by passing its
+	 *       first component and four times the element count.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ConvertF32ToF16(float32 const* in, float16* out, uint64 count);
+
+	/**
+	 * Converts an array of half-precision numbers to single-precision. The
+	 * conversion is exact.
+	 *
+	 * Uses F16C to convert eight values per instruction where available, and
+	 * an SSE2 bit manipulation converting four values at once otherwise.
+	 *
+	 * \param in The half-precision numbers to convert.
+	 * \param out The array receiving the single-precision values.
+	 * \param count The number of values to convert.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ConvertF16ToF32(float16 const* in, float32* out, uint64 count);
+} // namespace ecm::math
+
+#include "float16.inl"
+
+#endif // !_ECM_FLOAT16_H_
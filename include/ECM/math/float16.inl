@@ -0,0 +1,103 @@
+#pragma once
+
+#include <ECM/math/float16.h>
+
+#include <cstring>
+
+namespace ecm
+{
+	inline float16::float16(float32 value) noexcept
+		: bits(math::Float32ToFloat16Bits(value))
+	{}
+
+	constexpr float16 float16::FromBits(uint16 bits) noexcept
+	{
+		float16 result{};
+		result.bits = bits;
+		return result;
+	}
+
+	inline float16::operator float32() const noexcept
+	{
+		return math::Float16BitsToFloat32(this->bits);
+	}
+
+	constexpr bool operator==(float16 h1, float16 h2) noexcept
+	{
+		const bool isNaN1{ (h1.bits & 0x7fffu) > 0x7c00u };
+		const bool isNaN2{ (h2.bits & 0x7fffu) > 0x7c00u };
+		if (isNaN1 || isNaN2) {
+			return false;
+		}
+		// Positive and negative zero are equal
+		return h1.bits == h2.bits || ((h1.bits | h2.bits) & 0x7fffu) == 0;
+	}
+
+	constexpr bool operator!=(float16 h1, float16 h2) noexcept
+	{
+		return !(h1 == h2);
+	}
+} // namespace ecm
+
+namespace ecm::math
+{
+	uint16 Float32ToFloat16Bits(float32 value) noexcept
+	{
+		uint32 f{ 0 };
+		std::memcpy(&f, &value, sizeof(f));
+		const uint32 sign{ f & 0x80000000u };
+		f ^= sign;
+
+		uint32 result{ 0 };
+		if (f >= 0x47800000u) {
+			// Infinity for values >= 65536 and a quiet NaN for NaN
+			result = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+		}
+		else if (f < 0x38800000u) {
+			// The result is subnormal or zero: adding 0.5 aligns the mantissa,
+			// so that the floating-point addition does the rounding.
+			float32 aligned{ 0.f };
+			std::memcpy(&aligned, &f, sizeof(f));
+			aligned += 0.5f;
+			std::memcpy(&result, &aligned, sizeof(result));
+			result -= 0x3f000000u;
+		}
+		else {
+			// Rebias the exponent and round to the nearest even value. A
+			// carry into the exponent yields the correct result, even if it
+			// overflows to infinity.
+			const uint32 mantissaOdd{ (f >> 13) & 1u };
+			f += 0xc8000fffu + mantissaOdd;
+			result = f >> 13;
+		}
+		return static_cast<uint16>(result | (sign >> 16));
+	}
+
+	float32 Float16BitsToFloat32(uint16 bits) noexcept
+	{
+		constexpr uint32 shiftedExp{ 0x7c00u << 13 };
+		uint32 f{ (bits & 0x7fffu) << 13 };
+		const uint32 exp{ f & shiftedExp };
+		f += (127 - 15) << 23;
+		if (exp == shiftedExp) {
+			// Infinity or NaN
+			f += (128 - 16) << 23;
+		}
+		else if (exp == 0) {
+			// Zero or subnormal: renormalize with a floating-point subtraction
+			constexpr uint32 magic{ 113u << 23 };
+			float32 magicValue{ 0.f };
+			std::memcpy(&magicValue, &magic, sizeof(magic));
+			f += 1u << 23;
+			float32 value{ 0.f };
+			std::memcpy(&value, &f, sizeof(f));
+			value -= magicValue;
+			std::memcpy(&f, &value, sizeof(f));
+		}
+		f |= static_cast<uint32>(bits & 0x8000u) << 16;
+
+		float32 result{ 0.f };
+		std::memcpy(&result, &f, sizeof(result));
+		return result;
+	}
+} // namespace ecm::math
@@ -0,0 +1,201 @@
+/**
+ * \file frustum.h
+ *
+ * \brief This header defines the view frustum and the culling of bounding
+ * volumes against it.
+ *
+ * The planes of a frustum are extracted from a view-projection matrix with
+ * the method of Gribb and Hartmann, and are normalized, so that the distance
+ * of a point to a plane is its dot product with the plane.
+ *
+ * The batch functions test boxes and spheres in SoA layout against the six
+ * planes, eight objects at once with AVX2 and four with SSE2, and write the
+ * indices of the visible objects to a compact list. Large batches are split
+ * into ranges, which run on the threads of ParallelFor.
+ */
+
+#pragma once
+#ifndef _ECM_FRUSTUM_H_
+#define _ECM_FRUSTUM_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a view frustum template. The planes are in
+	 * the order left, right, bottom, top, near and far. The normal of each
+	 * plane is in x, y and z and points into the frustum, and w is the
+	 * distance of the plane to the origin.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct Frustum_Base
+	{
+		typedef T value_type;
+		typedef Frustum_Base<T> type;
+
+		// The six planes
+		Vector4_Base<T> planes[6];
+	};
+
+	/**
+	 * This structure references boxes in SoA layout, with one array per
+	 * component of their corners.
+	 *
+	 * \since v1.0.0
+	 */
+	struct AABBArrays
+	{
+		/* The x, y and z components of the minimum corners */
+		float32 const* min[3]{ nullptr, nullptr, nullptr };
+		/* The x, y and z components of the maximum corners */
+		float32 const* max[3]{ nullptr, nullptr, nullptr };
+	};
+
+	/**
+	 * This structure references spheres in SoA layout, with one array per
+	 * component of their centers.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SphereArrays
+	{
+		/* The x, y and z components of the centers */
+		float32 const* center[3]{ nullptr, nullptr, nullptr };
+		/* The radii */
+		float32 const* radius{ nullptr };
+	};
+
+	/**
+	 * This structure counts the culled objects. The batch functions add to
+	 * the counters, so that they can sum up the calls of a frame.
+	 *
+	 * \since v1.0.0
+	 */
+	struct CullStats
+	{
+		/* The number of tested objects */
+		uint64 tested{ 0 };
+		/* The number of visible objects */
+		uint64 visible{ 0 };
+	};
+
+	// Functions
+
+	/**
+	 * Extracts the frustum of a view-projection matrix, which transforms
+	 * column vectors.
+	 *
+	 * \param viewProjection The view-projection matrix.
+	 * \param zeroToOneDepth true if the matrix maps the depth to [0, 1], like
+	 *                       Direct3D and Vulkan, or false if it maps the
+	 *                       depth to [-1, 1], like OpenGL.
+	 *
+	 * \returns The frustum with normalized planes.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Frustum_Base<T> ECM_CALL FrustumFromMatrix(Matrix4x4_Base<T> const& viewProjection,
+		bool zeroToOneDepth = false) noexcept;
+
+	/**
+	 * Checks if a point is inside of a frustum.
+	 *
+	 * \param frustum The frustum.
+	 * \param point The point.
+	 *
+	 * \returns true if the point is on the inner side of all planes, or false
+	 *          if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Contains(Frustum_Base<T> const& frustum,
+		Vector3_Base<T> const& point) noexcept;
+
+	/**
+	 * Checks if a box may be visible. The test is conservative, and may
+	 * accept boxes near the corners of the frustum, which are outside.
+	 *
+	 * \param frustum The frustum.
+	 * \param box The box.
+	 *
+	 * \returns false if the box is completely outside of a plane, or true if
+	 *          not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(Frustum_Base<T> const& frustum,
+		AABB_Base<T> const& box) noexcept;
+
+	/**
+	 * Checks if a sphere may be visible. The test is conservative like the
+	 * one of boxes.
+	 *
+	 * \param frustum The frustum.
+	 * \param sphere The sphere.
+	 *
+	 * \returns false if the sphere is completely outside of a plane, or true
+	 *          if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(Frustum_Base<T> const& frustum,
+		Sphere_Base<T> const& sphere) noexcept;
+
+	/**
+	 * Culls boxes against a frustum, with the same test as Intersects.
+	 *
+	 * \param frustum The frustum.
+	 * \param boxes The boxes.
+	 * \param count The number of boxes.
+	 * \param visible Receives the indices of the visible boxes in ascending
+	 *                order. It must have room for count indices.
+	 * \param stats The counters, which receive the number of tested and
+	 *              visible boxes, or null.
+	 *
+	 * \returns The number of visible boxes.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API uint64 ECM_CALL CullAABBs(Frustum_Base<float32> const& frustum, AABBArrays const& boxes,
+		uint64 count, uint32* visible, CullStats* stats = nullptr) noexcept;
+
+	/**
+	 * Culls spheres against a frustum, with the same test as Intersects.
+	 *
+	 * \param frustum The frustum.
+	 * \param spheres The spheres.
+	 * \param count The number of spheres.
+	 * \param visible Receives the indices of the visible spheres in
+	 *                ascending order. It must have room for count indices.
+	 * \param stats The counters, which receive the number of tested and
+	 *              visible spheres, or null.
+	 *
+	 * \returns The number of visible spheres.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API uint64 ECM_CALL CullSpheres(Frustum_Base<float32> const& frustum, SphereArrays const& spheres,
+		uint64 count, uint32* visible, CullStats* stats = nullptr) noexcept;
+
+	/**
+	 * A view frustum with single-precision floating-point planes.
+	 *
+	 * \since v1.0.0
+	 */
+	using Frustum = Frustum_Base<float32>;
+} // namespace ecm::math
+
+#include "frustum.inl"
+
+#endif // !_ECM_FRUSTUM_H_
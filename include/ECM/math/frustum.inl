@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ECM/math/frustum.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		template<typename T>
+		constexpr T plane_distance(Vector4_Base<T> const& plane, T x, T y, T z)
+		{
+			return plane.x * x + plane.y * y + plane.z * z + plane.w;
+		}
+	} // namespace detail
+
+	// Functions
+
+	template<typename T>
+	Frustum_Base<T> FrustumFromMatrix(Matrix4x4_Base<T> const& viewProjection, bool zeroToOneDepth) noexcept
+	{
+		// The rows of the matrix give the clip coordinates of a point
+		Vector4_Base<T> rows[4];
+		for (uint8 r{ 0 }; r < 4; ++r) {
+			rows[r] = Vector4_Base<T>(viewProjection.matrix[0][r], viewProjection.matrix[1][r],
+				viewProjection.matrix[2][r], viewProjection.matrix[3][r]);
+		}
+		// -w <= x <= w, -w <= y <= w and -w <= z <= w, or 0 <= z <= w
+		Frustum_Base<T> frustum;
+		frustum.planes[0] = rows[3] + rows[0];
+		frustum.planes[1] = rows[3] - rows[0];
+		frustum.planes[2] = rows[3] + rows[1];
+		frustum.planes[3] = rows[3] - rows[1];
+		frustum.planes[4] = zeroToOneDepth ? rows[2] : rows[3] + rows[2];
+		frustum.planes[5] = rows[3] - rows[2];
+		for (Vector4_Base<T>& plane : frustum.planes) {
+			const T length{ static_cast<T>(std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z)) };
+			if (length > T(0))
+				plane = Vector4_Base<T>(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+		}
+		return frustum;
+	}
+
+	template<typename T>
+	constexpr bool Contains(Frustum_Base<T> const& frustum, Vector3_Base<T> const& point) noexcept
+	{
+		for (Vector4_Base<T> const& plane : frustum.planes) {
+			if (detail::plane_distance(plane, point.x, point.y, point.z) < T(0))
+				return false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(Frustum_Base<T> const& frustum, AABB_Base<T> const& box) noexcept
+	{
+		// The corner, which is the farthest along the normal, must not be
+		// behind the plane
+		for (Vector4_Base<T> const& plane : frustum.planes) {
+			const T x{ plane.x < T(0) ? box.min.x : box.max.x };
+			const T y{ plane.y < T(0) ? box.min.y : box.max.y };
+			const T z{ plane.z < T(0) ? box.min.z : box.max.z };
+			if (detail::plane_distance(plane, x, y, z) < T(0))
+				return false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(Frustum_Base<T> const& frustum, Sphere_Base<T> const& sphere) noexcept
+	{
+		for (Vector4_Base<T> const& plane : frustum.planes) {
+			if (detail::plane_distance(plane, sphere.center.x, sphere.center.y, sphere.center.z) < -sphere.radius)
+				return false;
+		}
+		return true;
+	}
+} // namespace ecm::math
@@ -53,6 +53,12 @@ namespace ecm::math
 	/**
 	 * Calculates the factorial of a non-negative integer.
 	 *
+	 * The factorials are read from tables generated at compile time. Integral
+	 * types are exact up to 20!, the largest factorial of 64 bits.
+	 * Floating-point types return the correctly rounded factorial and
+	 * infinity above 34! for float32 and 170! for float64. Fractional inputs
+	 * are truncated, inputs below 1 return 1.
+	 *
 	 * \param n The non-negative integer input.
 	 *
 	 * \tparam T The type of the input value (generally integral).
@@ -64,9 +70,38 @@ namespace ecm::math
 	template<typename T>
 	ECM_NODISCARD constexpr T ECM_CALL Fact(T n) noexcept;
 
+	/**
+	 * Calculates the binomial coefficient, the number of ways to choose \p k
+	 * of \p n elements.
+	 *
+	 * The coefficients up to n = 67, the largest row of 64 bits, are read
+	 * from a table generated at compile time. Larger ones are calculated by
+	 * the multiplicative formula.
+	 *
+	 * \param n The number of elements.
+	 * \param k The number of chosen elements.
+	 *
+	 * \tparam T The type of the input values.
+	 *
+	 * \returns The binomial coefficient, 0 if \p k is not in the range
+	 *          \[0, \p n\].
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr T ECM_CALL Binomial(T n, T k) noexcept;
+
 	/**
 	 * Raises a base to the power of an exponent.
 	 *
+	 * Integral exponents are calculated by exponentiation by squaring. A
+	 * float32 base is multiplied in float64, so the result is rounded once.
+	 * A float64 base uses exponentiation by squaring for exponents from -5
+	 * to 7, where its measured error is below 5 ulp, and std::pow outside.
+	 * Integral bases with negative exponents return 0, unless the base is 1
+	 * or -1, and wrap around like unsigned integers on overflow.
+	 * Floating-point exponents always use std::pow.
+	 *
 	 * \param base The base value.
 	 * \param exp The exponent value.
 	 *
@@ -80,6 +115,25 @@ namespace ecm::math
 	template<typename B, typename E>
 	ECM_NODISCARD constexpr B ECM_CALL Pow(B base, E exp) noexcept;
 
+	/**
+	 * Raises a base to the power of a constant exponent. The multiplications
+	 * of exponentiation by squaring are unrolled at compile time. Like Pow,
+	 * a float64 base uses std::pow for exponents below -5 or above 7, and
+	 * integral bases wrap around on overflow.
+	 *
+	 * \param base The base value.
+	 *
+	 * \tparam N The exponent, which must not be negative for integral
+	 *           bases.
+	 * \tparam T The type of the base value.
+	 *
+	 * \returns The value of \p base raised to the power \p N.
+	 *
+	 * \since v1.0.0
+	 */
+	template<int32 N, typename T>
+	ECM_NODISCARD constexpr T ECM_CALL Pow(T base) noexcept;
+
 	/**
 	 * Computes the remainder of division.
 	 *
@@ -286,6 +340,54 @@ namespace ecm::math
 	template<typename T>
 	ECM_NODISCARD constexpr T ECM_CALL Clamp(T v, T min, T max) noexcept;
 
+	/**
+	 * Smoothly interpolates between 0 and 1 as \p x moves from \p edge0 to
+	 * \p edge1.
+	 *
+	 * This function computes the Hermite polynomial of the clamped position:
+	 * \f[
+	 *   t = \text{Clamp}\left(\frac{x - edge0}{edge1 - edge0}, 0, 1\right), \quad
+	 *   \text{SmoothStep}(edge0, edge1, x) = t^2 \cdot (3 - 2t)
+	 * \f]
+	 *
+	 * \param edge0 The value of \p x, which gives 0.
+	 * \param edge1 The value of \p x, which gives 1.
+	 * \param x The input value.
+	 *
+	 * \tparam T The floating-point type of the values.
+	 *
+	 * \returns The smoothed value in the range \[0, 1\].
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr T ECM_CALL SmoothStep(T edge0, T edge1, T x) noexcept;
+
+	/**
+	 * Maps a value from the range \[\p inMin, \p inMax\] to the range
+	 * \[\p outMin, \p outMax\].
+	 *
+	 * The value is not clamped, so values outside the input range give
+	 * values outside the output range:
+	 * \f[
+	 *   \text{Remap}(v) = \text{Lerp}\left(outMin, outMax, \frac{v - inMin}{inMax - inMin}\right)
+	 * \f]
+	 *
+	 * \param v The input value.
+	 * \param inMin The start of the input range.
+	 * \param inMax The end of the input range.
+	 * \param outMin The start of the output range.
+	 * \param outMax The end of the output range.
+	 *
+	 * \tparam T The floating-point type of the values.
+	 *
+	 * \returns The mapped value.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr T ECM_CALL Remap(T v, T inMin, T inMax, T outMin, T outMax) noexcept;
+
 	// Trigonometry functions
 
 	/**
@@ -539,6 +641,84 @@ namespace ecm::math
 	 */
 	template<typename T>
 	ECM_NODISCARD constexpr T ECM_CALL Log1p(T x) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Raises an array of values to the power of an integral exponent. The
+	 * results equal the ones of Pow.
+	 *
+	 * \param in The base values.
+	 * \param out The array receiving the results.
+	 * \param count The number of values.
+	 * \param exp The exponent.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL PowBatch(float32 const* in, float32* out, uint64 count, int32 exp);
+
+	/**
+	 * Raises an array of values to the power of an integral exponent. The
+	 * results equal the ones of Pow.
+	 *
+	 * \param in The base values.
+	 * \param out The array receiving the results.
+	 * \param count The number of values.
+	 * \param exp The exponent.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL PowBatch(float64 const* in, float64* out, uint64 count, int32 exp);
+
+	/**
+	 * Calculates the factorials of an array of integers. The results equal
+	 * the ones of Fact.
+	 *
+	 * \param n The integers.
+	 * \param out The array receiving the factorials.
+	 * \param count The number of integers.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL FactBatch(uint32 const* n, float32* out, uint64 count);
+
+	/**
+	 * Calculates the factorials of an array of integers. The results equal
+	 * the ones of Fact.
+	 *
+	 * \param n The integers.
+	 * \param out The array receiving the factorials.
+	 * \param count The number of integers.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL FactBatch(uint32 const* n, float64* out, uint64 count);
+
+	/**
+	 * Calculates the binomial coefficients of arrays of integers. The results
+	 * equal the ones of Binomial.
+	 *
+	 * \param n The numbers of elements.
+	 * \param k The numbers of chosen elements.
+	 * \param out The array receiving the binomial coefficients.
+	 * \param count The number of coefficients.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL BinomialBatch(uint32 const* n, uint32 const* k, float32* out, uint64 count);
+
+	/**
+	 * Calculates the binomial coefficients of arrays of integers. The results
+	 * equal the ones of Binomial.
+	 *
+	 * \param n The numbers of elements.
+	 * \param k The numbers of chosen elements.
+	 * \param out The array receiving the binomial coefficients.
+	 * \param count The number of coefficients.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL BinomialBatch(uint32 const* n, uint32 const* k, float64* out, uint64 count);
 } // namespace ecm::math
 
 #include "functions.inl"
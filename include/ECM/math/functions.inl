@@ -4,9 +4,173 @@
 
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 namespace ecm::math
 {
+	namespace detail
+	{
+		template<typename T, uint32 N>
+		struct lookup_table
+		{
+			T values[N];
+		};
+
+		// The largest positive and negative exponents of a float64 base,
+		// which Pow calculates by exponentiation by squaring. The error grows
+		// with about 0.6 ulp per exponent step, and the reciprocal of a
+		// negative exponent adds another ulp.
+		inline constexpr uint64 pow_squaring_limit_f64{ 7 };
+		inline constexpr uint64 pow_squaring_limit_negative_f64{ 5 };
+		// The number of table entries: 20! is the largest factorial of 64
+		// bits, 34! and 170! are the largest finite float32 and float64 ones
+		inline constexpr uint32 factorial_count_u64{ 21 };
+		inline constexpr uint32 factorial_count_f32{ 35 };
+		inline constexpr uint32 factorial_count_f64{ 171 };
+		// The number of rows of Pascal's triangle, whose coefficients fit in
+		// 64 bits
+		inline constexpr uint32 binomial_rows{ 68 };
+		// 170! is below 2^1020
+		inline constexpr uint32 factorial_limbs{ 32 };
+
+		constexpr uint32 count_leading_zeros(uint32 x) noexcept
+		{
+			uint32 count{ 0 };
+			for (uint32 bit{ 0x80000000u }; bit != 0 && (x & bit) == 0; bit >>= 1)
+				++count;
+			return count;
+		}
+
+		// Rounds an integer of 32-bit limbs to the nearest floating-point
+		// value. The top 64 bits keep a sticky bit for all lower bits, so
+		// that their conversion rounds like the whole integer.
+		template<typename T>
+		constexpr T round_limbs(uint32 const* limbs, uint32 count) noexcept
+		{
+			const uint32 top{ count - 1 };
+			const uint32 shift{ count_leading_zeros(limbs[top]) };
+			const uint64 high{ (static_cast<uint64>(limbs[top]) << 32) | (top >= 1 ? limbs[top - 1] : 0u) };
+			const uint32 next{ top >= 2 ? limbs[top - 2] : 0u };
+			uint64 mantissa{ shift == 0 ? high : (high << shift) | (next >> (32 - shift)) };
+			bool sticky{ static_cast<uint32>(next << shift) != 0 };
+			for (uint32 i{ 0 }; i + 2 < top; ++i)
+				sticky = sticky || limbs[i] != 0;
+			mantissa |= sticky ? 1u : 0u;
+
+			// The powers of two are exact
+			T result{ static_cast<T>(mantissa) };
+			int32 exponent{ 32 * (static_cast<int32>(top) - 1) - static_cast<int32>(shift) };
+			for (; exponent >= 32; exponent -= 32)
+				result *= static_cast<T>(4294967296.0);
+			for (; exponent > 0; --exponent)
+				result *= static_cast<T>(2);
+			for (; exponent < 0; ++exponent)
+				result *= static_cast<T>(0.5);
+			return result;
+		}
+
+		// Multiplies the factorials exactly in 32-bit limbs and rounds each
+		// of them once
+		template<typename T, uint32 N>
+		constexpr lookup_table<T, N> make_factorial_table() noexcept
+		{
+			lookup_table<T, N> table{};
+			uint32 limbs[factorial_limbs]{ 1 };
+			uint32 count{ 1 };
+			table.values[0] = static_cast<T>(1);
+			for (uint32 n{ 1 }; n < N; ++n) {
+				uint64 carry{ 0 };
+				for (uint32 i{ 0 }; i < count; ++i) {
+					const uint64 product{ static_cast<uint64>(limbs[i]) * n + carry };
+					limbs[i] = static_cast<uint32>(product);
+					carry = product >> 32;
+				}
+				if (carry != 0)
+					limbs[count++] = static_cast<uint32>(carry);
+				table.values[n] = round_limbs<T>(limbs, count);
+			}
+			return table;
+		}
+
+		constexpr lookup_table<uint64, factorial_count_u64> make_factorial_table_u64() noexcept
+		{
+			lookup_table<uint64, factorial_count_u64> table{};
+			table.values[0] = 1;
+			for (uint32 n{ 1 }; n < factorial_count_u64; ++n)
+				table.values[n] = table.values[n - 1] * n;
+			return table;
+		}
+
+		constexpr uint32 binomial_index(uint32 n, uint32 k) noexcept
+		{
+			return n * (n + 1) / 2 + k;
+		}
+
+		// Pascal's triangle, row after row
+		constexpr lookup_table<uint64, binomial_rows * (binomial_rows + 1) / 2> make_binomial_table() noexcept
+		{
+			lookup_table<uint64, binomial_rows * (binomial_rows + 1) / 2> table{};
+			for (uint32 n{ 0 }; n < binomial_rows; ++n) {
+				table.values[binomial_index(n, 0)] = 1;
+				table.values[binomial_index(n, n)] = 1;
+				for (uint32 k{ 1 }; k < n; ++k)
+					table.values[binomial_index(n, k)] = table.values[binomial_index(n - 1, k - 1)] + table.values[binomial_index(n - 1, k)];
+			}
+			return table;
+		}
+
+		inline constexpr lookup_table<uint64, factorial_count_u64> factorials_u64{ make_factorial_table_u64() };
+		inline constexpr lookup_table<float32, factorial_count_f32> factorials_f32{ make_factorial_table<float32, factorial_count_f32>() };
+		inline constexpr lookup_table<float64, factorial_count_f64> factorials_f64{ make_factorial_table<float64, factorial_count_f64>() };
+		inline constexpr lookup_table<uint64, binomial_rows * (binomial_rows + 1) / 2> binomials{ make_binomial_table() };
+
+		template<typename T, uint32 N>
+		constexpr T lookup_factorial(lookup_table<T, N> const& table, T n) noexcept
+		{
+			if (!(n >= static_cast<T>(1)))
+				return static_cast<T>(1);
+			if (n >= static_cast<T>(N))
+				return std::numeric_limits<T>::infinity();
+			return table.values[static_cast<uint32>(n)];
+		}
+
+		template<typename T>
+		constexpr T pow_by_squaring(T base, uint64 exp) noexcept
+		{
+			T result{ static_cast<T>(1) };
+			while (exp != 0) {
+				if (exp & 1)
+					result *= base;
+				exp >>= 1;
+				if (exp != 0)
+					base *= base;
+			}
+			return result;
+		}
+
+		// The type, in which the powers of an integral base are calculated.
+		// Types below 32 bits would be promoted to int, whose multiplications
+		// overflow instead of wrapping.
+		template<typename T>
+		using pow_unsigned_t = std::conditional_t<(sizeof(T) <= sizeof(uint32)), uint32, uint64>;
+
+		template<uint64 N, typename T>
+		constexpr T pow_unrolled(T base) noexcept
+		{
+			if constexpr (N == 0) {
+				return static_cast<T>(1);
+			} else if constexpr (N == 1) {
+				return base;
+			} else {
+				const T half{ pow_unrolled<N / 2>(base) };
+				if constexpr (N % 2 == 0)
+					return static_cast<T>(half * half);
+				else
+					return static_cast<T>(half * half * base);
+			}
+		}
+	} // namespace detail
+
 	// Basic functions
 
 	template<typename T>
@@ -24,17 +188,96 @@ namespace ecm::math
 	template<typename T>
 	constexpr T Fact(T n) noexcept
 	{
-		T res{ static_cast<T>(1) };
-		for (T i{ static_cast<T>(1) }; i <= n; ++i) {
-			res *= i;
+		if constexpr (std::is_same_v<T, float32>) {
+			return detail::lookup_factorial(detail::factorials_f32, n);
+		} else if constexpr (std::is_same_v<T, float64>) {
+			return detail::lookup_factorial(detail::factorials_f64, n);
+		} else {
+			if constexpr (std::is_integral_v<T>) {
+				if (n <= static_cast<T>(1))
+					return static_cast<T>(1);
+				ECM_ASSERT(static_cast<uint64>(n) < detail::factorial_count_u64);
+				if (static_cast<uint64>(n) < detail::factorial_count_u64)
+					return static_cast<T>(detail::factorials_u64.values[n]);
+			}
+			T res{ static_cast<T>(1) };
+			for (T i{ static_cast<T>(1) }; i <= n; ++i) {
+				res *= i;
+			}
+			return res;
 		}
-		return res;
+	}
+
+	template<typename T>
+	constexpr T Binomial(T n, T k) noexcept
+	{
+		if constexpr (std::is_signed_v<T>) {
+			if (k < static_cast<T>(0))
+				return static_cast<T>(0);
+		}
+		if (k > n)
+			return static_cast<T>(0);
+		if (n < static_cast<T>(detail::binomial_rows))
+			return static_cast<T>(detail::binomials.values[detail::binomial_index(static_cast<uint32>(n), static_cast<uint32>(k))]);
+		if (k > n - k)
+			k = n - k;
+		T result{ static_cast<T>(1) };
+		for (T i{ static_cast<T>(1) }; i <= k; ++i)
+			result = result * (n - k + i) / i;
+		return result;
 	}
 
 	template<typename B, typename E>
 	constexpr B Pow(B base, E exp) noexcept
 	{
-		return static_cast<B>(std::pow(base, exp));
+		if constexpr (std::is_integral_v<E>) {
+			bool negative{ false };
+			if constexpr (std::is_signed_v<E>)
+				negative = exp < 0;
+			const uint64 magnitude{ negative ? 0 - static_cast<uint64>(exp) : static_cast<uint64>(exp) };
+			if constexpr (std::is_same_v<B, float32>) {
+				const float64 result{ detail::pow_by_squaring(static_cast<float64>(base), magnitude) };
+				return static_cast<float32>(negative ? 1.0 / result : result);
+			} else if constexpr (std::is_floating_point_v<B>) {
+				if (magnitude > (negative ? detail::pow_squaring_limit_negative_f64 : detail::pow_squaring_limit_f64))
+					return static_cast<B>(std::pow(base, exp));
+				const B result{ detail::pow_by_squaring(base, magnitude) };
+				return negative ? static_cast<B>(1) / result : result;
+			} else {
+				if (negative) {
+					ECM_ASSERT(base != 0);
+					if constexpr (std::is_signed_v<B>) {
+						if (base == -1)
+							return static_cast<B>((magnitude & 1) ? -1 : 1);
+					}
+					return static_cast<B>(base == 1 ? 1 : 0);
+				}
+				// Unsigned multiplications of at least 32 bits wrap instead of
+				// overflowing
+				return static_cast<B>(detail::pow_by_squaring(static_cast<detail::pow_unsigned_t<B>>(base), magnitude));
+			}
+		} else {
+			return static_cast<B>(std::pow(base, exp));
+		}
+	}
+
+	template<int32 N, typename T>
+	constexpr T Pow(T base) noexcept
+	{
+		static_assert(N >= 0 || std::is_floating_point_v<T>, "Integral bases require a non-negative exponent.");
+		constexpr uint64 magnitude{ N < 0 ? 0 - static_cast<uint64>(N) : static_cast<uint64>(N) };
+		if constexpr (std::is_same_v<T, float32>) {
+			const float64 result{ detail::pow_unrolled<magnitude>(static_cast<float64>(base)) };
+			return static_cast<float32>(N < 0 ? 1.0 / result : result);
+		} else if constexpr (std::is_integral_v<T>) {
+			return static_cast<T>(detail::pow_unrolled<magnitude>(static_cast<detail::pow_unsigned_t<T>>(base)));
+		} else if constexpr (magnitude > (N < 0 ? detail::pow_squaring_limit_negative_f64 : detail::pow_squaring_limit_f64)) {
+			return static_cast<T>(std::pow(base, N));
+		} else if constexpr (N < 0) {
+			return static_cast<T>(1) / detail::pow_unrolled<magnitude>(base);
+		} else {
+			return detail::pow_unrolled<magnitude>(base);
+		}
 	}
 
 	template<typename T, typename U>
@@ -156,6 +399,19 @@ namespace ecm::math
 		return (v < min) ? min : (v > max) ? max : v;
 	}
 
+	template<typename T>
+	constexpr T SmoothStep(T edge0, T edge1, T x) noexcept
+	{
+		const T t{ Clamp((x - edge0) / (edge1 - edge0), T(0), T(1)) };
+		return t * t * (T(3) - T(2) * t);
+	}
+
+	template<typename T>
+	constexpr T Remap(T v, T inMin, T inMax, T outMin, T outMax) noexcept
+	{
+		return Lerp(outMin, outMax, (v - inMin) / (inMax - inMin));
+	}
+
 	// Trigonometry functions
 
 	template<typename T>
@@ -13,6 +13,39 @@
 
 #include <immintrin.h>
 
+// SIMD instruction sets, which are enabled at compile time
+#if defined(__AVX2__)
+#	define ECM_SIMD_AVX2 1
+#else
+#	define ECM_SIMD_AVX2 0
+#endif // __AVX2__
+#if defined(__SSE4_1__) || defined(__AVX__) || ECM_SIMD_AVX2
+#	define ECM_SIMD_SSE41 1
+#else
+#	define ECM_SIMD_SSE41 0
+#endif // __SSE4_1__
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || ECM_SIMD_SSE41
+#	define ECM_SIMD_SSE2 1
+#else
+#	define ECM_SIMD_SSE2 0
+#endif // __SSE2__
+// MSVC does not define macros for these extensions, but implies them with AVX2
+#if defined(__FMA__) || (defined(_MSC_VER) && ECM_SIMD_AVX2)
+#	define ECM_SIMD_FMA 1
+#else
+#	define ECM_SIMD_FMA 0
+#endif // __FMA__
+#if defined(__F16C__) || (defined(_MSC_VER) && ECM_SIMD_AVX2)
+#	define ECM_SIMD_F16C 1
+#else
+#	define ECM_SIMD_F16C 0
+#endif // __F16C__
+#if defined(__BMI2__) || (defined(_MSC_VER) && ECM_SIMD_AVX2)
+#	define ECM_SIMD_BMI2 1
+#else
+#	define ECM_SIMD_BMI2 0
+#endif // __BMI2__
+
 namespace ecm::math
 {
 	/**
@@ -85,6 +118,207 @@ namespace ecm::math
 	 * \since v1.0.0
 	 */
 	ECM_NODISCARD ECM_INLINE __m128 ECM_CALL SplatW(__m128 v);
+
+	// Integer functions
+
+	/**
+	 * Broadcasts the x-component (the first element) of the given 128-bit
+	 * integer vector to all four elements of a resulting 128-bit vector.
+	 *
+	 * \param v The input 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with all elements set to the
+	 *          x-component of \p v.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SplatX(__m128i v);
+
+	/**
+	 * Broadcasts the y-component (the second element) of the given 128-bit
+	 * integer vector to all four elements of a resulting 128-bit vector.
+	 *
+	 * \param v The input 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with all elements set to the
+	 *          y-component of \p v.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SplatY(__m128i v);
+
+	/**
+	 * Broadcasts the z-component (the third element) of the given 128-bit
+	 * integer vector to all four elements of a resulting 128-bit vector.
+	 *
+	 * \param v The input 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with all elements set to the
+	 *          z-component of \p v.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SplatZ(__m128i v);
+
+	/**
+	 * Broadcasts the w-component (the fourth element) of the given 128-bit
+	 * integer vector to all four elements of a resulting 128-bit vector.
+	 *
+	 * \param v The input 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with all elements set to the
+	 *          w-component of \p v.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SplatW(__m128i v);
+
+	/**
+	 * Multiplies the four 32-bit integers of two 128-bit vectors and keeps the
+	 * low 32 bits of each product. The result is the same for signed and
+	 * unsigned integers.
+	 *
+	 * Uses `pmulld` with SSE4.1 and two `pmuludq` otherwise.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector containing the low 32 bits of
+	 *          \p a * \p b.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL MulLo(__m128i a, __m128i b);
+
+	/**
+	 * Computes the element-wise minimum of four signed 32-bit integers.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with the smaller elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL MinI32(__m128i a, __m128i b);
+
+	/**
+	 * Computes the element-wise maximum of four signed 32-bit integers.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with the greater elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL MaxI32(__m128i a, __m128i b);
+
+	/**
+	 * Computes the element-wise minimum of four unsigned 32-bit integers.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with the smaller elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL MinU32(__m128i a, __m128i b);
+
+	/**
+	 * Computes the element-wise maximum of four unsigned 32-bit integers.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector with the greater elements.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL MaxU32(__m128i a, __m128i b);
+
+	/**
+	 * Compares four unsigned 32-bit integers for \p a < \p b.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit mask with all bits of an element set, if the
+	 *          comparison is true.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL CmpLtU32(__m128i a, __m128i b);
+
+	/**
+	 * Compares four unsigned 32-bit integers for \p a > \p b.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit mask with all bits of an element set, if the
+	 *          comparison is true.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL CmpGtU32(__m128i a, __m128i b);
+
+	/**
+	 * Adds four signed 32-bit integers and saturates the results to
+	 * [INT32_MIN, INT32_MAX] instead of wrapping around.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector containing the saturated sums.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL AddSatI32(__m128i a, __m128i b);
+
+	/**
+	 * Subtracts four signed 32-bit integers and saturates the results to
+	 * [INT32_MIN, INT32_MAX] instead of wrapping around.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector containing the saturated
+	 *          differences.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SubSatI32(__m128i a, __m128i b);
+
+	/**
+	 * Adds four unsigned 32-bit integers and saturates the results to
+	 * UINT32_MAX instead of wrapping around.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector containing the saturated sums.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL AddSatU32(__m128i a, __m128i b);
+
+	/**
+	 * Subtracts four unsigned 32-bit integers and saturates the results to
+	 * zero instead of wrapping around.
+	 *
+	 * \param a The first 128-bit integer vector.
+	 * \param b The second 128-bit integer vector.
+	 *
+	 * \returns A 128-bit integer vector containing the saturated
+	 *          differences.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE __m128i ECM_CALL SubSatU32(__m128i a, __m128i b);
 } // namespace ecm::math
 
+#include "functions_simd.inl"
+
 #endif // !_ECM_FUNCTIONS_SIMD_H_
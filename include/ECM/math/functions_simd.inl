@@ -0,0 +1,131 @@
+#pragma once
+
+#include <ECM/math/functions_simd.h>
+
+namespace ecm::math
+{
+	// Integer functions
+
+	__m128i SplatX(__m128i v)
+	{
+		return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 0, 0, 0));
+	}
+
+	__m128i SplatY(__m128i v)
+	{
+		return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 1, 1));
+	}
+
+	__m128i SplatZ(__m128i v)
+	{
+		return _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 2, 2, 2));
+	}
+
+	__m128i SplatW(__m128i v)
+	{
+		return _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	__m128i MulLo(__m128i a, __m128i b)
+	{
+#if ECM_SIMD_SSE41
+		return _mm_mullo_epi32(a, b);
+#else
+		// Multiply the even and the odd elements separately and interleave
+		// the low halves of the 64-bit products.
+		const __m128i even{ _mm_mul_epu32(a, b) };
+		const __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)) };
+		return _mm_unpacklo_epi32(
+			_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+			_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif // ECM_SIMD_SSE41
+	}
+
+	__m128i MinI32(__m128i a, __m128i b)
+	{
+#if ECM_SIMD_SSE41
+		return _mm_min_epi32(a, b);
+#else
+		const __m128i mask{ _mm_cmplt_epi32(a, b) };
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif // ECM_SIMD_SSE41
+	}
+
+	__m128i MaxI32(__m128i a, __m128i b)
+	{
+#if ECM_SIMD_SSE41
+		return _mm_max_epi32(a, b);
+#else
+		const __m128i mask{ _mm_cmpgt_epi32(a, b) };
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif // ECM_SIMD_SSE41
+	}
+
+	__m128i MinU32(__m128i a, __m128i b)
+	{
+#if ECM_SIMD_SSE41
+		return _mm_min_epu32(a, b);
+#else
+		const __m128i mask{ CmpLtU32(a, b) };
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif // ECM_SIMD_SSE41
+	}
+
+	__m128i MaxU32(__m128i a, __m128i b)
+	{
+#if ECM_SIMD_SSE41
+		return _mm_max_epu32(a, b);
+#else
+		const __m128i mask{ CmpGtU32(a, b) };
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+#endif // ECM_SIMD_SSE41
+	}
+
+	__m128i CmpLtU32(__m128i a, __m128i b)
+	{
+		// Flipping the sign bit maps the unsigned order onto the signed one.
+		const __m128i bias{ _mm_set1_epi32(static_cast<int32>(0x80000000u)) };
+		return _mm_cmplt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+	}
+
+	__m128i CmpGtU32(__m128i a, __m128i b)
+	{
+		const __m128i bias{ _mm_set1_epi32(static_cast<int32>(0x80000000u)) };
+		return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+	}
+
+	__m128i AddSatI32(__m128i a, __m128i b)
+	{
+		const __m128i sum{ _mm_add_epi32(a, b) };
+		// Overflow occurred, if both operands have the same sign and the sign
+		// of the sum differs from it.
+		const __m128i overflow{ _mm_srai_epi32(
+			_mm_and_si128(_mm_xor_si128(a, sum), _mm_xor_si128(b, sum)), 31) };
+		// INT32_MAX for positive and INT32_MIN for negative operands
+		const __m128i limit{ _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff)) };
+		return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, sum));
+	}
+
+	__m128i SubSatI32(__m128i a, __m128i b)
+	{
+		const __m128i diff{ _mm_sub_epi32(a, b) };
+		// Overflow occurred, if the operands have different signs and the
+		// sign of the difference differs from the minuend.
+		const __m128i overflow{ _mm_srai_epi32(
+			_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, diff)), 31) };
+		const __m128i limit{ _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7fffffff)) };
+		return _mm_or_si128(_mm_and_si128(overflow, limit), _mm_andnot_si128(overflow, diff));
+	}
+
+	__m128i AddSatU32(__m128i a, __m128i b)
+	{
+		// A carry occurred, if the sum is smaller than one of the operands.
+		const __m128i sum{ _mm_add_epi32(a, b) };
+		return _mm_or_si128(sum, CmpLtU32(sum, a));
+	}
+
+	__m128i SubSatU32(__m128i a, __m128i b)
+	{
+		return _mm_sub_epi32(a, MinU32(a, b));
+	}
+} // namespace ecm::math
@@ -0,0 +1,406 @@
+/**
+ * \file loose_tree.h
+ *
+ * \brief This header defines loose octrees and quadtrees, which index boxes
+ * for broad-phase queries in mostly static worlds.
+ *
+ * The cells of a loose tree overlap their neighbours by half their size
+ * (Ulrich, "Loose Octrees"). An item is stored in the node of the cell,
+ * which contains its center, at the depth, whose cells are at least as large
+ * as the item. So the node of an item follows from its box alone, and moving
+ * an item either updates it in place, or relinks it below the lowest common
+ * ancestor of its old and new node. Only the nodes on the paths of items
+ * exist, so sparse worlds take little memory.
+ *
+ * The nodes and items are kept in pools, whose slots are reused. The queries
+ * write the found items into buffers of the caller and don't allocate.
+ */
+
+#pragma once
+#ifndef _ECM_LOOSE_TREE_H_
+#define _ECM_LOOSE_TREE_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/frustum.h>
+#include <ECM/math/ray.h>
+#include <ECM/math/vector.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// The nodes and items of a loose tree with D dimensions, which the
+		// octree and the quadtree share
+		template<uint32 D>
+		class loose_tree
+		{
+		public:
+			static constexpr uint32 child_count{ 1u << D };
+			static constexpr uint32 max_depth{ 20 };
+			static constexpr uint32 invalid{ 0xffffffffu };
+
+			struct node
+			{
+				uint32 children[child_count];
+				uint32 parent;
+				// The first item of the list of the items of the node
+				uint32 first;
+				// The coordinates of the cell in the cells of its depth
+				uint32 cell[D];
+				uint32 depth;
+			};
+
+			struct item
+			{
+				float32 min[D];
+				float32 max[D];
+				uint32 node;
+				// The neighbours in the list of the node, or the next free item
+				uint32 next;
+				uint32 previous;
+			};
+
+			void reset(float32 const* min, float32 const* max, uint32 depth);
+			uint32 insert(float32 const* min, float32 const* max);
+			void remove(uint32 handle) noexcept;
+			void move(uint32 handle, float32 const* min, float32 const* max);
+
+			template<typename NodeTest, typename ItemTest>
+			uint32 query(NodeTest const& nodeTest, ItemTest const& itemTest, uint32* out, uint32 capacity) const noexcept;
+
+			std::vector<node> nodes;
+			std::vector<item> items;
+			uint32 freeNode{ invalid };
+			uint32 freeItem{ invalid };
+			uint32 count{ 0 };
+			uint32 nodeCount{ 0 };
+			uint32 depthCount{ 1 };
+			float32 origin[D]{};
+			// The size of the cells of each depth
+			float32 cellSize[max_depth + 1]{};
+		private:
+			void place(float32 const* min, float32 const* max, uint32& depth, uint32* cell) const noexcept;
+			uint32 find_or_create(uint32 start, uint32 depth, uint32 const* cell);
+			void link(uint32 handle, uint32 node) noexcept;
+			void unlink(uint32 handle) noexcept;
+			void prune(uint32 node) noexcept;
+		};
+	} // namespace detail
+
+	/**
+	 * This class represents a loose octree over the boxes of 3D items.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API LooseOctree
+	{
+	public:
+		/**
+		 * Constructor creating an empty octree.
+		 *
+		 * \param world The box of the world, which the root cell covers as a
+		 *              cube. Items outside of it are kept in the root.
+		 * \param maxDepth The depth of the smallest cells, at most 20.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit LooseOctree(AABB_Base<float32> const& world = AABB_Base<float32>(
+			Vector3_Base<float32>(-1.f, -1.f, -1.f), Vector3_Base<float32>(1.f, 1.f, 1.f)), uint32 maxDepth = 8);
+
+		/**
+		 * Removes all items.
+		 *
+		 * \since v1.0.0
+		 */
+		void Clear();
+
+		/**
+		 * Inserts an item.
+		 *
+		 * \param bounds The box of the item.
+		 *
+		 * \returns The handle of the item. The handles of removed items are
+		 *          reused.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 Insert(AABB_Base<float32> const& bounds);
+
+		/**
+		 * Removes an item.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		void Remove(uint32 item) noexcept;
+
+		/**
+		 * Moves an item. Items, which stay in the cell of their node, are
+		 * updated in place.
+		 *
+		 * \param item The handle of the item.
+		 * \param bounds The new box of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		void Move(uint32 item, AABB_Base<float32> const& bounds);
+
+		/**
+		 * Finds the items, whose boxes intersect a box.
+		 *
+		 * \param box The box.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity. Only the first items fill the buffer then.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryAABB(AABB_Base<float32> const& box, uint32* items, uint32 capacity) const noexcept;
+
+		/**
+		 * Finds the items, whose boxes intersect a sphere.
+		 *
+		 * \param sphere The sphere.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QuerySphere(Sphere_Base<float32> const& sphere, uint32* items, uint32 capacity) const noexcept;
+
+		/**
+		 * Finds the items, whose boxes intersect a frustum.
+		 *
+		 * \param frustum The frustum.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryFrustum(Frustum_Base<float32> const& frustum, uint32* items, uint32 capacity) const noexcept;
+
+		/**
+		 * Finds the items, whose boxes a ray hits, in no particular order.
+		 *
+		 * \param ray The ray.
+		 * \param maxDistance The maximum distance of the ray.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryRay(Ray_Base<float32> const& ray, float32 maxDistance, uint32* items,
+			uint32 capacity) const noexcept;
+
+		/**
+		 * Returns the box of an item.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \returns The box.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD AABB_Base<float32> ECM_CALL GetBounds(uint32 item) const noexcept;
+
+		/**
+		 * Returns the number of items.
+		 *
+		 * \returns The number of items.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetCount() const noexcept;
+
+		/**
+		 * Returns the number of nodes.
+		 *
+		 * \returns The number of nodes, which have items or children.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetNodeCount() const noexcept;
+	private:
+		AABB_Base<float32> _world;
+		uint32 _maxDepth;
+		detail::loose_tree<3> _tree;
+	};
+
+	/**
+	 * This class represents a loose quadtree over the rectangles of 2D items.
+	 * The rectangles are given by their corners with the smallest and the
+	 * largest coordinates.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API LooseQuadtree
+	{
+	public:
+		/**
+		 * Constructor creating an empty quadtree.
+		 *
+		 * \param min The corner of the world with the smallest coordinates.
+		 * \param max The corner of the world with the largest coordinates.
+		 *            The root cell covers the world as a square. Items
+		 *            outside of it are kept in the root.
+		 * \param maxDepth The depth of the smallest cells, at most 20.
+		 *
+		 * \since v1.0.0
+		 */
+		LooseQuadtree(PointF const& min = PointF(-1.f, -1.f), PointF const& max = PointF(1.f, 1.f),
+			uint32 maxDepth = 8);
+
+		/**
+		 * Removes all items.
+		 *
+		 * \since v1.0.0
+		 */
+		void Clear();
+
+		/**
+		 * Inserts an item.
+		 *
+		 * \param min The corner of the item with the smallest coordinates.
+		 * \param max The corner of the item with the largest coordinates.
+		 *
+		 * \returns The handle of the item. The handles of removed items are
+		 *          reused.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 Insert(PointF const& min, PointF const& max);
+
+		/**
+		 * Removes an item.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		void Remove(uint32 item) noexcept;
+
+		/**
+		 * Moves an item. Items, which stay in the cell of their node, are
+		 * updated in place.
+		 *
+		 * \param item The handle of the item.
+		 * \param min The new corner with the smallest coordinates.
+		 * \param max The new corner with the largest coordinates.
+		 *
+		 * \since v1.0.0
+		 */
+		void Move(uint32 item, PointF const& min, PointF const& max);
+
+		/**
+		 * Finds the items, whose rectangles intersect a rectangle.
+		 *
+		 * \param min The corner with the smallest coordinates.
+		 * \param max The corner with the largest coordinates.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity. Only the first items fill the buffer then.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryRect(PointF const& min, PointF const& max, uint32* items, uint32 capacity) const noexcept;
+
+		/**
+		 * Finds the items, whose rectangles intersect a circle.
+		 *
+		 * \param center The center of the circle.
+		 * \param radius The radius of the circle.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryCircle(PointF const& center, float32 radius, uint32* items, uint32 capacity) const noexcept;
+
+		/**
+		 * Finds the items, whose rectangles a ray hits, in no particular
+		 * order.
+		 *
+		 * \param origin The origin of the ray.
+		 * \param direction The direction of the ray.
+		 * \param maxDistance The maximum distance of the ray, in lengths of
+		 *                    its direction.
+		 * \param items Receives the handles of the items.
+		 * \param capacity The length of the buffer.
+		 *
+		 * \returns The number of items found, which can be larger than the
+		 *          capacity.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryRay(PointF const& origin, PointF const& direction, float32 maxDistance, uint32* items,
+			uint32 capacity) const noexcept;
+
+		/**
+		 * Returns the corner of an item with the smallest coordinates.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \returns The corner.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD PointF ECM_CALL GetMin(uint32 item) const noexcept;
+
+		/**
+		 * Returns the corner of an item with the largest coordinates.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \returns The corner.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD PointF ECM_CALL GetMax(uint32 item) const noexcept;
+
+		/**
+		 * Returns the number of items.
+		 *
+		 * \returns The number of items.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetCount() const noexcept;
+
+		/**
+		 * Returns the number of nodes.
+		 *
+		 * \returns The number of nodes, which have items or children.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetNodeCount() const noexcept;
+	private:
+		PointF _min;
+		PointF _max;
+		uint32 _maxDepth;
+		detail::loose_tree<2> _tree;
+	};
+} // namespace ecm::math
+
+#endif // !_ECM_LOOSE_TREE_H_
@@ -8,6 +8,7 @@
 #ifndef _ECM_MATRIX_H_
 #define _ECM_MATRIX_H_
 
+#include <ECM/math/fixed.h>
 #include <ECM/math/matrix4x4.h>
 
 namespace ecm::math
@@ -77,6 +78,18 @@ namespace ecm::math
 	 * \since v1.0.0
 	 */
 	using Matrix4x4uA = ECM_ALIGN(16) Matrix4x4u;
+
+	/**
+	 * A 4x4 matrix of Q16.16 fixed-point numbers.
+	 *
+	 * This type alias is used for deterministic transformations, which give
+	 * the same results on every compiler and CPU.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa Fixed
+	 */
+	using Matrix4x4x = Matrix4x4_Base<Fixed16_16>;
 } // namespace ecm::math
 
 #endif // !_ECM_MATRIX_H_
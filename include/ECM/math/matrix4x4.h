@@ -10,6 +10,7 @@
 
 #include <ECM/ECM_api.h>
 #include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
 #include <ECM/math/vector3.h>
 #include <ECM/math/vector4.h>
 
@@ -217,7 +218,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator=(Matrix4x4_Base<U> const& m);
 
 		/**
@@ -231,7 +232,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator+=(U scalar);
 
 		/**
@@ -245,7 +246,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator+=(Matrix4x4_Base<U> const& m);
 
 		/**
@@ -259,7 +260,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator-=(U scalar);
 
 		/**
@@ -273,7 +274,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator-=(Matrix4x4_Base<U> const& m);
 
 		/**
@@ -287,7 +288,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator*=(U scalar);
 
 		/**
@@ -301,7 +302,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator*=(Matrix4x4_Base<U> const& m);
 
 		/**
@@ -315,7 +316,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator/=(U scalar);
 
 		/**
@@ -329,7 +330,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Matrix4x4_Base<T>& operator/=(Matrix4x4_Base<U> const& m);
 
 		// Increment and decrement operators
@@ -447,7 +448,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator+(Matrix4x4_Base<T> const& m, U scalar);
 
 	/**
@@ -462,7 +463,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator+(U scalar, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -477,7 +478,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator+(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<U> const& m2);
 
 	/**
@@ -492,7 +493,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator-(Matrix4x4_Base<T> const& m, U scalar);
 
 	/**
@@ -507,7 +508,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator-(U scalar, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -522,7 +523,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator-(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<U> const& m2);
 
 	/**
@@ -537,7 +538,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator*(Matrix4x4_Base<T> const& m, U scalar);
 
 	/**
@@ -552,7 +553,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator*(U scalar, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -568,7 +569,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr typename Matrix4x4_Base<T>::column_type operator*(Matrix4x4_Base<T> const& m, typename Matrix4x4_Base<U>::row_type const& v);
 
 	/**
@@ -585,7 +586,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr typename Matrix4x4_Base<T>::row_type operator*(typename Matrix4x4_Base<U>::column_type const& v, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -601,7 +602,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator*(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<U> const& m2);
 
 	/**
@@ -616,7 +617,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator/(Matrix4x4_Base<T> const& m, U scalar);
 
 	/**
@@ -631,7 +632,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator/(U scalar, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -651,7 +652,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr typename Matrix4x4_Base<T>::column_type operator/(Matrix4x4_Base<T> const& m, typename Matrix4x4_Base<U>::row_type const& v);
 
 	/**
@@ -670,7 +671,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr typename Matrix4x4_Base<T>::row_type operator/(typename Matrix4x4_Base<U>::column_type const& v, Matrix4x4_Base<T> const& m);
 
 	/**
@@ -685,7 +686,7 @@ namespace ecm::math
 	 *
 	 * \since v1.0.0
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Matrix4x4_Base<T> operator/(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<U> const& m2);
 
 
@@ -4,6 +4,7 @@
 #include <ECM/math/functions.h>
 #include <ECM/math/functions_simd.h>
 
+#include <cstring>
 #include <limits>
 
 namespace ecm::math
@@ -82,25 +83,25 @@ namespace ecm::math
 			column_type(x3, y3, z3, w3),
 			column_type(x4, y4, z4, w4) }
 	{
-		static_assert(std::numeric_limits<X1>::is_iec559 || std::numeric_limits<X1>::is_integer, "Matrix4x4 constructor only takes float and integer types, 1st paramter type is invalid.");
-		static_assert(std::numeric_limits<Y1>::is_iec559 || std::numeric_limits<Y1>::is_integer, "Matrix4x4 constructor only takes float and integer types, 2nd paramter type is invalid.");
-		static_assert(std::numeric_limits<Z1>::is_iec559 || std::numeric_limits<Z1>::is_integer, "Matrix4x4 constructor only takes float and integer types, 3rd paramter type is invalid.");
-		static_assert(std::numeric_limits<W1>::is_iec559 || std::numeric_limits<W1>::is_integer, "Matrix4x4 constructor only takes float and integer types, 4th paramter type is invalid.");
+		static_assert(is_arithmetic_v<X1>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 1st paramter type is invalid.");
+		static_assert(is_arithmetic_v<Y1>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 2nd paramter type is invalid.");
+		static_assert(is_arithmetic_v<Z1>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 3rd paramter type is invalid.");
+		static_assert(is_arithmetic_v<W1>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 4th paramter type is invalid.");
 
-		static_assert(std::numeric_limits<X2>::is_iec559 || std::numeric_limits<X2>::is_integer, "Matrix4x4 constructor only takes float and integer types, 5th paramter type is invalid.");
-		static_assert(std::numeric_limits<Y2>::is_iec559 || std::numeric_limits<Y2>::is_integer, "Matrix4x4 constructor only takes float and integer types, 6th paramter type is invalid.");
-		static_assert(std::numeric_limits<Z2>::is_iec559 || std::numeric_limits<Z2>::is_integer, "Matrix4x4 constructor only takes float and integer types, 7th paramter type is invalid.");
-		static_assert(std::numeric_limits<W2>::is_iec559 || std::numeric_limits<W2>::is_integer, "Matrix4x4 constructor only takes float and integer types, 8th paramter type is invalid.");
+		static_assert(is_arithmetic_v<X2>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 5th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Y2>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 6th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Z2>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 7th paramter type is invalid.");
+		static_assert(is_arithmetic_v<W2>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 8th paramter type is invalid.");
 
-		static_assert(std::numeric_limits<X3>::is_iec559 || std::numeric_limits<X3>::is_integer, "Matrix4x4 constructor only takes float and integer types, 9th paramter type is invalid.");
-		static_assert(std::numeric_limits<Y3>::is_iec559 || std::numeric_limits<Y3>::is_integer, "Matrix4x4 constructor only takes float and integer types, 10th paramter type is invalid.");
-		static_assert(std::numeric_limits<Z3>::is_iec559 || std::numeric_limits<Z3>::is_integer, "Matrix4x4 constructor only takes float and integer types, 11th paramter type is invalid.");
-		static_assert(std::numeric_limits<W3>::is_iec559 || std::numeric_limits<W3>::is_integer, "Matrix4x4 constructor only takes float and integer types, 12th paramter type is invalid.");
+		static_assert(is_arithmetic_v<X3>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 9th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Y3>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 10th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Z3>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 11th paramter type is invalid.");
+		static_assert(is_arithmetic_v<W3>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 12th paramter type is invalid.");
 
-		static_assert(std::numeric_limits<X4>::is_iec559 || std::numeric_limits<X4>::is_integer, "Matrix4x4 constructor only takes float and integer types, 13th paramter type is invalid.");
-		static_assert(std::numeric_limits<Y4>::is_iec559 || std::numeric_limits<Y4>::is_integer, "Matrix4x4 constructor only takes float and integer types, 14th paramter type is invalid.");
-		static_assert(std::numeric_limits<Z4>::is_iec559 || std::numeric_limits<Z4>::is_integer, "Matrix4x4 constructor only takes float and integer types, 15th paramter type is invalid.");
-		static_assert(std::numeric_limits<W4>::is_iec559 || std::numeric_limits<W4>::is_integer, "Matrix4x4 constructor only takes float and integer types, 16th paramter type is invalid.");
+		static_assert(is_arithmetic_v<X4>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 13th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Y4>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 14th paramter type is invalid.");
+		static_assert(is_arithmetic_v<Z4>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 15th paramter type is invalid.");
+		static_assert(is_arithmetic_v<W4>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 16th paramter type is invalid.");
 	}
 
 	template<typename T>
@@ -116,10 +117,10 @@ namespace ecm::math
 			column_type(v3),
 			column_type(v4) }
 	{
-		static_assert(std::numeric_limits<V1>::is_iec559 || std::numeric_limits<V1>::is_integer, "Matrix4x4 constructor only takes float and integer types, 1st paramter type is invalid.");
-		static_assert(std::numeric_limits<V2>::is_iec559 || std::numeric_limits<V2>::is_integer, "Matrix4x4 constructor only takes float and integer types, 2nd paramter type is invalid.");
-		static_assert(std::numeric_limits<V3>::is_iec559 || std::numeric_limits<V3>::is_integer, "Matrix4x4 constructor only takes float and integer types, 3rd paramter type is invalid.");
-		static_assert(std::numeric_limits<V4>::is_iec559 || std::numeric_limits<V4>::is_integer, "Matrix4x4 constructor only takes float and integer types, 4th paramter type is invalid.");
+		static_assert(is_arithmetic_v<V1>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 1st paramter type is invalid.");
+		static_assert(is_arithmetic_v<V2>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 2nd paramter type is invalid.");
+		static_assert(is_arithmetic_v<V3>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 3rd paramter type is invalid.");
+		static_assert(is_arithmetic_v<V4>, "Matrix4x4 constructor only takes float, integer and fixed-point types, 4th paramter type is invalid.");
 	}
 
 	template<typename T>
@@ -431,11 +432,35 @@ namespace ecm::math
 
 		template<typename T>
 		constexpr bool is_aligned_v = is_aligned<T>::value;
+
+		template<typename T>
+		inline Matrix4x4_Base<T> mul_int4x4(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<T> const& m2)
+		{
+			const __m128i a0{ load_int4(m1[0]) };
+			const __m128i a1{ load_int4(m1[1]) };
+			const __m128i a2{ load_int4(m1[2]) };
+			const __m128i a3{ load_int4(m1[3]) };
+
+			Matrix4x4_Base<T> result;
+			for (uint8 i{ 0 }; i < 4; ++i) {
+				const __m128i b{ load_int4(m2[i]) };
+				const __m128i sum0{ _mm_add_epi32(MulLo(a0, SplatX(b)), MulLo(a1, SplatY(b))) };
+				const __m128i sum1{ _mm_add_epi32(MulLo(a2, SplatZ(b)), MulLo(a3, SplatW(b))) };
+				result[i] = store_int4<T>(_mm_add_epi32(sum0, sum1));
+			}
+			return result;
+		}
 	}
 
 	template<typename T, typename U, typename>
 	constexpr Matrix4x4_Base<T> operator*(Matrix4x4_Base<T> const& m1, Matrix4x4_Base<U> const& m2)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>)
+		{
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::mul_int4x4(m1, m2);
+			}
+		}
 		if constexpr (detail::is_aligned_v<typename Matrix4x4_Base<T>::type>)
 		{
 			typename Matrix4x4_Base<T>::column_type const sourceA0 = m1[0];
@@ -0,0 +1,376 @@
+/**
+ * \file matrixn.h
+ *
+ * \brief This header defines fixed-size matrices and dense solvers for small
+ * linear systems.
+ *
+ * The matrices store their elements column by column like Matrix4x4_Base.
+ * Their sizes are known at compile time, so the loops of the solvers have
+ * constant trip counts, which the compiler unrolls for the small systems of
+ * constraint solvers and curve fitting.
+ *
+ * |Solver|Systems|Operations
+ * |-|-|-
+ * |LU with partial pivoting|Square and regular|N^3 / 3
+ * |Cholesky|Symmetric and positive definite|N^3 / 6
+ * |Householder QR|Least squares with full column rank|N^3 * 2 / 3
+ *
+ * SolveBatch solves many independent systems of the same size at once, with
+ * one system in each SIMD lane.
+ */
+
+#pragma once
+#ifndef _ECM_MATRIXN_H_
+#define _ECM_MATRIXN_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a matrix template with R rows and C columns.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	struct MatrixN
+	{
+		static_assert(R > 0 && C > 0, "MatrixN needs at least one row and column");
+
+		typedef T value_type;
+		typedef MatrixN<T, R, C> type;
+
+		/* The number of rows */
+		static constexpr uint32 RowCount{ R };
+		/* The number of columns */
+		static constexpr uint32 ColumnCount{ C };
+
+		// The elements column by column, so that the element of row r and
+		// column c is elements[c * R + r].
+		T elements[R * C]{};
+
+		/**
+		 * Default constructor, which creates the zero matrix.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr MatrixN() = default;
+
+		/**
+		 * Scalar constructor.
+		 * Initializes the diagonal with the given scalar value and all other
+		 * elements with zero.
+		 *
+		 * \param scalar The value of the diagonal.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit constexpr MatrixN(T scalar);
+
+		/**
+		 * Element access by row and column.
+		 *
+		 * \param row The row.
+		 * \param column The column.
+		 *
+		 * \returns A reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T& operator()(uint32 row, uint32 column);
+
+		/**
+		 * Element access by row and column.
+		 *
+		 * \param row The row.
+		 * \param column The column.
+		 *
+		 * \returns A constant reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T const& operator()(uint32 row, uint32 column) const;
+
+		/**
+		 * Element access by the index into the elements, which is the row of
+		 * column vectors.
+		 *
+		 * \param index The index.
+		 *
+		 * \returns A reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T& operator[](uint32 index);
+
+		/**
+		 * Element access by the index into the elements, which is the row of
+		 * column vectors.
+		 *
+		 * \param index The index.
+		 *
+		 * \returns A constant reference to the element.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T const& operator[](uint32 index) const;
+	};
+
+	/**
+	 * A column vector with N elements.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	using VectorN = MatrixN<T, N, 1>;
+
+	// Arithmetic operators
+
+	/**
+	 * This operator checks if two matrices are the same.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	constexpr bool operator==(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2);
+
+	/**
+	 * This operator checks if two matrices are not the same.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	constexpr bool operator!=(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2);
+
+	/**
+	 * Adds two matrices element by element.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator+(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2);
+
+	/**
+	 * Subtracts two matrices element by element.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator-(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2);
+
+	/**
+	 * Multiplies a matrix by a scalar.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator*(MatrixN<T, R, C> const& m, T scalar);
+
+	/**
+	 * Multiplies two matrices.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 K, uint32 C>
+	constexpr MatrixN<T, R, C> operator*(MatrixN<T, R, K> const& m1, MatrixN<T, K, C> const& m2);
+
+	/**
+	 * Transposes a matrix.
+	 *
+	 * \param m The matrix.
+	 *
+	 * \returns The matrix with rows and columns exchanged.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	ECM_NODISCARD constexpr MatrixN<T, C, R> ECM_CALL Transpose(MatrixN<T, R, C> const& m) noexcept;
+
+	// LU decomposition
+
+	/**
+	 * Decomposes a square matrix into PA = LU with partial pivoting. L has
+	 * a unit diagonal, and both triangles are stored in one matrix.
+	 *
+	 * A matrix counts as singular, if a pivot is not larger than the largest
+	 * element times N times the machine epsilon.
+	 *
+	 * \param a The matrix.
+	 * \param lu Receives L below the diagonal and U on and above it.
+	 * \param pivots Receives the row, which was exchanged with each row.
+	 *
+	 * \returns False if the matrix is singular, true otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD bool ECM_CALL DecomposeLU(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& lu,
+		uint32 (&pivots)[N]) noexcept;
+
+	/**
+	 * Solves Ax = b with the decomposition of DecomposeLU.
+	 *
+	 * \param lu The decomposition of A.
+	 * \param pivots The pivots of the decomposition.
+	 * \param b The right-hand side.
+	 *
+	 * \returns The solution x.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD VectorN<T, N> ECM_CALL SolveLU(MatrixN<T, N, N> const& lu, uint32 const (&pivots)[N],
+		VectorN<T, N> const& b) noexcept;
+
+	/**
+	 * Solves the square system Ax = b with an LU decomposition.
+	 *
+	 * \param a The matrix.
+	 * \param b The right-hand side.
+	 * \param x Receives the solution, if the matrix isn't singular.
+	 *
+	 * \returns False if the matrix is singular, true otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD bool ECM_CALL Solve(MatrixN<T, N, N> const& a, VectorN<T, N> const& b, VectorN<T, N>& x) noexcept;
+
+	/**
+	 * Computes the determinant of a square matrix with an LU
+	 * decomposition.
+	 *
+	 * \param a The matrix.
+	 *
+	 * \returns The determinant, or 0 if the matrix is singular.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD T ECM_CALL Determinant(MatrixN<T, N, N> const& a) noexcept;
+
+	/**
+	 * Inverts a square matrix with an LU decomposition.
+	 *
+	 * \param a The matrix.
+	 * \param inverse Receives the inverse, if the matrix isn't singular.
+	 *
+	 * \returns False if the matrix is singular, true otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD bool ECM_CALL Inverse(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& inverse) noexcept;
+
+	// Cholesky decomposition
+
+	/**
+	 * Decomposes a symmetric positive definite matrix into A = LL^T. Only
+	 * the lower triangle of the matrix is read.
+	 *
+	 * \param a The matrix.
+	 * \param l Receives the lower triangular factor, whose upper triangle is
+	 *          zero.
+	 *
+	 * \returns False if the matrix isn't positive definite, true otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD bool ECM_CALL DecomposeCholesky(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& l) noexcept;
+
+	/**
+	 * Solves Ax = b with the factor of DecomposeCholesky.
+	 *
+	 * \param l The lower triangular factor of A.
+	 * \param b The right-hand side.
+	 *
+	 * \returns The solution x.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 N>
+	ECM_NODISCARD VectorN<T, N> ECM_CALL SolveCholesky(MatrixN<T, N, N> const& l, VectorN<T, N> const& b) noexcept;
+
+	// QR decomposition
+
+	/**
+	 * Decomposes a matrix with at least as many rows as columns into A = QR
+	 * with Householder reflections.
+	 *
+	 * \param a The matrix.
+	 * \param q Receives the orthonormal columns of Q.
+	 * \param r Receives the upper triangular factor.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	void ECM_CALL DecomposeQR(MatrixN<T, R, C> const& a, MatrixN<T, R, C>& q, MatrixN<T, C, C>& r) noexcept;
+
+	/**
+	 * Solves Ax = b in the least squares sense with a QR decomposition, for
+	 * example to fit a curve to more points than it has coefficients.
+	 *
+	 * \param a The matrix, with at least as many rows as columns.
+	 * \param b The right-hand side.
+	 * \param x Receives the solution, which minimizes |Ax - b|, if the
+	 *          columns of the matrix are independent.
+	 *
+	 * \returns False if the columns of the matrix are dependent, true
+	 *          otherwise.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T, uint32 R, uint32 C>
+	ECM_NODISCARD bool ECM_CALL SolveLeastSquares(MatrixN<T, R, C> const& a, VectorN<T, R> const& b,
+		VectorN<T, C>& x) noexcept;
+
+	// Eigen decomposition
+
+	/**
+	 * Computes the eigenvalues and eigenvectors of a symmetric 3x3 matrix,
+	 * for example of an inertia tensor or a covariance matrix, with Jacobi
+	 * rotations. Only the upper triangle of the matrix is read.
+	 *
+	 * \param a The matrix.
+	 * \param values Receives the eigenvalues in ascending order.
+	 * \param vectors Receives the eigenvectors of unit length in the columns
+	 *                of the same order, which form a rotation.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	void ECM_CALL EigenSymmetric3(MatrixN<T, 3, 3> const& a, VectorN<T, 3>& values,
+		MatrixN<T, 3, 3>& vectors) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Solves independent square systems Ax = b of the same size with LU
+	 * decompositions with partial pivoting, with one system in each SIMD
+	 * lane.
+	 *
+	 * The arrays hold the systems side by side: the element of row r and
+	 * column c of system i is a[(c * n + r) * count + i], and the element r
+	 * of its vectors is b[r * count + i] and x[r * count + i].
+	 *
+	 * \param n The size of the systems, from 1 to 8.
+	 * \param a The matrices.
+	 * \param b The right-hand sides.
+	 * \param x The array receiving the solutions, which are zero for
+	 *          singular systems.
+	 * \param count The number of systems.
+	 *
+	 * \returns The number of systems, which aren't singular, or 0 if the
+	 *          size is not supported.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API uint64 ECM_CALL SolveBatch(uint32 n, float32 const* a, float32 const* b, float32* x,
+		uint64 count);
+} // namespace ecm::math
+
+#include "matrixn.inl"
+
+#endif // !_ECM_MATRIXN_H_
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <ECM/math/matrixn.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace ecm::math
+{
+	// Constructors and element access
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C>::MatrixN(T scalar)
+	{
+		for (uint32 i{ 0 }; i < (R < C ? R : C); ++i)
+			elements[i * R + i] = scalar;
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr T& MatrixN<T, R, C>::operator()(uint32 row, uint32 column)
+	{
+		return elements[column * R + row];
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr T const& MatrixN<T, R, C>::operator()(uint32 row, uint32 column) const
+	{
+		return elements[column * R + row];
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr T& MatrixN<T, R, C>::operator[](uint32 index)
+	{
+		return elements[index];
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr T const& MatrixN<T, R, C>::operator[](uint32 index) const
+	{
+		return elements[index];
+	}
+
+	// Arithmetic operators
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr bool operator==(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2)
+	{
+		for (uint32 i{ 0 }; i < R * C; ++i) {
+			if (m1.elements[i] != m2.elements[i])
+				return false;
+		}
+		return true;
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr bool operator!=(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2)
+	{
+		return !(m1 == m2);
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator+(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2)
+	{
+		MatrixN<T, R, C> result;
+		for (uint32 i{ 0 }; i < R * C; ++i)
+			result.elements[i] = m1.elements[i] + m2.elements[i];
+		return result;
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator-(MatrixN<T, R, C> const& m1, MatrixN<T, R, C> const& m2)
+	{
+		MatrixN<T, R, C> result;
+		for (uint32 i{ 0 }; i < R * C; ++i)
+			result.elements[i] = m1.elements[i] - m2.elements[i];
+		return result;
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, R, C> operator*(MatrixN<T, R, C> const& m, T scalar)
+	{
+		MatrixN<T, R, C> result;
+		for (uint32 i{ 0 }; i < R * C; ++i)
+			result.elements[i] = m.elements[i] * scalar;
+		return result;
+	}
+
+	template<typename T, uint32 R, uint32 K, uint32 C>
+	constexpr MatrixN<T, R, C> operator*(MatrixN<T, R, K> const& m1, MatrixN<T, K, C> const& m2)
+	{
+		// Each column of the result is a sum of the columns of m1, which
+		// runs down the contiguous columns
+		MatrixN<T, R, C> result;
+		for (uint32 c{ 0 }; c < C; ++c) {
+			for (uint32 k{ 0 }; k < K; ++k) {
+				const T factor{ m2(k, c) };
+				for (uint32 r{ 0 }; r < R; ++r)
+					result(r, c) += m1(r, k) * factor;
+			}
+		}
+		return result;
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	constexpr MatrixN<T, C, R> Transpose(MatrixN<T, R, C> const& m) noexcept
+	{
+		MatrixN<T, C, R> result;
+		for (uint32 c{ 0 }; c < C; ++c) {
+			for (uint32 r{ 0 }; r < R; ++r)
+				result(c, r) = m(r, c);
+		}
+		return result;
+	}
+
+	namespace detail
+	{
+		// The largest absolute element, which scales the tolerances of the
+		// solvers
+		template<typename T, uint32 R, uint32 C>
+		inline T max_abs(MatrixN<T, R, C> const& m) noexcept
+		{
+			T result{ 0 };
+			for (uint32 i{ 0 }; i < R * C; ++i)
+				result = std::max(result, std::abs(m.elements[i]));
+			return result;
+		}
+	} // namespace detail
+
+	// LU decomposition
+
+	template<typename T, uint32 N>
+	bool DecomposeLU(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& lu, uint32 (&pivots)[N]) noexcept
+	{
+		lu = a;
+		const T tolerance{ detail::max_abs(a) * static_cast<T>(N) * std::numeric_limits<T>::epsilon() };
+		for (uint32 k{ 0 }; k < N; ++k) {
+			uint32 pivot{ k };
+			T largest{ std::abs(lu(k, k)) };
+			for (uint32 i{ k + 1 }; i < N; ++i) {
+				if (std::abs(lu(i, k)) > largest) {
+					largest = std::abs(lu(i, k));
+					pivot = i;
+				}
+			}
+			pivots[k] = pivot;
+			// NaN is singular as well
+			if (!(largest > tolerance))
+				return false;
+			if (pivot != k) {
+				for (uint32 j{ 0 }; j < N; ++j)
+					std::swap(lu(k, j), lu(pivot, j));
+			}
+			const T inverse{ T(1) / lu(k, k) };
+			for (uint32 i{ k + 1 }; i < N; ++i)
+				lu(i, k) *= inverse;
+			for (uint32 j{ k + 1 }; j < N; ++j) {
+				const T factor{ lu(k, j) };
+				for (uint32 i{ k + 1 }; i < N; ++i)
+					lu(i, j) -= lu(i, k) * factor;
+			}
+		}
+		return true;
+	}
+
+	template<typename T, uint32 N>
+	VectorN<T, N> SolveLU(MatrixN<T, N, N> const& lu, uint32 const (&pivots)[N], VectorN<T, N> const& b) noexcept
+	{
+		VectorN<T, N> x{ b };
+		for (uint32 k{ 0 }; k < N; ++k)
+			std::swap(x[k], x[pivots[k]]);
+		for (uint32 k{ 0 }; k < N; ++k) {
+			for (uint32 i{ k + 1 }; i < N; ++i)
+				x[i] -= lu(i, k) * x[k];
+		}
+		for (uint32 k{ N }; k-- > 0;) {
+			x[k] /= lu(k, k);
+			for (uint32 i{ 0 }; i < k; ++i)
+				x[i] -= lu(i, k) * x[k];
+		}
+		return x;
+	}
+
+	template<typename T, uint32 N>
+	bool Solve(MatrixN<T, N, N> const& a, VectorN<T, N> const& b, VectorN<T, N>& x) noexcept
+	{
+		MatrixN<T, N, N> lu;
+		uint32 pivots[N];
+		if (!DecomposeLU(a, lu, pivots))
+			return false;
+		x = SolveLU(lu, pivots, b);
+		return true;
+	}
+
+	template<typename T, uint32 N>
+	T Determinant(MatrixN<T, N, N> const& a) noexcept
+	{
+		MatrixN<T, N, N> lu;
+		uint32 pivots[N];
+		if (!DecomposeLU(a, lu, pivots))
+			return T(0);
+		T result{ 1 };
+		for (uint32 k{ 0 }; k < N; ++k)
+			result *= pivots[k] == k ? lu(k, k) : -lu(k, k);
+		return result;
+	}
+
+	template<typename T, uint32 N>
+	bool Inverse(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& inverse) noexcept
+	{
+		MatrixN<T, N, N> lu;
+		uint32 pivots[N];
+		if (!DecomposeLU(a, lu, pivots))
+			return false;
+		for (uint32 c{ 0 }; c < N; ++c) {
+			VectorN<T, N> unit;
+			unit[c] = T(1);
+			const VectorN<T, N> column{ SolveLU(lu, pivots, unit) };
+			for (uint32 r{ 0 }; r < N; ++r)
+				inverse(r, c) = column[r];
+		}
+		return true;
+	}
+
+	// Cholesky decomposition
+
+	template<typename T, uint32 N>
+	bool DecomposeCholesky(MatrixN<T, N, N> const& a, MatrixN<T, N, N>& l) noexcept
+	{
+		l = MatrixN<T, N, N>();
+		for (uint32 j{ 0 }; j < N; ++j) {
+			T diagonal{ a(j, j) };
+			for (uint32 k{ 0 }; k < j; ++k)
+				diagonal -= l(j, k) * l(j, k);
+			if (!(diagonal > T(0)))
+				return false;
+			const T root{ std::sqrt(diagonal) };
+			l(j, j) = root;
+			const T inverse{ T(1) / root };
+			for (uint32 i{ j + 1 }; i < N; ++i) {
+				T sum{ a(i, j) };
+				for (uint32 k{ 0 }; k < j; ++k)
+					sum -= l(i, k) * l(j, k);
+				l(i, j) = sum * inverse;
+			}
+		}
+		return true;
+	}
+
+	template<typename T, uint32 N>
+	VectorN<T, N> SolveCholesky(MatrixN<T, N, N> const& l, VectorN<T, N> const& b) noexcept
+	{
+		// Solves Ly = b, then L^T x = y
+		VectorN<T, N> x{ b };
+		for (uint32 k{ 0 }; k < N; ++k) {
+			x[k] /= l(k, k);
+			for (uint32 i{ k + 1 }; i < N; ++i)
+				x[i] -= l(i, k) * x[k];
+		}
+		for (uint32 k{ N }; k-- > 0;) {
+			for (uint32 i{ k + 1 }; i < N; ++i)
+				x[k] -= l(i, k) * x[i];
+			x[k] /= l(k, k);
+		}
+		return x;
+	}
+
+	// QR decomposition
+
+	namespace detail
+	{
+		// Reduces a matrix to R with Householder reflections, which are
+		// returned as the vectors v and factors beta of I - beta * v * v^T.
+		template<typename T, uint32 R, uint32 C>
+		void householder(MatrixN<T, R, C>& w, MatrixN<T, R, C>& v, T (&beta)[C]) noexcept
+		{
+			static_assert(R >= C, "QR needs at least as many rows as columns");
+			v = MatrixN<T, R, C>();
+			for (uint32 k{ 0 }; k < C; ++k) {
+				T normSquared{ 0 };
+				for (uint32 i{ k }; i < R; ++i)
+					normSquared += w(i, k) * w(i, k);
+				beta[k] = T(0);
+				if (!(normSquared > T(0)))
+					continue;
+				// The sign avoids cancellation in the first element of v
+				const T alpha{ w(k, k) > T(0) ? -std::sqrt(normSquared) : std::sqrt(normSquared) };
+				for (uint32 i{ k }; i < R; ++i)
+					v(i, k) = w(i, k);
+				v(k, k) -= alpha;
+				const T vv{ normSquared - T(2) * alpha * w(k, k) + alpha * alpha };
+				beta[k] = T(2) / vv;
+				w(k, k) = alpha;
+				for (uint32 i{ k + 1 }; i < R; ++i)
+					w(i, k) = T(0);
+				for (uint32 j{ k + 1 }; j < C; ++j) {
+					T s{ 0 };
+					for (uint32 i{ k }; i < R; ++i)
+						s += v(i, k) * w(i, j);
+					s *= beta[k];
+					for (uint32 i{ k }; i < R; ++i)
+						w(i, j) -= s * v(i, k);
+				}
+			}
+		}
+	} // namespace detail
+
+	template<typename T, uint32 R, uint32 C>
+	void DecomposeQR(MatrixN<T, R, C> const& a, MatrixN<T, R, C>& q, MatrixN<T, C, C>& r) noexcept
+	{
+		MatrixN<T, R, C> w{ a };
+		MatrixN<T, R, C> v;
+		T beta[C];
+		detail::householder(w, v, beta);
+		r = MatrixN<T, C, C>();
+		for (uint32 j{ 0 }; j < C; ++j) {
+			for (uint32 i{ 0 }; i <= j; ++i)
+				r(i, j) = w(i, j);
+		}
+		// Q is the product of the reflections, applied to the first columns
+		// of the identity in reverse order
+		q = MatrixN<T, R, C>(T(1));
+		for (uint32 k{ C }; k-- > 0;) {
+			for (uint32 j{ 0 }; j < C; ++j) {
+				T s{ 0 };
+				for (uint32 i{ k }; i < R; ++i)
+					s += v(i, k) * q(i, j);
+				s *= beta[k];
+				for (uint32 i{ k }; i < R; ++i)
+					q(i, j) -= s * v(i, k);
+			}
+		}
+	}
+
+	template<typename T, uint32 R, uint32 C>
+	bool SolveLeastSquares(MatrixN<T, R, C> const& a, VectorN<T, R> const& b, VectorN<T, C>& x) noexcept
+	{
+		MatrixN<T, R, C> w{ a };
+		MatrixN<T, R, C> v;
+		T beta[C];
+		detail::householder(w, v, beta);
+		const T tolerance{ detail::max_abs(w) * static_cast<T>(R) * std::numeric_limits<T>::epsilon() };
+		for (uint32 k{ 0 }; k < C; ++k) {
+			if (!(std::abs(w(k, k)) > tolerance))
+				return false;
+		}
+		// Q^T b by the reflections, without forming Q
+		VectorN<T, R> y{ b };
+		for (uint32 k{ 0 }; k < C; ++k) {
+			T s{ 0 };
+			for (uint32 i{ k }; i < R; ++i)
+				s += v(i, k) * y[i];
+			s *= beta[k];
+			for (uint32 i{ k }; i < R; ++i)
+				y[i] -= s * v(i, k);
+		}
+		for (uint32 k{ C }; k-- > 0;) {
+			T sum{ y[k] };
+			for (uint32 j{ k + 1 }; j < C; ++j)
+				sum -= w(k, j) * x[j];
+			x[k] = sum / w(k, k);
+		}
+		return true;
+	}
+
+	// Eigen decomposition
+
+	template<typename T>
+	void EigenSymmetric3(MatrixN<T, 3, 3> const& a, VectorN<T, 3>& values, MatrixN<T, 3, 3>& vectors) noexcept
+	{
+		// Cyclic Jacobi rotations (Golub and Van Loan, 8.5), which converge
+		// quadratically and keep the eigenvectors orthogonal
+		MatrixN<T, 3, 3> m;
+		for (uint32 c{ 0 }; c < 3; ++c) {
+			for (uint32 r{ 0 }; r <= c; ++r)
+				m(r, c) = m(c, r) = a(r, c);
+		}
+		MatrixN<T, 3, 3> v(T(1));
+		T total{ 0 };
+		for (uint32 i{ 0 }; i < 9; ++i)
+			total += m.elements[i] * m.elements[i];
+		const T tolerance{ total * std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() };
+		for (uint32 sweep{ 0 }; sweep < 16; ++sweep) {
+			const T off{ m(0, 1) * m(0, 1) + m(0, 2) * m(0, 2) + m(1, 2) * m(1, 2) };
+			if (!(off > tolerance))
+				break;
+			static constexpr uint32 Pairs[3][2]{ { 0, 1 }, { 0, 2 }, { 1, 2 } };
+			for (uint32 const* pair : Pairs) {
+				const uint32 p{ pair[0] };
+				const uint32 q{ pair[1] };
+				if (m(p, q) == T(0))
+					continue;
+				const T theta{ (m(q, q) - m(p, p)) / (T(2) * m(p, q)) };
+				// The smaller angle, whose tangent doesn't overflow for
+				// large theta
+				const T t{ std::abs(theta) > T(1) / std::numeric_limits<T>::epsilon()
+					? T(1) / (T(2) * theta)
+					: (theta < T(0) ? T(-1) : T(1)) / (std::abs(theta) + std::sqrt(theta * theta + T(1))) };
+				const T c{ T(1) / std::sqrt(t * t + T(1)) };
+				const T s{ t * c };
+				for (uint32 k{ 0 }; k < 3; ++k) {
+					const T mkp{ m(k, p) };
+					const T mkq{ m(k, q) };
+					m(k, p) = c * mkp - s * mkq;
+					m(k, q) = s * mkp + c * mkq;
+				}
+				for (uint32 k{ 0 }; k < 3; ++k) {
+					const T mpk{ m(p, k) };
+					const T mqk{ m(q, k) };
+					m(p, k) = c * mpk - s * mqk;
+					m(q, k) = s * mpk + c * mqk;
+				}
+				m(p, q) = m(q, p) = T(0);
+				for (uint32 k{ 0 }; k < 3; ++k) {
+					const T vkp{ v(k, p) };
+					const T vkq{ v(k, q) };
+					v(k, p) = c * vkp - s * vkq;
+					v(k, q) = s * vkp + c * vkq;
+				}
+			}
+		}
+
+		uint32 order[3]{ 0, 1, 2 };
+		for (uint32 i{ 0 }; i < 3; ++i) {
+			for (uint32 j{ i + 1 }; j < 3; ++j) {
+				if (m(order[j], order[j]) < m(order[i], order[i]))
+					std::swap(order[i], order[j]);
+			}
+		}
+		for (uint32 i{ 0 }; i < 3; ++i) {
+			values[i] = m(order[i], order[i]);
+			for (uint32 r{ 0 }; r < 3; ++r)
+				vectors(r, i) = v(r, order[i]);
+		}
+		// A reflection becomes a rotation by flipping the last eigenvector
+		const T determinant{ vectors(0, 0) * (vectors(1, 1) * vectors(2, 2) - vectors(2, 1) * vectors(1, 2))
+			- vectors(0, 1) * (vectors(1, 0) * vectors(2, 2) - vectors(2, 0) * vectors(1, 2))
+			+ vectors(0, 2) * (vectors(1, 0) * vectors(2, 1) - vectors(2, 0) * vectors(1, 1)) };
+		if (determinant < T(0)) {
+			for (uint32 r{ 0 }; r < 3; ++r)
+				vectors(r, 2) = -vectors(r, 2);
+		}
+	}
+} // namespace ecm::math
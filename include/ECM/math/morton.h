@@ -0,0 +1,282 @@
+/**
+ * \file morton.h
+ *
+ * \brief This header defines Morton codes and Hilbert indices of 2D and 3D
+ * grid cells, which order cells along a space-filling curve.
+ *
+ * Sorting particles, voxels or draw calls by these codes keeps cells, which
+ * are close in space, close in memory. The Hilbert curve never jumps between
+ * distant cells, so it keeps more locality than the Z-order of Morton codes,
+ * which are however much cheaper to compute.
+ *
+ * The codes only take as many bits of each coordinate, as fit into them:
+ *
+ * |Code|Bits per coordinate
+ * |-|-
+ * |2D, 32-bit|16
+ * |2D, 64-bit|32
+ * |3D, 32-bit|10
+ * |3D, 64-bit|21
+ *
+ * Higher bits are ignored. The bits of x are the lowest of each group of
+ * the Morton codes. Morton codes use the pdep and pext instructions, if BMI2
+ * is enabled, which some older AMD processors execute slower than the bit
+ * operations used otherwise.
+ */
+
+#pragma once
+#ifndef _ECM_MORTON_H_
+#define _ECM_MORTON_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/vector2.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	// Morton codes
+
+	/**
+	 * Encodes a 2D cell into a 32-bit Morton code.
+	 *
+	 * \param cell The cell, whose coordinates have 16 bits.
+	 *
+	 * \returns The code.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint32 ECM_CALL EncodeMorton2D32(Vector2_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Decodes a 32-bit Morton code, which was encoded by EncodeMorton2D32.
+	 *
+	 * \param code The code.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector2_Base<uint32> ECM_CALL DecodeMorton2D32(uint32 code) noexcept;
+
+	/**
+	 * Encodes a 2D cell into a 64-bit Morton code.
+	 *
+	 * \param cell The cell, whose coordinates have 32 bits.
+	 *
+	 * \returns The code.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint64 ECM_CALL EncodeMorton2D64(Vector2_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Decodes a 64-bit Morton code, which was encoded by EncodeMorton2D64.
+	 *
+	 * \param code The code.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector2_Base<uint32> ECM_CALL DecodeMorton2D64(uint64 code) noexcept;
+
+	/**
+	 * Encodes a 3D cell into a 32-bit Morton code.
+	 *
+	 * \param cell The cell, whose coordinates have 10 bits.
+	 *
+	 * \returns The code in the low 30 bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint32 ECM_CALL EncodeMorton3D32(Vector3_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Decodes a 32-bit Morton code, which was encoded by EncodeMorton3D32.
+	 *
+	 * \param code The code.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector3_Base<uint32> ECM_CALL DecodeMorton3D32(uint32 code) noexcept;
+
+	/**
+	 * Encodes a 3D cell into a 64-bit Morton code.
+	 *
+	 * \param cell The cell, whose coordinates have 21 bits.
+	 *
+	 * \returns The code in the low 63 bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint64 ECM_CALL EncodeMorton3D64(Vector3_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Decodes a 64-bit Morton code, which was encoded by EncodeMorton3D64.
+	 *
+	 * \param code The code.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector3_Base<uint32> ECM_CALL DecodeMorton3D64(uint64 code) noexcept;
+
+	// Hilbert indices
+
+	/**
+	 * Computes the 32-bit index of a 2D cell along the Hilbert curve.
+	 *
+	 * \param cell The cell, whose coordinates have 16 bits.
+	 *
+	 * \returns The index.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL EncodeHilbert2D32(Vector2_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Computes the 2D cell at a 32-bit index along the Hilbert curve.
+	 *
+	 * \param index The index.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector2_Base<uint32> ECM_CALL DecodeHilbert2D32(uint32 index) noexcept;
+
+	/**
+	 * Computes the 64-bit index of a 2D cell along the Hilbert curve.
+	 *
+	 * \param cell The cell, whose coordinates have 32 bits.
+	 *
+	 * \returns The index.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint64 ECM_CALL EncodeHilbert2D64(Vector2_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Computes the 2D cell at a 64-bit index along the Hilbert curve.
+	 *
+	 * \param index The index.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector2_Base<uint32> ECM_CALL DecodeHilbert2D64(uint64 index) noexcept;
+
+	/**
+	 * Computes the 32-bit index of a 3D cell along the Hilbert curve.
+	 *
+	 * \param cell The cell, whose coordinates have 10 bits.
+	 *
+	 * \returns The index in the low 30 bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL EncodeHilbert3D32(Vector3_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Computes the 3D cell at a 32-bit index along the Hilbert curve.
+	 *
+	 * \param index The index.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector3_Base<uint32> ECM_CALL DecodeHilbert3D32(uint32 index) noexcept;
+
+	/**
+	 * Computes the 64-bit index of a 3D cell along the Hilbert curve.
+	 *
+	 * \param cell The cell, whose coordinates have 21 bits.
+	 *
+	 * \returns The index in the low 63 bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint64 ECM_CALL EncodeHilbert3D64(Vector3_Base<uint32> const& cell) noexcept;
+
+	/**
+	 * Computes the 3D cell at a 64-bit index along the Hilbert curve.
+	 *
+	 * \param index The index.
+	 *
+	 * \returns The cell.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector3_Base<uint32> ECM_CALL DecodeHilbert3D64(uint64 index) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Encodes the positions of an array into 32-bit Morton codes. The box is
+	 * divided into 1024 cells along each axis, and each position is encoded
+	 * by the cell, which contains it. Positions outside of the box are
+	 * clamped to it.
+	 *
+	 * \param bounds The box of the positions.
+	 * \param in The positions to encode.
+	 * \param out The array receiving the codes.
+	 * \param count The number of positions.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeMorton3D32Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in,
+		uint32* out, uint64 count);
+
+	/**
+	 * Encodes the positions of an array into 64-bit Morton codes. Same as
+	 * EncodeMorton3D32Batch, but with 2097152 cells along each axis.
+	 *
+	 * \param bounds The box of the positions.
+	 * \param in The positions to encode.
+	 * \param out The array receiving the codes.
+	 * \param count The number of positions.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeMorton3D64Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in,
+		uint64* out, uint64 count);
+
+	/**
+	 * Encodes the positions of an array into 32-bit Hilbert indices. The
+	 * positions are divided into cells like by EncodeMorton3D32Batch.
+	 *
+	 * \param bounds The box of the positions.
+	 * \param in The positions to encode.
+	 * \param out The array receiving the indices.
+	 * \param count The number of positions.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeHilbert3D32Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in,
+		uint32* out, uint64 count);
+
+	/**
+	 * Encodes the positions of an array into 64-bit Hilbert indices. The
+	 * positions are divided into cells like by EncodeMorton3D64Batch.
+	 *
+	 * \param bounds The box of the positions.
+	 * \param in The positions to encode.
+	 * \param out The array receiving the indices.
+	 * \param count The number of positions.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeHilbert3D64Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in,
+		uint64* out, uint64 count);
+} // namespace ecm::math
+
+#include "morton.inl"
+
+#endif // !_ECM_MORTON_H_
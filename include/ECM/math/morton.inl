@@ -0,0 +1,186 @@
+#pragma once
+
+#include <ECM/math/morton.h>
+#include <ECM/math/functions_simd.h>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// The bit operations are templates, so that the batch functions run
+		// them on SIMD lanes as well.
+
+		// Spreads the low 16 bits of v to the even bits.
+		template<typename I>
+		inline I spread_bits2(I v) noexcept
+		{
+			v = v & I(0x0000ffffu);
+			v = (v | (v << 8)) & I(0x00ff00ffu);
+			v = (v | (v << 4)) & I(0x0f0f0f0fu);
+			v = (v | (v << 2)) & I(0x33333333u);
+			return (v | (v << 1)) & I(0x55555555u);
+		}
+
+		// Gathers the even bits of v into the low 16 bits.
+		template<typename I>
+		inline I compact_bits2(I v) noexcept
+		{
+			v = v & I(0x55555555u);
+			v = (v | (v >> 1)) & I(0x33333333u);
+			v = (v | (v >> 2)) & I(0x0f0f0f0fu);
+			v = (v | (v >> 4)) & I(0x00ff00ffu);
+			return (v | (v >> 8)) & I(0x0000ffffu);
+		}
+
+		// Spreads the low 10 bits of v to every third bit.
+		template<typename I>
+		inline I spread_bits3(I v) noexcept
+		{
+			v = v & I(0x000003ffu);
+			v = (v | (v << 16)) & I(0xff0000ffu);
+			v = (v | (v << 8)) & I(0x0300f00fu);
+			v = (v | (v << 4)) & I(0x030c30c3u);
+			return (v | (v << 2)) & I(0x09249249u);
+		}
+
+		// Gathers every third bit of v into the low 10 bits.
+		template<typename I>
+		inline I compact_bits3(I v) noexcept
+		{
+			v = v & I(0x09249249u);
+			v = (v | (v >> 2)) & I(0x030c30c3u);
+			v = (v | (v >> 4)) & I(0x0300f00fu);
+			v = (v | (v >> 8)) & I(0xff0000ffu);
+			return (v | (v >> 16)) & I(0x000003ffu);
+		}
+
+		// Spreads the 32 bits of v to the even bits.
+		inline uint64 spread_bits2_64(uint64 v) noexcept
+		{
+			v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+			v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+			v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+			v = (v | (v << 2)) & 0x3333333333333333ull;
+			return (v | (v << 1)) & 0x5555555555555555ull;
+		}
+
+		// Gathers the even bits of v into the low 32 bits.
+		inline uint32 compact_bits2_64(uint64 v) noexcept
+		{
+			v &= 0x5555555555555555ull;
+			v = (v | (v >> 1)) & 0x3333333333333333ull;
+			v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0full;
+			v = (v | (v >> 4)) & 0x00ff00ff00ff00ffull;
+			v = (v | (v >> 8)) & 0x0000ffff0000ffffull;
+			return static_cast<uint32>(v | (v >> 16));
+		}
+
+		// Spreads the low 21 bits of v to every third bit.
+		template<typename L>
+		inline L spread_bits3_64(L v) noexcept
+		{
+			v = v & L(0x00000000001fffffull);
+			v = (v | (v << 32)) & L(0x001f00000000ffffull);
+			v = (v | (v << 16)) & L(0x001f0000ff0000ffull);
+			v = (v | (v << 8)) & L(0x100f00f00f00f00full);
+			v = (v | (v << 4)) & L(0x10c30c30c30c30c3ull);
+			return (v | (v << 2)) & L(0x1249249249249249ull);
+		}
+
+		// Gathers every third bit of v into the low 21 bits.
+		inline uint32 compact_bits3_64(uint64 v) noexcept
+		{
+			v &= 0x1249249249249249ull;
+			v = (v | (v >> 2)) & 0x10c30c30c30c30c3ull;
+			v = (v | (v >> 4)) & 0x100f00f00f00f00full;
+			v = (v | (v >> 8)) & 0x001f0000ff0000ffull;
+			v = (v | (v >> 16)) & 0x001f00000000ffffull;
+			return static_cast<uint32>((v | (v >> 32)) & 0x00000000001fffffull);
+		}
+	} // namespace detail
+
+	// Morton codes
+
+	uint32 EncodeMorton2D32(Vector2_Base<uint32> const& cell) noexcept
+	{
+#if ECM_SIMD_BMI2
+		return _pdep_u32(cell.x, 0x55555555u) | _pdep_u32(cell.y, 0xaaaaaaaau);
+#else
+		return detail::spread_bits2(cell.x) | (detail::spread_bits2(cell.y) << 1);
+#endif // ECM_SIMD_BMI2
+	}
+
+	Vector2_Base<uint32> DecodeMorton2D32(uint32 code) noexcept
+	{
+#if ECM_SIMD_BMI2
+		return Vector2_Base<uint32>(_pext_u32(code, 0x55555555u), _pext_u32(code, 0xaaaaaaaau));
+#else
+		return Vector2_Base<uint32>(detail::compact_bits2(code), detail::compact_bits2(code >> 1));
+#endif // ECM_SIMD_BMI2
+	}
+
+	uint64 EncodeMorton2D64(Vector2_Base<uint32> const& cell) noexcept
+	{
+#if ECM_SIMD_BMI2 && defined(ECM_OS_X64)
+		return _pdep_u64(cell.x, 0x5555555555555555ull) | _pdep_u64(cell.y, 0xaaaaaaaaaaaaaaaaull);
+#else
+		return detail::spread_bits2_64(cell.x) | (detail::spread_bits2_64(cell.y) << 1);
+#endif // ECM_SIMD_BMI2 && ECM_OS_X64
+	}
+
+	Vector2_Base<uint32> DecodeMorton2D64(uint64 code) noexcept
+	{
+#if ECM_SIMD_BMI2 && defined(ECM_OS_X64)
+		return Vector2_Base<uint32>(
+			static_cast<uint32>(_pext_u64(code, 0x5555555555555555ull)),
+			static_cast<uint32>(_pext_u64(code, 0xaaaaaaaaaaaaaaaaull)));
+#else
+		return Vector2_Base<uint32>(detail::compact_bits2_64(code), detail::compact_bits2_64(code >> 1));
+#endif // ECM_SIMD_BMI2 && ECM_OS_X64
+	}
+
+	uint32 EncodeMorton3D32(Vector3_Base<uint32> const& cell) noexcept
+	{
+#if ECM_SIMD_BMI2
+		return _pdep_u32(cell.x, 0x09249249u) | _pdep_u32(cell.y, 0x12492492u) | _pdep_u32(cell.z, 0x24924924u);
+#else
+		return detail::spread_bits3(cell.x) | (detail::spread_bits3(cell.y) << 1)
+			| (detail::spread_bits3(cell.z) << 2);
+#endif // ECM_SIMD_BMI2
+	}
+
+	Vector3_Base<uint32> DecodeMorton3D32(uint32 code) noexcept
+	{
+#if ECM_SIMD_BMI2
+		return Vector3_Base<uint32>(
+			_pext_u32(code, 0x09249249u), _pext_u32(code, 0x12492492u), _pext_u32(code, 0x24924924u));
+#else
+		return Vector3_Base<uint32>(
+			detail::compact_bits3(code), detail::compact_bits3(code >> 1), detail::compact_bits3(code >> 2));
+#endif // ECM_SIMD_BMI2
+	}
+
+	uint64 EncodeMorton3D64(Vector3_Base<uint32> const& cell) noexcept
+	{
+#if ECM_SIMD_BMI2 && defined(ECM_OS_X64)
+		return _pdep_u64(cell.x, 0x1249249249249249ull) | _pdep_u64(cell.y, 0x2492492492492492ull)
+			| _pdep_u64(cell.z, 0x4924924924924924ull);
+#else
+		return detail::spread_bits3_64<uint64>(cell.x) | (detail::spread_bits3_64<uint64>(cell.y) << 1)
+			| (detail::spread_bits3_64<uint64>(cell.z) << 2);
+#endif // ECM_SIMD_BMI2 && ECM_OS_X64
+	}
+
+	Vector3_Base<uint32> DecodeMorton3D64(uint64 code) noexcept
+	{
+#if ECM_SIMD_BMI2 && defined(ECM_OS_X64)
+		return Vector3_Base<uint32>(
+			static_cast<uint32>(_pext_u64(code, 0x1249249249249249ull)),
+			static_cast<uint32>(_pext_u64(code, 0x2492492492492492ull)),
+			static_cast<uint32>(_pext_u64(code, 0x4924924924924924ull)));
+#else
+		return Vector3_Base<uint32>(
+			detail::compact_bits3_64(code), detail::compact_bits3_64(code >> 1), detail::compact_bits3_64(code >> 2));
+#endif // ECM_SIMD_BMI2 && ECM_OS_X64
+	}
+} // namespace ecm::math
@@ -0,0 +1,306 @@
+/**
+ * \file noise.h
+ *
+ * \brief This header defines gradient and cellular noise functions.
+ *
+ * The noise functions are deterministic for a seed, so the same point gives
+ * the same value on every platform. Perlin and OpenSimplex2 noise return
+ * values in the range [-1, 1]. Worley noise returns the distance to the
+ * nearest feature point, which is in the range [0, 1] for 2D and slightly
+ * larger in rare cases for 3D and 4D.
+ *
+ * The batch functions evaluate eight points at once with AVX2 and four with
+ * SSE2. FillNoiseGrid additionally splits the grid into rows, which run on
+ * the threads of ParallelFor.
+ */
+
+#pragma once
+#ifndef _ECM_NOISE_H_
+#define _ECM_NOISE_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector2.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines the base functions of the layered noise.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class NoiseType : uint8
+	{
+		PERLIN = 0x0,
+		OPENSIMPLEX2,
+		WORLEY
+	} NoiseType;
+
+	/**
+	 * This enumeration defines how octaves of noise are layered.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class FractalType : uint8
+	{
+		/* A single octave */
+		NONE = 0x0,
+		/* Fractal Brownian motion, the sum of all octaves */
+		FBM,
+		/* The sum of all octaves, folded to sharp ridges: 1 - 2 * |noise| */
+		RIDGED
+	} FractalType;
+
+	/**
+	 * This structure defines the settings of layered noise.
+	 *
+	 * The sum of the octaves is divided by the sum of their amplitudes, so
+	 * the result keeps the range of the base function. Every octave uses the
+	 * seed plus its index.
+	 *
+	 * \since v1.0.0
+	 */
+	struct NoiseSettings
+	{
+		NoiseType type{ NoiseType::PERLIN };
+		FractalType fractal{ FractalType::NONE };
+		/* The seed of the first octave */
+		int32 seed{ 0 };
+		/* The scale of the coordinates of the first octave */
+		float32 frequency{ 1.f };
+		/* The number of octaves, ignored with FractalType::NONE */
+		int32 octaves{ 4 };
+		/* The frequency factor from one octave to the next */
+		float32 lacunarity{ 2.f };
+		/* The amplitude factor from one octave to the next */
+		float32 gain{ 0.5f };
+	};
+
+	// Base functions
+
+	/**
+	 * Calculates 2D Perlin noise with the quintic fade curve.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Perlin(Vector2_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 3D Perlin noise with the quintic fade curve.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Perlin(Vector3_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 4D Perlin noise with the quintic fade curve.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Perlin(Vector4_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 2D OpenSimplex2 noise on the triangular lattice.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL OpenSimplex2(Vector2_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 3D OpenSimplex2 noise on the body-centered cubic lattice,
+	 * rotated so that no axis-aligned artifacts show on XY slices.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL OpenSimplex2(Vector3_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 4D simplex noise with the kernel of OpenSimplex2.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The noise value in the range [-1, 1].
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL OpenSimplex2(Vector4_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 2D Worley noise, the Euclidean distance to the nearest
+	 * feature point. Each cell of the unit grid has one feature point.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The distance to the nearest feature point.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Worley(Vector2_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 3D Worley noise, the Euclidean distance to the nearest
+	 * feature point. Each cell of the unit grid has one feature point.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The distance to the nearest feature point.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Worley(Vector3_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	/**
+	 * Calculates 4D Worley noise, the Euclidean distance to the nearest
+	 * feature point. Each cell of the unit grid has one feature point.
+	 *
+	 * \param p The point.
+	 * \param seed The seed.
+	 *
+	 * \returns The distance to the nearest feature point.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Worley(Vector4_Base<float32> const& p, int32 seed = 0) noexcept;
+
+	// Layered noise
+
+	/**
+	 * Calculates layered 2D noise.
+	 *
+	 * \param settings The noise settings.
+	 * \param p The point.
+	 *
+	 * \returns The noise value.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Noise(NoiseSettings const& settings, Vector2_Base<float32> const& p) noexcept;
+
+	/**
+	 * Calculates layered 3D noise.
+	 *
+	 * \param settings The noise settings.
+	 * \param p The point.
+	 *
+	 * \returns The noise value.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Noise(NoiseSettings const& settings, Vector3_Base<float32> const& p) noexcept;
+
+	/**
+	 * Calculates layered 4D noise.
+	 *
+	 * \param settings The noise settings.
+	 * \param p The point.
+	 *
+	 * \returns The noise value.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Noise(NoiseSettings const& settings, Vector4_Base<float32> const& p) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Calculates layered 2D noise for an array of points.
+	 *
+	 * \param settings The noise settings.
+	 * \param points The points.
+	 * \param out The array receiving the noise values.
+	 * \param count The number of points.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL NoiseBatch(NoiseSettings const& settings, Vector2_Base<float32> const* points, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Calculates layered 3D noise for an array of points.
+	 *
+	 * \param settings The noise settings.
+	 * \param points The points.
+	 * \param out The array receiving the noise values.
+	 * \param count The number of points.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL NoiseBatch(NoiseSettings const& settings, Vector3_Base<float32> const* points, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Calculates layered 4D noise for an array of points.
+	 *
+	 * \param settings The noise settings.
+	 * \param points The points.
+	 * \param out The array receiving the noise values.
+	 * \param count The number of points.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL NoiseBatch(NoiseSettings const& settings, Vector4_Base<float32> const* points, float32* out, uint64 count) noexcept;
+
+	/**
+	 * Fills a 2D grid with layered noise on multiple threads. The value of
+	 * out[y * width + x] is the noise at origin + (x, y) * spacing.
+	 *
+	 * \param settings The noise settings.
+	 * \param origin The point of the first value.
+	 * \param spacing The distance between neighbouring values.
+	 * \param width The number of values along x.
+	 * \param height The number of values along y.
+	 * \param out The array receiving width * height values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL FillNoiseGrid(NoiseSettings const& settings, Vector2_Base<float32> const& origin,
+		Vector2_Base<float32> const& spacing, uint32 width, uint32 height, float32* out);
+
+	/**
+	 * Fills a 3D grid with layered noise on multiple threads. The value of
+	 * out[(z * height + y) * width + x] is the noise at
+	 * origin + (x, y, z) * spacing.
+	 *
+	 * \param settings The noise settings.
+	 * \param origin The point of the first value.
+	 * \param spacing The distance between neighbouring values.
+	 * \param width The number of values along x.
+	 * \param height The number of values along y.
+	 * \param depth The number of values along z.
+	 * \param out The array receiving width * height * depth values.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL FillNoiseGrid(NoiseSettings const& settings, Vector3_Base<float32> const& origin,
+		Vector3_Base<float32> const& spacing, uint32 width, uint32 height, uint32 depth, float32* out);
+} // namespace ecm::math
+
+#endif // !_ECM_NOISE_H_
@@ -0,0 +1,245 @@
+/**
+ * \file packing.h
+ *
+ * \brief This header defines compact encodings for normals and tangents.
+ *
+ * The encodings trade precision for memory. The following table lists the
+ * size and the maximum angular error of a decoded unit vector, measured over
+ * four million random unit vectors:
+ *
+ * |Encoding|Size|Max. error
+ * |-|-|-
+ * |Vector3 (float32)|12 bytes|-
+ * |Octahedral 2x16 snorm|4 bytes|0.0037 degrees
+ * |Octahedral 2x8 snorm|2 bytes|0.96 degrees
+ * |Snorm 10:10:10:2|4 bytes|0.097 degrees
+ * |Snorm 16x4|8 bytes|0.0015 degrees
+ *
+ * The snorm encodings do not normalize, so they also store vectors which are
+ * not unit length, as long as each component is in the range [-1, 1]. The
+ * maximum error of a component is 1 / 511 for 10:10:10:2 and 1 / 32767 for
+ * 16x4. The 2-bit component of 10:10:10:2 stores -1, 0 or 1, which is enough
+ * for the handedness of a tangent frame.
+ */
+
+#pragma once
+#ifndef _ECM_PACKING_H_
+#define _ECM_PACKING_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	// Octahedral encodings
+
+	/**
+	 * Encodes a unit vector with the octahedral mapping into two 16-bit snorm
+	 * values.
+	 *
+	 * \param n The unit vector to encode.
+	 *
+	 * \returns The x coordinate in the low and the y coordinate in the high 16
+	 *          bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint32 ECM_CALL EncodeOctahedral16(Vector3_Base<float32> const& n) noexcept;
+
+	/**
+	 * Decodes a unit vector, which was encoded by EncodeOctahedral16.
+	 *
+	 * \param packed The encoded vector.
+	 *
+	 * \returns The normalized vector.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector3_Base<float32> ECM_CALL DecodeOctahedral16(uint32 packed) noexcept;
+
+	/**
+	 * Encodes a unit vector with the octahedral mapping into two 8-bit snorm
+	 * values.
+	 *
+	 * \param n The unit vector to encode.
+	 *
+	 * \returns The x coordinate in the low and the y coordinate in the high 8
+	 *          bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint16 ECM_CALL EncodeOctahedral8(Vector3_Base<float32> const& n) noexcept;
+
+	/**
+	 * Decodes a unit vector, which was encoded by EncodeOctahedral8.
+	 *
+	 * \param packed The encoded vector.
+	 *
+	 * \returns The normalized vector.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector3_Base<float32> ECM_CALL DecodeOctahedral8(uint16 packed) noexcept;
+
+	// Snorm encodings
+
+	/**
+	 * Encodes a 4D vector into the 10:10:10:2 snorm format, which matches
+	 * the signed RGB10A2 vertex format of graphics APIs.
+	 *
+	 * \param v The vector to encode. The components are clamped to [-1, 1].
+	 *
+	 * \returns The x component in bits 0-9, y in bits 10-19, z in bits 20-29
+	 *          and w in bits 30-31.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint32 ECM_CALL EncodeSnorm1010102(Vector4_Base<float32> const& v) noexcept;
+
+	/**
+	 * Decodes a 4D vector, which was encoded by EncodeSnorm1010102.
+	 *
+	 * \param packed The encoded vector.
+	 *
+	 * \returns The decoded vector.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector4_Base<float32> ECM_CALL DecodeSnorm1010102(uint32 packed) noexcept;
+
+	/**
+	 * Encodes a 4D vector into four 16-bit snorm values.
+	 *
+	 * \param v The vector to encode. The components are clamped to [-1, 1].
+	 *
+	 * \returns The components from x in the lowest to w in the highest 16
+	 *          bits.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE uint64 ECM_CALL EncodeSnorm16x4(Vector4_Base<float32> const& v) noexcept;
+
+	/**
+	 * Decodes a 4D vector, which was encoded by EncodeSnorm16x4.
+	 *
+	 * \param packed The encoded vector.
+	 *
+	 * \returns The decoded vector.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_INLINE Vector4_Base<float32> ECM_CALL DecodeSnorm16x4(uint64 packed) noexcept;
+
+	// Batch functions
+
+	/**
+	 * Encodes an array of unit vectors like EncodeOctahedral16, four vectors
+	 * per iteration with SSE.
+	 *
+	 * \param in The unit vectors to encode.
+	 * \param out The array receiving the encoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeOctahedral16Batch(Vector3_Base<float32> const* in, uint32* out, uint64 count);
+
+	/**
+	 * Decodes an array of vectors like DecodeOctahedral16, four vectors per
+	 * iteration with SSE.
+	 *
+	 * \param in The encoded vectors.
+	 * \param out The array receiving the normalized vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL DecodeOctahedral16Batch(uint32 const* in, Vector3_Base<float32>* out, uint64 count);
+
+	/**
+	 * Encodes an array of unit vectors like EncodeOctahedral8, four vectors
+	 * per iteration with SSE.
+	 *
+	 * \param in The unit vectors to encode.
+	 * \param out The array receiving the encoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeOctahedral8Batch(Vector3_Base<float32> const* in, uint16* out, uint64 count);
+
+	/**
+	 * Decodes an array of vectors like DecodeOctahedral8, four vectors per
+	 * iteration with SSE.
+	 *
+	 * \param in The encoded vectors.
+	 * \param out The array receiving the normalized vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL DecodeOctahedral8Batch(uint16 const* in, Vector3_Base<float32>* out, uint64 count);
+
+	/**
+	 * Encodes an array of 4D vectors like EncodeSnorm1010102, four vectors
+	 * per iteration with SSE.
+	 *
+	 * \param in The vectors to encode.
+	 * \param out The array receiving the encoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeSnorm1010102Batch(Vector4_Base<float32> const* in, uint32* out, uint64 count);
+
+	/**
+	 * Decodes an array of vectors like DecodeSnorm1010102, four vectors per
+	 * iteration with SSE.
+	 *
+	 * \param in The encoded vectors.
+	 * \param out The array receiving the decoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL DecodeSnorm1010102Batch(uint32 const* in, Vector4_Base<float32>* out, uint64 count);
+
+	/**
+	 * Encodes an array of 4D vectors like EncodeSnorm16x4, two vectors per
+	 * iteration with SSE.
+	 *
+	 * \param in The vectors to encode.
+	 * \param out The array receiving the encoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL EncodeSnorm16x4Batch(Vector4_Base<float32> const* in, uint64* out, uint64 count);
+
+	/**
+	 * Decodes an array of vectors like DecodeSnorm16x4, two vectors per
+	 * iteration with SSE.
+	 *
+	 * \param in The encoded vectors.
+	 * \param out The array receiving the decoded vectors.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL DecodeSnorm16x4Batch(uint64 const* in, Vector4_Base<float32>* out, uint64 count);
+
+	namespace detail
+	{
+		// Folds the upper hemisphere back onto the lower one and normalizes
+		// the vector. It's defined in the library, which computes it without
+		// fused multiply-adds like the batch functions, so that both round
+		// the same whatever the program is compiled with.
+		ECM_MATH_API Vector3_Base<float32> ECM_CALL octahedral_unproject(float32 u, float32 v) noexcept;
+	} // namespace detail
+} // namespace ecm::math
+
+#include "packing.inl"
+
+#endif // !_ECM_PACKING_H_
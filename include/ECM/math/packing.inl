@@ -0,0 +1,122 @@
+#pragma once
+
+#include <ECM/math/packing.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// Converts a value in [-1, 1] to a signed integer with the given
+		// maximum, rounding to the nearest integer.
+		inline int32 to_snorm(float32 v, float32 max) noexcept
+		{
+			v = v < -1.f ? -1.f : (v > 1.f ? 1.f : v);
+			return static_cast<int32>(std::lrint(v * max));
+		}
+
+		// Converts a signed integer with the given maximum to [-1, 1].
+		inline float32 from_snorm(int32 v, float32 max) noexcept
+		{
+			const float32 f{ static_cast<float32>(v) / max };
+			return f < -1.f ? -1.f : f;
+		}
+
+		// Projects a unit vector onto the octahedron and unfolds the lower
+		// hemisphere onto the square [-1, 1]^2.
+		inline void octahedral_project(Vector3_Base<float32> const& n, float32& u, float32& v) noexcept
+		{
+			const float32 invL1{ 1.f / (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z)) };
+			u = n.x * invL1;
+			v = n.y * invL1;
+			if (n.z < 0.f) {
+				const float32 foldU{ (1.f - std::fabs(v)) * (u >= 0.f ? 1.f : -1.f) };
+				const float32 foldV{ (1.f - std::fabs(u)) * (v >= 0.f ? 1.f : -1.f) };
+				u = foldU;
+				v = foldV;
+			}
+		}
+	} // namespace detail
+
+	// Octahedral encodings
+
+	uint32 EncodeOctahedral16(Vector3_Base<float32> const& n) noexcept
+	{
+		float32 u{ 0.f };
+		float32 v{ 0.f };
+		detail::octahedral_project(n, u, v);
+		const uint32 x{ static_cast<uint32>(detail::to_snorm(u, 32767.f)) & 0xffffu };
+		const uint32 y{ static_cast<uint32>(detail::to_snorm(v, 32767.f)) & 0xffffu };
+		return x | (y << 16);
+	}
+
+	Vector3_Base<float32> DecodeOctahedral16(uint32 packed) noexcept
+	{
+		const int32 x{ static_cast<int16>(packed & 0xffffu) };
+		const int32 y{ static_cast<int16>(packed >> 16) };
+		return detail::octahedral_unproject(
+			detail::from_snorm(x, 32767.f), detail::from_snorm(y, 32767.f));
+	}
+
+	uint16 EncodeOctahedral8(Vector3_Base<float32> const& n) noexcept
+	{
+		float32 u{ 0.f };
+		float32 v{ 0.f };
+		detail::octahedral_project(n, u, v);
+		const uint32 x{ static_cast<uint32>(detail::to_snorm(u, 127.f)) & 0xffu };
+		const uint32 y{ static_cast<uint32>(detail::to_snorm(v, 127.f)) & 0xffu };
+		return static_cast<uint16>(x | (y << 8));
+	}
+
+	Vector3_Base<float32> DecodeOctahedral8(uint16 packed) noexcept
+	{
+		const int32 x{ static_cast<signed char>(packed & 0xffu) };
+		const int32 y{ static_cast<signed char>(packed >> 8) };
+		return detail::octahedral_unproject(
+			detail::from_snorm(x, 127.f), detail::from_snorm(y, 127.f));
+	}
+
+	// Snorm encodings
+
+	uint32 EncodeSnorm1010102(Vector4_Base<float32> const& v) noexcept
+	{
+		const uint32 x{ static_cast<uint32>(detail::to_snorm(v.x, 511.f)) & 0x3ffu };
+		const uint32 y{ static_cast<uint32>(detail::to_snorm(v.y, 511.f)) & 0x3ffu };
+		const uint32 z{ static_cast<uint32>(detail::to_snorm(v.z, 511.f)) & 0x3ffu };
+		const uint32 w{ static_cast<uint32>(detail::to_snorm(v.w, 1.f)) & 0x3u };
+		return x | (y << 10) | (z << 20) | (w << 30);
+	}
+
+	Vector4_Base<float32> DecodeSnorm1010102(uint32 packed) noexcept
+	{
+		// Shifting the field to the top and back sign extends it
+		const int32 x{ static_cast<int32>(packed << 22) >> 22 };
+		const int32 y{ static_cast<int32>(packed << 12) >> 22 };
+		const int32 z{ static_cast<int32>(packed << 2) >> 22 };
+		const int32 w{ static_cast<int32>(packed) >> 30 };
+		return Vector4_Base<float32>(
+			detail::from_snorm(x, 511.f),
+			detail::from_snorm(y, 511.f),
+			detail::from_snorm(z, 511.f),
+			detail::from_snorm(w, 1.f));
+	}
+
+	uint64 EncodeSnorm16x4(Vector4_Base<float32> const& v) noexcept
+	{
+		const uint64 x{ static_cast<uint64>(detail::to_snorm(v.x, 32767.f)) & 0xffffu };
+		const uint64 y{ static_cast<uint64>(detail::to_snorm(v.y, 32767.f)) & 0xffffu };
+		const uint64 z{ static_cast<uint64>(detail::to_snorm(v.z, 32767.f)) & 0xffffu };
+		const uint64 w{ static_cast<uint64>(detail::to_snorm(v.w, 32767.f)) & 0xffffu };
+		return x | (y << 16) | (z << 32) | (w << 48);
+	}
+
+	Vector4_Base<float32> DecodeSnorm16x4(uint64 packed) noexcept
+	{
+		return Vector4_Base<float32>(
+			detail::from_snorm(static_cast<int16>(packed & 0xffffu), 32767.f),
+			detail::from_snorm(static_cast<int16>((packed >> 16) & 0xffffu), 32767.f),
+			detail::from_snorm(static_cast<int16>((packed >> 32) & 0xffffu), 32767.f),
+			detail::from_snorm(static_cast<int16>(packed >> 48), 32767.f));
+	}
+} // namespace ecm::math
@@ -0,0 +1,78 @@
+/**
+ * \file parallel.h
+ *
+ * \brief This header defines functions running loops on multiple threads.
+ *
+ * The loops run on a pool of worker threads, which is created on the first
+ * use and shared by the whole math module. The calling thread takes part in
+ * the work, so a pool of n workers runs n + 1 chunks at a time.
+ */
+
+#pragma once
+#ifndef _ECM_PARALLEL_H_
+#define _ECM_PARALLEL_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+namespace ecm::math
+{
+	/**
+	 * Returns the number of threads, which run the chunks of ParallelFor.
+	 * This is the number of hardware threads, including the calling thread.
+	 *
+	 * \returns The number of threads.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL GetParallelThreadCount() noexcept;
+
+	/**
+	 * Calls a function for chunks of the range [begin, end) on multiple
+	 * threads, and returns after all chunks are done.
+	 *
+	 * The chunks start at begin + n * grain and have grain iterations, except
+	 * the last one. Their boundaries don't depend on the number of threads,
+	 * so results, which are stored per chunk, are deterministic.
+	 *
+	 * ParallelFor runs serially, if it's called from a function of another
+	 * ParallelFor, or while another thread uses the pool. The function must
+	 * not throw exceptions.
+	 *
+	 * \param begin The first index.
+	 * \param end The index after the last one.
+	 * \param grain The number of iterations of a chunk.
+	 * \param function The function to call with the range of a chunk, as
+	 *        function(uint64 chunkBegin, uint64 chunkEnd).
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Function>
+	void ECM_CALL ParallelFor(uint64 begin, uint64 end, uint64 grain, Function&& function);
+
+	/**
+	 * Calls a function for chunks of the range [begin, end) on multiple
+	 * threads, and returns after all chunks are done. The chunks are sized
+	 * for the number of threads, so their boundaries are not deterministic.
+	 *
+	 * \param begin The first index.
+	 * \param end The index after the last one.
+	 * \param function The function to call with the range of a chunk, as
+	 *        function(uint64 chunkBegin, uint64 chunkEnd).
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Function>
+	void ECM_CALL ParallelFor(uint64 begin, uint64 end, Function&& function);
+
+	namespace detail
+	{
+		typedef void (*parallel_task)(void* context, uint64 begin, uint64 end);
+
+		ECM_MATH_API void ECM_CALL parallel_for(uint64 begin, uint64 end, uint64 grain, parallel_task task, void* context);
+	} // namespace detail
+} // namespace ecm::math
+
+#include "parallel.inl"
+
+#endif // !_ECM_PARALLEL_H_
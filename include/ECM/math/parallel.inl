@@ -0,0 +1,36 @@
+#pragma once
+
+#include <ECM/math/parallel.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace ecm::math
+{
+	template<typename Function>
+	void ParallelFor(uint64 begin, uint64 end, uint64 grain, Function&& function)
+	{
+		if (end <= begin)
+			return;
+		if (grain == 0)
+			grain = 1;
+		if (end - begin <= grain) {
+			function(begin, end);
+			return;
+		}
+		using function_type = std::remove_reference_t<Function>;
+		detail::parallel_for(begin, end, grain, [](void* context, uint64 chunkBegin, uint64 chunkEnd) {
+			(*static_cast<function_type*>(context))(chunkBegin, chunkEnd);
+		}, const_cast<void*>(static_cast<void const*>(&function)));
+	}
+
+	template<typename Function>
+	void ParallelFor(uint64 begin, uint64 end, Function&& function)
+	{
+		if (end <= begin)
+			return;
+		// Four chunks per thread balance uneven chunks
+		const uint64 chunks{ static_cast<uint64>(GetParallelThreadCount()) * 4 };
+		ParallelFor(begin, end, (end - begin + chunks - 1) / chunks, std::forward<Function>(function));
+	}
+} // namespace ecm::math
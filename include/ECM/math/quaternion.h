@@ -0,0 +1,350 @@
+/**
+ * \file quaternion.h
+ *
+ * \brief This header defines a quaternion for rotations and functionalities.
+ *
+ * Quaternions store the vector part in x, y and z and the scalar part in w.
+ * A rotation by the angle a around the unit axis n is
+ * (n * sin(a / 2), cos(a / 2)). The product q1 * q2 rotates by q2 first and
+ * by q1 after it.
+ */
+
+#pragma once
+#ifndef _ECM_QUATERNION_H_
+#define _ECM_QUATERNION_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a quaternion template.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct Quaternion_Base
+	{
+		typedef T value_type;
+		typedef Quaternion_Base<T> type;
+
+		union
+		{
+			struct
+			{
+				// X component of the vector part
+				T x;
+				// Y component of the vector part
+				T y;
+				// Z component of the vector part
+				T z;
+				// Scalar part
+				T w;
+			};
+			T coord[4];
+		};
+
+		// Basic constructors
+
+		/**
+		 * Default constructor, which creates the identity rotation.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Quaternion_Base();
+
+		/**
+		 * Copy constructor initializing from another quaternion.
+		 *
+		 * \param q The quaternion to copy from.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Quaternion_Base(Quaternion_Base<T> const& q);
+
+		/**
+		 * Constructor initializing with the components.
+		 *
+		 * \param x The x component of the vector part.
+		 * \param y The y component of the vector part.
+		 * \param z The z component of the vector part.
+		 * \param w The scalar part.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Quaternion_Base(T x, T y, T z, T w);
+
+		/**
+		 * Constructor initializing from a 4D vector with the components
+		 * (x, y, z, w).
+		 *
+		 * \param v The vector.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit constexpr Quaternion_Base(Vector4_Base<T> const& v);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * \param q The quaternion to assign from.
+		 *
+		 * \returns A reference to this quaternion after assignment.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Quaternion_Base<T>& operator=(Quaternion_Base<T> const& q);
+
+		/**
+		 * Subscript operator to access the components.
+		 *
+		 * \param i The index of the component, 3 for w.
+		 *
+		 * \returns The component.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T& operator[](const uint8 i);
+
+		/**
+		 * Subscript operator to access the components.
+		 *
+		 * \param i The index of the component, 3 for w.
+		 *
+		 * \returns The component.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr T const& operator[](const uint8 i) const;
+	};
+
+	// Comparison operators
+
+	/**
+	 * This operator checks if the two quaternions are the same.
+	 *
+	 * \param q1 Left operand.
+	 * \param q2 Right operand.
+	 *
+	 * \returns true if all components are equal, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator==(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2);
+
+	/**
+	 * This operator checks if the two quaternions are not the same.
+	 *
+	 * \param q1 Left operand.
+	 * \param q2 Right operand.
+	 *
+	 * \returns true if a component differs, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator!=(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2);
+
+	// Arithmetic operators
+
+	/**
+	 * Negates all components. The result is the same rotation.
+	 *
+	 * \param q The quaternion.
+	 *
+	 * \returns The negated quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Quaternion_Base<T> operator-(Quaternion_Base<T> const& q);
+
+	/**
+	 * Adds two quaternions component-wise.
+	 *
+	 * \param q1 Left operand.
+	 * \param q2 Right operand.
+	 *
+	 * \returns The sum.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Quaternion_Base<T> operator+(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2);
+
+	/**
+	 * Multiplies all components by a scalar.
+	 *
+	 * \param q The quaternion.
+	 * \param scalar The scalar.
+	 *
+	 * \returns The scaled quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Quaternion_Base<T> operator*(Quaternion_Base<T> const& q, T scalar);
+
+	/**
+	 * Calculates the Hamilton product, which rotates by \p q2 first and by
+	 * \p q1 after it.
+	 *
+	 * \param q1 Left operand.
+	 * \param q2 Right operand.
+	 *
+	 * \returns The product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Quaternion_Base<T> operator*(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2);
+
+	// Functions
+
+	/**
+	 * Calculates the dot product of two quaternions.
+	 *
+	 * \param q1 The first quaternion.
+	 * \param q2 The second quaternion.
+	 *
+	 * \returns The dot product.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr T ECM_CALL Dot(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2) noexcept;
+
+	/**
+	 * Scales a quaternion to the length 1.
+	 *
+	 * \param q The quaternion, which must not be 0.
+	 *
+	 * \returns The unit quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Quaternion_Base<T> ECM_CALL Normalize(Quaternion_Base<T> const& q) noexcept;
+
+	/**
+	 * Calculates the conjugate, which is the inverse rotation of a unit
+	 * quaternion.
+	 *
+	 * \param q The quaternion.
+	 *
+	 * \returns The quaternion with the negated vector part.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Quaternion_Base<T> ECM_CALL Conjugate(Quaternion_Base<T> const& q) noexcept;
+
+	/**
+	 * Creates the rotation around an axis.
+	 *
+	 * \param axis The unit axis.
+	 * \param angle The angle in radians.
+	 *
+	 * \returns The unit quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Quaternion_Base<T> ECM_CALL QuaternionFromAxisAngle(Vector3_Base<T> const& axis, T angle) noexcept;
+
+	/**
+	 * Creates the rotation of a rotation matrix.
+	 *
+	 * \param m The matrix, whose columns m[0], m[1] and m[2] are orthonormal.
+	 *
+	 * \returns The unit quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Quaternion_Base<T> ECM_CALL QuaternionFromMatrix(Matrix4x4_Base<T> const& m) noexcept;
+
+	/**
+	 * Interpolates linearly along the shorter arc and normalizes the result.
+	 * The angular velocity isn't constant, but the result is close to Slerp
+	 * for the small angles of neighbouring keys and poses.
+	 *
+	 * \param q1 The start rotation.
+	 * \param q2 The end rotation.
+	 * \param t The interpolation factor in the range [0, 1].
+	 *
+	 * \returns The unit quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Quaternion_Base<T> ECM_CALL Nlerp(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2, T t) noexcept;
+
+	/**
+	 * Interpolates spherically along the shorter arc with constant angular
+	 * velocity. Nearly equal rotations fall back to Nlerp.
+	 *
+	 * \param q1 The start rotation.
+	 * \param q2 The end rotation.
+	 * \param t The interpolation factor in the range [0, 1].
+	 *
+	 * \returns The unit quaternion.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD Quaternion_Base<T> ECM_CALL Slerp(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2, T t) noexcept;
+
+	/**
+	 * Rotates a vector by a unit quaternion.
+	 *
+	 * \param q The rotation.
+	 * \param v The vector.
+	 *
+	 * \returns The rotated vector.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL Rotate(Quaternion_Base<T> const& q, Vector3_Base<T> const& v) noexcept;
+
+	/**
+	 * Converts a unit quaternion to a rotation matrix. The columns m[0],
+	 * m[1] and m[2] are the rotated axes, so m * v rotates the column
+	 * vector v.
+	 *
+	 * \param q The rotation.
+	 *
+	 * \returns The rotation matrix.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Matrix4x4_Base<T> ECM_CALL ToMatrix(Quaternion_Base<T> const& q) noexcept;
+
+	/**
+	 * A rotation with single-precision floating-point components.
+	 *
+	 * \since v1.0.0
+	 */
+	using Quaternion = Quaternion_Base<float32>;
+
+	/**
+	 * A rotation with single-precision floating-point components and 16-byte
+	 * alignment.
+	 *
+	 * \note Requires SIMD alignment for efficient vectorized operations.
+	 *
+	 * \since v1.0.0
+	 */
+	using QuaternionA = ECM_ALIGN(16) Quaternion;
+} // namespace ecm::math
+
+#include "quaternion.inl"
+
+#endif // !_ECM_QUATERNION_H_
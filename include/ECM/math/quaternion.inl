@@ -0,0 +1,213 @@
+#pragma once
+
+#include <ECM/math/quaternion.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		// Above this cosine of the half angle, Slerp's sine is too close to
+		// 0 to divide by it
+		inline constexpr float64 slerp_nlerp_threshold{ 0.9995 };
+	} // namespace detail
+
+	// Basic constructors
+
+	template<typename T>
+	constexpr Quaternion_Base<T>::Quaternion_Base()
+		: x(0), y(0), z(0), w(1)
+	{}
+
+	template<typename T>
+	constexpr Quaternion_Base<T>::Quaternion_Base(Quaternion_Base<T> const& q)
+		: x(q.x), y(q.y), z(q.z), w(q.w)
+	{}
+
+	template<typename T>
+	constexpr Quaternion_Base<T>::Quaternion_Base(T x, T y, T z, T w)
+		: x(x), y(y), z(z), w(w)
+	{}
+
+	template<typename T>
+	constexpr Quaternion_Base<T>::Quaternion_Base(Vector4_Base<T> const& v)
+		: x(v.x), y(v.y), z(v.z), w(v.w)
+	{}
+
+	template<typename T>
+	constexpr Quaternion_Base<T>& Quaternion_Base<T>::operator=(Quaternion_Base<T> const& q)
+	{
+		x = q.x;
+		y = q.y;
+		z = q.z;
+		w = q.w;
+		return *this;
+	}
+
+	template<typename T>
+	constexpr T& Quaternion_Base<T>::operator[](const uint8 i)
+	{
+		return coord[i];
+	}
+
+	template<typename T>
+	constexpr T const& Quaternion_Base<T>::operator[](const uint8 i) const
+	{
+		return coord[i];
+	}
+
+	// Comparison operators
+
+	template<typename T>
+	constexpr bool operator==(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2)
+	{
+		return q1.x == q2.x && q1.y == q2.y && q1.z == q2.z && q1.w == q2.w;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2)
+	{
+		return !(q1 == q2);
+	}
+
+	// Arithmetic operators
+
+	template<typename T>
+	constexpr Quaternion_Base<T> operator-(Quaternion_Base<T> const& q)
+	{
+		return Quaternion_Base<T>(-q.x, -q.y, -q.z, -q.w);
+	}
+
+	template<typename T>
+	constexpr Quaternion_Base<T> operator+(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2)
+	{
+		return Quaternion_Base<T>(q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w);
+	}
+
+	template<typename T>
+	constexpr Quaternion_Base<T> operator*(Quaternion_Base<T> const& q, T scalar)
+	{
+		return Quaternion_Base<T>(q.x * scalar, q.y * scalar, q.z * scalar, q.w * scalar);
+	}
+
+	template<typename T>
+	constexpr Quaternion_Base<T> operator*(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2)
+	{
+		return Quaternion_Base<T>(
+			q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+			q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+			q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+			q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z);
+	}
+
+	// Functions
+
+	template<typename T>
+	constexpr T Dot(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2) noexcept
+	{
+		return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+	}
+
+	template<typename T>
+	Quaternion_Base<T> Normalize(Quaternion_Base<T> const& q) noexcept
+	{
+		const T length{ static_cast<T>(std::sqrt(Dot(q, q))) };
+		return Quaternion_Base<T>(q.x / length, q.y / length, q.z / length, q.w / length);
+	}
+
+	template<typename T>
+	constexpr Quaternion_Base<T> Conjugate(Quaternion_Base<T> const& q) noexcept
+	{
+		return Quaternion_Base<T>(-q.x, -q.y, -q.z, q.w);
+	}
+
+	template<typename T>
+	Quaternion_Base<T> QuaternionFromAxisAngle(Vector3_Base<T> const& axis, T angle) noexcept
+	{
+		const T s{ static_cast<T>(std::sin(angle * T(0.5))) };
+		return Quaternion_Base<T>(axis.x * s, axis.y * s, axis.z * s, static_cast<T>(std::cos(angle * T(0.5))));
+	}
+
+	template<typename T>
+	Quaternion_Base<T> QuaternionFromMatrix(Matrix4x4_Base<T> const& m) noexcept
+	{
+		// The element of row r and column c is m.matrix[c][r]. The largest of
+		// w, x, y and z is calculated from the diagonal, and divides the
+		// others.
+		auto const& a{ m.matrix };
+		const T trace{ a[0][0] + a[1][1] + a[2][2] };
+		if (trace > T(0)) {
+			const T s{ static_cast<T>(std::sqrt(trace + T(1))) * T(2) };
+			return Quaternion_Base<T>((a[1][2] - a[2][1]) / s, (a[2][0] - a[0][2]) / s, (a[0][1] - a[1][0]) / s, s / T(4));
+		}
+		if (a[0][0] > a[1][1] && a[0][0] > a[2][2]) {
+			const T s{ static_cast<T>(std::sqrt(T(1) + a[0][0] - a[1][1] - a[2][2])) * T(2) };
+			return Quaternion_Base<T>(s / T(4), (a[1][0] + a[0][1]) / s, (a[2][0] + a[0][2]) / s, (a[1][2] - a[2][1]) / s);
+		}
+		if (a[1][1] > a[2][2]) {
+			const T s{ static_cast<T>(std::sqrt(T(1) + a[1][1] - a[0][0] - a[2][2])) * T(2) };
+			return Quaternion_Base<T>((a[1][0] + a[0][1]) / s, s / T(4), (a[2][1] + a[1][2]) / s, (a[2][0] - a[0][2]) / s);
+		}
+		const T s{ static_cast<T>(std::sqrt(T(1) + a[2][2] - a[0][0] - a[1][1])) * T(2) };
+		return Quaternion_Base<T>((a[2][0] + a[0][2]) / s, (a[2][1] + a[1][2]) / s, s / T(4), (a[0][1] - a[1][0]) / s);
+	}
+
+	template<typename T>
+	Quaternion_Base<T> Nlerp(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2, T t) noexcept
+	{
+		// q and -q are the same rotation, the sign picks the shorter arc
+		const T sign{ Dot(q1, q2) < T(0) ? T(-1) : T(1) };
+		const T s{ T(1) - t };
+		const T u{ t * sign };
+		return Normalize(Quaternion_Base<T>(q1.x * s + q2.x * u, q1.y * s + q2.y * u,
+			q1.z * s + q2.z * u, q1.w * s + q2.w * u));
+	}
+
+	template<typename T>
+	Quaternion_Base<T> Slerp(Quaternion_Base<T> const& q1, Quaternion_Base<T> const& q2, T t) noexcept
+	{
+		T cosine{ Dot(q1, q2) };
+		const T sign{ cosine < T(0) ? T(-1) : T(1) };
+		cosine *= sign;
+		if (cosine > static_cast<T>(detail::slerp_nlerp_threshold))
+			return Nlerp(q1, q2, t);
+		const T angle{ static_cast<T>(std::acos(cosine)) };
+		const T sine{ static_cast<T>(std::sin(angle)) };
+		const T s{ static_cast<T>(std::sin((T(1) - t) * angle)) / sine };
+		const T u{ static_cast<T>(std::sin(t * angle)) / sine * sign };
+		return Quaternion_Base<T>(q1.x * s + q2.x * u, q1.y * s + q2.y * u, q1.z * s + q2.z * u, q1.w * s + q2.w * u);
+	}
+
+	template<typename T>
+	constexpr Vector3_Base<T> Rotate(Quaternion_Base<T> const& q, Vector3_Base<T> const& v) noexcept
+	{
+		// v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v)
+		const T tx{ T(2) * (q.y * v.z - q.z * v.y) };
+		const T ty{ T(2) * (q.z * v.x - q.x * v.z) };
+		const T tz{ T(2) * (q.x * v.y - q.y * v.x) };
+		return Vector3_Base<T>(
+			v.x + q.w * tx + (q.y * tz - q.z * ty),
+			v.y + q.w * ty + (q.z * tx - q.x * tz),
+			v.z + q.w * tz + (q.x * ty - q.y * tx));
+	}
+
+	template<typename T>
+	constexpr Matrix4x4_Base<T> ToMatrix(Quaternion_Base<T> const& q) noexcept
+	{
+		const T xx{ q.x * q.x };
+		const T yy{ q.y * q.y };
+		const T zz{ q.z * q.z };
+		const T xy{ q.x * q.y };
+		const T xz{ q.x * q.z };
+		const T yz{ q.y * q.z };
+		const T wx{ q.w * q.x };
+		const T wy{ q.w * q.y };
+		const T wz{ q.w * q.z };
+		return Matrix4x4_Base<T>(
+			Vector4_Base<T>(T(1) - T(2) * (yy + zz), T(2) * (xy + wz), T(2) * (xz - wy), T(0)),
+			Vector4_Base<T>(T(2) * (xy - wz), T(1) - T(2) * (xx + zz), T(2) * (yz + wx), T(0)),
+			Vector4_Base<T>(T(2) * (xz + wy), T(2) * (yz - wx), T(1) - T(2) * (xx + yy), T(0)),
+			Vector4_Base<T>(T(0), T(0), T(0), T(1)));
+	}
+} // namespace ecm::math
@@ -0,0 +1,515 @@
+/**
+ * \file random.h
+ *
+ * \brief This header defines random number generators and functions filling
+ *        arrays with random numbers.
+ *
+ * The generators are small, fast and not cryptographically secure. All of
+ * them satisfy the UniformRandomBitGenerator requirements, so they also work
+ * with the distributions of the standard library.
+ *
+ * The Fill functions take any generator with a Fill(uint32*, uint64) member
+ * function. They are fastest with the SIMD generators Pcg32x8 and
+ * Xoshiro256ppx4, which produce eight 32-bit values per step.
+ */
+
+#pragma once
+#ifndef _ECM_RANDOM_H_
+#define _ECM_RANDOM_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector2.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a PCG32 generator (PCG-XSH-RR), with 64 bits
+	 * of state and a period of 2^64.
+	 *
+	 * Generators with different streams produce independent sequences, even
+	 * with the same seed.
+	 *
+	 * \since v1.0.0
+	 */
+	struct Pcg32
+	{
+		typedef uint32 result_type;
+
+		/**
+		 * Default constructor, seeding with a fixed value.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Pcg32() noexcept;
+
+		/**
+		 * Constructor seeding the generator.
+		 *
+		 * \param seed The seed.
+		 * \param stream The stream selecting one of 2^63 sequences.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr explicit Pcg32(uint64 seed, uint64 stream = 0) noexcept;
+
+		/**
+		 * Returns the smallest value the generator produces.
+		 *
+		 * \returns 0.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL min() noexcept;
+
+		/**
+		 * Returns the largest value the generator produces.
+		 *
+		 * \returns 2^32 - 1.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL max() noexcept;
+
+		/**
+		 * Generates the next random value.
+		 *
+		 * \returns The random value.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr result_type operator()() noexcept;
+
+		/**
+		 * Advances the generator as if delta values had been generated, in
+		 * O(log delta) steps.
+		 *
+		 * \param delta The number of values to skip.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr void Advance(uint64 delta) noexcept;
+
+		/**
+		 * Fills an array with random values.
+		 *
+		 * \param out The array to fill.
+		 * \param count The number of values.
+		 *
+		 * \since v1.0.0
+		 */
+		void Fill(uint32* out, uint64 count) noexcept;
+	private:
+		uint64 _state;
+		uint64 _inc;
+	};
+
+	/**
+	 * This structure represents a xoshiro256++ generator, with 256 bits of
+	 * state and a period of 2^256 - 1.
+	 *
+	 * Independent sequences for multiple threads are created by copying a
+	 * generator and calling Jump on each copy a different number of times.
+	 *
+	 * \since v1.0.0
+	 */
+	struct Xoshiro256pp
+	{
+		typedef uint64 result_type;
+
+		/**
+		 * Default constructor, seeding with a fixed value.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Xoshiro256pp() noexcept;
+
+		/**
+		 * Constructor seeding the generator. The state is initialized with
+		 * the SplitMix64 generator, so that similar seeds give unrelated
+		 * sequences.
+		 *
+		 * \param seed The seed.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr explicit Xoshiro256pp(uint64 seed) noexcept;
+
+		/**
+		 * Returns the smallest value the generator produces.
+		 *
+		 * \returns 0.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL min() noexcept;
+
+		/**
+		 * Returns the largest value the generator produces.
+		 *
+		 * \returns 2^64 - 1.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL max() noexcept;
+
+		/**
+		 * Generates the next random value.
+		 *
+		 * \returns The random value.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr result_type operator()() noexcept;
+
+		/**
+		 * Advances the generator by 2^128 values. This creates up to 2^128
+		 * non-overlapping sequences.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr void Jump() noexcept;
+
+		/**
+		 * Advances the generator by 2^192 values. This creates up to 2^64
+		 * starting points, from which Jump creates further sequences.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr void LongJump() noexcept;
+
+		/**
+		 * Fills an array with random values. Each generated 64-bit value
+		 * provides two 32-bit values.
+		 *
+		 * \param out The array to fill.
+		 * \param count The number of values.
+		 *
+		 * \since v1.0.0
+		 */
+		void Fill(uint32* out, uint64 count) noexcept;
+	private:
+		uint64 _state[4];
+	};
+
+	/**
+	 * This structure represents eight PCG32 generators, which run in
+	 * parallel in AVX2 registers.
+	 *
+	 * Lane i is a Pcg32 with the same seed and the stream 8 * stream + i. The
+	 * output is interleaved, so that value 8 * n + i is the n-th value of lane
+	 * i. The results are identical without AVX2.
+	 *
+	 * \since v1.0.0
+	 */
+	struct ECM_MATH_API Pcg32x8
+	{
+		typedef uint32 result_type;
+
+		/**
+		 * Default constructor, seeding with a fixed value.
+		 *
+		 * \since v1.0.0
+		 */
+		Pcg32x8() noexcept;
+
+		/**
+		 * Constructor seeding the generators.
+		 *
+		 * \param seed The seed.
+		 * \param stream The stream selecting eight of 2^63 sequences.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit Pcg32x8(uint64 seed, uint64 stream = 0) noexcept;
+
+		/**
+		 * Returns the smallest value the generator produces.
+		 *
+		 * \returns 0.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL min() noexcept;
+
+		/**
+		 * Returns the largest value the generator produces.
+		 *
+		 * \returns 2^32 - 1.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL max() noexcept;
+
+		/**
+		 * Generates the next random value. This is slow, use Fill instead.
+		 *
+		 * \returns The random value.
+		 *
+		 * \since v1.0.0
+		 */
+		result_type operator()() noexcept;
+
+		/**
+		 * Advances every lane as if delta values had been generated in it.
+		 *
+		 * \param delta The number of values to skip per lane.
+		 *
+		 * \since v1.0.0
+		 */
+		void Advance(uint64 delta) noexcept;
+
+		/**
+		 * Fills an array with random values, eight per step. Values of a
+		 * started step, which are left over, are discarded.
+		 *
+		 * \param out The array to fill.
+		 * \param count The number of values.
+		 *
+		 * \since v1.0.0
+		 */
+		void Fill(uint32* out, uint64 count) noexcept;
+	private:
+		ECM_ALIGN(32) uint64 _state[8];
+		ECM_ALIGN(32) uint64 _inc[8];
+	};
+
+	/**
+	 * This structure represents four xoshiro256++ generators, which run in
+	 * parallel in AVX2 or SSE2 registers.
+	 *
+	 * Lane i starts like a Xoshiro256pp with the same seed, on which Jump
+	 * was called i times, so the lanes never overlap. The output is
+	 * interleaved, so that values 8 * n + 2 * i and 8 * n + 2 * i + 1 are the
+	 * low and high half of the n-th value of lane i. The results are
+	 * identical without AVX2.
+	 *
+	 * \since v1.0.0
+	 */
+	struct ECM_MATH_API Xoshiro256ppx4
+	{
+		typedef uint32 result_type;
+
+		/**
+		 * Default constructor, seeding with a fixed value.
+		 *
+		 * \since v1.0.0
+		 */
+		Xoshiro256ppx4() noexcept;
+
+		/**
+		 * Constructor seeding the generators.
+		 *
+		 * \param seed The seed.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit Xoshiro256ppx4(uint64 seed) noexcept;
+
+		/**
+		 * Returns the smallest value the generator produces.
+		 *
+		 * \returns 0.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL min() noexcept;
+
+		/**
+		 * Returns the largest value the generator produces.
+		 *
+		 * \returns 2^32 - 1.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD static constexpr result_type ECM_CALL max() noexcept;
+
+		/**
+		 * Generates the next random value. This is slow, use Fill instead.
+		 *
+		 * \returns The random value.
+		 *
+		 * \since v1.0.0
+		 */
+		result_type operator()() noexcept;
+
+		/**
+		 * Advances every lane by 4 * 2^128 values, which skips the
+		 * sequences of all four lanes. Calling this on copies of a generator
+		 * creates non-overlapping generators for multiple threads.
+		 *
+		 * \since v1.0.0
+		 */
+		void Jump() noexcept;
+
+		/**
+		 * Advances every lane by 2^192 values.
+		 *
+		 * \since v1.0.0
+		 */
+		void LongJump() noexcept;
+
+		/**
+		 * Fills an array with random values, eight per step. Values of a
+		 * started step, which are left over, are discarded.
+		 *
+		 * \param out The array to fill.
+		 * \param count The number of values.
+		 *
+		 * \since v1.0.0
+		 */
+		void Fill(uint32* out, uint64 count) noexcept;
+	private:
+		// The state words in SoA layout: _state[word][lane]
+		ECM_ALIGN(32) uint64 _state[4][4];
+	};
+
+	// Fill functions
+
+	/**
+	 * Fills an array with uniformly distributed 32-bit values.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of values.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUniform(Generator& rng, uint32* out, uint64 count);
+
+	/**
+	 * Fills an array with uniformly distributed values in [min, max). The
+	 * values have 24 random bits, one for every bit of a float mantissa.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of values.
+	 * \param min The inclusive lower bound.
+	 * \param max The exclusive upper bound.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUniform(Generator& rng, float32* out, uint64 count, float32 min = 0.f, float32 max = 1.f);
+
+	/**
+	 * Fills an array with vectors, which are uniformly distributed in the
+	 * square [min, max)^2.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 * \param min The inclusive lower bound of each component.
+	 * \param max The exclusive upper bound of each component.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUniform(Generator& rng, Vector2_Base<float32>* out, uint64 count, float32 min = 0.f, float32 max = 1.f);
+
+	/**
+	 * Fills an array with vectors, which are uniformly distributed in the
+	 * cube [min, max)^3.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 * \param min The inclusive lower bound of each component.
+	 * \param max The exclusive upper bound of each component.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUniform(Generator& rng, Vector3_Base<float32>* out, uint64 count, float32 min = 0.f, float32 max = 1.f);
+
+	/**
+	 * Fills an array with unit vectors, which are uniformly distributed on
+	 * the unit circle.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUnitCircle(Generator& rng, Vector2_Base<float32>* out, uint64 count);
+
+	/**
+	 * Fills an array with unit vectors, which are uniformly distributed on
+	 * the unit sphere.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillUnitSphere(Generator& rng, Vector3_Base<float32>* out, uint64 count);
+
+	/**
+	 * Fills an array with normally distributed values, using the Ziggurat
+	 * method of Marsaglia and Tsang with 128 layers.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of values.
+	 * \param mean The mean of the distribution.
+	 * \param stddev The standard deviation of the distribution.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillNormal(Generator& rng, float32* out, uint64 count, float32 mean = 0.f, float32 stddev = 1.f);
+
+	/**
+	 * Fills an array with vectors, whose components are normally distributed.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 * \param mean The mean of the distribution.
+	 * \param stddev The standard deviation of the distribution.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillNormal(Generator& rng, Vector2_Base<float32>* out, uint64 count, float32 mean = 0.f, float32 stddev = 1.f);
+
+	/**
+	 * Fills an array with vectors, whose components are normally distributed.
+	 *
+	 * \param rng The generator.
+	 * \param out The array to fill.
+	 * \param count The number of vectors.
+	 * \param mean The mean of the distribution.
+	 * \param stddev The standard deviation of the distribution.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename Generator>
+	void ECM_CALL FillNormal(Generator& rng, Vector3_Base<float32>* out, uint64 count, float32 mean = 0.f, float32 stddev = 1.f);
+
+	namespace detail
+	{
+		// A type-erased generator, so that the fill functions are compiled
+		// once in the library instead of once per generator.
+		struct bit_source
+		{
+			void* generator;
+			void (*fill)(void* generator, uint32* out, uint64 count);
+		};
+
+		ECM_MATH_API void ECM_CALL fill_uniform(bit_source source, float32* out, uint64 count, float32 min, float32 max);
+		ECM_MATH_API void ECM_CALL fill_unit_circle(bit_source source, Vector2_Base<float32>* out, uint64 count);
+		ECM_MATH_API void ECM_CALL fill_unit_sphere(bit_source source, Vector3_Base<float32>* out, uint64 count);
+		ECM_MATH_API void ECM_CALL fill_normal(bit_source source, float32* out, uint64 count, float32 mean, float32 stddev);
+	} // namespace detail
+} // namespace ecm::math
+
+#include "random.inl"
+
+#endif // !_ECM_RANDOM_H_
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <ECM/math/random.h>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		inline constexpr uint64 pcg_multiplier{ 6364136223846793005ull };
+
+		inline constexpr uint64 xoshiro_jump[4]{
+			0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+		inline constexpr uint64 xoshiro_long_jump[4]{
+			0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull };
+
+		constexpr uint32 rotr32(uint32 v, uint32 r) noexcept
+		{
+			return (v >> r) | (v << ((32u - r) & 31u));
+		}
+
+		constexpr uint64 rotl64(uint64 v, uint32 r) noexcept
+		{
+			return (v << r) | (v >> ((64u - r) & 63u));
+		}
+
+		// The PCG-XSH-RR output function of a state.
+		constexpr uint32 pcg_output(uint64 state) noexcept
+		{
+			const uint32 xorshifted{ static_cast<uint32>(((state >> 18u) ^ state) >> 27u) };
+			return rotr32(xorshifted, static_cast<uint32>(state >> 59u));
+		}
+
+		// Advances the LCG of a PCG generator by delta steps, by
+		// accumulating the powers of the step function (Brown, "Random
+		// Number Generation with Arbitrary Strides").
+		constexpr uint64 pcg_advance(uint64 state, uint64 inc, uint64 delta) noexcept
+		{
+			uint64 curMult{ pcg_multiplier };
+			uint64 curPlus{ inc };
+			uint64 accMult{ 1 };
+			uint64 accPlus{ 0 };
+			while (delta > 0) {
+				if (delta & 1) {
+					accMult *= curMult;
+					accPlus = accPlus * curMult + curPlus;
+				}
+				curPlus *= curMult + 1;
+				curMult *= curMult;
+				delta >>= 1;
+			}
+			return accMult * state + accPlus;
+		}
+
+		constexpr uint64 splitmix64(uint64& state) noexcept
+		{
+			uint64 z{ state += 0x9e3779b97f4a7c15ull };
+			z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31u);
+		}
+
+		constexpr uint64 xoshiro_next(uint64 (&s)[4]) noexcept
+		{
+			const uint64 result{ rotl64(s[0] + s[3], 23) + s[0] };
+			const uint64 t{ s[1] << 17u };
+			s[2] ^= s[0];
+			s[3] ^= s[1];
+			s[1] ^= s[2];
+			s[0] ^= s[3];
+			s[2] ^= t;
+			s[3] = rotl64(s[3], 45);
+			return result;
+		}
+
+		constexpr void xoshiro_seed(uint64 (&s)[4], uint64 seed) noexcept
+		{
+			for (uint64& word : s)
+				word = splitmix64(seed);
+		}
+
+		// Advances the state by the polynomial given in the table.
+		constexpr void xoshiro_apply_jump(uint64 (&s)[4], uint64 const (&table)[4]) noexcept
+		{
+			uint64 result[4]{ 0, 0, 0, 0 };
+			for (uint64 bits : table) {
+				for (uint32 b{ 0 }; b < 64; ++b) {
+					if (bits & (1ull << b)) {
+						for (uint32 i{ 0 }; i < 4; ++i)
+							result[i] ^= s[i];
+					}
+					xoshiro_next(s);
+				}
+			}
+			for (uint32 i{ 0 }; i < 4; ++i)
+				s[i] = result[i];
+		}
+
+		template<typename Generator>
+		inline bit_source make_bit_source(Generator& rng) noexcept
+		{
+			return bit_source{ &rng, [](void* generator, uint32* out, uint64 count) {
+				static_cast<Generator*>(generator)->Fill(out, count);
+			} };
+		}
+	} // namespace detail
+
+	// Pcg32
+
+	constexpr Pcg32::Pcg32() noexcept
+		: Pcg32(0x853c49e6748fea9bull, 0)
+	{}
+
+	constexpr Pcg32::Pcg32(uint64 seed, uint64 stream) noexcept
+		: _state{ 0 }, _inc{ (stream << 1u) | 1u }
+	{
+		_state = _state * detail::pcg_multiplier + _inc;
+		_state += seed;
+		_state = _state * detail::pcg_multiplier + _inc;
+	}
+
+	constexpr Pcg32::result_type Pcg32::min() noexcept
+	{
+		return 0;
+	}
+
+	constexpr Pcg32::result_type Pcg32::max() noexcept
+	{
+		return 0xffffffffu;
+	}
+
+	constexpr Pcg32::result_type Pcg32::operator()() noexcept
+	{
+		const uint64 old{ _state };
+		_state = old * detail::pcg_multiplier + _inc;
+		return detail::pcg_output(old);
+	}
+
+	constexpr void Pcg32::Advance(uint64 delta) noexcept
+	{
+		_state = detail::pcg_advance(_state, _inc, delta);
+	}
+
+	inline void Pcg32::Fill(uint32* out, uint64 count) noexcept
+	{
+		uint64 state{ _state };
+		for (uint64 i{ 0 }; i < count; ++i) {
+			out[i] = detail::pcg_output(state);
+			state = state * detail::pcg_multiplier + _inc;
+		}
+		_state = state;
+	}
+
+	// Xoshiro256pp
+
+	constexpr Xoshiro256pp::Xoshiro256pp() noexcept
+		: Xoshiro256pp(0x853c49e6748fea9bull)
+	{}
+
+	constexpr Xoshiro256pp::Xoshiro256pp(uint64 seed) noexcept
+		: _state{ 0, 0, 0, 0 }
+	{
+		detail::xoshiro_seed(_state, seed);
+	}
+
+	constexpr Xoshiro256pp::result_type Xoshiro256pp::min() noexcept
+	{
+		return 0;
+	}
+
+	constexpr Xoshiro256pp::result_type Xoshiro256pp::max() noexcept
+	{
+		return 0xffffffffffffffffull;
+	}
+
+	constexpr Xoshiro256pp::result_type Xoshiro256pp::operator()() noexcept
+	{
+		return detail::xoshiro_next(_state);
+	}
+
+	constexpr void Xoshiro256pp::Jump() noexcept
+	{
+		detail::xoshiro_apply_jump(_state, detail::xoshiro_jump);
+	}
+
+	constexpr void Xoshiro256pp::LongJump() noexcept
+	{
+		detail::xoshiro_apply_jump(_state, detail::xoshiro_long_jump);
+	}
+
+	inline void Xoshiro256pp::Fill(uint32* out, uint64 count) noexcept
+	{
+		uint64 i{ 0 };
+		for (; i + 2 <= count; i += 2) {
+			const uint64 value{ detail::xoshiro_next(_state) };
+			out[i] = static_cast<uint32>(value);
+			out[i + 1] = static_cast<uint32>(value >> 32u);
+		}
+		if (i < count)
+			out[i] = static_cast<uint32>(detail::xoshiro_next(_state));
+	}
+
+	// Pcg32x8 and Xoshiro256ppx4
+
+	constexpr Pcg32x8::result_type Pcg32x8::min() noexcept
+	{
+		return 0;
+	}
+
+	constexpr Pcg32x8::result_type Pcg32x8::max() noexcept
+	{
+		return 0xffffffffu;
+	}
+
+	constexpr Xoshiro256ppx4::result_type Xoshiro256ppx4::min() noexcept
+	{
+		return 0;
+	}
+
+	constexpr Xoshiro256ppx4::result_type Xoshiro256ppx4::max() noexcept
+	{
+		return 0xffffffffu;
+	}
+
+	// Fill functions
+
+	template<typename Generator>
+	void FillUniform(Generator& rng, uint32* out, uint64 count)
+	{
+		rng.Fill(out, count);
+	}
+
+	template<typename Generator>
+	void FillUniform(Generator& rng, float32* out, uint64 count, float32 min, float32 max)
+	{
+		detail::fill_uniform(detail::make_bit_source(rng), out, count, min, max);
+	}
+
+	template<typename Generator>
+	void FillUniform(Generator& rng, Vector2_Base<float32>* out, uint64 count, float32 min, float32 max)
+	{
+		static_assert(sizeof(Vector2_Base<float32>) == 2 * sizeof(float32));
+		detail::fill_uniform(detail::make_bit_source(rng), reinterpret_cast<float32*>(out), count * 2, min, max);
+	}
+
+	template<typename Generator>
+	void FillUniform(Generator& rng, Vector3_Base<float32>* out, uint64 count, float32 min, float32 max)
+	{
+		static_assert(sizeof(Vector3_Base<float32>) == 3 * sizeof(float32));
+		detail::fill_uniform(detail::make_bit_source(rng), reinterpret_cast<float32*>(out), count * 3, min, max);
+	}
+
+	template<typename Generator>
+	void FillUnitCircle(Generator& rng, Vector2_Base<float32>* out, uint64 count)
+	{
+		detail::fill_unit_circle(detail::make_bit_source(rng), out, count);
+	}
+
+	template<typename Generator>
+	void FillUnitSphere(Generator& rng, Vector3_Base<float32>* out, uint64 count)
+	{
+		detail::fill_unit_sphere(detail::make_bit_source(rng), out, count);
+	}
+
+	template<typename Generator>
+	void FillNormal(Generator& rng, float32* out, uint64 count, float32 mean, float32 stddev)
+	{
+		detail::fill_normal(detail::make_bit_source(rng), out, count, mean, stddev);
+	}
+
+	template<typename Generator>
+	void FillNormal(Generator& rng, Vector2_Base<float32>* out, uint64 count, float32 mean, float32 stddev)
+	{
+		static_assert(sizeof(Vector2_Base<float32>) == 2 * sizeof(float32));
+		detail::fill_normal(detail::make_bit_source(rng), reinterpret_cast<float32*>(out), count * 2, mean, stddev);
+	}
+
+	template<typename Generator>
+	void FillNormal(Generator& rng, Vector3_Base<float32>* out, uint64 count, float32 mean, float32 stddev)
+	{
+		static_assert(sizeof(Vector3_Base<float32>) == 3 * sizeof(float32));
+		detail::fill_normal(detail::make_bit_source(rng), reinterpret_cast<float32*>(out), count * 3, mean, stddev);
+	}
+} // namespace ecm::math
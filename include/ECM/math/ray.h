@@ -0,0 +1,352 @@
+/**
+ * \file ray.h
+ *
+ * \brief This header defines rays, ray packets and their intersection with
+ * boxes, triangles and spheres.
+ *
+ * The box test is the slab test with the robust rounding of Ize, which
+ * doesn't miss boxes because of rounding errors, and handles directions with
+ * zero components. The triangle test is either the one of Möller and
+ * Trumbore, or the watertight test of Woop, Benthin and Wald, which never
+ * lets a ray pass between adjacent triangles.
+ *
+ * Ray packets hold four or eight rays in SoA layout. Their functions test
+ * all rays at once with SSE2 or AVX2, and return a mask of the rays, which
+ * hit.
+ */
+
+#pragma once
+#ifndef _ECM_RAY_H_
+#define _ECM_RAY_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/bounds.h>
+#include <ECM/math/vector3.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a ray template. The points of the ray are
+	 * origin + t * direction with t >= 0.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct Ray_Base
+	{
+		typedef T value_type;
+		typedef Ray_Base<T> type;
+
+		// The origin
+		Vector3_Base<T> origin;
+		// The direction, which doesn't need to be normalized
+		Vector3_Base<T> direction;
+
+		// Basic constructors
+
+		/**
+		 * Default constructor, which creates a ray from the origin along
+		 * the z axis.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Ray_Base();
+
+		/**
+		 * Copy constructor initializing from another ray.
+		 *
+		 * \param ray The ray to copy from.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Ray_Base(Ray_Base<T> const& ray);
+
+		/**
+		 * Constructor initializing with the origin and the direction.
+		 *
+		 * \param origin The origin.
+		 * \param direction The direction.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Ray_Base(Vector3_Base<T> const& origin, Vector3_Base<T> const& direction);
+
+		/**
+		 * Assignment operator.
+		 *
+		 * \param ray The ray to assign from.
+		 *
+		 * \returns A reference to this ray after assignment.
+		 *
+		 * \since v1.0.0
+		 */
+		constexpr Ray_Base<T>& operator=(Ray_Base<T> const& ray);
+	};
+
+	/**
+	 * This structure represents a packet of N rays in SoA layout, with one
+	 * array per component.
+	 *
+	 * \since v1.0.0
+	 */
+	template<uint32 N>
+	ECM_ALIGNEDSTRUCT(32) RayPacket_Base
+	{
+		// The x, y and z components of the origins
+		float32 origin[3][N];
+		// The x, y and z components of the directions
+		float32 direction[3][N];
+	};
+
+	// Comparison operators
+
+	/**
+	 * This operator checks if the two rays are the same.
+	 *
+	 * \param ray1 Left operand.
+	 * \param ray2 Right operand.
+	 *
+	 * \returns true if the origins and the directions are the same, or false
+	 *          if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator==(Ray_Base<T> const& ray1, Ray_Base<T> const& ray2);
+
+	/**
+	 * This operator checks if the two rays are not the same.
+	 *
+	 * \param ray1 Left operand.
+	 * \param ray2 Right operand.
+	 *
+	 * \returns true if the origin or the direction differs, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool operator!=(Ray_Base<T> const& ray1, Ray_Base<T> const& ray2);
+
+	// Functions
+
+	/**
+	 * Returns a point of a ray.
+	 *
+	 * \param ray The ray.
+	 * \param t The distance along the ray, in lengths of its direction.
+	 *
+	 * \returns origin + t * direction.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr Vector3_Base<T> ECM_CALL GetPoint(Ray_Base<T> const& ray, T t) noexcept;
+
+	/**
+	 * Checks if a ray hits a box.
+	 *
+	 * \param ray The ray.
+	 * \param box The box.
+	 * \param distance Receives the distance, where the ray enters the box, or
+	 *                 0 if the origin is inside. It is only written on a hit.
+	 *
+	 * \returns true if the ray hits the box, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(Ray_Base<T> const& ray, AABB_Base<T> const& box,
+		T& distance) noexcept;
+
+	/**
+	 * Checks if a ray hits a triangle with the test of Möller and Trumbore.
+	 * Both sides of the triangle are hit.
+	 *
+	 * \param ray The ray.
+	 * \param v0 The first vertex.
+	 * \param v1 The second vertex.
+	 * \param v2 The third vertex.
+	 * \param distance Receives the distance of the hit.
+	 * \param u Receives the barycentric coordinate of v1.
+	 * \param v Receives the barycentric coordinate of v2.
+	 *
+	 * \returns true if the ray hits the triangle, or false if not. The
+	 *          outputs are only written on a hit.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD constexpr bool ECM_CALL Intersects(Ray_Base<T> const& ray, Vector3_Base<T> const& v0,
+		Vector3_Base<T> const& v1, Vector3_Base<T> const& v2, T& distance, T& u, T& v) noexcept;
+
+	/**
+	 * Checks if a ray hits a triangle with the watertight test. Rays, which
+	 * pass through an edge or a vertex, hit at least one of the triangles,
+	 * which share it. Both sides of the triangle are hit.
+	 *
+	 * \param ray The ray.
+	 * \param v0 The first vertex.
+	 * \param v1 The second vertex.
+	 * \param v2 The third vertex.
+	 * \param distance Receives the distance of the hit.
+	 * \param u Receives the barycentric coordinate of v1.
+	 * \param v Receives the barycentric coordinate of v2.
+	 *
+	 * \returns true if the ray hits the triangle, or false if not. The
+	 *          outputs are only written on a hit.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD bool ECM_CALL IntersectsWatertight(Ray_Base<T> const& ray, Vector3_Base<T> const& v0,
+		Vector3_Base<T> const& v1, Vector3_Base<T> const& v2, T& distance, T& u, T& v) noexcept;
+
+	/**
+	 * Checks if a ray hits a sphere.
+	 *
+	 * \param ray The ray.
+	 * \param sphere The sphere.
+	 * \param distance Receives the distance, where the ray enters the sphere,
+	 *                 or where it leaves it if the origin is inside. It is
+	 *                 only written on a hit.
+	 *
+	 * \returns true if the ray hits the sphere, or false if not.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	ECM_NODISCARD bool ECM_CALL Intersects(Ray_Base<T> const& ray, Sphere_Base<T> const& sphere,
+		T& distance) noexcept;
+
+	/**
+	 * Intersects a packet of four rays with a box.
+	 *
+	 * \param rays The rays.
+	 * \param box The box.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<4> const& rays,
+		AABB_Base<float32> const& box, float32* distances) noexcept;
+
+	/**
+	 * Intersects a packet of eight rays with a box.
+	 *
+	 * \param rays The rays.
+	 * \param box The box.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<8> const& rays,
+		AABB_Base<float32> const& box, float32* distances) noexcept;
+
+	/**
+	 * Intersects a packet of four rays with a triangle, with the test of
+	 * Möller and Trumbore.
+	 *
+	 * \param rays The rays.
+	 * \param v0 The first vertex.
+	 * \param v1 The second vertex.
+	 * \param v2 The third vertex.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 * \param u Receives the barycentric coordinates of v1 of the hits, or
+	 *          null.
+	 * \param v Receives the barycentric coordinates of v2 of the hits, or
+	 *          null.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<4> const& rays,
+		Vector3_Base<float32> const& v0, Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2,
+		float32* distances, float32* u = nullptr, float32* v = nullptr) noexcept;
+
+	/**
+	 * Intersects a packet of eight rays with a triangle, with the test of
+	 * Möller and Trumbore.
+	 *
+	 * \param rays The rays.
+	 * \param v0 The first vertex.
+	 * \param v1 The second vertex.
+	 * \param v2 The third vertex.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 * \param u Receives the barycentric coordinates of v1 of the hits, or
+	 *          null.
+	 * \param v Receives the barycentric coordinates of v2 of the hits, or
+	 *          null.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<8> const& rays,
+		Vector3_Base<float32> const& v0, Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2,
+		float32* distances, float32* u = nullptr, float32* v = nullptr) noexcept;
+
+	/**
+	 * Intersects a packet of four rays with a sphere.
+	 *
+	 * \param rays The rays.
+	 * \param sphere The sphere.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<4> const& rays,
+		Sphere_Base<float32> const& sphere, float32* distances) noexcept;
+
+	/**
+	 * Intersects a packet of eight rays with a sphere.
+	 *
+	 * \param rays The rays.
+	 * \param sphere The sphere.
+	 * \param distances The distances of the rays. A ray only hits before its
+	 *                  distance, which receives the distance of the hit.
+	 *
+	 * \returns The mask of the rays, which hit, with bit i for ray i.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint32 ECM_CALL IntersectPacket(RayPacket_Base<8> const& rays,
+		Sphere_Base<float32> const& sphere, float32* distances) noexcept;
+
+	/**
+	 * A ray with single-precision floating-point components.
+	 *
+	 * \since v1.0.0
+	 */
+	using Ray = Ray_Base<float32>;
+
+	/**
+	 * A packet of four rays.
+	 *
+	 * \since v1.0.0
+	 */
+	using RayPacket4 = RayPacket_Base<4>;
+
+	/**
+	 * A packet of eight rays.
+	 *
+	 * \since v1.0.0
+	 */
+	using RayPacket8 = RayPacket_Base<8>;
+} // namespace ecm::math
+
+#include "ray.inl"
+
+#endif // !_ECM_RAY_H_
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <ECM/math/ray.h>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		template<typename T>
+		constexpr Vector3_Base<T> vector_sub(Vector3_Base<T> const& a, Vector3_Base<T> const& b)
+		{
+			return Vector3_Base<T>(a.x - b.x, a.y - b.y, a.z - b.z);
+		}
+
+		template<typename T>
+		constexpr T vector_dot(Vector3_Base<T> const& a, Vector3_Base<T> const& b)
+		{
+			return a.x * b.x + a.y * b.y + a.z * b.z;
+		}
+
+		template<typename T>
+		constexpr Vector3_Base<T> vector_cross(Vector3_Base<T> const& a, Vector3_Base<T> const& b)
+		{
+			return Vector3_Base<T>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+		}
+
+		// The exit distance of a slab is scaled by 1 + 2 * gamma(3), which
+		// covers the rounding errors of the slab test (Ize, "Robust BVH Ray
+		// Traversal")
+		template<typename T>
+		inline constexpr T slab_exit_scale{ T(1) + T(2) * (T(3) * std::numeric_limits<T>::epsilon() / T(2))
+			/ (T(1) - T(3) * std::numeric_limits<T>::epsilon() / T(2)) };
+
+		// The minimum and maximum of SSE, which return the second operand if
+		// one of the operands is NaN
+		template<typename T>
+		constexpr T slab_min(T a, T b)
+		{
+			return a < b ? a : b;
+		}
+
+		template<typename T>
+		constexpr T slab_max(T a, T b)
+		{
+			return a > b ? a : b;
+		}
+
+		// The edge functions of the watertight test
+		template<typename T>
+		inline void watertight_edges(T ax, T ay, T bx, T by, T cx, T cy, T& u, T& v, T& w)
+		{
+			u = cx * by - cy * bx;
+			v = ax * cy - ay * cx;
+			w = bx * ay - by * ax;
+		}
+	} // namespace detail
+
+	// Basic constructors
+
+	template<typename T>
+	constexpr Ray_Base<T>::Ray_Base()
+		: origin(0, 0, 0), direction(0, 0, 1)
+	{}
+
+	template<typename T>
+	constexpr Ray_Base<T>::Ray_Base(Ray_Base<T> const& ray)
+		: origin(ray.origin), direction(ray.direction)
+	{}
+
+	template<typename T>
+	constexpr Ray_Base<T>::Ray_Base(Vector3_Base<T> const& origin, Vector3_Base<T> const& direction)
+		: origin(origin), direction(direction)
+	{}
+
+	template<typename T>
+	constexpr Ray_Base<T>& Ray_Base<T>::operator=(Ray_Base<T> const& ray)
+	{
+		origin = ray.origin;
+		direction = ray.direction;
+		return *this;
+	}
+
+	// Comparison operators
+
+	template<typename T>
+	constexpr bool operator==(Ray_Base<T> const& ray1, Ray_Base<T> const& ray2)
+	{
+		return ray1.origin == ray2.origin && ray1.direction == ray2.direction;
+	}
+
+	template<typename T>
+	constexpr bool operator!=(Ray_Base<T> const& ray1, Ray_Base<T> const& ray2)
+	{
+		return !(ray1 == ray2);
+	}
+
+	// Functions
+
+	template<typename T>
+	constexpr Vector3_Base<T> GetPoint(Ray_Base<T> const& ray, T t) noexcept
+	{
+		return Vector3_Base<T>(ray.origin.x + t * ray.direction.x, ray.origin.y + t * ray.direction.y,
+			ray.origin.z + t * ray.direction.z);
+	}
+
+	template<typename T>
+	constexpr bool Intersects(Ray_Base<T> const& ray, AABB_Base<T> const& box, T& distance) noexcept
+	{
+		T entry{ 0 };
+		T exit{ std::numeric_limits<T>::infinity() };
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			// A zero component gives infinite distances, and NaN if the
+			// origin is on a plane of the slab. Each distance is combined
+			// with the entry and exit first, whose minimum and maximum
+			// return them unchanged for NaN.
+			const T inverse{ T(1) / ray.direction[i] };
+			const T t0{ (box.min[i] - ray.origin[i]) * inverse };
+			const T t1{ (box.max[i] - ray.origin[i]) * inverse };
+			entry = detail::slab_min(detail::slab_max(t0, entry), detail::slab_max(t1, entry));
+			exit = detail::slab_max(detail::slab_min(t0 * detail::slab_exit_scale<T>, exit),
+				detail::slab_min(t1 * detail::slab_exit_scale<T>, exit));
+		}
+		if (!(entry <= exit))
+			return false;
+		distance = entry;
+		return true;
+	}
+
+	template<typename T>
+	constexpr bool Intersects(Ray_Base<T> const& ray, Vector3_Base<T> const& v0, Vector3_Base<T> const& v1,
+		Vector3_Base<T> const& v2, T& distance, T& u, T& v) noexcept
+	{
+		const Vector3_Base<T> edge1{ detail::vector_sub(v1, v0) };
+		const Vector3_Base<T> edge2{ detail::vector_sub(v2, v0) };
+		const Vector3_Base<T> p{ detail::vector_cross(ray.direction, edge2) };
+		const T determinant{ detail::vector_dot(edge1, p) };
+		// The ray is parallel to the triangle
+		if (determinant == T(0))
+			return false;
+		const T inverse{ T(1) / determinant };
+		const Vector3_Base<T> s{ detail::vector_sub(ray.origin, v0) };
+		const T hitU{ detail::vector_dot(s, p) * inverse };
+		if (hitU < T(0) || hitU > T(1))
+			return false;
+		const Vector3_Base<T> q{ detail::vector_cross(s, edge1) };
+		const T hitV{ detail::vector_dot(ray.direction, q) * inverse };
+		if (hitV < T(0) || hitU + hitV > T(1))
+			return false;
+		const T t{ detail::vector_dot(edge2, q) * inverse };
+		if (t < T(0))
+			return false;
+		distance = t;
+		u = hitU;
+		v = hitV;
+		return true;
+	}
+
+	template<typename T>
+	bool IntersectsWatertight(Ray_Base<T> const& ray, Vector3_Base<T> const& v0, Vector3_Base<T> const& v1,
+		Vector3_Base<T> const& v2, T& distance, T& u, T& v) noexcept
+	{
+		// The ray is the z axis of a sheared space, whose largest component
+		// of the direction is z, and which keeps the winding of the triangle
+		const T absX{ std::abs(ray.direction.x) };
+		const T absY{ std::abs(ray.direction.y) };
+		const T absZ{ std::abs(ray.direction.z) };
+		const uint8 kz{ static_cast<uint8>(absX > absY ? (absX > absZ ? 0 : 2) : (absY > absZ ? 1 : 2)) };
+		uint8 kx{ static_cast<uint8>((kz + 1) % 3) };
+		uint8 ky{ static_cast<uint8>((kx + 1) % 3) };
+		if (ray.direction[kz] < T(0)) {
+			const uint8 k{ kx };
+			kx = ky;
+			ky = k;
+		}
+		const T shearX{ ray.direction[kx] / ray.direction[kz] };
+		const T shearY{ ray.direction[ky] / ray.direction[kz] };
+		const T shearZ{ T(1) / ray.direction[kz] };
+
+		const Vector3_Base<T> a{ detail::vector_sub(v0, ray.origin) };
+		const Vector3_Base<T> b{ detail::vector_sub(v1, ray.origin) };
+		const Vector3_Base<T> c{ detail::vector_sub(v2, ray.origin) };
+		const T ax{ a[kx] - shearX * a[kz] };
+		const T ay{ a[ky] - shearY * a[kz] };
+		const T bx{ b[kx] - shearX * b[kz] };
+		const T by{ b[ky] - shearY * b[kz] };
+		const T cx{ c[kx] - shearX * c[kz] };
+		const T cy{ c[ky] - shearY * c[kz] };
+
+		T edgeU;
+		T edgeV;
+		T edgeW;
+		detail::watertight_edges(ax, ay, bx, by, cx, cy, edgeU, edgeV, edgeW);
+		// Edge functions of 0 are exact in double precision
+		if constexpr (std::is_same_v<T, float32>) {
+			if (edgeU == 0.f || edgeV == 0.f || edgeW == 0.f) {
+				float64 u64;
+				float64 v64;
+				float64 w64;
+				detail::watertight_edges<float64>(ax, ay, bx, by, cx, cy, u64, v64, w64);
+				edgeU = static_cast<float32>(u64);
+				edgeV = static_cast<float32>(v64);
+				edgeW = static_cast<float32>(w64);
+			}
+		}
+		if ((edgeU < T(0) || edgeV < T(0) || edgeW < T(0)) && (edgeU > T(0) || edgeV > T(0) || edgeW > T(0)))
+			return false;
+		const T determinant{ edgeU + edgeV + edgeW };
+		if (determinant == T(0))
+			return false;
+
+		// The scaled distance has the sign of the determinant in front of
+		// the origin
+		const T scaledT{ edgeU * shearZ * a[kz] + edgeV * shearZ * b[kz] + edgeW * shearZ * c[kz] };
+		if (determinant < T(0) ? scaledT > T(0) : scaledT < T(0))
+			return false;
+		const T inverse{ T(1) / determinant };
+		distance = scaledT * inverse;
+		u = edgeV * inverse;
+		v = edgeW * inverse;
+		return true;
+	}
+
+	template<typename T>
+	bool Intersects(Ray_Base<T> const& ray, Sphere_Base<T> const& sphere, T& distance) noexcept
+	{
+		const Vector3_Base<T> f{ detail::vector_sub(ray.origin, sphere.center) };
+		const T a{ detail::vector_dot(ray.direction, ray.direction) };
+		const T b{ detail::vector_dot(f, ray.direction) };
+		const T c{ detail::vector_dot(f, f) - sphere.radius * sphere.radius };
+		// b * b - a * c, without the cancellation of far away spheres
+		// (Haines et al., "Precision Improvements for Ray/Sphere
+		// Intersection")
+		const T s{ b / a };
+		const Vector3_Base<T> l(f.x - s * ray.direction.x, f.y - s * ray.direction.y, f.z - s * ray.direction.z);
+		const T discriminant{ a * (sphere.radius * sphere.radius - detail::vector_dot(l, l)) };
+		if (!(discriminant >= T(0)))
+			return false;
+		const T root{ static_cast<T>(std::sqrt(discriminant)) };
+		const T q{ b < T(0) ? root - b : -b - root };
+		T t0{ c / q };
+		T t1{ q / a };
+		if (t1 < t0) {
+			const T t{ t0 };
+			t0 = t1;
+			t1 = t;
+		}
+		if (t0 >= T(0)) {
+			distance = t0;
+			return true;
+		}
+		if (t1 >= T(0)) {
+			distance = t1;
+			return true;
+		}
+		return false;
+	}
+} // namespace ecm::math
@@ -0,0 +1,384 @@
+/**
+ * \file reduction.h
+ *
+ * \brief This header defines reductions of large arrays: sums, dot
+ * products, means, variances, ranges, the index of the greatest value and
+ * histograms.
+ *
+ * The reductions keep several sums in SIMD registers, eight or four values
+ * wide with AVX2 and SSE2 for float32, and add them at the end. Large
+ * arrays are split into chunks, which run on the threads of ParallelFor.
+ * The chunks only depend on the number of values, so the results are the
+ * same for every number of threads.
+ *
+ * The compensated summation tracks the rounding error of each addition
+ * like the summation of Kahan and Neumaier. The error is computed with the
+ * branch-free TwoSum of Knuth, so it is exact for every order of the
+ * addends and runs in SIMD registers. It costs about four additions per
+ * value.
+ *
+ * Arrays of Vector3 and Vector4 are reduced component by component.
+ */
+
+#pragma once
+#ifndef _ECM_REDUCTION_H_
+#define _ECM_REDUCTION_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines how the values of a reduction are added.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class Summation : uint8
+	{
+		/* Several sums in SIMD registers, which are added at the end */
+		FAST = 0x0,
+		/* Sums, which keep the rounding errors of their additions */
+		COMPENSATED
+	} Summation;
+
+	/**
+	 * Calculates the sum of values on multiple threads.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values are added.
+	 *
+	 * \returns The sum, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Sum(float32 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the sum of values on multiple threads.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values are added.
+	 *
+	 * \returns The sum, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float64 ECM_CALL Sum(float64 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the sum of vectors on multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors are added.
+	 *
+	 * \returns The sum, which is zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector3_Base<float32> ECM_CALL Sum(Vector3_Base<float32> const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the sum of vectors on multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors are added.
+	 *
+	 * \returns The sum, which is zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector4_Base<float32> ECM_CALL Sum(Vector4_Base<float32> const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the dot product of two arrays on multiple threads.
+	 *
+	 * \param a The first array.
+	 * \param b The second array.
+	 * \param count The number of values of each array.
+	 * \param summation How the products are added.
+	 *
+	 * \returns The dot product, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Dot(float32 const* a, float32 const* b, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the dot product of two arrays on multiple threads.
+	 *
+	 * \param a The first array.
+	 * \param b The second array.
+	 * \param count The number of values of each array.
+	 * \param summation How the products are added.
+	 *
+	 * \returns The dot product, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float64 ECM_CALL Dot(float64 const* a, float64 const* b, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the mean of values on multiple threads.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values are added.
+	 *
+	 * \returns The mean, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Mean(float32 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the mean of values on multiple threads.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values are added.
+	 *
+	 * \returns The mean, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float64 ECM_CALL Mean(float64 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the mean of vectors on multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors are added.
+	 *
+	 * \returns The mean, which is zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector3_Base<float32> ECM_CALL Mean(Vector3_Base<float32> const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the mean of vectors on multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors are added.
+	 *
+	 * \returns The mean, which is zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector4_Base<float32> ECM_CALL Mean(Vector4_Base<float32> const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the population variance of values on multiple threads. The
+	 * mean is calculated first and the squared deviations from it are added
+	 * in a second pass, which avoids the cancellation of the sum of squares.
+	 * The variance of a sample is the result multiplied by
+	 * count / (count - 1).
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values and the squared deviations are added.
+	 *
+	 * \returns The variance, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float32 ECM_CALL Variance(float32 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the population variance of values on multiple threads. The
+	 * mean is calculated first and the squared deviations from it are added
+	 * in a second pass, which avoids the cancellation of the sum of squares.
+	 * The variance of a sample is the result multiplied by
+	 * count / (count - 1).
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param summation How the values and the squared deviations are added.
+	 *
+	 * \returns The variance, which is 0 if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API float64 ECM_CALL Variance(float64 const* values, uint64 count,
+		Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the population variance of each component of vectors on
+	 * multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors and the squared deviations are added.
+	 *
+	 * \returns The variances, which are zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector3_Base<float32> ECM_CALL Variance(Vector3_Base<float32> const* values,
+		uint64 count, Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the population variance of each component of vectors on
+	 * multiple threads.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param summation How the vectors and the squared deviations are added.
+	 *
+	 * \returns The variances, which are zero if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API Vector4_Base<float32> ECM_CALL Variance(Vector4_Base<float32> const* values,
+		uint64 count, Summation summation = Summation::FAST) noexcept;
+
+	/**
+	 * Calculates the smallest and the greatest of values on multiple
+	 * threads. The result is undefined, if the values contain NaN.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param min Receives the smallest value, which is infinity if count
+	 *            is 0.
+	 * \param max Receives the greatest value, which is minus infinity if
+	 *            count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MinMax(float32 const* values, uint64 count, float32& min, float32& max) noexcept;
+
+	/**
+	 * Calculates the smallest and the greatest of values on multiple
+	 * threads. The result is undefined, if the values contain NaN.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param min Receives the smallest value, which is infinity if count
+	 *            is 0.
+	 * \param max Receives the greatest value, which is minus infinity if
+	 *            count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MinMax(float64 const* values, uint64 count, float64& min, float64& max) noexcept;
+
+	/**
+	 * Calculates the smallest and the greatest of each component of vectors
+	 * on multiple threads. The result is undefined, if the vectors contain
+	 * NaN.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param min Receives the smallest components, which are infinity if
+	 *            count is 0.
+	 * \param max Receives the greatest components, which are minus
+	 *            infinity if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MinMax(Vector3_Base<float32> const* values, uint64 count, Vector3_Base<float32>& min,
+		Vector3_Base<float32>& max) noexcept;
+
+	/**
+	 * Calculates the smallest and the greatest of each component of vectors
+	 * on multiple threads. The result is undefined, if the vectors contain
+	 * NaN.
+	 *
+	 * \param values The vectors.
+	 * \param count The number of vectors.
+	 * \param min Receives the smallest components, which are infinity if
+	 *            count is 0.
+	 * \param max Receives the greatest components, which are minus
+	 *            infinity if count is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MinMax(Vector4_Base<float32> const* values, uint64 count, Vector4_Base<float32>& min,
+		Vector4_Base<float32>& max) noexcept;
+
+	/**
+	 * Finds the greatest value on multiple threads. The result is
+	 * undefined, if the values contain NaN.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 *
+	 * \returns The index of the first greatest value, which is 0 if count
+	 *          is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint64 ECM_CALL ArgMax(float32 const* values, uint64 count) noexcept;
+
+	/**
+	 * Finds the greatest value on multiple threads. The result is
+	 * undefined, if the values contain NaN.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 *
+	 * \returns The index of the first greatest value, which is 0 if count
+	 *          is 0.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_NODISCARD ECM_MATH_API uint64 ECM_CALL ArgMax(float64 const* values, uint64 count) noexcept;
+
+	/**
+	 * Counts values in bins of equal width on multiple threads. The bins
+	 * divide the range [min, max], whose upper bound belongs to the last
+	 * bin. Values outside of the range and NaN aren't counted.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param min The lower bound of the first bin.
+	 * \param max The upper bound of the last bin, which must be greater than
+	 *            min.
+	 * \param binCount The number of bins.
+	 * \param bins The binCount elements receiving the counts of the bins.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL Histogram(float32 const* values, uint64 count, float32 min, float32 max, uint32 binCount,
+		uint64* bins);
+
+	/**
+	 * Counts values in bins of equal width on multiple threads. The bins
+	 * divide the range [min, max], whose upper bound belongs to the last
+	 * bin. Values outside of the range and NaN aren't counted.
+	 *
+	 * \param values The values.
+	 * \param count The number of values.
+	 * \param min The lower bound of the first bin.
+	 * \param max The upper bound of the last bin, which must be greater than
+	 *            min.
+	 * \param binCount The number of bins.
+	 * \param bins The binCount elements receiving the counts of the bins.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL Histogram(float64 const* values, uint64 count, float64 min, float64 max, uint32 binCount,
+		uint64* bins);
+} // namespace ecm::math
+
+#endif // !_ECM_REDUCTION_H_
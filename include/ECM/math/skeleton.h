@@ -0,0 +1,293 @@
+/**
+ * \file skeleton.h
+ *
+ * \brief This header defines the poses of skeletons, their blending, and
+ * the generation of skinning matrices.
+ *
+ * A pose stores the local translation, rotation and scale of the bones as
+ * ten arrays, one for each component. The blend functions process eight
+ * bones at once with AVX2 and four with SSE2. The arrays are padded with
+ * identity bones to a multiple of eight, so no bone is processed alone.
+ *
+ * The bones of a skeleton are ordered, so that each parent comes before its
+ * children. LocalToModel concatenates the hierarchy in one pass in this
+ * order.
+ */
+
+#pragma once
+#ifndef _ECM_SKELETON_H_
+#define _ECM_SKELETON_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/dual_quaternion.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/quaternion.h>
+#include <ECM/math/vector3.h>
+#include <ECM/math/vector4.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This enumeration defines the component arrays of a pose.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class PoseChannel : uint8
+	{
+		TRANSLATION_X = 0x0,
+		TRANSLATION_Y,
+		TRANSLATION_Z,
+		ROTATION_X,
+		ROTATION_Y,
+		ROTATION_Z,
+		ROTATION_W,
+		SCALE_X,
+		SCALE_Y,
+		SCALE_Z
+	} PoseChannel;
+
+	/**
+	 * This structure represents a skinning matrix as the first three rows of
+	 * an affine transformation, which a shader applies to a point p with the
+	 * dot products of the rows and (p, 1).
+	 *
+	 * \since v1.0.0
+	 */
+	struct SkinningMatrix
+	{
+		Vector4_Base<float32> rows[3];
+	};
+
+	namespace detail
+	{
+		// The multiple, to which the arrays of a pose are padded
+		inline constexpr uint32 pose_padding{ 8 };
+		inline constexpr uint32 pose_channels{ 10 };
+	} // namespace detail
+
+	/**
+	 * This class represents the local transformations of the bones of a
+	 * skeleton.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API Pose
+	{
+	public:
+		/**
+		 * Constructor creating a pose without bones.
+		 *
+		 * \since v1.0.0
+		 */
+		Pose() noexcept = default;
+
+		/**
+		 * Constructor creating a pose, whose bones have the identity
+		 * transformation.
+		 *
+		 * \param boneCount The number of bones.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit Pose(uint32 boneCount);
+
+		/**
+		 * Changes the number of bones. Added bones have the identity
+		 * transformation.
+		 *
+		 * \param boneCount The number of bones.
+		 *
+		 * \since v1.0.0
+		 */
+		void Resize(uint32 boneCount);
+
+		/**
+		 * Sets all bones to the identity transformation.
+		 *
+		 * \since v1.0.0
+		 */
+		void SetIdentity() noexcept;
+
+		/**
+		 * Returns the number of bones.
+		 *
+		 * \returns The number of bones.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetBoneCount() const noexcept;
+
+		/**
+		 * Returns the length of the component arrays, which is the number of
+		 * bones rounded up to a multiple of eight.
+		 *
+		 * \returns The length of the arrays.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetStride() const noexcept;
+
+		/**
+		 * Sets the transformation of a bone.
+		 *
+		 * \param bone The index of the bone.
+		 * \param translation The translation.
+		 * \param rotation The unit rotation.
+		 * \param scale The scale.
+		 *
+		 * \since v1.0.0
+		 */
+		void SetBone(uint32 bone, Vector3_Base<float32> const& translation, Quaternion_Base<float32> const& rotation,
+			Vector3_Base<float32> const& scale) noexcept;
+
+		/**
+		 * Returns the translation of a bone.
+		 *
+		 * \param bone The index of the bone.
+		 *
+		 * \returns The translation.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD Vector3_Base<float32> ECM_CALL GetTranslation(uint32 bone) const noexcept;
+
+		/**
+		 * Returns the rotation of a bone.
+		 *
+		 * \param bone The index of the bone.
+		 *
+		 * \returns The rotation.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD Quaternion_Base<float32> ECM_CALL GetRotation(uint32 bone) const noexcept;
+
+		/**
+		 * Returns the scale of a bone.
+		 *
+		 * \param bone The index of the bone.
+		 *
+		 * \returns The scale.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD Vector3_Base<float32> ECM_CALL GetScale(uint32 bone) const noexcept;
+
+		/**
+		 * Returns a component array, to write the sampled animation tracks
+		 * of the bones directly. The padding after the last bone must keep
+		 * the identity transformation.
+		 *
+		 * \param channel The component.
+		 *
+		 * \returns The array of GetStride() values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD float32* ECM_CALL GetChannel(PoseChannel channel) noexcept;
+
+		/**
+		 * Returns a component array.
+		 *
+		 * \param channel The component.
+		 *
+		 * \returns The array of GetStride() values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD float32 const* ECM_CALL GetChannel(PoseChannel channel) const noexcept;
+	private:
+		uint32 _boneCount{ 0 };
+		uint32 _stride{ 0 };
+		std::vector<float32> _channels;
+	};
+
+	/**
+	 * Blends poses with weights. The translations and scales are weighted
+	 * sums, and the rotations are normalized weighted sums, with each
+	 * rotation on the hemisphere of the first pose.
+	 *
+	 * \param poses The poses, which have the same number of bones as out.
+	 * \param weights The weights, which should sum to 1.
+	 * \param count The number of poses, which must not be 0.
+	 * \param out The blended pose, which may be one of the poses.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL BlendPoses(Pose const* const* poses, float32 const* weights, uint32 count, Pose& out) noexcept;
+
+	/**
+	 * Calculates the difference of a pose to a reference pose, which
+	 * AddPose applies to other poses.
+	 *
+	 * \param pose The pose.
+	 * \param reference The reference pose, with the same number of bones.
+	 * \param out The additive pose, which may be one of the poses.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL MakeAdditivePose(Pose const& pose, Pose const& reference, Pose& out) noexcept;
+
+	/**
+	 * Applies an additive pose to a pose. The weight scales the
+	 * translations, interpolates the rotations from the identity, and
+	 * interpolates the scales from 1.
+	 *
+	 * \param base The pose.
+	 * \param additive The additive pose of MakeAdditivePose, with the same
+	 *                 number of bones.
+	 * \param weight The weight of the additive pose.
+	 * \param out The result, which may be one of the poses.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL AddPose(Pose const& base, Pose const& additive, float32 weight, Pose& out) noexcept;
+
+	/**
+	 * Calculates the model space transformations of the bones, by
+	 * concatenating each local transformation with the one of its parent.
+	 *
+	 * \param local The local pose.
+	 * \param parents The index of the parent of each bone, which is less
+	 *                than the index of the bone, or -1 for a root.
+	 * \param model The array of the model space matrices of the bones.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL LocalToModel(Pose const& local, int32 const* parents, Matrix4x4_Base<float32>* model) noexcept;
+
+	/**
+	 * Calculates the skinning matrices, which transform the vertices from
+	 * the bind pose to the pose of the model matrices.
+	 *
+	 * \param model The model space matrices of the bones.
+	 * \param inverseBind The inverses of the model space matrices of the
+	 *                    bones in the bind pose.
+	 * \param out The array of the skinning matrices.
+	 * \param count The number of bones.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ComputeSkinningMatrices(Matrix4x4_Base<float32> const* model,
+		Matrix4x4_Base<float32> const* inverseBind, SkinningMatrix* out, uint32 count) noexcept;
+
+	/**
+	 * Calculates the skinning transformations as dual quaternions. The scale
+	 * of the transformations is removed.
+	 *
+	 * \param model The model space matrices of the bones.
+	 * \param inverseBind The inverses of the model space matrices of the
+	 *                    bones in the bind pose.
+	 * \param out The array of the unit dual quaternions.
+	 * \param count The number of bones.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL ComputeSkinningMatrices(Matrix4x4_Base<float32> const* model,
+		Matrix4x4_Base<float32> const* inverseBind, DualQuaternion_Base<float32>* out, uint32 count) noexcept;
+} // namespace ecm::math
+
+#endif // !_ECM_SKELETON_H_
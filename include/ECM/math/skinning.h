@@ -0,0 +1,107 @@
+/**
+ * \file skinning.h
+ *
+ * \brief This header defines the skinning of vertices on the CPU, with the
+ * linear blend of skinning matrices or with dual quaternions.
+ *
+ * The vertices are in SoA layout, with one array per component, and have
+ * the indices and weights of four bones each. The kernels process eight
+ * vertices at once with AVX2 and four with SSE2. They load the
+ * transformations of the bones of four vertices from the palette and
+ * transpose them to one lane per vertex. Large batches are split into ranges
+ * of vertices, which run on the threads of ParallelFor.
+ */
+
+#pragma once
+#ifndef _ECM_SKINNING_H_
+#define _ECM_SKINNING_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/dual_quaternion.h>
+#include <ECM/math/matrix4x4.h>
+#include <ECM/math/skeleton.h>
+
+namespace ecm::math
+{
+	/**
+	 * This structure references the vertices, which are skinned.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SkinningVertices
+	{
+		/* The x, y and z components of the positions */
+		float32 const* positions[3]{ nullptr, nullptr, nullptr };
+		/* The x, y and z components of the normals, or null if the vertices
+		   have no normals */
+		float32 const* normals[3]{ nullptr, nullptr, nullptr };
+		/* The indices of the four bones of each vertex into the palette */
+		uint16 const* bones{ nullptr };
+		/* The weights of the four bones of each vertex, which sum to 1 */
+		float32 const* weights{ nullptr };
+	};
+
+	/**
+	 * This structure references the arrays of the skinned vertices.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SkinnedVertices
+	{
+		/* The x, y and z components of the positions */
+		float32* positions[3]{ nullptr, nullptr, nullptr };
+		/* The x, y and z components of the normals, or null to skip the
+		   normals */
+		float32* normals[3]{ nullptr, nullptr, nullptr };
+	};
+
+	/**
+	 * Skins vertices with the weighted sum of their skinning matrices. The
+	 * normals are transformed by the rotation and scale of the sum, and are
+	 * not normalized.
+	 *
+	 * \param palette The skinning matrices of ComputeSkinningMatrices.
+	 * \param vertices The vertices.
+	 * \param out The skinned vertices, whose arrays may be the ones of the
+	 *            vertices.
+	 * \param count The number of vertices.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SkinLinear(SkinningMatrix const* palette, SkinningVertices const& vertices,
+		SkinnedVertices const& out, uint64 count) noexcept;
+
+	/**
+	 * Skins vertices with the weighted sum of their skinning matrices.
+	 *
+	 * \param palette The skinning matrices, with the translation in m[3].
+	 * \param vertices The vertices.
+	 * \param out The skinned vertices, whose arrays may be the ones of the
+	 *            vertices.
+	 * \param count The number of vertices.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SkinLinear(Matrix4x4_Base<float32> const* palette, SkinningVertices const& vertices,
+		SkinnedVertices const& out, uint64 count) noexcept;
+
+	/**
+	 * Skins vertices with the normalized weighted sum of their dual
+	 * quaternions, which keeps the volume of twisted joints. The dual
+	 * quaternions of a vertex are summed on the hemisphere of its first
+	 * bone.
+	 *
+	 * \param palette The unit dual quaternions of ComputeSkinningMatrices.
+	 * \param vertices The vertices.
+	 * \param out The skinned vertices, whose arrays may be the ones of the
+	 *            vertices.
+	 * \param count The number of vertices.
+	 *
+	 * \since v1.0.0
+	 */
+	ECM_MATH_API void ECM_CALL SkinDualQuat(DualQuaternion_Base<float32> const* palette,
+		SkinningVertices const& vertices, SkinnedVertices const& out, uint64 count) noexcept;
+} // namespace ecm::math
+
+#endif // !_ECM_SKINNING_H_
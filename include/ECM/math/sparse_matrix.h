@@ -0,0 +1,442 @@
+/**
+ * \file sparse_matrix.h
+ *
+ * \brief This header defines sparse matrices and a conjugate gradient
+ * solver for the large symmetric systems of cloth, pressure projection
+ * and heat diffusion.
+ *
+ * SparseMatrix stores the nonzero elements of each row contiguously
+ * (compressed sparse rows, CSR), and BlockSparseMatrix stores dense square
+ * blocks instead of elements (block sparse rows, BSR), which suits systems
+ * with several unknowns per node. Their products with vectors run on the
+ * threads of ParallelFor. The products of blocks of 2x2 to 4x4 elements
+ * keep the sums of a row of blocks in a SIMD register and multiply whole
+ * columns of the blocks, while the rows of SparseMatrix load one element
+ * of the vector per stored element. Larger blocks use scalar loops.
+ *
+ * ConjugateGradient keeps its vectors and its preconditioner between
+ * solves, so that solving every frame doesn't allocate. The dot products
+ * are summed in chunks, whose boundaries don't depend on the number of
+ * threads, so the results are deterministic.
+ *
+ * The classes are explicitly instantiated for float32 and float64.
+ */
+
+#pragma once
+#ifndef _ECM_SPARSE_MATRIX_H_
+#define _ECM_SPARSE_MATRIX_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents an element of a sparse matrix, from which
+	 * the matrix is built.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct SparseTriplet
+	{
+		/* The row */
+		uint32 row{ 0 };
+		/* The column */
+		uint32 column{ 0 };
+		/* The value, which is added to the other values of the same
+		 * element */
+		T value{ 0 };
+	};
+
+	/**
+	 * This class represents a sparse matrix in compressed sparse rows.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	class ECM_MATH_API SparseMatrix
+	{
+	public:
+		typedef T value_type;
+
+		/**
+		 * Constructor creating an empty matrix.
+		 *
+		 * \since v1.0.0
+		 */
+		SparseMatrix() noexcept = default;
+
+		/**
+		 * Builds the matrix from elements in any order. The values of
+		 * elements, which occur more than once, are added, like the element
+		 * matrices of finite elements are assembled. The columns of each row
+		 * are sorted.
+		 *
+		 * \param rows The number of rows.
+		 * \param columns The number of columns.
+		 * \param triplets The elements, whose rows and columns are within
+		 *                 the size.
+		 * \param count The number of elements.
+		 *
+		 * \since v1.0.0
+		 */
+		void Build(uint32 rows, uint32 columns, SparseTriplet<T> const* triplets, uint64 count);
+
+		/**
+		 * Computes y = Ax on multiple threads.
+		 *
+		 * \param x The vector with an element for each column.
+		 * \param y The vector receiving an element for each row, which must
+		 *          not be the same as x.
+		 *
+		 * \since v1.0.0
+		 */
+		void Multiply(T const* x, T* y) const noexcept;
+
+		/**
+		 * Copies the diagonal of the matrix.
+		 *
+		 * \param diagonal The array receiving an element for each row, which
+		 *                 is zero for missing elements.
+		 *
+		 * \since v1.0.0
+		 */
+		void GetDiagonal(T* diagonal) const noexcept;
+
+		/**
+		 * Returns the number of rows.
+		 *
+		 * \returns The number of rows.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetRows() const noexcept;
+
+		/**
+		 * Returns the number of columns.
+		 *
+		 * \returns The number of columns.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetColumns() const noexcept;
+
+		/**
+		 * Returns the number of stored elements.
+		 *
+		 * \returns The number of stored elements.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint64 ECM_CALL GetNonZeroCount() const noexcept;
+
+		/**
+		 * Returns the offsets of the rows into the columns and values. The
+		 * elements of row r are in [offsets[r], offsets[r + 1]).
+		 *
+		 * \returns The array of GetRows() + 1 offsets.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint64 const* ECM_CALL GetRowOffsets() const noexcept;
+
+		/**
+		 * Returns the columns of the stored elements.
+		 *
+		 * \returns The array of GetNonZeroCount() columns.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 const* ECM_CALL GetColumnIndices() const noexcept;
+
+		/**
+		 * Returns the values of the stored elements, which can be changed
+		 * without building the matrix again, if the pattern stays the same.
+		 *
+		 * \returns The array of GetNonZeroCount() values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T* ECM_CALL GetValues() noexcept;
+
+		/**
+		 * Returns the values of the stored elements.
+		 *
+		 * \returns The array of GetNonZeroCount() values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T const* ECM_CALL GetValues() const noexcept;
+	private:
+		std::vector<uint64> _offsets;
+		std::vector<uint32> _columnIndices;
+		std::vector<T> _values;
+		uint32 _rows{ 0 };
+		uint32 _columns{ 0 };
+	};
+
+	/**
+	 * This class represents a sparse matrix of dense square blocks in block
+	 * sparse rows. The blocks store their elements column by column.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	class ECM_MATH_API BlockSparseMatrix
+	{
+	public:
+		typedef T value_type;
+
+		/**
+		 * Constructor creating an empty matrix.
+		 *
+		 * \since v1.0.0
+		 */
+		BlockSparseMatrix() noexcept = default;
+
+		/**
+		 * Builds the matrix from a sparse matrix. A block is stored, if any
+		 * of its elements is stored in the sparse matrix.
+		 *
+		 * \param matrix The sparse matrix.
+		 * \param blockSize The size of the blocks, which divides the number
+		 *                  of rows and columns of the matrix.
+		 *
+		 * \returns False if the block size doesn't divide the size of the
+		 *          matrix, in which case the matrix is empty, true
+		 *          otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Build(SparseMatrix<T> const& matrix, uint32 blockSize);
+
+		/**
+		 * Computes y = Ax on multiple threads.
+		 *
+		 * \param x The vector with an element for each column.
+		 * \param y The vector receiving an element for each row, which must
+		 *          not be the same as x.
+		 *
+		 * \since v1.0.0
+		 */
+		void Multiply(T const* x, T* y) const noexcept;
+
+		/**
+		 * Returns the size of the blocks.
+		 *
+		 * \returns The size of the blocks.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetBlockSize() const noexcept;
+
+		/**
+		 * Returns the number of rows of blocks.
+		 *
+		 * \returns The number of rows of blocks.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetBlockRows() const noexcept;
+
+		/**
+		 * Returns the number of stored blocks.
+		 *
+		 * \returns The number of stored blocks.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint64 ECM_CALL GetBlockCount() const noexcept;
+
+		/**
+		 * Returns the offsets of the rows of blocks into the blocks.
+		 *
+		 * \returns The array of GetBlockRows() + 1 offsets.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint64 const* ECM_CALL GetRowOffsets() const noexcept;
+
+		/**
+		 * Returns the columns of blocks of the stored blocks.
+		 *
+		 * \returns The array of GetBlockCount() columns.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 const* ECM_CALL GetColumnIndices() const noexcept;
+
+		/**
+		 * Returns the values of the stored blocks, one block after the
+		 * other.
+		 *
+		 * \returns The array of GetBlockCount() * GetBlockSize()^2 values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T* ECM_CALL GetValues() noexcept;
+
+		/**
+		 * Returns the values of the stored blocks, one block after the
+		 * other.
+		 *
+		 * \returns The array of GetBlockCount() * GetBlockSize()^2 values.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD T const* ECM_CALL GetValues() const noexcept;
+	private:
+		std::vector<uint64> _offsets;
+		std::vector<uint32> _columnIndices;
+		std::vector<T> _values;
+		uint32 _blockSize{ 1 };
+		uint32 _blockRows{ 0 };
+		uint32 _blockColumns{ 0 };
+	};
+
+	/**
+	 * This enumeration defines the preconditioners of ConjugateGradient.
+	 *
+	 * \since v1.0.0
+	 */
+	typedef enum class Preconditioner : uint8
+	{
+		/* No preconditioner */
+		NONE = 0x0,
+		/* The inverse of the diagonal, which is cheap and parallel */
+		JACOBI,
+		/* The incomplete Cholesky factorization with the pattern of the
+		 * matrix, which needs fewer iterations, but whose triangular
+		 * solves run on one thread */
+		IC0
+	} Preconditioner;
+
+	/**
+	 * This structure receives the statistics of a solve.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SolverStats
+	{
+		/* The number of iterations */
+		uint32 iterations{ 0 };
+		/* The norm of the last residual relative to the norm of the
+		 * right-hand side */
+		float64 residual{ 0.0 };
+		/* The time of the solve in seconds */
+		float64 seconds{ 0.0 };
+		/* Whether the residual reached the tolerance */
+		bool converged{ false };
+	};
+
+	/**
+	 * This class solves symmetric positive definite systems Ax = b with the
+	 * preconditioned conjugate gradient method.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	class ECM_MATH_API ConjugateGradient
+	{
+	public:
+		/**
+		 * Constructor.
+		 *
+		 * \param preconditioner The preconditioner.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit ConjugateGradient(Preconditioner preconditioner = Preconditioner::JACOBI) noexcept;
+
+		/**
+		 * Computes the preconditioner of a matrix. It must be called again,
+		 * when the values of the matrix change.
+		 *
+		 * If the incomplete Cholesky factorization breaks down, because a
+		 * pivot isn't positive, the solves use the Jacobi preconditioner
+		 * instead.
+		 *
+		 * \param a The symmetric matrix, whose columns of each row are
+		 *          sorted like SparseMatrix::Build sorts them.
+		 *
+		 * \returns False if the preconditioner fell back to Jacobi or the
+		 *          diagonal has zeros, true otherwise.
+		 *
+		 * \since v1.0.0
+		 */
+		bool Compute(SparseMatrix<T> const& a);
+
+		/**
+		 * Solves Ax = b with the preconditioner of the last Compute.
+		 *
+		 * \param a The matrix, which was passed to Compute.
+		 * \param b The right-hand side.
+		 * \param x The initial guess, which receives the solution.
+		 *
+		 * \returns The statistics of the solve.
+		 *
+		 * \since v1.0.0
+		 */
+		SolverStats Solve(SparseMatrix<T> const& a, T const* b, T* x);
+
+		/**
+		 * Sets the tolerance of the residual relative to the right-hand
+		 * side. The default is 1e-6.
+		 *
+		 * \param tolerance The tolerance.
+		 *
+		 * \since v1.0.0
+		 */
+		void ECM_CALL SetTolerance(float64 tolerance) noexcept;
+
+		/**
+		 * Sets the maximum number of iterations. The default is 1000.
+		 *
+		 * \param iterations The maximum number of iterations.
+		 *
+		 * \since v1.0.0
+		 */
+		void ECM_CALL SetMaxIterations(uint32 iterations) noexcept;
+
+		/**
+		 * Returns the preconditioner.
+		 *
+		 * \returns The preconditioner.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD Preconditioner ECM_CALL GetPreconditioner() const noexcept;
+	private:
+		// Computes z = M^-1 r and returns r . z
+		float64 precondition(Preconditioner preconditioner);
+
+		Preconditioner _preconditioner;
+		// The preconditioner of the last Compute, which is Jacobi, if the
+		// factorization broke down
+		Preconditioner _active{ Preconditioner::NONE };
+		float64 _tolerance{ 1e-6 };
+		uint32 _maxIterations{ 1000 };
+		// The inverse of the diagonal for Jacobi
+		std::vector<T> _inverseDiagonal;
+		// The lower triangle L of the incomplete factorization A = LL^T
+		SparseMatrix<T> _factor;
+		// The workspace of the solves
+		std::vector<T> _r;
+		std::vector<T> _z;
+		std::vector<T> _p;
+		std::vector<T> _q;
+		std::vector<float64> _partials;
+	};
+
+	extern template class SparseMatrix<float32>;
+	extern template class SparseMatrix<float64>;
+	extern template class BlockSparseMatrix<float32>;
+	extern template class BlockSparseMatrix<float64>;
+	extern template class ConjugateGradient<float32>;
+	extern template class ConjugateGradient<float64>;
+} // namespace ecm::math
+
+#endif // !_ECM_SPARSE_MATRIX_H_
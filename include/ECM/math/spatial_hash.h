@@ -0,0 +1,220 @@
+/**
+ * \file spatial_hash.h
+ *
+ * \brief This header defines a uniform grid over 2D points, whose cells are
+ * hashed into a flat table, for broad-phase queries.
+ *
+ * The items are sorted by their bucket with a counting sort into flat
+ * arrays, so that the items of a cell are contiguous. Inserting, moving and
+ * removing items is O(1): moves within a cell are updated in place, and
+ * other changes go to a small list of pending items, which the queries scan
+ * as well. The grid is sorted again, once the pending items or the removed
+ * items exceed a fraction of all items. Scenes, whose items all move every
+ * frame, are best rebuilt with Build.
+ */
+
+#pragma once
+#ifndef _ECM_SPATIAL_HASH_H_
+#define _ECM_SPATIAL_HASH_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/vector.h>
+
+#include <vector>
+
+namespace ecm::math
+{
+	/**
+	 * This structure represents a pair of items, which are close to each
+	 * other.
+	 *
+	 * \since v1.0.0
+	 */
+	struct SpatialPair
+	{
+		/* The smaller item */
+		uint32 first{ 0 };
+		/* The larger item */
+		uint32 second{ 0 };
+	};
+
+	/**
+	 * This class represents a uniform grid of square cells over 2D points.
+	 * Items are identified by the handles, which Insert returns, and the
+	 * handles of removed items are reused.
+	 *
+	 * \since v1.0.0
+	 */
+	class ECM_MATH_API SpatialHashGrid
+	{
+	public:
+		/**
+		 * Constructor creating an empty grid.
+		 *
+		 * \param cellSize The size of the cells. Queries are fastest, if it
+		 *                 is about the distance of the pair queries, or the
+		 *                 typical radius of the radius queries.
+		 *
+		 * \since v1.0.0
+		 */
+		explicit SpatialHashGrid(float32 cellSize = 1.f) noexcept;
+
+		/**
+		 * Replaces all items with the points of an array and sorts them.
+		 * Item i has the handle i.
+		 *
+		 * \param positions The points.
+		 * \param count The number of points.
+		 *
+		 * \since v1.0.0
+		 */
+		void Build(PointF const* positions, uint32 count);
+
+		/**
+		 * Removes all items.
+		 *
+		 * \since v1.0.0
+		 */
+		void Clear() noexcept;
+
+		/**
+		 * Inserts an item.
+		 *
+		 * \param position The position of the item.
+		 *
+		 * \returns The handle of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 Insert(PointF const& position);
+
+		/**
+		 * Removes an item.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		void Remove(uint32 item);
+
+		/**
+		 * Moves an item.
+		 *
+		 * \param item The handle of the item.
+		 * \param position The new position of the item.
+		 *
+		 * \since v1.0.0
+		 */
+		void Move(uint32 item, PointF const& position);
+
+		/**
+		 * Sorts all items into the flat arrays of the grid, which
+		 * Insert, Move and Remove do on their own if needed.
+		 *
+		 * \since v1.0.0
+		 */
+		void Rebuild();
+
+		/**
+		 * Finds the items within a distance of a point.
+		 *
+		 * \param center The point.
+		 * \param radius The distance.
+		 * \param items Receives the handles of the items, which are appended.
+		 *
+		 * \returns The number of items found.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryRadius(PointF const& center, float32 radius, std::vector<uint32>& items) const;
+
+		/**
+		 * Finds the items inside a rectangle, including its edges.
+		 *
+		 * \param min The corner with the smallest coordinates.
+		 * \param max The corner with the largest coordinates.
+		 * \param items Receives the handles of the items, which are appended.
+		 *
+		 * \returns The number of items found.
+		 *
+		 * \since v1.0.0
+		 */
+		uint32 QueryRect(PointF const& min, PointF const& max, std::vector<uint32>& items) const;
+
+		/**
+		 * Finds all pairs of items within a distance of each other on
+		 * multiple threads. The grid is sorted first if items are pending.
+		 *
+		 * \param distance The distance.
+		 * \param pairs Receives the pairs, which replace its contents. Each
+		 *              pair is found once.
+		 *
+		 * \since v1.0.0
+		 */
+		void FindPairs(float32 distance, std::vector<SpatialPair>& pairs);
+
+		/**
+		 * Returns the position of an item.
+		 *
+		 * \param item The handle of the item.
+		 *
+		 * \returns The position.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD PointF ECM_CALL GetPosition(uint32 item) const noexcept;
+
+		/**
+		 * Returns the number of items.
+		 *
+		 * \returns The number of items.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD uint32 ECM_CALL GetCount() const noexcept;
+
+		/**
+		 * Returns the size of the cells.
+		 *
+		 * \returns The size of the cells.
+		 *
+		 * \since v1.0.0
+		 */
+		ECM_NODISCARD float32 ECM_CALL GetCellSize() const noexcept;
+	private:
+		struct item_entry
+		{
+			PointF position;
+			// The index into the sorted arrays or into the pending items
+			uint32 slot;
+		};
+
+		template<typename Test>
+		uint32 query(PointF const& min, PointF const& max, Test const& test, std::vector<uint32>& items) const;
+
+		void remove_slot(uint32 item) noexcept;
+
+		void rebuild_if_needed();
+
+		float32 _cellSize;
+		float32 _inverseCellSize;
+		uint32 _count{ 0 };
+		uint32 _removed{ 0 };
+		uint32 _bucketMask{ 0 };
+		std::vector<item_entry> _items;
+		std::vector<uint32> _free;
+		std::vector<uint32> _pending;
+		// The first sorted item of each bucket, and the end of the last one
+		std::vector<uint32> _bucketStart;
+		// The sorted items, whose handle is InvalidItem once they are
+		// removed or moved to another cell
+		std::vector<float32> _x;
+		std::vector<float32> _y;
+		std::vector<int32> _cellX;
+		std::vector<int32> _cellY;
+		std::vector<uint32> _handles;
+	};
+} // namespace ecm::math
+
+#endif // !_ECM_SPATIAL_HASH_H_
@@ -0,0 +1,41 @@
+/**
+ * \file type_traits.h
+ *
+ * \brief This header defines type traits of the math module.
+ */
+
+#pragma once
+#ifndef _ECM_TYPE_TRAITS_H_
+#define _ECM_TYPE_TRAITS_H_
+
+#include <ECM/ECM_api.h>
+#include <ECM/ECM_stdtypes.h>
+
+#include <type_traits>
+
+namespace ecm::math
+{
+	/**
+	 * Checks whether a type can be used as the scalar of vectors and
+	 * matrices. This is true for the built-in arithmetic types, and number
+	 * types like Fixed specialize it to be usable as well.
+	 *
+	 * \tparam T The type to check.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	struct is_arithmetic : std::is_arithmetic<T> {};
+
+	/**
+	 * Helper variable template of is_arithmetic.
+	 *
+	 * \tparam T The type to check.
+	 *
+	 * \since v1.0.0
+	 */
+	template<typename T>
+	inline constexpr bool is_arithmetic_v = is_arithmetic<T>::value;
+} // namespace ecm::math
+
+#endif // !_ECM_TYPE_TRAITS_H_
@@ -8,6 +8,8 @@
 #ifndef _ECM_VECTOR_H_
 #define _ECM_VECTOR_H_
 
+#include <ECM/math/fixed.h>
+#include <ECM/math/float16.h>
 #include <ECM/math/vector2.h>
 #include <ECM/math/vector3.h>
 #include <ECM/math/vector4.h>
@@ -106,6 +108,31 @@ namespace ecm::math
 	 */
 	using Vector2uA = ECM_ALIGN(16) Vector2u;
 
+	/**
+	 * A 2D vector with half-precision floating-point components.
+	 *
+	 * This type alias is used to store 2D data, like texture coordinates, with
+	 * half the memory of Vector2. It is a storage type, which is converted to
+	 * Vector2 for arithmetic.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa float16
+	 */
+	using Vector2h = Vector2_Base<float16>;
+
+	/**
+	 * A 2D vector with Q16.16 fixed-point components.
+	 *
+	 * This type alias is used for deterministic calculations in a 2D
+	 * space, which give the same results on every compiler and CPU.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa Fixed
+	 */
+	using Vector2x = Vector2_Base<Fixed16_16>;
+
 	// Vector3 definitions
 
 	/**
@@ -177,6 +204,18 @@ namespace ecm::math
 	 */
 	using Vector3uA = ECM_ALIGN(16) Vector3u;
 
+	/**
+	 * A 3D vector with Q16.16 fixed-point components.
+	 *
+	 * This type alias is used for deterministic calculations in a 3D
+	 * space, which give the same results on every compiler and CPU.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa Fixed
+	 */
+	using Vector3x = Vector3_Base<Fixed16_16>;
+
 	// Vector4 definitions
 
 	/**
@@ -247,6 +286,31 @@ namespace ecm::math
 	 * \since v1.0.0
 	 */
 	using Vector4uA = ECM_ALIGN(16) Vector4u;
+
+	/**
+	 * A 4D vector with half-precision floating-point components.
+	 *
+	 * This type alias is used to store 4D data, like vertex attributes or
+	 * colors, with half the memory of Vector4. It is a storage type, which is
+	 * converted to Vector4 for arithmetic.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa float16
+	 */
+	using Vector4h = Vector4_Base<float16>;
+
+	/**
+	 * A 4D vector with Q16.16 fixed-point components.
+	 *
+	 * This type alias is used for deterministic calculations in a 4D
+	 * space, which give the same results on every compiler and CPU.
+	 *
+	 * \since v1.0.0
+	 *
+	 * \sa Fixed
+	 */
+	using Vector4x = Vector4_Base<Fixed16_16>;
 } // namespace ecm::math
 
 #endif // !_ECM_VECTOR_H_
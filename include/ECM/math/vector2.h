@@ -10,6 +10,7 @@
 
 #include <ECM/ECM_api.h>
 #include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
 
 #include <type_traits>
 
@@ -186,7 +187,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator=(Vector2_Base<U> const& v);
 
 		/**
@@ -200,7 +201,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator+=(U scalar);
 
 		/**
@@ -215,7 +216,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator+=(Vector2_Base<U> const& v);
 
 		/**
@@ -229,7 +230,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator-=(U scalar);
 
 		/**
@@ -244,7 +245,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator-=(Vector2_Base<U> const& v);
 
 		/**
@@ -258,7 +259,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator*=(U scalar);
 
 		/**
@@ -273,7 +274,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator*=(Vector2_Base<U> const& v);
 
 		/**
@@ -287,7 +288,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator/=(U scalar);
 
 		/**
@@ -302,7 +303,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector2_Base<T>& operator/=(Vector2_Base<U> const& v);
 
 		// Increment and decrement operators
@@ -450,7 +451,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator+(Vector2_Base<T> const& v, U scalar);
 
 	/**
@@ -467,7 +468,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator+(Vector2_Base<T> const& v1, Vector2_Base<U> const& v2);
 
 	/**
@@ -484,7 +485,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator-(Vector2_Base<T> const& v, U scalar);
 
 	/**
@@ -501,7 +502,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator-(Vector2_Base<T> const& v1, Vector2_Base<U> const& v2);
 
 	/**
@@ -519,7 +520,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator*(Vector2_Base<T> const& v, U scalar);
 
 	/**
@@ -537,7 +538,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator*(Vector2_Base<T> const& v1, Vector2_Base<U> const& v2);
 
 	/**
@@ -554,7 +555,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator/(Vector2_Base<T> const& v, U scalar);
 
 	/**
@@ -571,7 +572,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector2_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector2_Base<T> operator/(Vector2_Base<T> const& v1, Vector2_Base<U> const& v2);
 } // namespace ecm::math
 
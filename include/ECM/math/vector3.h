@@ -10,6 +10,7 @@
 
 #include <ECM/ECM_api.h>
 #include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
 
 #include <type_traits>
 
@@ -182,7 +183,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator=(Vector3_Base<U> const& v);
 
 		/**
@@ -196,7 +197,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator+=(U scalar);
 
 		/**
@@ -211,7 +212,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator+=(Vector3_Base<U> const& scalar);
 
 		/**
@@ -225,7 +226,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator-=(U scalar);
 
 		/**
@@ -240,7 +241,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator-=(Vector3_Base<U> const& scalar);
 
 		/**
@@ -254,7 +255,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator*=(U scalar);
 
 		/**
@@ -269,7 +270,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator*=(Vector3_Base<U> const& scalar);
 
 		/**
@@ -283,7 +284,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator/=(U scalar);
 
 		/**
@@ -298,7 +299,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector3_Base<T>& operator/=(Vector3_Base<U> const& scalar);
 
 		// Increment and decrement operators
@@ -446,7 +447,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator+(Vector3_Base<T> const& v, U scalar);
 
 	/**
@@ -463,7 +464,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator+(Vector3_Base<T> const& v1, Vector3_Base<U> const& v2);
 
 	/**
@@ -480,7 +481,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator-(Vector3_Base<T> const& v, U scalar);
 
 	/**
@@ -497,7 +498,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator-(Vector3_Base<T> const& v1, Vector3_Base<U> const& v2);
 
 	/**
@@ -515,7 +516,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator*(Vector3_Base<T> const& v, U scalar);
 
 	/**
@@ -533,7 +534,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator*(Vector3_Base<T> const& v1, Vector3_Base<U> const& v2);
 
 	/**
@@ -550,7 +551,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator/(Vector3_Base<T> const& v, U scalar);
 
 	/**
@@ -567,7 +568,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector3_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector3_Base<T> operator/(Vector3_Base<T> const& v1, Vector3_Base<U> const& v2);
 } // namespace ecm::math
 
@@ -208,7 +208,7 @@ namespace ecm::math
 	template<typename T>
 	constexpr bool operator==(Vector3_Base<T> const& v1, Vector3_Base<T> const& v2)
 	{
-		if (v1.x == v2.y) {
+		if (v1.x == v2.x) {
 			if (v1.y == v2.y) {
 				if (v1.z == v2.z) {
 					return true;
@@ -10,6 +10,7 @@
 
 #include <ECM/ECM_api.h>
 #include <ECM/ECM_stdtypes.h>
+#include <ECM/math/type_traits.h>
 
 #include <type_traits>
 
@@ -188,7 +189,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator=(Vector4_Base<U> const& v);
 
 		/**
@@ -202,7 +203,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator+=(U scalar);
 
 		/**
@@ -217,7 +218,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator+=(Vector4_Base<U> const& v);
 
 		/**
@@ -231,7 +232,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator-=(U scalar);
 
 		/**
@@ -246,7 +247,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator-=(Vector4_Base<U> const& v);
 
 		/**
@@ -260,7 +261,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator*=(U scalar);
 
 		/**
@@ -275,7 +276,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator*=(Vector4_Base<U> const& v);
 
 		/**
@@ -289,7 +290,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator/=(U scalar);
 
 		/**
@@ -304,7 +305,7 @@ namespace ecm::math
 		 *
 		 * \since v1.0.0
 		 */
-		template<typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+		template<typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 		constexpr Vector4_Base<T>& operator/=(Vector4_Base<U> const& v);
 
 		// Increment and decrement operators
@@ -452,7 +453,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator+(Vector4_Base<T> const& v, U scalar);
 
 	/**
@@ -469,7 +470,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator+(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2);
 
 	/**
@@ -486,7 +487,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator-(Vector4_Base<T> const& v, U scalar);
 
 	/**
@@ -503,7 +504,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator-(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2);
 
 	/**
@@ -521,7 +522,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator*(Vector4_Base<T> const& v, U scalar);
 
 	/**
@@ -539,7 +540,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator*(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2);
 
 	/**
@@ -556,7 +557,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator/(Vector4_Base<T> const& v, U scalar);
 
 	/**
@@ -573,7 +574,7 @@ namespace ecm::math
 	 *
 	 * \sa Vector4_Base
 	 */
-	template<typename T, typename U, typename = std::enable_if_t<std::is_arithmetic<U>::value>>
+	template<typename T, typename U, typename = std::enable_if_t<is_arithmetic_v<U>>>
 	constexpr Vector4_Base<T> operator/(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2);
 } // namespace ecm::math
 
@@ -1,12 +1,41 @@
 #pragma once
 
 #include <ECM/math/vector4.h>
+#include <ECM/math/functions_simd.h>
 
 #pragma warning(push)
 #pragma warning(disable : 26495)
 
 namespace ecm::math
 {
+	namespace detail
+	{
+		// 32-bit integer vectors fit exactly into a 128-bit SSE register.
+		template<typename T, typename U>
+		struct is_simd_int4
+		{
+			static constexpr bool value = ECM_SIMD_SSE2 && std::is_same_v<T, U> &&
+				(std::is_same_v<T, int32> || std::is_same_v<T, uint32>);
+		};
+
+		template<typename T, typename U>
+		constexpr bool is_simd_int4_v = is_simd_int4<T, U>::value;
+
+		template<typename T>
+		ECM_FORCEINLINE __m128i load_int4(Vector4_Base<T> const& v)
+		{
+			return _mm_loadu_si128(reinterpret_cast<__m128i const*>(v.coord));
+		}
+
+		template<typename T>
+		ECM_FORCEINLINE Vector4_Base<T> store_int4(__m128i v)
+		{
+			Vector4_Base<T> result;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result.coord), v);
+			return result;
+		}
+	} // namespace detail
+
 	// Basic constructors
 
 	template<typename T>
@@ -106,6 +135,11 @@ namespace ecm::math
 	template<typename U, typename>
 	constexpr Vector4_Base<T>& Vector4_Base<T>::operator+=(Vector4_Base<U> const& v)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return *this = detail::store_int4<T>(_mm_add_epi32(detail::load_int4(*this), detail::load_int4(v)));
+			}
+		}
 		this->x += static_cast<T>(v.x);
 		this->y += static_cast<T>(v.y);
 		this->z += static_cast<T>(v.z);
@@ -128,6 +162,11 @@ namespace ecm::math
 	template<typename U, typename>
 	constexpr Vector4_Base<T>& Vector4_Base<T>::operator-=(Vector4_Base<U> const& v)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return *this = detail::store_int4<T>(_mm_sub_epi32(detail::load_int4(*this), detail::load_int4(v)));
+			}
+		}
 		this->x -= static_cast<T>(v.x);
 		this->y -= static_cast<T>(v.y);
 		this->z -= static_cast<T>(v.z);
@@ -150,6 +189,11 @@ namespace ecm::math
 	template<typename U, typename>
 	constexpr Vector4_Base<T>& Vector4_Base<T>::operator*=(Vector4_Base<U> const& v)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return *this = detail::store_int4<T>(MulLo(detail::load_int4(*this), detail::load_int4(v)));
+			}
+		}
 		this->x *= static_cast<T>(v.x);
 		this->y *= static_cast<T>(v.y);
 		this->z *= static_cast<T>(v.z);
@@ -222,6 +266,12 @@ namespace ecm::math
 	template<typename T>
 	constexpr bool operator==(Vector4_Base<T> const& v1, Vector4_Base<T> const& v2)
 	{
+		if constexpr (detail::is_simd_int4_v<T, T>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				const __m128i mask{ _mm_cmpeq_epi32(detail::load_int4(v1), detail::load_int4(v2)) };
+				return _mm_movemask_epi8(mask) == 0xffff;
+			}
+		}
 		if (v1.x == v2.x) {
 			if (v1.y == v2.y) {
 				if (v1.z == v2.z) {
@@ -279,6 +329,11 @@ namespace ecm::math
 	template<typename T, typename U, typename>
 	constexpr Vector4_Base<T> operator+(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::store_int4<T>(_mm_add_epi32(detail::load_int4(v1), detail::load_int4(v2)));
+			}
+		}
 		return Vector4_Base<T>(
 			static_cast<T>(v1.x + v2.x),
 			static_cast<T>(v1.y + v2.y),
@@ -299,6 +354,11 @@ namespace ecm::math
 	template<typename T, typename U, typename>
 	constexpr Vector4_Base<T> operator-(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::store_int4<T>(_mm_sub_epi32(detail::load_int4(v1), detail::load_int4(v2)));
+			}
+		}
 		return Vector4_Base<T>(
 			static_cast<T>(v1.x - v2.x),
 			static_cast<T>(v1.y - v2.y),
@@ -319,6 +379,11 @@ namespace ecm::math
 	template<typename T, typename U, typename>
 	constexpr Vector4_Base<T> operator*(Vector4_Base<T> const& v1, Vector4_Base<U> const& v2)
 	{
+		if constexpr (detail::is_simd_int4_v<T, U>) {
+			if (!ECM_IS_CONSTANT_EVALUATED()) {
+				return detail::store_int4<T>(MulLo(detail::load_int4(v1), detail::load_int4(v2)));
+			}
+		}
 		return Vector4_Base<T>(
 			static_cast<T>(v1.x * v2.x),
 			static_cast<T>(v1.y * v2.y),
@@ -0,0 +1,279 @@
+#include <ECM/math/animation.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The number of tracks, whose keys are gathered before they are
+		// interpolated
+		constexpr uint64 BlockSize{ 64 };
+
+		// The gathered segments of a block of tracks. The components are
+		// arrays of BlockSize lanes.
+		struct segment_block
+		{
+			float32 u[BlockSize];
+			float32 cubic[BlockSize];
+			float32 p0[4 * BlockSize];
+			float32 p1[4 * BlockSize];
+			float32 m0[4 * BlockSize];
+			float32 m1[4 * BlockSize];
+		};
+
+		// The kernels use the lane types of simd_lanes.h, so SampleAll and
+		// Sample give the same values.
+
+		// Finds the segment [times[k], times[k + 1]] of the time. The cursor
+		// and its next segment are tried before the binary search. Times
+		// outside of the keys give the first or the last segment.
+		inline uint32 find_segment(detail::track_view const& track, float32 time, uint32 cursor)
+		{
+			float32 const* times{ track.times };
+			const uint32 segments{ track.count - 1 };
+			const uint32 k{ cursor < segments ? cursor : segments - 1 };
+			if (time >= times[k]) {
+				if (k + 1 == segments || time < times[k + 1])
+					return k;
+				if (k + 2 == segments || time < times[k + 2])
+					return k + 1;
+			}
+			else if (k == 0)
+				return 0;
+			// The number of inner keys up to the time
+			return static_cast<uint32>(std::upper_bound(times + 1, times + segments, time) - (times + 1));
+		}
+
+		// Starts loading the keys at the cursors of the tracks
+		inline void prefetch_keys(detail::track_view const* tracks, uint32 const* cursors, uint32 components,
+			uint64 begin, uint64 end)
+		{
+			for (uint64 i{ begin }; i < end; ++i) {
+				detail::track_view const& track{ tracks[i] };
+				const uint64 k{ cursors && cursors[i] < track.count ? cursors[i] : 0 };
+				_mm_prefetch(reinterpret_cast<char const*>(track.times + k), _MM_HINT_T0);
+				_mm_prefetch(reinterpret_cast<char const*>(track.values + k * components), _MM_HINT_T0);
+				if (track.tangents)
+					_mm_prefetch(reinterpret_cast<char const*>(track.tangents + (2 * k + 1) * components), _MM_HINT_T0);
+			}
+		}
+
+		// Gathers the keys of the segment of the time, with the components
+		// stride floats apart, and returns if the segment is cubic. Only
+		// cubic segments have tangents, which are scaled to the length of
+		// the segment. STEP segments have a factor of 0 or 1.
+		template<uint32 N, bool Rotation>
+		inline bool gather_segment(detail::track_view const& track, float32 time, uint32* cursor, float32& u,
+			float32* p0, float32* p1, float32* m0, float32* m1, uint64 stride)
+		{
+			if (track.count < 2) {
+				u = 0.f;
+				for (uint32 c{ 0 }; c < N; ++c) {
+					const float32 identity{ Rotation && c == 3 ? 1.f : 0.f };
+					p0[c * stride] = track.count == 0 ? identity : track.values[c];
+					p1[c * stride] = p0[c * stride];
+				}
+				return false;
+			}
+
+			const uint32 k{ find_segment(track, time, cursor ? *cursor : 0) };
+			if (cursor)
+				*cursor = k;
+			const float32 length{ track.times[k + 1] - track.times[k] };
+			const float32 t{ (time - track.times[k]) / length };
+			// NaN gives 0
+			u = t > 0.f ? (t < 1.f ? t : 1.f) : 0.f;
+			float32 const* values{ track.values + k * N };
+			for (uint32 c{ 0 }; c < N; ++c) {
+				p0[c * stride] = values[c];
+				p1[c * stride] = values[N + c];
+			}
+			if (track.type == InterpolationType::STEP)
+				u = u >= 1.f ? 1.f : 0.f;
+			if (track.type != InterpolationType::HERMITE && track.type != InterpolationType::CATMULL_ROM)
+				return false;
+			// The out-tangent of the key and the in-tangent of the next one
+			float32 const* tangents{ track.tangents + (2 * k + 1) * N };
+			for (uint32 c{ 0 }; c < N; ++c) {
+				m0[c * stride] = tangents[c] * length;
+				m1[c * stride] = tangents[N + c] * length;
+			}
+			return true;
+		}
+
+		// Interpolates linearly, or with the cubic Hermite basis where cubic
+		// is set. Linear segments give the same values, if Cubic is false
+		// and the tangents are not read.
+		template<uint32 N, bool Rotation, bool Cubic, typename F, typename M>
+		inline void interpolate(F u, M cubic, F const* p0, F const* p1, F const* m0, F const* m1, F* values)
+		{
+			const F s{ F(1.f) - u };
+			for (uint32 c{ 0 }; c < N; ++c)
+				values[c] = s * p0[c] + u * p1[c];
+			if constexpr (Cubic) {
+				const F h00{ (F(1.f) + F(2.f) * u) * s * s };
+				const F h01{ u * u * (F(3.f) - F(2.f) * u) };
+				const F h10{ u * s * s };
+				const F h11{ u * u * (u - F(1.f)) };
+				for (uint32 c{ 0 }; c < N; ++c)
+					values[c] = lane_select(cubic, h00 * p0[c] + h01 * p1[c] + h10 * m0[c] + h11 * m1[c], values[c]);
+			}
+			if constexpr (Rotation) {
+				const F length{ lane_sqrt(values[0] * values[0] + values[1] * values[1]
+					+ values[2] * values[2] + values[3] * values[3]) };
+				for (uint32 c{ 0 }; c < 4; ++c)
+					values[c] = values[c] / length;
+			}
+		}
+
+		// Interpolates the lanes of a block starting at i, and stores the
+		// values in p0
+		template<uint32 N, bool Rotation, bool Cubic>
+		inline void interpolate_lanes(segment_block& block, uint64 i)
+		{
+			vfloat p0[N];
+			vfloat p1[N];
+			vfloat m0[N];
+			vfloat m1[N];
+			for (uint32 c{ 0 }; c < N; ++c) {
+				p0[c] = loadu_ps(block.p0 + c * BlockSize + i);
+				p1[c] = loadu_ps(block.p1 + c * BlockSize + i);
+				if constexpr (Cubic) {
+					m0[c] = loadu_ps(block.m0 + c * BlockSize + i);
+					m1[c] = loadu_ps(block.m1 + c * BlockSize + i);
+				}
+			}
+			vfloat values[N];
+			interpolate<N, Rotation, Cubic>(vfloat(loadu_ps(block.u + i)),
+				vfloat(loadu_ps(block.cubic + i)) > vfloat(0.f), p0, p1, m0, m1, values);
+			for (uint32 c{ 0 }; c < N; ++c)
+				storeu_ps(block.p0 + c * BlockSize + i, values[c].v);
+		}
+
+		template<uint32 N, bool Rotation>
+		void sample_one(detail::track_view const& track, float32 time, uint32* cursor, float32* out)
+		{
+			float32 u;
+			float32 p0[N];
+			float32 p1[N];
+			float32 m0[N];
+			float32 m1[N];
+			if (gather_segment<N, Rotation>(track, time, cursor, u, p0, p1, m0, m1, 1))
+				interpolate<N, Rotation, true>(u, true, p0, p1, m0, m1, out);
+			else
+				interpolate<N, Rotation, false>(u, false, p0, p1, m0, m1, out);
+		}
+
+		template<uint32 N, bool Rotation>
+		void sample_many(detail::track_view const* tracks, uint64 count, float32 time, uint32* cursors, float32* out)
+		{
+			segment_block block;
+			prefetch_keys(tracks, cursors, N, 0, std::min(BlockSize, count));
+			for (uint64 b{ 0 }; b < count; b += BlockSize) {
+				const uint64 n{ std::min(count - b, BlockSize) };
+				// The keys of the tracks are in separate allocations, so the
+				// loads of the next block start before this one is gathered
+				prefetch_keys(tracks, cursors, N, std::min(b + BlockSize, count), std::min(b + 2 * BlockSize, count));
+				bool cubic{ false };
+				for (uint64 j{ 0 }; j < n; ++j) {
+					const bool segmentCubic{ gather_segment<N, Rotation>(tracks[b + j], time,
+						cursors ? cursors + b + j : nullptr, block.u[j], block.p0 + j, block.p1 + j, block.m0 + j,
+						block.m1 + j, BlockSize) };
+					block.cubic[j] = segmentCubic ? 1.f : 0.f;
+					cubic = cubic || segmentCubic;
+				}
+
+				uint64 i{ 0 };
+				if (cubic) {
+					// The tangents of the linear lanes are not selected, but
+					// they must be numbers
+					for (uint64 j{ 0 }; j < n; ++j) {
+						if (block.cubic[j] > 0.f)
+							continue;
+						for (uint32 c{ 0 }; c < N; ++c) {
+							block.m0[c * BlockSize + j] = 0.f;
+							block.m1[c * BlockSize + j] = 0.f;
+						}
+					}
+					for (; i + LaneCount <= n; i += LaneCount)
+						interpolate_lanes<N, Rotation, true>(block, i);
+				}
+				else {
+					for (; i + LaneCount <= n; i += LaneCount)
+						interpolate_lanes<N, Rotation, false>(block, i);
+				}
+				for (; i < n; ++i) {
+					float32 p0[N];
+					float32 p1[N];
+					float32 m0[N];
+					float32 m1[N];
+					for (uint32 c{ 0 }; c < N; ++c) {
+						p0[c] = block.p0[c * BlockSize + i];
+						p1[c] = block.p1[c * BlockSize + i];
+						m0[c] = block.m0[c * BlockSize + i];
+						m1[c] = block.m1[c * BlockSize + i];
+					}
+					float32 lane[N];
+					if (block.cubic[i] > 0.f)
+						interpolate<N, Rotation, true>(block.u[i], true, p0, p1, m0, m1, lane);
+					else
+						interpolate<N, Rotation, false>(block.u[i], false, p0, p1, m0, m1, lane);
+					for (uint32 c{ 0 }; c < N; ++c)
+						block.p0[c * BlockSize + i] = lane[c];
+				}
+
+				float32* values{ out + b * N };
+				for (uint64 j{ 0 }; j < n; ++j) {
+					for (uint32 c{ 0 }; c < N; ++c)
+						values[j * N + c] = block.p0[c * BlockSize + j];
+				}
+			}
+		}
+
+		// Calls the kernel for the number of components
+		template<typename Function>
+		inline void visit_components(uint32 components, bool rotation, Function const& function)
+		{
+			switch (components) {
+			case 1:
+				function(std::integral_constant<uint32, 1>{}, std::false_type{});
+				break;
+			case 2:
+				function(std::integral_constant<uint32, 2>{}, std::false_type{});
+				break;
+			case 3:
+				function(std::integral_constant<uint32, 3>{}, std::false_type{});
+				break;
+			default:
+				if (rotation)
+					function(std::integral_constant<uint32, 4>{}, std::true_type{});
+				else
+					function(std::integral_constant<uint32, 4>{}, std::false_type{});
+				break;
+			}
+		}
+	} // anonymous namespace
+
+	namespace detail
+	{
+		void sample_track(track_view const& track, uint32 components, bool rotation, float32 time, uint32* cursor,
+			float32* out) noexcept
+		{
+			visit_components(components, rotation, [&](auto n, auto r) {
+				sample_one<decltype(n)::value, decltype(r)::value>(track, time, cursor, out);
+			});
+		}
+
+		void sample_tracks(track_view const* tracks, uint64 count, uint32 components, bool rotation, float32 time,
+			uint32* cursors, float32* out) noexcept
+		{
+			visit_components(components, rotation, [&](auto n, auto r) {
+				sample_many<decltype(n)::value, decltype(r)::value>(tracks, count, time, cursors, out);
+			});
+		}
+	} // namespace detail
+} // namespace ecm::math
@@ -0,0 +1,123 @@
+#include <ECM/math/bounds.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint64 PointGrain{ 16384 };
+		constexpr uint64 MaxChunks{ 256 };
+
+		static_assert(sizeof(Vector3_Base<float32>) == 3 * sizeof(float32),
+			"The points must be packed floats");
+
+		// Computes the box of interleaved points. Each load takes the x, y
+		// and z components of LaneCount points in three registers, whose
+		// lane j holds the component j % 3 of the block.
+		AABB_Base<float32> bounds_interleaved(float32 const* points, uint64 count)
+		{
+			AABB_Base<float32> result;
+			uint64 i{ 0 };
+			if (count >= LaneCount) {
+				vfloat mins[3];
+				vfloat maxs[3];
+				for (uint8 k{ 0 }; k < 3; ++k)
+					mins[k] = maxs[k] = loadu_ps(points + k * LaneCount);
+				for (i = LaneCount; i + LaneCount <= count; i += LaneCount) {
+					for (uint8 k{ 0 }; k < 3; ++k) {
+						const vfloat v{ loadu_ps(points + i * 3 + k * LaneCount) };
+						mins[k] = lane_min(mins[k], v);
+						maxs[k] = lane_max(maxs[k], v);
+					}
+				}
+				ECM_ALIGN(32) float32 lanesMin[3 * LaneCount];
+				ECM_ALIGN(32) float32 lanesMax[3 * LaneCount];
+				for (uint8 k{ 0 }; k < 3; ++k) {
+					store_ps(lanesMin + k * LaneCount, mins[k].v);
+					store_ps(lanesMax + k * LaneCount, maxs[k].v);
+				}
+				for (uint32 j{ 0 }; j < 3 * LaneCount; ++j) {
+					result.min[j % 3] = lane_min(result.min[j % 3], lanesMin[j]);
+					result.max[j % 3] = lane_max(result.max[j % 3], lanesMax[j]);
+				}
+			}
+			for (; i < count; ++i) {
+				for (uint8 c{ 0 }; c < 3; ++c) {
+					result.min[c] = lane_min(result.min[c], points[i * 3 + c]);
+					result.max[c] = lane_max(result.max[c], points[i * 3 + c]);
+				}
+			}
+			return result;
+		}
+
+		// Computes the range of one component array
+		void bounds_axis(float32 const* values, uint64 count, float32& min, float32& max)
+		{
+			uint64 i{ 0 };
+			if (count >= LaneCount) {
+				vfloat laneMin{ loadu_ps(values) };
+				vfloat laneMax{ laneMin };
+				for (i = LaneCount; i + LaneCount <= count; i += LaneCount) {
+					const vfloat v{ loadu_ps(values + i) };
+					laneMin = lane_min(laneMin, v);
+					laneMax = lane_max(laneMax, v);
+				}
+				ECM_ALIGN(32) float32 lanesMin[LaneCount];
+				ECM_ALIGN(32) float32 lanesMax[LaneCount];
+				store_ps(lanesMin, laneMin.v);
+				store_ps(lanesMax, laneMax.v);
+				for (uint32 j{ 0 }; j < LaneCount; ++j) {
+					min = lane_min(min, lanesMin[j]);
+					max = lane_max(max, lanesMax[j]);
+				}
+			}
+			for (; i < count; ++i) {
+				min = lane_min(min, values[i]);
+				max = lane_max(max, values[i]);
+			}
+		}
+
+		// Splits the points into at most MaxChunks chunks, computes the box
+		// of each chunk on the threads and merges the boxes.
+		template<typename Function>
+		AABB_Base<float32> bounds(uint64 count, Function&& function)
+		{
+			const uint64 chunk{ std::max(PointGrain, (count + MaxChunks - 1) / MaxChunks) };
+			const uint64 chunkCount{ (count + chunk - 1) / chunk };
+			if (chunkCount <= 1)
+				return function(0, count);
+			AABB_Base<float32> partial[MaxChunks];
+			ParallelFor(0, chunkCount, 1, [&](uint64 begin, uint64 end) {
+				for (uint64 c{ begin }; c < end; ++c)
+					partial[c] = function(c * chunk, std::min(count, (c + 1) * chunk));
+			});
+			AABB_Base<float32> result;
+			for (uint64 c{ 0 }; c < chunkCount; ++c)
+				result = Merge(result, partial[c]);
+			return result;
+		}
+	} // anonymous namespace
+
+	AABB_Base<float32> ComputeBounds(Vector3_Base<float32> const* points, uint64 count) noexcept
+	{
+		float32 const* values{ reinterpret_cast<float32 const*>(points) };
+		return bounds(count, [values](uint64 begin, uint64 end) {
+			return bounds_interleaved(values + begin * 3, end - begin);
+		});
+	}
+
+	AABB_Base<float32> ComputeBounds(float32 const* x, float32 const* y, float32 const* z, uint64 count) noexcept
+	{
+		return bounds(count, [x, y, z](uint64 begin, uint64 end) {
+			AABB_Base<float32> result;
+			bounds_axis(x + begin, end - begin, result.min.x, result.max.x);
+			bounds_axis(y + begin, end - begin, result.min.y, result.max.y);
+			bounds_axis(z + begin, end - begin, result.min.z, result.max.z);
+			return result;
+		});
+	}
+} // namespace ecm::math
@@ -0,0 +1,665 @@
+#include <ECM/math/bvh.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint32 BinCount{ 16 };
+		constexpr uint32 MaxLeafSize{ 4 };
+		// Ranges above this size are measured and binned on the threads
+		constexpr uint64 ParallelThreshold{ 1ull << 16 };
+		constexpr uint64 BinGrain{ 1ull << 14 };
+		// Subtrees below this size are built by one thread
+		constexpr uint64 MinSubtreeSize{ 4096 };
+		constexpr uint64 RayGrain{ 256 };
+		// The traversal stack on the stack of the thread. Deeper trees get
+		// one on the heap.
+		constexpr uint32 StackSize{ 256 };
+		constexpr uint32 InvalidChild{ 0xffffffffu };
+
+		// A node of the binary tree over the references [first, first +
+		// count). The children of a node are at left and left + 1, and
+		// leaves have no left child, since the root is no child.
+		struct build_node
+		{
+			AABB_Base<float32> bounds;
+			uint32 first{ 0 };
+			uint32 count{ 0 };
+			uint32 left{ 0 };
+		};
+
+		struct build_context
+		{
+			// The box of each triangle
+			std::vector<AABB_Base<float32>> boxes;
+			// The triangles in the order of the leaves
+			std::vector<uint32> references;
+		};
+
+		struct range_info
+		{
+			AABB_Base<float32> bounds;
+			AABB_Base<float32> centroids;
+		};
+
+		struct bin
+		{
+			AABB_Base<float32> bounds;
+			uint32 count{ 0 };
+		};
+
+		inline float32 half_area(AABB_Base<float32> const& box)
+		{
+			if (IsEmpty(box))
+				return 0.f;
+			const float32 x{ box.max.x - box.min.x };
+			const float32 y{ box.max.y - box.min.y };
+			const float32 z{ box.max.z - box.min.z };
+			return x * y + y * z + z * x;
+		}
+
+		inline float32 centroid(AABB_Base<float32> const& box, uint32 axis)
+		{
+			return (box.min[axis] + box.max[axis]) * 0.5f;
+		}
+
+		inline uint32 bin_index(float32 c, float32 min, float32 scale)
+		{
+			return std::min(BinCount - 1, static_cast<uint32>((c - min) * scale));
+		}
+
+		// Runs a function, which processes the references [begin, end) into
+		// a partial result, on chunks of the range. Large ranges run on the
+		// threads, and the partial results are combined in order.
+		template<typename T, typename Function, typename Combine>
+		T reduce_range(uint64 begin, uint64 end, Function const& function, Combine const& combine)
+		{
+			if (end - begin <= ParallelThreshold)
+				return function(begin, end);
+			const uint64 chunkCount{ (end - begin + BinGrain - 1) / BinGrain };
+			std::vector<T> partial(chunkCount);
+			ParallelFor(begin, end, BinGrain, [&](uint64 chunkBegin, uint64 chunkEnd) {
+				partial[(chunkBegin - begin) / BinGrain] = function(chunkBegin, chunkEnd);
+			});
+			T result{ partial[0] };
+			for (uint64 c{ 1 }; c < chunkCount; ++c)
+				combine(result, partial[c]);
+			return result;
+		}
+
+		range_info measure(build_context const& context, uint64 begin, uint64 end)
+		{
+			return reduce_range<range_info>(begin, end, [&context](uint64 chunkBegin, uint64 chunkEnd) {
+				range_info info;
+				for (uint64 i{ chunkBegin }; i < chunkEnd; ++i) {
+					AABB_Base<float32> const& box{ context.boxes[context.references[i]] };
+					const Vector3_Base<float32> c(centroid(box, 0), centroid(box, 1), centroid(box, 2));
+					info.bounds = Merge(info.bounds, box);
+					info.centroids = Merge(info.centroids, c);
+				}
+				return info;
+			}, [](range_info& result, range_info const& info) {
+				result.bounds = Merge(result.bounds, info.bounds);
+				result.centroids = Merge(result.centroids, info.centroids);
+			});
+		}
+
+		struct bins
+		{
+			bin axes[3][BinCount];
+		};
+
+		// Splits the references [begin, end) with the surface area heuristic,
+		// and returns the end of the left half, or begin if the range is a
+		// leaf
+		uint64 split_range(build_context& context, uint64 begin, uint64 end, AABB_Base<float32>& bounds)
+		{
+			const range_info info{ measure(context, begin, end) };
+			bounds = info.bounds;
+			// The wide nodes have leaves of up to MaxLeafSize triangles
+			// anyway
+			const uint64 count{ end - begin };
+			if (count <= MaxLeafSize)
+				return begin;
+
+			float32 scale[3];
+			for (uint32 a{ 0 }; a < 3; ++a) {
+				const float32 extent{ info.centroids.max[a] - info.centroids.min[a] };
+				scale[a] = extent > 0.f ? static_cast<float32>(BinCount) / extent : 0.f;
+			}
+			const bins binned{ reduce_range<bins>(begin, end, [&](uint64 chunkBegin, uint64 chunkEnd) {
+				bins result;
+				for (uint64 i{ chunkBegin }; i < chunkEnd; ++i) {
+					AABB_Base<float32> const& box{ context.boxes[context.references[i]] };
+					for (uint32 a{ 0 }; a < 3; ++a) {
+						bin& b{ result.axes[a][bin_index(centroid(box, a), info.centroids.min[a], scale[a])] };
+						b.bounds = Merge(b.bounds, box);
+						++b.count;
+					}
+				}
+				return result;
+			}, [](bins& result, bins const& partial) {
+				for (uint32 a{ 0 }; a < 3; ++a) {
+					for (uint32 b{ 0 }; b < BinCount; ++b) {
+						result.axes[a][b].bounds = Merge(result.axes[a][b].bounds, partial.axes[a][b].bounds);
+						result.axes[a][b].count += partial.axes[a][b].count;
+					}
+				}
+			}) };
+
+			// Sweeps the bins of each axis for the cheapest split between
+			// bins [0, split) and [split, BinCount)
+			float32 bestCost{ std::numeric_limits<float32>::infinity() };
+			uint32 bestAxis{ 0 };
+			uint32 bestSplit{ 0 };
+			for (uint32 a{ 0 }; a < 3; ++a) {
+				if (scale[a] == 0.f)
+					continue;
+				float32 leftCost[BinCount];
+				AABB_Base<float32> leftBox;
+				uint32 leftCount{ 0 };
+				for (uint32 b{ 0 }; b < BinCount - 1; ++b) {
+					leftBox = Merge(leftBox, binned.axes[a][b].bounds);
+					leftCount += binned.axes[a][b].count;
+					leftCost[b] = half_area(leftBox) * static_cast<float32>(leftCount);
+				}
+				AABB_Base<float32> rightBox;
+				uint32 rightCount{ 0 };
+				for (uint32 b{ BinCount - 1 }; b > 0; --b) {
+					rightBox = Merge(rightBox, binned.axes[a][b].bounds);
+					rightCount += binned.axes[a][b].count;
+					if (rightCount == 0 || rightCount == count)
+						continue;
+					const float32 cost{ leftCost[b - 1] + half_area(rightBox) * static_cast<float32>(rightCount) };
+					if (cost < bestCost) {
+						bestCost = cost;
+						bestAxis = a;
+						bestSplit = b;
+					}
+				}
+			}
+
+			if (bestSplit != 0) {
+				uint32* first{ context.references.data() + begin };
+				uint32* middle{ std::partition(first, context.references.data() + end, [&](uint32 reference) {
+					return bin_index(centroid(context.boxes[reference], bestAxis), info.centroids.min[bestAxis],
+						scale[bestAxis]) < bestSplit;
+				}) };
+				return begin + static_cast<uint64>(middle - first);
+			}
+			// The centroids are in one point, so the order doesn't matter
+			return begin + count / 2;
+		}
+
+		// Builds the subtree of a node over the references [begin, end)
+		void build_subtree(build_context& context, std::vector<build_node>& nodes, uint32 node, uint64 begin,
+			uint64 end)
+		{
+			AABB_Base<float32> bounds;
+			const uint64 middle{ split_range(context, begin, end, bounds) };
+			nodes[node].bounds = bounds;
+			nodes[node].first = static_cast<uint32>(begin);
+			nodes[node].count = static_cast<uint32>(end - begin);
+			if (middle == begin)
+				return;
+			const uint32 left{ static_cast<uint32>(nodes.size()) };
+			nodes.resize(nodes.size() + 2);
+			nodes[node].left = left;
+			build_subtree(context, nodes, left, begin, middle);
+			build_subtree(context, nodes, left + 1, middle, end);
+		}
+
+		struct build_task
+		{
+			uint64 begin;
+			uint64 end;
+			uint32 node;
+		};
+
+		// Splits the large ranges level by level with binning on the
+		// threads, and then builds the subtrees of the small ranges on the
+		// threads
+		std::vector<build_node> build_tree(build_context& context)
+		{
+			const uint64 count{ context.references.size() };
+			const uint64 threads{ GetParallelThreadCount() };
+			const uint64 subtreeSize{ threads > 1 ? std::max(MinSubtreeSize, count / (threads * 8)) : count };
+			std::vector<build_node> nodes(1);
+			std::vector<build_task> tasks{ { 0, count, 0 } };
+			std::vector<build_task> subtrees;
+			while (!tasks.empty()) {
+				std::vector<build_task> next;
+				for (build_task const& task : tasks) {
+					if (task.end - task.begin <= subtreeSize) {
+						subtrees.push_back(task);
+						continue;
+					}
+					AABB_Base<float32> bounds;
+					const uint64 middle{ split_range(context, task.begin, task.end, bounds) };
+					nodes[task.node].bounds = bounds;
+					nodes[task.node].first = static_cast<uint32>(task.begin);
+					nodes[task.node].count = static_cast<uint32>(task.end - task.begin);
+					const uint32 left{ static_cast<uint32>(nodes.size()) };
+					nodes.resize(nodes.size() + 2);
+					nodes[task.node].left = left;
+					next.push_back({ task.begin, middle, left });
+					next.push_back({ middle, task.end, left + 1 });
+				}
+				tasks.swap(next);
+			}
+
+			// The largest subtrees start first
+			std::sort(subtrees.begin(), subtrees.end(), [](build_task const& a, build_task const& b) {
+				return a.end - a.begin > b.end - b.begin;
+			});
+			std::vector<std::vector<build_node>> subtreeNodes(subtrees.size());
+			ParallelFor(0, subtrees.size(), 1, [&](uint64 begin, uint64 end) {
+				for (uint64 s{ begin }; s < end; ++s) {
+					subtreeNodes[s].reserve((subtrees[s].end - subtrees[s].begin) / 2 + 1);
+					subtreeNodes[s].resize(1);
+					build_subtree(context, subtreeNodes[s], 0, subtrees[s].begin, subtrees[s].end);
+				}
+			});
+			// The root of a subtree replaces its node, and the others are
+			// appended
+			for (uint64 s{ 0 }; s < subtrees.size(); ++s) {
+				std::vector<build_node>& local{ subtreeNodes[s] };
+				const uint32 base{ static_cast<uint32>(nodes.size()) - 1 };
+				for (build_node& node : local) {
+					if (node.left != 0)
+						node.left += base;
+				}
+				nodes[subtrees[s].node] = local[0];
+				nodes.insert(nodes.end(), local.begin() + 1, local.end());
+				std::vector<build_node>().swap(local);
+			}
+			return nodes;
+		}
+
+		template<uint32 N>
+		void set_child(BvhNode_Base<N>& node, uint32 slot, AABB_Base<float32> const& box, uint32 child, uint32 count)
+		{
+			for (uint32 a{ 0 }; a < 3; ++a) {
+				node.min[a][slot] = box.min[a];
+				node.max[a][slot] = box.max[a];
+			}
+			node.child[slot] = child;
+			node.count[slot] = count;
+		}
+
+		// Unused children have a box at infinity. Rays only hit it at an
+		// infinite distance, e.g. with an infinite maxDistance, and the
+		// traversal skips it by its InvalidChild index.
+		template<uint32 N>
+		void clear_child(BvhNode_Base<N>& node, uint32 slot)
+		{
+			for (uint32 a{ 0 }; a < 3; ++a) {
+				node.min[a][slot] = std::numeric_limits<float32>::infinity();
+				node.max[a][slot] = std::numeric_limits<float32>::infinity();
+			}
+			node.child[slot] = InvalidChild;
+			node.count[slot] = 0;
+		}
+
+		// Collapses the binary subtree of a node into wide nodes in
+		// preorder, by replacing the largest inner child with its children
+		// until N children are gathered
+		template<uint32 N>
+		uint32 collapse(std::vector<build_node> const& binary, uint32 root, std::vector<BvhNode_Base<N>>& wide)
+		{
+			const uint32 index{ static_cast<uint32>(wide.size()) };
+			wide.emplace_back();
+			uint32 children[N];
+			uint32 childCount{ 0 };
+			if (binary[root].left == 0) {
+				children[childCount++] = root;
+			} else {
+				children[childCount++] = binary[root].left;
+				children[childCount++] = binary[root].left + 1;
+			}
+			while (childCount < N) {
+				uint32 largest{ N };
+				float32 largestArea{ -1.f };
+				for (uint32 c{ 0 }; c < childCount; ++c) {
+					build_node const& node{ binary[children[c]] };
+					if (node.left != 0 && half_area(node.bounds) > largestArea) {
+						largestArea = half_area(node.bounds);
+						largest = c;
+					}
+				}
+				if (largest == N)
+					break;
+				const uint32 node{ children[largest] };
+				children[largest] = binary[node].left;
+				children[childCount++] = binary[node].left + 1;
+			}
+			for (uint32 c{ 0 }; c < N; ++c) {
+				if (c >= childCount) {
+					clear_child(wide[index], c);
+					continue;
+				}
+				build_node const& node{ binary[children[c]] };
+				if (node.left == 0) {
+					set_child(wide[index], c, node.bounds, node.first, node.count);
+				} else {
+					const uint32 child{ collapse(binary, children[c], wide) };
+					set_child(wide[index], c, node.bounds, child, 0);
+				}
+			}
+			return index;
+		}
+
+		// The origin and the inverse direction of a ray
+		struct ray_lanes
+		{
+			float32 origin[3];
+			float32 inverse[3];
+		};
+
+		// The slab test of Intersects against all children of a node.
+		// Returns the mask of the children, which are hit before
+		// maxDistance, and writes their entry distances.
+		template<uint32 N>
+		inline uint32 intersect_children(BvhNode_Base<N> const& node, ray_lanes const& ray, float32 maxDistance,
+			float32* distances)
+		{
+#if ECM_SIMD_AVX2
+			if constexpr (N == 8) {
+				__m256 entry{ _mm256_setzero_ps() };
+				__m256 exit{ _mm256_set1_ps(maxDistance) };
+				for (uint32 a{ 0 }; a < 3; ++a) {
+					const __m256 origin{ _mm256_set1_ps(ray.origin[a]) };
+					const __m256 inverse{ _mm256_set1_ps(ray.inverse[a]) };
+					const __m256 t0{ _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.min[a]), origin), inverse) };
+					const __m256 t1{ _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(node.max[a]), origin), inverse) };
+					const __m256 scale{ _mm256_set1_ps(detail::slab_exit_scale<float32>) };
+					entry = _mm256_min_ps(_mm256_max_ps(t0, entry), _mm256_max_ps(t1, entry));
+					exit = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(t0, scale), exit),
+						_mm256_min_ps(_mm256_mul_ps(t1, scale), exit));
+				}
+				_mm256_storeu_ps(distances, entry);
+				return static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(entry, exit, _CMP_LE_OQ)));
+			}
+#endif // ECM_SIMD_AVX2
+			uint32 mask{ 0 };
+			for (uint32 b{ 0 }; b < N; b += 4) {
+				__m128 entry{ _mm_setzero_ps() };
+				__m128 exit{ _mm_set1_ps(maxDistance) };
+				for (uint32 a{ 0 }; a < 3; ++a) {
+					const __m128 origin{ _mm_set1_ps(ray.origin[a]) };
+					const __m128 inverse{ _mm_set1_ps(ray.inverse[a]) };
+					const __m128 t0{ _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.min[a] + b), origin), inverse) };
+					const __m128 t1{ _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.max[a] + b), origin), inverse) };
+					const __m128 scale{ _mm_set1_ps(detail::slab_exit_scale<float32>) };
+					entry = _mm_min_ps(_mm_max_ps(t0, entry), _mm_max_ps(t1, entry));
+					exit = _mm_max_ps(_mm_min_ps(_mm_mul_ps(t0, scale), exit), _mm_min_ps(_mm_mul_ps(t1, scale), exit));
+				}
+				_mm_storeu_ps(distances + b, entry);
+				mask |= static_cast<uint32>(_mm_movemask_ps(_mm_cmple_ps(entry, exit))) << b;
+			}
+			return mask;
+		}
+
+		inline ray_lanes make_ray_lanes(Ray_Base<float32> const& ray)
+		{
+			ray_lanes lanes;
+			for (uint8 a{ 0 }; a < 3; ++a) {
+				lanes.origin[a] = ray.origin[a];
+				lanes.inverse[a] = 1.f / ray.direction[a];
+			}
+			return lanes;
+		}
+
+		struct stack_entry
+		{
+			uint32 node;
+			float32 distance;
+		};
+
+		template<uint32 N>
+		bool intersect_closest(std::vector<BvhNode_Base<N>> const& nodes,
+			std::vector<Vector3_Base<float32>> const& positions, std::vector<uint32> const& triangles,
+			uint32 stackSize, Ray_Base<float32> const& ray, BvhHit& hit)
+		{
+			if (nodes.empty())
+				return false;
+			const ray_lanes lanes{ make_ray_lanes(ray) };
+			stack_entry local[StackSize];
+			std::vector<stack_entry> heap(stackSize > StackSize ? stackSize : 0);
+			stack_entry* stack{ heap.empty() ? local : heap.data() };
+			uint32 size{ 0 };
+			stack[size++] = { 0, 0.f };
+			bool found{ false };
+			while (size > 0) {
+				const stack_entry entry{ stack[--size] };
+				if (entry.distance > hit.distance)
+					continue;
+				BvhNode_Base<N> const& node{ nodes[entry.node] };
+				ECM_ALIGN(32) float32 distances[N];
+				uint32 mask{ intersect_children(node, lanes, hit.distance, distances) };
+				stack_entry inner[N];
+				uint32 innerCount{ 0 };
+				while (mask) {
+					uint32 c{ 0 };
+					while (!(mask & (1u << c)))
+						++c;
+					mask &= mask - 1;
+					if (node.count[c] == 0) {
+						if (node.child[c] == InvalidChild)
+							continue;
+						// Sorted by descending distance, so that the closest
+						// child is popped first
+						uint32 k{ innerCount++ };
+						for (; k > 0 && inner[k - 1].distance < distances[c]; --k)
+							inner[k] = inner[k - 1];
+						inner[k] = { node.child[c], distances[c] };
+						continue;
+					}
+					for (uint32 t{ node.child[c] }; t < node.child[c] + node.count[c]; ++t) {
+						float32 distance;
+						float32 u;
+						float32 v;
+						if (Intersects(ray, positions[t * 3], positions[t * 3 + 1], positions[t * 3 + 2], distance, u, v)
+							&& distance < hit.distance) {
+							hit.distance = distance;
+							hit.u = u;
+							hit.v = v;
+							hit.triangle = triangles[t];
+							found = true;
+						}
+					}
+				}
+				for (uint32 k{ 0 }; k < innerCount; ++k)
+					stack[size++] = inner[k];
+			}
+			return found;
+		}
+
+		template<uint32 N>
+		bool intersect_any(std::vector<BvhNode_Base<N>> const& nodes, std::vector<Vector3_Base<float32>> const& positions,
+			uint32 stackSize, Ray_Base<float32> const& ray, float32 maxDistance)
+		{
+			if (nodes.empty())
+				return false;
+			const ray_lanes lanes{ make_ray_lanes(ray) };
+			uint32 local[StackSize];
+			std::vector<uint32> heap(stackSize > StackSize ? stackSize : 0);
+			uint32* stack{ heap.empty() ? local : heap.data() };
+			uint32 size{ 0 };
+			stack[size++] = 0;
+			while (size > 0) {
+				BvhNode_Base<N> const& node{ nodes[stack[--size]] };
+				ECM_ALIGN(32) float32 distances[N];
+				uint32 mask{ intersect_children(node, lanes, maxDistance, distances) };
+				while (mask) {
+					uint32 c{ 0 };
+					while (!(mask & (1u << c)))
+						++c;
+					mask &= mask - 1;
+					if (node.count[c] == 0) {
+						if (node.child[c] != InvalidChild)
+							stack[size++] = node.child[c];
+						continue;
+					}
+					for (uint32 t{ node.child[c] }; t < node.child[c] + node.count[c]; ++t) {
+						float32 distance;
+						float32 u;
+						float32 v;
+						if (Intersects(ray, positions[t * 3], positions[t * 3 + 1], positions[t * 3 + 2], distance, u, v)
+							&& distance < maxDistance)
+							return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		// The box of the used children of a node
+		template<uint32 N>
+		AABB_Base<float32> node_bounds(BvhNode_Base<N> const& node)
+		{
+			AABB_Base<float32> bounds;
+			for (uint32 c{ 0 }; c < N; ++c) {
+				if (node.count[c] == 0 && node.child[c] == InvalidChild)
+					continue;
+				bounds = Merge(bounds, AABB_Base<float32>(
+					Vector3_Base<float32>(node.min[0][c], node.min[1][c], node.min[2][c]),
+					Vector3_Base<float32>(node.max[0][c], node.max[1][c], node.max[2][c])));
+			}
+			return bounds;
+		}
+	} // anonymous namespace
+
+	template<uint32 N>
+	void Bvh_Base<N>::Build(Vector3_Base<float32> const* vertices, uint32 const* indices, uint32 triangleCount)
+	{
+		_nodes.clear();
+		_positions.clear();
+		_indices.clear();
+		_triangles.clear();
+		_stackSize = 0;
+		if (triangleCount == 0)
+			return;
+
+		build_context context;
+		context.boxes.resize(triangleCount);
+		context.references.resize(triangleCount);
+		ParallelFor(0, triangleCount, BinGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 t{ begin }; t < end; ++t) {
+				AABB_Base<float32> box(vertices[indices[t * 3]], vertices[indices[t * 3]]);
+				box = Merge(box, vertices[indices[t * 3 + 1]]);
+				context.boxes[t] = Merge(box, vertices[indices[t * 3 + 2]]);
+				context.references[t] = static_cast<uint32>(t);
+			}
+		});
+
+		const std::vector<build_node> binary{ build_tree(context) };
+		collapse(binary, 0, _nodes);
+		// The children follow their node in preorder. A traversal holds at
+		// most N - 1 siblings per level below the root, and the root.
+		std::vector<uint32> depths(_nodes.size(), 1);
+		uint32 depth{ 1 };
+		for (uint64 n{ 0 }; n < _nodes.size(); ++n) {
+			depth = std::max(depth, depths[n]);
+			for (uint32 c{ 0 }; c < N; ++c) {
+				if (_nodes[n].count[c] == 0 && _nodes[n].child[c] != InvalidChild)
+					depths[_nodes[n].child[c]] = depths[n] + 1;
+			}
+		}
+		_stackSize = (N - 1) * (depth - 1) + 1;
+
+		_triangles = std::move(context.references);
+		_indices.resize(static_cast<uint64>(triangleCount) * 3);
+		for (uint64 t{ 0 }; t < triangleCount; ++t) {
+			for (uint32 k{ 0 }; k < 3; ++k)
+				_indices[t * 3 + k] = indices[static_cast<uint64>(_triangles[t]) * 3 + k];
+		}
+		_positions.resize(_indices.size());
+		Refit(vertices);
+	}
+
+	template<uint32 N>
+	void Bvh_Base<N>::Refit(Vector3_Base<float32> const* vertices) noexcept
+	{
+		if (_nodes.empty())
+			return;
+		ParallelFor(0, _indices.size(), BinGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 i{ begin }; i < end; ++i)
+				_positions[i] = vertices[_indices[i]];
+		});
+		// The leaves first, and then the nodes, whose children are after
+		// them in preorder
+		ParallelFor(0, _nodes.size(), RayGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 n{ begin }; n < end; ++n) {
+				BvhNode_Base<N>& node{ _nodes[n] };
+				for (uint32 c{ 0 }; c < N; ++c) {
+					if (node.count[c] == 0)
+						continue;
+					AABB_Base<float32> box;
+					for (uint32 i{ node.child[c] * 3 }; i < (node.child[c] + node.count[c]) * 3; ++i)
+						box = Merge(box, _positions[i]);
+					set_child(node, c, box, node.child[c], node.count[c]);
+				}
+			}
+		});
+		for (uint64 n{ _nodes.size() }; n-- > 0;) {
+			BvhNode_Base<N>& node{ _nodes[n] };
+			for (uint32 c{ 0 }; c < N; ++c) {
+				if (node.count[c] == 0 && node.child[c] != InvalidChild)
+					set_child(node, c, node_bounds(_nodes[node.child[c]]), node.child[c], 0);
+			}
+		}
+	}
+
+	template<uint32 N>
+	bool Bvh_Base<N>::IntersectClosest(Ray_Base<float32> const& ray, BvhHit& hit) const noexcept
+	{
+		return intersect_closest(_nodes, _positions, _triangles, _stackSize, ray, hit);
+	}
+
+	template<uint32 N>
+	void Bvh_Base<N>::IntersectClosest(Ray_Base<float32> const* rays, BvhHit* hits, uint64 count) const noexcept
+	{
+		ParallelFor(0, count, RayGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 i{ begin }; i < end; ++i)
+				intersect_closest(_nodes, _positions, _triangles, _stackSize, rays[i], hits[i]);
+		});
+	}
+
+	template<uint32 N>
+	bool Bvh_Base<N>::IntersectAny(Ray_Base<float32> const& ray, float32 maxDistance) const noexcept
+	{
+		return intersect_any(_nodes, _positions, _stackSize, ray, maxDistance);
+	}
+
+	template<uint32 N>
+	AABB_Base<float32> Bvh_Base<N>::GetBounds() const noexcept
+	{
+		return _nodes.empty() ? AABB_Base<float32>() : node_bounds(_nodes[0]);
+	}
+
+	template<uint32 N>
+	uint32 Bvh_Base<N>::GetNodeCount() const noexcept
+	{
+		return static_cast<uint32>(_nodes.size());
+	}
+
+	template<uint32 N>
+	uint32 Bvh_Base<N>::GetTriangleCount() const noexcept
+	{
+		return static_cast<uint32>(_triangles.size());
+	}
+
+	template<uint32 N>
+	BvhNode_Base<N> const* Bvh_Base<N>::GetNodes() const noexcept
+	{
+		return _nodes.data();
+	}
+
+	template class Bvh_Base<4>;
+	template class Bvh_Base<8>;
+} // namespace ecm::math
@@ -0,0 +1,874 @@
+#include <ECM/math/collision.h>
+#include <ECM/math/parallel.h>
+#include <ECM/math/ray.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		typedef Vector3_Base<float32> vector_type;
+		typedef Matrix4x4_Base<float32> matrix_type;
+
+		constexpr uint32 GjkMaxIterations{ 64 };
+		// GJK stops, once the squared distance improves by less than this
+		// fraction
+		constexpr float32 GjkTolerance{ 1e-5f };
+		// Squared distances below this fraction of the squared size of the
+		// simplex are rounding errors, and count as touching
+		constexpr float32 GjkTouchTolerance{ 1e-10f };
+		constexpr uint32 EpaMaxVertices{ 64 };
+		constexpr uint32 EpaMaxFaces{ 128 };
+		constexpr uint32 EpaMaxEdges{ 96 };
+		// EPA stops, once the support point is less than this fraction of
+		// the depth beyond the closest face
+		constexpr float32 EpaTolerance{ 1e-4f };
+		// Added to the absolute rotation of OBBIntersects, so that parallel
+		// edges don't give a null axis
+		constexpr float32 ParallelEpsilon{ 1e-6f };
+		constexpr uint64 PairGrain{ 64 };
+
+		inline float32 dot(vector_type const& a, vector_type const& b)
+		{
+			return detail::vector_dot(a, b);
+		}
+
+		inline vector_type cross(vector_type const& a, vector_type const& b)
+		{
+			return detail::vector_cross(a, b);
+		}
+
+		inline vector_type column(matrix_type const& m, uint8 c)
+		{
+			return vector_type(m.matrix[c][0], m.matrix[c][1], m.matrix[c][2]);
+		}
+
+		inline vector_type transform_point(matrix_type const& m, vector_type const& p)
+		{
+			return column(m, 0) * p.x + column(m, 1) * p.y + column(m, 2) * p.z + column(m, 3);
+		}
+
+		inline float32 sign_of(float32 v, float32 magnitude)
+		{
+			return v < 0.f ? -magnitude : magnitude;
+		}
+
+		// The support point of a core shape in its local space
+		vector_type local_support(ConvexShape const& shape, vector_type const& d)
+		{
+			switch (shape.type) {
+			case ShapeType::SEGMENT:
+				return vector_type(0.f, sign_of(d.y, shape.extents.y), 0.f);
+			case ShapeType::BOX:
+				return vector_type(sign_of(d.x, shape.extents.x), sign_of(d.y, shape.extents.y),
+					sign_of(d.z, shape.extents.z));
+			case ShapeType::HULL: {
+				if (shape.pointCount == 0)
+					return vector_type();
+				uint32 best{ 0 };
+				float32 bestDot{ dot(shape.points[0], d) };
+				for (uint32 i{ 1 }; i < shape.pointCount; ++i) {
+					const float32 value{ dot(shape.points[i], d) };
+					if (value > bestDot) {
+						bestDot = value;
+						best = i;
+					}
+				}
+				return shape.points[best];
+			}
+			default:
+				return vector_type();
+			}
+		}
+
+		// A core shape with its transformation. The direction of the support
+		// function is transformed by the transpose, which holds for all
+		// affine transformations.
+		struct placed_shape
+		{
+			ConvexShape const& shape;
+			matrix_type const& transform;
+
+			vector_type support(vector_type const& d) const
+			{
+				const vector_type local(dot(column(transform, 0), d), dot(column(transform, 1), d),
+					dot(column(transform, 2), d));
+				return transform_point(transform, local_support(shape, local));
+			}
+		};
+
+		// A point of the Minkowski difference A - B with the points of A and
+		// B, whose difference it is
+		struct support_point
+		{
+			vector_type w;
+			vector_type a;
+			vector_type b;
+		};
+
+		inline support_point minkowski_support(placed_shape const& a, placed_shape const& b, vector_type const& d)
+		{
+			support_point p;
+			p.a = a.support(d);
+			p.b = b.support(vector_type() - d);
+			p.w = p.a - p.b;
+			return p;
+		}
+
+		struct simplex
+		{
+			support_point v[4];
+			float32 lambda[4]{};
+			uint32 count{ 0 };
+
+			vector_type closest() const
+			{
+				vector_type p;
+				for (uint32 i{ 0 }; i < count; ++i)
+					p = p + v[i].w * lambda[i];
+				return p;
+			}
+
+			void witnesses(vector_type& a, vector_type& b) const
+			{
+				a = b = vector_type();
+				for (uint32 i{ 0 }; i < count; ++i) {
+					a = a + v[i].a * lambda[i];
+					b = b + v[i].b * lambda[i];
+				}
+			}
+
+			// Keeps the given vertices with their weights
+			void keep(uint32 i, float32 li)
+			{
+				v[0] = v[i];
+				lambda[0] = li;
+				count = 1;
+			}
+
+			void keep(uint32 i, float32 li, uint32 j, float32 lj)
+			{
+				const support_point vi{ v[i] };
+				const support_point vj{ v[j] };
+				v[0] = vi;
+				v[1] = vj;
+				lambda[0] = li;
+				lambda[1] = lj;
+				count = 2;
+			}
+		};
+
+		// The closest point of a segment to the origin (Ericson, "Real-Time
+		// Collision Detection", 5.1), reducing the simplex to its feature
+		void solve_segment(simplex& s)
+		{
+			const vector_type ab{ s.v[1].w - s.v[0].w };
+			const float32 lengthSquared{ dot(ab, ab) };
+			const float32 t{ lengthSquared > 0.f ? -dot(s.v[0].w, ab) / lengthSquared : 0.f };
+			if (t <= 0.f)
+				s.keep(0, 1.f);
+			else if (t >= 1.f)
+				s.keep(1, 1.f);
+			else
+				s.keep(0, 1.f - t, 1, t);
+		}
+
+		// The closest point of a triangle to the origin by its Voronoi
+		// regions (Ericson, 5.1.5)
+		void solve_triangle(simplex& s)
+		{
+			const vector_type a{ s.v[0].w };
+			const vector_type b{ s.v[1].w };
+			const vector_type c{ s.v[2].w };
+			const vector_type ab{ b - a };
+			const vector_type ac{ c - a };
+			const float32 d1{ -dot(ab, a) };
+			const float32 d2{ -dot(ac, a) };
+			if (d1 <= 0.f && d2 <= 0.f)
+				return s.keep(0, 1.f);
+			const float32 d3{ -dot(ab, b) };
+			const float32 d4{ -dot(ac, b) };
+			if (d3 >= 0.f && d4 <= d3)
+				return s.keep(1, 1.f);
+			const float32 vc{ d1 * d4 - d3 * d2 };
+			if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f) {
+				const float32 t{ d1 / (d1 - d3) };
+				return s.keep(0, 1.f - t, 1, t);
+			}
+			const float32 d5{ -dot(ab, c) };
+			const float32 d6{ -dot(ac, c) };
+			if (d6 >= 0.f && d5 <= d6)
+				return s.keep(2, 1.f);
+			const float32 vb{ d5 * d2 - d1 * d6 };
+			if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f) {
+				const float32 t{ d2 / (d2 - d6) };
+				return s.keep(0, 1.f - t, 2, t);
+			}
+			const float32 va{ d3 * d6 - d5 * d4 };
+			if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f) {
+				const float32 t{ (d4 - d3) / ((d4 - d3) + (d5 - d6)) };
+				return s.keep(1, 1.f - t, 2, t);
+			}
+			// The weights of the regions cancel badly for triangles far from
+			// the origin, so the origin is projected onto the plane instead
+			const vector_type n{ cross(ab, ac) };
+			const float32 nn{ dot(n, n) };
+			if (!(nn > 0.f)) {
+				// A degenerate triangle falls back to its first edge
+				s.count = 2;
+				return solve_segment(s);
+			}
+			const vector_type p{ n * (dot(a, n) / nn) };
+			s.lambda[0] = dot(n, cross(b - p, c - p)) / nn;
+			s.lambda[1] = dot(n, cross(c - p, a - p)) / nn;
+			s.lambda[2] = 1.f - s.lambda[0] - s.lambda[1];
+			s.count = 3;
+		}
+
+		// Tests, whether the origin is on the other side of the plane of a
+		// triangle than the fourth point. Degenerate tetrahedra count as
+		// outside.
+		inline bool origin_outside(vector_type const& a, vector_type const& b, vector_type const& c,
+			vector_type const& d)
+		{
+			const vector_type n{ cross(b - a, c - a) };
+			const float32 signOrigin{ -dot(a, n) };
+			const float32 signD{ dot(d - a, n) };
+			return signD == 0.f || signOrigin * signD < 0.f;
+		}
+
+		// The closest point of a tetrahedron to the origin (Ericson, 5.1.6).
+		// Returns true if the tetrahedron contains the origin.
+		bool solve_tetrahedron(simplex& s)
+		{
+			static constexpr uint32 Faces[4][4]{ { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+			simplex best;
+			float32 bestDistance{ std::numeric_limits<float32>::infinity() };
+			bool outside{ false };
+			for (uint32 const* f : Faces) {
+				if (!origin_outside(s.v[f[0]].w, s.v[f[1]].w, s.v[f[2]].w, s.v[f[3]].w))
+					continue;
+				outside = true;
+				simplex face;
+				face.v[0] = s.v[f[0]];
+				face.v[1] = s.v[f[1]];
+				face.v[2] = s.v[f[2]];
+				face.count = 3;
+				solve_triangle(face);
+				const vector_type p{ face.closest() };
+				const float32 distance{ dot(p, p) };
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					best = face;
+				}
+			}
+			if (!outside)
+				return true;
+			s = best;
+			return false;
+		}
+
+		// Reduces the simplex to the feature closest to the origin. Returns
+		// true if the simplex contains the origin.
+		bool solve(simplex& s)
+		{
+			switch (s.count) {
+			case 2:
+				solve_segment(s);
+				return false;
+			case 3:
+				solve_triangle(s);
+				return false;
+			case 4:
+				return solve_tetrahedron(s);
+			default:
+				s.lambda[0] = 1.f;
+				return false;
+			}
+		}
+
+		typedef enum class gjk_result : uint8
+		{
+			// The cores intersect or touch
+			INTERSECT = 0x0,
+			// The cores are farther apart than the separation
+			SEPARATED,
+			// The simplex holds the closest points of the cores
+			CLOSEST
+		} gjk_result;
+
+		// Runs GJK on the cores of two shapes (van den Bergen, "A Fast and
+		// Robust GJK Implementation for Collision Detection of Convex
+		// Objects"). It stops early, once the cores are known to be farther
+		// apart than the separation.
+		gjk_result gjk(placed_shape const& a, placed_shape const& b, float32 separation, simplex& s)
+		{
+			vector_type d{ column(a.transform, 3) - column(b.transform, 3) };
+			if (dot(d, d) == 0.f)
+				d = vector_type(1.f, 0.f, 0.f);
+			s.v[0] = minkowski_support(a, b, d);
+			s.lambda[0] = 1.f;
+			s.count = 1;
+			vector_type v{ s.v[0].w };
+			float32 vv{ dot(v, v) };
+			const float32 separationSquared{ separation * separation };
+			for (uint32 iteration{ 0 }; iteration < GjkMaxIterations; ++iteration) {
+				if (vv == 0.f)
+					return gjk_result::INTERSECT;
+				const support_point p{ minkowski_support(a, b, vector_type() - v) };
+				const float32 vw{ dot(v, p.w) };
+				// The plane through the support point separates the origin
+				// from the difference, and bounds the distance from below
+				if (vw > 0.f && vw * vw > separationSquared * vv)
+					return gjk_result::SEPARATED;
+				if (vv - vw <= GjkTolerance * vv + GjkTouchTolerance * dot(p.w, p.w))
+					return gjk_result::CLOSEST;
+				bool duplicate{ false };
+				for (uint32 i{ 0 }; i < s.count; ++i)
+					duplicate = duplicate || (s.v[i].w == p.w);
+				if (duplicate)
+					return gjk_result::CLOSEST;
+
+				const simplex previous{ s };
+				s.v[s.count++] = p;
+				// The old simplex lies beyond the plane through v, so the
+				// origin can only be enclosed by a support point behind it
+				if (solve(s)) {
+					if (vw <= 0.f)
+						return gjk_result::INTERSECT;
+					s = previous;
+					return gjk_result::CLOSEST;
+				}
+				v = s.closest();
+				const float32 next{ dot(v, v) };
+				float32 size{ 0.f };
+				for (uint32 i{ 0 }; i < s.count; ++i)
+					size = std::max(size, dot(s.v[i].w, s.v[i].w));
+				if (next <= GjkTouchTolerance * size)
+					return gjk_result::INTERSECT;
+				// Rounding stops the distance from decreasing
+				if (next >= vv) {
+					s = previous;
+					return gjk_result::CLOSEST;
+				}
+				vv = next;
+			}
+			return gjk_result::CLOSEST;
+		}
+
+		// The barycentric coordinates of a point in the plane of a triangle
+		inline void barycentric(vector_type const& p, vector_type const& a, vector_type const& b,
+			vector_type const& c, float32* lambda)
+		{
+			const vector_type v0{ b - a };
+			const vector_type v1{ c - a };
+			const vector_type v2{ p - a };
+			const float32 d00{ dot(v0, v0) };
+			const float32 d01{ dot(v0, v1) };
+			const float32 d11{ dot(v1, v1) };
+			const float32 d20{ dot(v2, v0) };
+			const float32 d21{ dot(v2, v1) };
+			const float32 denominator{ d00 * d11 - d01 * d01 };
+			if (!(denominator > 0.f)) {
+				lambda[0] = 1.f;
+				lambda[1] = lambda[2] = 0.f;
+				return;
+			}
+			lambda[1] = (d11 * d20 - d01 * d21) / denominator;
+			lambda[2] = (d00 * d21 - d01 * d20) / denominator;
+			lambda[0] = 1.f - lambda[1] - lambda[2];
+		}
+
+		// Grows the simplex of intersecting cores into a tetrahedron, which
+		// contains the origin. Returns false if the difference is flat,
+		// where the cores only touch.
+		bool expand_simplex(placed_shape const& a, placed_shape const& b, simplex& s)
+		{
+			static const vector_type Axes[6]{ vector_type(1.f, 0.f, 0.f), vector_type(-1.f, 0.f, 0.f),
+				vector_type(0.f, 1.f, 0.f), vector_type(0.f, -1.f, 0.f), vector_type(0.f, 0.f, 1.f),
+				vector_type(0.f, 0.f, -1.f) };
+			float32 size{ 0.f };
+			for (uint32 i{ 0 }; i < s.count; ++i)
+				size = std::max(size, dot(s.v[i].w, s.v[i].w));
+			if (s.count == 1) {
+				for (vector_type const& axis : Axes) {
+					const support_point p{ minkowski_support(a, b, axis) };
+					const vector_type offset{ p.w - s.v[0].w };
+					if (dot(offset, offset) > GjkTouchTolerance * std::max(size, dot(p.w, p.w))) {
+						s.v[s.count++] = p;
+						break;
+					}
+				}
+				if (s.count == 1)
+					return false;
+			}
+			if (s.count == 2) {
+				const vector_type edge{ s.v[1].w - s.v[0].w };
+				// The axis least aligned with the edge gives two normals
+				uint8 axis{ 0 };
+				for (uint8 i{ 1 }; i < 3; ++i) {
+					if (std::fabs(edge[i]) < std::fabs(edge[axis]))
+						axis = i;
+				}
+				vector_type unit;
+				unit[axis] = 1.f;
+				const vector_type n1{ cross(edge, unit) };
+				const vector_type n2{ cross(edge, n1) };
+				const vector_type directions[4]{ n1, vector_type() - n1, n2, vector_type() - n2 };
+				const float32 edgeSquared{ dot(edge, edge) };
+				for (vector_type const& direction : directions) {
+					const support_point p{ minkowski_support(a, b, direction) };
+					const vector_type offset{ cross(p.w - s.v[0].w, edge) };
+					if (dot(offset, offset) > GjkTouchTolerance * edgeSquared * std::max(size, dot(p.w, p.w))) {
+						s.v[s.count++] = p;
+						break;
+					}
+				}
+				if (s.count == 2)
+					return false;
+			}
+			if (s.count == 3) {
+				const vector_type n{ cross(s.v[1].w - s.v[0].w, s.v[2].w - s.v[0].w) };
+				const float32 nn{ dot(n, n) };
+				for (float32 side : { 1.f, -1.f }) {
+					const support_point p{ minkowski_support(a, b, n * side) };
+					const float32 height{ dot(p.w - s.v[0].w, n) };
+					if (height * height > GjkTouchTolerance * nn * std::max(size, dot(p.w, p.w))) {
+						s.v[s.count++] = p;
+						break;
+					}
+				}
+				if (s.count == 3)
+					return false;
+			}
+			return true;
+		}
+
+		struct epa_face
+		{
+			uint8 v[3];
+			vector_type n;
+			float32 d;
+		};
+
+		struct epa_edge
+		{
+			uint8 a;
+			uint8 b;
+		};
+
+		inline epa_face make_face(support_point const* vertices, uint8 i, uint8 j, uint8 k)
+		{
+			epa_face face{ { i, j, k }, vector_type(), std::numeric_limits<float32>::infinity() };
+			const vector_type n{ cross(vertices[j].w - vertices[i].w, vertices[k].w - vertices[i].w) };
+			const float32 length{ std::sqrt(dot(n, n)) };
+			// Degenerate faces are never the closest or visible
+			if (length > 0.f) {
+				face.n = n * (1.f / length);
+				face.d = dot(face.n, vertices[i].w);
+			}
+			return face;
+		}
+
+		// Expands the polytope of intersecting cores towards the face of the
+		// difference, which is closest to the origin (van den Bergen,
+		// "Proximity Queries and Penetration Depth Computation on 3D Game
+		// Objects"). The polytope has a fixed capacity, and the closest face
+		// so far is taken once it is full.
+		void epa(placed_shape const& a, placed_shape const& b, simplex const& s, Contact& contact)
+		{
+			support_point vertices[EpaMaxVertices];
+			epa_face faces[EpaMaxFaces];
+			epa_edge edges[EpaMaxEdges];
+			uint32 visible[EpaMaxFaces];
+			for (uint32 i{ 0 }; i < 4; ++i)
+				vertices[i] = s.v[i];
+			uint32 vertexCount{ 4 };
+			uint32 faceCount{ 0 };
+			static constexpr uint8 Tetrahedron[4][4]{ { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+			for (uint8 const* f : Tetrahedron) {
+				// The faces point away from the opposite vertex
+				const vector_type n{ cross(vertices[f[1]].w - vertices[f[0]].w, vertices[f[2]].w - vertices[f[0]].w) };
+				if (dot(n, vertices[f[3]].w - vertices[f[0]].w) > 0.f)
+					faces[faceCount++] = make_face(vertices, f[0], f[2], f[1]);
+				else
+					faces[faceCount++] = make_face(vertices, f[0], f[1], f[2]);
+			}
+
+			uint32 closest{ 0 };
+			for (;;) {
+				closest = 0;
+				for (uint32 f{ 1 }; f < faceCount; ++f) {
+					if (faces[f].d < faces[closest].d)
+						closest = f;
+				}
+				epa_face const& face{ faces[closest] };
+				if (face.d == std::numeric_limits<float32>::infinity() || vertexCount == EpaMaxVertices)
+					break;
+				const support_point p{ minkowski_support(a, b, face.n) };
+				const float32 distance{ dot(p.w, face.n) };
+				float32 size{ 0.f };
+				for (uint32 i{ 0 }; i < vertexCount; ++i)
+					size = std::max(size, dot(vertices[i].w, vertices[i].w));
+				if (distance - face.d <= EpaTolerance * std::max(face.d, 1e-3f * std::sqrt(size)))
+					break;
+
+				// The faces, which the new vertex sees, are removed, and the
+				// edges of the hole are joined with the new vertex
+				uint32 visibleCount{ 0 };
+				uint32 edgeCount{ 0 };
+				bool full{ false };
+				for (uint32 f{ 0 }; f < faceCount && !full; ++f) {
+					if (dot(faces[f].n, p.w - vertices[faces[f].v[0]].w) <= 0.f)
+						continue;
+					visible[visibleCount++] = f;
+					for (uint32 e{ 0 }; e < 3; ++e) {
+						const uint8 from{ faces[f].v[e] };
+						const uint8 to{ faces[f].v[(e + 1) % 3] };
+						// An edge shared with another visible face is inside
+						// the hole
+						uint32 shared{ edgeCount };
+						for (uint32 k{ 0 }; k < edgeCount; ++k) {
+							if (edges[k].a == to && edges[k].b == from) {
+								shared = k;
+								break;
+							}
+						}
+						if (shared < edgeCount) {
+							edges[shared] = edges[--edgeCount];
+						} else if (edgeCount < EpaMaxEdges) {
+							edges[edgeCount++] = { from, to };
+						} else {
+							full = true;
+							break;
+						}
+					}
+				}
+				if (full || visibleCount == 0 || faceCount - visibleCount + edgeCount > EpaMaxFaces)
+					break;
+				const uint8 added{ static_cast<uint8>(vertexCount) };
+				vertices[vertexCount++] = p;
+				// The visible faces are removed from the back, so that the
+				// indices of the others stay valid
+				for (uint32 k{ visibleCount }; k-- > 0;)
+					faces[visible[k]] = faces[--faceCount];
+				for (uint32 k{ 0 }; k < edgeCount; ++k)
+					faces[faceCount++] = make_face(vertices, edges[k].a, edges[k].b, added);
+			}
+
+			epa_face const& face{ faces[closest] };
+			float32 lambda[3];
+			support_point const& p0{ vertices[face.v[0]] };
+			support_point const& p1{ vertices[face.v[1]] };
+			support_point const& p2{ vertices[face.v[2]] };
+			barycentric(face.n * face.d, p0.w, p1.w, p2.w, lambda);
+			contact.normal = face.n;
+			contact.depth = std::max(face.d, 0.f);
+			contact.pointA = p0.a * lambda[0] + p1.a * lambda[1] + p2.a * lambda[2];
+			contact.pointB = p0.b * lambda[0] + p1.b * lambda[1] + p2.b * lambda[2];
+		}
+
+		// Moves the points of a contact of the cores onto the rounded shapes
+		inline void add_radii(Contact& contact, float32 radiusA, float32 radiusB)
+		{
+			contact.pointA = contact.pointA + contact.normal * radiusA;
+			contact.pointB = contact.pointB - contact.normal * radiusB;
+			contact.depth += radiusA + radiusB;
+		}
+
+		// The closest points of two segments, which are given by their
+		// centers, unit directions and half lengths (Ericson, 5.1.9)
+		void closest_segments(vector_type const& centerA, vector_type const& directionA, float32 halfA,
+			vector_type const& centerB, vector_type const& directionB, float32 halfB, vector_type& pointA,
+			vector_type& pointB)
+		{
+			const vector_type r{ centerA - centerB };
+			const float32 b{ dot(directionA, directionB) };
+			const float32 c{ dot(directionA, r) };
+			const float32 f{ dot(directionB, r) };
+			const float32 denominator{ 1.f - b * b };
+			float32 s{ denominator > 0.f ? std::clamp((b * f - c) / denominator, -halfA, halfA) : 0.f };
+			const float32 t{ std::clamp(b * s + f, -halfB, halfB) };
+			s = std::clamp(b * t - c, -halfA, halfA);
+			pointA = centerA + directionA * s;
+			pointB = centerB + directionB * t;
+		}
+	} // anonymous namespace
+
+	bool GjkIntersects(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA, ConvexShape const& b,
+		Matrix4x4_Base<float32> const& transformB) noexcept
+	{
+		simplex s;
+		const gjk_result result{ gjk({ a, transformA }, { b, transformB }, a.radius + b.radius, s) };
+		if (result != gjk_result::CLOSEST)
+			return result == gjk_result::INTERSECT;
+		const vector_type v{ s.closest() };
+		const float32 radii{ a.radius + b.radius };
+		return dot(v, v) <= radii * radii;
+	}
+
+	float32 GjkDistance(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA, ConvexShape const& b,
+		Matrix4x4_Base<float32> const& transformB, Vector3_Base<float32>* pointA,
+		Vector3_Base<float32>* pointB) noexcept
+	{
+		simplex s;
+		if (gjk({ a, transformA }, { b, transformB }, std::numeric_limits<float32>::infinity(), s)
+			== gjk_result::INTERSECT)
+			return 0.f;
+		vector_type closestA, closestB;
+		s.witnesses(closestA, closestB);
+		const vector_type offset{ closestB - closestA };
+		const float32 coreDistance{ std::sqrt(dot(offset, offset)) };
+		const float32 distance{ coreDistance - a.radius - b.radius };
+		if (!(distance > 0.f))
+			return 0.f;
+		const vector_type n{ offset * (1.f / coreDistance) };
+		if (pointA)
+			*pointA = closestA + n * a.radius;
+		if (pointB)
+			*pointB = closestB - n * b.radius;
+		return distance;
+	}
+
+	bool EpaPenetration(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA, ConvexShape const& b,
+		Matrix4x4_Base<float32> const& transformB, Contact& contact) noexcept
+	{
+		contact = Contact();
+		const placed_shape placedA{ a, transformA };
+		const placed_shape placedB{ b, transformB };
+		const float32 radii{ a.radius + b.radius };
+		simplex s;
+		const gjk_result result{ gjk(placedA, placedB, radii, s) };
+		if (result == gjk_result::SEPARATED)
+			return false;
+		if (result == gjk_result::CLOSEST) {
+			// Only the rounded shapes intersect
+			vector_type closestA, closestB;
+			s.witnesses(closestA, closestB);
+			const vector_type offset{ closestB - closestA };
+			const float32 coreDistance{ std::sqrt(dot(offset, offset)) };
+			if (!(coreDistance < radii))
+				return false;
+			if (coreDistance > 0.f) {
+				contact.normal = offset * (1.f / coreDistance);
+				contact.pointA = closestA;
+				contact.pointB = closestB;
+				contact.depth = -coreDistance;
+				add_radii(contact, a.radius, b.radius);
+				return true;
+			}
+		}
+		if (expand_simplex(placedA, placedB, s)) {
+			epa(placedA, placedB, s, contact);
+		} else {
+			// Touching cores push apart along the line of their centers
+			vector_type n{ column(transformB, 3) - column(transformA, 3) };
+			const float32 length{ std::sqrt(dot(n, n)) };
+			contact.normal = length > 0.f ? n * (1.f / length) : vector_type(0.f, 1.f, 0.f);
+			s.witnesses(contact.pointA, contact.pointB);
+			contact.depth = 0.f;
+		}
+		add_radii(contact, a.radius, b.radius);
+		if (!(contact.depth > 0.f)) {
+			contact = Contact();
+			return false;
+		}
+		return true;
+	}
+
+	bool OBBIntersects(Vector3_Base<float32> const& halfExtentsA, Matrix4x4_Base<float32> const& transformA,
+		Vector3_Base<float32> const& halfExtentsB, Matrix4x4_Base<float32> const& transformB,
+		Contact* contact) noexcept
+	{
+		// The axes are normalized, and their scale goes into the extents
+		vector_type axesA[3], axesB[3];
+		float32 extentsA[3], extentsB[3];
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			axesA[i] = column(transformA, i);
+			axesB[i] = column(transformB, i);
+			const float32 lengthA{ std::sqrt(dot(axesA[i], axesA[i])) };
+			const float32 lengthB{ std::sqrt(dot(axesB[i], axesB[i])) };
+			axesA[i] = lengthA > 0.f ? axesA[i] * (1.f / lengthA) : axesA[i];
+			axesB[i] = lengthB > 0.f ? axesB[i] * (1.f / lengthB) : axesB[i];
+			extentsA[i] = std::fabs(halfExtentsA[i]) * lengthA;
+			extentsB[i] = std::fabs(halfExtentsB[i]) * lengthB;
+		}
+		const vector_type centerA{ column(transformA, 3) };
+		const vector_type centerB{ column(transformB, 3) };
+		const vector_type offset{ centerB - centerA };
+
+		// The rotation of B in the frame of A (Gottschalk et al., "OBBTree")
+		float32 r[3][3], absR[3][3], t[3];
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			for (uint8 j{ 0 }; j < 3; ++j) {
+				r[i][j] = dot(axesA[i], axesB[j]);
+				absR[i][j] = std::fabs(r[i][j]) + ParallelEpsilon;
+			}
+			t[i] = dot(offset, axesA[i]);
+		}
+
+		// The axis of the least overlap: 0-2 the faces of A, 3-5 the faces
+		// of B and 6-14 the edges
+		float32 bestOverlap{ std::numeric_limits<float32>::infinity() };
+		uint32 bestAxis{ 0 };
+		const auto test = [&](float32 ra, float32 rb, float32 distance, float32 length, uint32 axis) {
+			const float32 overlap{ (ra + rb - std::fabs(distance)) / length };
+			if (overlap < bestOverlap) {
+				bestOverlap = overlap;
+				bestAxis = axis;
+			}
+			return overlap >= 0.f;
+		};
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			const float32 rb{ extentsB[0] * absR[i][0] + extentsB[1] * absR[i][1] + extentsB[2] * absR[i][2] };
+			if (!test(extentsA[i], rb, t[i], 1.f, i))
+				return false;
+		}
+		for (uint8 j{ 0 }; j < 3; ++j) {
+			const float32 ra{ extentsA[0] * absR[0][j] + extentsA[1] * absR[1][j] + extentsA[2] * absR[2][j] };
+			const float32 distance{ t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j] };
+			if (!test(ra, extentsB[j], distance, 1.f, 3 + j))
+				return false;
+		}
+		for (uint8 i{ 0 }; i < 3; ++i) {
+			const uint8 i1{ static_cast<uint8>((i + 1) % 3) };
+			const uint8 i2{ static_cast<uint8>((i + 2) % 3) };
+			for (uint8 j{ 0 }; j < 3; ++j) {
+				const uint8 j1{ static_cast<uint8>((j + 1) % 3) };
+				const uint8 j2{ static_cast<uint8>((j + 2) % 3) };
+				// Parallel edges are covered by the faces
+				const float32 length{ std::sqrt(std::max(1.f - r[i][j] * r[i][j], 0.f)) };
+				if (length < 1e-3f)
+					continue;
+				const float32 ra{ extentsA[i1] * absR[i2][j] + extentsA[i2] * absR[i1][j] };
+				const float32 rb{ extentsB[j1] * absR[i][j2] + extentsB[j2] * absR[i][j1] };
+				const float32 distance{ t[i2] * r[i1][j] - t[i1] * r[i2][j] };
+				if (!test(ra, rb, distance, length, 6 + i * 3 + j))
+					return false;
+			}
+		}
+		if (!contact)
+			return true;
+
+		vector_type n;
+		if (bestAxis < 3) {
+			n = axesA[bestAxis];
+		} else if (bestAxis < 6) {
+			n = axesB[bestAxis - 3];
+		} else {
+			n = cross(axesA[(bestAxis - 6) / 3], axesB[(bestAxis - 6) % 3]);
+			n = n * (1.f / std::sqrt(dot(n, n)));
+		}
+		if (dot(n, offset) < 0.f)
+			n = vector_type() - n;
+		contact->normal = n;
+		contact->depth = bestOverlap;
+		// The deepest corner of the box, whose face is not the axis, or the
+		// closest points of the edges
+		vector_type cornerA{ centerA }, cornerB{ centerB };
+		for (uint8 k{ 0 }; k < 3; ++k) {
+			cornerA = cornerA + axesA[k] * sign_of(dot(axesA[k], n), extentsA[k]);
+			cornerB = cornerB - axesB[k] * sign_of(dot(axesB[k], n), extentsB[k]);
+		}
+		if (bestAxis < 3) {
+			contact->pointB = cornerB;
+			contact->pointA = cornerB + n * bestOverlap;
+		} else if (bestAxis < 6) {
+			contact->pointA = cornerA;
+			contact->pointB = cornerA - n * bestOverlap;
+		} else {
+			const uint32 i{ (bestAxis - 6) / 3 };
+			const uint32 j{ (bestAxis - 6) % 3 };
+			// The supporting edges run through the deepest corners
+			const vector_type edgeA{ cornerA - axesA[i] * sign_of(dot(axesA[i], n), extentsA[i]) };
+			const vector_type edgeB{ cornerB + axesB[j] * sign_of(dot(axesB[j], n), extentsB[j]) };
+			closest_segments(edgeA, axesA[i], extentsA[i], edgeB, axesB[j], extentsB[j], contact->pointA,
+				contact->pointB);
+		}
+		return true;
+	}
+
+	bool TriangleAABBIntersects(Vector3_Base<float32> const& v0, Vector3_Base<float32> const& v1,
+		Vector3_Base<float32> const& v2, AABB_Base<float32> const& box) noexcept
+	{
+		const vector_type center{ (box.min + box.max) * 0.5f };
+		const vector_type e{ (box.max - box.min) * 0.5f };
+		const vector_type p[3]{ v0 - center, v1 - center, v2 - center };
+
+		// The axes of the box
+		for (uint8 k{ 0 }; k < 3; ++k) {
+			if (std::min({ p[0][k], p[1][k], p[2][k] }) > e[k] || std::max({ p[0][k], p[1][k], p[2][k] }) < -e[k])
+				return false;
+		}
+		// The cross products of the axes of the box with the edges
+		const vector_type edges[3]{ p[1] - p[0], p[2] - p[1], p[0] - p[2] };
+		for (vector_type const& edge : edges) {
+			const vector_type axes[3]{ vector_type(0.f, -edge.z, edge.y), vector_type(edge.z, 0.f, -edge.x),
+				vector_type(-edge.y, edge.x, 0.f) };
+			for (vector_type const& axis : axes) {
+				const float32 d0{ dot(p[0], axis) };
+				const float32 d1{ dot(p[1], axis) };
+				const float32 d2{ dot(p[2], axis) };
+				const float32 radius{ e.x * std::fabs(axis.x) + e.y * std::fabs(axis.y) + e.z * std::fabs(axis.z) };
+				if (std::min({ d0, d1, d2 }) > radius || std::max({ d0, d1, d2 }) < -radius)
+					return false;
+			}
+		}
+		// The normal of the triangle
+		const vector_type n{ cross(edges[0], edges[1]) };
+		const float32 radius{ e.x * std::fabs(n.x) + e.y * std::fabs(n.y) + e.z * std::fabs(n.z) };
+		return std::fabs(dot(n, p[0])) <= radius;
+	}
+
+	bool Collide(ConvexShape const& a, Matrix4x4_Base<float32> const& transformA, ConvexShape const& b,
+		Matrix4x4_Base<float32> const& transformB, Contact& contact) noexcept
+	{
+		if (a.type == ShapeType::POINT && b.type == ShapeType::POINT) {
+			contact = Contact();
+			const vector_type centerA{ column(transformA, 3) };
+			const vector_type centerB{ column(transformB, 3) };
+			const vector_type offset{ centerB - centerA };
+			const float32 distance{ std::sqrt(dot(offset, offset)) };
+			const float32 radii{ a.radius + b.radius };
+			if (!(distance < radii))
+				return false;
+			contact.normal = distance > 0.f ? offset * (1.f / distance) : vector_type(0.f, 1.f, 0.f);
+			contact.pointA = centerA;
+			contact.pointB = centerB;
+			contact.depth = -distance;
+			add_radii(contact, a.radius, b.radius);
+			return true;
+		}
+		if (a.type == ShapeType::BOX && b.type == ShapeType::BOX && a.radius == 0.f && b.radius == 0.f) {
+			contact = Contact();
+			if (!OBBIntersects(a.extents, transformA, b.extents, transformB, &contact))
+				return false;
+			if (!(contact.depth > 0.f)) {
+				contact = Contact();
+				return false;
+			}
+			return true;
+		}
+		return EpaPenetration(a, transformA, b, transformB, contact);
+	}
+
+	uint64 CollideBatch(ConvexShape const* shapes, Matrix4x4_Base<float32> const* transforms,
+		SpatialPair const* pairs, uint64 count, Contact* contacts)
+	{
+		std::atomic<uint64> hits{ 0 };
+		ParallelFor(0, count, PairGrain, [&](uint64 begin, uint64 end) {
+			uint64 found{ 0 };
+			for (uint64 i{ begin }; i < end; ++i) {
+				SpatialPair const& pair{ pairs[i] };
+				found += Collide(shapes[pair.first], transforms[pair.first], shapes[pair.second],
+					transforms[pair.second], contacts[i]);
+			}
+			hits.fetch_add(found, std::memory_order_relaxed);
+		});
+		return hits.load(std::memory_order_relaxed);
+	}
+} // namespace ecm::math
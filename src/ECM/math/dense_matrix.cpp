@@ -0,0 +1,680 @@
+#include <ECM/math/dense_matrix.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <new>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The alignment of the storage and of the packed panels
+		constexpr std::size_t StorageAlignment{ 64 };
+		// The number of columns of the microkernel tiles
+		constexpr uint32 TileColumns{ 6 };
+		// The depth of the packed panels, so that a panel of B with
+		// TileColumns columns stays in the L1 cache
+		constexpr uint32 PanelDepth{ 256 };
+		// The size of the block of packed A, which a task reads, so that it
+		// stays in the L2 cache. A is packed whole for each panel depth.
+		constexpr uint32 BlockBytes{ 128 * 1024 };
+		// The number of columns of a packed panel of B, which stays in the
+		// L3 cache
+		constexpr uint32 PanelColumns{ TileColumns * 512 };
+		// The number of columns, which a task of Gemm computes for a block
+		// of rows
+		constexpr uint32 TaskColumns{ TileColumns * 16 };
+		// The number of elements of a chunk of the element-wise operations
+		constexpr uint64 ElementGrain{ 16384 };
+		// The number of rows of a chunk of Gemv
+		constexpr uint64 RowGrain{ 2048 };
+		// The number of columns of a chunk of the transposed Gemv
+		constexpr uint64 ColumnGrain{ 16 };
+		// The size of the square blocks of Transpose
+		constexpr uint32 TransposeBlock{ 32 };
+
+		template<typename T>
+		T* allocate_aligned(uint64 count)
+		{
+			return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ StorageAlignment }));
+		}
+
+		template<typename T>
+		void free_aligned(T* data) noexcept
+		{
+			::operator delete(data, std::align_val_t{ StorageAlignment });
+		}
+
+		// The storage of packed panels, which is freed at the end of Gemm
+		template<typename T>
+		struct aligned_buffer
+		{
+			explicit aligned_buffer(uint64 count) : data{ allocate_aligned<T>(count) } {}
+			aligned_buffer(aligned_buffer const&) = delete;
+			aligned_buffer& operator=(aligned_buffer const&) = delete;
+			~aligned_buffer() { free_aligned(data); }
+
+			T* data;
+		};
+
+		// The SIMD registers of float32 and float64, which the kernels use
+		// through the same functions
+		template<typename T>
+		struct lanes;
+
+#if ECM_SIMD_AVX2
+		template<>
+		struct lanes<float32>
+		{
+			typedef __m256 type;
+			static constexpr uint32 count{ 8 };
+			static type zero() { return _mm256_setzero_ps(); }
+			static type set1(float32 f) { return _mm256_set1_ps(f); }
+			static type load(float32 const* p) { return _mm256_load_ps(p); }
+			static type loadu(float32 const* p) { return _mm256_loadu_ps(p); }
+			static void store(float32* p, type a) { _mm256_store_ps(p, a); }
+			static void storeu(float32* p, type a) { _mm256_storeu_ps(p, a); }
+			static type add(type a, type b) { return _mm256_add_ps(a, b); }
+			static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+
+		template<>
+		struct lanes<float64>
+		{
+			typedef __m256d type;
+			static constexpr uint32 count{ 4 };
+			static type zero() { return _mm256_setzero_pd(); }
+			static type set1(float64 f) { return _mm256_set1_pd(f); }
+			static type load(float64 const* p) { return _mm256_load_pd(p); }
+			static type loadu(float64 const* p) { return _mm256_loadu_pd(p); }
+			static void store(float64* p, type a) { _mm256_store_pd(p, a); }
+			static void storeu(float64* p, type a) { _mm256_storeu_pd(p, a); }
+			static type add(type a, type b) { return _mm256_add_pd(a, b); }
+			static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+#elif ECM_SIMD_SSE2
+		template<>
+		struct lanes<float32>
+		{
+			typedef __m128 type;
+			static constexpr uint32 count{ 4 };
+			static type zero() { return _mm_setzero_ps(); }
+			static type set1(float32 f) { return _mm_set1_ps(f); }
+			static type load(float32 const* p) { return _mm_load_ps(p); }
+			static type loadu(float32 const* p) { return _mm_loadu_ps(p); }
+			static void store(float32* p, type a) { _mm_store_ps(p, a); }
+			static void storeu(float32* p, type a) { _mm_storeu_ps(p, a); }
+			static type add(type a, type b) { return _mm_add_ps(a, b); }
+			static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm_fmadd_ps(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+
+		template<>
+		struct lanes<float64>
+		{
+			typedef __m128d type;
+			static constexpr uint32 count{ 2 };
+			static type zero() { return _mm_setzero_pd(); }
+			static type set1(float64 f) { return _mm_set1_pd(f); }
+			static type load(float64 const* p) { return _mm_load_pd(p); }
+			static type loadu(float64 const* p) { return _mm_loadu_pd(p); }
+			static void store(float64* p, type a) { _mm_store_pd(p, a); }
+			static void storeu(float64* p, type a) { _mm_storeu_pd(p, a); }
+			static type add(type a, type b) { return _mm_add_pd(a, b); }
+			static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm_fmadd_pd(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+#else
+		template<typename T>
+		struct lanes
+		{
+			typedef T type;
+			static constexpr uint32 count{ 1 };
+			static type zero() { return T(0); }
+			static type set1(T f) { return f; }
+			static type load(T const* p) { return *p; }
+			static type loadu(T const* p) { return *p; }
+			static void store(T* p, type a) { *p = a; }
+			static void storeu(T* p, type a) { *p = a; }
+			static type add(type a, type b) { return a + b; }
+			static type mul(type a, type b) { return a * b; }
+			static type fmadd(type a, type b, type c) { return a * b + c; }
+		};
+#endif // ECM_SIMD_AVX2
+
+		// The number of rows of the microkernel tiles, which are two
+		// registers high
+		template<typename T>
+		constexpr uint32 tile_rows{ lanes<T>::count * 2 };
+
+		// The number of rows of the block of packed A of a task
+		template<typename T>
+		constexpr uint32 block_rows{ BlockBytes / (PanelDepth * sizeof(T)) };
+
+		// Computes a tile of C += A * B from a panel of A with tile_rows
+		// rows and a panel of B with TileColumns columns. The tile keeps its
+		// 12 sums in registers. Tiles at the edges of C only update m rows
+		// and n columns.
+		template<typename T>
+		void micro_kernel(uint32 depth, T const* a, T const* b, T* c, uint64 stride, uint32 m, uint32 n)
+		{
+			typedef lanes<T> L;
+			typedef typename L::type V;
+			constexpr uint32 rows{ tile_rows<T> };
+			V c00{ L::zero() }, c01{ L::zero() }, c02{ L::zero() }, c03{ L::zero() }, c04{ L::zero() }, c05{ L::zero() };
+			V c10{ L::zero() }, c11{ L::zero() }, c12{ L::zero() }, c13{ L::zero() }, c14{ L::zero() }, c15{ L::zero() };
+			for (uint32 k{ 0 }; k < depth; ++k) {
+				const V a0{ L::load(a) };
+				const V a1{ L::load(a + L::count) };
+				V bk{ L::set1(b[0]) };
+				c00 = L::fmadd(a0, bk, c00);
+				c10 = L::fmadd(a1, bk, c10);
+				bk = L::set1(b[1]);
+				c01 = L::fmadd(a0, bk, c01);
+				c11 = L::fmadd(a1, bk, c11);
+				bk = L::set1(b[2]);
+				c02 = L::fmadd(a0, bk, c02);
+				c12 = L::fmadd(a1, bk, c12);
+				bk = L::set1(b[3]);
+				c03 = L::fmadd(a0, bk, c03);
+				c13 = L::fmadd(a1, bk, c13);
+				bk = L::set1(b[4]);
+				c04 = L::fmadd(a0, bk, c04);
+				c14 = L::fmadd(a1, bk, c14);
+				bk = L::set1(b[5]);
+				c05 = L::fmadd(a0, bk, c05);
+				c15 = L::fmadd(a1, bk, c15);
+				a += rows;
+				b += TileColumns;
+			}
+			ECM_ALIGN(64) T tile[TileColumns * rows];
+			L::store(tile + 0 * rows, c00);
+			L::store(tile + 0 * rows + L::count, c10);
+			L::store(tile + 1 * rows, c01);
+			L::store(tile + 1 * rows + L::count, c11);
+			L::store(tile + 2 * rows, c02);
+			L::store(tile + 2 * rows + L::count, c12);
+			L::store(tile + 3 * rows, c03);
+			L::store(tile + 3 * rows + L::count, c13);
+			L::store(tile + 4 * rows, c04);
+			L::store(tile + 4 * rows + L::count, c14);
+			L::store(tile + 5 * rows, c05);
+			L::store(tile + 5 * rows + L::count, c15);
+			if (m == rows) {
+				for (uint32 j{ 0 }; j < n; ++j) {
+					T* column{ c + j * stride };
+					L::storeu(column, L::add(L::loadu(column), L::load(tile + j * rows)));
+					L::storeu(column + L::count, L::add(L::loadu(column + L::count), L::load(tile + j * rows + L::count)));
+				}
+			} else {
+				for (uint32 j{ 0 }; j < n; ++j) {
+					for (uint32 i{ 0 }; i < m; ++i)
+						c[j * stride + i] += tile[j * rows + i];
+				}
+			}
+		}
+
+		// The element of row i and column k of op(A)
+		template<typename T>
+		inline T const& element(DenseMatrix<T> const& a, MatrixOp op, uint64 i, uint64 k)
+		{
+			return op == MatrixOp::NONE ? a.GetData()[k * a.GetRows() + i] : a.GetData()[i * a.GetRows() + k];
+		}
+
+		// Packs the columns [first, first + depth) of alpha * op(A) into
+		// panels of tile_rows rows, which hold the rows of each column
+		// contiguously. The rows of the last panel are padded with zero.
+		template<typename T>
+		void pack_a(T alpha, DenseMatrix<T> const& a, MatrixOp op, uint32 rowCount, uint32 first, uint32 depth,
+			T* packed)
+		{
+			constexpr uint32 rows{ tile_rows<T> };
+			const uint64 panelCount{ (rowCount + rows - 1) / rows };
+			ParallelFor(0, panelCount, 8, [&](uint64 begin, uint64 end) {
+				for (uint64 panel{ begin }; panel < end; ++panel) {
+					T* destination{ packed + panel * rows * depth };
+					const uint64 row{ panel * rows };
+					const uint32 m{ static_cast<uint32>(std::min<uint64>(rows, rowCount - row)) };
+					for (uint32 k{ 0 }; k < depth; ++k) {
+						for (uint32 i{ 0 }; i < m; ++i)
+							destination[k * rows + i] = alpha * element(a, op, row + i, first + k);
+						for (uint32 i{ m }; i < rows; ++i)
+							destination[k * rows + i] = T(0);
+					}
+				}
+			});
+		}
+
+		// Packs the block of op(B) at the rows [first, first + depth) and the
+		// columns [column, column + count) into panels of TileColumns
+		// columns, which hold the columns of each row contiguously. The
+		// columns of the last panel are padded with zero.
+		template<typename T>
+		void pack_b(DenseMatrix<T> const& b, MatrixOp op, uint32 first, uint32 depth, uint32 column, uint32 count,
+			T* packed)
+		{
+			const uint64 panelCount{ (count + TileColumns - 1) / TileColumns };
+			ParallelFor(0, panelCount, 4, [&](uint64 begin, uint64 end) {
+				for (uint64 panel{ begin }; panel < end; ++panel) {
+					T* destination{ packed + panel * TileColumns * depth };
+					const uint64 j0{ column + panel * TileColumns };
+					const uint32 n{ static_cast<uint32>(std::min<uint64>(TileColumns, column + count - j0)) };
+					for (uint32 k{ 0 }; k < depth; ++k) {
+						for (uint32 j{ 0 }; j < n; ++j)
+							destination[k * TileColumns + j] = element(b, op, first + k, j0 + j);
+						for (uint32 j{ n }; j < TileColumns; ++j)
+							destination[k * TileColumns + j] = T(0);
+					}
+				}
+			});
+		}
+
+		template<typename T, typename Function>
+		void for_each_element(uint64 count, Function&& function)
+		{
+			ParallelFor(0, count, ElementGrain, [&](uint64 begin, uint64 end) {
+				for (uint64 i{ begin }; i < end; ++i)
+					function(i);
+			});
+		}
+
+		// Resizes the result of an element-wise operation, unless it has the
+		// size already, which keeps the elements of an operand, which is
+		// the result as well
+		template<typename T>
+		void prepare_result(DenseMatrix<T>& result, uint32 rows, uint32 columns)
+		{
+			if (result.GetRows() != rows || result.GetColumns() != columns)
+				result.Resize(rows, columns);
+		}
+
+		template<typename T>
+		inline bool same_size(DenseMatrix<T> const& a, DenseMatrix<T> const& b)
+		{
+			return a.GetRows() == b.GetRows() && a.GetColumns() == b.GetColumns();
+		}
+
+		// The dot product of two arrays
+		template<typename T>
+		T dot(T const* a, T const* b, uint64 count)
+		{
+			typedef lanes<T> L;
+			typename L::type sum0{ L::zero() }, sum1{ L::zero() };
+			uint64 i{ 0 };
+			for (; i + 2 * L::count <= count; i += 2 * L::count) {
+				sum0 = L::fmadd(L::loadu(a + i), L::loadu(b + i), sum0);
+				sum1 = L::fmadd(L::loadu(a + i + L::count), L::loadu(b + i + L::count), sum1);
+			}
+			ECM_ALIGN(64) T sums[L::count];
+			L::store(sums, L::add(sum0, sum1));
+			T result{ 0 };
+			for (uint32 lane{ 0 }; lane < L::count; ++lane)
+				result += sums[lane];
+			for (; i < count; ++i)
+				result += a[i] * b[i];
+			return result;
+		}
+	} // anonymous namespace
+
+	// DenseMatrix
+
+	template<typename T>
+	DenseMatrix<T>::DenseMatrix(uint32 rows, uint32 columns, T value)
+	{
+		Resize(rows, columns);
+		if (value != T(0))
+			Fill(value);
+	}
+
+	template<typename T>
+	DenseMatrix<T>::DenseMatrix(DenseMatrix const& other)
+		: _rows{ other._rows }, _columns{ other._columns }
+	{
+		const uint64 count{ static_cast<uint64>(_rows) * _columns };
+		if (count) {
+			_data = allocate_aligned<T>(count);
+			_capacity = count;
+			std::copy(other._data, other._data + count, _data);
+		}
+	}
+
+	template<typename T>
+	DenseMatrix<T>::DenseMatrix(DenseMatrix&& other) noexcept
+		: _data{ other._data }, _capacity{ other._capacity }, _rows{ other._rows }, _columns{ other._columns }
+	{
+		other._data = nullptr;
+		other._capacity = 0;
+		other._rows = 0;
+		other._columns = 0;
+	}
+
+	template<typename T>
+	DenseMatrix<T>::~DenseMatrix()
+	{
+		free_aligned(_data);
+	}
+
+	template<typename T>
+	DenseMatrix<T>& DenseMatrix<T>::operator=(DenseMatrix const& other)
+	{
+		if (this != &other) {
+			const uint64 count{ static_cast<uint64>(other._rows) * other._columns };
+			if (count > _capacity) {
+				T* data{ allocate_aligned<T>(count) };
+				free_aligned(_data);
+				_data = data;
+				_capacity = count;
+			}
+			_rows = other._rows;
+			_columns = other._columns;
+			std::copy(other._data, other._data + count, _data);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	DenseMatrix<T>& DenseMatrix<T>::operator=(DenseMatrix&& other) noexcept
+	{
+		if (this != &other) {
+			free_aligned(_data);
+			_data = other._data;
+			_capacity = other._capacity;
+			_rows = other._rows;
+			_columns = other._columns;
+			other._data = nullptr;
+			other._capacity = 0;
+			other._rows = 0;
+			other._columns = 0;
+		}
+		return *this;
+	}
+
+	template<typename T>
+	void DenseMatrix<T>::Resize(uint32 rows, uint32 columns)
+	{
+		const uint64 count{ static_cast<uint64>(rows) * columns };
+		if (count > _capacity) {
+			T* data{ allocate_aligned<T>(count) };
+			free_aligned(_data);
+			_data = data;
+			_capacity = count;
+		}
+		_rows = rows;
+		_columns = columns;
+		std::fill(_data, _data + count, T(0));
+	}
+
+	template<typename T>
+	void DenseMatrix<T>::Fill(T value) noexcept
+	{
+		std::fill(_data, _data + static_cast<uint64>(_rows) * _columns, value);
+	}
+
+	template<typename T>
+	T& DenseMatrix<T>::operator()(uint32 row, uint32 column) noexcept
+	{
+		return _data[static_cast<uint64>(column) * _rows + row];
+	}
+
+	template<typename T>
+	T const& DenseMatrix<T>::operator()(uint32 row, uint32 column) const noexcept
+	{
+		return _data[static_cast<uint64>(column) * _rows + row];
+	}
+
+	template<typename T>
+	uint32 DenseMatrix<T>::GetRows() const noexcept
+	{
+		return _rows;
+	}
+
+	template<typename T>
+	uint32 DenseMatrix<T>::GetColumns() const noexcept
+	{
+		return _columns;
+	}
+
+	template<typename T>
+	T* DenseMatrix<T>::GetData() noexcept
+	{
+		return _data;
+	}
+
+	template<typename T>
+	T const* DenseMatrix<T>::GetData() const noexcept
+	{
+		return _data;
+	}
+
+	template class DenseMatrix<float32>;
+	template class DenseMatrix<float64>;
+
+	// Operations
+
+	template<typename T>
+	bool Gemm(T alpha, DenseMatrix<T> const& a, MatrixOp opA, DenseMatrix<T> const& b, MatrixOp opB, T beta,
+		DenseMatrix<T>& c)
+	{
+		const uint32 m{ opA == MatrixOp::NONE ? a.GetRows() : a.GetColumns() };
+		const uint32 depth{ opA == MatrixOp::NONE ? a.GetColumns() : a.GetRows() };
+		const uint32 n{ opB == MatrixOp::NONE ? b.GetColumns() : b.GetRows() };
+		if ((opB == MatrixOp::NONE ? b.GetRows() : b.GetColumns()) != depth)
+			return false;
+		if (beta == T(0)) {
+			c.Resize(m, n);
+		} else {
+			if (c.GetRows() != m || c.GetColumns() != n)
+				return false;
+			if (beta != T(1)) {
+				T* data{ c.GetData() };
+				for_each_element<T>(static_cast<uint64>(m) * n, [&](uint64 i) { data[i] *= beta; });
+			}
+		}
+		if (!m || !n || !depth || alpha == T(0))
+			return true;
+
+		constexpr uint32 rows{ tile_rows<T> };
+		constexpr uint32 blockRows{ block_rows<T> };
+		const uint32 panelDepth{ std::min(depth, PanelDepth) };
+		const uint32 panelColumns{ std::min(n, PanelColumns) };
+		aligned_buffer<T> packedA{ static_cast<uint64>((m + rows - 1) / rows) * rows * panelDepth };
+		aligned_buffer<T> packedB{ static_cast<uint64>((panelColumns + TileColumns - 1) / TileColumns) *
+			TileColumns * panelDepth };
+		const uint64 stride{ m };
+		T* data{ c.GetData() };
+		const uint64 blockCount{ (m + blockRows - 1) / blockRows };
+		for (uint32 first{ 0 }; first < depth; first += PanelDepth) {
+			const uint32 kc{ std::min(PanelDepth, depth - first) };
+			pack_a(alpha, a, opA, m, first, kc, packedA.data);
+			for (uint32 column{ 0 }; column < n; column += PanelColumns) {
+				const uint32 nc{ std::min(PanelColumns, n - column) };
+				pack_b(b, opB, first, kc, column, nc, packedB.data);
+				// Each task computes the tiles of a block of rows and a group
+				// of columns, so that even thin products keep all threads
+				// busy
+				const uint64 groupCount{ (nc + TaskColumns - 1) / TaskColumns };
+				ParallelFor(0, blockCount * groupCount, 1, [&](uint64 begin, uint64 end) {
+					for (uint64 task{ begin }; task < end; ++task) {
+						const uint32 row0{ static_cast<uint32>(task % blockCount) * blockRows };
+						const uint32 rowEnd{ std::min(m, row0 + blockRows) };
+						const uint32 column0{ static_cast<uint32>(task / blockCount) * TaskColumns };
+						const uint32 columnEnd{ std::min(nc, column0 + TaskColumns) };
+						for (uint32 j{ column0 }; j < columnEnd; j += TileColumns) {
+							T const* panelB{ packedB.data + static_cast<uint64>(j) * kc };
+							const uint32 tileColumns{ std::min(TileColumns, columnEnd - j) };
+							for (uint32 i{ row0 }; i < rowEnd; i += rows) {
+								micro_kernel(kc, packedA.data + static_cast<uint64>(i) * kc, panelB,
+									data + (column + j) * stride + i, stride, std::min(rows, rowEnd - i), tileColumns);
+							}
+						}
+					}
+				});
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	void Gemv(T alpha, DenseMatrix<T> const& a, MatrixOp opA, T const* x, T beta, T* y) noexcept
+	{
+		typedef lanes<T> L;
+		const uint64 rows{ a.GetRows() };
+		const uint64 columns{ a.GetColumns() };
+		T const* data{ a.GetData() };
+		if (opA == MatrixOp::NONE) {
+			// Each chunk adds the columns times x to its rows of y, four
+			// columns at a time
+			ParallelFor(0, rows, RowGrain, [&](uint64 begin, uint64 end) {
+				for (uint64 i{ begin }; i < end; ++i)
+					y[i] = beta == T(0) ? T(0) : beta * y[i];
+				uint64 k{ 0 };
+				for (; k + 4 <= columns; k += 4) {
+					T const* a0{ data + k * rows };
+					T const* a1{ a0 + rows };
+					T const* a2{ a1 + rows };
+					T const* a3{ a2 + rows };
+					const T x0{ alpha * x[k] }, x1{ alpha * x[k + 1] }, x2{ alpha * x[k + 2] }, x3{ alpha * x[k + 3] };
+					const typename L::type v0{ L::set1(x0) }, v1{ L::set1(x1) }, v2{ L::set1(x2) }, v3{ L::set1(x3) };
+					uint64 i{ begin };
+					for (; i + L::count <= end; i += L::count) {
+						typename L::type sum{ L::loadu(y + i) };
+						sum = L::fmadd(L::loadu(a0 + i), v0, sum);
+						sum = L::fmadd(L::loadu(a1 + i), v1, sum);
+						sum = L::fmadd(L::loadu(a2 + i), v2, sum);
+						sum = L::fmadd(L::loadu(a3 + i), v3, sum);
+						L::storeu(y + i, sum);
+					}
+					for (; i < end; ++i)
+						y[i] += a0[i] * x0 + a1[i] * x1 + a2[i] * x2 + a3[i] * x3;
+				}
+				for (; k < columns; ++k) {
+					T const* column{ data + k * rows };
+					const T factor{ alpha * x[k] };
+					for (uint64 i{ begin }; i < end; ++i)
+						y[i] += column[i] * factor;
+				}
+			});
+		} else {
+			ParallelFor(0, columns, ColumnGrain, [&](uint64 begin, uint64 end) {
+				for (uint64 j{ begin }; j < end; ++j) {
+					const T product{ alpha * dot(data + j * rows, x, rows) };
+					y[j] = beta == T(0) ? product : product + beta * y[j];
+				}
+			});
+		}
+	}
+
+	template<typename T>
+	void Transpose(DenseMatrix<T> const& a, DenseMatrix<T>& result)
+	{
+		const uint32 rows{ a.GetRows() };
+		const uint32 columns{ a.GetColumns() };
+		prepare_result(result, columns, rows);
+		T const* source{ a.GetData() };
+		T* destination{ result.GetData() };
+		// Each chunk transposes the blocks of a strip of columns, whose rows
+		// of the result stay in the cache
+		const uint64 stripCount{ (columns + TransposeBlock - 1) / TransposeBlock };
+		ParallelFor(0, stripCount, 1, [&](uint64 begin, uint64 end) {
+			for (uint64 strip{ begin }; strip < end; ++strip) {
+				const uint64 column0{ strip * TransposeBlock };
+				const uint64 columnEnd{ std::min<uint64>(columns, column0 + TransposeBlock) };
+				for (uint64 row0{ 0 }; row0 < rows; row0 += TransposeBlock) {
+					const uint64 rowEnd{ std::min<uint64>(rows, row0 + TransposeBlock) };
+					for (uint64 r{ row0 }; r < rowEnd; ++r) {
+						for (uint64 c{ column0 }; c < columnEnd; ++c)
+							destination[r * columns + c] = source[c * rows + r];
+					}
+				}
+			}
+		});
+	}
+
+	template<typename T>
+	bool Add(DenseMatrix<T> const& a, DenseMatrix<T> const& b, DenseMatrix<T>& result)
+	{
+		if (!same_size(a, b))
+			return false;
+		prepare_result(result, a.GetRows(), a.GetColumns());
+		T const* x{ a.GetData() };
+		T const* y{ b.GetData() };
+		T* z{ result.GetData() };
+		for_each_element<T>(static_cast<uint64>(a.GetRows()) * a.GetColumns(), [&](uint64 i) { z[i] = x[i] + y[i]; });
+		return true;
+	}
+
+	template<typename T>
+	bool Subtract(DenseMatrix<T> const& a, DenseMatrix<T> const& b, DenseMatrix<T>& result)
+	{
+		if (!same_size(a, b))
+			return false;
+		prepare_result(result, a.GetRows(), a.GetColumns());
+		T const* x{ a.GetData() };
+		T const* y{ b.GetData() };
+		T* z{ result.GetData() };
+		for_each_element<T>(static_cast<uint64>(a.GetRows()) * a.GetColumns(), [&](uint64 i) { z[i] = x[i] - y[i]; });
+		return true;
+	}
+
+	template<typename T>
+	bool MultiplyElements(DenseMatrix<T> const& a, DenseMatrix<T> const& b, DenseMatrix<T>& result)
+	{
+		if (!same_size(a, b))
+			return false;
+		prepare_result(result, a.GetRows(), a.GetColumns());
+		T const* x{ a.GetData() };
+		T const* y{ b.GetData() };
+		T* z{ result.GetData() };
+		for_each_element<T>(static_cast<uint64>(a.GetRows()) * a.GetColumns(), [&](uint64 i) { z[i] = x[i] * y[i]; });
+		return true;
+	}
+
+	template<typename T>
+	void Scale(DenseMatrix<T> const& a, T scalar, DenseMatrix<T>& result)
+	{
+		prepare_result(result, a.GetRows(), a.GetColumns());
+		T const* x{ a.GetData() };
+		T* z{ result.GetData() };
+		for_each_element<T>(static_cast<uint64>(a.GetRows()) * a.GetColumns(), [&](uint64 i) { z[i] = x[i] * scalar; });
+	}
+
+	template bool Gemm<float32>(float32, DenseMatrix<float32> const&, MatrixOp, DenseMatrix<float32> const&, MatrixOp,
+		float32, DenseMatrix<float32>&);
+	template bool Gemm<float64>(float64, DenseMatrix<float64> const&, MatrixOp, DenseMatrix<float64> const&, MatrixOp,
+		float64, DenseMatrix<float64>&);
+	template void Gemv<float32>(float32, DenseMatrix<float32> const&, MatrixOp, float32 const*, float32,
+		float32*) noexcept;
+	template void Gemv<float64>(float64, DenseMatrix<float64> const&, MatrixOp, float64 const*, float64,
+		float64*) noexcept;
+	template void Transpose<float32>(DenseMatrix<float32> const&, DenseMatrix<float32>&);
+	template void Transpose<float64>(DenseMatrix<float64> const&, DenseMatrix<float64>&);
+	template bool Add<float32>(DenseMatrix<float32> const&, DenseMatrix<float32> const&, DenseMatrix<float32>&);
+	template bool Add<float64>(DenseMatrix<float64> const&, DenseMatrix<float64> const&, DenseMatrix<float64>&);
+	template bool Subtract<float32>(DenseMatrix<float32> const&, DenseMatrix<float32> const&, DenseMatrix<float32>&);
+	template bool Subtract<float64>(DenseMatrix<float64> const&, DenseMatrix<float64> const&, DenseMatrix<float64>&);
+	template bool MultiplyElements<float32>(DenseMatrix<float32> const&, DenseMatrix<float32> const&,
+		DenseMatrix<float32>&);
+	template bool MultiplyElements<float64>(DenseMatrix<float64> const&, DenseMatrix<float64> const&,
+		DenseMatrix<float64>&);
+	template void Scale<float32>(DenseMatrix<float32> const&, float32, DenseMatrix<float32>&);
+	template void Scale<float64>(DenseMatrix<float64> const&, float64, DenseMatrix<float64>&);
+} // namespace ecm::math
@@ -0,0 +1,472 @@
+#include <ECM/math/easing.h>
+#include <ECM/math/functions.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The number of floats of the stack buffers, a multiple of the lane
+		// count and of the vector sizes
+		constexpr uint64 BufferSize{ 768 };
+		// The number of tracks of a chunk of EvaluateTracks
+		constexpr uint64 TrackGrain{ 16384 };
+
+		constexpr float32 BackC1{ 1.70158f };
+		constexpr float32 BackC2{ BackC1 * 1.525f };
+		constexpr float32 ElasticC4{ 2.0943951f };
+		constexpr float32 ElasticC5{ 1.3962634f };
+
+		static_assert(sizeof(Vector2_Base<float32>) == 2 * sizeof(float32));
+		static_assert(sizeof(Vector3_Base<float32>) == 3 * sizeof(float32));
+		static_assert(sizeof(Vector4_Base<float32>) == 4 * sizeof(float32));
+
+		// The kernels use the lane types of simd_lanes.h, so the batch
+		// functions and the scalar ones give the same values.
+
+		// NaN gives 0
+		template<typename F>
+		inline F clamp_unit(F t)
+		{
+			return lane_min(F(1.f), lane_max(t, F(0.f)));
+		}
+
+		// The same comparisons as Clamp
+		template<typename F>
+		inline F clamp_range(F v, F min, F max)
+		{
+			return lane_min(max, lane_max(min, v));
+		}
+
+		// 2^x for x in [-126, 0], with the polynomial of the fraction in
+		// [-0.5, 0.5] of Cephes' exp2f
+		template<typename F, typename I>
+		inline F exp2_negative(F x)
+		{
+			const I n{ lane_round(x) };
+			const F f{ x - lane_to_float(n) };
+			F p{ F(1.535336188e-4f) };
+			p = p * f + F(1.339887440e-3f);
+			p = p * f + F(9.618437357e-3f);
+			p = p * f + F(5.550332471e-2f);
+			p = p * f + F(2.402264791e-1f);
+			p = p * f + F(6.931472028e-1f);
+			return (p * f + F(1.f)) * lane_as_float((n + I(127u)) << 23);
+		}
+
+		// sin(x) for |x| < 100, reduced to [-pi/2, pi/2] with a two-part pi
+		template<typename F, typename I>
+		inline F sin_reduced(F x)
+		{
+			const I k{ lane_round(x * F(0.318309886f)) };
+			const F kf{ lane_to_float(k) };
+			const F r{ (x - kf * F(3.140625f)) - kf * F(9.67653589e-4f) };
+			const F r2{ r * r };
+			F p{ F(-2.5052108e-8f) };
+			p = p * r2 + F(2.7557319e-6f);
+			p = p * r2 + F(-1.9841270e-4f);
+			p = p * r2 + F(8.3333333e-3f);
+			p = p * r2 + F(-1.6666667e-1f);
+			const F s{ r + r * r2 * p };
+			return lane_select(lane_test(k, 1u), -s, s);
+		}
+
+		// The curves of easings.net for t in [0, 1]
+		template<EaseType Type, typename F, typename I>
+		inline F ease(F t)
+		{
+			if constexpr (Type == EaseType::QUAD_IN) {
+				return t * t;
+			} else if constexpr (Type == EaseType::QUAD_OUT) {
+				const F u{ F(1.f) - t };
+				return F(1.f) - u * u;
+			} else if constexpr (Type == EaseType::QUAD_IN_OUT) {
+				const auto low{ t < F(0.5f) };
+				const F u{ F(2.f) - F(2.f) * t };
+				return lane_select(low, F(2.f) * t * t, F(1.f) - u * u * F(0.5f));
+			} else if constexpr (Type == EaseType::CUBIC_IN) {
+				return t * t * t;
+			} else if constexpr (Type == EaseType::CUBIC_OUT) {
+				const F u{ F(1.f) - t };
+				return F(1.f) - u * u * u;
+			} else if constexpr (Type == EaseType::CUBIC_IN_OUT) {
+				const auto low{ t < F(0.5f) };
+				const F u{ F(2.f) - F(2.f) * t };
+				return lane_select(low, F(4.f) * t * t * t, F(1.f) - u * u * u * F(0.5f));
+			} else if constexpr (Type == EaseType::EXPO_IN) {
+				return lane_select(t <= F(0.f), F(0.f), exp2_negative<F, I>(F(10.f) * t - F(10.f)));
+			} else if constexpr (Type == EaseType::EXPO_OUT) {
+				return lane_select(t >= F(1.f), F(1.f), F(1.f) - exp2_negative<F, I>(F(-10.f) * t));
+			} else if constexpr (Type == EaseType::EXPO_IN_OUT) {
+				const auto low{ t < F(0.5f) };
+				const F e{ exp2_negative<F, I>(lane_select(low, F(20.f) * t - F(10.f), F(10.f) - F(20.f) * t)) * F(0.5f) };
+				const F value{ lane_select(low, e, F(1.f) - e) };
+				return lane_select(t <= F(0.f), F(0.f), lane_select(t >= F(1.f), F(1.f), value));
+			} else if constexpr (Type == EaseType::ELASTIC_IN) {
+				const F s{ sin_reduced<F, I>((F(10.f) * t - F(10.75f)) * F(ElasticC4)) };
+				const F value{ -(exp2_negative<F, I>(F(10.f) * t - F(10.f)) * s) };
+				return lane_select(t <= F(0.f), F(0.f), lane_select(t >= F(1.f), F(1.f), value));
+			} else if constexpr (Type == EaseType::ELASTIC_OUT) {
+				const F s{ sin_reduced<F, I>((F(10.f) * t - F(0.75f)) * F(ElasticC4)) };
+				const F value{ exp2_negative<F, I>(F(-10.f) * t) * s + F(1.f) };
+				return lane_select(t <= F(0.f), F(0.f), lane_select(t >= F(1.f), F(1.f), value));
+			} else if constexpr (Type == EaseType::ELASTIC_IN_OUT) {
+				const auto low{ t < F(0.5f) };
+				const F s{ sin_reduced<F, I>((F(20.f) * t - F(11.125f)) * F(ElasticC5)) };
+				const F e{ exp2_negative<F, I>(lane_select(low, F(20.f) * t - F(10.f), F(10.f) - F(20.f) * t)) * s * F(0.5f) };
+				const F value{ lane_select(low, -e, e + F(1.f)) };
+				return lane_select(t <= F(0.f), F(0.f), lane_select(t >= F(1.f), F(1.f), value));
+			} else if constexpr (Type == EaseType::BACK_IN) {
+				return t * t * (F(BackC1 + 1.f) * t - F(BackC1));
+			} else if constexpr (Type == EaseType::BACK_OUT) {
+				const F u{ t - F(1.f) };
+				return F(1.f) + u * u * (F(BackC1 + 1.f) * u + F(BackC1));
+			} else if constexpr (Type == EaseType::BACK_IN_OUT) {
+				const auto low{ t < F(0.5f) };
+				const F a{ lane_select(low, F(2.f) * t, F(2.f) * t - F(2.f)) };
+				const F q{ a * a * (F(BackC2 + 1.f) * a + lane_select(low, F(-BackC2), F(BackC2))) * F(0.5f) };
+				return lane_select(low, q, q + F(1.f));
+			} else {
+				return t;
+			}
+		}
+
+		template<EaseType Type>
+		using ease_constant = std::integral_constant<EaseType, Type>;
+
+		// Calls the visitor with the curve as compile-time constant, so the
+		// loops don't branch on it
+		template<typename Visitor>
+		inline void visit_ease(EaseType type, Visitor&& visitor)
+		{
+			switch (type) {
+			case EaseType::QUAD_IN: visitor(ease_constant<EaseType::QUAD_IN>{}); break;
+			case EaseType::QUAD_OUT: visitor(ease_constant<EaseType::QUAD_OUT>{}); break;
+			case EaseType::QUAD_IN_OUT: visitor(ease_constant<EaseType::QUAD_IN_OUT>{}); break;
+			case EaseType::CUBIC_IN: visitor(ease_constant<EaseType::CUBIC_IN>{}); break;
+			case EaseType::CUBIC_OUT: visitor(ease_constant<EaseType::CUBIC_OUT>{}); break;
+			case EaseType::CUBIC_IN_OUT: visitor(ease_constant<EaseType::CUBIC_IN_OUT>{}); break;
+			case EaseType::EXPO_IN: visitor(ease_constant<EaseType::EXPO_IN>{}); break;
+			case EaseType::EXPO_OUT: visitor(ease_constant<EaseType::EXPO_OUT>{}); break;
+			case EaseType::EXPO_IN_OUT: visitor(ease_constant<EaseType::EXPO_IN_OUT>{}); break;
+			case EaseType::ELASTIC_IN: visitor(ease_constant<EaseType::ELASTIC_IN>{}); break;
+			case EaseType::ELASTIC_OUT: visitor(ease_constant<EaseType::ELASTIC_OUT>{}); break;
+			case EaseType::ELASTIC_IN_OUT: visitor(ease_constant<EaseType::ELASTIC_IN_OUT>{}); break;
+			case EaseType::BACK_IN: visitor(ease_constant<EaseType::BACK_IN>{}); break;
+			case EaseType::BACK_OUT: visitor(ease_constant<EaseType::BACK_OUT>{}); break;
+			case EaseType::BACK_IN_OUT: visitor(ease_constant<EaseType::BACK_IN_OUT>{}); break;
+			default: visitor(ease_constant<EaseType::LINEAR>{}); break;
+			}
+		}
+
+		// Applies a kernel to the lanes of the input arrays, and the
+		// remainder one by one
+		template<typename Kernel, typename... Inputs>
+		inline void map_lanes(float32* out, uint64 count, Kernel const& kernel, Inputs... in)
+		{
+			uint64 i{ 0 };
+			for (; i + LaneCount <= count; i += LaneCount)
+				storeu_ps(out + i, kernel(vfloat(loadu_ps(in + i))...).v);
+			for (; i < count; ++i)
+				out[i] = kernel(in[i]...);
+		}
+
+		template<EaseType Type>
+		inline void ease_lanes(float32 const* t, float32* out, uint64 count)
+		{
+			map_lanes(out, count, [](auto t) {
+				using F = decltype(t);
+				return ease<Type, F, decltype(lane_to_int(t))>(clamp_unit(t));
+			}, t);
+		}
+
+		inline void lerp_lanes(float32 const* x, float32 const* y, float32 const* t, float32* out, uint64 count)
+		{
+			map_lanes(out, count, [](auto x, auto y, auto t) {
+				return x + (y - x) * t;
+			}, x, y, t);
+		}
+
+		inline void lerp_lanes(float32 const* x, float32 const* y, float32 t, float32* out, uint64 count)
+		{
+			map_lanes(out, count, [t](auto x, auto y) {
+				using F = decltype(x);
+				return x + (y - x) * F(t);
+			}, x, y);
+		}
+
+		// Repeats the factor of each vector for its N components
+		template<uint64 N>
+		void lerp_vectors(float32 const* x, float32 const* y, float32 const* t, float32* out, uint64 count)
+		{
+			float32 factors[BufferSize];
+			for (uint64 i{ 0 }; i < count; i += BufferSize / N) {
+				const uint64 n{ std::min(count - i, BufferSize / N) };
+				for (uint64 j{ 0 }; j < n; ++j) {
+					for (uint64 c{ 0 }; c < N; ++c)
+						factors[j * N + c] = t[i + j];
+				}
+				lerp_lanes(x + i * N, y + i * N, factors, out + i * N, n * N);
+			}
+		}
+
+		// Clamps to bounds, which repeat every N components. A block of
+		// three lane groups is a multiple of N, so its bounds stay in
+		// registers.
+		template<uint64 N>
+		void clamp_components(float32 const* v, float32 const* min, float32 const* max, float32* out, uint64 count)
+		{
+			constexpr uint64 period{ LaneCount * 3 };
+			float32 mins[period];
+			float32 maxs[period];
+			for (uint64 i{ 0 }; i < period; ++i) {
+				mins[i] = min[i % N];
+				maxs[i] = max[i % N];
+			}
+			vfloat minLanes[3];
+			vfloat maxLanes[3];
+			for (uint64 j{ 0 }; j < 3; ++j) {
+				minLanes[j] = loadu_ps(mins + j * LaneCount);
+				maxLanes[j] = loadu_ps(maxs + j * LaneCount);
+			}
+			uint64 i{ 0 };
+			for (; i + period <= count; i += period) {
+				for (uint64 j{ 0 }; j < 3; ++j) {
+					const uint64 offset{ i + j * LaneCount };
+					storeu_ps(out + offset, clamp_range(vfloat(loadu_ps(v + offset)), minLanes[j], maxLanes[j]).v);
+				}
+			}
+			for (; i < count; ++i)
+				out[i] = clamp_range(v[i], mins[i % period], maxs[i % period]);
+		}
+
+		inline void smooth_step_lanes(float32 edge0, float32 edge1, float32 const* x, float32* out, uint64 count)
+		{
+			map_lanes(out, count, [edge0, edge1](auto x) {
+				using F = decltype(x);
+				const F t{ clamp_range((x - F(edge0)) / (F(edge1) - F(edge0)), F(0.f), F(1.f)) };
+				return t * t * (F(3.f) - F(2.f) * t);
+			}, x);
+		}
+
+		inline void remap_lanes(float32 const* v, float32 inMin, float32 inMax, float32 outMin, float32 outMax,
+			float32* out, uint64 count)
+		{
+			map_lanes(out, count, [=](auto v) {
+				using F = decltype(v);
+				const F t{ (v - F(inMin)) / (F(inMax) - F(inMin)) };
+				return F(outMin) + (F(outMax) - F(outMin)) * t;
+			}, v);
+		}
+
+		template<EaseType Type>
+		inline void ease_tracks(EaseTracks const& tracks, float32 time, float32 const* from, float32 const* to,
+			float32* out, uint64 begin, uint64 end)
+		{
+			map_lanes(out + begin, end - begin, [time](auto start, auto duration, auto from, auto to) {
+				using F = decltype(start);
+				const F t{ ease<Type, F, decltype(lane_to_int(start))>(clamp_unit((F(time) - start) / duration)) };
+				return from + (to - from) * t;
+			}, tracks.start + begin, tracks.duration + begin, from + begin, to + begin);
+		}
+
+		// Eases the factors of a chunk of tracks, and interpolates their N
+		// components
+		template<uint64 N>
+		void evaluate_vector_tracks(EaseTracks const& tracks, float32 time, float32 const* from, float32 const* to,
+			float32* out, uint64 count)
+		{
+			ParallelFor(0, count, TrackGrain, [&](uint64 begin, uint64 end) {
+				float32 factors[BufferSize];
+				for (uint64 i{ begin }; i < end; i += BufferSize) {
+					const uint64 n{ std::min(end - i, BufferSize) };
+					visit_ease(tracks.type, [&](auto constant) {
+						map_lanes(factors, n, [time](auto start, auto duration) {
+							using F = decltype(start);
+							return ease<decltype(constant)::value, F, decltype(lane_to_int(start))>(
+								clamp_unit((F(time) - start) / duration));
+						}, tracks.start + i, tracks.duration + i);
+					});
+					lerp_vectors<N>(from + i * N, to + i * N, factors, out + i * N, n);
+				}
+			});
+		}
+
+		template<typename Vector>
+		inline float32 const* components(Vector const* v)
+		{
+			return reinterpret_cast<float32 const*>(v);
+		}
+
+		template<typename Vector>
+		inline float32* components(Vector* v)
+		{
+			return reinterpret_cast<float32*>(v);
+		}
+	} // anonymous namespace
+
+	float32 Ease(EaseType type, float32 t) noexcept
+	{
+		float32 value{ 0.f };
+		visit_ease(type, [&](auto constant) {
+			value = ease<decltype(constant)::value, float32, uint32>(clamp_unit(t));
+		});
+		return value;
+	}
+
+	void LerpBatch(float32 const* x, float32 const* y, float32 t, float32* out, uint64 count) noexcept
+	{
+		lerp_lanes(x, y, t, out, count);
+	}
+
+	void LerpBatch(float32 const* x, float32 const* y, float32 const* t, float32* out, uint64 count) noexcept
+	{
+		lerp_lanes(x, y, t, out, count);
+	}
+
+	void LerpBatch(Vector2_Base<float32> const* x, Vector2_Base<float32> const* y, float32 t,
+		Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_lanes(components(x), components(y), t, components(out), count * 2);
+	}
+
+	void LerpBatch(Vector3_Base<float32> const* x, Vector3_Base<float32> const* y, float32 t,
+		Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_lanes(components(x), components(y), t, components(out), count * 3);
+	}
+
+	void LerpBatch(Vector4_Base<float32> const* x, Vector4_Base<float32> const* y, float32 t,
+		Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_lanes(components(x), components(y), t, components(out), count * 4);
+	}
+
+	void LerpBatch(Vector2_Base<float32> const* x, Vector2_Base<float32> const* y, float32 const* t,
+		Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_vectors<2>(components(x), components(y), t, components(out), count);
+	}
+
+	void LerpBatch(Vector3_Base<float32> const* x, Vector3_Base<float32> const* y, float32 const* t,
+		Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_vectors<3>(components(x), components(y), t, components(out), count);
+	}
+
+	void LerpBatch(Vector4_Base<float32> const* x, Vector4_Base<float32> const* y, float32 const* t,
+		Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		lerp_vectors<4>(components(x), components(y), t, components(out), count);
+	}
+
+	void ClampBatch(float32 const* v, float32 min, float32 max, float32* out, uint64 count) noexcept
+	{
+		clamp_components<1>(v, &min, &max, out, count);
+	}
+
+	void ClampBatch(Vector2_Base<float32> const* v, Vector2_Base<float32> const& min,
+		Vector2_Base<float32> const& max, Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		clamp_components<2>(components(v), min.coord, max.coord, components(out), count * 2);
+	}
+
+	void ClampBatch(Vector3_Base<float32> const* v, Vector3_Base<float32> const& min,
+		Vector3_Base<float32> const& max, Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		clamp_components<3>(components(v), min.coord, max.coord, components(out), count * 3);
+	}
+
+	void ClampBatch(Vector4_Base<float32> const* v, Vector4_Base<float32> const& min,
+		Vector4_Base<float32> const& max, Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		clamp_components<4>(components(v), min.coord, max.coord, components(out), count * 4);
+	}
+
+	void SmoothStepBatch(float32 edge0, float32 edge1, float32 const* x, float32* out, uint64 count) noexcept
+	{
+		smooth_step_lanes(edge0, edge1, x, out, count);
+	}
+
+	void SmoothStepBatch(float32 edge0, float32 edge1, Vector2_Base<float32> const* x,
+		Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		smooth_step_lanes(edge0, edge1, components(x), components(out), count * 2);
+	}
+
+	void SmoothStepBatch(float32 edge0, float32 edge1, Vector3_Base<float32> const* x,
+		Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		smooth_step_lanes(edge0, edge1, components(x), components(out), count * 3);
+	}
+
+	void SmoothStepBatch(float32 edge0, float32 edge1, Vector4_Base<float32> const* x,
+		Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		smooth_step_lanes(edge0, edge1, components(x), components(out), count * 4);
+	}
+
+	void RemapBatch(float32 const* v, float32 inMin, float32 inMax, float32 outMin, float32 outMax,
+		float32* out, uint64 count) noexcept
+	{
+		remap_lanes(v, inMin, inMax, outMin, outMax, out, count);
+	}
+
+	void RemapBatch(Vector2_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		remap_lanes(components(v), inMin, inMax, outMin, outMax, components(out), count * 2);
+	}
+
+	void RemapBatch(Vector3_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		remap_lanes(components(v), inMin, inMax, outMin, outMax, components(out), count * 3);
+	}
+
+	void RemapBatch(Vector4_Base<float32> const* v, float32 inMin, float32 inMax, float32 outMin,
+		float32 outMax, Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		remap_lanes(components(v), inMin, inMax, outMin, outMax, components(out), count * 4);
+	}
+
+	void EaseBatch(EaseType type, float32 const* t, float32* out, uint64 count) noexcept
+	{
+		visit_ease(type, [&](auto constant) {
+			ease_lanes<decltype(constant)::value>(t, out, count);
+		});
+	}
+
+	void EvaluateTracks(EaseTracks const& tracks, float32 time, float32 const* from, float32 const* to,
+		float32* out, uint64 count) noexcept
+	{
+		visit_ease(tracks.type, [&](auto constant) {
+			ParallelFor(0, count, TrackGrain, [&](uint64 begin, uint64 end) {
+				ease_tracks<decltype(constant)::value>(tracks, time, from, to, out, begin, end);
+			});
+		});
+	}
+
+	void EvaluateTracks(EaseTracks const& tracks, float32 time, Vector2_Base<float32> const* from,
+		Vector2_Base<float32> const* to, Vector2_Base<float32>* out, uint64 count) noexcept
+	{
+		evaluate_vector_tracks<2>(tracks, time, components(from), components(to), components(out), count);
+	}
+
+	void EvaluateTracks(EaseTracks const& tracks, float32 time, Vector3_Base<float32> const* from,
+		Vector3_Base<float32> const* to, Vector3_Base<float32>* out, uint64 count) noexcept
+	{
+		evaluate_vector_tracks<3>(tracks, time, components(from), components(to), components(out), count);
+	}
+
+	void EvaluateTracks(EaseTracks const& tracks, float32 time, Vector4_Base<float32> const* from,
+		Vector4_Base<float32> const* to, Vector4_Base<float32>* out, uint64 count) noexcept
+	{
+		evaluate_vector_tracks<4>(tracks, time, components(from), components(to), components(out), count);
+	}
+} // namespace ecm::math
@@ -0,0 +1,263 @@
+#include <ECM/math/ext/integer_ext.h>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// Applies a binary operation to two arrays of 32-bit integer vectors.
+		// With AVX2 two vectors are processed at once, the remaining one is
+		// processed with SSE2.
+		template<typename T, typename Op128, typename Op256>
+		inline void batch_binary(Vector4_Base<T> const* a, Vector4_Base<T> const* b,
+			Vector4_Base<T>* out, uint64 count, Op128 op128, ECM_MAYBEUNUSED Op256 op256)
+		{
+			uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+			for (; i + 2 <= count; i += 2) {
+				const __m256i va{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i)) };
+				const __m256i vb{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i)) };
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), op256(va, vb));
+			}
+#endif // ECM_SIMD_AVX2
+			for (; i < count; ++i) {
+				const __m128i va{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i)) };
+				const __m128i vb{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i)) };
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), op128(va, vb));
+			}
+		}
+
+		// Applies a unary operation to an array of 32-bit integer vectors.
+		template<typename T, typename Op128, typename Op256>
+		inline void batch_unary(Vector4_Base<T> const* in, Vector4_Base<T>* out,
+			uint64 count, Op128 op128, ECM_MAYBEUNUSED Op256 op256)
+		{
+			uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+			for (; i + 2 <= count; i += 2) {
+				const __m256i v{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i)) };
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), op256(v));
+			}
+#endif // ECM_SIMD_AVX2
+			for (; i < count; ++i) {
+				const __m128i v{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), op128(v));
+			}
+		}
+
+#if ECM_SIMD_AVX2
+		inline __m256i add_sat_i32(__m256i a, __m256i b)
+		{
+			const __m256i sum{ _mm256_add_epi32(a, b) };
+			const __m256i overflow{ _mm256_srai_epi32(
+				_mm256_and_si256(_mm256_xor_si256(a, sum), _mm256_xor_si256(b, sum)), 31) };
+			const __m256i limit{ _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7fffffff)) };
+			return _mm256_blendv_epi8(sum, limit, overflow);
+		}
+
+		inline __m256i sub_sat_i32(__m256i a, __m256i b)
+		{
+			const __m256i diff{ _mm256_sub_epi32(a, b) };
+			const __m256i overflow{ _mm256_srai_epi32(
+				_mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, diff)), 31) };
+			const __m256i limit{ _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(0x7fffffff)) };
+			return _mm256_blendv_epi8(diff, limit, overflow);
+		}
+
+		inline __m256i add_sat_u32(__m256i a, __m256i b)
+		{
+			// The sum wrapped around, if it is smaller than an operand.
+			const __m256i sum{ _mm256_add_epi32(a, b) };
+			const __m256i noCarry{ _mm256_cmpeq_epi32(_mm256_max_epu32(sum, a), sum) };
+			return _mm256_or_si256(sum, _mm256_xor_si256(noCarry, _mm256_set1_epi32(-1)));
+		}
+
+		inline __m256i sub_sat_u32(__m256i a, __m256i b)
+		{
+			return _mm256_sub_epi32(a, _mm256_min_epu32(a, b));
+		}
+#endif // ECM_SIMD_AVX2
+
+		template<typename T>
+		inline void mul_matrix_batch(Matrix4x4_Base<T> const* a, Matrix4x4_Base<T> const* b,
+			Matrix4x4_Base<T>* out, uint64 count)
+		{
+			for (uint64 n{ 0 }; n < count; ++n) {
+				__m128i const* ma{ reinterpret_cast<__m128i const*>(a[n].elements) };
+				__m128i const* mb{ reinterpret_cast<__m128i const*>(b[n].elements) };
+				__m128i* mo{ reinterpret_cast<__m128i*>(out[n].elements) };
+
+				const __m128i a0{ _mm_loadu_si128(ma + 0) };
+				const __m128i a1{ _mm_loadu_si128(ma + 1) };
+				const __m128i a2{ _mm_loadu_si128(ma + 2) };
+				const __m128i a3{ _mm_loadu_si128(ma + 3) };
+#if ECM_SIMD_AVX2
+				// Two result columns per iteration: the left matrix columns
+				// are duplicated into both 128-bit lanes.
+				const __m256i a00{ _mm256_broadcastsi128_si256(a0) };
+				const __m256i a11{ _mm256_broadcastsi128_si256(a1) };
+				const __m256i a22{ _mm256_broadcastsi128_si256(a2) };
+				const __m256i a33{ _mm256_broadcastsi128_si256(a3) };
+				for (int32 i{ 0 }; i < 4; i += 2) {
+					const __m256i bc{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(mb + i)) };
+					const __m256i sum0{ _mm256_add_epi32(
+						_mm256_mullo_epi32(a00, _mm256_shuffle_epi32(bc, _MM_SHUFFLE(0, 0, 0, 0))),
+						_mm256_mullo_epi32(a11, _mm256_shuffle_epi32(bc, _MM_SHUFFLE(1, 1, 1, 1)))) };
+					const __m256i sum1{ _mm256_add_epi32(
+						_mm256_mullo_epi32(a22, _mm256_shuffle_epi32(bc, _MM_SHUFFLE(2, 2, 2, 2))),
+						_mm256_mullo_epi32(a33, _mm256_shuffle_epi32(bc, _MM_SHUFFLE(3, 3, 3, 3)))) };
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(mo + i), _mm256_add_epi32(sum0, sum1));
+				}
+#else
+				for (int32 i{ 0 }; i < 4; ++i) {
+					const __m128i bc{ _mm_loadu_si128(mb + i) };
+					const __m128i sum0{ _mm_add_epi32(MulLo(a0, SplatX(bc)), MulLo(a1, SplatY(bc))) };
+					const __m128i sum1{ _mm_add_epi32(MulLo(a2, SplatZ(bc)), MulLo(a3, SplatW(bc))) };
+					_mm_storeu_si128(mo + i, _mm_add_epi32(sum0, sum1));
+				}
+#endif // ECM_SIMD_AVX2
+			}
+		}
+	} // anonymous namespace
+
+	// Batch functions
+
+	void AddBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return _mm_add_epi32(x, y); },
+			[](auto x, auto y) { return _mm256_add_epi32(x, y); });
+	}
+
+	void AddBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return _mm_add_epi32(x, y); },
+			[](auto x, auto y) { return _mm256_add_epi32(x, y); });
+	}
+
+	void SubBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return _mm_sub_epi32(x, y); },
+			[](auto x, auto y) { return _mm256_sub_epi32(x, y); });
+	}
+
+	void SubBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return _mm_sub_epi32(x, y); },
+			[](auto x, auto y) { return _mm256_sub_epi32(x, y); });
+	}
+
+	void MulBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MulLo(x, y); },
+			[](auto x, auto y) { return _mm256_mullo_epi32(x, y); });
+	}
+
+	void MulBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MulLo(x, y); },
+			[](auto x, auto y) { return _mm256_mullo_epi32(x, y); });
+	}
+
+	void MinBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MinI32(x, y); },
+			[](auto x, auto y) { return _mm256_min_epi32(x, y); });
+	}
+
+	void MinBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MinU32(x, y); },
+			[](auto x, auto y) { return _mm256_min_epu32(x, y); });
+	}
+
+	void MaxBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MaxI32(x, y); },
+			[](auto x, auto y) { return _mm256_max_epi32(x, y); });
+	}
+
+	void MaxBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return MaxU32(x, y); },
+			[](auto x, auto y) { return _mm256_max_epu32(x, y); });
+	}
+
+	void AddSatBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return AddSatI32(x, y); },
+			[](auto x, auto y) { return add_sat_i32(x, y); });
+	}
+
+	void AddSatBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return AddSatU32(x, y); },
+			[](auto x, auto y) { return add_sat_u32(x, y); });
+	}
+
+	void SubSatBatch(Vector4i const* a, Vector4i const* b, Vector4i* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return SubSatI32(x, y); },
+			[](auto x, auto y) { return sub_sat_i32(x, y); });
+	}
+
+	void SubSatBatch(Vector4u const* a, Vector4u const* b, Vector4u* out, uint64 count)
+	{
+		batch_binary(a, b, out, count,
+			[](__m128i x, __m128i y) { return SubSatU32(x, y); },
+			[](auto x, auto y) { return sub_sat_u32(x, y); });
+	}
+
+	void ShiftLeftBatch(Vector4i const* in, int32 bits, Vector4i* out, uint64 count)
+	{
+		const __m128i shift{ _mm_cvtsi32_si128(bits) };
+		batch_unary(in, out, count,
+			[shift](__m128i v) { return _mm_sll_epi32(v, shift); },
+			[shift](auto v) { return _mm256_sll_epi32(v, shift); });
+	}
+
+	void ShiftLeftBatch(Vector4u const* in, int32 bits, Vector4u* out, uint64 count)
+	{
+		const __m128i shift{ _mm_cvtsi32_si128(bits) };
+		batch_unary(in, out, count,
+			[shift](__m128i v) { return _mm_sll_epi32(v, shift); },
+			[shift](auto v) { return _mm256_sll_epi32(v, shift); });
+	}
+
+	void ShiftRightBatch(Vector4i const* in, int32 bits, Vector4i* out, uint64 count)
+	{
+		const __m128i shift{ _mm_cvtsi32_si128(bits) };
+		batch_unary(in, out, count,
+			[shift](__m128i v) { return _mm_sra_epi32(v, shift); },
+			[shift](auto v) { return _mm256_sra_epi32(v, shift); });
+	}
+
+	void ShiftRightBatch(Vector4u const* in, int32 bits, Vector4u* out, uint64 count)
+	{
+		const __m128i shift{ _mm_cvtsi32_si128(bits) };
+		batch_unary(in, out, count,
+			[shift](__m128i v) { return _mm_srl_epi32(v, shift); },
+			[shift](auto v) { return _mm256_srl_epi32(v, shift); });
+	}
+
+	void MulBatch(Matrix4x4i const* a, Matrix4x4i const* b, Matrix4x4i* out, uint64 count)
+	{
+		mul_matrix_batch(a, b, out, count);
+	}
+
+	void MulBatch(Matrix4x4u const* a, Matrix4x4u const* b, Matrix4x4u* out, uint64 count)
+	{
+		mul_matrix_batch(a, b, out, count);
+	}
+} // namespace ecm::math
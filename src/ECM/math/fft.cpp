@@ -0,0 +1,494 @@
+#include <ECM/math/fft.h>
+#include <ECM/math/functions.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The size, from which the stages of a transform run on multiple
+		// threads
+		constexpr uint32 ParallelSize{ 1u << 16 };
+		// The number of butterflies of a chunk of a stage
+		constexpr uint64 ButterflyGrain{ 4096 };
+		// The number of elements of a chunk of the bit reversal
+		constexpr uint64 ReverseGrain{ 16384 };
+		// The number of elements of the rows of a chunk of the
+		// two-dimensional transforms
+		constexpr uint64 RowElements{ 8192 };
+		// The size of the square blocks of the transposes, whose 8 KiB stay
+		// in the L1 cache
+		constexpr uint32 TransposeBlock{ 32 };
+
+		inline bool is_power_of_two(uint32 n) noexcept
+		{
+			return n != 0 && (n & (n - 1)) == 0;
+		}
+
+		// The exponent of a power of two
+		inline uint32 log2_of(uint32 n) noexcept
+		{
+			uint32 bits{ 0 };
+			while ((n >>= 1) != 0)
+				++bits;
+			return bits;
+		}
+
+		inline ComplexF polar(float64 angle) noexcept
+		{
+			return { static_cast<float32>(std::cos(angle)), static_cast<float32>(std::sin(angle)) };
+		}
+
+		// The complex numbers of a SIMD register, which the butterflies use
+		// through the same functions as single complex numbers
+		struct scalar_lanes
+		{
+			typedef ComplexF type;
+			static constexpr uint32 count{ 1 };
+			static type load(ComplexF const* p) { return *p; }
+			static void store(ComplexF* p, type a) { *p = a; }
+			static type add(type a, type b) { return { a.real + b.real, a.imag + b.imag }; }
+			static type sub(type a, type b) { return { a.real - b.real, a.imag - b.imag }; }
+			static type mul(type a, type w)
+			{
+				return { a.real * w.real - a.imag * w.imag, a.imag * w.real + a.real * w.imag };
+			}
+			static type mul_conj(type a, type w)
+			{
+				return { a.real * w.real + a.imag * w.imag, a.imag * w.real - a.real * w.imag };
+			}
+			// Multiplies by -i
+			static type rotate(type a) { return { a.imag, -a.real }; }
+			// Multiplies by i
+			static type rotate_inverse(type a) { return { -a.imag, a.real }; }
+		};
+
+#if ECM_SIMD_AVX2
+		struct complex_lanes
+		{
+			typedef __m256 type;
+			static constexpr uint32 count{ 4 };
+			static type load(ComplexF const* p) { return _mm256_loadu_ps(&p->real); }
+			static void store(ComplexF* p, type a) { _mm256_storeu_ps(&p->real, a); }
+			static type add(type a, type b) { return _mm256_add_ps(a, b); }
+			static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+			static type mul(type a, type w)
+			{
+				const __m256 crossed{ _mm256_mul_ps(_mm256_permute_ps(a, 0xB1), _mm256_movehdup_ps(w)) };
+#	if ECM_SIMD_FMA
+				return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(w), crossed);
+#	else
+				return _mm256_addsub_ps(_mm256_mul_ps(a, _mm256_moveldup_ps(w)), crossed);
+#	endif // ECM_SIMD_FMA
+			}
+			static type mul_conj(type a, type w)
+			{
+				const __m256 crossed{ _mm256_mul_ps(_mm256_permute_ps(a, 0xB1), _mm256_movehdup_ps(w)) };
+#	if ECM_SIMD_FMA
+				return _mm256_fmsubadd_ps(a, _mm256_moveldup_ps(w), crossed);
+#	else
+				return _mm256_addsub_ps(_mm256_mul_ps(a, _mm256_moveldup_ps(w)),
+					_mm256_xor_ps(crossed, _mm256_set1_ps(-0.0f)));
+#	endif // ECM_SIMD_FMA
+			}
+			static type rotate(type a)
+			{
+				return _mm256_xor_ps(_mm256_permute_ps(a, 0xB1), _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f,
+					-0.0f, 0.0f, -0.0f));
+			}
+			static type rotate_inverse(type a)
+			{
+				return _mm256_xor_ps(_mm256_permute_ps(a, 0xB1), _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f,
+					0.0f, -0.0f, 0.0f));
+			}
+		};
+#elif ECM_SIMD_SSE2
+		struct complex_lanes
+		{
+			typedef __m128 type;
+			static constexpr uint32 count{ 2 };
+			static type load(ComplexF const* p) { return _mm_loadu_ps(&p->real); }
+			static void store(ComplexF* p, type a) { _mm_storeu_ps(&p->real, a); }
+			static type add(type a, type b) { return _mm_add_ps(a, b); }
+			static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+			// SSE2 has no addsub, so the signs of the crossed products are
+			// flipped with a mask
+			static type mul(type a, type w)
+			{
+				const __m128 crossed{ _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+					_mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1))) };
+				return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0))),
+					_mm_xor_ps(crossed, _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f)));
+			}
+			static type mul_conj(type a, type w)
+			{
+				const __m128 crossed{ _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)),
+					_mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 1, 1))) };
+				return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 0, 0))),
+					_mm_xor_ps(crossed, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f)));
+			}
+			static type rotate(type a)
+			{
+				return _mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(0.0f, -0.0f, 0.0f,
+					-0.0f));
+			}
+			static type rotate_inverse(type a)
+			{
+				return _mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, -0.0f,
+					0.0f));
+			}
+		};
+#else
+		typedef scalar_lanes complex_lanes;
+#endif // ECM_SIMD_AVX2
+
+		// The radix-4 butterflies of the elements [k, k + L::count) of a
+		// block of 4 * m elements. In the order of the bit reversal the
+		// quarters of the block hold the transforms of the elements, whose
+		// indices are 0, 2, 1 and 3 modulo 4.
+		template<bool Inverse, typename L>
+		inline void butterfly(ComplexF* block, uint32 m, uint32 k, ComplexF const* twiddles)
+		{
+			ComplexF* p0{ block + k };
+			ComplexF* p1{ p0 + m };
+			ComplexF* p2{ p1 + m };
+			ComplexF* p3{ p2 + m };
+			typename L::type a0{ L::load(p0) };
+			typename L::type a1, a2, a3;
+			if constexpr (Inverse) {
+				a1 = L::mul_conj(L::load(p2), L::load(twiddles + k));
+				a2 = L::mul_conj(L::load(p1), L::load(twiddles + m + k));
+				a3 = L::mul_conj(L::load(p3), L::load(twiddles + 2 * m + k));
+			} else {
+				a1 = L::mul(L::load(p2), L::load(twiddles + k));
+				a2 = L::mul(L::load(p1), L::load(twiddles + m + k));
+				a3 = L::mul(L::load(p3), L::load(twiddles + 2 * m + k));
+			}
+			const typename L::type t0{ L::add(a0, a2) };
+			const typename L::type t1{ L::sub(a0, a2) };
+			const typename L::type t2{ L::add(a1, a3) };
+			const typename L::type t3{ Inverse ? L::rotate_inverse(L::sub(a1, a3)) : L::rotate(L::sub(a1, a3)) };
+			L::store(p0, L::add(t0, t2));
+			L::store(p1, L::add(t1, t3));
+			L::store(p2, L::sub(t0, t2));
+			L::store(p3, L::sub(t1, t3));
+		}
+
+		// Computes the butterflies [begin, end) of the radix-4 stage, which
+		// combines transforms of size m to transforms of size 4 * m
+		template<bool Inverse>
+		void radix4_stage(ComplexF* data, uint32 m, ComplexF const* twiddles, uint64 begin, uint64 end)
+		{
+			uint64 index{ begin };
+			while (index < end) {
+				ComplexF* block{ data + (index / m) * 4 * m };
+				uint32 k{ static_cast<uint32>(index % m) };
+				const uint32 kEnd{ static_cast<uint32>(std::min<uint64>(m, k + (end - index))) };
+				index += kEnd - k;
+				for (; k + complex_lanes::count <= kEnd; k += complex_lanes::count)
+					butterfly<Inverse, complex_lanes>(block, m, k, twiddles);
+				for (; k < kEnd; ++k)
+					butterfly<Inverse, scalar_lanes>(block, m, k, twiddles);
+			}
+		}
+
+		// The first stage, which combines pairs of elements, if the number
+		// of radix-4 stages doesn't reach the size
+		void radix2_stage(ComplexF* data, uint64 begin, uint64 end) noexcept
+		{
+			for (uint64 i{ begin }; i < end; ++i) {
+				const ComplexF a{ data[2 * i] };
+				const ComplexF b{ data[2 * i + 1] };
+				data[2 * i] = scalar_lanes::add(a, b);
+				data[2 * i + 1] = scalar_lanes::sub(a, b);
+			}
+		}
+
+		// Runs a function on the range [0, count) on multiple threads, if
+		// the transform is large enough
+		template<typename Function>
+		inline void run_chunks(uint32 size, uint64 count, uint64 grain, Function&& function)
+		{
+			if (size >= ParallelSize)
+				ParallelFor(0, count, grain, function);
+			else
+				function(0, count);
+		}
+
+		template<bool Inverse>
+		void execute_stages(ComplexF* data, uint32 size, ComplexF const* twiddles)
+		{
+			uint32 m{ 1 };
+			// An odd number of levels takes one radix-2 stage, which comes
+			// first, since it needs no twiddles. The radix-4 stages, whose m
+			// is below complex_lanes::count, run the scalar butterflies.
+			if ((log2_of(size) & 1) != 0) {
+				run_chunks(size, size / 2, ButterflyGrain, [data](uint64 begin, uint64 end) {
+					radix2_stage(data, begin, end);
+				});
+				m = 2;
+			}
+			for (; m < size; m *= 4) {
+				run_chunks(size, size / 4, ButterflyGrain, [data, m, twiddles](uint64 begin, uint64 end) {
+					radix4_stage<Inverse>(data, m, twiddles, begin, end);
+				});
+				twiddles += 3 * m;
+			}
+		}
+
+		// Transposes a matrix of complex numbers stored row by row in
+		// cache-sized blocks on multiple threads
+		void transpose(ComplexF const* source, uint32 rows, uint32 columns, ComplexF* destination)
+		{
+			const uint64 stripCount{ (rows + TransposeBlock - 1) / TransposeBlock };
+			ParallelFor(0, stripCount, 1, [=](uint64 begin, uint64 end) {
+				for (uint64 strip{ begin }; strip < end; ++strip) {
+					const uint64 row0{ strip * TransposeBlock };
+					const uint64 rowEnd{ std::min<uint64>(rows, row0 + TransposeBlock) };
+					for (uint64 column0{ 0 }; column0 < columns; column0 += TransposeBlock) {
+						const uint64 columnEnd{ std::min<uint64>(columns, column0 + TransposeBlock) };
+						for (uint64 c{ column0 }; c < columnEnd; ++c) {
+							for (uint64 r{ row0 }; r < rowEnd; ++r)
+								destination[c * rows + r] = source[r * columns + c];
+						}
+					}
+				}
+			});
+		}
+
+		// Transforms the rows of a matrix stored row by row in place on
+		// multiple threads
+		void transform_rows(FftPlan const& plan, ComplexF* data, uint32 rows, FftDirection direction)
+		{
+			const uint32 columns{ plan.GetSize() };
+			ParallelFor(0, rows, std::max<uint64>(1, RowElements / columns), [&](uint64 begin, uint64 end) {
+				for (uint64 row{ begin }; row < end; ++row)
+					plan.Execute(data + row * columns, data + row * columns, direction);
+			});
+		}
+	} // anonymous namespace
+
+	bool FftPlan::Create(uint32 size)
+	{
+		_twiddles.clear();
+		_reversed.clear();
+		_size = 0;
+		if (!is_power_of_two(size))
+			return false;
+		_size = size;
+
+		const uint32 bits{ log2_of(size) };
+		_reversed.resize(size);
+		_reversed[0] = 0;
+		for (uint32 i{ 1 }; i < size; ++i)
+			_reversed[i] = (_reversed[i >> 1] >> 1) | ((i & 1) << (bits - 1));
+
+		// Each radix-4 stage uses exp(-2 pi i r k / (4 * m)) for r = 1, 3
+		// and 2, stored in the order, in which the butterflies load them
+		for (uint32 m{ (bits & 1) != 0 ? 2u : 1u }; m < size; m *= 4) {
+			const float64 step{ -DEF_2PI / (4.0 * m) };
+			for (uint32 r : { 1u, 2u, 3u }) {
+				for (uint32 k{ 0 }; k < m; ++k)
+					_twiddles.push_back(polar(step * r * k));
+			}
+		}
+		return true;
+	}
+
+	void FftPlan::Execute(ComplexF const* input, ComplexF* output, FftDirection direction) const noexcept
+	{
+		if (_size == 0)
+			return;
+		uint32 const* reversed{ _reversed.data() };
+		if (input == output) {
+			run_chunks(_size, _size, ReverseGrain, [output, reversed](uint64 begin, uint64 end) {
+				for (uint64 i{ begin }; i < end; ++i) {
+					if (i < reversed[i])
+						std::swap(output[i], output[reversed[i]]);
+				}
+			});
+		} else {
+			run_chunks(_size, _size, ReverseGrain, [input, output, reversed](uint64 begin, uint64 end) {
+				for (uint64 i{ begin }; i < end; ++i)
+					output[i] = input[reversed[i]];
+			});
+		}
+		if (direction == FftDirection::INVERSE)
+			execute_stages<true>(output, _size, _twiddles.data());
+		else
+			execute_stages<false>(output, _size, _twiddles.data());
+	}
+
+	uint32 FftPlan::GetSize() const noexcept
+	{
+		return _size;
+	}
+
+	bool RealFftPlan::Create(uint32 size)
+	{
+		_twiddles.clear();
+		_size = 0;
+		if (size < 2 || !_half.Create(size / 2))
+			return false;
+		_size = size;
+		_twiddles.resize(size / 4 + 1);
+		for (uint32 k{ 0 }; k <= size / 4; ++k)
+			_twiddles[k] = polar(-DEF_2PI * k / size);
+		return true;
+	}
+
+	void RealFftPlan::Forward(float32 const* input, ComplexF* output) const noexcept
+	{
+		if (_size == 0)
+			return;
+		// The even and odd elements are the real and imaginary parts of a
+		// complex signal of half the size
+		if (static_cast<void const*>(input) != static_cast<void const*>(output))
+			std::memcpy(static_cast<void*>(output), input, _size * sizeof(float32));
+		_half.Execute(output, output, FftDirection::FORWARD);
+
+		// Splits the transform Z into the transforms of the even and odd
+		// elements, E = (Z[k] + conj(Z[n - k])) / 2 and
+		// O = (Z[k] - conj(Z[n - k])) / 2i, and combines them to
+		// X[k] = E + w^k O and X[n - k] = conj(E - w^k O)
+		const uint32 n{ _size / 2 };
+		const ComplexF z0{ output[0] };
+		output[0] = { z0.real + z0.imag, 0.0f };
+		output[n] = { z0.real - z0.imag, 0.0f };
+		for (uint32 k{ 1 }; k <= n / 2; ++k) {
+			const ComplexF a{ output[k] };
+			const ComplexF b{ output[n - k].real, -output[n - k].imag };
+			const ComplexF even{ 0.5f * (a.real + b.real), 0.5f * (a.imag + b.imag) };
+			const ComplexF odd{ 0.5f * (a.imag - b.imag), -0.5f * (a.real - b.real) };
+			const ComplexF t{ scalar_lanes::mul(odd, _twiddles[k]) };
+			output[n - k] = { even.real - t.real, t.imag - even.imag };
+			output[k] = scalar_lanes::add(even, t);
+		}
+	}
+
+	void RealFftPlan::Inverse(ComplexF const* input, float32* output) const noexcept
+	{
+		if (_size == 0)
+			return;
+		// Reverses the split of Forward with twice the values, so that the
+		// complex inverse of half the size gives the signal multiplied by
+		// its size. Z[k] = E + i O with E = X[k] + conj(X[n - k]) and
+		// O = (X[k] - conj(X[n - k])) conj(w^k).
+		const uint32 n{ _size / 2 };
+		ComplexF* z{ reinterpret_cast<ComplexF*>(output) };
+		const float32 first{ input[0].real };
+		const float32 last{ input[n].real };
+		for (uint32 k{ 1 }; k <= n / 2; ++k) {
+			const ComplexF a{ input[k] };
+			const ComplexF b{ input[n - k].real, -input[n - k].imag };
+			const ComplexF even{ scalar_lanes::add(a, b) };
+			const ComplexF odd{ scalar_lanes::mul_conj(scalar_lanes::sub(a, b), _twiddles[k]) };
+			z[n - k] = { even.real + odd.imag, odd.real - even.imag };
+			z[k] = { even.real - odd.imag, even.imag + odd.real };
+		}
+		z[0] = { first + last, first - last };
+		_half.Execute(z, z, FftDirection::INVERSE);
+	}
+
+	uint32 RealFftPlan::GetSize() const noexcept
+	{
+		return _size;
+	}
+
+	bool FftPlan2D::Create(uint32 width, uint32 height)
+	{
+		_transposed.clear();
+		if (!_rows.Create(width) || !_columns.Create(height)) {
+			_rows.Create(0);
+			_columns.Create(0);
+			return false;
+		}
+		_transposed.resize(static_cast<uint64>(width) * height);
+		return true;
+	}
+
+	void FftPlan2D::Execute(ComplexF const* input, ComplexF* output, FftDirection direction)
+	{
+		const uint32 width{ _rows.GetSize() };
+		const uint32 height{ _columns.GetSize() };
+		if (width == 0)
+			return;
+		ParallelFor(0, height, std::max<uint64>(1, RowElements / width), [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row)
+				_rows.Execute(input + row * width, output + row * width, direction);
+		});
+		transpose(output, height, width, _transposed.data());
+		transform_rows(_columns, _transposed.data(), width, direction);
+		transpose(_transposed.data(), width, height, output);
+	}
+
+	uint32 FftPlan2D::GetWidth() const noexcept
+	{
+		return _rows.GetSize();
+	}
+
+	uint32 FftPlan2D::GetHeight() const noexcept
+	{
+		return _columns.GetSize();
+	}
+
+	bool RealFftPlan2D::Create(uint32 width, uint32 height)
+	{
+		_transposed.clear();
+		if (!_rows.Create(width) || !_columns.Create(height)) {
+			_rows.Create(0);
+			_columns.Create(0);
+			return false;
+		}
+		_transposed.resize(static_cast<uint64>(width / 2 + 1) * height);
+		return true;
+	}
+
+	void RealFftPlan2D::Forward(float32 const* input, ComplexF* output)
+	{
+		const uint32 width{ _rows.GetSize() };
+		const uint32 height{ _columns.GetSize() };
+		if (width == 0)
+			return;
+		const uint32 bins{ width / 2 + 1 };
+		ParallelFor(0, height, std::max<uint64>(1, RowElements / width), [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row)
+				_rows.Forward(input + row * width, output + row * bins);
+		});
+		transpose(output, height, bins, _transposed.data());
+		transform_rows(_columns, _transposed.data(), bins, FftDirection::FORWARD);
+		transpose(_transposed.data(), bins, height, output);
+	}
+
+	void RealFftPlan2D::Inverse(ComplexF* input, float32* output)
+	{
+		const uint32 width{ _rows.GetSize() };
+		const uint32 height{ _columns.GetSize() };
+		if (width == 0)
+			return;
+		const uint32 bins{ width / 2 + 1 };
+		transpose(input, height, bins, _transposed.data());
+		transform_rows(_columns, _transposed.data(), bins, FftDirection::INVERSE);
+		transpose(_transposed.data(), bins, height, input);
+		ParallelFor(0, height, std::max<uint64>(1, RowElements / width), [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row)
+				_rows.Inverse(input + row * bins, output + row * width);
+		});
+	}
+
+	uint32 RealFftPlan2D::GetWidth() const noexcept
+	{
+		return _rows.GetSize();
+	}
+
+	uint32 RealFftPlan2D::GetHeight() const noexcept
+	{
+		return _columns.GetSize();
+	}
+} // namespace ecm::math
@@ -0,0 +1,123 @@
+#include <ECM/math/fixed.h>
+#include <ECM/math/functions_simd.h>
+
+static_assert(sizeof(ecm::math::Fixed16_16) == 4, "Fixed16_16 must be 32 bits wide.");
+static_assert(sizeof(ecm::math::Fixed32_32) == 8, "Fixed32_32 must be 64 bits wide.");
+
+namespace ecm::math
+{
+	namespace
+	{
+		// Multiplies four Q16.16 numbers like detail::fixed_mul does. Only
+		// the bits 16 to 47 of each 64-bit product are needed, which a
+		// logical shift yields as well as an arithmetic one.
+		inline __m128i mul_q16_4(__m128i a, __m128i b)
+		{
+			const __m128i half{ _mm_set1_epi64x(0x8000) };
+			const __m128i aOdd{ _mm_srli_epi64(a, 32) };
+			const __m128i bOdd{ _mm_srli_epi64(b, 32) };
+#if ECM_SIMD_SSE41
+			const __m128i even{ _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(a, b), half), 16) };
+			const __m128i odd{ _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(aOdd, bOdd), half), 16) };
+			return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xcc);
+#else
+			// The unsigned product differs from the signed one by b * 2^32
+			// for a negative a, and a * 2^32 for a negative b. After the shift
+			// this is a correction of the lower 32 bits by (a or b) * 2^16.
+			const __m128i even{ _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(a, b), half), 16) };
+			const __m128i odd{ _mm_srli_epi64(_mm_add_epi64(_mm_mul_epu32(aOdd, bOdd), half), 16) };
+			const __m128i mask{ _mm_set_epi32(0, -1, 0, -1) };
+			const __m128i product{ _mm_or_si128(_mm_and_si128(even, mask), _mm_slli_epi64(odd, 32)) };
+			const __m128i correction{ _mm_add_epi32(
+				_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a)) };
+			return _mm_sub_epi32(product, _mm_slli_epi32(correction, 16));
+#endif // ECM_SIMD_SSE41
+		}
+
+#if ECM_SIMD_AVX2
+		inline __m256i mul_q16_8(__m256i a, __m256i b)
+		{
+			const __m256i half{ _mm256_set1_epi64x(0x8000) };
+			const __m256i even{ _mm256_srli_epi64(_mm256_add_epi64(_mm256_mul_epi32(a, b), half), 16) };
+			const __m256i odd{ _mm256_srli_epi64(_mm256_add_epi64(
+				_mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)), half), 16) };
+			return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xaa);
+		}
+#endif // ECM_SIMD_AVX2
+	} // anonymous namespace
+
+	void AddBatch(Fixed16_16 const* a, Fixed16_16 const* b, Fixed16_16* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		for (; i + 8 <= count; i += 8) {
+			const __m256i va{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i)) };
+			const __m256i vb{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i)) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(va, vb));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i + 4 <= count; i += 4) {
+			const __m128i va{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i)) };
+			const __m128i vb{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi32(va, vb));
+		}
+		for (; i < count; ++i) {
+			out[i] = Fixed16_16::FromRaw(static_cast<int32>(
+				static_cast<uint32>(a[i].raw) + static_cast<uint32>(b[i].raw)));
+		}
+	}
+
+	void MulBatch(Fixed16_16 const* a, Fixed16_16 const* b, Fixed16_16* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		for (; i + 8 <= count; i += 8) {
+			const __m256i va{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i)) };
+			const __m256i vb{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i)) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), mul_q16_8(va, vb));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i + 4 <= count; i += 4) {
+			const __m128i va{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i)) };
+			const __m128i vb{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), mul_q16_4(va, vb));
+		}
+		for (; i < count; ++i) {
+			const int64 product{ static_cast<int64>(a[i].raw) * b[i].raw };
+			out[i] = Fixed16_16::FromRaw(static_cast<int32>((product + 0x8000) >> 16));
+		}
+	}
+
+	void AddBatch(Fixed32_32 const* a, Fixed32_32 const* b, Fixed32_32* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		for (; i + 4 <= count; i += 4) {
+			const __m256i va{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i)) };
+			const __m256i vb{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i)) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(va, vb));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i + 2 <= count; i += 2) {
+			const __m128i va{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i)) };
+			const __m128i vb{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi64(va, vb));
+		}
+		for (; i < count; ++i) {
+			out[i] = Fixed32_32::FromRaw(static_cast<int64>(
+				static_cast<uint64>(a[i].raw) + static_cast<uint64>(b[i].raw)));
+		}
+	}
+
+	void MulBatch(Fixed32_32 const* a, Fixed32_32 const* b, Fixed32_32* out, uint64 count)
+	{
+		for (uint64 i{ 0 }; i < count; ++i) {
+			// Same as detail::fixed_mul, without the overflow check
+			const bool negative{ (a[i].raw < 0) != (b[i].raw < 0) };
+			const detail::uint128 magnitude{ detail::mul_64x64(detail::uabs(a[i].raw), detail::uabs(b[i].raw)) };
+			const detail::uint128 product{ negative ? detail::make_uint128(0) - magnitude : magnitude };
+			const detail::uint128 rounded{ product + (detail::make_uint128(1) << 31) };
+			out[i] = Fixed32_32::FromRaw(static_cast<int64>(detail::low64(rounded >> 32)));
+		}
+	}
+} // namespace ecm::math
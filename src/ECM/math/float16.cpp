@@ -0,0 +1,112 @@
+#include <ECM/math/float16.h>
+#include <ECM/math/functions_simd.h>
+
+static_assert(sizeof(ecm::float16) == 2, "float16 must be 16 bits wide.");
+
+namespace ecm::math
+{
+	namespace
+	{
+#if !ECM_SIMD_F16C
+		// Converts four single-precision values to half-precision with the
+		// same bit manipulation as Float32ToFloat16Bits. The results are in
+		// the low 16 bits of each 32-bit element.
+		inline __m128i float_to_half4(__m128 f)
+		{
+			const __m128i maskSign{ _mm_set1_epi32(static_cast<int32>(0x80000000u)) };
+			const __m128i f16Max{ _mm_set1_epi32(0x47800000) };
+			const __m128i minNormal{ _mm_set1_epi32(0x38800000) };
+			const __m128i subnormMagic{ _mm_set1_epi32(0x3f000000) };
+			const __m128i normalBias{ _mm_set1_epi32(static_cast<int32>(0xc8000fffu)) };
+
+			const __m128i bits{ _mm_castps_si128(f) };
+			const __m128i justSign{ _mm_and_si128(bits, maskSign) };
+			const __m128i absBits{ _mm_xor_si128(bits, justSign) };
+			const __m128 absF{ _mm_castsi128_ps(absBits) };
+
+			// Infinity or quiet NaN for values out of range
+			const __m128i isNaN{ _mm_castps_si128(_mm_cmpunord_ps(absF, absF)) };
+			const __m128i infOrNaN{ _mm_or_si128(
+				_mm_and_si128(isNaN, _mm_set1_epi32(0x0200)), _mm_set1_epi32(0x7c00)) };
+			const __m128i isRegular{ _mm_cmpgt_epi32(f16Max, absBits) };
+
+			// Subnormal results are rounded by the floating-point addition
+			const __m128i isSubnormal{ _mm_cmpgt_epi32(minNormal, absBits) };
+			const __m128i subnormal{ _mm_sub_epi32(_mm_castps_si128(
+				_mm_add_ps(absF, _mm_castsi128_ps(subnormMagic))), subnormMagic) };
+
+			// Normal results are rebiased and rounded to the nearest even
+			const __m128i mantissaOdd{ _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31) };
+			const __m128i normal{ _mm_srli_epi32(
+				_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd), 13) };
+
+			const __m128i finite{ _mm_or_si128(
+				_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal)) };
+			const __m128i joined{ _mm_or_si128(
+				_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN)) };
+			return _mm_or_si128(joined, _mm_srli_epi32(justSign, 16));
+		}
+
+		// Converts four half-precision numbers, given in the low 16 bits of
+		// each 32-bit element, to single-precision. Subnormal numbers are
+		// renormalized by a multiplication with 2^112.
+		inline __m128 half_to_float4(__m128i h)
+		{
+			const __m128i maskNoSign{ _mm_set1_epi32(0x7fff) };
+			const __m128 magic{ _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)) };
+			const __m128i wasInfNaN{ _mm_set1_epi32(0x7bff) };
+			const __m128i expInfNaN{ _mm_set1_epi32(255 << 23) };
+
+			const __m128i expMantissa{ _mm_and_si128(h, maskNoSign) };
+			const __m128i justSign{ _mm_xor_si128(h, expMantissa) };
+			const __m128 scaled{ _mm_mul_ps(
+				_mm_castsi128_ps(_mm_slli_epi32(expMantissa, 13)), magic) };
+			const __m128i isInfNaN{ _mm_cmpgt_epi32(expMantissa, wasInfNaN) };
+			const __m128i signInf{ _mm_or_si128(
+				_mm_slli_epi32(justSign, 16), _mm_and_si128(isInfNaN, expInfNaN)) };
+			return _mm_or_ps(scaled, _mm_castsi128_ps(signInf));
+		}
+#endif // !ECM_SIMD_F16C
+	} // anonymous namespace
+
+	void ConvertF32ToF16(float32 const* in, float16* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_F16C
+		for (; i + 8 <= count; i += 8) {
+			const __m128i h{ _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+		}
+#else
+		for (; i + 4 <= count; i += 4) {
+			__m128i h{ float_to_half4(_mm_loadu_ps(in + i)) };
+			// Sign extend the 16-bit results, so that packing does not
+			// saturate negative numbers.
+			h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(h, h));
+		}
+#endif // ECM_SIMD_F16C
+		for (; i < count; ++i) {
+			out[i].bits = Float32ToFloat16Bits(in[i]);
+		}
+	}
+
+	void ConvertF16ToF32(float16 const* in, float32* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_F16C
+		for (; i + 8 <= count; i += 8) {
+			const __m128i h{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+			_mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+		}
+#else
+		for (; i + 4 <= count; i += 4) {
+			const __m128i h{ _mm_loadl_epi64(reinterpret_cast<__m128i const*>(in + i)) };
+			_mm_storeu_ps(out + i, half_to_float4(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+		}
+#endif // ECM_SIMD_F16C
+		for (; i < count; ++i) {
+			out[i] = Float16BitsToFloat32(in[i].bits);
+		}
+	}
+} // namespace ecm::math
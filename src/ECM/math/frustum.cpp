@@ -0,0 +1,191 @@
+#include <ECM/math/frustum.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint64 ObjectGrain{ 4096 };
+		constexpr uint64 MaxChunks{ 256 };
+
+		// The plane of a box test, with the corner, which is the farthest
+		// along its normal
+		struct box_plane
+		{
+			float32 normal[3];
+			float32 distance;
+			// 0 for the minimum and 1 for the maximum on each axis
+			uint32 corner[3];
+		};
+
+		template<typename F>
+		inline auto box_visible(box_plane const* planes, F const (&corners)[2][3])
+		{
+			auto visible{ F(planes[0].normal[0]) * corners[planes[0].corner[0]][0]
+				+ F(planes[0].normal[1]) * corners[planes[0].corner[1]][1]
+				+ F(planes[0].normal[2]) * corners[planes[0].corner[2]][2] >= F(-planes[0].distance) };
+			for (uint32 p{ 1 }; p < 6; ++p) {
+				const F d{ F(planes[p].normal[0]) * corners[planes[p].corner[0]][0]
+					+ F(planes[p].normal[1]) * corners[planes[p].corner[1]][1]
+					+ F(planes[p].normal[2]) * corners[planes[p].corner[2]][2] };
+				visible = lane_and(visible, d >= F(-planes[p].distance));
+			}
+			return visible;
+		}
+
+		template<typename F>
+		inline auto sphere_visible(Frustum_Base<float32> const& frustum, F const (&center)[3], F radius)
+		{
+			const F negative{ -radius };
+			auto visible{ F(frustum.planes[0].x) * center[0] + F(frustum.planes[0].y) * center[1]
+				+ F(frustum.planes[0].z) * center[2] + F(frustum.planes[0].w) >= negative };
+			for (uint32 p{ 1 }; p < 6; ++p) {
+				const F d{ F(frustum.planes[p].x) * center[0] + F(frustum.planes[p].y) * center[1]
+					+ F(frustum.planes[p].z) * center[2] + F(frustum.planes[p].w) };
+				visible = lane_and(visible, d >= negative);
+			}
+			return visible;
+		}
+
+#if ECM_SIMD_AVX2
+		// The lanes of each mask of eight objects, packed into 3 bits per
+		// visible lane
+		struct compact_table
+		{
+			uint32 packed[256];
+		};
+
+		constexpr compact_table make_compact_table()
+		{
+			compact_table table{};
+			for (uint32 mask{ 0 }; mask < 256; ++mask) {
+				uint32 count{ 0 };
+				for (uint32 lane{ 0 }; lane < 8; ++lane) {
+					if (mask & (1u << lane))
+						table.packed[mask] |= lane << (3 * count++);
+				}
+			}
+			return table;
+		}
+
+		constexpr compact_table CompactTable{ make_compact_table() };
+
+		// Writes all eight lanes, of which the first ones are the visible
+		// indices. The others are overwritten by the following objects.
+		inline uint32 compact(uint32 mask, uint32 base, uint32* out)
+		{
+			const __m256i shifts{ _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21) };
+			const __m256i lanes{ _mm256_and_si256(_mm256_srlv_epi32(
+				_mm256_set1_epi32(static_cast<int32>(CompactTable.packed[mask])), shifts), _mm256_set1_epi32(7)) };
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+				_mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int32>(base))));
+			return static_cast<uint32>(_mm_popcnt_u32(mask));
+		}
+#else
+		// Writes each index, and only advances past the visible ones
+		inline uint32 compact(uint32 mask, uint32 base, uint32* out)
+		{
+			uint32 count{ 0 };
+			for (uint32 lane{ 0 }; lane < LaneCount; ++lane) {
+				out[count] = base + lane;
+				count += (mask >> lane) & 1u;
+			}
+			return count;
+		}
+#endif // ECM_SIMD_AVX2
+
+		// Tests the objects [begin, end) with a kernel, which takes the
+		// index of the first object and returns the visible lanes, and
+		// writes the indices of the visible objects to out
+		template<typename Kernel>
+		uint64 cull_range(uint64 begin, uint64 end, uint32* out, Kernel const& kernel)
+		{
+			uint64 count{ 0 };
+			uint64 i{ begin };
+			for (; i + LaneCount <= end; i += LaneCount) {
+				const uint32 mask{ lane_bits(kernel(i, vfloat())) };
+				count += compact(mask, static_cast<uint32>(i), out + count);
+			}
+			for (; i < end; ++i) {
+				out[count] = static_cast<uint32>(i);
+				count += lane_bits(kernel(i, float32()));
+			}
+			return count;
+		}
+
+		// Splits the objects into at most MaxChunks chunks, which write
+		// their indices to the part of visible at their first object, and
+		// moves the lists of the chunks together.
+		template<typename Kernel>
+		uint64 cull(uint64 count, uint32* visible, CullStats* stats, Kernel const& kernel)
+		{
+			const uint64 chunk{ std::max(ObjectGrain, (count + MaxChunks - 1) / MaxChunks) };
+			const uint64 chunkCount{ (count + chunk - 1) / chunk };
+			uint64 result{ 0 };
+			if (chunkCount <= 1) {
+				result = cull_range(0, count, visible, kernel);
+			} else {
+				uint64 counts[MaxChunks];
+				ParallelFor(0, chunkCount, 1, [&](uint64 begin, uint64 end) {
+					for (uint64 c{ begin }; c < end; ++c)
+						counts[c] = cull_range(c * chunk, std::min(count, (c + 1) * chunk), visible + c * chunk, kernel);
+				});
+				for (uint64 c{ 0 }; c < chunkCount; ++c) {
+					if (result != c * chunk)
+						std::memmove(visible + result, visible + c * chunk, counts[c] * sizeof(uint32));
+					result += counts[c];
+				}
+			}
+			if (stats) {
+				stats->tested += count;
+				stats->visible += result;
+			}
+			return result;
+		}
+
+		inline vfloat load(float32 const* p, uint64 i, vfloat)
+		{
+			return loadu_ps(p + i);
+		}
+
+		inline float32 load(float32 const* p, uint64 i, float32)
+		{
+			return p[i];
+		}
+	} // anonymous namespace
+
+	uint64 CullAABBs(Frustum_Base<float32> const& frustum, AABBArrays const& boxes, uint64 count, uint32* visible,
+		CullStats* stats) noexcept
+	{
+		box_plane planes[6];
+		for (uint32 p{ 0 }; p < 6; ++p) {
+			Vector4_Base<float32> const& plane{ frustum.planes[p] };
+			planes[p] = { { plane.x, plane.y, plane.z }, plane.w,
+				{ plane.x < 0.f ? 0u : 1u, plane.y < 0.f ? 0u : 1u, plane.z < 0.f ? 0u : 1u } };
+		}
+		return cull(count, visible, stats, [&planes, &boxes](uint64 i, auto lanes) {
+			using F = decltype(lanes);
+			const F corners[2][3]{
+				{ load(boxes.min[0], i, F()), load(boxes.min[1], i, F()), load(boxes.min[2], i, F()) },
+				{ load(boxes.max[0], i, F()), load(boxes.max[1], i, F()), load(boxes.max[2], i, F()) }
+			};
+			return box_visible(planes, corners);
+		});
+	}
+
+	uint64 CullSpheres(Frustum_Base<float32> const& frustum, SphereArrays const& spheres, uint64 count,
+		uint32* visible, CullStats* stats) noexcept
+	{
+		return cull(count, visible, stats, [&frustum, &spheres](uint64 i, auto lanes) {
+			using F = decltype(lanes);
+			const F center[3]{ load(spheres.center[0], i, F()), load(spheres.center[1], i, F()),
+				load(spheres.center[2], i, F()) };
+			return sphere_visible(frustum, center, load(spheres.radius, i, F()));
+		});
+	}
+} // namespace ecm::math
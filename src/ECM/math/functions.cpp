@@ -0,0 +1,240 @@
+#include <ECM/math/functions.h>
+#include <ECM/math/functions_simd.h>
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The tables of the batch functions end with an entry for all inputs
+		// out of range, so that a clamped index can be gathered
+		template<typename T, uint32 N>
+		constexpr detail::lookup_table<T, N + 1> pad_factorials(detail::lookup_table<T, N> const& table) noexcept
+		{
+			detail::lookup_table<T, N + 1> padded{};
+			for (uint32 i{ 0 }; i < N; ++i)
+				padded.values[i] = table.values[i];
+			padded.values[N] = std::numeric_limits<T>::infinity();
+			return padded;
+		}
+
+		template<typename T>
+		constexpr detail::lookup_table<T, detail::binomial_rows * (detail::binomial_rows + 1) / 2 + 1> convert_binomials() noexcept
+		{
+			detail::lookup_table<T, detail::binomial_rows * (detail::binomial_rows + 1) / 2 + 1> converted{};
+			for (uint32 i{ 0 }; i < detail::binomial_rows * (detail::binomial_rows + 1) / 2; ++i)
+				converted.values[i] = static_cast<T>(detail::binomials.values[i]);
+			return converted;
+		}
+
+		constexpr detail::lookup_table<float32, detail::factorial_count_f32 + 1> FactorialsF32{ pad_factorials(detail::factorials_f32) };
+		constexpr detail::lookup_table<float64, detail::factorial_count_f64 + 1> FactorialsF64{ pad_factorials(detail::factorials_f64) };
+		constexpr detail::lookup_table<float32, detail::binomial_rows * (detail::binomial_rows + 1) / 2 + 1> BinomialsF32{ convert_binomials<float32>() };
+		constexpr detail::lookup_table<float64, detail::binomial_rows * (detail::binomial_rows + 1) / 2 + 1> BinomialsF64{ convert_binomials<float64>() };
+		// The index of the zero after the triangle, for k > n
+		constexpr int32 BinomialZero{ static_cast<int32>(detail::binomial_rows * (detail::binomial_rows + 1) / 2) };
+
+		ECM_INLINE __m128d pd_mul(__m128d a, __m128d b)
+		{
+			return _mm_mul_pd(a, b);
+		}
+
+		ECM_INLINE __m128d pd_div(__m128d a, __m128d b)
+		{
+			return _mm_div_pd(a, b);
+		}
+
+		ECM_INLINE __m128d pd_one(__m128d)
+		{
+			return _mm_set1_pd(1.0);
+		}
+
+#if ECM_SIMD_AVX2
+		ECM_INLINE __m256d pd_mul(__m256d a, __m256d b)
+		{
+			return _mm256_mul_pd(a, b);
+		}
+
+		ECM_INLINE __m256d pd_div(__m256d a, __m256d b)
+		{
+			return _mm256_div_pd(a, b);
+		}
+
+		ECM_INLINE __m256d pd_one(__m256d)
+		{
+			return _mm256_set1_pd(1.0);
+		}
+#endif // ECM_SIMD_AVX2
+
+		// The same multiplications as detail::pow_by_squaring, so that the
+		// results equal the ones of Pow
+		template<typename V>
+		ECM_INLINE V pow_vector(V base, uint64 exp, bool negative)
+		{
+			V result{ pd_one(base) };
+			while (exp != 0) {
+				if (exp & 1)
+					result = pd_mul(result, base);
+				exp >>= 1;
+				if (exp != 0)
+					base = pd_mul(base, base);
+			}
+			return negative ? pd_div(pd_one(base), result) : result;
+		}
+
+		ECM_INLINE uint32 binomial_lookup_index(uint32 n, uint32 k)
+		{
+			return k > n ? static_cast<uint32>(BinomialZero) : detail::binomial_index(n, k);
+		}
+
+#if ECM_SIMD_AVX2
+		// The triangle indices of eight lanes, or the one of the zero for k > n
+		ECM_INLINE __m256i binomial_lookup_index(__m256i n, __m256i k)
+		{
+			const __m256i index{ _mm256_add_epi32(_mm256_srli_epi32(
+				_mm256_mullo_epi32(n, _mm256_add_epi32(n, _mm256_set1_epi32(1))), 1), k) };
+			const __m256i valid{ _mm256_cmpeq_epi32(_mm256_max_epu32(n, k), n) };
+			return _mm256_blendv_epi8(_mm256_set1_epi32(BinomialZero), index, valid);
+		}
+
+		// Masked gathers with a defined source, as the unmasked ones leave it
+		// undefined
+		ECM_INLINE __m256 gather(float32 const* table, __m256i index)
+		{
+			return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), table, index, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4);
+		}
+
+		ECM_INLINE __m256d gather(float64 const* table, __m128i index)
+		{
+			return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), table, index, _mm256_castsi256_pd(_mm256_set1_epi32(-1)), 8);
+		}
+
+		ECM_INLINE bool any_above(__m256i n, uint32 limit)
+		{
+			const __m256i above{ _mm256_cmpeq_epi32(_mm256_max_epu32(n, _mm256_set1_epi32(static_cast<int32>(limit + 1))), n) };
+			return _mm256_movemask_epi8(above) != 0;
+		}
+#endif // ECM_SIMD_AVX2
+	} // anonymous namespace
+
+	void PowBatch(float32 const* in, float32* out, uint64 count, int32 exp)
+	{
+		const bool negative{ exp < 0 };
+		const uint64 magnitude{ negative ? 0 - static_cast<uint64>(exp) : static_cast<uint64>(exp) };
+		uint64 i{ 0 };
+		// The bases are raised in float64 like the ones of Pow
+#if ECM_SIMD_AVX2
+		for (; i + 8 <= count; i += 8) {
+			const __m256 x{ _mm256_loadu_ps(in + i) };
+			const __m256d low{ pow_vector(_mm256_cvtps_pd(_mm256_castps256_ps128(x)), magnitude, negative) };
+			const __m256d high{ pow_vector(_mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)), magnitude, negative) };
+			_mm256_storeu_ps(out + i, _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1));
+		}
+#endif // ECM_SIMD_AVX2
+#if ECM_SIMD_SSE2
+		for (; i + 4 <= count; i += 4) {
+			const __m128 x{ _mm_loadu_ps(in + i) };
+			const __m128d low{ pow_vector(_mm_cvtps_pd(x), magnitude, negative) };
+			const __m128d high{ pow_vector(_mm_cvtps_pd(_mm_movehl_ps(x, x)), magnitude, negative) };
+			_mm_storeu_ps(out + i, _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+		}
+#endif // ECM_SIMD_SSE2
+		for (; i < count; ++i)
+			out[i] = Pow(in[i], exp);
+	}
+
+	void PowBatch(float64 const* in, float64* out, uint64 count, int32 exp)
+	{
+		const bool negative{ exp < 0 };
+		const uint64 magnitude{ negative ? 0 - static_cast<uint64>(exp) : static_cast<uint64>(exp) };
+		uint64 i{ 0 };
+		// Large exponents use std::pow like Pow
+		if (magnitude <= detail::pow_squaring_limit_f64) {
+#if ECM_SIMD_AVX2
+			for (; i + 4 <= count; i += 4)
+				_mm256_storeu_pd(out + i, pow_vector(_mm256_loadu_pd(in + i), magnitude, negative));
+#endif // ECM_SIMD_AVX2
+#if ECM_SIMD_SSE2
+			for (; i + 2 <= count; i += 2)
+				_mm_storeu_pd(out + i, pow_vector(_mm_loadu_pd(in + i), magnitude, negative));
+#endif // ECM_SIMD_SSE2
+		}
+		for (; i < count; ++i)
+			out[i] = Pow(in[i], exp);
+	}
+
+	void FactBatch(uint32 const* n, float32* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		const __m256i last{ _mm256_set1_epi32(static_cast<int32>(detail::factorial_count_f32)) };
+		for (; i + 8 <= count; i += 8) {
+			const __m256i index{ _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(n + i)), last) };
+			_mm256_storeu_ps(out + i, gather(FactorialsF32.values, index));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i < count; ++i)
+			out[i] = FactorialsF32.values[std::min(n[i], detail::factorial_count_f32)];
+	}
+
+	void FactBatch(uint32 const* n, float64* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		const __m128i last{ _mm_set1_epi32(static_cast<int32>(detail::factorial_count_f64)) };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i index{ _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(n + i)), last) };
+			_mm256_storeu_pd(out + i, gather(FactorialsF64.values, index));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i < count; ++i)
+			out[i] = FactorialsF64.values[std::min(n[i], detail::factorial_count_f64)];
+	}
+
+	void BinomialBatch(uint32 const* n, uint32 const* k, float32* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		for (; i + 8 <= count; i += 8) {
+			const __m256i rows{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(n + i)) };
+			// Rows beyond the table are calculated one by one
+			if (any_above(rows, detail::binomial_rows - 1)) {
+				for (uint64 j{ i }; j < i + 8; ++j)
+					out[j] = Binomial(static_cast<float32>(n[j]), static_cast<float32>(k[j]));
+				continue;
+			}
+			const __m256i index{ binomial_lookup_index(rows, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(k + i))) };
+			_mm256_storeu_ps(out + i, gather(BinomialsF32.values, index));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i < count; ++i) {
+			out[i] = n[i] < detail::binomial_rows
+				? BinomialsF32.values[binomial_lookup_index(n[i], k[i])]
+				: Binomial(static_cast<float32>(n[i]), static_cast<float32>(k[i]));
+		}
+	}
+
+	void BinomialBatch(uint32 const* n, uint32 const* k, float64* out, uint64 count)
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		for (; i + 8 <= count; i += 8) {
+			const __m256i rows{ _mm256_loadu_si256(reinterpret_cast<__m256i const*>(n + i)) };
+			if (any_above(rows, detail::binomial_rows - 1)) {
+				for (uint64 j{ i }; j < i + 8; ++j)
+					out[j] = Binomial(static_cast<float64>(n[j]), static_cast<float64>(k[j]));
+				continue;
+			}
+			const __m256i index{ binomial_lookup_index(rows, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(k + i))) };
+			_mm256_storeu_pd(out + i, gather(BinomialsF64.values, _mm256_castsi256_si128(index)));
+			_mm256_storeu_pd(out + i + 4, gather(BinomialsF64.values, _mm256_extracti128_si256(index, 1)));
+		}
+#endif // ECM_SIMD_AVX2
+		for (; i < count; ++i) {
+			out[i] = n[i] < detail::binomial_rows
+				? BinomialsF64.values[binomial_lookup_index(n[i], k[i])]
+				: Binomial(static_cast<float64>(n[i]), static_cast<float64>(k[i]));
+		}
+	}
+} // namespace ecm::math
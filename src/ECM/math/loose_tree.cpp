@@ -0,0 +1,460 @@
+#include <ECM/math/loose_tree.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace detail
+	{
+		template<uint32 D>
+		void loose_tree<D>::reset(float32 const* min, float32 const* max, uint32 depth)
+		{
+			nodes.clear();
+			items.clear();
+			freeNode = invalid;
+			freeItem = invalid;
+			count = 0;
+			depthCount = (depth < max_depth ? depth : max_depth) + 1;
+			float32 size{ 0.f };
+			for (uint32 i{ 0 }; i < D; ++i) {
+				origin[i] = min[i];
+				if (max[i] - min[i] > size)
+					size = max[i] - min[i];
+			}
+			if (!(size > 0.f))
+				size = 1.f;
+			for (uint32 d{ 0 }; d < depthCount; ++d)
+				cellSize[d] = std::ldexp(size, -static_cast<int32>(d));
+
+			node root;
+			for (uint32 c{ 0 }; c < child_count; ++c)
+				root.children[c] = invalid;
+			root.parent = invalid;
+			root.first = invalid;
+			for (uint32 i{ 0 }; i < D; ++i)
+				root.cell[i] = 0;
+			root.depth = 0;
+			nodes.push_back(root);
+			nodeCount = 1;
+		}
+
+		template<uint32 D>
+		uint32 loose_tree<D>::insert(float32 const* min, float32 const* max)
+		{
+			uint32 handle{ freeItem };
+			if (handle != invalid) {
+				freeItem = items[handle].next;
+			} else {
+				handle = static_cast<uint32>(items.size());
+				items.emplace_back();
+			}
+			for (uint32 i{ 0 }; i < D; ++i) {
+				items[handle].min[i] = min[i];
+				items[handle].max[i] = max[i];
+			}
+			uint32 depth;
+			uint32 cell[D];
+			place(min, max, depth, cell);
+			link(handle, find_or_create(0, depth, cell));
+			++count;
+			return handle;
+		}
+
+		template<uint32 D>
+		void loose_tree<D>::remove(uint32 handle) noexcept
+		{
+			const uint32 node{ items[handle].node };
+			unlink(handle);
+			prune(node);
+			items[handle].node = invalid;
+			items[handle].next = freeItem;
+			freeItem = handle;
+			--count;
+		}
+
+		template<uint32 D>
+		void loose_tree<D>::move(uint32 handle, float32 const* min, float32 const* max)
+		{
+			for (uint32 i{ 0 }; i < D; ++i) {
+				items[handle].min[i] = min[i];
+				items[handle].max[i] = max[i];
+			}
+			uint32 depth;
+			uint32 cell[D];
+			place(min, max, depth, cell);
+			const uint32 current{ items[handle].node };
+			const auto inCell = [&](uint32 n) {
+				if (nodes[n].depth > depth)
+					return false;
+				for (uint32 i{ 0 }; i < D; ++i) {
+					if ((cell[i] >> (depth - nodes[n].depth)) != nodes[n].cell[i])
+						return false;
+				}
+				return true;
+			};
+			if (nodes[current].depth == depth && inCell(current))
+				return;
+			// The new node is below the lowest ancestor, whose cell contains
+			// the new cell
+			uint32 ancestor{ current };
+			while (!inCell(ancestor))
+				ancestor = nodes[ancestor].parent;
+			unlink(handle);
+			link(handle, find_or_create(ancestor, depth, cell));
+			prune(current);
+		}
+
+		template<uint32 D>
+		template<typename NodeTest, typename ItemTest>
+		uint32 loose_tree<D>::query(NodeTest const& nodeTest, ItemTest const& itemTest, uint32* out,
+			uint32 capacity) const noexcept
+		{
+			if (nodes.empty())
+				return 0;
+			uint32 stack[max_depth * (child_count - 1) + 1];
+			uint32 size{ 0 };
+			stack[size++] = 0;
+			uint32 found{ 0 };
+			while (size > 0) {
+				const uint32 n{ stack[--size] };
+				node const& current{ nodes[n] };
+				// The root holds the items outside of the world, so it is
+				// always visited
+				if (n != 0) {
+					const float32 extent{ cellSize[current.depth] };
+					float32 min[D];
+					float32 max[D];
+					for (uint32 i{ 0 }; i < D; ++i) {
+						min[i] = origin[i] + (static_cast<float32>(current.cell[i]) - 0.5f) * extent;
+						max[i] = min[i] + 2.f * extent;
+					}
+					if (!nodeTest(min, max))
+						continue;
+				}
+				for (uint32 h{ current.first }; h != invalid; h = items[h].next) {
+					if (itemTest(items[h].min, items[h].max)) {
+						if (found < capacity)
+							out[found] = h;
+						++found;
+					}
+				}
+				for (uint32 c{ 0 }; c < child_count; ++c) {
+					if (current.children[c] != invalid)
+						stack[size++] = current.children[c];
+				}
+			}
+			return found;
+		}
+
+		// Finds the deepest cell, whose size is at least the extent of the
+		// box, and which holds the box in its loose bounds. Boxes outside of
+		// the world stay in the root.
+		template<uint32 D>
+		void loose_tree<D>::place(float32 const* min, float32 const* max, uint32& depth, uint32* cell) const noexcept
+		{
+			float32 extent{ 0.f };
+			for (uint32 i{ 0 }; i < D; ++i) {
+				if (!(max[i] - min[i] <= extent))
+					extent = max[i] - min[i];
+			}
+			depth = depthCount - 1;
+			while (depth > 0 && !(cellSize[depth] >= extent))
+				--depth;
+			for (; depth > 0; --depth) {
+				const float32 size{ cellSize[depth] };
+				const float32 last{ static_cast<float32>((1u << depth) - 1) };
+				bool inside{ true };
+				for (uint32 i{ 0 }; i < D; ++i) {
+					float32 c{ std::floor(((min[i] + max[i]) * 0.5f - origin[i]) / size) };
+					c = c > 0.f ? (c < last ? c : last) : 0.f;
+					cell[i] = static_cast<uint32>(c);
+					const float32 low{ origin[i] + (c - 0.5f) * size };
+					inside = inside && min[i] >= low && max[i] <= low + 2.f * size;
+				}
+				if (inside)
+					return;
+			}
+			for (uint32 i{ 0 }; i < D; ++i)
+				cell[i] = 0;
+		}
+
+		template<uint32 D>
+		uint32 loose_tree<D>::find_or_create(uint32 start, uint32 depth, uint32 const* cell)
+		{
+			uint32 n{ start };
+			while (nodes[n].depth < depth) {
+				const uint32 level{ nodes[n].depth + 1 };
+				uint32 child{ 0 };
+				for (uint32 i{ 0 }; i < D; ++i)
+					child |= ((cell[i] >> (depth - level)) & 1u) << i;
+				if (nodes[n].children[child] == invalid) {
+					uint32 created{ freeNode };
+					if (created != invalid) {
+						freeNode = nodes[created].parent;
+					} else {
+						created = static_cast<uint32>(nodes.size());
+						nodes.emplace_back();
+					}
+					node& added{ nodes[created] };
+					for (uint32 c{ 0 }; c < child_count; ++c)
+						added.children[c] = invalid;
+					added.parent = n;
+					added.first = invalid;
+					for (uint32 i{ 0 }; i < D; ++i)
+						added.cell[i] = cell[i] >> (depth - level);
+					added.depth = level;
+					nodes[n].children[child] = created;
+					++nodeCount;
+				}
+				n = nodes[n].children[child];
+			}
+			return n;
+		}
+
+		template<uint32 D>
+		void loose_tree<D>::link(uint32 handle, uint32 node) noexcept
+		{
+			item& linked{ items[handle] };
+			linked.node = node;
+			linked.previous = invalid;
+			linked.next = nodes[node].first;
+			if (linked.next != invalid)
+				items[linked.next].previous = handle;
+			nodes[node].first = handle;
+		}
+
+		template<uint32 D>
+		void loose_tree<D>::unlink(uint32 handle) noexcept
+		{
+			item const& unlinked{ items[handle] };
+			if (unlinked.previous != invalid)
+				items[unlinked.previous].next = unlinked.next;
+			else
+				nodes[unlinked.node].first = unlinked.next;
+			if (unlinked.next != invalid)
+				items[unlinked.next].previous = unlinked.previous;
+		}
+
+		// Frees the empty nodes from a node up to the root
+		template<uint32 D>
+		void loose_tree<D>::prune(uint32 node) noexcept
+		{
+			while (node != 0 && nodes[node].first == invalid) {
+				for (uint32 c{ 0 }; c < child_count; ++c) {
+					if (nodes[node].children[c] != invalid)
+						return;
+				}
+				const uint32 parent{ nodes[node].parent };
+				uint32 child{ 0 };
+				for (uint32 i{ 0 }; i < D; ++i)
+					child |= (nodes[node].cell[i] & 1u) << i;
+				nodes[parent].children[child] = invalid;
+				nodes[node].parent = freeNode;
+				freeNode = node;
+				--nodeCount;
+				node = parent;
+			}
+		}
+
+		template class loose_tree<2>;
+		template class loose_tree<3>;
+	} // namespace detail
+
+	namespace
+	{
+		inline AABB_Base<float32> make_box(float32 const* min, float32 const* max)
+		{
+			return AABB_Base<float32>(Vector3_Base<float32>(min[0], min[1], min[2]),
+				Vector3_Base<float32>(max[0], max[1], max[2]));
+		}
+
+		inline bool overlaps_rect(float32 const* min, float32 const* max, PointF const& rectMin, PointF const& rectMax)
+		{
+			return min[0] <= rectMax.x && max[0] >= rectMin.x && min[1] <= rectMax.y && max[1] >= rectMin.y;
+		}
+
+		inline bool overlaps_circle(float32 const* min, float32 const* max, PointF const& center, float32 radius)
+		{
+			const float32 dx{ center.x < min[0] ? min[0] - center.x : (center.x > max[0] ? center.x - max[0] : 0.f) };
+			const float32 dy{ center.y < min[1] ? min[1] - center.y : (center.y > max[1] ? center.y - max[1] : 0.f) };
+			return dx * dx + dy * dy <= radius * radius;
+		}
+
+		// The slab test of Intersects in two dimensions
+		inline bool hits_rect(float32 const* min, float32 const* max, PointF const& origin, PointF const& inverse,
+			float32 maxDistance)
+		{
+			float32 entry{ 0.f };
+			float32 exit{ maxDistance };
+			for (uint8 i{ 0 }; i < 2; ++i) {
+				const float32 t0{ (min[i] - origin.coord[i]) * inverse.coord[i] };
+				const float32 t1{ (max[i] - origin.coord[i]) * inverse.coord[i] };
+				entry = detail::slab_min(detail::slab_max(t0, entry), detail::slab_max(t1, entry));
+				exit = detail::slab_max(detail::slab_min(t0 * detail::slab_exit_scale<float32>, exit),
+					detail::slab_min(t1 * detail::slab_exit_scale<float32>, exit));
+			}
+			return entry <= exit;
+		}
+	} // anonymous namespace
+
+	// LooseOctree
+
+	LooseOctree::LooseOctree(AABB_Base<float32> const& world, uint32 maxDepth)
+		: _world(world), _maxDepth(maxDepth)
+	{
+		Clear();
+	}
+
+	void LooseOctree::Clear()
+	{
+		const float32 min[3]{ _world.min.x, _world.min.y, _world.min.z };
+		const float32 max[3]{ _world.max.x, _world.max.y, _world.max.z };
+		_tree.reset(min, max, _maxDepth);
+	}
+
+	uint32 LooseOctree::Insert(AABB_Base<float32> const& bounds)
+	{
+		const float32 min[3]{ bounds.min.x, bounds.min.y, bounds.min.z };
+		const float32 max[3]{ bounds.max.x, bounds.max.y, bounds.max.z };
+		return _tree.insert(min, max);
+	}
+
+	void LooseOctree::Remove(uint32 item) noexcept
+	{
+		_tree.remove(item);
+	}
+
+	void LooseOctree::Move(uint32 item, AABB_Base<float32> const& bounds)
+	{
+		const float32 min[3]{ bounds.min.x, bounds.min.y, bounds.min.z };
+		const float32 max[3]{ bounds.max.x, bounds.max.y, bounds.max.z };
+		_tree.move(item, min, max);
+	}
+
+	uint32 LooseOctree::QueryAABB(AABB_Base<float32> const& box, uint32* items, uint32 capacity) const noexcept
+	{
+		const auto test = [&box](float32 const* min, float32 const* max) {
+			return min[0] <= box.max.x && max[0] >= box.min.x && min[1] <= box.max.y && max[1] >= box.min.y
+				&& min[2] <= box.max.z && max[2] >= box.min.z;
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	uint32 LooseOctree::QuerySphere(Sphere_Base<float32> const& sphere, uint32* items, uint32 capacity) const noexcept
+	{
+		const auto test = [&sphere](float32 const* min, float32 const* max) {
+			return Intersects(make_box(min, max), sphere);
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	uint32 LooseOctree::QueryFrustum(Frustum_Base<float32> const& frustum, uint32* items,
+		uint32 capacity) const noexcept
+	{
+		const auto test = [&frustum](float32 const* min, float32 const* max) {
+			return Intersects(frustum, make_box(min, max));
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	uint32 LooseOctree::QueryRay(Ray_Base<float32> const& ray, float32 maxDistance, uint32* items,
+		uint32 capacity) const noexcept
+	{
+		const auto test = [&ray, maxDistance](float32 const* min, float32 const* max) {
+			float32 distance;
+			return Intersects(ray, make_box(min, max), distance) && distance <= maxDistance;
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	AABB_Base<float32> LooseOctree::GetBounds(uint32 item) const noexcept
+	{
+		return make_box(_tree.items[item].min, _tree.items[item].max);
+	}
+
+	uint32 LooseOctree::GetCount() const noexcept
+	{
+		return _tree.count;
+	}
+
+	uint32 LooseOctree::GetNodeCount() const noexcept
+	{
+		return _tree.nodeCount;
+	}
+
+	// LooseQuadtree
+
+	LooseQuadtree::LooseQuadtree(PointF const& min, PointF const& max, uint32 maxDepth)
+		: _min(min), _max(max), _maxDepth(maxDepth)
+	{
+		Clear();
+	}
+
+	void LooseQuadtree::Clear()
+	{
+		_tree.reset(_min.coord, _max.coord, _maxDepth);
+	}
+
+	uint32 LooseQuadtree::Insert(PointF const& min, PointF const& max)
+	{
+		return _tree.insert(min.coord, max.coord);
+	}
+
+	void LooseQuadtree::Remove(uint32 item) noexcept
+	{
+		_tree.remove(item);
+	}
+
+	void LooseQuadtree::Move(uint32 item, PointF const& min, PointF const& max)
+	{
+		_tree.move(item, min.coord, max.coord);
+	}
+
+	uint32 LooseQuadtree::QueryRect(PointF const& min, PointF const& max, uint32* items,
+		uint32 capacity) const noexcept
+	{
+		const auto test = [&min, &max](float32 const* itemMin, float32 const* itemMax) {
+			return overlaps_rect(itemMin, itemMax, min, max);
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	uint32 LooseQuadtree::QueryCircle(PointF const& center, float32 radius, uint32* items,
+		uint32 capacity) const noexcept
+	{
+		const auto test = [&center, radius](float32 const* min, float32 const* max) {
+			return overlaps_circle(min, max, center, radius);
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	uint32 LooseQuadtree::QueryRay(PointF const& origin, PointF const& direction, float32 maxDistance,
+		uint32* items, uint32 capacity) const noexcept
+	{
+		const PointF inverse(1.f / direction.x, 1.f / direction.y);
+		const auto test = [&origin, &inverse, maxDistance](float32 const* min, float32 const* max) {
+			return hits_rect(min, max, origin, inverse, maxDistance);
+		};
+		return _tree.query(test, test, items, capacity);
+	}
+
+	PointF LooseQuadtree::GetMin(uint32 item) const noexcept
+	{
+		return PointF(_tree.items[item].min[0], _tree.items[item].min[1]);
+	}
+
+	PointF LooseQuadtree::GetMax(uint32 item) const noexcept
+	{
+		return PointF(_tree.items[item].max[0], _tree.items[item].max[1]);
+	}
+
+	uint32 LooseQuadtree::GetCount() const noexcept
+	{
+		return _tree.count;
+	}
+
+	uint32 LooseQuadtree::GetNodeCount() const noexcept
+	{
+		return _tree.nodeCount;
+	}
+} // namespace ecm::math
@@ -0,0 +1,148 @@
+#include <ECM/math/matrixn.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The number of lane groups of a chunk of SolveBatch
+		constexpr uint64 GroupGrain{ 256 };
+
+		// Solves N systems at a time, one in each lane, by LU decomposition
+		// with partial pivoting like DecomposeLU. The right-hand sides are
+		// eliminated together with the matrices. Returns the lanes, which
+		// aren't singular.
+		template<uint32 N>
+		vmask solve_lanes(vfloat (&a)[N * N], vfloat (&x)[N])
+		{
+			vfloat scale{ 0.f };
+			for (uint32 i{ 0 }; i < N * N; ++i)
+				scale = lane_max(scale, lane_abs(a[i]));
+			const vfloat tolerance{ scale * vfloat(static_cast<float32>(N) * std::numeric_limits<float32>::epsilon()) };
+			vmask regular{ vfloat(0.f) <= vfloat(0.f) };
+			for (uint32 k{ 0 }; k < N; ++k) {
+				// The pivot of each lane, which is exchanged with row k by
+				// selects
+				vfloat largest{ lane_abs(a[k * N + k]) };
+				vint pivot{ k };
+				for (uint32 i{ k + 1 }; i < N; ++i) {
+					const vfloat value{ lane_abs(a[k * N + i]) };
+					const vmask larger{ value > largest };
+					largest = lane_select(larger, value, largest);
+					pivot = lane_select(larger, vint(i), pivot);
+				}
+				regular = lane_and(regular, largest > tolerance);
+				for (uint32 i{ k + 1 }; i < N; ++i) {
+					const vmask exchange{ pivot == vint(i) };
+					for (uint32 j{ k }; j < N; ++j) {
+						const vfloat top{ a[j * N + k] };
+						a[j * N + k] = lane_select(exchange, a[j * N + i], top);
+						a[j * N + i] = lane_select(exchange, top, a[j * N + i]);
+					}
+					const vfloat top{ x[k] };
+					x[k] = lane_select(exchange, x[i], top);
+					x[i] = lane_select(exchange, top, x[i]);
+				}
+				const vfloat inverse{ vfloat(1.f) / a[k * N + k] };
+				for (uint32 i{ k + 1 }; i < N; ++i) {
+					const vfloat factor{ a[k * N + i] * inverse };
+					for (uint32 j{ k + 1 }; j < N; ++j)
+						a[j * N + i] = a[j * N + i] - factor * a[j * N + k];
+					x[i] = x[i] - factor * x[k];
+				}
+			}
+			for (uint32 k{ N }; k-- > 0;) {
+				x[k] = x[k] / a[k * N + k];
+				for (uint32 i{ 0 }; i < k; ++i)
+					x[i] = x[i] - a[k * N + i] * x[k];
+			}
+			// Singular lanes may hold infinities or NaN
+			for (uint32 i{ 0 }; i < N; ++i)
+				x[i] = lane_select(regular, x[i], vfloat(0.f));
+			return regular;
+		}
+
+		inline uint32 bit_count(uint32 bits)
+		{
+			uint32 result{ 0 };
+			for (; bits; bits &= bits - 1)
+				++result;
+			return result;
+		}
+
+		template<uint32 N>
+		uint64 solve_batch(float32 const* a, float32 const* b, float32* x, uint64 count)
+		{
+			const uint64 groupCount{ (count + LaneCount - 1) / LaneCount };
+			std::atomic<uint64> solved{ 0 };
+			ParallelFor(0, groupCount, GroupGrain, [&](uint64 begin, uint64 end) {
+				uint64 found{ 0 };
+				vfloat matrix[N * N];
+				vfloat vector[N];
+				for (uint64 group{ begin }; group < end; ++group) {
+					const uint64 first{ group * LaneCount };
+					const uint64 n{ std::min<uint64>(count - first, LaneCount) };
+					if (n == LaneCount) {
+						for (uint32 i{ 0 }; i < N * N; ++i)
+							matrix[i] = loadu_ps(a + i * count + first);
+						for (uint32 i{ 0 }; i < N; ++i)
+							vector[i] = loadu_ps(b + i * count + first);
+					} else {
+						// A partial group repeats its last system
+						ECM_ALIGN(32) float32 lanes[LaneCount];
+						for (uint32 i{ 0 }; i < N * N + N; ++i) {
+							float32 const* row{ i < N * N ? a + i * count : b + (i - N * N) * count };
+							for (uint32 lane{ 0 }; lane < LaneCount; ++lane)
+								lanes[lane] = row[first + std::min<uint64>(lane, n - 1)];
+							(i < N * N ? matrix[i] : vector[i - N * N]) = load_ps(lanes);
+						}
+					}
+					const uint32 mask{ (1u << n) - 1u };
+					found += bit_count(lane_bits(solve_lanes<N>(matrix, vector)) & mask);
+					if (n == LaneCount) {
+						for (uint32 i{ 0 }; i < N; ++i)
+							storeu_ps(x + i * count + first, vector[i].v);
+					} else {
+						ECM_ALIGN(32) float32 lanes[LaneCount];
+						for (uint32 i{ 0 }; i < N; ++i) {
+							store_ps(lanes, vector[i].v);
+							std::copy(lanes, lanes + n, x + i * count + first);
+						}
+					}
+				}
+				solved.fetch_add(found, std::memory_order_relaxed);
+			});
+			return solved.load(std::memory_order_relaxed);
+		}
+	} // anonymous namespace
+
+	uint64 SolveBatch(uint32 n, float32 const* a, float32 const* b, float32* x, uint64 count)
+	{
+		switch (n) {
+		case 1:
+			return solve_batch<1>(a, b, x, count);
+		case 2:
+			return solve_batch<2>(a, b, x, count);
+		case 3:
+			return solve_batch<3>(a, b, x, count);
+		case 4:
+			return solve_batch<4>(a, b, x, count);
+		case 5:
+			return solve_batch<5>(a, b, x, count);
+		case 6:
+			return solve_batch<6>(a, b, x, count);
+		case 7:
+			return solve_batch<7>(a, b, x, count);
+		case 8:
+			return solve_batch<8>(a, b, x, count);
+		default:
+			return 0;
+		}
+	}
+} // namespace ecm::math
@@ -0,0 +1,301 @@
+#include <ECM/math/morton.h>
+#include "simd_lanes.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The Hilbert indices follow Skilling, "Programming the Hilbert
+		// curve". The coordinates are transformed in place into the
+		// transposed index, whose interleaved bits are the index, with the
+		// bits of the first coordinate the highest of each group.
+
+		// Transforms the coordinates of a cell into the transposed index.
+		// The kernel takes lanes of cells, so that the batch functions and
+		// the scalar functions give the same indices.
+		template<uint32 D, typename I>
+		void hilbert_transpose(I* x, uint32 bits)
+		{
+			const uint32 top{ 1u << (bits - 1) };
+			for (uint32 q{ top }; q > 1; q >>= 1) {
+				const uint32 p{ q - 1 };
+				for (uint32 i{ 0 }; i < D; ++i) {
+					// Inverts the low bits of the first coordinate, or
+					// exchanges them with the ones of coordinate i
+					const auto set = lane_test(x[i], q);
+					const I t{ lane_select(set, I(0u), (x[0] ^ x[i]) & I(p)) };
+					x[0] = x[0] ^ lane_select(set, I(p), t);
+					x[i] = x[i] ^ t;
+				}
+			}
+			// Gray encoding
+			for (uint32 i{ 1 }; i < D; ++i)
+				x[i] = x[i] ^ x[i - 1];
+			I t{ 0u };
+			for (uint32 q{ top }; q > 1; q >>= 1)
+				t = t ^ lane_select(lane_test(x[D - 1], q), I(q - 1), I(0u));
+			for (uint32 i{ 0 }; i < D; ++i)
+				x[i] = x[i] ^ t;
+		}
+
+		// Transforms the transposed index back into the coordinates of the
+		// cell.
+		template<uint32 D>
+		void hilbert_axes(uint32* x, uint32 bits)
+		{
+			// Gray decoding
+			const uint32 t{ x[D - 1] >> 1 };
+			for (uint32 i{ D - 1 }; i > 0; --i)
+				x[i] ^= x[i - 1];
+			x[0] ^= t;
+			const uint64 end{ 1ull << bits };
+			for (uint64 q{ 2 }; q < end; q <<= 1) {
+				const uint32 p{ static_cast<uint32>(q - 1) };
+				for (uint32 i{ D }; i-- > 0;) {
+					if (x[i] & q) {
+						x[0] ^= p;
+					} else {
+						const uint32 s{ (x[0] ^ x[i]) & p };
+						x[0] ^= s;
+						x[i] ^= s;
+					}
+				}
+			}
+		}
+
+		// Quantizes a coordinate into the cells of an axis of the box. NaN
+		// gives the first cell.
+		template<typename F, typename I>
+		inline I quantize(F v, float32 min, float32 scale, float32 maxCell)
+		{
+			return lane_to_int(lane_min(lane_max((v - F(min)) * F(scale), F(0.f)), F(maxCell)));
+		}
+
+		struct grid_axes
+		{
+			float32 min[3];
+			float32 scale[3];
+			float32 maxCell;
+		};
+
+		inline grid_axes make_grid(AABB_Base<float32> const& bounds, uint32 bits)
+		{
+			const float32 cells{ static_cast<float32>(1u << bits) };
+			grid_axes grid;
+			for (uint8 d{ 0 }; d < 3; ++d) {
+				const float32 extent{ bounds.max[d] - bounds.min[d] };
+				grid.min[d] = bounds.min[d];
+				// Flat and invalid boxes put all positions into the first
+				// cell of the axis
+				grid.scale[d] = extent > 0.f && extent < std::numeric_limits<float32>::infinity() ? cells / extent : 0.f;
+			}
+			grid.maxCell = cells - 1.f;
+			return grid;
+		}
+
+		// Runs a kernel on the quantized cells of LaneCount positions at a
+		// time. Full batches are loaded and transposed in registers, a
+		// partial batch repeats its last position.
+		template<typename Kernel>
+		void quantize_batch(grid_axes const& grid, Vector3_Base<float32> const* in, uint64 count,
+			Kernel const& kernel)
+		{
+			const auto run = [&](vfloat const* coords, uint64 i, uint64 n) {
+				vint cell[3];
+				for (uint32 d{ 0 }; d < 3; ++d)
+					cell[d] = quantize<vfloat, vint>(coords[d], grid.min[d], grid.scale[d], grid.maxCell);
+				kernel(cell, i, n);
+			};
+			uint64 i{ 0 };
+			for (; i + LaneCount <= count; i += LaneCount) {
+				vfloat coords[3];
+				lane_load3(reinterpret_cast<float32 const*>(in + i), coords[0], coords[1], coords[2]);
+				run(coords, i, LaneCount);
+			}
+			if (i < count) {
+				ECM_ALIGN(32) float32 coords[3][LaneCount];
+				const uint64 n{ count - i };
+				for (uint32 lane{ 0 }; lane < LaneCount; ++lane) {
+					Vector3_Base<float32> const& v{ in[i + std::min<uint64>(lane, n - 1)] };
+					coords[0][lane] = v.x;
+					coords[1][lane] = v.y;
+					coords[2][lane] = v.z;
+				}
+				const vfloat lanes[3]{ load_ps(coords[0]), load_ps(coords[1]), load_ps(coords[2]) };
+				run(lanes, i, n);
+			}
+		}
+
+		// Interleaves the bits of the cells of a batch into 32-bit codes and
+		// stores the first n of them.
+		inline void store_codes32(vint const* cell, uint32* out, uint64 n)
+		{
+			const vint code{ detail::spread_bits3(cell[0]) | (detail::spread_bits3(cell[1]) << 1)
+				| (detail::spread_bits3(cell[2]) << 2) };
+			if (n == LaneCount) {
+				storeu_ps(reinterpret_cast<float32*>(out), lane_as_float(code).v);
+			} else {
+				ECM_ALIGN(32) uint32 codes[LaneCount];
+				store_ps(reinterpret_cast<float32*>(codes), lane_as_float(code).v);
+				std::copy(codes, codes + n, out);
+			}
+		}
+
+#if ECM_SIMD_AVX2
+		inline native_int set1_epi64(uint64 u) { return _mm256_set1_epi64x(static_cast<int64>(u)); }
+		inline native_int slli_epi64(native_int a, int32 n) { return _mm256_slli_epi64(a, n); }
+		inline native_int cvtlo_epu32_epi64(native_int a) { return _mm256_cvtepu32_epi64(_mm256_castsi256_si128(a)); }
+		inline native_int cvthi_epu32_epi64(native_int a) { return _mm256_cvtepu32_epi64(_mm256_extracti128_si256(a, 1)); }
+		inline void storeu_epi64(uint64* p, native_int a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+#else
+		inline native_int set1_epi64(uint64 u) { return _mm_set1_epi64x(static_cast<int64>(u)); }
+		inline native_int slli_epi64(native_int a, int32 n) { return _mm_slli_epi64(a, n); }
+		inline native_int cvtlo_epu32_epi64(native_int a) { return _mm_unpacklo_epi32(a, _mm_setzero_si128()); }
+		inline native_int cvthi_epu32_epi64(native_int a) { return _mm_unpackhi_epi32(a, _mm_setzero_si128()); }
+		inline void storeu_epi64(uint64* p, native_int a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+#endif // ECM_SIMD_AVX2
+
+		// Half a batch of 64-bit integer lanes, in which the bits of the cells
+		// are spread into 64-bit codes.
+		struct vlong
+		{
+			native_int v;
+
+			vlong() = default;
+			vlong(native_int v) : v(v) {}
+			template<typename T, std::enable_if_t<std::is_same_v<T, uint64>, int> = 0>
+			vlong(T u) : v(set1_epi64(u)) {}
+		};
+
+		inline vlong operator&(vlong a, vlong b) { return and_epi32(a.v, b.v); }
+		inline vlong operator|(vlong a, vlong b) { return or_epi32(a.v, b.v); }
+		inline vlong operator<<(vlong a, int32 n) { return slli_epi64(a.v, n); }
+
+		// Interleaves the bits of the cells of a batch into 64-bit codes and
+		// stores the first n of them.
+		inline void store_codes64(vint const* cell, uint64* out, uint64 n)
+		{
+			vlong low{ 0ull };
+			vlong high{ 0ull };
+			for (uint32 d{ 0 }; d < 3; ++d) {
+				low = low | (detail::spread_bits3_64(vlong(cvtlo_epu32_epi64(cell[d].v))) << d);
+				high = high | (detail::spread_bits3_64(vlong(cvthi_epu32_epi64(cell[d].v))) << d);
+			}
+			constexpr uint32 half{ LaneCount / 2 };
+			if (n == LaneCount) {
+				storeu_epi64(out, low.v);
+				storeu_epi64(out + half, high.v);
+			} else {
+				uint64 codes[LaneCount];
+				storeu_epi64(codes, low.v);
+				storeu_epi64(codes + half, high.v);
+				std::copy(codes, codes + n, out);
+			}
+		}
+	} // anonymous namespace
+
+	// Hilbert indices
+
+	uint32 EncodeHilbert2D32(Vector2_Base<uint32> const& cell) noexcept
+	{
+		uint32 x[2]{ cell.x & 0xffffu, cell.y & 0xffffu };
+		hilbert_transpose<2>(x, 16);
+		return EncodeMorton2D32(Vector2_Base<uint32>(x[1], x[0]));
+	}
+
+	Vector2_Base<uint32> DecodeHilbert2D32(uint32 index) noexcept
+	{
+		const Vector2_Base<uint32> transposed{ DecodeMorton2D32(index) };
+		uint32 x[2]{ transposed.y, transposed.x };
+		hilbert_axes<2>(x, 16);
+		return Vector2_Base<uint32>(x[0], x[1]);
+	}
+
+	uint64 EncodeHilbert2D64(Vector2_Base<uint32> const& cell) noexcept
+	{
+		uint32 x[2]{ cell.x, cell.y };
+		hilbert_transpose<2>(x, 32);
+		return EncodeMorton2D64(Vector2_Base<uint32>(x[1], x[0]));
+	}
+
+	Vector2_Base<uint32> DecodeHilbert2D64(uint64 index) noexcept
+	{
+		const Vector2_Base<uint32> transposed{ DecodeMorton2D64(index) };
+		uint32 x[2]{ transposed.y, transposed.x };
+		hilbert_axes<2>(x, 32);
+		return Vector2_Base<uint32>(x[0], x[1]);
+	}
+
+	uint32 EncodeHilbert3D32(Vector3_Base<uint32> const& cell) noexcept
+	{
+		uint32 x[3]{ cell.x & 0x3ffu, cell.y & 0x3ffu, cell.z & 0x3ffu };
+		hilbert_transpose<3>(x, 10);
+		return EncodeMorton3D32(Vector3_Base<uint32>(x[2], x[1], x[0]));
+	}
+
+	Vector3_Base<uint32> DecodeHilbert3D32(uint32 index) noexcept
+	{
+		const Vector3_Base<uint32> transposed{ DecodeMorton3D32(index) };
+		uint32 x[3]{ transposed.z, transposed.y, transposed.x };
+		hilbert_axes<3>(x, 10);
+		return Vector3_Base<uint32>(x[0], x[1], x[2]);
+	}
+
+	uint64 EncodeHilbert3D64(Vector3_Base<uint32> const& cell) noexcept
+	{
+		uint32 x[3]{ cell.x & 0x1fffffu, cell.y & 0x1fffffu, cell.z & 0x1fffffu };
+		hilbert_transpose<3>(x, 21);
+		return EncodeMorton3D64(Vector3_Base<uint32>(x[2], x[1], x[0]));
+	}
+
+	Vector3_Base<uint32> DecodeHilbert3D64(uint64 index) noexcept
+	{
+		const Vector3_Base<uint32> transposed{ DecodeMorton3D64(index) };
+		uint32 x[3]{ transposed.z, transposed.y, transposed.x };
+		hilbert_axes<3>(x, 21);
+		return Vector3_Base<uint32>(x[0], x[1], x[2]);
+	}
+
+	// Batch functions
+
+	void EncodeMorton3D32Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in, uint32* out,
+		uint64 count)
+	{
+		quantize_batch(make_grid(bounds, 10), in, count, [&](vint const* cell, uint64 i, uint64 n) {
+			store_codes32(cell, out + i, n);
+		});
+	}
+
+	void EncodeMorton3D64Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in, uint64* out,
+		uint64 count)
+	{
+		quantize_batch(make_grid(bounds, 21), in, count, [&](vint const* cell, uint64 i, uint64 n) {
+			store_codes64(cell, out + i, n);
+		});
+	}
+
+	void EncodeHilbert3D32Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in, uint32* out,
+		uint64 count)
+	{
+		quantize_batch(make_grid(bounds, 10), in, count, [&](vint const* cell, uint64 i, uint64 n) {
+			vint x[3]{ cell[0], cell[1], cell[2] };
+			hilbert_transpose<3>(x, 10);
+			const vint transposed[3]{ x[2], x[1], x[0] };
+			store_codes32(transposed, out + i, n);
+		});
+	}
+
+	void EncodeHilbert3D64Batch(AABB_Base<float32> const& bounds, Vector3_Base<float32> const* in, uint64* out,
+		uint64 count)
+	{
+		quantize_batch(make_grid(bounds, 21), in, count, [&](vint const* cell, uint64 i, uint64 n) {
+			vint x[3]{ cell[0], cell[1], cell[2] };
+			hilbert_transpose<3>(x, 21);
+			const vint transposed[3]{ x[2], x[1], x[0] };
+			store_codes64(transposed, out + i, n);
+		});
+	}
+} // namespace ecm::math
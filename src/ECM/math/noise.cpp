@@ -0,0 +1,693 @@
+#include <ECM/math/noise.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// Hashing of lattice points, whose coordinates are premultiplied
+		// with the primes.
+
+		constexpr uint32 PrimeX{ 501125321u };
+		constexpr uint32 PrimeY{ 1136930381u };
+		constexpr uint32 PrimeZ{ 1720413743u };
+		constexpr uint32 PrimeW{ 1066037191u };
+
+		template<typename I>
+		inline I hash(I seed, I x, I y)
+		{
+			I h{ (seed ^ x ^ y) * I(0x27d4eb2du) };
+			return h ^ (h >> 15);
+		}
+
+		template<typename I>
+		inline I hash(I seed, I x, I y, I z)
+		{
+			I h{ (seed ^ x ^ y ^ z) * I(0x27d4eb2du) };
+			return h ^ (h >> 15);
+		}
+
+		template<typename I>
+		inline I hash(I seed, I x, I y, I z, I w)
+		{
+			I h{ (seed ^ x ^ y ^ z ^ w) * I(0x27d4eb2du) };
+			return h ^ (h >> 15);
+		}
+
+		// Gradients, which are selected by the low hash bits
+
+		// The eight directions (+-1, +-0.5) and (+-0.5, +-1)
+		template<typename F, typename I>
+		inline F grad(I h, F x, F y)
+		{
+			const auto swap{ lane_test(h, 4) };
+			const F u{ lane_select(swap, y, x) };
+			const F v{ lane_select(swap, x, y) };
+			return lane_select(lane_test(h, 1), -u, u) + lane_select(lane_test(h, 2), -v, v) * F(0.5f);
+		}
+
+		// The twelve edge midpoints of the cube, with four of them twice
+		template<typename F, typename I>
+		inline F grad(I h, F x, F y, F z)
+		{
+			const auto low{ lane_not(lane_or(lane_test(h, 8), lane_test(h, 4))) };
+			const F u{ lane_select(lane_test(h, 8), y, x) };
+			const F v{ lane_select(low, y, lane_select((h & I(13u)) == I(12u), x, z)) };
+			return lane_select(lane_test(h, 1), -u, u) + lane_select(lane_test(h, 2), -v, v);
+		}
+
+		// The 32 edge midpoints of the tesseract
+		template<typename F, typename I>
+		inline F grad(I h, F x, F y, F z, F w)
+		{
+			const auto b8{ lane_test(h, 8) };
+			const auto b16{ lane_test(h, 16) };
+			const F u{ lane_select(lane_and(b16, b8), y, x) };
+			const F v{ lane_select(b16, z, y) };
+			const F t{ lane_select(lane_or(b16, b8), w, z) };
+			return lane_select(lane_test(h, 1), -u, u) + lane_select(lane_test(h, 2), -v, v)
+				+ lane_select(lane_test(h, 4), -t, t);
+		}
+
+		template<typename F>
+		inline F fade(F t)
+		{
+			return t * t * t * (t * (t * F(6.f) - F(15.f)) + F(10.f));
+		}
+
+		template<typename F>
+		inline F lerp(F a, F b, F t)
+		{
+			return a + t * (b - a);
+		}
+
+		template<typename F>
+		inline F pow4(F a)
+		{
+			const F a2{ a * a };
+			return a2 * a2;
+		}
+
+		// Perlin noise. The factors scale the largest values, which a local
+		// search found, to 1. The result is clamped, in case the search missed
+		// a larger one.
+
+		template<typename F, typename I>
+		F perlin(I seed, F x, F y)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const I x0{ lane_to_int(fx) * I(PrimeX) };
+			const I y0{ lane_to_int(fy) * I(PrimeY) };
+			const I x1{ x0 + I(PrimeX) };
+			const I y1{ y0 + I(PrimeY) };
+			const F dx0{ x - fx };
+			const F dy0{ y - fy };
+			const F dx1{ dx0 - F(1.f) };
+			const F dy1{ dy0 - F(1.f) };
+			const F u{ fade(dx0) };
+			const F v{ fade(dy0) };
+			const F a{ lerp(grad(hash(seed, x0, y0), dx0, dy0), grad(hash(seed, x1, y0), dx1, dy0), u) };
+			const F b{ lerp(grad(hash(seed, x0, y1), dx0, dy1), grad(hash(seed, x1, y1), dx1, dy1), u) };
+			return lane_clamp(lerp(a, b, v) * F(1.3234f));
+		}
+
+		template<typename F, typename I>
+		F perlin(I seed, F x, F y, F z)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const F fz{ lane_floor(z) };
+			const I x0{ lane_to_int(fx) * I(PrimeX) };
+			const I y0{ lane_to_int(fy) * I(PrimeY) };
+			const I z0{ lane_to_int(fz) * I(PrimeZ) };
+			const I x1{ x0 + I(PrimeX) };
+			const I y1{ y0 + I(PrimeY) };
+			const I z1{ z0 + I(PrimeZ) };
+			const F dx0{ x - fx };
+			const F dy0{ y - fy };
+			const F dz0{ z - fz };
+			const F dx1{ dx0 - F(1.f) };
+			const F dy1{ dy0 - F(1.f) };
+			const F dz1{ dz0 - F(1.f) };
+			const F u{ fade(dx0) };
+			const F v{ fade(dy0) };
+			const F w{ fade(dz0) };
+			const F a{ lerp(
+				lerp(grad(hash(seed, x0, y0, z0), dx0, dy0, dz0), grad(hash(seed, x1, y0, z0), dx1, dy0, dz0), u),
+				lerp(grad(hash(seed, x0, y1, z0), dx0, dy1, dz0), grad(hash(seed, x1, y1, z0), dx1, dy1, dz0), u), v) };
+			const F b{ lerp(
+				lerp(grad(hash(seed, x0, y0, z1), dx0, dy0, dz1), grad(hash(seed, x1, y0, z1), dx1, dy0, dz1), u),
+				lerp(grad(hash(seed, x0, y1, z1), dx0, dy1, dz1), grad(hash(seed, x1, y1, z1), dx1, dy1, dz1), u), v) };
+			return lane_clamp(lerp(a, b, w) * F(0.98f));
+		}
+
+		template<typename F, typename I>
+		F perlin(I seed, F x, F y, F z, F w)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const F fz{ lane_floor(z) };
+			const F fw{ lane_floor(w) };
+			const I x0{ lane_to_int(fx) * I(PrimeX) };
+			const I y0{ lane_to_int(fy) * I(PrimeY) };
+			const I z0{ lane_to_int(fz) * I(PrimeZ) };
+			const I w0{ lane_to_int(fw) * I(PrimeW) };
+			const I x1{ x0 + I(PrimeX) };
+			const I y1{ y0 + I(PrimeY) };
+			const I z1{ z0 + I(PrimeZ) };
+			const I w1{ w0 + I(PrimeW) };
+			const F dx0{ x - fx };
+			const F dy0{ y - fy };
+			const F dz0{ z - fz };
+			const F dw0{ w - fw };
+			const F dx1{ dx0 - F(1.f) };
+			const F dy1{ dy0 - F(1.f) };
+			const F dz1{ dz0 - F(1.f) };
+			const F dw1{ dw0 - F(1.f) };
+			const F u{ fade(dx0) };
+			const F v{ fade(dy0) };
+			const F t{ fade(dz0) };
+			const F s{ fade(dw0) };
+			// Trilinear interpolation of one w layer
+			const auto layer{ [&](I wi, F dw) {
+				const F a{ lerp(
+					lerp(grad(hash(seed, x0, y0, z0, wi), dx0, dy0, dz0, dw), grad(hash(seed, x1, y0, z0, wi), dx1, dy0, dz0, dw), u),
+					lerp(grad(hash(seed, x0, y1, z0, wi), dx0, dy1, dz0, dw), grad(hash(seed, x1, y1, z0, wi), dx1, dy1, dz0, dw), u), v) };
+				const F b{ lerp(
+					lerp(grad(hash(seed, x0, y0, z1, wi), dx0, dy0, dz1, dw), grad(hash(seed, x1, y0, z1, wi), dx1, dy0, dz1, dw), u),
+					lerp(grad(hash(seed, x0, y1, z1, wi), dx0, dy1, dz1, dw), grad(hash(seed, x1, y1, z1, wi), dx1, dy1, dz1, dw), u), v) };
+				return lerp(a, b, t);
+			} };
+			return lane_clamp(lerp(layer(w0, dw0), layer(w1, dw1), s) * F(0.8f));
+		}
+
+		// OpenSimplex2 noise, scaled and clamped like Perlin noise
+
+		template<typename F, typename I>
+		F open_simplex2(I seed, F x, F y)
+		{
+			constexpr float32 F2{ 0.36602540378443864676f };
+			constexpr float32 G2{ 0.21132486540518711775f };
+			const auto contribution{ [&](I hx, I hy, F dx, F dy) {
+				const F a{ F(0.5f) - dx * dx - dy * dy };
+				return lane_select(a > F(0.f), pow4(a) * grad(hash(seed, hx, hy), dx, dy), F(0.f));
+			} };
+			// Skew onto the grid of the triangles
+			const F s{ (x + y) * F(F2) };
+			const F fx{ lane_floor(x + s) };
+			const F fy{ lane_floor(y + s) };
+			const F xi{ x + s - fx };
+			const F yi{ y + s - fy };
+			const F t{ (xi + yi) * F(G2) };
+			const F x0{ xi - t };
+			const F y0{ yi - t };
+			const I i{ lane_to_int(fx) * I(PrimeX) };
+			const I j{ lane_to_int(fy) * I(PrimeY) };
+			// The middle vertex depends on the triangle of the square
+			const auto upper{ y0 > x0 };
+			const F x1{ x0 + lane_select(upper, F(G2), F(G2 - 1.f)) };
+			const F y1{ y0 + lane_select(upper, F(G2 - 1.f), F(G2)) };
+			const I i1{ i + lane_select(upper, I(0u), I(PrimeX)) };
+			const I j1{ j + lane_select(upper, I(PrimeY), I(0u)) };
+			const F n{ contribution(i, j, x0, y0)
+				+ contribution(i1, j1, x1, y1)
+				+ contribution(i + I(PrimeX), j + I(PrimeY), x0 + F(2.f * G2 - 1.f), y0 + F(2.f * G2 - 1.f)) };
+			return lane_clamp(n * F(90.46f));
+		}
+
+		template<typename F, typename I>
+		F open_simplex2(I seed, F x, F y, F z)
+		{
+			// Rotate, so that the lattice shows no axis-aligned artifacts
+			const F r{ (x + y + z) * F(2.f / 3.f) };
+			x = r - x;
+			y = r - y;
+			z = r - z;
+			// The nearest vertex of the first of the two cubic lattices of
+			// the body-centered cubic lattice
+			I i{ lane_round(x) };
+			I j{ lane_round(y) };
+			I k{ lane_round(z) };
+			F x0{ x - lane_to_float(i) };
+			F y0{ y - lane_to_float(j) };
+			F z0{ z - lane_to_float(k) };
+			auto xNeg{ x0 < F(0.f) };
+			auto yNeg{ y0 < F(0.f) };
+			auto zNeg{ z0 < F(0.f) };
+			F ax0{ lane_abs(x0) };
+			F ay0{ lane_abs(y0) };
+			F az0{ lane_abs(z0) };
+			i = i * I(PrimeX);
+			j = j * I(PrimeY);
+			k = k * I(PrimeZ);
+			F value{ 0.f };
+			F a{ (F(0.6f) - x0 * x0) - (y0 * y0 + z0 * z0) };
+			for (uint32 lattice{ 0 }; ; ++lattice) {
+				// The signs point away from the vertex
+				const F xSign{ lane_select(xNeg, F(1.f), F(-1.f)) };
+				const F ySign{ lane_select(yNeg, F(1.f), F(-1.f)) };
+				const F zSign{ lane_select(zNeg, F(1.f), F(-1.f)) };
+				value = value + lane_select(a > F(0.f), pow4(a) * grad(hash(seed, i, j, k), x0, y0, z0), F(0.f));
+				// The neighbouring vertex along the largest axis
+				const auto alongX{ lane_and(ax0 >= ay0, ax0 >= az0) };
+				const auto alongY{ lane_and(lane_not(alongX), lane_and(ay0 > ax0, ay0 >= az0)) };
+				const auto alongZ{ lane_not(lane_or(alongX, alongY)) };
+				const F aMax{ lane_select(alongX, ax0, lane_select(alongY, ay0, az0)) };
+				const F b{ a + aMax + aMax - F(1.f) };
+				const I ib{ i + lane_select(alongX, lane_select(xNeg, I(0u) - I(PrimeX), I(PrimeX)), I(0u)) };
+				const I jb{ j + lane_select(alongY, lane_select(yNeg, I(0u) - I(PrimeY), I(PrimeY)), I(0u)) };
+				const I kb{ k + lane_select(alongZ, lane_select(zNeg, I(0u) - I(PrimeZ), I(PrimeZ)), I(0u)) };
+				const F xb{ x0 + lane_select(alongX, xSign, F(0.f)) };
+				const F yb{ y0 + lane_select(alongY, ySign, F(0.f)) };
+				const F zb{ z0 + lane_select(alongZ, zSign, F(0.f)) };
+				value = value + lane_select(b > F(0.f), pow4(b) * grad(hash(seed, ib, jb, kb), xb, yb, zb), F(0.f));
+				if (lattice == 1)
+					break;
+				// Continue with the nearest vertex of the second lattice,
+				// which is offset by half a cell towards the point
+				ax0 = F(0.5f) - ax0;
+				ay0 = F(0.5f) - ay0;
+				az0 = F(0.5f) - az0;
+				x0 = xSign * ax0;
+				y0 = ySign * ay0;
+				z0 = zSign * az0;
+				a = a + (F(0.75f) - ax0) - (ay0 + az0);
+				i = i + lane_select(xNeg, I(0u), I(PrimeX));
+				j = j + lane_select(yNeg, I(0u), I(PrimeY));
+				k = k + lane_select(zNeg, I(0u), I(PrimeZ));
+				xNeg = lane_not(xNeg);
+				yNeg = lane_not(yNeg);
+				zNeg = lane_not(zNeg);
+				seed = seed ^ I(0xffffffffu);
+			}
+			return lane_clamp(value * F(32.69428f));
+		}
+
+		template<typename F, typename I>
+		F open_simplex2(I seed, F x, F y, F z, F w)
+		{
+			constexpr float32 F4{ 0.30901699437494742410f };
+			constexpr float32 G4{ 0.13819660112501051518f };
+			// Skew onto the grid of the simplices
+			const F s{ (x + y + z + w) * F(F4) };
+			const F fx{ lane_floor(x + s) };
+			const F fy{ lane_floor(y + s) };
+			const F fz{ lane_floor(z + s) };
+			const F fw{ lane_floor(w + s) };
+			const F t{ (fx + fy + fz + fw) * F(G4) };
+			const F x0{ x - (fx - t) };
+			const F y0{ y - (fy - t) };
+			const F z0{ z - (fz - t) };
+			const F w0{ w - (fw - t) };
+			const I i{ lane_to_int(fx) * I(PrimeX) };
+			const I j{ lane_to_int(fy) * I(PrimeY) };
+			const I k{ lane_to_int(fz) * I(PrimeZ) };
+			const I l{ lane_to_int(fw) * I(PrimeW) };
+			// The rank of each coordinate orders the traversal of the simplex
+			F rx{ 0.f };
+			F ry{ 0.f };
+			F rz{ 0.f };
+			F rw{ 0.f };
+			const auto rank{ [](F a, F b, F& ra, F& rb) {
+				const auto greater{ a > b };
+				ra = ra + lane_select(greater, F(1.f), F(0.f));
+				rb = rb + lane_select(greater, F(0.f), F(1.f));
+			} };
+			rank(x0, y0, rx, ry);
+			rank(x0, z0, rx, rz);
+			rank(x0, w0, rx, rw);
+			rank(y0, z0, ry, rz);
+			rank(y0, w0, ry, rw);
+			rank(z0, w0, rz, rw);
+			const auto contribution{ [&](F threshold, F offset) {
+				const auto ox{ rx >= threshold };
+				const auto oy{ ry >= threshold };
+				const auto oz{ rz >= threshold };
+				const auto ow{ rw >= threshold };
+				const F dx{ x0 - lane_select(ox, F(1.f), F(0.f)) + offset };
+				const F dy{ y0 - lane_select(oy, F(1.f), F(0.f)) + offset };
+				const F dz{ z0 - lane_select(oz, F(1.f), F(0.f)) + offset };
+				const F dw{ w0 - lane_select(ow, F(1.f), F(0.f)) + offset };
+				const I h{ hash(seed,
+					i + lane_select(ox, I(PrimeX), I(0u)), j + lane_select(oy, I(PrimeY), I(0u)),
+					k + lane_select(oz, I(PrimeZ), I(0u)), l + lane_select(ow, I(PrimeW), I(0u))) };
+				const F a{ F(0.6f) - dx * dx - dy * dy - dz * dz - dw * dw };
+				return lane_select(a > F(0.f), pow4(a) * grad(h, dx, dy, dz, dw), F(0.f));
+			} };
+			const F n{ contribution(F(4.f), F(0.f))
+				+ contribution(F(3.f), F(G4))
+				+ contribution(F(2.f), F(2.f * G4))
+				+ contribution(F(1.f), F(3.f * G4))
+				+ contribution(F(0.f), F(4.f * G4)) };
+			return lane_clamp(n * F(27.22f));
+		}
+
+		// Worley noise. The feature point of a cell is in the middle half of
+		// the cell along each axis, so the nearest one is almost always in
+		// the neighbouring cells.
+
+		template<typename F, typename I>
+		inline F jitter(I bits, uint32 mask, float32 scale)
+		{
+			return lane_to_float(bits & I(mask)) * F(scale) + F(0.25f);
+		}
+
+		template<typename F, typename I>
+		F worley(I seed, F x, F y)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const F dx{ x - fx };
+			const F dy{ y - fy };
+			const I cx{ lane_to_int(fx) * I(PrimeX) };
+			const I cy{ lane_to_int(fy) * I(PrimeY) };
+			F best{ 8.f };
+			for (int32 oy{ -1 }; oy <= 1; ++oy) {
+				const I hy{ cy + I(static_cast<uint32>(oy) * PrimeY) };
+				for (int32 ox{ -1 }; ox <= 1; ++ox) {
+					const I h{ hash(seed, cx + I(static_cast<uint32>(ox) * PrimeX), hy) };
+					const F px{ F(static_cast<float32>(ox)) + jitter<F>(h, 0xffffu, 0.5f / 65536.f) - dx };
+					const F py{ F(static_cast<float32>(oy)) + jitter<F>(h >> 16, 0xffffu, 0.5f / 65536.f) - dy };
+					best = lane_min(best, px * px + py * py);
+				}
+			}
+			return lane_sqrt(best);
+		}
+
+		template<typename F, typename I>
+		F worley(I seed, F x, F y, F z)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const F fz{ lane_floor(z) };
+			const F dx{ x - fx };
+			const F dy{ y - fy };
+			const F dz{ z - fz };
+			const I cx{ lane_to_int(fx) * I(PrimeX) };
+			const I cy{ lane_to_int(fy) * I(PrimeY) };
+			const I cz{ lane_to_int(fz) * I(PrimeZ) };
+			F best{ 8.f };
+			for (int32 oz{ -1 }; oz <= 1; ++oz) {
+				const I hz{ cz + I(static_cast<uint32>(oz) * PrimeZ) };
+				for (int32 oy{ -1 }; oy <= 1; ++oy) {
+					const I hy{ cy + I(static_cast<uint32>(oy) * PrimeY) };
+					for (int32 ox{ -1 }; ox <= 1; ++ox) {
+						const I h{ hash(seed, cx + I(static_cast<uint32>(ox) * PrimeX), hy, hz) };
+						const F px{ F(static_cast<float32>(ox)) + jitter<F>(h, 0x3ffu, 0.5f / 1024.f) - dx };
+						const F py{ F(static_cast<float32>(oy)) + jitter<F>(h >> 10, 0x3ffu, 0.5f / 1024.f) - dy };
+						const F pz{ F(static_cast<float32>(oz)) + jitter<F>(h >> 20, 0x3ffu, 0.5f / 1024.f) - dz };
+						best = lane_min(best, px * px + py * py + pz * pz);
+					}
+				}
+			}
+			return lane_sqrt(best);
+		}
+
+		template<typename F, typename I>
+		F worley(I seed, F x, F y, F z, F w)
+		{
+			const F fx{ lane_floor(x) };
+			const F fy{ lane_floor(y) };
+			const F fz{ lane_floor(z) };
+			const F fw{ lane_floor(w) };
+			const F dx{ x - fx };
+			const F dy{ y - fy };
+			const F dz{ z - fz };
+			const F dw{ w - fw };
+			const I cx{ lane_to_int(fx) * I(PrimeX) };
+			const I cy{ lane_to_int(fy) * I(PrimeY) };
+			const I cz{ lane_to_int(fz) * I(PrimeZ) };
+			const I cw{ lane_to_int(fw) * I(PrimeW) };
+			F best{ 8.f };
+			for (int32 ow{ -1 }; ow <= 1; ++ow) {
+				const I hw{ cw + I(static_cast<uint32>(ow) * PrimeW) };
+				for (int32 oz{ -1 }; oz <= 1; ++oz) {
+					const I hz{ cz + I(static_cast<uint32>(oz) * PrimeZ) };
+					for (int32 oy{ -1 }; oy <= 1; ++oy) {
+						const I hy{ cy + I(static_cast<uint32>(oy) * PrimeY) };
+						for (int32 ox{ -1 }; ox <= 1; ++ox) {
+							const I h{ hash(seed, cx + I(static_cast<uint32>(ox) * PrimeX), hy, hz, hw) };
+							const F px{ F(static_cast<float32>(ox)) + jitter<F>(h, 0xffu, 0.5f / 256.f) - dx };
+							const F py{ F(static_cast<float32>(oy)) + jitter<F>(h >> 8, 0xffu, 0.5f / 256.f) - dy };
+							const F pz{ F(static_cast<float32>(oz)) + jitter<F>(h >> 16, 0xffu, 0.5f / 256.f) - dz };
+							const F pw{ F(static_cast<float32>(ow)) + jitter<F>(h >> 24, 0xffu, 0.5f / 256.f) - dw };
+							best = lane_min(best, px * px + py * py + pz * pz + pw * pw);
+						}
+					}
+				}
+			}
+			return lane_sqrt(best);
+		}
+
+		// Layering
+
+		template<int32 N, typename F>
+		struct lane_point
+		{
+			F c[N];
+		};
+
+		template<typename F, typename I>
+		inline F base_noise(NoiseType type, I seed, lane_point<2, F> const& p)
+		{
+			switch (type) {
+			case NoiseType::OPENSIMPLEX2:
+				return open_simplex2(seed, p.c[0], p.c[1]);
+			case NoiseType::WORLEY:
+				return worley(seed, p.c[0], p.c[1]);
+			default:
+				return perlin(seed, p.c[0], p.c[1]);
+			}
+		}
+
+		template<typename F, typename I>
+		inline F base_noise(NoiseType type, I seed, lane_point<3, F> const& p)
+		{
+			switch (type) {
+			case NoiseType::OPENSIMPLEX2:
+				return open_simplex2(seed, p.c[0], p.c[1], p.c[2]);
+			case NoiseType::WORLEY:
+				return worley(seed, p.c[0], p.c[1], p.c[2]);
+			default:
+				return perlin(seed, p.c[0], p.c[1], p.c[2]);
+			}
+		}
+
+		template<typename F, typename I>
+		inline F base_noise(NoiseType type, I seed, lane_point<4, F> const& p)
+		{
+			switch (type) {
+			case NoiseType::OPENSIMPLEX2:
+				return open_simplex2(seed, p.c[0], p.c[1], p.c[2], p.c[3]);
+			case NoiseType::WORLEY:
+				return worley(seed, p.c[0], p.c[1], p.c[2], p.c[3]);
+			default:
+				return perlin(seed, p.c[0], p.c[1], p.c[2], p.c[3]);
+			}
+		}
+
+		template<typename I, int32 N, typename F>
+		F layered_noise(NoiseSettings const& settings, lane_point<N, F> p)
+		{
+			for (int32 d{ 0 }; d < N; ++d)
+				p.c[d] = p.c[d] * F(settings.frequency);
+			const uint32 seed{ static_cast<uint32>(settings.seed) };
+			if (settings.fractal == FractalType::NONE || settings.octaves <= 1) {
+				const F n{ base_noise(settings.type, I(seed), p) };
+				return settings.fractal == FractalType::RIDGED ? F(1.f) - lane_abs(n) * F(2.f) : n;
+			}
+			F sum{ 0.f };
+			float32 amplitude{ 1.f };
+			float32 total{ 0.f };
+			for (int32 octave{ 0 }; octave < settings.octaves; ++octave) {
+				F n{ base_noise(settings.type, I(seed + static_cast<uint32>(octave)), p) };
+				if (settings.fractal == FractalType::RIDGED)
+					n = F(1.f) - lane_abs(n) * F(2.f);
+				sum = sum + n * F(amplitude);
+				total += amplitude;
+				amplitude *= settings.gain;
+				for (int32 d{ 0 }; d < N; ++d)
+					p.c[d] = p.c[d] * F(settings.lacunarity);
+			}
+			return sum * F(1.f / total);
+		}
+
+		template<int32 N, typename Vector>
+		lane_point<N, float32> to_point(Vector const& v)
+		{
+			lane_point<N, float32> p;
+			for (int32 d{ 0 }; d < N; ++d)
+				p.c[d] = v[static_cast<uint8>(d)];
+			return p;
+		}
+
+		template<int32 N, typename Vector>
+		void noise_batch(NoiseSettings const& settings, Vector const* points, float32* out, uint64 count)
+		{
+			ECM_ALIGN(32) float32 coords[N][LaneCount];
+			ECM_ALIGN(32) float32 values[LaneCount];
+			for (uint64 i{ 0 }; i < count; i += LaneCount) {
+				// A partial batch repeats its last point
+				const uint64 n{ std::min<uint64>(count - i, LaneCount) };
+				for (uint32 lane{ 0 }; lane < LaneCount; ++lane) {
+					Vector const& v{ points[i + std::min<uint64>(lane, n - 1)] };
+					for (int32 d{ 0 }; d < N; ++d)
+						coords[d][lane] = v[static_cast<uint8>(d)];
+				}
+				lane_point<N, vfloat> p;
+				for (int32 d{ 0 }; d < N; ++d)
+					p.c[d] = load_ps(coords[d]);
+				store_ps(values, layered_noise<vint>(settings, p).v);
+				std::copy(values, values + n, out + i);
+			}
+		}
+
+		// Fills a row of a grid, whose coordinates besides x are constant.
+		template<int32 N>
+		void noise_row(NoiseSettings const& settings, lane_point<N, float32> const& start, float32 spacing, uint32 width, float32* out)
+		{
+			ECM_ALIGN(32) float32 offsets[LaneCount];
+			ECM_ALIGN(32) float32 values[LaneCount];
+			for (uint32 lane{ 0 }; lane < LaneCount; ++lane)
+				offsets[lane] = static_cast<float32>(lane);
+			const vfloat laneOffsets{ load_ps(offsets) };
+			lane_point<N, vfloat> p;
+			for (int32 d{ 1 }; d < N; ++d)
+				p.c[d] = vfloat(start.c[d]);
+			for (uint32 x{ 0 }; x < width; x += LaneCount) {
+				p.c[0] = vfloat(start.c[0]) + (vfloat(static_cast<float32>(x)) + laneOffsets) * vfloat(spacing);
+				const vfloat v{ layered_noise<vint>(settings, p) };
+				if (x + LaneCount <= width) {
+#if ECM_SIMD_AVX2
+					_mm256_storeu_ps(out + x, v.v);
+#else
+					_mm_storeu_ps(out + x, v.v);
+#endif // ECM_SIMD_AVX2
+				} else {
+					store_ps(values, v.v);
+					std::copy(values, values + (width - x), out + x);
+				}
+			}
+		}
+
+		// The number of rows of a chunk, so that a chunk has at least 4096
+		// values.
+		inline uint64 row_grain(uint32 width)
+		{
+			return std::max<uint64>(1, 4096 / std::max<uint32>(width, 1));
+		}
+	} // anonymous namespace
+
+	// Base functions
+
+	float32 Perlin(Vector2_Base<float32> const& p, int32 seed) noexcept
+	{
+		return perlin(static_cast<uint32>(seed), p.x, p.y);
+	}
+
+	float32 Perlin(Vector3_Base<float32> const& p, int32 seed) noexcept
+	{
+		return perlin(static_cast<uint32>(seed), p.x, p.y, p.z);
+	}
+
+	float32 Perlin(Vector4_Base<float32> const& p, int32 seed) noexcept
+	{
+		return perlin(static_cast<uint32>(seed), p.x, p.y, p.z, p.w);
+	}
+
+	float32 OpenSimplex2(Vector2_Base<float32> const& p, int32 seed) noexcept
+	{
+		return open_simplex2(static_cast<uint32>(seed), p.x, p.y);
+	}
+
+	float32 OpenSimplex2(Vector3_Base<float32> const& p, int32 seed) noexcept
+	{
+		return open_simplex2(static_cast<uint32>(seed), p.x, p.y, p.z);
+	}
+
+	float32 OpenSimplex2(Vector4_Base<float32> const& p, int32 seed) noexcept
+	{
+		return open_simplex2(static_cast<uint32>(seed), p.x, p.y, p.z, p.w);
+	}
+
+	float32 Worley(Vector2_Base<float32> const& p, int32 seed) noexcept
+	{
+		return worley(static_cast<uint32>(seed), p.x, p.y);
+	}
+
+	float32 Worley(Vector3_Base<float32> const& p, int32 seed) noexcept
+	{
+		return worley(static_cast<uint32>(seed), p.x, p.y, p.z);
+	}
+
+	float32 Worley(Vector4_Base<float32> const& p, int32 seed) noexcept
+	{
+		return worley(static_cast<uint32>(seed), p.x, p.y, p.z, p.w);
+	}
+
+	// Layered noise
+
+	float32 Noise(NoiseSettings const& settings, Vector2_Base<float32> const& p) noexcept
+	{
+		return layered_noise<uint32>(settings, to_point<2>(p));
+	}
+
+	float32 Noise(NoiseSettings const& settings, Vector3_Base<float32> const& p) noexcept
+	{
+		return layered_noise<uint32>(settings, to_point<3>(p));
+	}
+
+	float32 Noise(NoiseSettings const& settings, Vector4_Base<float32> const& p) noexcept
+	{
+		return layered_noise<uint32>(settings, to_point<4>(p));
+	}
+
+	// Batch functions
+
+	void NoiseBatch(NoiseSettings const& settings, Vector2_Base<float32> const* points, float32* out, uint64 count) noexcept
+	{
+		noise_batch<2>(settings, points, out, count);
+	}
+
+	void NoiseBatch(NoiseSettings const& settings, Vector3_Base<float32> const* points, float32* out, uint64 count) noexcept
+	{
+		noise_batch<3>(settings, points, out, count);
+	}
+
+	void NoiseBatch(NoiseSettings const& settings, Vector4_Base<float32> const* points, float32* out, uint64 count) noexcept
+	{
+		noise_batch<4>(settings, points, out, count);
+	}
+
+	void FillNoiseGrid(NoiseSettings const& settings, Vector2_Base<float32> const& origin,
+		Vector2_Base<float32> const& spacing, uint32 width, uint32 height, float32* out)
+	{
+		ParallelFor(0, height, row_grain(width), [&](uint64 begin, uint64 end) {
+			for (uint64 y{ begin }; y < end; ++y) {
+				const lane_point<2, float32> start{ { origin.x, origin.y + static_cast<float32>(y) * spacing.y } };
+				noise_row(settings, start, spacing.x, width, out + y * width);
+			}
+		});
+	}
+
+	void FillNoiseGrid(NoiseSettings const& settings, Vector3_Base<float32> const& origin,
+		Vector3_Base<float32> const& spacing, uint32 width, uint32 height, uint32 depth, float32* out)
+	{
+		const uint64 rows{ static_cast<uint64>(height) * depth };
+		ParallelFor(0, rows, row_grain(width), [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row) {
+				const float32 y{ static_cast<float32>(row % height) };
+				const float32 z{ static_cast<float32>(row / height) };
+				const lane_point<3, float32> start{ {
+					origin.x, origin.y + y * spacing.y, origin.z + z * spacing.z } };
+				noise_row(settings, start, spacing.x, width, out + row * width);
+			}
+		});
+	}
+} // namespace ecm::math
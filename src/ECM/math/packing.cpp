@@ -0,0 +1,270 @@
+#include <ECM/math/packing.h>
+#include <ECM/math/functions_simd.h>
+
+static_assert(sizeof(ecm::math::Vector3_Base<ecm::float32>) == 12,
+	"The batch functions require tightly packed vectors.");
+static_assert(sizeof(ecm::math::Vector4_Base<ecm::float32>) == 16,
+	"The batch functions require tightly packed vectors.");
+
+namespace ecm::math
+{
+	namespace
+	{
+		// Loads four Vector3 and transposes them into one register per
+		// component.
+		inline void load_soa3(float32 const* in, __m128& x, __m128& y, __m128& z)
+		{
+			const __m128 v0{ _mm_loadu_ps(in) };     // x0 y0 z0 x1
+			const __m128 v1{ _mm_loadu_ps(in + 4) }; // y1 z1 x2 y2
+			const __m128 v2{ _mm_loadu_ps(in + 8) }; // z2 x3 y3 z3
+			const __m128 a{ _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)) }; // x2 y2 x3 y3
+			const __m128 b{ _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)) }; // y0 z0 y1 z1
+			x = _mm_shuffle_ps(v0, a, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(b, a, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm_shuffle_ps(b, v2, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+
+		// Transposes one register per component back and stores four Vector3.
+		inline void store_soa3(float32* out, __m128 x, __m128 y, __m128 z)
+		{
+			const __m128 xy01{ _mm_unpacklo_ps(x, y) }; // x0 y0 x1 y1
+			const __m128 xy23{ _mm_unpackhi_ps(x, y) }; // x2 y2 x3 y3
+			const __m128 zx{ _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 0, 1, 0)) };        // z0 z1 x0 x1
+			const __m128 yz{ _mm_shuffle_ps(xy01, z, _MM_SHUFFLE(1, 1, 3, 3)) };     // y1 y1 z1 z1
+			const __m128 zxy{ _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2)) };    // z2 z3 x3 y3
+			_mm_storeu_ps(out, _mm_shuffle_ps(xy01, zx, _MM_SHUFFLE(3, 0, 1, 0)));
+			_mm_storeu_ps(out + 4, _mm_shuffle_ps(yz, xy23, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(out + 8, _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(1, 3, 2, 0)));
+		}
+
+		inline __m128 abs4(__m128 v)
+		{
+			return _mm_andnot_ps(_mm_set1_ps(-0.f), v);
+		}
+
+		// Selects a where the mask is set and b otherwise.
+		inline __m128 select4(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		// Same as detail::to_snorm for four values.
+		inline __m128i to_snorm4(__m128 v, __m128 max)
+		{
+			const __m128 clamped{ _mm_max_ps(_mm_min_ps(v, _mm_set1_ps(1.f)), _mm_set1_ps(-1.f)) };
+			return _mm_cvtps_epi32(_mm_mul_ps(clamped, max));
+		}
+
+		// Same as detail::from_snorm for four values.
+		inline __m128 from_snorm4(__m128i v, __m128 max)
+		{
+			return _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(v), max), _mm_set1_ps(-1.f));
+		}
+
+		// Same as detail::octahedral_project for four vectors.
+		inline void octahedral_project4(__m128 x, __m128 y, __m128 z, __m128& u, __m128& v)
+		{
+			const __m128 zero{ _mm_setzero_ps() };
+			const __m128 one{ _mm_set1_ps(1.f) };
+			const __m128 invL1{ _mm_div_ps(one, _mm_add_ps(_mm_add_ps(abs4(x), abs4(y)), abs4(z))) };
+			const __m128 pu{ _mm_mul_ps(x, invL1) };
+			const __m128 pv{ _mm_mul_ps(y, invL1) };
+
+			const __m128 signU{ select4(_mm_cmpge_ps(pu, zero), one, _mm_set1_ps(-1.f)) };
+			const __m128 signV{ select4(_mm_cmpge_ps(pv, zero), one, _mm_set1_ps(-1.f)) };
+			const __m128 foldU{ _mm_mul_ps(_mm_sub_ps(one, abs4(pv)), signU) };
+			const __m128 foldV{ _mm_mul_ps(_mm_sub_ps(one, abs4(pu)), signV) };
+			const __m128 lower{ _mm_cmplt_ps(z, zero) };
+			u = select4(lower, foldU, pu);
+			v = select4(lower, foldV, pv);
+		}
+
+		// Same as detail::octahedral_unproject for four vectors.
+		inline void octahedral_unproject4(__m128 u, __m128 v, __m128& x, __m128& y, __m128& z)
+		{
+			const __m128 zero{ _mm_setzero_ps() };
+			const __m128 one{ _mm_set1_ps(1.f) };
+			z = _mm_sub_ps(_mm_sub_ps(one, abs4(u)), abs4(v));
+			const __m128 t{ _mm_max_ps(_mm_sub_ps(zero, z), zero) };
+			const __m128 negT{ _mm_sub_ps(zero, t) };
+			x = _mm_add_ps(u, select4(_mm_cmpge_ps(u, zero), negT, t));
+			y = _mm_add_ps(v, select4(_mm_cmpge_ps(v, zero), negT, t));
+
+			const __m128 lengthSq{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)) };
+			const __m128 invLength{ _mm_div_ps(one, _mm_sqrt_ps(lengthSq)) };
+			x = _mm_mul_ps(x, invLength);
+			y = _mm_mul_ps(y, invLength);
+			z = _mm_mul_ps(z, invLength);
+		}
+	} // anonymous namespace
+
+	namespace detail
+	{
+		Vector3_Base<float32> octahedral_unproject(float32 u, float32 v) noexcept
+		{
+			const float32 z{ 1.f - std::fabs(u) - std::fabs(v) };
+			const float32 t{ z < 0.f ? -z : 0.f };
+			const float32 x{ u + (u >= 0.f ? -t : t) };
+			const float32 y{ v + (v >= 0.f ? -t : t) };
+			const float32 invLength{ 1.f / std::sqrt(x * x + y * y + z * z) };
+			return Vector3_Base<float32>(x * invLength, y * invLength, z * invLength);
+		}
+	} // namespace detail
+
+	// Octahedral encodings
+
+	void EncodeOctahedral16Batch(Vector3_Base<float32> const* in, uint32* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(32767.f) };
+		const __m128i mask{ _mm_set1_epi32(0xffff) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z, u, v;
+			load_soa3(reinterpret_cast<float32 const*>(in + i), x, y, z);
+			octahedral_project4(x, y, z, u, v);
+			const __m128i qu{ _mm_and_si128(to_snorm4(u, max), mask) };
+			const __m128i qv{ _mm_slli_epi32(to_snorm4(v, max), 16) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(qu, qv));
+		}
+		for (; i < count; ++i) {
+			out[i] = EncodeOctahedral16(in[i]);
+		}
+	}
+
+	void DecodeOctahedral16Batch(uint32 const* in, Vector3_Base<float32>* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(32767.f) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i packed{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+			const __m128 u{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 16), max) };
+			const __m128 v{ from_snorm4(_mm_srai_epi32(packed, 16), max) };
+			__m128 x, y, z;
+			octahedral_unproject4(u, v, x, y, z);
+			store_soa3(reinterpret_cast<float32*>(out + i), x, y, z);
+		}
+		for (; i < count; ++i) {
+			out[i] = DecodeOctahedral16(in[i]);
+		}
+	}
+
+	void EncodeOctahedral8Batch(Vector3_Base<float32> const* in, uint16* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(127.f) };
+		const __m128i mask{ _mm_set1_epi32(0xff) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			__m128 x, y, z, u, v;
+			load_soa3(reinterpret_cast<float32 const*>(in + i), x, y, z);
+			octahedral_project4(x, y, z, u, v);
+			// The shifted y keeps its sign, so the result stays in the 16-bit
+			// range and packing does not saturate.
+			const __m128i qu{ _mm_and_si128(to_snorm4(u, max), mask) };
+			const __m128i qv{ _mm_slli_epi32(to_snorm4(v, max), 8) };
+			const __m128i packed{ _mm_or_si128(qu, qv) };
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(packed, packed));
+		}
+		for (; i < count; ++i) {
+			out[i] = EncodeOctahedral8(in[i]);
+		}
+	}
+
+	void DecodeOctahedral8Batch(uint16 const* in, Vector3_Base<float32>* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(127.f) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i packed{ _mm_unpacklo_epi16(
+				_mm_loadl_epi64(reinterpret_cast<__m128i const*>(in + i)), _mm_setzero_si128()) };
+			const __m128 u{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 24), 24), max) };
+			const __m128 v{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 16), 24), max) };
+			__m128 x, y, z;
+			octahedral_unproject4(u, v, x, y, z);
+			store_soa3(reinterpret_cast<float32*>(out + i), x, y, z);
+		}
+		for (; i < count; ++i) {
+			out[i] = DecodeOctahedral8(in[i]);
+		}
+	}
+
+	// Snorm encodings
+
+	void EncodeSnorm1010102Batch(Vector4_Base<float32> const* in, uint32* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(511.f) };
+		const __m128i mask{ _mm_set1_epi32(0x3ff) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			float32 const* src{ reinterpret_cast<float32 const*>(in + i) };
+			__m128 x{ _mm_loadu_ps(src) };
+			__m128 y{ _mm_loadu_ps(src + 4) };
+			__m128 z{ _mm_loadu_ps(src + 8) };
+			__m128 w{ _mm_loadu_ps(src + 12) };
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			const __m128i qx{ _mm_and_si128(to_snorm4(x, max), mask) };
+			const __m128i qy{ _mm_slli_epi32(_mm_and_si128(to_snorm4(y, max), mask), 10) };
+			const __m128i qz{ _mm_slli_epi32(_mm_and_si128(to_snorm4(z, max), mask), 20) };
+			const __m128i qw{ _mm_slli_epi32(to_snorm4(w, _mm_set1_ps(1.f)), 30) };
+			const __m128i packed{ _mm_or_si128(_mm_or_si128(qx, qy), _mm_or_si128(qz, qw)) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+		}
+		for (; i < count; ++i) {
+			out[i] = EncodeSnorm1010102(in[i]);
+		}
+	}
+
+	void DecodeSnorm1010102Batch(uint32 const* in, Vector4_Base<float32>* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(511.f) };
+		uint64 i{ 0 };
+		for (; i + 4 <= count; i += 4) {
+			const __m128i packed{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+			__m128 x{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 22), 22), max) };
+			__m128 y{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 12), 22), max) };
+			__m128 z{ from_snorm4(_mm_srai_epi32(_mm_slli_epi32(packed, 2), 22), max) };
+			__m128 w{ from_snorm4(_mm_srai_epi32(packed, 30), _mm_set1_ps(1.f)) };
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			float32* dst{ reinterpret_cast<float32*>(out + i) };
+			_mm_storeu_ps(dst, x);
+			_mm_storeu_ps(dst + 4, y);
+			_mm_storeu_ps(dst + 8, z);
+			_mm_storeu_ps(dst + 12, w);
+		}
+		for (; i < count; ++i) {
+			out[i] = DecodeSnorm1010102(in[i]);
+		}
+	}
+
+	void EncodeSnorm16x4Batch(Vector4_Base<float32> const* in, uint64* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(32767.f) };
+		uint64 i{ 0 };
+		for (; i + 2 <= count; i += 2) {
+			float32 const* src{ reinterpret_cast<float32 const*>(in + i) };
+			const __m128i q0{ to_snorm4(_mm_loadu_ps(src), max) };
+			const __m128i q1{ to_snorm4(_mm_loadu_ps(src + 4), max) };
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(q0, q1));
+		}
+		for (; i < count; ++i) {
+			out[i] = EncodeSnorm16x4(in[i]);
+		}
+	}
+
+	void DecodeSnorm16x4Batch(uint64 const* in, Vector4_Base<float32>* out, uint64 count)
+	{
+		const __m128 max{ _mm_set1_ps(32767.f) };
+		uint64 i{ 0 };
+		for (; i + 2 <= count; i += 2) {
+			const __m128i packed{ _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i)) };
+			// Interleaving a value with itself and shifting back sign extends it
+			const __m128i q0{ _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16) };
+			const __m128i q1{ _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16) };
+			float32* dst{ reinterpret_cast<float32*>(out + i) };
+			_mm_storeu_ps(dst, from_snorm4(q0, max));
+			_mm_storeu_ps(dst + 4, from_snorm4(q1, max));
+		}
+		for (; i < count; ++i) {
+			out[i] = DecodeSnorm16x4(in[i]);
+		}
+	}
+} // namespace ecm::math
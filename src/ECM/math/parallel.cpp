@@ -0,0 +1,142 @@
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// Set on the worker threads and while a thread runs chunks, so that
+		// nested loops run serially instead of waiting for themselves.
+		thread_local bool InParallelLoop{ false };
+
+		class thread_pool
+		{
+		public:
+			explicit thread_pool(uint32 workerCount)
+			{
+				_workers.reserve(workerCount);
+				for (uint32 i{ 0 }; i < workerCount; ++i)
+					_workers.emplace_back([this]() { Work(); });
+			}
+
+			~thread_pool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stop = true;
+				}
+				_wake.notify_all();
+				for (std::thread& worker : _workers)
+					worker.join();
+			}
+
+			uint32 GetThreadCount() const noexcept
+			{
+				return static_cast<uint32>(_workers.size()) + 1;
+			}
+
+			void Run(uint64 begin, uint64 end, uint64 grain, detail::parallel_task task, void* context)
+			{
+				std::unique_lock<std::mutex> submit(_submit, std::try_to_lock);
+				if (!submit.owns_lock() || _workers.empty()) {
+					RunSerial(begin, end, grain, task, context);
+					return;
+				}
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_task = task;
+					_context = context;
+					_end = end;
+					_grain = grain;
+					_next.store(begin, std::memory_order_relaxed);
+					_active = static_cast<uint32>(_workers.size());
+					++_generation;
+				}
+				_wake.notify_all();
+				InParallelLoop = true;
+				RunChunks();
+				InParallelLoop = false;
+				std::unique_lock<std::mutex> lock(_mutex);
+				_done.wait(lock, [this]() { return _active == 0; });
+			}
+
+			static void RunSerial(uint64 begin, uint64 end, uint64 grain, detail::parallel_task task, void* context)
+			{
+				for (uint64 i{ begin }; i < end; i += grain)
+					task(context, i, std::min(end - i, grain) + i);
+			}
+		private:
+			void RunChunks()
+			{
+				for (;;) {
+					const uint64 chunk{ _next.fetch_add(_grain, std::memory_order_relaxed) };
+					if (chunk >= _end)
+						break;
+					_task(_context, chunk, std::min(_end - chunk, _grain) + chunk);
+				}
+			}
+
+			void Work()
+			{
+				InParallelLoop = true;
+				uint64 generation{ 0 };
+				for (;;) {
+					{
+						std::unique_lock<std::mutex> lock(_mutex);
+						_wake.wait(lock, [&]() { return _stop || _generation != generation; });
+						if (_stop)
+							return;
+						generation = _generation;
+					}
+					RunChunks();
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (--_active == 0)
+						_done.notify_one();
+				}
+			}
+
+			std::vector<std::thread> _workers;
+			std::mutex _submit;
+			std::mutex _mutex;
+			std::condition_variable _wake;
+			std::condition_variable _done;
+			detail::parallel_task _task{ nullptr };
+			void* _context{ nullptr };
+			uint64 _end{ 0 };
+			uint64 _grain{ 1 };
+			std::atomic<uint64> _next{ 0 };
+			uint64 _generation{ 0 };
+			uint32 _active{ 0 };
+			bool _stop{ false };
+		};
+
+		thread_pool& get_thread_pool()
+		{
+			static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+			return pool;
+		}
+	} // anonymous namespace
+
+	uint32 GetParallelThreadCount() noexcept
+	{
+		return get_thread_pool().GetThreadCount();
+	}
+
+	namespace detail
+	{
+		void parallel_for(uint64 begin, uint64 end, uint64 grain, parallel_task task, void* context)
+		{
+			if (InParallelLoop) {
+				thread_pool::RunSerial(begin, end, grain, task, context);
+				return;
+			}
+			get_thread_pool().Run(begin, end, grain, task, context);
+		}
+	} // namespace detail
+} // namespace ecm::math
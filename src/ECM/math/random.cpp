@@ -0,0 +1,408 @@
+#include <ECM/math/random.h>
+#include <ECM/math/functions_simd.h>
+
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint32 BufferSize{ 256 };
+		constexpr float32 Uint24ToFloat{ 1.f / 16777216.f };
+		constexpr float32 TwoPi{ 6.28318530717958647692f };
+
+		// Converts 32 random bits to a float in [0, 1) with 24 random bits.
+		inline float32 to_unit_float(uint32 bits) noexcept
+		{
+			return static_cast<float32>(bits >> 8u) * Uint24ToFloat;
+		}
+
+		// Reads random bits from a generator in blocks of BufferSize values.
+		struct bit_reader
+		{
+			detail::bit_source source;
+			uint32 buffer[BufferSize];
+			uint32 index;
+
+			explicit bit_reader(detail::bit_source source) noexcept
+				: source(source), index(BufferSize)
+			{}
+
+			uint32 Next() noexcept
+			{
+				if (index == BufferSize) {
+					source.fill(source.generator, buffer, BufferSize);
+					index = 0;
+				}
+				return buffer[index++];
+			}
+		};
+
+		// The tables of the Ziggurat method with 128 layers, from Marsaglia
+		// and Tsang, "The Ziggurat Method for Generating Random Variables".
+		struct ziggurat_tables
+		{
+			uint32 k[128];
+			float32 w[128];
+			float32 f[128];
+
+			ziggurat_tables() noexcept
+			{
+				const float64 m1{ 2147483648.0 };
+				const float64 vn{ 9.91256303526217e-3 };
+				float64 dn{ 3.442619855899 };
+				float64 tn{ dn };
+				const float64 q{ vn / std::exp(-0.5 * dn * dn) };
+				k[0] = static_cast<uint32>((dn / q) * m1);
+				k[1] = 0;
+				w[0] = static_cast<float32>(q / m1);
+				w[127] = static_cast<float32>(dn / m1);
+				f[0] = 1.f;
+				f[127] = static_cast<float32>(std::exp(-0.5 * dn * dn));
+				for (int32 i{ 126 }; i >= 1; --i) {
+					dn = std::sqrt(-2.0 * std::log(vn / dn + std::exp(-0.5 * dn * dn)));
+					k[i + 1] = static_cast<uint32>((dn / tn) * m1);
+					tn = dn;
+					f[i] = static_cast<float32>(std::exp(-0.5 * dn * dn));
+					w[i] = static_cast<float32>(dn / m1);
+				}
+			}
+		};
+
+		ziggurat_tables const& get_ziggurat_tables() noexcept
+		{
+			static const ziggurat_tables tables;
+			return tables;
+		}
+
+		inline uint32 magnitude(int32 v) noexcept
+		{
+			return v < 0 ? 0u - static_cast<uint32>(v) : static_cast<uint32>(v);
+		}
+
+		// Continues the Ziggurat method after a value was outside the
+		// rectangle of its layer (RNOR's nfix).
+		float32 ziggurat_fix(ziggurat_tables const& tables, bit_reader& reader, int32 hz, uint32 iz) noexcept
+		{
+			constexpr float32 r{ 3.442620f };
+			for (;;) {
+				const float32 x{ static_cast<float32>(hz) * tables.w[iz] };
+				if (iz == 0) {
+					// Sample the tail beyond r
+					float32 tx{ 0.f };
+					float32 ty{ 0.f };
+					do {
+						tx = -std::log((static_cast<float32>(reader.Next() >> 8u) + 0.5f) * Uint24ToFloat) / r;
+						ty = -std::log((static_cast<float32>(reader.Next() >> 8u) + 0.5f) * Uint24ToFloat);
+					} while (ty + ty < tx * tx);
+					return hz > 0 ? r + tx : -r - tx;
+				}
+				const float32 u{ (static_cast<float32>(reader.Next() >> 8u) + 0.5f) * Uint24ToFloat };
+				if (tables.f[iz] + u * (tables.f[iz - 1] - tables.f[iz]) < std::exp(-0.5f * x * x))
+					return x;
+				hz = static_cast<int32>(reader.Next());
+				iz = static_cast<uint32>(hz) & 127u;
+				if (magnitude(hz) < tables.k[iz])
+					return static_cast<float32>(hz) * tables.w[iz];
+			}
+		}
+
+		// Scales and offsets floats of 24 random bits, the SIMD way.
+		void uniform_kernel(uint32 const* bits, float32* out, uint32 count, float32 scale, float32 offset, float32 limit) noexcept
+		{
+			uint32 i{ 0 };
+#if ECM_SIMD_AVX2
+			{
+				const __m256 vScale{ _mm256_set1_ps(scale) };
+				const __m256 vOffset{ _mm256_set1_ps(offset) };
+				const __m256 vLimit{ _mm256_set1_ps(limit) };
+				for (; i + 8 <= count; i += 8) {
+					const __m256i b{ _mm256_srli_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(bits + i)), 8) };
+					const __m256 v{ _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(b), vScale), vOffset) };
+					_mm256_storeu_ps(out + i, _mm256_min_ps(v, vLimit));
+				}
+			}
+#endif // ECM_SIMD_AVX2
+			const __m128 vScale{ _mm_set1_ps(scale) };
+			const __m128 vOffset{ _mm_set1_ps(offset) };
+			const __m128 vLimit{ _mm_set1_ps(limit) };
+			for (; i + 4 <= count; i += 4) {
+				const __m128i b{ _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(bits + i)), 8) };
+				const __m128 v{ _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(b), vScale), vOffset) };
+				_mm_storeu_ps(out + i, _mm_min_ps(v, vLimit));
+			}
+			for (; i < count; ++i) {
+				const float32 v{ static_cast<float32>(bits[i] >> 8u) * scale + offset };
+				out[i] = v < limit ? v : limit;
+			}
+		}
+
+#if ECM_SIMD_AVX2
+		// Multiplies four 64-bit integers by a constant, modulo 2^64.
+		inline __m256i mul_epi64_const(__m256i a, __m256i lo, __m256i hi) noexcept
+		{
+			const __m256i cross{ _mm256_add_epi64(
+				_mm256_mul_epu32(_mm256_srli_epi64(a, 32), lo), _mm256_mul_epu32(a, hi)) };
+			return _mm256_add_epi64(_mm256_mul_epu32(a, lo), _mm256_slli_epi64(cross, 32));
+		}
+
+		// The PCG-XSH-RR output of four states, in the low half of each lane.
+		inline __m256i pcg_output_4(__m256i state) noexcept
+		{
+			const __m256i xorshifted{ _mm256_srli_epi64(
+				_mm256_xor_si256(_mm256_srli_epi64(state, 18), state), 27) };
+			const __m256i rot{ _mm256_srli_epi64(state, 59) };
+			return _mm256_or_si256(_mm256_srlv_epi32(xorshifted, rot),
+				_mm256_sllv_epi32(xorshifted, _mm256_sub_epi32(_mm256_set1_epi32(32), rot)));
+		}
+
+		inline __m256i rotl_epi64(__m256i v, int32 r) noexcept
+		{
+			return _mm256_or_si256(_mm256_slli_epi64(v, r), _mm256_srli_epi64(v, 64 - r));
+		}
+#else
+		inline __m128i rotl_epi64(__m128i v, int32 r) noexcept
+		{
+			return _mm_or_si128(_mm_slli_epi64(v, r), _mm_srli_epi64(v, 64 - r));
+		}
+#endif // ECM_SIMD_AVX2
+	} // anonymous namespace
+
+	// Pcg32x8
+
+	Pcg32x8::Pcg32x8() noexcept
+		: Pcg32x8(0x853c49e6748fea9bull, 0)
+	{}
+
+	Pcg32x8::Pcg32x8(uint64 seed, uint64 stream) noexcept
+	{
+		for (uint32 lane{ 0 }; lane < 8; ++lane) {
+			_inc[lane] = ((stream * 8 + lane) << 1u) | 1u;
+			_state[lane] = _inc[lane];
+			_state[lane] += seed;
+			_state[lane] = _state[lane] * detail::pcg_multiplier + _inc[lane];
+		}
+	}
+
+	Pcg32x8::result_type Pcg32x8::operator()() noexcept
+	{
+		uint32 value{ 0 };
+		Fill(&value, 1);
+		return value;
+	}
+
+	void Pcg32x8::Advance(uint64 delta) noexcept
+	{
+		for (uint32 lane{ 0 }; lane < 8; ++lane)
+			_state[lane] = detail::pcg_advance(_state[lane], _inc[lane], delta);
+	}
+
+	void Pcg32x8::Fill(uint32* out, uint64 count) noexcept
+	{
+		uint64 i{ 0 };
+#if ECM_SIMD_AVX2
+		const __m256i lo{ _mm256_set1_epi64x(static_cast<int64>(detail::pcg_multiplier & 0xffffffffu)) };
+		const __m256i hi{ _mm256_set1_epi64x(static_cast<int64>(detail::pcg_multiplier >> 32u)) };
+		__m256i state0{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state)) };
+		__m256i state1{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state + 4)) };
+		const __m256i inc0{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_inc)) };
+		const __m256i inc1{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_inc + 4)) };
+		for (; i < count; i += 8) {
+			// Gather the low halves of the lanes 0-3 and 4-7 in order
+			const __m256i a{ _mm256_shuffle_epi32(pcg_output_4(state0), _MM_SHUFFLE(2, 0, 2, 0)) };
+			const __m256i b{ _mm256_shuffle_epi32(pcg_output_4(state1), _MM_SHUFFLE(2, 0, 2, 0)) };
+			const __m256i values{ _mm256_permute4x64_epi64(_mm256_blend_epi32(a, b, 0xcc), _MM_SHUFFLE(3, 1, 2, 0)) };
+			state0 = _mm256_add_epi64(mul_epi64_const(state0, lo, hi), inc0);
+			state1 = _mm256_add_epi64(mul_epi64_const(state1, lo, hi), inc1);
+			if (i + 8 <= count) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+			} else {
+				ECM_ALIGN(32) uint32 tail[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(tail), values);
+				for (uint64 j{ 0 }; i + j < count; ++j)
+					out[i + j] = tail[j];
+			}
+		}
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state), state0);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state + 4), state1);
+#else
+		for (; i < count; i += 8) {
+			for (uint32 lane{ 0 }; lane < 8; ++lane) {
+				if (i + lane < count)
+					out[i + lane] = detail::pcg_output(_state[lane]);
+				_state[lane] = _state[lane] * detail::pcg_multiplier + _inc[lane];
+			}
+		}
+#endif // ECM_SIMD_AVX2
+	}
+
+	// Xoshiro256ppx4
+
+	Xoshiro256ppx4::Xoshiro256ppx4() noexcept
+		: Xoshiro256ppx4(0x853c49e6748fea9bull)
+	{}
+
+	Xoshiro256ppx4::Xoshiro256ppx4(uint64 seed) noexcept
+	{
+		uint64 s[4]{ 0, 0, 0, 0 };
+		detail::xoshiro_seed(s, seed);
+		for (uint32 lane{ 0 }; lane < 4; ++lane) {
+			for (uint32 word{ 0 }; word < 4; ++word)
+				_state[word][lane] = s[word];
+			detail::xoshiro_apply_jump(s, detail::xoshiro_jump);
+		}
+	}
+
+	Xoshiro256ppx4::result_type Xoshiro256ppx4::operator()() noexcept
+	{
+		uint32 value{ 0 };
+		Fill(&value, 1);
+		return value;
+	}
+
+	void Xoshiro256ppx4::Jump() noexcept
+	{
+		for (uint32 lane{ 0 }; lane < 4; ++lane) {
+			uint64 s[4]{ _state[0][lane], _state[1][lane], _state[2][lane], _state[3][lane] };
+			for (uint32 n{ 0 }; n < 4; ++n)
+				detail::xoshiro_apply_jump(s, detail::xoshiro_jump);
+			for (uint32 word{ 0 }; word < 4; ++word)
+				_state[word][lane] = s[word];
+		}
+	}
+
+	void Xoshiro256ppx4::LongJump() noexcept
+	{
+		for (uint32 lane{ 0 }; lane < 4; ++lane) {
+			uint64 s[4]{ _state[0][lane], _state[1][lane], _state[2][lane], _state[3][lane] };
+			detail::xoshiro_apply_jump(s, detail::xoshiro_long_jump);
+			for (uint32 word{ 0 }; word < 4; ++word)
+				_state[word][lane] = s[word];
+		}
+	}
+
+	void Xoshiro256ppx4::Fill(uint32* out, uint64 count) noexcept
+	{
+#if ECM_SIMD_AVX2
+		__m256i s0{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state[0])) };
+		__m256i s1{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state[1])) };
+		__m256i s2{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state[2])) };
+		__m256i s3{ _mm256_load_si256(reinterpret_cast<__m256i const*>(_state[3])) };
+		for (uint64 i{ 0 }; i < count; i += 8) {
+			const __m256i values{ _mm256_add_epi64(rotl_epi64(_mm256_add_epi64(s0, s3), 23), s0) };
+			const __m256i t{ _mm256_slli_epi64(s1, 17) };
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = rotl_epi64(s3, 45);
+			if (i + 8 <= count) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+			} else {
+				ECM_ALIGN(32) uint32 tail[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(tail), values);
+				for (uint64 j{ 0 }; i + j < count; ++j)
+					out[i + j] = tail[j];
+			}
+		}
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state[0]), s0);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state[1]), s1);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state[2]), s2);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(_state[3]), s3);
+#else
+		// Two halves of two lanes each, which produce the values 0-3 and
+		// 4-7 of every step
+		const uint64 steps{ (count + 7) / 8 };
+		for (uint32 half{ 0 }; half < 2; ++half) {
+			__m128i s0{ _mm_load_si128(reinterpret_cast<__m128i const*>(_state[0] + 2 * half)) };
+			__m128i s1{ _mm_load_si128(reinterpret_cast<__m128i const*>(_state[1] + 2 * half)) };
+			__m128i s2{ _mm_load_si128(reinterpret_cast<__m128i const*>(_state[2] + 2 * half)) };
+			__m128i s3{ _mm_load_si128(reinterpret_cast<__m128i const*>(_state[3] + 2 * half)) };
+			for (uint64 step{ 0 }; step < steps; ++step) {
+				const __m128i values{ _mm_add_epi64(rotl_epi64(_mm_add_epi64(s0, s3), 23), s0) };
+				const __m128i t{ _mm_slli_epi64(s1, 17) };
+				s2 = _mm_xor_si128(s2, s0);
+				s3 = _mm_xor_si128(s3, s1);
+				s1 = _mm_xor_si128(s1, s2);
+				s0 = _mm_xor_si128(s0, s3);
+				s2 = _mm_xor_si128(s2, t);
+				s3 = rotl_epi64(s3, 45);
+				const uint64 i{ 8 * step + 4 * half };
+				if (i + 4 <= count) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), values);
+				} else if (i < count) {
+					ECM_ALIGN(16) uint32 tail[4];
+					_mm_store_si128(reinterpret_cast<__m128i*>(tail), values);
+					for (uint64 j{ 0 }; i + j < count; ++j)
+						out[i + j] = tail[j];
+				}
+			}
+			_mm_store_si128(reinterpret_cast<__m128i*>(_state[0] + 2 * half), s0);
+			_mm_store_si128(reinterpret_cast<__m128i*>(_state[1] + 2 * half), s1);
+			_mm_store_si128(reinterpret_cast<__m128i*>(_state[2] + 2 * half), s2);
+			_mm_store_si128(reinterpret_cast<__m128i*>(_state[3] + 2 * half), s3);
+		}
+#endif // ECM_SIMD_AVX2
+	}
+
+	namespace detail
+	{
+		void fill_uniform(bit_source source, float32* out, uint64 count, float32 min, float32 max)
+		{
+			const float32 scale{ (max - min) * Uint24ToFloat };
+			// Rounding may reach max for wide ranges, which is excluded
+			const float32 limit{ max > min ? std::nextafter(max, min) : max };
+			uint32 bits[BufferSize];
+			for (uint64 i{ 0 }; i < count; i += BufferSize) {
+				const uint32 n{ static_cast<uint32>(count - i < BufferSize ? count - i : BufferSize) };
+				source.fill(source.generator, bits, n);
+				uniform_kernel(bits, out + i, n, scale, min, limit);
+			}
+		}
+
+		void fill_unit_circle(bit_source source, Vector2_Base<float32>* out, uint64 count)
+		{
+			uint32 bits[BufferSize];
+			for (uint64 i{ 0 }; i < count; i += BufferSize) {
+				const uint32 n{ static_cast<uint32>(count - i < BufferSize ? count - i : BufferSize) };
+				source.fill(source.generator, bits, n);
+				for (uint32 j{ 0 }; j < n; ++j) {
+					const float32 phi{ to_unit_float(bits[j]) * TwoPi };
+					out[i + j] = Vector2_Base<float32>(std::cos(phi), std::sin(phi));
+				}
+			}
+		}
+
+		void fill_unit_sphere(bit_source source, Vector3_Base<float32>* out, uint64 count)
+		{
+			// Archimedes: z is uniform in [-1, 1] on the sphere
+			constexpr uint32 Points{ BufferSize / 2 };
+			uint32 bits[BufferSize];
+			for (uint64 i{ 0 }; i < count; i += Points) {
+				const uint32 n{ static_cast<uint32>(count - i < Points ? count - i : Points) };
+				source.fill(source.generator, bits, n * 2);
+				for (uint32 j{ 0 }; j < n; ++j) {
+					const float32 z{ to_unit_float(bits[2 * j]) * 2.f - 1.f };
+					const float32 phi{ to_unit_float(bits[2 * j + 1]) * TwoPi };
+					const float32 r{ std::sqrt(std::fmax(0.f, 1.f - z * z)) };
+					out[i + j] = Vector3_Base<float32>(r * std::cos(phi), r * std::sin(phi), z);
+				}
+			}
+		}
+
+		void fill_normal(bit_source source, float32* out, uint64 count, float32 mean, float32 stddev)
+		{
+			ziggurat_tables const& tables{ get_ziggurat_tables() };
+			bit_reader reader{ source };
+			for (uint64 i{ 0 }; i < count; ++i) {
+				const int32 hz{ static_cast<int32>(reader.Next()) };
+				const uint32 iz{ static_cast<uint32>(hz) & 127u };
+				const float32 x{ magnitude(hz) < tables.k[iz]
+					? static_cast<float32>(hz) * tables.w[iz]
+					: ziggurat_fix(tables, reader, hz, iz) };
+				out[i] = x * stddev + mean;
+			}
+		}
+	} // namespace detail
+} // namespace ecm::math
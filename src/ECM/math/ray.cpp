@@ -0,0 +1,214 @@
+#include <ECM/math/ray.h>
+
+#include "simd_lanes.h"
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The lanes of the rays of a packet. A packet of four rays fills
+		// both halves of an AVX2 register, and a packet of eight rays takes
+		// two SSE2 registers.
+		template<uint32 N>
+		inline vfloat load_rays(float32 const* p)
+		{
+#if ECM_SIMD_AVX2
+			if constexpr (N < LaneCount)
+				return _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(p));
+#endif // ECM_SIMD_AVX2
+			return loadu_ps(p);
+		}
+
+		template<uint32 N>
+		inline void store_rays(float32* p, vfloat v)
+		{
+#if ECM_SIMD_AVX2
+			if constexpr (N < LaneCount) {
+				_mm_storeu_ps(p, _mm256_castps256_ps128(v.v));
+				return;
+			}
+#endif // ECM_SIMD_AVX2
+			storeu_ps(p, v.v);
+		}
+
+		// The distance and the barycentric coordinates of the hits
+		struct packet_hits
+		{
+			vmask hit;
+			vfloat distance;
+			vfloat u;
+			vfloat v;
+		};
+
+		// Runs a kernel, which takes the origins, directions and distances
+		// of the rays of a block, on the blocks of a packet, and writes the
+		// outputs of the rays, which hit
+		template<uint32 N, typename Kernel>
+		uint32 intersect_packet(RayPacket_Base<N> const& rays, float32* distances, float32* u, float32* v,
+			Kernel const& kernel)
+		{
+			constexpr uint32 Block{ N < LaneCount ? N : LaneCount };
+			uint32 mask{ 0 };
+			for (uint32 b{ 0 }; b < N; b += Block) {
+				vfloat origin[3];
+				vfloat direction[3];
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					origin[c] = load_rays<N>(rays.origin[c] + b);
+					direction[c] = load_rays<N>(rays.direction[c] + b);
+				}
+				const vfloat distance{ load_rays<N>(distances + b) };
+				const packet_hits hits{ kernel(origin, direction, distance) };
+				const uint32 bits{ lane_bits(hits.hit) & ((1u << Block) - 1u) };
+				if (bits == 0)
+					continue;
+				mask |= bits << b;
+				store_rays<N>(distances + b, lane_select(hits.hit, hits.distance, distance));
+				if (u)
+					store_rays<N>(u + b, lane_select(hits.hit, hits.u, load_rays<N>(u + b)));
+				if (v)
+					store_rays<N>(v + b, lane_select(hits.hit, hits.v, load_rays<N>(v + b)));
+			}
+			return mask;
+		}
+
+		// The slab test of Intersects
+		packet_hits intersect_box(AABB_Base<float32> const& box, vfloat const (&origin)[3],
+			vfloat const (&direction)[3], vfloat distance)
+		{
+			vfloat entry{ 0.f };
+			vfloat exit{ distance };
+			for (uint8 i{ 0 }; i < 3; ++i) {
+				const vfloat inverse{ vfloat(1.f) / direction[i] };
+				const vfloat t0{ (vfloat(box.min[i]) - origin[i]) * inverse };
+				const vfloat t1{ (vfloat(box.max[i]) - origin[i]) * inverse };
+				const vfloat scale{ detail::slab_exit_scale<float32> };
+				entry = lane_min(lane_max(t0, entry), lane_max(t1, entry));
+				exit = lane_max(lane_min(t0 * scale, exit), lane_min(t1 * scale, exit));
+			}
+			return { entry <= exit, entry, vfloat(0.f), vfloat(0.f) };
+		}
+
+		// The test of Möller and Trumbore of Intersects
+		packet_hits intersect_triangle(Vector3_Base<float32> const& v0, Vector3_Base<float32> const& v1,
+			Vector3_Base<float32> const& v2, vfloat const (&origin)[3], vfloat const (&direction)[3],
+			vfloat distance)
+		{
+			const vfloat edge1[3]{ vfloat(v1.x - v0.x), vfloat(v1.y - v0.y), vfloat(v1.z - v0.z) };
+			const vfloat edge2[3]{ vfloat(v2.x - v0.x), vfloat(v2.y - v0.y), vfloat(v2.z - v0.z) };
+			const vfloat p[3]{
+				direction[1] * edge2[2] - direction[2] * edge2[1],
+				direction[2] * edge2[0] - direction[0] * edge2[2],
+				direction[0] * edge2[1] - direction[1] * edge2[0]
+			};
+			const vfloat determinant{ edge1[0] * p[0] + edge1[1] * p[1] + edge1[2] * p[2] };
+			const vfloat inverse{ vfloat(1.f) / determinant };
+			const vfloat s[3]{ origin[0] - vfloat(v0.x), origin[1] - vfloat(v0.y), origin[2] - vfloat(v0.z) };
+			const vfloat u{ (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse };
+			const vfloat q[3]{
+				s[1] * edge1[2] - s[2] * edge1[1],
+				s[2] * edge1[0] - s[0] * edge1[2],
+				s[0] * edge1[1] - s[1] * edge1[0]
+			};
+			const vfloat v{ (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverse };
+			const vfloat t{ (edge2[0] * q[0] + edge2[1] * q[1] + edge2[2] * q[2]) * inverse };
+			const vmask parallel{ lane_and(determinant <= vfloat(0.f), determinant >= vfloat(0.f)) };
+			vmask hit{ lane_and(lane_not(parallel), lane_and(u >= vfloat(0.f), u <= vfloat(1.f))) };
+			hit = lane_and(hit, lane_and(v >= vfloat(0.f), u + v <= vfloat(1.f)));
+			hit = lane_and(hit, lane_and(t >= vfloat(0.f), t < distance));
+			return { hit, t, u, v };
+		}
+
+		// The test of Intersects
+		packet_hits intersect_sphere(Sphere_Base<float32> const& sphere, vfloat const (&origin)[3],
+			vfloat const (&direction)[3], vfloat distance)
+		{
+			const vfloat f[3]{ origin[0] - vfloat(sphere.center.x), origin[1] - vfloat(sphere.center.y),
+				origin[2] - vfloat(sphere.center.z) };
+			const vfloat a{ direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2] };
+			const vfloat b{ f[0] * direction[0] + f[1] * direction[1] + f[2] * direction[2] };
+			const vfloat radiusSquared{ sphere.radius * sphere.radius };
+			const vfloat c{ f[0] * f[0] + f[1] * f[1] + f[2] * f[2] - radiusSquared };
+			const vfloat s{ b / a };
+			const vfloat l[3]{ f[0] - s * direction[0], f[1] - s * direction[1], f[2] - s * direction[2] };
+			const vfloat discriminant{ a * (radiusSquared - (l[0] * l[0] + l[1] * l[1] + l[2] * l[2])) };
+			const vmask real{ discriminant >= vfloat(0.f) };
+			const vfloat root{ lane_sqrt(lane_select(real, discriminant, vfloat(0.f))) };
+			const vfloat q{ lane_select(b < vfloat(0.f), root - b, -b - root) };
+			const vfloat r0{ c / q };
+			const vfloat r1{ q / a };
+			const vfloat t0{ lane_min(r0, r1) };
+			const vfloat t1{ lane_max(r0, r1) };
+			const vfloat t{ lane_select(t0 >= vfloat(0.f), t0, t1) };
+			return { lane_and(real, lane_and(t >= vfloat(0.f), t < distance)), t, vfloat(0.f), vfloat(0.f) };
+		}
+
+		template<uint32 N>
+		uint32 intersect_box_packet(RayPacket_Base<N> const& rays, AABB_Base<float32> const& box,
+			float32* distances)
+		{
+			return intersect_packet(rays, distances, nullptr, nullptr, [&box](vfloat const (&origin)[3],
+				vfloat const (&direction)[3], vfloat distance) {
+				return intersect_box(box, origin, direction, distance);
+			});
+		}
+
+		template<uint32 N>
+		uint32 intersect_triangle_packet(RayPacket_Base<N> const& rays, Vector3_Base<float32> const& v0,
+			Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2, float32* distances, float32* u,
+			float32* v)
+		{
+			return intersect_packet(rays, distances, u, v, [&](vfloat const (&origin)[3],
+				vfloat const (&direction)[3], vfloat distance) {
+				return intersect_triangle(v0, v1, v2, origin, direction, distance);
+			});
+		}
+
+		template<uint32 N>
+		uint32 intersect_sphere_packet(RayPacket_Base<N> const& rays, Sphere_Base<float32> const& sphere,
+			float32* distances)
+		{
+			return intersect_packet(rays, distances, nullptr, nullptr, [&sphere](vfloat const (&origin)[3],
+				vfloat const (&direction)[3], vfloat distance) {
+				return intersect_sphere(sphere, origin, direction, distance);
+			});
+		}
+	} // anonymous namespace
+
+	uint32 IntersectPacket(RayPacket_Base<4> const& rays, AABB_Base<float32> const& box,
+		float32* distances) noexcept
+	{
+		return intersect_box_packet(rays, box, distances);
+	}
+
+	uint32 IntersectPacket(RayPacket_Base<8> const& rays, AABB_Base<float32> const& box,
+		float32* distances) noexcept
+	{
+		return intersect_box_packet(rays, box, distances);
+	}
+
+	uint32 IntersectPacket(RayPacket_Base<4> const& rays, Vector3_Base<float32> const& v0,
+		Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2, float32* distances, float32* u,
+		float32* v) noexcept
+	{
+		return intersect_triangle_packet(rays, v0, v1, v2, distances, u, v);
+	}
+
+	uint32 IntersectPacket(RayPacket_Base<8> const& rays, Vector3_Base<float32> const& v0,
+		Vector3_Base<float32> const& v1, Vector3_Base<float32> const& v2, float32* distances, float32* u,
+		float32* v) noexcept
+	{
+		return intersect_triangle_packet(rays, v0, v1, v2, distances, u, v);
+	}
+
+	uint32 IntersectPacket(RayPacket_Base<4> const& rays, Sphere_Base<float32> const& sphere,
+		float32* distances) noexcept
+	{
+		return intersect_sphere_packet(rays, sphere, distances);
+	}
+
+	uint32 IntersectPacket(RayPacket_Base<8> const& rays, Sphere_Base<float32> const& sphere,
+		float32* distances) noexcept
+	{
+		return intersect_sphere_packet(rays, sphere, distances);
+	}
+} // namespace ecm::math
@@ -0,0 +1,655 @@
+#include <ECM/math/reduction.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The minimum number of values of a chunk
+		constexpr uint64 ValueGrain{ 16384 };
+		// The maximum number of chunks, whose partial results are merged in
+		// order
+		constexpr uint64 MaxChunks{ 256 };
+		// The minimum number of values of a chunk of Histogram per bin, which
+		// bounds the storage of the partial histograms
+		constexpr uint64 HistogramValuesPerBin{ 16 };
+		// The number of histograms, which a chunk of Histogram fills in turn,
+		// so that equal values don't wait for each other's increment
+		constexpr uint32 HistogramCopies{ 4 };
+
+		static_assert(sizeof(Vector3_Base<float32>) == 3 * sizeof(float32),
+			"The vectors must be packed floats");
+		static_assert(sizeof(Vector4_Base<float32>) == 4 * sizeof(float32),
+			"The vectors must be packed floats");
+
+		// The SIMD registers of float32 and float64, which the kernels use
+		// through the same functions
+		template<typename T>
+		struct lanes;
+
+#if ECM_SIMD_AVX2
+		template<>
+		struct lanes<float32>
+		{
+			typedef __m256 type;
+			static constexpr uint32 count{ 8 };
+			static type set1(float32 f) { return _mm256_set1_ps(f); }
+			static type loadu(float32 const* p) { return _mm256_loadu_ps(p); }
+			static void storeu(float32* p, type a) { _mm256_storeu_ps(p, a); }
+			static type add(type a, type b) { return _mm256_add_ps(a, b); }
+			static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+			static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+			static type min(type a, type b) { return _mm256_min_ps(a, b); }
+			static type max(type a, type b) { return _mm256_max_ps(a, b); }
+			static uint32 equal(type a, type b)
+			{
+				return static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+			}
+		};
+
+		template<>
+		struct lanes<float64>
+		{
+			typedef __m256d type;
+			static constexpr uint32 count{ 4 };
+			static type set1(float64 f) { return _mm256_set1_pd(f); }
+			static type loadu(float64 const* p) { return _mm256_loadu_pd(p); }
+			static void storeu(float64* p, type a) { _mm256_storeu_pd(p, a); }
+			static type add(type a, type b) { return _mm256_add_pd(a, b); }
+			static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+			static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+			static type min(type a, type b) { return _mm256_min_pd(a, b); }
+			static type max(type a, type b) { return _mm256_max_pd(a, b); }
+			static uint32 equal(type a, type b)
+			{
+				return static_cast<uint32>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+			}
+		};
+#elif ECM_SIMD_SSE2
+		template<>
+		struct lanes<float32>
+		{
+			typedef __m128 type;
+			static constexpr uint32 count{ 4 };
+			static type set1(float32 f) { return _mm_set1_ps(f); }
+			static type loadu(float32 const* p) { return _mm_loadu_ps(p); }
+			static void storeu(float32* p, type a) { _mm_storeu_ps(p, a); }
+			static type add(type a, type b) { return _mm_add_ps(a, b); }
+			static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+			static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+			static type min(type a, type b) { return _mm_min_ps(a, b); }
+			static type max(type a, type b) { return _mm_max_ps(a, b); }
+			static uint32 equal(type a, type b) { return static_cast<uint32>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+		};
+
+		template<>
+		struct lanes<float64>
+		{
+			typedef __m128d type;
+			static constexpr uint32 count{ 2 };
+			static type set1(float64 f) { return _mm_set1_pd(f); }
+			static type loadu(float64 const* p) { return _mm_loadu_pd(p); }
+			static void storeu(float64* p, type a) { _mm_storeu_pd(p, a); }
+			static type add(type a, type b) { return _mm_add_pd(a, b); }
+			static type sub(type a, type b) { return _mm_sub_pd(a, b); }
+			static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+			static type min(type a, type b) { return _mm_min_pd(a, b); }
+			static type max(type a, type b) { return _mm_max_pd(a, b); }
+			static uint32 equal(type a, type b) { return static_cast<uint32>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+		};
+#else
+		template<typename T>
+		struct lanes
+		{
+			typedef T type;
+			static constexpr uint32 count{ 1 };
+			static type set1(T f) { return f; }
+			static type loadu(T const* p) { return *p; }
+			static void storeu(T* p, type a) { *p = a; }
+			static type add(type a, type b) { return a + b; }
+			static type sub(type a, type b) { return a - b; }
+			static type mul(type a, type b) { return a * b; }
+			static type min(type a, type b) { return a < b ? a : b; }
+			static type max(type a, type b) { return a > b ? a : b; }
+			static uint32 equal(type a, type b) { return a == b ? 1u : 0u; }
+		};
+#endif // ECM_SIMD_AVX2
+
+		// The number of registers, which the kernels of vectors with N
+		// components fill in turn. A step over all of them is a multiple of N,
+		// so that each lane always holds the same component.
+		template<uint32 N>
+		constexpr uint32 register_count{ N == 3 ? 6 : 4 };
+
+		// Adds x to the sum s and the rounding error of the addition to the
+		// compensation c with the TwoSum of Knuth
+		template<typename L>
+		inline void two_sum(typename L::type& s, typename L::type& c, typename L::type x)
+		{
+			const typename L::type t{ L::add(s, x) };
+			const typename L::type z{ L::sub(t, s) };
+			c = L::add(c, L::add(L::sub(s, L::sub(t, z)), L::sub(x, z)));
+			s = t;
+		}
+
+		// The sums of the components of a chunk
+		template<typename T, uint32 N>
+		struct partial_sum
+		{
+			T sum[N];
+			T compensation[N];
+		};
+
+		// Adds the terms of the values [0, count) of a chunk of vectors with N
+		// components. The term object returns the terms of L::count values
+		// for a register and of single values.
+		template<typename T, uint32 N, bool Compensated, typename Term>
+		partial_sum<T, N> accumulate(uint64 count, Term const& term)
+		{
+			typedef lanes<T> L;
+			typedef typename L::type V;
+			constexpr uint32 registers{ register_count<N> };
+			constexpr uint32 step{ registers * L::count };
+			V sums[registers];
+			V compensations[registers];
+			for (uint32 r{ 0 }; r < registers; ++r)
+				sums[r] = compensations[r] = L::set1(T(0));
+			uint64 i{ 0 };
+			for (; i + step <= count; i += step) {
+				for (uint32 r{ 0 }; r < registers; ++r) {
+					const V x{ term(i + r * L::count, r) };
+					if constexpr (Compensated)
+						two_sum<L>(sums[r], compensations[r], x);
+					else
+						sums[r] = L::add(sums[r], x);
+				}
+			}
+
+			partial_sum<T, N> result{};
+			ECM_ALIGN(64) T lanesSum[step];
+			ECM_ALIGN(64) T lanesCompensation[step];
+			for (uint32 r{ 0 }; r < registers; ++r) {
+				L::storeu(lanesSum + r * L::count, sums[r]);
+				L::storeu(lanesCompensation + r * L::count, compensations[r]);
+			}
+			auto add = [&result](uint32 component, T x) {
+				if constexpr (Compensated) {
+					const T t{ result.sum[component] + x };
+					const T z{ t - result.sum[component] };
+					result.compensation[component] += (result.sum[component] - (t - z)) + (x - z);
+					result.sum[component] = t;
+				} else {
+					result.sum[component] += x;
+				}
+			};
+			for (uint32 j{ 0 }; j < step; ++j) {
+				add(j % N, lanesSum[j]);
+				result.compensation[j % N] += lanesCompensation[j];
+			}
+			for (; i < count; ++i)
+				add(static_cast<uint32>(i % N), term(i));
+			return result;
+		}
+
+		// Splits count items into at most MaxChunks chunks, which only
+		// depend on count
+		inline uint64 chunk_size(uint64 count, uint64 grain) noexcept
+		{
+			return std::max(grain, (count + MaxChunks - 1) / MaxChunks);
+		}
+
+		// Computes the partial result of each chunk of count items on the
+		// threads, and returns the number of chunks
+		template<typename R, typename Function>
+		uint64 reduce_chunks(uint64 count, R* partial, Function&& function)
+		{
+			const uint64 chunk{ chunk_size(count, ValueGrain) };
+			const uint64 chunkCount{ (count + chunk - 1) / chunk };
+			if (chunkCount <= 1) {
+				partial[0] = function(0, count);
+				return 1;
+			}
+			ParallelFor(0, chunkCount, 1, [&](uint64 begin, uint64 end) {
+				for (uint64 c{ begin }; c < end; ++c)
+					partial[c] = function(c * chunk, std::min(count, (c + 1) * chunk));
+			});
+			return chunkCount;
+		}
+
+		// Adds the terms of count vectors with N components on the threads
+		// and merges the sums of the chunks in order
+		template<typename T, uint32 N, typename Term>
+		void sum_terms(uint64 count, Summation summation, Term const& term, T* result)
+		{
+			partial_sum<T, N> partial[MaxChunks];
+			const bool compensated{ summation == Summation::COMPENSATED };
+			const uint64 chunkCount{ reduce_chunks(count, partial, [&](uint64 begin, uint64 end) {
+				const Term chunkTerm{ term.offset(begin * N) };
+				return compensated ? accumulate<T, N, true>((end - begin) * N, chunkTerm)
+					: accumulate<T, N, false>((end - begin) * N, chunkTerm);
+			}) };
+			for (uint32 component{ 0 }; component < N; ++component) {
+				T sum{ 0 }, compensation{ 0 };
+				for (uint64 c{ 0 }; c < chunkCount; ++c) {
+					const T x{ partial[c].sum[component] };
+					const T t{ sum + x };
+					if (compensated) {
+						const T z{ t - sum };
+						compensation += (sum - (t - z)) + (x - z) + partial[c].compensation[component];
+					}
+					sum = t;
+				}
+				result[component] = sum + compensation;
+			}
+		}
+
+		// The terms of Sum
+		template<typename T>
+		struct value_term
+		{
+			value_term offset(uint64 i) const { return { values + i }; }
+			typename lanes<T>::type operator()(uint64 i, uint32) const { return lanes<T>::loadu(values + i); }
+			T operator()(uint64 i) const { return values[i]; }
+
+			T const* values;
+		};
+
+		// The terms of Dot
+		template<typename T>
+		struct product_term
+		{
+			product_term offset(uint64 i) const { return { a + i, b + i }; }
+			typename lanes<T>::type operator()(uint64 i, uint32) const
+			{
+				return lanes<T>::mul(lanes<T>::loadu(a + i), lanes<T>::loadu(b + i));
+			}
+			T operator()(uint64 i) const { return a[i] * b[i]; }
+
+			T const* a;
+			T const* b;
+		};
+
+		// The terms of Variance, the squared deviations from the mean of
+		// each component
+		template<typename T, uint32 N>
+		struct deviation_term
+		{
+			typedef lanes<T> L;
+
+			deviation_term(T const* values, T const* mean) : values{ values }
+			{
+				for (uint32 c{ 0 }; c < N; ++c)
+					this->mean[c] = mean[c];
+				// The registers hold the components (r * L::count + j) % N
+				for (uint32 r{ 0 }; r < register_count<N>; ++r) {
+					ECM_ALIGN(64) T pattern[L::count];
+					for (uint32 j{ 0 }; j < L::count; ++j)
+						pattern[j] = mean[(r * L::count + j) % N];
+					means[r] = L::loadu(pattern);
+				}
+			}
+			deviation_term offset(uint64 i) const
+			{
+				deviation_term result{ *this };
+				result.values += i;
+				return result;
+			}
+			typename L::type operator()(uint64 i, uint32 r) const
+			{
+				const typename L::type d{ L::sub(L::loadu(values + i), means[r]) };
+				return L::mul(d, d);
+			}
+			T operator()(uint64 i) const
+			{
+				const T d{ values[i] - mean[i % N] };
+				return d * d;
+			}
+
+			T const* values;
+			T mean[N];
+			typename L::type means[register_count<N>];
+		};
+
+		template<typename T, uint32 N>
+		void sum(T const* values, uint64 count, Summation summation, T* result)
+		{
+			sum_terms<T, N>(count, summation, value_term<T>{ values }, result);
+		}
+
+		template<typename T, uint32 N>
+		void mean(T const* values, uint64 count, Summation summation, T* result)
+		{
+			sum<T, N>(values, count, summation, result);
+			for (uint32 c{ 0 }; c < N; ++c)
+				result[c] = count != 0 ? result[c] / static_cast<T>(count) : T(0);
+		}
+
+		template<typename T, uint32 N>
+		void variance(T const* values, uint64 count, Summation summation, T* result)
+		{
+			T means[N];
+			mean<T, N>(values, count, summation, means);
+			sum_terms<T, N>(count, summation, deviation_term<T, N>{ values, means }, result);
+			for (uint32 c{ 0 }; c < N; ++c)
+				result[c] = count != 0 ? result[c] / static_cast<T>(count) : T(0);
+		}
+
+		// The ranges of the components of a chunk
+		template<typename T, uint32 N>
+		struct partial_range
+		{
+			T min[N];
+			T max[N];
+		};
+
+		template<typename T, uint32 N>
+		partial_range<T, N> range_chunk(T const* values, uint64 count)
+		{
+			typedef lanes<T> L;
+			typedef typename L::type V;
+			constexpr uint32 registers{ register_count<N> };
+			constexpr uint32 step{ registers * L::count };
+			partial_range<T, N> result;
+			std::fill(result.min, result.min + N, std::numeric_limits<T>::infinity());
+			std::fill(result.max, result.max + N, -std::numeric_limits<T>::infinity());
+			uint64 i{ 0 };
+			if (count >= step) {
+				V mins[registers];
+				V maxs[registers];
+				for (uint32 r{ 0 }; r < registers; ++r)
+					mins[r] = maxs[r] = L::loadu(values + r * L::count);
+				for (i = step; i + step <= count; i += step) {
+					for (uint32 r{ 0 }; r < registers; ++r) {
+						const V v{ L::loadu(values + i + r * L::count) };
+						mins[r] = L::min(mins[r], v);
+						maxs[r] = L::max(maxs[r], v);
+					}
+				}
+				ECM_ALIGN(64) T lanesMin[step];
+				ECM_ALIGN(64) T lanesMax[step];
+				for (uint32 r{ 0 }; r < registers; ++r) {
+					L::storeu(lanesMin + r * L::count, mins[r]);
+					L::storeu(lanesMax + r * L::count, maxs[r]);
+				}
+				for (uint32 j{ 0 }; j < step; ++j) {
+					result.min[j % N] = std::min(result.min[j % N], lanesMin[j]);
+					result.max[j % N] = std::max(result.max[j % N], lanesMax[j]);
+				}
+			}
+			for (; i < count; ++i) {
+				result.min[i % N] = std::min(result.min[i % N], values[i]);
+				result.max[i % N] = std::max(result.max[i % N], values[i]);
+			}
+			return result;
+		}
+
+		template<typename T, uint32 N>
+		void min_max(T const* values, uint64 count, T* min, T* max)
+		{
+			partial_range<T, N> partial[MaxChunks];
+			const uint64 chunkCount{ reduce_chunks(count, partial, [values](uint64 begin, uint64 end) {
+				return range_chunk<T, N>(values + begin * N, (end - begin) * N);
+			}) };
+			for (uint32 component{ 0 }; component < N; ++component) {
+				min[component] = partial[0].min[component];
+				max[component] = partial[0].max[component];
+				for (uint64 c{ 1 }; c < chunkCount; ++c) {
+					min[component] = std::min(min[component], partial[c].min[component]);
+					max[component] = std::max(max[component], partial[c].max[component]);
+				}
+			}
+		}
+
+		// The greatest value of a chunk and its first index
+		template<typename T>
+		struct partial_maximum
+		{
+			T value;
+			uint64 index;
+		};
+
+		// Finds the greatest value of a chunk, which stays in the cache, and
+		// searches its first index in a second pass
+		template<typename T>
+		partial_maximum<T> maximum_chunk(T const* values, uint64 begin, uint64 end)
+		{
+			typedef lanes<T> L;
+			T const* chunk{ values + begin };
+			const uint64 count{ end - begin };
+			const T value{ range_chunk<T, 1>(chunk, count).max[0] };
+			const typename L::type target{ L::set1(value) };
+			uint64 i{ 0 };
+			for (; i + L::count <= count; i += L::count) {
+				const uint32 mask{ L::equal(L::loadu(chunk + i), target) };
+				if (mask != 0) {
+					uint32 lane{ 0 };
+					while ((mask & (1u << lane)) == 0)
+						++lane;
+					return { value, begin + i + lane };
+				}
+			}
+			for (; i < count && chunk[i] != value; ++i) {}
+			// Only NaN leaves the value unfound
+			return { value, i < count ? begin + i : begin };
+		}
+
+		template<typename T>
+		uint64 arg_max(T const* values, uint64 count)
+		{
+			if (count == 0)
+				return 0;
+			partial_maximum<T> partial[MaxChunks];
+			const uint64 chunkCount{ reduce_chunks(count, partial, [values](uint64 begin, uint64 end) {
+				return maximum_chunk(values, begin, end);
+			}) };
+			partial_maximum<T> result{ partial[0] };
+			for (uint64 c{ 1 }; c < chunkCount; ++c) {
+				if (partial[c].value > result.value)
+					result = partial[c];
+			}
+			return result.index;
+		}
+
+		// Counts the values of a chunk into the copies of its histogram
+		template<typename T>
+		void histogram_chunk(T const* values, uint64 count, T min, T max, T scale, uint32 binCount, uint64* copies)
+		{
+			auto count_value = [=](uint32 copy, T value) {
+				if (value >= min && value <= max) {
+					const uint32 bin{ std::min(static_cast<uint32>((value - min) * scale), binCount - 1) };
+					++copies[copy * binCount + bin];
+				}
+			};
+			uint64 i{ 0 };
+			for (; i + HistogramCopies <= count; i += HistogramCopies) {
+				for (uint32 copy{ 0 }; copy < HistogramCopies; ++copy)
+					count_value(copy, values[i + copy]);
+			}
+			for (; i < count; ++i)
+				count_value(0, values[i]);
+		}
+
+		template<typename T>
+		void histogram(T const* values, uint64 count, T min, T max, uint32 binCount, uint64* bins)
+		{
+			std::fill(bins, bins + binCount, uint64{ 0 });
+			if (binCount == 0 || !(max > min) || count == 0)
+				return;
+			const T scale{ static_cast<T>(binCount) / (max - min) };
+			const uint64 chunk{ chunk_size(count, std::max(ValueGrain, binCount * HistogramValuesPerBin)) };
+			const uint64 chunkCount{ (count + chunk - 1) / chunk };
+			std::vector<uint64> partial(chunkCount * binCount);
+			ParallelFor(0, chunkCount, 1, [&](uint64 begin, uint64 end) {
+				std::vector<uint64> copies(static_cast<uint64>(HistogramCopies) * binCount);
+				for (uint64 c{ begin }; c < end; ++c) {
+					std::fill(copies.begin(), copies.end(), uint64{ 0 });
+					const uint64 first{ c * chunk };
+					histogram_chunk(values + first, std::min(count, first + chunk) - first, min, max, scale,
+						binCount, copies.data());
+					uint64* chunkBins{ partial.data() + c * binCount };
+					for (uint32 bin{ 0 }; bin < binCount; ++bin) {
+						uint64 sum{ 0 };
+						for (uint32 copy{ 0 }; copy < HistogramCopies; ++copy)
+							sum += copies[copy * binCount + bin];
+						chunkBins[bin] = sum;
+					}
+				}
+			});
+			for (uint64 c{ 0 }; c < chunkCount; ++c) {
+				for (uint32 bin{ 0 }; bin < binCount; ++bin)
+					bins[bin] += partial[c * binCount + bin];
+			}
+		}
+	} // anonymous namespace
+
+	float32 Sum(float32 const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result;
+		sum<float32, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	float64 Sum(float64 const* values, uint64 count, Summation summation) noexcept
+	{
+		float64 result;
+		sum<float64, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	Vector3_Base<float32> Sum(Vector3_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[3];
+		sum<float32, 3>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2] };
+	}
+
+	Vector4_Base<float32> Sum(Vector4_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[4];
+		sum<float32, 4>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2], result[3] };
+	}
+
+	float32 Dot(float32 const* a, float32 const* b, uint64 count, Summation summation) noexcept
+	{
+		float32 result;
+		sum_terms<float32, 1>(count, summation, product_term<float32>{ a, b }, &result);
+		return result;
+	}
+
+	float64 Dot(float64 const* a, float64 const* b, uint64 count, Summation summation) noexcept
+	{
+		float64 result;
+		sum_terms<float64, 1>(count, summation, product_term<float64>{ a, b }, &result);
+		return result;
+	}
+
+	float32 Mean(float32 const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result;
+		mean<float32, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	float64 Mean(float64 const* values, uint64 count, Summation summation) noexcept
+	{
+		float64 result;
+		mean<float64, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	Vector3_Base<float32> Mean(Vector3_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[3];
+		mean<float32, 3>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2] };
+	}
+
+	Vector4_Base<float32> Mean(Vector4_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[4];
+		mean<float32, 4>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2], result[3] };
+	}
+
+	float32 Variance(float32 const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result;
+		variance<float32, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	float64 Variance(float64 const* values, uint64 count, Summation summation) noexcept
+	{
+		float64 result;
+		variance<float64, 1>(values, count, summation, &result);
+		return result;
+	}
+
+	Vector3_Base<float32> Variance(Vector3_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[3];
+		variance<float32, 3>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2] };
+	}
+
+	Vector4_Base<float32> Variance(Vector4_Base<float32> const* values, uint64 count, Summation summation) noexcept
+	{
+		float32 result[4];
+		variance<float32, 4>(reinterpret_cast<float32 const*>(values), count, summation, result);
+		return { result[0], result[1], result[2], result[3] };
+	}
+
+	void MinMax(float32 const* values, uint64 count, float32& min, float32& max) noexcept
+	{
+		min_max<float32, 1>(values, count, &min, &max);
+	}
+
+	void MinMax(float64 const* values, uint64 count, float64& min, float64& max) noexcept
+	{
+		min_max<float64, 1>(values, count, &min, &max);
+	}
+
+	void MinMax(Vector3_Base<float32> const* values, uint64 count, Vector3_Base<float32>& min,
+		Vector3_Base<float32>& max) noexcept
+	{
+		float32 mins[3], maxs[3];
+		min_max<float32, 3>(reinterpret_cast<float32 const*>(values), count, mins, maxs);
+		min = { mins[0], mins[1], mins[2] };
+		max = { maxs[0], maxs[1], maxs[2] };
+	}
+
+	void MinMax(Vector4_Base<float32> const* values, uint64 count, Vector4_Base<float32>& min,
+		Vector4_Base<float32>& max) noexcept
+	{
+		float32 mins[4], maxs[4];
+		min_max<float32, 4>(reinterpret_cast<float32 const*>(values), count, mins, maxs);
+		min = { mins[0], mins[1], mins[2], mins[3] };
+		max = { maxs[0], maxs[1], maxs[2], maxs[3] };
+	}
+
+	uint64 ArgMax(float32 const* values, uint64 count) noexcept
+	{
+		return arg_max(values, count);
+	}
+
+	uint64 ArgMax(float64 const* values, uint64 count) noexcept
+	{
+		return arg_max(values, count);
+	}
+
+	void Histogram(float32 const* values, uint64 count, float32 min, float32 max, uint32 binCount, uint64* bins)
+	{
+		histogram(values, count, min, max, binCount, bins);
+	}
+
+	void Histogram(float64 const* values, uint64 count, float64 min, float64 max, uint32 binCount, uint64* bins)
+	{
+		histogram(values, count, min, max, binCount, bins);
+	}
+} // namespace ecm::math
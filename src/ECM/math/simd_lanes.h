@@ -0,0 +1,249 @@
+/*
+ * \file simd_lanes.h
+ *
+ * \brief This private header defines the lanes of the batch kernels.
+ */
+
+#pragma once
+#ifndef _ECM_SIMD_LANES_H_
+#define _ECM_SIMD_LANES_H_
+
+#include <ECM/ECM_stdtypes.h>
+#include <ECM/math/functions_simd.h>
+
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The kernels are templates over a float type F and an integer type
+		// I, whose comparisons give masks. The scalar types are float32,
+		// uint32 and bool, the SIMD types are vfloat, vint and vmask. Integer
+		// lanes wrap around like uint32.
+
+#if ECM_SIMD_AVX2
+		constexpr uint32 LaneCount{ 8 };
+		typedef __m256 native_float;
+		typedef __m256i native_int;
+
+		inline native_float set1_ps(float32 f) { return _mm256_set1_ps(f); }
+		inline native_int set1_epi32(uint32 u) { return _mm256_set1_epi32(static_cast<int32>(u)); }
+		inline native_float add_ps(native_float a, native_float b) { return _mm256_add_ps(a, b); }
+		inline native_float sub_ps(native_float a, native_float b) { return _mm256_sub_ps(a, b); }
+		inline native_float mul_ps(native_float a, native_float b) { return _mm256_mul_ps(a, b); }
+		inline native_float div_ps(native_float a, native_float b) { return _mm256_div_ps(a, b); }
+		inline native_float min_ps(native_float a, native_float b) { return _mm256_min_ps(a, b); }
+		inline native_float max_ps(native_float a, native_float b) { return _mm256_max_ps(a, b); }
+		inline native_float sqrt_ps(native_float a) { return _mm256_sqrt_ps(a); }
+		inline native_float and_ps(native_float a, native_float b) { return _mm256_and_ps(a, b); }
+		inline native_float or_ps(native_float a, native_float b) { return _mm256_or_ps(a, b); }
+		inline native_float xor_ps(native_float a, native_float b) { return _mm256_xor_ps(a, b); }
+		inline native_float andnot_ps(native_float a, native_float b) { return _mm256_andnot_ps(a, b); }
+		inline native_float select_ps(native_float m, native_float a, native_float b) { return _mm256_blendv_ps(b, a, m); }
+		inline native_float cmplt_ps(native_float a, native_float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline native_float cmple_ps(native_float a, native_float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		inline uint32 movemask_ps(native_float a) { return static_cast<uint32>(_mm256_movemask_ps(a)); }
+		inline native_float floor_ps(native_float a) { return _mm256_floor_ps(a); }
+		inline native_int cvttps_epi32(native_float a) { return _mm256_cvttps_epi32(a); }
+		inline native_int cvtps_epi32(native_float a) { return _mm256_cvtps_epi32(a); }
+		inline native_float cvtepi32_ps(native_int a) { return _mm256_cvtepi32_ps(a); }
+		inline native_float castsi_ps(native_int a) { return _mm256_castsi256_ps(a); }
+		inline native_int add_epi32(native_int a, native_int b) { return _mm256_add_epi32(a, b); }
+		inline native_int sub_epi32(native_int a, native_int b) { return _mm256_sub_epi32(a, b); }
+		inline native_int mullo_epi32(native_int a, native_int b) { return _mm256_mullo_epi32(a, b); }
+		inline native_int and_epi32(native_int a, native_int b) { return _mm256_and_si256(a, b); }
+		inline native_int or_epi32(native_int a, native_int b) { return _mm256_or_si256(a, b); }
+		inline native_int xor_epi32(native_int a, native_int b) { return _mm256_xor_si256(a, b); }
+		inline native_int slli_epi32(native_int a, int32 n) { return _mm256_slli_epi32(a, n); }
+		inline native_int srli_epi32(native_int a, int32 n) { return _mm256_srli_epi32(a, n); }
+		inline native_int cmpeq_epi32(native_int a, native_int b) { return _mm256_cmpeq_epi32(a, b); }
+		inline native_int select_epi32(native_float m, native_int a, native_int b)
+		{
+			return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), m));
+		}
+		inline native_float load_ps(float32 const* p) { return _mm256_load_ps(p); }
+		inline void store_ps(float32* p, native_float a) { _mm256_store_ps(p, a); }
+		inline native_float loadu_ps(float32 const* p) { return _mm256_loadu_ps(p); }
+		inline void storeu_ps(float32* p, native_float a) { _mm256_storeu_ps(p, a); }
+		inline void load3_ps(float32 const* p, native_float& x, native_float& y, native_float& z)
+		{
+			// The low halves hold the first four vectors, the high halves the
+			// last four, and the shuffles transpose both at once
+			const __m256 v0{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1) };
+			const __m256 v1{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1) };
+			const __m256 v2{ _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1) };
+			const __m256 a{ _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)) };
+			const __m256 b{ _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)) };
+			x = _mm256_shuffle_ps(v0, a, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm256_shuffle_ps(b, a, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm256_shuffle_ps(b, v2, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+#else
+		constexpr uint32 LaneCount{ 4 };
+		typedef __m128 native_float;
+		typedef __m128i native_int;
+
+		inline native_float set1_ps(float32 f) { return _mm_set1_ps(f); }
+		inline native_int set1_epi32(uint32 u) { return _mm_set1_epi32(static_cast<int32>(u)); }
+		inline native_float add_ps(native_float a, native_float b) { return _mm_add_ps(a, b); }
+		inline native_float sub_ps(native_float a, native_float b) { return _mm_sub_ps(a, b); }
+		inline native_float mul_ps(native_float a, native_float b) { return _mm_mul_ps(a, b); }
+		inline native_float div_ps(native_float a, native_float b) { return _mm_div_ps(a, b); }
+		inline native_float min_ps(native_float a, native_float b) { return _mm_min_ps(a, b); }
+		inline native_float max_ps(native_float a, native_float b) { return _mm_max_ps(a, b); }
+		inline native_float sqrt_ps(native_float a) { return _mm_sqrt_ps(a); }
+		inline native_float and_ps(native_float a, native_float b) { return _mm_and_ps(a, b); }
+		inline native_float or_ps(native_float a, native_float b) { return _mm_or_ps(a, b); }
+		inline native_float xor_ps(native_float a, native_float b) { return _mm_xor_ps(a, b); }
+		inline native_float andnot_ps(native_float a, native_float b) { return _mm_andnot_ps(a, b); }
+		inline native_float select_ps(native_float m, native_float a, native_float b)
+		{
+#if ECM_SIMD_SSE41
+			return _mm_blendv_ps(b, a, m);
+#else
+			return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#endif // ECM_SIMD_SSE41
+		}
+		inline native_float cmplt_ps(native_float a, native_float b) { return _mm_cmplt_ps(a, b); }
+		inline native_float cmple_ps(native_float a, native_float b) { return _mm_cmple_ps(a, b); }
+		inline uint32 movemask_ps(native_float a) { return static_cast<uint32>(_mm_movemask_ps(a)); }
+		inline native_float floor_ps(native_float a)
+		{
+#if ECM_SIMD_SSE41
+			return _mm_floor_ps(a);
+#else
+			const native_float t{ _mm_cvtepi32_ps(_mm_cvttps_epi32(a)) };
+			return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.f)));
+#endif // ECM_SIMD_SSE41
+		}
+		inline native_int cvttps_epi32(native_float a) { return _mm_cvttps_epi32(a); }
+		inline native_int cvtps_epi32(native_float a) { return _mm_cvtps_epi32(a); }
+		inline native_float cvtepi32_ps(native_int a) { return _mm_cvtepi32_ps(a); }
+		inline native_float castsi_ps(native_int a) { return _mm_castsi128_ps(a); }
+		inline native_int add_epi32(native_int a, native_int b) { return _mm_add_epi32(a, b); }
+		inline native_int sub_epi32(native_int a, native_int b) { return _mm_sub_epi32(a, b); }
+		inline native_int mullo_epi32(native_int a, native_int b) { return MulLo(a, b); }
+		inline native_int and_epi32(native_int a, native_int b) { return _mm_and_si128(a, b); }
+		inline native_int or_epi32(native_int a, native_int b) { return _mm_or_si128(a, b); }
+		inline native_int xor_epi32(native_int a, native_int b) { return _mm_xor_si128(a, b); }
+		inline native_int slli_epi32(native_int a, int32 n) { return _mm_slli_epi32(a, n); }
+		inline native_int srli_epi32(native_int a, int32 n) { return _mm_srli_epi32(a, n); }
+		inline native_int cmpeq_epi32(native_int a, native_int b) { return _mm_cmpeq_epi32(a, b); }
+		inline native_int select_epi32(native_float m, native_int a, native_int b)
+		{
+			return _mm_castps_si128(select_ps(m, _mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+		}
+		inline native_float load_ps(float32 const* p) { return _mm_load_ps(p); }
+		inline void store_ps(float32* p, native_float a) { _mm_store_ps(p, a); }
+		inline native_float loadu_ps(float32 const* p) { return _mm_loadu_ps(p); }
+		inline void storeu_ps(float32* p, native_float a) { _mm_storeu_ps(p, a); }
+		inline void load3_ps(float32 const* p, native_float& x, native_float& y, native_float& z)
+		{
+			const __m128 v0{ _mm_loadu_ps(p) };     // x0 y0 z0 x1
+			const __m128 v1{ _mm_loadu_ps(p + 4) }; // y1 z1 x2 y2
+			const __m128 v2{ _mm_loadu_ps(p + 8) }; // z2 x3 y3 z3
+			const __m128 a{ _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2)) }; // x2 y2 x3 y3
+			const __m128 b{ _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1)) }; // y0 z0 y1 z1
+			x = _mm_shuffle_ps(v0, a, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(b, a, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm_shuffle_ps(b, v2, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+#endif // ECM_SIMD_AVX2
+
+		struct vmask
+		{
+			native_float v;
+		};
+
+		inline vmask lane_and(vmask a, vmask b) { return { and_ps(a.v, b.v) }; }
+		inline vmask lane_or(vmask a, vmask b) { return { or_ps(a.v, b.v) }; }
+		inline vmask lane_not(vmask a) { return { xor_ps(a.v, castsi_ps(set1_epi32(0xffffffffu))) }; }
+		inline uint32 lane_bits(vmask a) { return movemask_ps(a.v); }
+
+		// The constructors only take float32 and uint32, so that mixed
+		// expressions with literals are not ambiguous.
+		struct vfloat
+		{
+			native_float v;
+
+			vfloat() = default;
+			vfloat(native_float v) : v(v) {}
+			template<typename T, std::enable_if_t<std::is_same_v<T, float32>, int> = 0>
+			vfloat(T f) : v(set1_ps(f)) {}
+		};
+
+		struct vint
+		{
+			native_int v;
+
+			vint() = default;
+			vint(native_int v) : v(v) {}
+			template<typename T, std::enable_if_t<std::is_same_v<T, uint32>, int> = 0>
+			vint(T u) : v(set1_epi32(u)) {}
+		};
+
+		inline vfloat operator+(vfloat a, vfloat b) { return add_ps(a.v, b.v); }
+		inline vfloat operator-(vfloat a, vfloat b) { return sub_ps(a.v, b.v); }
+		inline vfloat operator*(vfloat a, vfloat b) { return mul_ps(a.v, b.v); }
+		inline vfloat operator/(vfloat a, vfloat b) { return div_ps(a.v, b.v); }
+		inline vfloat operator-(vfloat a) { return xor_ps(a.v, set1_ps(-0.f)); }
+		inline vmask operator<(vfloat a, vfloat b) { return { cmplt_ps(a.v, b.v) }; }
+		inline vmask operator>(vfloat a, vfloat b) { return { cmplt_ps(b.v, a.v) }; }
+		inline vmask operator<=(vfloat a, vfloat b) { return { cmple_ps(a.v, b.v) }; }
+		inline vmask operator>=(vfloat a, vfloat b) { return { cmple_ps(b.v, a.v) }; }
+
+		inline vint operator+(vint a, vint b) { return add_epi32(a.v, b.v); }
+		inline vint operator-(vint a, vint b) { return sub_epi32(a.v, b.v); }
+		inline vint operator*(vint a, vint b) { return mullo_epi32(a.v, b.v); }
+		inline vint operator&(vint a, vint b) { return and_epi32(a.v, b.v); }
+		inline vint operator|(vint a, vint b) { return or_epi32(a.v, b.v); }
+		inline vint operator^(vint a, vint b) { return xor_epi32(a.v, b.v); }
+		inline vint operator<<(vint a, int32 n) { return slli_epi32(a.v, n); }
+		inline vint operator>>(vint a, int32 n) { return srli_epi32(a.v, n); }
+		inline vmask operator==(vint a, vint b) { return { castsi_ps(cmpeq_epi32(a.v, b.v)) }; }
+
+		inline vfloat lane_select(vmask m, vfloat a, vfloat b) { return select_ps(m.v, a.v, b.v); }
+		inline vint lane_select(vmask m, vint a, vint b) { return select_epi32(m.v, a.v, b.v); }
+		inline vfloat lane_floor(vfloat a) { return floor_ps(a.v); }
+		inline vint lane_to_int(vfloat a) { return cvttps_epi32(a.v); }
+		inline vint lane_round(vfloat a) { return cvtps_epi32(a.v); }
+		inline vfloat lane_to_float(vint a) { return cvtepi32_ps(a.v); }
+		inline vfloat lane_as_float(vint a) { return castsi_ps(a.v); }
+		inline vfloat lane_abs(vfloat a) { return andnot_ps(set1_ps(-0.f), a.v); }
+		inline vfloat lane_sqrt(vfloat a) { return sqrt_ps(a.v); }
+		inline vfloat lane_min(vfloat a, vfloat b) { return min_ps(a.v, b.v); }
+		inline vfloat lane_max(vfloat a, vfloat b) { return max_ps(a.v, b.v); }
+		inline vfloat lane_clamp(vfloat a) { return max_ps(min_ps(a.v, set1_ps(1.f)), set1_ps(-1.f)); }
+		inline vmask lane_test(vint a, uint32 bits) { return lane_not((a & vint(bits)) == vint(0u)); }
+
+		// Loads LaneCount packed Vector3 and transposes them into one lane
+		// per component.
+		inline void lane_load3(float32 const* p, vfloat& x, vfloat& y, vfloat& z)
+		{
+			load3_ps(p, x.v, y.v, z.v);
+		}
+
+		inline bool lane_and(bool a, bool b) { return a && b; }
+		inline bool lane_or(bool a, bool b) { return a || b; }
+		inline bool lane_not(bool a) { return !a; }
+		inline uint32 lane_bits(bool a) { return a ? 1u : 0u; }
+		inline float32 lane_select(bool m, float32 a, float32 b) { return m ? a : b; }
+		inline uint32 lane_select(bool m, uint32 a, uint32 b) { return m ? a : b; }
+		inline float32 lane_floor(float32 a) { return std::floor(a); }
+		inline uint32 lane_to_int(float32 a) { return static_cast<uint32>(static_cast<int32>(a)); }
+		inline uint32 lane_round(float32 a) { return static_cast<uint32>(static_cast<int32>(std::nearbyint(a))); }
+		inline float32 lane_to_float(uint32 a) { return static_cast<float32>(static_cast<int32>(a)); }
+		inline float32 lane_as_float(uint32 a) { float32 f; std::memcpy(&f, &a, sizeof(f)); return f; }
+		inline float32 lane_abs(float32 a) { return std::fabs(a); }
+		inline float32 lane_sqrt(float32 a) { return std::sqrt(a); }
+		inline float32 lane_min(float32 a, float32 b) { return a < b ? a : b; }
+		inline float32 lane_max(float32 a, float32 b) { return a > b ? a : b; }
+		inline float32 lane_clamp(float32 a) { return a < 1.f ? (a > -1.f ? a : -1.f) : 1.f; }
+		inline bool lane_test(uint32 a, uint32 bits) { return (a & bits) != 0; }
+	} // anonymous namespace
+} // namespace ecm::math
+
+#endif // _ECM_SIMD_LANES_H_
@@ -0,0 +1,339 @@
+#include <ECM/math/skeleton.h>
+
+#include "simd_lanes.h"
+
+#include <algorithm>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint32 TranslationChannel{ static_cast<uint32>(PoseChannel::TRANSLATION_X) };
+		constexpr uint32 RotationChannel{ static_cast<uint32>(PoseChannel::ROTATION_X) };
+		constexpr uint32 ScaleChannel{ static_cast<uint32>(PoseChannel::SCALE_X) };
+
+		static_assert(detail::pose_padding % LaneCount == 0);
+		static_assert(sizeof(Matrix4x4_Base<float32>) == 16 * sizeof(float32));
+		static_assert(sizeof(SkinningMatrix) == 12 * sizeof(float32));
+
+		// The identity transformation of each channel
+		constexpr float32 IdentityChannels[detail::pose_channels]{ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f };
+
+		// The lanes of the ten channels of LaneCount bones
+		struct bone_lanes
+		{
+			vfloat c[detail::pose_channels];
+		};
+
+		inline bone_lanes load_bones(Pose const& pose, uint32 i)
+		{
+			bone_lanes bones;
+			for (uint32 c{ 0 }; c < detail::pose_channels; ++c)
+				bones.c[c] = loadu_ps(pose.GetChannel(static_cast<PoseChannel>(c)) + i);
+			return bones;
+		}
+
+		inline void store_bones(Pose& pose, uint32 i, bone_lanes const& bones)
+		{
+			for (uint32 c{ 0 }; c < detail::pose_channels; ++c)
+				storeu_ps(pose.GetChannel(static_cast<PoseChannel>(c)) + i, bones.c[c].v);
+		}
+
+		// The Hamilton product of the rotations in the channels starting at
+		// a and b
+		inline void multiply_rotations(vfloat const* a, vfloat const* b, vfloat* out)
+		{
+			const vfloat x{ a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1] };
+			const vfloat y{ a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0] };
+			const vfloat z{ a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3] };
+			const vfloat w{ a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2] };
+			out[0] = x;
+			out[1] = y;
+			out[2] = z;
+			out[3] = w;
+		}
+
+		inline void normalize_rotation(vfloat* q)
+		{
+			const vfloat length{ lane_sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]) };
+			for (uint32 c{ 0 }; c < 4; ++c)
+				q[c] = q[c] / length;
+		}
+
+		// Broadcasts the element I of v
+		template<int I>
+		inline __m128 splat(__m128 v)
+		{
+			return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+		}
+
+		// The product of the matrix m and the matrix with the columns a
+		inline void multiply_columns(float32 const* m, __m128 const* a, __m128* out)
+		{
+			const __m128 m0{ _mm_loadu_ps(m) };
+			const __m128 m1{ _mm_loadu_ps(m + 4) };
+			const __m128 m2{ _mm_loadu_ps(m + 8) };
+			const __m128 m3{ _mm_loadu_ps(m + 12) };
+			for (uint32 j{ 0 }; j < 4; ++j) {
+				const __m128 xy{ _mm_add_ps(_mm_mul_ps(m0, splat<0>(a[j])), _mm_mul_ps(m1, splat<1>(a[j]))) };
+				const __m128 zw{ _mm_add_ps(_mm_mul_ps(m2, splat<2>(a[j])), _mm_mul_ps(m3, splat<3>(a[j]))) };
+				out[j] = _mm_add_ps(xy, zw);
+			}
+		}
+
+		inline void load_columns(float32 const* m, __m128* columns)
+		{
+			for (uint32 j{ 0 }; j < 4; ++j)
+				columns[j] = _mm_loadu_ps(m + j * 4);
+		}
+	} // anonymous namespace
+
+	// Pose
+
+	Pose::Pose(uint32 boneCount)
+	{
+		Resize(boneCount);
+	}
+
+	void Pose::Resize(uint32 boneCount)
+	{
+		const uint32 stride{ (boneCount + detail::pose_padding - 1) / detail::pose_padding * detail::pose_padding };
+		std::vector<float32> channels(static_cast<uint64>(stride) * detail::pose_channels);
+		const uint32 kept{ std::min(boneCount, _boneCount) };
+		for (uint32 c{ 0 }; c < detail::pose_channels; ++c) {
+			float32* channel{ channels.data() + static_cast<uint64>(c) * stride };
+			std::copy_n(_channels.data() + static_cast<uint64>(c) * _stride, kept, channel);
+			std::fill(channel + kept, channel + stride, IdentityChannels[c]);
+		}
+		_channels.swap(channels);
+		_boneCount = boneCount;
+		_stride = stride;
+	}
+
+	void Pose::SetIdentity() noexcept
+	{
+		for (uint32 c{ 0 }; c < detail::pose_channels; ++c)
+			std::fill_n(GetChannel(static_cast<PoseChannel>(c)), _stride, IdentityChannels[c]);
+	}
+
+	uint32 Pose::GetBoneCount() const noexcept
+	{
+		return _boneCount;
+	}
+
+	uint32 Pose::GetStride() const noexcept
+	{
+		return _stride;
+	}
+
+	void Pose::SetBone(uint32 bone, Vector3_Base<float32> const& translation, Quaternion_Base<float32> const& rotation,
+		Vector3_Base<float32> const& scale) noexcept
+	{
+		ECM_ASSERT(bone < _boneCount);
+		const float32 values[detail::pose_channels]{ translation.x, translation.y, translation.z,
+			rotation.x, rotation.y, rotation.z, rotation.w, scale.x, scale.y, scale.z };
+		for (uint32 c{ 0 }; c < detail::pose_channels; ++c)
+			_channels[static_cast<uint64>(c) * _stride + bone] = values[c];
+	}
+
+	Vector3_Base<float32> Pose::GetTranslation(uint32 bone) const noexcept
+	{
+		ECM_ASSERT(bone < _boneCount);
+		float32 const* t{ _channels.data() + bone };
+		return Vector3_Base<float32>(t[0], t[_stride], t[2 * _stride]);
+	}
+
+	Quaternion_Base<float32> Pose::GetRotation(uint32 bone) const noexcept
+	{
+		ECM_ASSERT(bone < _boneCount);
+		float32 const* r{ _channels.data() + static_cast<uint64>(RotationChannel) * _stride + bone };
+		return Quaternion_Base<float32>(r[0], r[_stride], r[2 * _stride], r[3 * _stride]);
+	}
+
+	Vector3_Base<float32> Pose::GetScale(uint32 bone) const noexcept
+	{
+		ECM_ASSERT(bone < _boneCount);
+		float32 const* s{ _channels.data() + static_cast<uint64>(ScaleChannel) * _stride + bone };
+		return Vector3_Base<float32>(s[0], s[_stride], s[2 * _stride]);
+	}
+
+	float32* Pose::GetChannel(PoseChannel channel) noexcept
+	{
+		return _channels.data() + static_cast<uint64>(channel) * _stride;
+	}
+
+	float32 const* Pose::GetChannel(PoseChannel channel) const noexcept
+	{
+		return _channels.data() + static_cast<uint64>(channel) * _stride;
+	}
+
+	// Blending
+
+	void BlendPoses(Pose const* const* poses, float32 const* weights, uint32 count, Pose& out) noexcept
+	{
+		ECM_ASSERT(count > 0);
+		const uint32 stride{ out.GetStride() };
+		for (uint32 i{ 0 }; i < stride; i += LaneCount) {
+			const bone_lanes first{ load_bones(*poses[0], i) };
+			bone_lanes sum;
+			for (uint32 c{ 0 }; c < detail::pose_channels; ++c)
+				sum.c[c] = first.c[c] * vfloat(weights[0]);
+			for (uint32 p{ 1 }; p < count; ++p) {
+				ECM_ASSERT(poses[p]->GetStride() == stride);
+				const bone_lanes bones{ load_bones(*poses[p], i) };
+				const vfloat weight{ weights[p] };
+				// q and -q are the same rotation, the sign keeps the sum on
+				// one hemisphere
+				const vfloat dot{ bones.c[RotationChannel] * first.c[RotationChannel] + bones.c[RotationChannel + 1] * first.c[RotationChannel + 1]
+					+ bones.c[RotationChannel + 2] * first.c[RotationChannel + 2] + bones.c[RotationChannel + 3] * first.c[RotationChannel + 3] };
+				const vfloat rotationWeight{ lane_select(dot < vfloat(0.f), -weight, weight) };
+				for (uint32 c{ 0 }; c < detail::pose_channels; ++c) {
+					const bool rotation{ c >= RotationChannel && c < ScaleChannel };
+					sum.c[c] = sum.c[c] + bones.c[c] * (rotation ? rotationWeight : weight);
+				}
+			}
+			normalize_rotation(sum.c + RotationChannel);
+			store_bones(out, i, sum);
+		}
+	}
+
+	void MakeAdditivePose(Pose const& pose, Pose const& reference, Pose& out) noexcept
+	{
+		ECM_ASSERT(pose.GetStride() == out.GetStride() && reference.GetStride() == out.GetStride());
+		for (uint32 i{ 0 }; i < out.GetStride(); i += LaneCount) {
+			const bone_lanes bones{ load_bones(pose, i) };
+			const bone_lanes ref{ load_bones(reference, i) };
+			bone_lanes difference;
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				difference.c[TranslationChannel + c] = bones.c[TranslationChannel + c] - ref.c[TranslationChannel + c];
+				difference.c[ScaleChannel + c] = bones.c[ScaleChannel + c] / ref.c[ScaleChannel + c];
+			}
+			// The conjugate of the reference times the rotation, so that the
+			// reference times the difference is the rotation
+			const vfloat inverse[4]{ -ref.c[RotationChannel], -ref.c[RotationChannel + 1], -ref.c[RotationChannel + 2], ref.c[RotationChannel + 3] };
+			multiply_rotations(inverse, bones.c + RotationChannel, difference.c + RotationChannel);
+			store_bones(out, i, difference);
+		}
+	}
+
+	void AddPose(Pose const& base, Pose const& additive, float32 weight, Pose& out) noexcept
+	{
+		ECM_ASSERT(base.GetStride() == out.GetStride() && additive.GetStride() == out.GetStride());
+		const vfloat w{ weight };
+		const vfloat s{ 1.f - weight };
+		for (uint32 i{ 0 }; i < out.GetStride(); i += LaneCount) {
+			const bone_lanes bones{ load_bones(base, i) };
+			const bone_lanes add{ load_bones(additive, i) };
+			bone_lanes result;
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				result.c[TranslationChannel + c] = bones.c[TranslationChannel + c] + add.c[TranslationChannel + c] * w;
+				result.c[ScaleChannel + c] = bones.c[ScaleChannel + c] * (vfloat(1.f) + (add.c[ScaleChannel + c] - vfloat(1.f)) * w);
+			}
+			// Nlerp from the identity along the shorter arc
+			const vfloat sign{ lane_select(add.c[RotationChannel + 3] < vfloat(0.f), -w, w) };
+			vfloat delta[4]{ add.c[RotationChannel] * sign, add.c[RotationChannel + 1] * sign, add.c[RotationChannel + 2] * sign,
+				add.c[RotationChannel + 3] * sign + s };
+			normalize_rotation(delta);
+			multiply_rotations(bones.c + RotationChannel, delta, result.c + RotationChannel);
+			store_bones(out, i, result);
+		}
+	}
+
+	// Hierarchy
+
+	void LocalToModel(Pose const& local, int32 const* parents, Matrix4x4_Base<float32>* model) noexcept
+	{
+		float32* matrices{ reinterpret_cast<float32*>(model) };
+		const uint32 boneCount{ local.GetBoneCount() };
+		for (uint32 i{ 0 }; i < boneCount; i += LaneCount) {
+			// The local matrices of the lanes, with the scaled rotation axes in
+			// the columns 0 to 2 and the translation in column 3
+			const bone_lanes bones{ load_bones(local, i) };
+			vfloat const* q{ bones.c + RotationChannel };
+			const vfloat two{ 2.f };
+			const vfloat xx{ q[0] * q[0] };
+			const vfloat yy{ q[1] * q[1] };
+			const vfloat zz{ q[2] * q[2] };
+			const vfloat xy{ q[0] * q[1] };
+			const vfloat xz{ q[0] * q[2] };
+			const vfloat yz{ q[1] * q[2] };
+			const vfloat wx{ q[3] * q[0] };
+			const vfloat wy{ q[3] * q[1] };
+			const vfloat wz{ q[3] * q[2] };
+			const vfloat sx{ bones.c[ScaleChannel] };
+			const vfloat sy{ bones.c[ScaleChannel + 1] };
+			const vfloat sz{ bones.c[ScaleChannel + 2] };
+			const vfloat elements[12]{
+				(vfloat(1.f) - two * (yy + zz)) * sx, two * (xy + wz) * sx, two * (xz - wy) * sx,
+				two * (xy - wz) * sy, (vfloat(1.f) - two * (xx + zz)) * sy, two * (yz + wx) * sy,
+				two * (xz + wy) * sz, two * (yz - wx) * sz, (vfloat(1.f) - two * (xx + yy)) * sz,
+				bones.c[TranslationChannel], bones.c[TranslationChannel + 1], bones.c[TranslationChannel + 2] };
+			ECM_ALIGN(32) float32 columns[12][LaneCount];
+			for (uint32 e{ 0 }; e < 12; ++e)
+				store_ps(columns[e], elements[e].v);
+
+			const uint32 n{ std::min(boneCount - i, LaneCount) };
+			for (uint32 j{ 0 }; j < n; ++j) {
+				const uint32 bone{ i + j };
+				const __m128 a[4]{
+					_mm_setr_ps(columns[0][j], columns[1][j], columns[2][j], 0.f),
+					_mm_setr_ps(columns[3][j], columns[4][j], columns[5][j], 0.f),
+					_mm_setr_ps(columns[6][j], columns[7][j], columns[8][j], 0.f),
+					_mm_setr_ps(columns[9][j], columns[10][j], columns[11][j], 1.f) };
+				float32* out{ matrices + static_cast<uint64>(bone) * 16 };
+				const int32 parent{ parents[bone] };
+				if (parent < 0) {
+					for (uint32 c{ 0 }; c < 4; ++c)
+						_mm_storeu_ps(out + c * 4, a[c]);
+					continue;
+				}
+				ECM_ASSERT(static_cast<uint32>(parent) < bone);
+				__m128 result[4];
+				multiply_columns(matrices + static_cast<uint64>(parent) * 16, a, result);
+				for (uint32 c{ 0 }; c < 4; ++c)
+					_mm_storeu_ps(out + c * 4, result[c]);
+			}
+		}
+	}
+
+	// Skinning
+
+	void ComputeSkinningMatrices(Matrix4x4_Base<float32> const* model, Matrix4x4_Base<float32> const* inverseBind,
+		SkinningMatrix* out, uint32 count) noexcept
+	{
+		for (uint32 i{ 0 }; i < count; ++i) {
+			__m128 a[4];
+			load_columns(reinterpret_cast<float32 const*>(inverseBind + i), a);
+			__m128 columns[4];
+			multiply_columns(reinterpret_cast<float32 const*>(model + i), a, columns);
+			// The rows are the columns of the transposed matrix
+			_MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+			float32* rows{ reinterpret_cast<float32*>(out + i) };
+			_mm_storeu_ps(rows, columns[0]);
+			_mm_storeu_ps(rows + 4, columns[1]);
+			_mm_storeu_ps(rows + 8, columns[2]);
+		}
+	}
+
+	void ComputeSkinningMatrices(Matrix4x4_Base<float32> const* model, Matrix4x4_Base<float32> const* inverseBind,
+		DualQuaternion_Base<float32>* out, uint32 count) noexcept
+	{
+		for (uint32 i{ 0 }; i < count; ++i) {
+			__m128 a[4];
+			load_columns(reinterpret_cast<float32 const*>(inverseBind + i), a);
+			__m128 columns[4];
+			multiply_columns(reinterpret_cast<float32 const*>(model + i), a, columns);
+			// Removes the scale from the rotation axes
+			for (uint32 c{ 0 }; c < 3; ++c) {
+				const __m128 lengthSquared{ _mm_mul_ps(columns[c], columns[c]) };
+				const __m128 length{ _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(splat<0>(lengthSquared), splat<1>(lengthSquared)),
+					splat<2>(lengthSquared))) };
+				columns[c] = _mm_div_ps(columns[c], length);
+			}
+			Matrix4x4_Base<float32> rigid;
+			for (uint32 c{ 0 }; c < 4; ++c)
+				_mm_storeu_ps(rigid.matrix[c], columns[c]);
+			out[i] = DualQuaternionFromTransform(QuaternionFromMatrix(rigid), Vector3_Base<float32>(rigid.m30, rigid.m31, rigid.m32));
+		}
+	}
+} // namespace ecm::math
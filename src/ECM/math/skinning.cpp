@@ -0,0 +1,326 @@
+#include <ECM/math/skinning.h>
+#include <ECM/math/parallel.h>
+
+#include "simd_lanes.h"
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The number of vertices of a chunk of the skinning functions
+		constexpr uint64 VertexGrain{ 8192 };
+
+		static_assert(LaneCount % 4 == 0);
+		static_assert(sizeof(Matrix4x4_Base<float32>) == 16 * sizeof(float32));
+		static_assert(sizeof(SkinningMatrix) == 12 * sizeof(float32));
+		static_assert(sizeof(DualQuaternion_Base<float32>) == 8 * sizeof(float32));
+
+		// The kernels use the lane types of simd_lanes.h, so a vertex gives
+		// the same values in every lane and in the scalar remainder.
+
+		// The offsets of the elements of the transformations of the
+		// palettes in floats, by row and column
+		struct row_layout
+		{
+			static constexpr uint32 stride{ 12 };
+			static constexpr uint32 offset(uint32 row, uint32 column) { return row * 4 + column; }
+		};
+
+		struct column_layout
+		{
+			static constexpr uint32 stride{ 16 };
+			static constexpr uint32 offset(uint32 row, uint32 column) { return column * 4 + row; }
+		};
+
+		// The real part, followed by the dual part
+		constexpr uint32 DualQuaternionStride{ 8 };
+
+		// Broadcasts the element I of v
+		template<int I>
+		inline __m128 splat(__m128 v)
+		{
+			return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I));
+		}
+
+		// The number of groups of four vertices in the lanes
+		constexpr uint32 GroupCount{ LaneCount / 4 };
+
+		// Transposes four vectors of four floats in place
+		inline void transpose(__m128* v)
+		{
+			_MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+		}
+
+		// Joins the values of the groups to lanes. The groups aren't stored
+		// and loaded as lanes, which would stall the loads of AVX2.
+		inline vfloat join_groups(__m128 const* groups)
+		{
+#if ECM_SIMD_AVX2
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(groups[0]), groups[1], 1);
+#else
+			return groups[0];
+#endif // ECM_SIMD_AVX2
+		}
+
+		// The transformations aren't gathered element by element. The rows
+		// of the transformations of four vertices are loaded and transposed
+		// to the lanes, which is faster than the gathers of AVX2.
+
+		// Loads the weights of LaneCount vertices, in one lane per vertex
+		inline void load_weights(float32 const* weights, vfloat* out)
+		{
+			__m128 groups[4][GroupCount];
+			for (uint32 g{ 0 }; g < GroupCount; ++g) {
+				__m128 v[4];
+				for (uint32 l{ 0 }; l < 4; ++l)
+					v[l] = _mm_loadu_ps(weights + (g * 4 + l) * 4);
+				transpose(v);
+				for (uint32 k{ 0 }; k < 4; ++k)
+					groups[k][g] = v[k];
+			}
+			for (uint32 k{ 0 }; k < 4; ++k)
+				out[k] = join_groups(groups[k]);
+		}
+
+		inline void load_weights(float32 const* weights, float32* out)
+		{
+			for (uint32 k{ 0 }; k < 4; ++k)
+				out[k] = weights[k];
+		}
+
+		// Loads the transformations of the bone k of LaneCount vertices
+		template<uint32 Stride>
+		inline void load_transforms(float32 const* palette, uint16 const* bones, uint32 k, vfloat* out)
+		{
+			__m128 groups[Stride][GroupCount];
+			for (uint32 g{ 0 }; g < GroupCount; ++g) {
+				for (uint32 e{ 0 }; e < Stride; e += 4) {
+					__m128 v[4];
+					for (uint32 l{ 0 }; l < 4; ++l)
+						v[l] = _mm_loadu_ps(palette + static_cast<uint64>(bones[(g * 4 + l) * 4 + k]) * Stride + e);
+					transpose(v);
+					for (uint32 i{ 0 }; i < 4; ++i)
+						groups[e + i][g] = v[i];
+				}
+			}
+			for (uint32 e{ 0 }; e < Stride; ++e)
+				out[e] = join_groups(groups[e]);
+		}
+
+		template<uint32 Stride>
+		inline void load_transforms(float32 const* palette, uint16 const* bones, uint32 k, float32* out)
+		{
+			for (uint32 e{ 0 }; e < Stride; ++e)
+				out[e] = palette[static_cast<uint64>(bones[k]) * Stride + e];
+		}
+
+		// Blends the transformations of the bones of LaneCount vertices.
+		// The sums are calculated for each vertex, with the same operations
+		// as the scalar overload, and transposed once.
+		template<uint32 Stride>
+		inline void blend_transforms(float32 const* palette, uint16 const* bones, float32 const* weights, vfloat* out)
+		{
+			__m128 groups[Stride][GroupCount];
+			for (uint32 g{ 0 }; g < GroupCount; ++g) {
+				__m128 v[Stride / 4][4];
+				for (uint32 l{ 0 }; l < 4; ++l) {
+					uint16 const* vertexBones{ bones + (g * 4 + l) * 4 };
+					const __m128 vertexWeights{ _mm_loadu_ps(weights + (g * 4 + l) * 4) };
+					const __m128 w[4]{ splat<0>(vertexWeights), splat<1>(vertexWeights), splat<2>(vertexWeights),
+						splat<3>(vertexWeights) };
+					float32 const* transforms[4];
+					for (uint32 k{ 0 }; k < 4; ++k)
+						transforms[k] = palette + static_cast<uint64>(vertexBones[k]) * Stride;
+					for (uint32 e{ 0 }; e < Stride / 4; ++e) {
+						__m128 sum{ _mm_mul_ps(w[0], _mm_loadu_ps(transforms[0] + e * 4)) };
+						for (uint32 k{ 1 }; k < 4; ++k)
+							sum = _mm_add_ps(sum, _mm_mul_ps(w[k], _mm_loadu_ps(transforms[k] + e * 4)));
+						v[e][l] = sum;
+					}
+				}
+				for (uint32 e{ 0 }; e < Stride / 4; ++e) {
+					transpose(v[e]);
+					for (uint32 i{ 0 }; i < 4; ++i)
+						groups[e * 4 + i][g] = v[e][i];
+				}
+			}
+			for (uint32 e{ 0 }; e < Stride; ++e)
+				out[e] = join_groups(groups[e]);
+		}
+
+		template<uint32 Stride>
+		inline void blend_transforms(float32 const* palette, uint16 const* bones, float32 const* weights, float32* out)
+		{
+			for (uint32 e{ 0 }; e < Stride; ++e)
+				out[e] = weights[0] * palette[static_cast<uint64>(bones[0]) * Stride + e];
+			for (uint32 k{ 1 }; k < 4; ++k) {
+				for (uint32 e{ 0 }; e < Stride; ++e)
+					out[e] = out[e] + weights[k] * palette[static_cast<uint64>(bones[k]) * Stride + e];
+			}
+		}
+
+		template<typename F>
+		inline void cross(F const* a, F const* b, F* out)
+		{
+			out[0] = a[1] * b[2] - a[2] * b[1];
+			out[1] = a[2] * b[0] - a[0] * b[2];
+			out[2] = a[0] * b[1] - a[1] * b[0];
+		}
+
+		// Rotates v by the unit quaternion q
+		template<typename F>
+		inline void rotate(F const* q, F const* v, F* out)
+		{
+			F c[3];
+			cross(q, v, c);
+			for (uint32 i{ 0 }; i < 3; ++i)
+				c[i] = c[i] + q[3] * v[i];
+			F d[3];
+			cross(q, c, d);
+			for (uint32 i{ 0 }; i < 3; ++i)
+				out[i] = v[i] + F(2.f) * d[i];
+		}
+
+		template<typename Layout, typename F>
+		inline void skin_linear(float32 const* palette, uint16 const* bones, float32 const* weights, F const* p,
+			F const* n, F* outP, F* outN, bool normals)
+		{
+			F m[Layout::stride];
+			blend_transforms<Layout::stride>(palette, bones, weights, m);
+			for (uint32 r{ 0 }; r < 3; ++r) {
+				outP[r] = m[Layout::offset(r, 0)] * p[0] + m[Layout::offset(r, 1)] * p[1]
+					+ m[Layout::offset(r, 2)] * p[2] + m[Layout::offset(r, 3)];
+			}
+			if (normals) {
+				for (uint32 r{ 0 }; r < 3; ++r) {
+					outN[r] = m[Layout::offset(r, 0)] * n[0] + m[Layout::offset(r, 1)] * n[1]
+						+ m[Layout::offset(r, 2)] * n[2];
+				}
+			}
+		}
+
+		template<typename F>
+		inline void skin_dual_quat(float32 const* palette, uint16 const* bones, float32 const* weights, F const* p,
+			F const* n, F* outP, F* outN, bool normals)
+		{
+			F factors[4];
+			load_weights(weights, factors);
+			F first[DualQuaternionStride];
+			load_transforms<DualQuaternionStride>(palette, bones, 0, first);
+			F sum[DualQuaternionStride];
+			for (uint32 e{ 0 }; e < DualQuaternionStride; ++e)
+				sum[e] = factors[0] * first[e];
+			for (uint32 k{ 1 }; k < 4; ++k) {
+				F dq[DualQuaternionStride];
+				load_transforms<DualQuaternionStride>(palette, bones, k, dq);
+				// q and -q are the same rotation, the sign keeps the sum on
+				// one hemisphere
+				const F dot{ dq[0] * first[0] + dq[1] * first[1] + dq[2] * first[2] + dq[3] * first[3] };
+				const F weight{ lane_select(dot < F(0.f), -factors[k], factors[k]) };
+				for (uint32 e{ 0 }; e < DualQuaternionStride; ++e)
+					sum[e] = sum[e] + weight * dq[e];
+			}
+			const F inverse{ F(1.f) / lane_sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]
+				+ sum[3] * sum[3]) };
+			F real[4];
+			F dual[4];
+			for (uint32 c{ 0 }; c < 4; ++c) {
+				real[c] = sum[c] * inverse;
+				dual[c] = sum[4 + c] * inverse;
+			}
+
+			// The translation 2 * dual * conjugate(real)
+			F t[3];
+			cross(real, dual, t);
+			for (uint32 i{ 0 }; i < 3; ++i)
+				t[i] = F(2.f) * (t[i] + real[3] * dual[i] - dual[3] * real[i]);
+			F rotated[3];
+			rotate(real, p, rotated);
+			for (uint32 i{ 0 }; i < 3; ++i)
+				outP[i] = rotated[i] + t[i];
+			if (normals)
+				rotate(real, n, outN);
+		}
+
+		// Skins the vertices [begin, end) with a kernel, which takes the
+		// bones and weights of the first vertex, the lanes of the position
+		// and the normal, and the outputs
+		template<typename Kernel>
+		void skin_range(SkinningVertices const& vertices, SkinnedVertices const& out, uint64 begin, uint64 end,
+			Kernel const& kernel)
+		{
+			const bool normals{ vertices.normals[0] != nullptr && out.normals[0] != nullptr };
+			uint64 i{ begin };
+			for (; i + LaneCount <= end; i += LaneCount) {
+				vfloat p[3];
+				vfloat n[3];
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					p[c] = loadu_ps(vertices.positions[c] + i);
+					n[c] = normals ? vfloat(loadu_ps(vertices.normals[c] + i)) : vfloat(0.f);
+				}
+				vfloat outP[3];
+				vfloat outN[3];
+				kernel(vertices.bones + i * 4, vertices.weights + i * 4, p, n, outP, outN, normals);
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					storeu_ps(out.positions[c] + i, outP[c].v);
+					if (normals)
+						storeu_ps(out.normals[c] + i, outN[c].v);
+				}
+			}
+			for (; i < end; ++i) {
+				float32 p[3];
+				float32 n[3];
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					p[c] = vertices.positions[c][i];
+					n[c] = normals ? vertices.normals[c][i] : 0.f;
+				}
+				float32 outP[3];
+				float32 outN[3];
+				kernel(vertices.bones + i * 4, vertices.weights + i * 4, p, n, outP, outN, normals);
+				for (uint32 c{ 0 }; c < 3; ++c) {
+					out.positions[c][i] = outP[c];
+					if (normals)
+						out.normals[c][i] = outN[c];
+				}
+			}
+		}
+
+		template<typename Kernel>
+		void skin(SkinningVertices const& vertices, SkinnedVertices const& out, uint64 count, Kernel const& kernel)
+		{
+			ParallelFor(0, count, VertexGrain, [&](uint64 begin, uint64 end) {
+				skin_range(vertices, out, begin, end, kernel);
+			});
+		}
+	} // anonymous namespace
+
+	void SkinLinear(SkinningMatrix const* palette, SkinningVertices const& vertices, SkinnedVertices const& out,
+		uint64 count) noexcept
+	{
+		float32 const* matrices{ reinterpret_cast<float32 const*>(palette) };
+		skin(vertices, out, count, [matrices](uint16 const* bones, float32 const* weights, auto const* p,
+			auto const* n, auto* outP, auto* outN, bool normals) {
+			skin_linear<row_layout>(matrices, bones, weights, p, n, outP, outN, normals);
+		});
+	}
+
+	void SkinLinear(Matrix4x4_Base<float32> const* palette, SkinningVertices const& vertices,
+		SkinnedVertices const& out, uint64 count) noexcept
+	{
+		float32 const* matrices{ reinterpret_cast<float32 const*>(palette) };
+		skin(vertices, out, count, [matrices](uint16 const* bones, float32 const* weights, auto const* p,
+			auto const* n, auto* outP, auto* outN, bool normals) {
+			skin_linear<column_layout>(matrices, bones, weights, p, n, outP, outN, normals);
+		});
+	}
+
+	void SkinDualQuat(DualQuaternion_Base<float32> const* palette, SkinningVertices const& vertices,
+		SkinnedVertices const& out, uint64 count) noexcept
+	{
+		float32 const* transforms{ reinterpret_cast<float32 const*>(palette) };
+		skin(vertices, out, count, [transforms](uint16 const* bones, float32 const* weights, auto const* p,
+			auto const* n, auto* outP, auto* outN, bool normals) {
+			skin_dual_quat(transforms, bones, weights, p, n, outP, outN, normals);
+		});
+	}
+} // namespace ecm::math
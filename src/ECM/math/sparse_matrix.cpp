@@ -0,0 +1,753 @@
+#include <ECM/math/sparse_matrix.h>
+#include <ECM/math/functions_simd.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace ecm::math
+{
+	namespace
+	{
+		// The number of rows of a chunk of the products
+		constexpr uint64 RowGrain{ 1024 };
+		// The number of elements of a chunk of the vector operations of the
+		// solver, whose dot products are summed per chunk
+		constexpr uint64 VectorGrain{ 8192 };
+		// Marks the columns of blocks, which aren't in the current row of
+		// blocks
+		constexpr uint32 InvalidSlot{ 0xffffffffu };
+
+		// The dot product of a row with the vector, whose elements are
+		// gathered by the columns of the row. AVX2 gathers were slower than
+		// scalar loads for the short rows of stencils, so the row is summed
+		// with two independent sums instead.
+		template<typename T>
+		inline T row_dot(T const* values, uint32 const* columns, uint64 count, T const* x)
+		{
+			T sum0{ 0 }, sum1{ 0 };
+			uint64 i{ 0 };
+			for (; i + 2 <= count; i += 2) {
+				sum0 += values[i] * x[columns[i]];
+				sum1 += values[i + 1] * x[columns[i + 1]];
+			}
+			if (i < count)
+				sum0 += values[i] * x[columns[i]];
+			return sum0 + sum1;
+		}
+
+		// Multiplies the rows of blocks [begin, end) with blocks of size B
+		// known at compile time, so that the loops over a block unroll
+		template<uint32 B, typename T>
+		void block_rows_multiply(uint64 const* offsets, uint32 const* columns, T const* values, T const* x, T* y,
+			uint64 begin, uint64 end)
+		{
+			for (uint64 row{ begin }; row < end; ++row) {
+				T sum[B]{};
+				for (uint64 block{ offsets[row] }; block < offsets[row + 1]; ++block) {
+					T const* v{ values + block * B * B };
+					T const* xs{ x + static_cast<uint64>(columns[block]) * B };
+					for (uint32 c{ 0 }; c < B; ++c) {
+						for (uint32 r{ 0 }; r < B; ++r)
+							sum[r] += v[c * B + r] * xs[c];
+					}
+				}
+				for (uint32 r{ 0 }; r < B; ++r)
+					y[row * B + r] = sum[r];
+			}
+		}
+
+#if ECM_SIMD_SSE2
+		// The B rows of a column of a block in one register, loaded and
+		// stored without touching the elements after the column
+		template<typename T, uint32 B>
+		struct block_column;
+
+		template<uint32 B>
+		struct block_column<float32, B>
+		{
+			typedef __m128 type;
+			static type zero() { return _mm_setzero_ps(); }
+			static type set1(float32 f) { return _mm_set1_ps(f); }
+			static type load(float32 const* p)
+			{
+				if constexpr (B == 4) {
+					return _mm_loadu_ps(p);
+				} else {
+					const __m128 low{ _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(p))) };
+					if constexpr (B == 3)
+						return _mm_movelh_ps(low, _mm_load_ss(p + 2));
+					else
+						return low;
+				}
+			}
+			static void store(float32* p, type a)
+			{
+				if constexpr (B == 4) {
+					_mm_storeu_ps(p, a);
+				} else {
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_castps_si128(a));
+					if constexpr (B == 3)
+						_mm_store_ss(p + 2, _mm_movehl_ps(a, a));
+				}
+			}
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm_fmadd_ps(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+
+		template<>
+		struct block_column<float64, 2>
+		{
+			typedef __m128d type;
+			static type zero() { return _mm_setzero_pd(); }
+			static type set1(float64 f) { return _mm_set1_pd(f); }
+			static type load(float64 const* p) { return _mm_loadu_pd(p); }
+			static void store(float64* p, type a) { _mm_storeu_pd(p, a); }
+#	if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm_fmadd_pd(a, b, c); }
+#	else
+			static type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+#	endif // ECM_SIMD_FMA
+		};
+
+#	if ECM_SIMD_AVX2
+		template<uint32 B>
+		struct block_column<float64, B>
+		{
+			typedef __m256d type;
+			static type zero() { return _mm256_setzero_pd(); }
+			static type set1(float64 f) { return _mm256_set1_pd(f); }
+			static __m256i mask() { return _mm256_setr_epi64x(-1, -1, -1, B == 4 ? -1 : 0); }
+			static type load(float64 const* p)
+			{
+				if constexpr (B == 4)
+					return _mm256_loadu_pd(p);
+				else
+					return _mm256_maskload_pd(p, mask());
+			}
+			static void store(float64* p, type a)
+			{
+				if constexpr (B == 4)
+					_mm256_storeu_pd(p, a);
+				else
+					_mm256_maskstore_pd(p, mask(), a);
+			}
+#		if ECM_SIMD_FMA
+			static type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+#		else
+			static type fmadd(type a, type b, type c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#		endif // ECM_SIMD_FMA
+		};
+#	else
+		// Two SSE2 registers, the second one of which holds one row of
+		// blocks of size 3
+		template<uint32 B>
+		struct block_column<float64, B>
+		{
+			struct type
+			{
+				__m128d low;
+				__m128d high;
+			};
+			static type zero() { return { _mm_setzero_pd(), _mm_setzero_pd() }; }
+			static type set1(float64 f) { return { _mm_set1_pd(f), _mm_set1_pd(f) }; }
+			static type load(float64 const* p)
+			{
+				return { _mm_loadu_pd(p), B == 4 ? _mm_loadu_pd(p + 2) : _mm_load_sd(p + 2) };
+			}
+			static void store(float64* p, type a)
+			{
+				_mm_storeu_pd(p, a.low);
+				if constexpr (B == 4)
+					_mm_storeu_pd(p + 2, a.high);
+				else
+					_mm_store_sd(p + 2, a.high);
+			}
+			static type fmadd(type a, type b, type c)
+			{
+				return { block_column<float64, 2>::fmadd(a.low, b.low, c.low),
+					block_column<float64, 2>::fmadd(a.high, b.high, c.high) };
+			}
+		};
+#	endif // ECM_SIMD_AVX2
+
+		// Multiplies the rows of blocks [begin, end) with blocks of size B
+		// from 2 to 4. The sums of a row of blocks stay in one register, and
+		// each column of a block adds its product with one element of x.
+		template<uint32 B, typename T>
+		void block_rows_multiply_simd(uint64 const* offsets, uint32 const* columns, T const* values, T const* x,
+			T* y, uint64 begin, uint64 end)
+		{
+			typedef block_column<T, B> L;
+			for (uint64 row{ begin }; row < end; ++row) {
+				typename L::type sum{ L::zero() };
+				for (uint64 block{ offsets[row] }; block < offsets[row + 1]; ++block) {
+					T const* v{ values + block * B * B };
+					T const* xs{ x + static_cast<uint64>(columns[block]) * B };
+					for (uint32 c{ 0 }; c < B; ++c)
+						sum = L::fmadd(L::load(v + c * B), L::set1(xs[c]), sum);
+				}
+				L::store(y + row * B, sum);
+			}
+		}
+#endif // ECM_SIMD_SSE2
+
+		template<typename T>
+		void block_rows_multiply(uint32 size, uint64 const* offsets, uint32 const* columns, T const* values,
+			T const* x, T* y, uint64 begin, uint64 end)
+		{
+			for (uint64 row{ begin }; row < end; ++row) {
+				T* ys{ y + row * size };
+				std::fill(ys, ys + size, T(0));
+				for (uint64 block{ offsets[row] }; block < offsets[row + 1]; ++block) {
+					T const* v{ values + block * size * size };
+					T const* xs{ x + static_cast<uint64>(columns[block]) * size };
+					for (uint32 c{ 0 }; c < size; ++c) {
+						for (uint32 r{ 0 }; r < size; ++r)
+							ys[r] += v[c * size + r] * xs[c];
+					}
+				}
+			}
+		}
+
+		// Sums function(chunkBegin, chunkEnd) over the chunks of [0, count)
+		// in the order of the chunks, so that the sum is deterministic
+		template<typename Function>
+		float64 parallel_sum(uint64 count, std::vector<float64>& partials, Function&& function)
+		{
+			ParallelFor(0, count, VectorGrain, [&](uint64 begin, uint64 end) {
+				partials[begin / VectorGrain] = function(begin, end);
+			});
+			float64 sum{ 0.0 };
+			const uint64 chunkCount{ (count + VectorGrain - 1) / VectorGrain };
+			for (uint64 chunk{ 0 }; chunk < chunkCount; ++chunk)
+				sum += partials[chunk];
+			return sum;
+		}
+	} // anonymous namespace
+
+	// SparseMatrix
+
+	template<typename T>
+	void SparseMatrix<T>::Build(uint32 rows, uint32 columns, SparseTriplet<T> const* triplets, uint64 count)
+	{
+		_rows = rows;
+		_columns = columns;
+		// Counting sort of the elements by rows
+		std::vector<uint64> offsets(static_cast<uint64>(rows) + 1, 0);
+		for (uint64 i{ 0 }; i < count; ++i)
+			++offsets[triplets[i].row + 1];
+		for (uint32 row{ 0 }; row < rows; ++row)
+			offsets[row + 1] += offsets[row];
+		std::vector<std::pair<uint32, T>> entries(count);
+		{
+			std::vector<uint64> cursor(offsets.begin(), offsets.end() - 1);
+			for (uint64 i{ 0 }; i < count; ++i)
+				entries[cursor[triplets[i].row]++] = { triplets[i].column, triplets[i].value };
+		}
+		// Sorts the columns of each row and adds the values of the same
+		// columns in place, then compacts the rows
+		_offsets.assign(static_cast<uint64>(rows) + 1, 0);
+		ParallelFor(0, rows, RowGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row) {
+				auto first{ entries.begin() + static_cast<std::ptrdiff_t>(offsets[row]) };
+				auto last{ entries.begin() + static_cast<std::ptrdiff_t>(offsets[row + 1]) };
+				std::sort(first, last, [](std::pair<uint32, T> const& a, std::pair<uint32, T> const& b) {
+					return a.first < b.first;
+				});
+				auto output{ first };
+				for (auto entry{ first }; entry != last; ++entry) {
+					if (output != first && (output - 1)->first == entry->first)
+						(output - 1)->second += entry->second;
+					else
+						*output++ = *entry;
+				}
+				_offsets[row + 1] = static_cast<uint64>(output - first);
+			}
+		});
+		for (uint32 row{ 0 }; row < rows; ++row)
+			_offsets[row + 1] += _offsets[row];
+		_columnIndices.resize(_offsets[rows]);
+		_values.resize(_offsets[rows]);
+		ParallelFor(0, rows, RowGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row) {
+				const uint64 source{ offsets[row] };
+				const uint64 destination{ _offsets[row] };
+				for (uint64 i{ 0 }; i < _offsets[row + 1] - destination; ++i) {
+					_columnIndices[destination + i] = entries[source + i].first;
+					_values[destination + i] = entries[source + i].second;
+				}
+			}
+		});
+	}
+
+	template<typename T>
+	void SparseMatrix<T>::Multiply(T const* x, T* y) const noexcept
+	{
+		uint64 const* offsets{ _offsets.data() };
+		uint32 const* columns{ _columnIndices.data() };
+		T const* values{ _values.data() };
+		ParallelFor(0, _rows, RowGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row) {
+				const uint64 first{ offsets[row] };
+				y[row] = row_dot(values + first, columns + first, offsets[row + 1] - first, x);
+			}
+		});
+	}
+
+	template<typename T>
+	void SparseMatrix<T>::GetDiagonal(T* diagonal) const noexcept
+	{
+		ParallelFor(0, _rows, RowGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 row{ begin }; row < end; ++row) {
+				uint32 const* first{ _columnIndices.data() + _offsets[row] };
+				uint32 const* last{ _columnIndices.data() + _offsets[row + 1] };
+				uint32 const* found{ std::lower_bound(first, last, static_cast<uint32>(row)) };
+				diagonal[row] = found != last && *found == row ? _values[static_cast<uint64>(found - _columnIndices.data())] : T(0);
+			}
+		});
+	}
+
+	template<typename T>
+	uint32 SparseMatrix<T>::GetRows() const noexcept
+	{
+		return _rows;
+	}
+
+	template<typename T>
+	uint32 SparseMatrix<T>::GetColumns() const noexcept
+	{
+		return _columns;
+	}
+
+	template<typename T>
+	uint64 SparseMatrix<T>::GetNonZeroCount() const noexcept
+	{
+		return _values.size();
+	}
+
+	template<typename T>
+	uint64 const* SparseMatrix<T>::GetRowOffsets() const noexcept
+	{
+		return _offsets.data();
+	}
+
+	template<typename T>
+	uint32 const* SparseMatrix<T>::GetColumnIndices() const noexcept
+	{
+		return _columnIndices.data();
+	}
+
+	template<typename T>
+	T* SparseMatrix<T>::GetValues() noexcept
+	{
+		return _values.data();
+	}
+
+	template<typename T>
+	T const* SparseMatrix<T>::GetValues() const noexcept
+	{
+		return _values.data();
+	}
+
+	// BlockSparseMatrix
+
+	template<typename T>
+	bool BlockSparseMatrix<T>::Build(SparseMatrix<T> const& matrix, uint32 blockSize)
+	{
+		_offsets.assign(1, 0);
+		_columnIndices.clear();
+		_values.clear();
+		_blockSize = blockSize ? blockSize : 1;
+		_blockRows = 0;
+		_blockColumns = 0;
+		if (!blockSize || matrix.GetRows() % blockSize || matrix.GetColumns() % blockSize)
+			return false;
+		_blockRows = matrix.GetRows() / blockSize;
+		_blockColumns = matrix.GetColumns() / blockSize;
+		uint64 const* offsets{ matrix.GetRowOffsets() };
+		uint32 const* columns{ matrix.GetColumnIndices() };
+		T const* values{ matrix.GetValues() };
+		const uint64 blockElements{ static_cast<uint64>(blockSize) * blockSize };
+		// The index of the block of each column of blocks in the current row
+		// of blocks
+		std::vector<uint32> slots(_blockColumns, InvalidSlot);
+		std::vector<uint32> rowColumns;
+		_offsets.reserve(static_cast<uint64>(_blockRows) + 1);
+		for (uint32 blockRow{ 0 }; blockRow < _blockRows; ++blockRow) {
+			const uint32 firstRow{ blockRow * blockSize };
+			rowColumns.clear();
+			for (uint32 row{ firstRow }; row < firstRow + blockSize; ++row) {
+				for (uint64 i{ offsets[row] }; i < offsets[row + 1]; ++i) {
+					const uint32 blockColumn{ columns[i] / blockSize };
+					if (slots[blockColumn] == InvalidSlot) {
+						slots[blockColumn] = 0;
+						rowColumns.push_back(blockColumn);
+					}
+				}
+			}
+			std::sort(rowColumns.begin(), rowColumns.end());
+			const uint64 firstBlock{ _columnIndices.size() };
+			for (uint32 i{ 0 }; i < static_cast<uint32>(rowColumns.size()); ++i) {
+				slots[rowColumns[i]] = static_cast<uint32>(i);
+				_columnIndices.push_back(rowColumns[i]);
+			}
+			_values.resize(_columnIndices.size() * blockElements, T(0));
+			for (uint32 row{ firstRow }; row < firstRow + blockSize; ++row) {
+				for (uint64 i{ offsets[row] }; i < offsets[row + 1]; ++i) {
+					const uint32 blockColumn{ columns[i] / blockSize };
+					T* block{ _values.data() + (firstBlock + slots[blockColumn]) * blockElements };
+					block[(columns[i] % blockSize) * blockSize + (row - firstRow)] = values[i];
+				}
+			}
+			for (const uint32 blockColumn : rowColumns)
+				slots[blockColumn] = InvalidSlot;
+			_offsets.push_back(_columnIndices.size());
+		}
+		return true;
+	}
+
+	template<typename T>
+	void BlockSparseMatrix<T>::Multiply(T const* x, T* y) const noexcept
+	{
+		uint64 const* offsets{ _offsets.data() };
+		uint32 const* columns{ _columnIndices.data() };
+		T const* values{ _values.data() };
+		const uint32 size{ _blockSize };
+		ParallelFor(0, _blockRows, std::max<uint64>(RowGrain / size, 1), [&](uint64 begin, uint64 end) {
+			switch (size) {
+			case 1:
+				block_rows_multiply<1>(offsets, columns, values, x, y, begin, end);
+				break;
+#if ECM_SIMD_SSE2
+			case 2:
+				block_rows_multiply_simd<2>(offsets, columns, values, x, y, begin, end);
+				break;
+			case 3:
+				block_rows_multiply_simd<3>(offsets, columns, values, x, y, begin, end);
+				break;
+			case 4:
+				block_rows_multiply_simd<4>(offsets, columns, values, x, y, begin, end);
+				break;
+#else
+			case 2:
+				block_rows_multiply<2>(offsets, columns, values, x, y, begin, end);
+				break;
+			case 3:
+				block_rows_multiply<3>(offsets, columns, values, x, y, begin, end);
+				break;
+			case 4:
+				block_rows_multiply<4>(offsets, columns, values, x, y, begin, end);
+				break;
+#endif // ECM_SIMD_SSE2
+			default:
+				block_rows_multiply(size, offsets, columns, values, x, y, begin, end);
+				break;
+			}
+		});
+	}
+
+	template<typename T>
+	uint32 BlockSparseMatrix<T>::GetBlockSize() const noexcept
+	{
+		return _blockSize;
+	}
+
+	template<typename T>
+	uint32 BlockSparseMatrix<T>::GetBlockRows() const noexcept
+	{
+		return _blockRows;
+	}
+
+	template<typename T>
+	uint64 BlockSparseMatrix<T>::GetBlockCount() const noexcept
+	{
+		return _columnIndices.size();
+	}
+
+	template<typename T>
+	uint64 const* BlockSparseMatrix<T>::GetRowOffsets() const noexcept
+	{
+		return _offsets.data();
+	}
+
+	template<typename T>
+	uint32 const* BlockSparseMatrix<T>::GetColumnIndices() const noexcept
+	{
+		return _columnIndices.data();
+	}
+
+	template<typename T>
+	T* BlockSparseMatrix<T>::GetValues() noexcept
+	{
+		return _values.data();
+	}
+
+	template<typename T>
+	T const* BlockSparseMatrix<T>::GetValues() const noexcept
+	{
+		return _values.data();
+	}
+
+	// ConjugateGradient
+
+	template<typename T>
+	ConjugateGradient<T>::ConjugateGradient(Preconditioner preconditioner) noexcept
+		: _preconditioner{ preconditioner }
+	{}
+
+	template<typename T>
+	bool ConjugateGradient<T>::Compute(SparseMatrix<T> const& a)
+	{
+		const uint32 n{ a.GetRows() };
+		_active = _preconditioner;
+		bool regular{ true };
+		if (_preconditioner != Preconditioner::NONE) {
+			// Jacobi is also the fallback of IC0. Rows without diagonal
+			// aren't scaled.
+			_inverseDiagonal.resize(n);
+			a.GetDiagonal(_inverseDiagonal.data());
+			for (uint32 i{ 0 }; i < n; ++i) {
+				if (_inverseDiagonal[i] != T(0)) {
+					_inverseDiagonal[i] = T(1) / _inverseDiagonal[i];
+				} else {
+					_inverseDiagonal[i] = T(1);
+					regular = false;
+				}
+			}
+		}
+		if (_preconditioner != Preconditioner::IC0)
+			return regular;
+
+		// The lower triangle of A, which is the prefix of each sorted row
+		uint64 const* offsets{ a.GetRowOffsets() };
+		uint32 const* columns{ a.GetColumnIndices() };
+		T const* values{ a.GetValues() };
+		std::vector<SparseTriplet<T>> triplets;
+		for (uint32 row{ 0 }; row < n; ++row) {
+			for (uint64 i{ offsets[row] }; i < offsets[row + 1] && columns[i] <= row; ++i)
+				triplets.push_back({ row, columns[i], values[i] });
+		}
+		_factor.Build(n, n, triplets.data(), triplets.size());
+
+		// Factorizes row by row: the elements of row i of L are
+		// L(i, k) = (A(i, k) - sum L(i, j) L(k, j)) / L(k, k) over j < k on
+		// the pattern, and the diagonal is the root of the rest of A(i, i).
+		uint64 const* factorOffsets{ _factor.GetRowOffsets() };
+		uint32 const* factorColumns{ _factor.GetColumnIndices() };
+		T* factor{ _factor.GetValues() };
+		for (uint32 row{ 0 }; row < n && _active == Preconditioner::IC0; ++row) {
+			const uint64 rowBegin{ factorOffsets[row] };
+			const uint64 rowEnd{ factorOffsets[row + 1] };
+			if (rowBegin == rowEnd || factorColumns[rowEnd - 1] != row) {
+				_active = Preconditioner::JACOBI;
+				break;
+			}
+			for (uint64 i{ rowBegin }; i < rowEnd; ++i) {
+				const uint32 k{ factorColumns[i] };
+				// The sparse dot product of the rows i and k before column k
+				const uint64 kBegin{ factorOffsets[k] };
+				const uint64 kEnd{ factorOffsets[k + 1] - 1 };
+				T sum{ factor[i] };
+				uint64 p{ rowBegin };
+				uint64 q{ kBegin };
+				while (p < i && q < kEnd) {
+					if (factorColumns[p] < factorColumns[q]) {
+						++p;
+					} else if (factorColumns[q] < factorColumns[p]) {
+						++q;
+					} else {
+						sum -= factor[p++] * factor[q++];
+					}
+				}
+				if (k < row) {
+					factor[i] = sum / factor[kEnd];
+				} else if (sum > T(0)) {
+					factor[i] = std::sqrt(sum);
+				} else {
+					_active = Preconditioner::JACOBI;
+					break;
+				}
+			}
+		}
+		return regular && _active == Preconditioner::IC0;
+	}
+
+	template<typename T>
+	float64 ConjugateGradient<T>::precondition(Preconditioner preconditioner)
+	{
+		const uint64 n{ _r.size() };
+		T const* r{ _r.data() };
+		T* z{ _z.data() };
+		switch (preconditioner) {
+		case Preconditioner::JACOBI: {
+			T const* inverse{ _inverseDiagonal.data() };
+			return parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+				float64 sum{ 0.0 };
+				for (uint64 i{ begin }; i < end; ++i) {
+					z[i] = r[i] * inverse[i];
+					sum += static_cast<float64>(r[i]) * z[i];
+				}
+				return sum;
+			});
+		}
+		case Preconditioner::IC0: {
+			// Solves Ly = r by rows and L^T z = y by the columns of L^T,
+			// which are the rows of L
+			uint64 const* offsets{ _factor.GetRowOffsets() };
+			uint32 const* columns{ _factor.GetColumnIndices() };
+			T const* factor{ _factor.GetValues() };
+			for (uint64 row{ 0 }; row < n; ++row) {
+				const uint64 diagonal{ offsets[row + 1] - 1 };
+				T sum{ r[row] };
+				for (uint64 i{ offsets[row] }; i < diagonal; ++i)
+					sum -= factor[i] * z[columns[i]];
+				z[row] = sum / factor[diagonal];
+			}
+			for (uint64 row{ n }; row-- > 0;) {
+				const uint64 diagonal{ offsets[row + 1] - 1 };
+				const T value{ z[row] / factor[diagonal] };
+				z[row] = value;
+				for (uint64 i{ offsets[row] }; i < diagonal; ++i)
+					z[columns[i]] -= factor[i] * value;
+			}
+			return parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+				float64 sum{ 0.0 };
+				for (uint64 i{ begin }; i < end; ++i)
+					sum += static_cast<float64>(r[i]) * z[i];
+				return sum;
+			});
+		}
+		default:
+			return parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+				float64 sum{ 0.0 };
+				for (uint64 i{ begin }; i < end; ++i) {
+					z[i] = r[i];
+					sum += static_cast<float64>(r[i]) * r[i];
+				}
+				return sum;
+			});
+		}
+	}
+
+	template<typename T>
+	SolverStats ConjugateGradient<T>::Solve(SparseMatrix<T> const& a, T const* b, T* x)
+	{
+		using clock = std::chrono::steady_clock;
+		const clock::time_point start{ clock::now() };
+		const uint64 n{ a.GetRows() };
+		// The workspace only grows, so that solves of the same size don't
+		// allocate
+		_r.resize(n);
+		_z.resize(n);
+		_p.resize(n);
+		_q.resize(n);
+		_partials.resize((n + VectorGrain - 1) / VectorGrain);
+		// Falls back to no preconditioner, if Compute wasn't called for a
+		// matrix of this size
+		Preconditioner preconditioner{ _active };
+		if ((preconditioner == Preconditioner::JACOBI && _inverseDiagonal.size() != n) ||
+			(preconditioner == Preconditioner::IC0 && _factor.GetRows() != n))
+			preconditioner = Preconditioner::NONE;
+
+		T* r{ _r.data() };
+		T* z{ _z.data() };
+		T* p{ _p.data() };
+		T* q{ _q.data() };
+		SolverStats stats;
+		const float64 bb{ parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+			float64 sum{ 0.0 };
+			for (uint64 i{ begin }; i < end; ++i)
+				sum += static_cast<float64>(b[i]) * b[i];
+			return sum;
+		}) };
+		if (bb == 0.0) {
+			std::fill(x, x + n, T(0));
+			stats.converged = true;
+			stats.seconds = std::chrono::duration<float64>(clock::now() - start).count();
+			return stats;
+		}
+		const float64 threshold{ _tolerance * _tolerance * bb };
+		a.Multiply(x, q);
+		float64 rr{ parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+			float64 sum{ 0.0 };
+			for (uint64 i{ begin }; i < end; ++i) {
+				r[i] = b[i] - q[i];
+				sum += static_cast<float64>(r[i]) * r[i];
+			}
+			return sum;
+		}) };
+		stats.converged = rr <= threshold;
+		if (!stats.converged) {
+			float64 rz{ precondition(preconditioner) };
+			std::copy(z, z + n, p);
+			while (stats.iterations < _maxIterations) {
+				a.Multiply(p, q);
+				const float64 pq{ parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+					float64 sum{ 0.0 };
+					for (uint64 i{ begin }; i < end; ++i)
+						sum += static_cast<float64>(p[i]) * q[i];
+					return sum;
+				}) };
+				// The matrix isn't positive definite
+				if (!(pq > 0.0))
+					break;
+				const T alpha{ static_cast<T>(rz / pq) };
+				rr = parallel_sum(n, _partials, [&](uint64 begin, uint64 end) {
+					float64 sum{ 0.0 };
+					for (uint64 i{ begin }; i < end; ++i) {
+						x[i] += alpha * p[i];
+						r[i] -= alpha * q[i];
+						sum += static_cast<float64>(r[i]) * r[i];
+					}
+					return sum;
+				});
+				++stats.iterations;
+				if (rr <= threshold) {
+					stats.converged = true;
+					break;
+				}
+				const float64 rzNext{ precondition(preconditioner) };
+				const T beta{ static_cast<T>(rzNext / rz) };
+				rz = rzNext;
+				ParallelFor(0, n, VectorGrain, [&](uint64 begin, uint64 end) {
+					for (uint64 i{ begin }; i < end; ++i)
+						p[i] = z[i] + beta * p[i];
+				});
+			}
+		}
+		stats.residual = std::sqrt(rr / bb);
+		stats.seconds = std::chrono::duration<float64>(clock::now() - start).count();
+		return stats;
+	}
+
+	template<typename T>
+	void ConjugateGradient<T>::SetTolerance(float64 tolerance) noexcept
+	{
+		_tolerance = tolerance;
+	}
+
+	template<typename T>
+	void ConjugateGradient<T>::SetMaxIterations(uint32 iterations) noexcept
+	{
+		_maxIterations = iterations;
+	}
+
+	template<typename T>
+	Preconditioner ConjugateGradient<T>::GetPreconditioner() const noexcept
+	{
+		return _preconditioner;
+	}
+
+	template class SparseMatrix<float32>;
+	template class SparseMatrix<float64>;
+	template class BlockSparseMatrix<float32>;
+	template class BlockSparseMatrix<float64>;
+	template class ConjugateGradient<float32>;
+	template class ConjugateGradient<float64>;
+} // namespace ecm::math
@@ -0,0 +1,320 @@
+#include <ECM/math/spatial_hash.h>
+#include <ECM/math/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ecm::math
+{
+	namespace
+	{
+		constexpr uint32 InvalidItem{ 0xffffffffu };
+		// Marks the slots of items, which are in the pending list
+		constexpr uint32 PendingBit{ 0x80000000u };
+		// The grid is sorted again, once more items than this, or a quarter
+		// of all items, are pending or removed
+		constexpr uint32 MinPending{ 256 };
+		constexpr uint32 MinBucketCount{ 16 };
+		constexpr uint64 ItemGrain{ 4096 };
+		constexpr uint64 PairGrain{ 1024 };
+		constexpr uint64 MaxChunks{ 256 };
+		// Cell coordinates are clamped, so that neighbours don't overflow
+		constexpr float32 MaxCell{ 1073741824.f };
+
+		inline int32 cell_coordinate(float32 v, float32 inverseCellSize)
+		{
+			const float32 c{ std::floor(v * inverseCellSize) };
+			if (!(c >= -MaxCell))
+				return -static_cast<int32>(MaxCell);
+			return c > MaxCell ? static_cast<int32>(MaxCell) : static_cast<int32>(c);
+		}
+
+		// The hash of Teschner et al., "Optimized Spatial Hashing for
+		// Collision Detection of Deformable Objects"
+		inline uint32 hash_cell(int32 x, int32 y)
+		{
+			return (static_cast<uint32>(x) * 73856093u) ^ (static_cast<uint32>(y) * 19349663u);
+		}
+	} // anonymous namespace
+
+	SpatialHashGrid::SpatialHashGrid(float32 cellSize) noexcept
+		: _cellSize(cellSize), _inverseCellSize(1.f / cellSize)
+	{}
+
+	void SpatialHashGrid::Build(PointF const* positions, uint32 count)
+	{
+		Clear();
+		_items.resize(count);
+		for (uint32 i{ 0 }; i < count; ++i)
+			_items[i].position = positions[i];
+		_count = count;
+		Rebuild();
+	}
+
+	void SpatialHashGrid::Clear() noexcept
+	{
+		_count = 0;
+		_removed = 0;
+		_bucketMask = 0;
+		_items.clear();
+		_free.clear();
+		_pending.clear();
+		_bucketStart.clear();
+		_x.clear();
+		_y.clear();
+		_cellX.clear();
+		_cellY.clear();
+		_handles.clear();
+	}
+
+	uint32 SpatialHashGrid::Insert(PointF const& position)
+	{
+		uint32 item;
+		if (!_free.empty()) {
+			item = _free.back();
+			_free.pop_back();
+		} else {
+			item = static_cast<uint32>(_items.size());
+			_items.emplace_back();
+		}
+		_items[item].position = position;
+		_items[item].slot = PendingBit | static_cast<uint32>(_pending.size());
+		_pending.push_back(item);
+		++_count;
+		rebuild_if_needed();
+		return item;
+	}
+
+	void SpatialHashGrid::Remove(uint32 item)
+	{
+		remove_slot(item);
+		_items[item].slot = InvalidItem;
+		_free.push_back(item);
+		--_count;
+		rebuild_if_needed();
+	}
+
+	void SpatialHashGrid::Move(uint32 item, PointF const& position)
+	{
+		item_entry& entry{ _items[item] };
+		entry.position = position;
+		if (entry.slot & PendingBit)
+			return;
+		// Items, which stay in their cell, are updated in place
+		const uint32 slot{ entry.slot };
+		if (cell_coordinate(position.x, _inverseCellSize) == _cellX[slot]
+			&& cell_coordinate(position.y, _inverseCellSize) == _cellY[slot]) {
+			_x[slot] = position.x;
+			_y[slot] = position.y;
+			return;
+		}
+		remove_slot(item);
+		entry.slot = PendingBit | static_cast<uint32>(_pending.size());
+		_pending.push_back(item);
+		rebuild_if_needed();
+	}
+
+	void SpatialHashGrid::Rebuild()
+	{
+		_pending.clear();
+		_removed = 0;
+		uint32 bucketCount{ MinBucketCount };
+		while (bucketCount < _count)
+			bucketCount <<= 1;
+		_bucketMask = bucketCount - 1;
+
+		// The cells and buckets of the items are computed on the threads,
+		// and the items are then sorted by their bucket with a counting sort
+		const uint64 itemCount{ _items.size() };
+		std::vector<int32> cells(itemCount * 2);
+		std::vector<uint32> buckets(itemCount);
+		ParallelFor(0, itemCount, ItemGrain, [&](uint64 begin, uint64 end) {
+			for (uint64 i{ begin }; i < end; ++i) {
+				if (_items[i].slot == InvalidItem) {
+					buckets[i] = InvalidItem;
+					continue;
+				}
+				cells[i * 2] = cell_coordinate(_items[i].position.x, _inverseCellSize);
+				cells[i * 2 + 1] = cell_coordinate(_items[i].position.y, _inverseCellSize);
+				buckets[i] = hash_cell(cells[i * 2], cells[i * 2 + 1]) & _bucketMask;
+			}
+		});
+		_bucketStart.assign(static_cast<uint64>(bucketCount) + 1, 0);
+		for (uint64 i{ 0 }; i < itemCount; ++i) {
+			if (buckets[i] != InvalidItem)
+				++_bucketStart[buckets[i] + 1];
+		}
+		for (uint32 b{ 0 }; b < bucketCount; ++b)
+			_bucketStart[b + 1] += _bucketStart[b];
+
+		std::vector<uint32> cursor(_bucketStart.begin(), _bucketStart.end() - 1);
+		_x.resize(_count);
+		_y.resize(_count);
+		_cellX.resize(_count);
+		_cellY.resize(_count);
+		_handles.resize(_count);
+		for (uint64 i{ 0 }; i < itemCount; ++i) {
+			if (buckets[i] == InvalidItem)
+				continue;
+			const uint32 slot{ cursor[buckets[i]]++ };
+			_x[slot] = _items[i].position.x;
+			_y[slot] = _items[i].position.y;
+			_cellX[slot] = cells[i * 2];
+			_cellY[slot] = cells[i * 2 + 1];
+			_handles[slot] = static_cast<uint32>(i);
+			_items[i].slot = slot;
+		}
+	}
+
+	uint32 SpatialHashGrid::QueryRadius(PointF const& center, float32 radius, std::vector<uint32>& items) const
+	{
+		const float32 radiusSquared{ radius * radius };
+		return query(PointF(center.x - radius, center.y - radius), PointF(center.x + radius, center.y + radius),
+			[&center, radiusSquared](float32 x, float32 y) {
+			const float32 dx{ x - center.x };
+			const float32 dy{ y - center.y };
+			return dx * dx + dy * dy <= radiusSquared;
+		}, items);
+	}
+
+	uint32 SpatialHashGrid::QueryRect(PointF const& min, PointF const& max, std::vector<uint32>& items) const
+	{
+		return query(min, max, [&min, &max](float32 x, float32 y) {
+			return x >= min.x && x <= max.x && y >= min.y && y <= max.y;
+		}, items);
+	}
+
+	void SpatialHashGrid::FindPairs(float32 distance, std::vector<SpatialPair>& pairs)
+	{
+		if (!_pending.empty() || _removed > 0)
+			Rebuild();
+		pairs.clear();
+		const uint64 count{ _handles.size() };
+		if (count == 0 || !(distance >= 0.f))
+			return;
+
+		// Each item looks for the items after it in its cell, and for all
+		// items in the forward half of the cells within the distance, so
+		// that each pair is found once. Distances of many cells scan all
+		// items instead.
+		const float32 distanceSquared{ distance * distance };
+		const float32 reach{ std::ceil(distance * _inverseCellSize) };
+		const bool scanAll{ !(reach * 2.f + 1.f <= std::sqrt(static_cast<float32>(_bucketMask + 1))) };
+		const int32 span{ scanAll ? 0 : static_cast<int32>(reach) };
+		const uint64 chunk{ std::max(PairGrain, (count + MaxChunks - 1) / MaxChunks) };
+		std::vector<std::vector<SpatialPair>> partial((count + chunk - 1) / chunk);
+		ParallelFor(0, count, chunk, [&](uint64 begin, uint64 end) {
+			std::vector<SpatialPair>& out{ partial[begin / chunk] };
+			const auto test = [&](uint64 s, uint64 t) {
+				const float32 dx{ _x[t] - _x[s] };
+				const float32 dy{ _y[t] - _y[s] };
+				if (dx * dx + dy * dy <= distanceSquared)
+					out.push_back({ std::min(_handles[s], _handles[t]), std::max(_handles[s], _handles[t]) });
+			};
+			for (uint64 s{ begin }; s < end; ++s) {
+				if (scanAll) {
+					for (uint64 t{ s + 1 }; t < count; ++t)
+						test(s, t);
+					continue;
+				}
+				const int32 cellX{ _cellX[s] };
+				const int32 cellY{ _cellY[s] };
+				const uint32 bucket{ hash_cell(cellX, cellY) & _bucketMask };
+				for (uint64 t{ s + 1 }; t < _bucketStart[bucket + 1]; ++t) {
+					if (_cellX[t] == cellX && _cellY[t] == cellY)
+						test(s, t);
+				}
+				for (int32 y{ cellY }; y <= cellY + span; ++y) {
+					for (int32 x{ y == cellY ? cellX + 1 : cellX - span }; x <= cellX + span; ++x) {
+						const uint32 neighbour{ hash_cell(x, y) & _bucketMask };
+						for (uint32 t{ _bucketStart[neighbour] }; t < _bucketStart[neighbour + 1]; ++t) {
+							if (_cellX[t] == x && _cellY[t] == y)
+								test(s, t);
+						}
+					}
+				}
+			}
+		});
+		uint64 total{ 0 };
+		for (std::vector<SpatialPair> const& p : partial)
+			total += p.size();
+		pairs.reserve(total);
+		for (std::vector<SpatialPair> const& p : partial)
+			pairs.insert(pairs.end(), p.begin(), p.end());
+	}
+
+	PointF SpatialHashGrid::GetPosition(uint32 item) const noexcept
+	{
+		return _items[item].position;
+	}
+
+	uint32 SpatialHashGrid::GetCount() const noexcept
+	{
+		return _count;
+	}
+
+	float32 SpatialHashGrid::GetCellSize() const noexcept
+	{
+		return _cellSize;
+	}
+
+	template<typename Test>
+	uint32 SpatialHashGrid::query(PointF const& min, PointF const& max, Test const& test,
+		std::vector<uint32>& items) const
+	{
+		const uint64 first{ items.size() };
+		if (!_bucketStart.empty()) {
+			const int32 x0{ cell_coordinate(min.x, _inverseCellSize) };
+			const int32 y0{ cell_coordinate(min.y, _inverseCellSize) };
+			const int32 x1{ cell_coordinate(max.x, _inverseCellSize) };
+			const int32 y1{ cell_coordinate(max.y, _inverseCellSize) };
+			const int64 cellCount{ (static_cast<int64>(x1) - x0 + 1) * (static_cast<int64>(y1) - y0 + 1) };
+			if (x1 < x0 || y1 < y0) {
+				// The area is empty
+			} else if (cellCount > static_cast<int64>(_bucketMask) + 1) {
+				// Areas of more cells than buckets scan all items
+				for (uint64 s{ 0 }; s < _handles.size(); ++s) {
+					if (_handles[s] != InvalidItem && test(_x[s], _y[s]))
+						items.push_back(_handles[s]);
+				}
+			} else {
+				for (int32 y{ y0 }; y <= y1; ++y) {
+					for (int32 x{ x0 }; x <= x1; ++x) {
+						const uint32 bucket{ hash_cell(x, y) & _bucketMask };
+						for (uint32 s{ _bucketStart[bucket] }; s < _bucketStart[bucket + 1]; ++s) {
+							if (_cellX[s] == x && _cellY[s] == y && _handles[s] != InvalidItem && test(_x[s], _y[s]))
+								items.push_back(_handles[s]);
+						}
+					}
+				}
+			}
+		}
+		for (uint32 item : _pending) {
+			if (test(_items[item].position.x, _items[item].position.y))
+				items.push_back(item);
+		}
+		return static_cast<uint32>(items.size() - first);
+	}
+
+	void SpatialHashGrid::remove_slot(uint32 item) noexcept
+	{
+		const uint32 slot{ _items[item].slot };
+		if (slot & PendingBit) {
+			const uint32 index{ slot & ~PendingBit };
+			const uint32 last{ _pending.back() };
+			_pending[index] = last;
+			_items[last].slot = PendingBit | index;
+			_pending.pop_back();
+		} else {
+			_handles[slot] = InvalidItem;
+			++_removed;
+		}
+	}
+
+	void SpatialHashGrid::rebuild_if_needed()
+	{
+		const uint32 limit{ std::max(MinPending, _count / 4) };
+		if (_pending.size() > limit || _removed > limit)
+			Rebuild();
+	}
+} // namespace ecm::math